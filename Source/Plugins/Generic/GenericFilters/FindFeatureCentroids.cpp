@@ -47,6 +47,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Generic/GenericFilters/util/CellFeatureReduction.h"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
@@ -142,75 +144,28 @@ void FindFeatureCentroids::find_centroids()
   size_t yPoints = imageGeom->getYPoints();
   size_t zPoints = imageGeom->getZPoints();
 
-  //Copy the Coords into an array and then compute the sum
-
-  std::vector<double> sum(totalFeatures * 3, 0.0);
-  std::vector<double> c(totalFeatures * 3, 0.0);
-  std::vector<size_t> count(totalFeatures * 3, 0.0);
+  // Summed cell centers and number of cells of each feature in one pass
+  ImageGeom* geom = imageGeom.get();
+  std::vector<double> sums = CellFeatureReduction::Sum<double>(m_FeatureIds, xPoints * yPoints * zPoints, totalFeatures, 4, [geom, xPoints, yPoints](size_t cell, double* featureSums) {
+    std::array<float, 3> voxel_center = {0.0f, 0.0f, 0.0f};
+    geom->getCoords(cell % xPoints, (cell / xPoints) % yPoints, cell / (xPoints * yPoints), voxel_center.data()); // Get the voxel center based on XYZ index from Image Geom
+    featureSums[0] += static_cast<double>(voxel_center[0]);
+    featureSums[1] += static_cast<double>(voxel_center[1]);
+    featureSums[2] += static_cast<double>(voxel_center[2]);
+    featureSums[3] += 1.0;
+  });
 
-  std::array<float, 3> voxel_center = {0.0f, 0.0f, 0.0f};
-
-  size_t zStride = 0;
-  size_t yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
+  for(size_t featureId = 0; featureId < totalFeatures; featureId++)
   {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
+    double count = sums[featureId * 4 + 3];
+    if(count > 0.0)
     {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
+      for(size_t d = 0; d < 3; d++)
       {
-        int32_t featureId = m_FeatureIds[zStride + yStride + k]; // Get the current FeatureId
-
-        imageGeom->getCoords(k, j, i, voxel_center.data()); // Get the voxel center based on XYZ index from Image Geom
-
-        //Kahan Sum for X Coord
-        size_t featureId_idx = static_cast<size_t>(featureId * 3);
-        double y = static_cast<double>(voxel_center[0] - c[featureId_idx]);
-        double t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
-
-        //Kahan Sum for Y Coord
-        featureId_idx = static_cast<size_t>(featureId * 3 + 1);
-        y = static_cast<double>(voxel_center[1] - c[featureId_idx]);
-        t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
-
-        //Kahan Sum for Z Coord
-        featureId_idx = static_cast<size_t>(featureId * 3 + 2);
-        y = static_cast<double>(voxel_center[2] - c[featureId_idx]);
-        t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
+        m_Centroids[featureId * 3 + d] = static_cast<float>(sums[featureId * 4 + d] / count);
       }
     }
   }
-
-  for(size_t featureId = 0; featureId < totalFeatures; featureId++)
-  {
-    size_t featureId_idx = static_cast<size_t>(featureId * 3);
-    if(count[featureId_idx] > 0.0f)
-    {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
-    }
-
-    featureId_idx = static_cast<size_t>(featureId * 3 + 1);
-    if(count[featureId_idx] > 0.0f)
-    {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
-    }
-
-    featureId_idx = static_cast<size_t>(featureId * 3 + 2);
-    if(count[featureId_idx] > 0.0f)
-    {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
-    }
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -59,6 +59,10 @@ endforeach()
 
 
 
+#-------------
+# These are files that need to be compiled into DREAM3DLib but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/CellFeatureReduction.h)
+
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
 SIMPL_END_FILTER_GROUP(${Generic_BINARY_DIR} "${_filterGroupName}" "Generic")
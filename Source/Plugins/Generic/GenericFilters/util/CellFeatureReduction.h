@@ -0,0 +1,316 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+/**
+ * @brief The CellFeatureReduction class reduces per cell values into per feature values. The cells are split
+ * into one contiguous block per thread and each block accumulates into its own copy of the feature values. The
+ * copies are added together in block order afterwards, so the result does not depend on the thread scheduling.
+ *
+ * Any number of values can be accumulated per feature, which lets a filter compute several aggregates (counts,
+ * sums of scalars, sums of coordinates, ...) in a single pass over the cells.
+ *
+ * Everything is implemented in this header so that filters from other plugins can use it without linking to
+ * the Generic plugin.
+ */
+class CellFeatureReduction
+{
+public:
+  /**
+   * @brief Sum Accumulates per feature values over all cells. For every cell whose feature id is in
+   * [0, numFeatures) the functor is called as addCell(cellIndex, featureValues), where featureValues points to the
+   * numValues accumulators of the feature of that cell. The functor is called concurrently for different blocks of
+   * cells but never for two cells of the same block at the same time.
+   * @param featureIds Feature id of each cell
+   * @param numCells
+   * @param numFeatures
+   * @param numValues Number of values accumulated per feature
+   * @param addCell Functor that adds the contribution of one cell
+   * @return numValues accumulated values per feature, zero for features without cells
+   */
+  template <typename T, typename CellFunctor>
+  static std::vector<T> Sum(const int32_t* featureIds, size_t numCells, size_t numFeatures, size_t numValues, const CellFunctor& addCell)
+  {
+    size_t numBlocks = BlockCount(numCells, numFeatures, numValues);
+    std::vector<T> values = SumBlocks<T>(featureIds, numCells, numFeatures, numValues, numBlocks, addCell);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numFeatures);
+    dataAlg.execute(MergeBlocksImpl<T>(values, numFeatures, numValues, numBlocks));
+    values.resize(numFeatures * numValues);
+    return values;
+  }
+
+  /**
+   * @brief GroupCells Sorts the cell indices by feature for reductions that must see the cells of a feature in
+   * order, such as running averages. The cells of feature f are cells[offsets[f]] to cells[offsets[f + 1] - 1] in
+   * increasing order. Cells whose feature id is outside [0, numFeatures) are left out. Besides the outputs, which
+   * take one index per cell, each block keeps one cursor per feature while the cells are scattered.
+   * @param featureIds Feature id of each cell
+   * @param numCells
+   * @param numFeatures
+   * @param offsets Output start of the cells of each feature, numFeatures + 1 values
+   * @param cells Output cell indices
+   */
+  static void GroupCells(const int32_t* featureIds, size_t numCells, size_t numFeatures, std::vector<size_t>& offsets, std::vector<size_t>& cells)
+  {
+    size_t numBlocks = BlockCount(numCells, numFeatures, 1);
+    std::vector<size_t> cursors = SumBlocks<size_t>(featureIds, numCells, numFeatures, 1, numBlocks, [](size_t, size_t* count) { (*count)++; });
+
+    // Turn the per block counts into the position where each block writes the next cell of each feature
+    offsets.assign(numFeatures + 1, 0);
+    size_t position = 0;
+    for(size_t f = 0; f < numFeatures; f++)
+    {
+      offsets[f] = position;
+      for(size_t block = 0; block < numBlocks; block++)
+      {
+        size_t count = cursors[block * numFeatures + f];
+        cursors[block * numFeatures + f] = position;
+        position += count;
+      }
+    }
+    offsets[numFeatures] = position;
+
+    cells.resize(position);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute(ScatterCellsImpl(featureIds, numCells, numFeatures, numBlocks, cursors, cells));
+  }
+
+  /**
+   * @brief BlockCount Returns the number of blocks the cells are split into: one per thread of the task arena the
+   * caller runs in, as long as each block is big enough to be worth a thread and the copies of the accumulators
+   * stay within a fixed memory budget.
+   * @param numCells
+   * @param numFeatures
+   * @param numValues
+   * @return
+   */
+  static size_t BlockCount(size_t numCells, size_t numFeatures, size_t numValues)
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    size_t numThreads = static_cast<size_t>(std::max(tbb::this_task_arena::max_concurrency(), 1));
+#else
+    // ParallelDataAlgorithm runs serially without TBB, so more blocks would only cost memory
+    size_t numThreads = 1;
+#endif
+    size_t byMemory = std::max<size_t>(k_MaxAccumulatorValues / std::max<size_t>(numFeatures * numValues, 1), 1);
+    size_t bySize = std::max<size_t>(numCells / k_MinBlockSize, 1);
+    return std::min({numThreads, byMemory, bySize});
+  }
+
+protected:
+  CellFeatureReduction() = default;
+
+public:
+  CellFeatureReduction(const CellFeatureReduction&) = delete;            // Copy Constructor Not Implemented
+  CellFeatureReduction(CellFeatureReduction&&) = delete;                 // Move Constructor Not Implemented
+  CellFeatureReduction& operator=(const CellFeatureReduction&) = delete; // Copy Assignment Not Implemented
+  CellFeatureReduction& operator=(CellFeatureReduction&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  // Blocks smaller than this are not worth a thread of their own
+  static constexpr size_t k_MinBlockSize = 32768;
+  // Upper bound on the number of accumulator values of all blocks together
+  static constexpr size_t k_MaxAccumulatorValues = size_t(1) << 24;
+
+  /**
+   * @brief The SumBlockImpl class implements a threaded algorithm that accumulates the cells of one block into the
+   * accumulators of that block.
+   */
+  template <typename T, typename CellFunctor>
+  class SumBlockImpl
+  {
+  public:
+    SumBlockImpl(const int32_t* featureIds, size_t numCells, size_t numFeatures, size_t numValues, size_t numBlocks, const CellFunctor& addCell, std::vector<T>& accumulators)
+    : m_FeatureIds(featureIds)
+    , m_NumCells(numCells)
+    , m_NumFeatures(numFeatures)
+    , m_NumValues(numValues)
+    , m_NumBlocks(numBlocks)
+    , m_AddCell(addCell)
+    , m_Accumulators(accumulators)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t block = start; block < end; block++)
+      {
+        T* values = m_Accumulators.data() + block * m_NumFeatures * m_NumValues;
+        size_t first = m_NumCells * block / m_NumBlocks;
+        size_t last = m_NumCells * (block + 1) / m_NumBlocks;
+        for(size_t cell = first; cell < last; cell++)
+        {
+          int32_t featureId = m_FeatureIds[cell];
+          if(featureId < 0 || static_cast<size_t>(featureId) >= m_NumFeatures)
+          {
+            continue;
+          }
+          m_AddCell(cell, values + static_cast<size_t>(featureId) * m_NumValues);
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    const int32_t* m_FeatureIds = nullptr;
+    size_t m_NumCells = 0;
+    size_t m_NumFeatures = 0;
+    size_t m_NumValues = 0;
+    size_t m_NumBlocks = 1;
+    const CellFunctor& m_AddCell;
+    std::vector<T>& m_Accumulators;
+  };
+
+  /**
+   * @brief The MergeBlocksImpl class implements a threaded algorithm that adds the accumulators of all blocks into
+   * those of the first block, one range of features at a time.
+   */
+  template <typename T>
+  class MergeBlocksImpl
+  {
+  public:
+    MergeBlocksImpl(std::vector<T>& accumulators, size_t numFeatures, size_t numValues, size_t numBlocks)
+    : m_Accumulators(accumulators)
+    , m_NumFeatures(numFeatures)
+    , m_NumValues(numValues)
+    , m_NumBlocks(numBlocks)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      T* merged = m_Accumulators.data();
+      for(size_t block = 1; block < m_NumBlocks; block++)
+      {
+        const T* values = m_Accumulators.data() + block * m_NumFeatures * m_NumValues;
+        for(size_t i = start * m_NumValues; i < end * m_NumValues; i++)
+        {
+          merged[i] += values[i];
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    std::vector<T>& m_Accumulators;
+    size_t m_NumFeatures = 0;
+    size_t m_NumValues = 0;
+    size_t m_NumBlocks = 1;
+  };
+
+  /**
+   * @brief The ScatterCellsImpl class implements a threaded algorithm that writes the cell indices of one block to
+   * the positions reserved for that block within each feature.
+   */
+  class ScatterCellsImpl
+  {
+  public:
+    ScatterCellsImpl(const int32_t* featureIds, size_t numCells, size_t numFeatures, size_t numBlocks, std::vector<size_t>& cursors, std::vector<size_t>& cells)
+    : m_FeatureIds(featureIds)
+    , m_NumCells(numCells)
+    , m_NumFeatures(numFeatures)
+    , m_NumBlocks(numBlocks)
+    , m_Cursors(cursors)
+    , m_Cells(cells)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t block = start; block < end; block++)
+      {
+        size_t* cursors = m_Cursors.data() + block * m_NumFeatures;
+        size_t first = m_NumCells * block / m_NumBlocks;
+        size_t last = m_NumCells * (block + 1) / m_NumBlocks;
+        for(size_t cell = first; cell < last; cell++)
+        {
+          int32_t featureId = m_FeatureIds[cell];
+          if(featureId < 0 || static_cast<size_t>(featureId) >= m_NumFeatures)
+          {
+            continue;
+          }
+          m_Cells[cursors[featureId]++] = cell;
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    const int32_t* m_FeatureIds = nullptr;
+    size_t m_NumCells = 0;
+    size_t m_NumFeatures = 0;
+    size_t m_NumBlocks = 1;
+    std::vector<size_t>& m_Cursors;
+    std::vector<size_t>& m_Cells;
+  };
+
+  // -----------------------------------------------------------------------------
+  template <typename T, typename CellFunctor>
+  static std::vector<T> SumBlocks(const int32_t* featureIds, size_t numCells, size_t numFeatures, size_t numValues, size_t numBlocks, const CellFunctor& addCell)
+  {
+    std::vector<T> accumulators(numBlocks * numFeatures * numValues, static_cast<T>(0));
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute(SumBlockImpl<T, CellFunctor>(featureIds, numCells, numFeatures, numValues, numBlocks, addCell, accumulators));
+    return accumulators;
+  }
+};
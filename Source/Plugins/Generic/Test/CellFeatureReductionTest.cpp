@@ -0,0 +1,186 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include "Generic/GenericFilters/util/CellFeatureReduction.h"
+
+class CellFeatureReductionTest
+{
+public:
+  CellFeatureReductionTest() = default;
+  ~CellFeatureReductionTest() = default;
+  CellFeatureReductionTest(const CellFeatureReductionTest&) = delete;            // Copy Constructor
+  CellFeatureReductionTest(CellFeatureReductionTest&&) = delete;                 // Move Constructor
+  CellFeatureReductionTest& operator=(const CellFeatureReductionTest&) = delete; // Copy Assignment
+  CellFeatureReductionTest& operator=(CellFeatureReductionTest&&) = delete;      // Move Assignment
+
+  const size_t k_NumCells = 200003;
+  const size_t k_NumFeatures = 517;
+
+  // -----------------------------------------------------------------------------
+  // Feature ids in [-1, k_NumFeatures + 1] so that some cells are outside the valid range
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> createFeatureIds()
+  {
+    std::mt19937_64 generator(5489);
+    std::uniform_int_distribution<int32_t> distribution(-1, static_cast<int32_t>(k_NumFeatures) + 1);
+    std::vector<int32_t> featureIds(k_NumCells);
+    for(int32_t& featureId : featureIds)
+    {
+      featureId = distribution(generator);
+    }
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSum()
+  {
+    std::vector<int32_t> featureIds = createFeatureIds();
+    std::vector<uint32_t> values(k_NumCells);
+    for(size_t i = 0; i < k_NumCells; i++)
+    {
+      values[i] = static_cast<uint32_t>((i * 7919) % 1000);
+    }
+
+    // Counts, sums and sums of squares in one pass
+    std::vector<uint64_t> sums = CellFeatureReduction::Sum<uint64_t>(featureIds.data(), k_NumCells, k_NumFeatures, 3, [&values](size_t cell, uint64_t* featureSums) {
+      featureSums[0]++;
+      featureSums[1] += values[cell];
+      featureSums[2] += static_cast<uint64_t>(values[cell]) * values[cell];
+    });
+    DREAM3D_REQUIRE_EQUAL(sums.size(), k_NumFeatures * 3)
+
+    std::vector<uint64_t> expected(k_NumFeatures * 3, 0);
+    for(size_t i = 0; i < k_NumCells; i++)
+    {
+      if(featureIds[i] < 0 || featureIds[i] >= static_cast<int32_t>(k_NumFeatures))
+      {
+        continue;
+      }
+      uint64_t* featureSums = expected.data() + featureIds[i] * 3;
+      featureSums[0]++;
+      featureSums[1] += values[i];
+      featureSums[2] += static_cast<uint64_t>(values[i]) * values[i];
+    }
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(sums[i], expected[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestGroupCells()
+  {
+    std::vector<int32_t> featureIds = createFeatureIds();
+    std::vector<size_t> offsets;
+    std::vector<size_t> cells;
+    CellFeatureReduction::GroupCells(featureIds.data(), k_NumCells, k_NumFeatures, offsets, cells);
+    DREAM3D_REQUIRE_EQUAL(offsets.size(), k_NumFeatures + 1)
+    DREAM3D_REQUIRE_EQUAL(offsets[0], 0)
+    DREAM3D_REQUIRE_EQUAL(offsets[k_NumFeatures], cells.size())
+
+    // Every valid cell appears once, under its own feature and in increasing order
+    std::vector<size_t> expectedOffsets(k_NumFeatures + 1, 0);
+    for(int32_t featureId : featureIds)
+    {
+      if(featureId >= 0 && featureId < static_cast<int32_t>(k_NumFeatures))
+      {
+        expectedOffsets[featureId + 1]++;
+      }
+    }
+    for(size_t f = 0; f < k_NumFeatures; f++)
+    {
+      expectedOffsets[f + 1] += expectedOffsets[f];
+      DREAM3D_REQUIRE_EQUAL(offsets[f + 1], expectedOffsets[f + 1])
+      for(size_t c = offsets[f]; c < offsets[f + 1]; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(featureIds[cells[c]], static_cast<int32_t>(f))
+        if(c > offsets[f])
+        {
+          DREAM3D_REQUIRE(cells[c] > cells[c - 1])
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestBlockCount()
+  {
+    DREAM3D_REQUIRE_EQUAL(CellFeatureReduction::BlockCount(0, 10, 1), 1)
+    DREAM3D_REQUIRE_EQUAL(CellFeatureReduction::BlockCount(100, 10, 1), 1)
+    // Accumulators that are too large for a second copy
+    DREAM3D_REQUIRE_EQUAL(CellFeatureReduction::BlockCount(size_t(1) << 30, size_t(1) << 24, 1), 1)
+    DREAM3D_REQUIRE(CellFeatureReduction::BlockCount(size_t(1) << 30, 10, 1) >= 1)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    // The blocks follow the arena the reduction runs in, not the number of cores
+    tbb::task_arena arena(2);
+    size_t numBlocks = 0;
+    arena.execute([&numBlocks] { numBlocks = CellFeatureReduction::BlockCount(size_t(1) << 30, 10, 1); });
+    DREAM3D_REQUIRE_EQUAL(numBlocks, 2)
+#endif
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "########### CellFeatureReductionTest ##############" << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestSum())
+    DREAM3D_REGISTER_TEST(TestGroupCells())
+    DREAM3D_REGISTER_TEST(TestBlockCount())
+  }
+};
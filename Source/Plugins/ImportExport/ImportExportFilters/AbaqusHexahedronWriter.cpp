@@ -51,6 +51,7 @@
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/TextFormatter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -266,13 +267,7 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   QTextStream ss(&buf);
 
   size_t pDims[3] = {cDims[0] + 1, cDims[1] + 1, cDims[2] + 1};
-  size_t nodeIndex = 1;
   size_t totalPoints = pDims[0] * pDims[1] * pDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if(increment == 0) // check to prevent divide by 0
-  {
-    increment = 1;
-  }
 
   int32_t err = 0;
   FILE* f = nullptr;
@@ -285,38 +280,45 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   fprintf(f, "** Generated by : %s\n", ImportExport::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Node\n");
 
-  for(size_t z = 0; z < pDims[2]; z++)
-  {
-    for(size_t y = 0; y < pDims[1]; y++)
+  ImportExport::ParallelTextWriter writer(ImportExport::ParallelTextWriter::FileSink(f));
+  writer.setProgressCallback([&](size_t itemsWritten, size_t totalItems) {
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
     {
-      for(size_t x = 0; x < pDims[0]; x++)
-      {
-        float xCoord = origin[0] + (x * spacing[0]);
-        float yCoord = origin[1] + (y * spacing[1]);
-        float zCoord = origin[2] + (z * spacing[2]);
-        fprintf(f, "%llu, %f, %f, %f\n", static_cast<unsigned long long int>(nodeIndex), xCoord, yCoord, zCoord);
-        if(nodeIndex % increment == 0)
-        {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if(currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << "Writing Nodes (File 1/5) " << static_cast<int>((float)(nodeIndex) / (float)(totalPoints)*100) << "% Completed ";
-            timeDiff = ((float)nodeIndex / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - nodeIndex) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if(getCancel()) // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
-        }
-        ++nodeIndex;
-      }
+      buf.clear();
+      ss << "Writing Nodes (File 1/5) " << static_cast<int>((float)(itemsWritten) / (float)(totalItems)*100) << "% Completed ";
+      timeDiff = ((float)itemsWritten / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalItems - itemsWritten) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
     }
+    return !getCancel();
+  });
+
+  bool completed = writer.write(totalPoints, [&](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+    for(size_t nodeIndex = start; nodeIndex < end; nodeIndex++)
+    {
+      size_t x = nodeIndex % pDims[0];
+      size_t y = (nodeIndex / pDims[0]) % pDims[1];
+      size_t z = nodeIndex / (pDims[0] * pDims[1]);
+      float xCoord = origin[0] + (x * spacing[0]);
+      float yCoord = origin[1] + (y * spacing[1]);
+      float zCoord = origin[2] + (z * spacing[2]);
+      buffer.appendInt(nodeIndex + 1);
+      buffer.append(", ", 2);
+      buffer.appendFixed(xCoord);
+      buffer.append(", ", 2);
+      buffer.appendFixed(yCoord);
+      buffer.append(", ", 2);
+      buffer.appendFixed(zCoord);
+      buffer.append('\n');
+    }
+  });
+  if(!completed) // Filter has been cancelled or the write failed
+  {
+    fclose(f);
+    return getCancel() ? 1 : -1;
   }
 
   // Write the last node, which is a dummy node used for stress - strain curves.
@@ -342,11 +344,6 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
   QString buf;
   QTextStream ss(&buf);
   size_t totalPoints = cDims[0] * cDims[1] * cDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if(increment == 0) // check to prevent divide by 0
-  {
-    increment = 1;
-  }
 
   int32_t err = 0;
   FILE* f = nullptr;
@@ -356,43 +353,48 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
     return -1;
   }
 
-  // Get a typedef to shorten up the printf codes
-  using _lli_t_ = long long int;
-
-  size_t index = 1;
   fprintf(f, "** Generated by : %s\n", ImportExport::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Element, type=C3D8\n");
-  for(size_t z = 0; z < cDims[2]; z++)
-  {
-    for(size_t y = 0; y < cDims[1]; y++)
+
+  ImportExport::ParallelTextWriter writer(ImportExport::ParallelTextWriter::FileSink(f));
+  writer.setProgressCallback([&](size_t itemsWritten, size_t totalItems) {
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
     {
-      for(size_t x = 0; x < cDims[0]; x++)
+      buf.clear();
+      ss << "Writing Elements (File 2/5) " << static_cast<int>((float)(itemsWritten) / (float)(totalItems)*100) << "% Completed ";
+      timeDiff = ((float)itemsWritten / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalItems - itemsWritten) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+    }
+    return !getCancel();
+  });
+
+  // Abaqus C3D8 node ordering of the voxel corners
+  static const size_t k_NodeOrder[8] = {5, 1, 0, 4, 7, 3, 2, 6};
+  bool completed = writer.write(totalPoints, [&](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+    int64_t nodeId[8];
+    for(size_t index = start; index < end; index++)
+    {
+      size_t x = index % cDims[0];
+      size_t y = (index / cDims[0]) % cDims[1];
+      size_t z = index / (cDims[0] * cDims[1]);
+      getNodeIds(x, y, z, pDims, nodeId);
+      buffer.appendInt(index + 1);
+      for(size_t n : k_NodeOrder)
       {
-        std::vector<int64_t> nodeId = getNodeIds(x, y, z, pDims);
-        fprintf(f, "%llu, %lld, %lld, %lld, %lld, %lld, %lld, %lld, %lld\n", (_lli_t_)index, (_lli_t_)nodeId[5], (_lli_t_)nodeId[1], (_lli_t_)nodeId[0], (_lli_t_)nodeId[4], (_lli_t_)nodeId[7],
-                (_lli_t_)nodeId[3], (_lli_t_)nodeId[2], (_lli_t_)nodeId[6]);
-        if(index % increment == 0)
-        {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if(currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << "Writing Elements (File 2/5) " << static_cast<int>((float)(index) / (float)(totalPoints)*100) << "% Completed ";
-            timeDiff = ((float)index / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - index) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if(getCancel()) // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
-        }
-        ++index;
+        buffer.append(", ", 2);
+        buffer.appendInt(nodeId[n]);
       }
+      buffer.append('\n');
     }
+  });
+  if(!completed) // Filter has been cancelled or the write failed
+  {
+    fclose(f);
+    return getCancel() ? 1 : -1;
   }
 
   fprintf(f, "**\n** ----------------------------------------------------------------\n**\n");
@@ -578,9 +580,8 @@ int32_t AbaqusHexahedronWriter::writeSects(const QString& file, size_t totalPoin
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, size_t* pDims)
+void AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, const size_t* pDims, int64_t* nodeId) const
 {
-  std::vector<int64_t> nodeId(8, 0);
 
   nodeId[0] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + x);
   nodeId[1] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + (x + 1));
@@ -605,7 +606,6 @@ std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size
     printf("         | /        |/     \n");
     printf("        %lld--------%lld     \n", static_cast<long long int>(nodeId[2]), static_cast<long long int>(nodeId[3]));
 #endif
-  return nodeId;
 }
 
 // -----------------------------------------------------------------------------
@@ -49,6 +49,7 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/TextFormatter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -253,55 +254,59 @@ int32_t DxWriter::writeFile()
     }
   }
 
-  int64_t index = 0;
-  for(int64_t x = 0; x < dims[0]; ++x)
-  {
-    // Add a leading surface Row for this plane if needed
-    if(m_AddSurfaceLayer)
-    {
-      for(int64_t i = 0; i < fileXDim; ++i)
-      {
-        out << "-4 ";
-      }
-      out << "\n";
-    }
-    for(int64_t y = 0; y < dims[1]; ++y)
+  // The data block is formatted one x plane per item, several planes at a time in parallel
+  out.flush();
+  ImportExport::ParallelTextWriter writer([&file](const char* data, size_t length) { return file.write(data, static_cast<qint64>(length)) == static_cast<qint64>(length); });
+  writer.setItemsPerChunk(static_cast<size_t>(std::max(static_cast<int64_t>(1), static_cast<int64_t>(262144) / std::max(static_cast<int64_t>(1), dims[1] * dims[2]))));
+  bool completed = writer.write(static_cast<size_t>(dims[0]), [&](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+    for(int64_t x = static_cast<int64_t>(start); x < static_cast<int64_t>(end); ++x)
     {
-      // write leading surface voxel for this row
+      // Add a leading surface Row for this plane if needed
       if(m_AddSurfaceLayer)
       {
-        out << "-5 ";
+        for(int64_t i = 0; i < fileXDim; ++i)
+        {
+          buffer.append("-4 ", 3);
+        }
+        buffer.append('\n');
       }
-      // Write the actual voxel data
-      for(int64_t z = 0; z < dims[2]; ++z)
+      for(int64_t y = 0; y < dims[1]; ++y)
       {
-        index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
-        if(m_FeatureIds[index] == 0)
+        // write leading surface voxel for this row
+        if(m_AddSurfaceLayer)
+        {
+          buffer.append("-5 ", 3);
+        }
+        // Write the actual voxel data
+        for(int64_t z = 0; z < dims[2]; ++z)
         {
-          out << "0"
-              << " ";
+          int64_t index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
+          buffer.appendInt(m_FeatureIds[index]);
+          buffer.append(' ');
         }
-        else
+        // write trailing surface voxel for this row
+        if(m_AddSurfaceLayer)
         {
-          out << m_FeatureIds[index] << " ";
+          buffer.append("-6 ", 3);
         }
+        buffer.append('\n');
       }
-      // write trailing surface voxel for this row
+      // Add a trailing surface Row for this plane if needed
       if(m_AddSurfaceLayer)
       {
-        out << "-6 ";
-      }
-      out << "\n";
-    }
-    // Add a trailing surface Row for this plane if needed
-    if(m_AddSurfaceLayer)
-    {
-      for(int64_t i = 0; i < fileXDim; ++i)
-      {
-        out << "-7 ";
+        for(int64_t i = 0; i < fileXDim; ++i)
+        {
+          buffer.append("-7 ", 3);
+        }
+        buffer.append('\n');
       }
-      out << "\n";
     }
+  });
+  if(!completed)
+  {
+    QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-101, ss);
+    return getErrorCode();
   }
 
   // Add a complete layer of surface voxels
@@ -49,10 +49,9 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/TextFormatter.h"
 #include "ImportExport/ImportExportVersion.h"
 
-#define LLU_CAST(arg) static_cast<unsigned long long int>(arg)
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -203,26 +202,42 @@ int32_t LosAlamosFFTWriter::writeFile()
     return -1;
   }
 
-  float phi1 = 0.0f, phi = 0.0f, phi2 = 0.0f;
-  int32_t featureId = 0;
-  int32_t phaseId = 0;
-
-  size_t index = 0;
-  for(size_t z = 0; z < dims[2]; ++z)
-  {
-    for(size_t y = 0; y < dims[1]; ++y)
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  ImportExport::ParallelTextWriter writer(ImportExport::ParallelTextWriter::FileSink(f));
+  writer.setProgressCallback([this](size_t /* itemsWritten */, size_t /* totalItems */) { return !getCancel(); });
+  bool completed = writer.write(totalPoints, [&](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+    float phi1 = 0.0f, phi = 0.0f, phi2 = 0.0f;
+    for(size_t index = start; index < end; index++)
     {
-      for(size_t x = 0; x < dims[0]; ++x)
-      {
-        index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
-        phi1 = m_CellEulerAngles[index * 3] * 180.0 * SIMPLib::Constants::k_1OverPiD;
-        phi = m_CellEulerAngles[index * 3 + 1] * 180.0 * SIMPLib::Constants::k_1OverPiD;
-        phi2 = m_CellEulerAngles[index * 3 + 2] * 180.0 * SIMPLib::Constants::k_1OverPiD;
-        featureId = m_FeatureIds[index];
-        phaseId = m_CellPhases[index];
-        fprintf(f, "%.3f %.3f %.3f %llu %llu %llu %d %d\n", phi1, phi, phi2, LLU_CAST(x + 1), LLU_CAST(y + 1), LLU_CAST(z + 1), featureId, phaseId);
-      }
+      size_t x = index % dims[0];
+      size_t y = (index / dims[0]) % dims[1];
+      size_t z = index / (dims[0] * dims[1]);
+      phi1 = m_CellEulerAngles[index * 3] * 180.0 * SIMPLib::Constants::k_1OverPiD;
+      phi = m_CellEulerAngles[index * 3 + 1] * 180.0 * SIMPLib::Constants::k_1OverPiD;
+      phi2 = m_CellEulerAngles[index * 3 + 2] * 180.0 * SIMPLib::Constants::k_1OverPiD;
+      buffer.appendFixed(phi1, 3);
+      buffer.append(' ');
+      buffer.appendFixed(phi, 3);
+      buffer.append(' ');
+      buffer.appendFixed(phi2, 3);
+      buffer.append(' ');
+      buffer.appendInt(x + 1);
+      buffer.append(' ');
+      buffer.appendInt(y + 1);
+      buffer.append(' ');
+      buffer.appendInt(z + 1);
+      buffer.append(' ');
+      buffer.appendInt(m_FeatureIds[index]);
+      buffer.append(' ');
+      buffer.appendInt(m_CellPhases[index]);
+      buffer.append('\n');
     }
+  });
+  if(!completed && !getCancel())
+  {
+    QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-1, ss);
+    err = -1;
   }
 
   fclose(f);
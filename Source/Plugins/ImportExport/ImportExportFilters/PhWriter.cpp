@@ -49,6 +49,7 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/TextFormatter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -197,20 +198,25 @@ int32_t PhWriter::writeFile()
     }
   }
 
-  // Buffer the output with 4096 Bytes which is typically the size of a "Block" on a
-  // modern Hard Drive. This should speed up the writes considerably
-  char buffer[4096];
-  outfile.rdbuf()->pubsetbuf(buffer, 4096);
-
   outfile << "     " << dims[0] << "     " << dims[1] << "     " << dims[2] << "\n";
   outfile << "\'DREAM3\'              52.00  1.000  1.0       " << features << "\n";
   outfile << " 0.000 0.000 0.000          0        \n"; // << features << endl;
 
-  for(size_t k = 0; k < totalpoints; k++)
+  ImportExport::ParallelTextWriter writer([&outfile](const char* data, size_t length) { return static_cast<bool>(outfile.write(data, static_cast<std::streamsize>(length))); });
+  bool completed = writer.write(totalpoints, [this](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+    for(size_t k = start; k < end; k++)
+    {
+      buffer.appendInt(m_FeatureIds[k]);
+      buffer.append('\n');
+    }
+  });
+  outfile.close();
+  if(!completed)
   {
-    outfile << m_FeatureIds[k] << '\n';
+    QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-101, ss);
+    return getErrorCode();
   }
-  outfile.close();
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage("Writing Ph File Complete");
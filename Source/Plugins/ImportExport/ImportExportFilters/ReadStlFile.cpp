@@ -36,6 +36,7 @@
 #include "ReadStlFile.h"
 
 #include <cstdio>
+#include <cstring>
 #include <tuple>
 
 #include <QtCore/QFileInfo>
@@ -78,16 +79,92 @@ constexpr int32_t k_TriangleParseError = -1106;
 constexpr int32_t k_AttributeParseError = -1107;
 } // namespace ReadStlFileErrors
 
+namespace
+{
+constexpr size_t k_StlRecordLength = 50;
+constexpr int64_t k_EmptySlot = -1;
+
+// -----------------------------------------------------------------------------
+// Hashes the exact bit pattern of a vertex. -0.0 is folded onto 0.0 so the hash
+// agrees with floating point equality, which is what decides if two vertices weld.
+inline uint64_t hashVertex(const float* v)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for(size_t c = 0; c < 3; c++)
+  {
+    float value = (v[c] == 0.0f) ? 0.0f : v[c];
+    uint32_t bits = 0;
+    ::memcpy(&bits, &value, sizeof(uint32_t));
+    hash = (hash ^ bits) * 1099511628211ULL;
+  }
+  return hash ^ (hash >> 29);
+}
+} // namespace
+
+/**
+ * @brief The DecodeStlTrianglesImpl class implements a threaded algorithm that decodes the
+ * binary STL triangle records from an in memory copy of the file into the vertex, triangle
+ * and face normal arrays
+ */
+class DecodeStlTrianglesImpl
+{
+public:
+  DecodeStlTrianglesImpl(const uint8_t* records, const std::vector<size_t>& recordOffsets, float* nodes, MeshIndexType* triangles, double* faceNormals)
+  : m_Records(records)
+  , m_RecordOffsets(recordOffsets)
+  , m_Nodes(nodes)
+  , m_Triangles(triangles)
+  , m_FaceNormals(faceNormals)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    float v[12];
+    for(size_t t = start; t < end; t++)
+    {
+      size_t offset = m_RecordOffsets.empty() ? t * k_StlRecordLength : m_RecordOffsets[t];
+      ::memcpy(v, m_Records + offset, sizeof(v));
+      m_FaceNormals[3 * t + 0] = static_cast<double>(v[0]);
+      m_FaceNormals[3 * t + 1] = static_cast<double>(v[1]);
+      m_FaceNormals[3 * t + 2] = static_cast<double>(v[2]);
+      ::memcpy(m_Nodes + 9 * t, v + 3, 9 * sizeof(float));
+      m_Triangles[t * 3] = 3 * t + 0;
+      m_Triangles[t * 3 + 1] = 3 * t + 1;
+      m_Triangles[t * 3 + 2] = 3 * t + 2;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const uint8_t* m_Records = nullptr;
+  const std::vector<size_t>& m_RecordOffsets;
+  float* m_Nodes = nullptr;
+  MeshIndexType* m_Triangles = nullptr;
+  double* m_FaceNormals = nullptr;
+};
+
 /**
  * @brief The FindUniqueIdsImpl class implements a threaded algorithm that determines the set of
- * unique vertices in the triangle geometry
+ * unique vertices in the triangle geometry. The vertices have been partitioned by their hash so
+ * each partition is welded independently with its own open addressing table. Vertices inside a
+ * partition are visited in increasing index order, so every duplicate is mapped onto the first
+ * occurrence of its position.
  */
 class FindUniqueIdsImpl
 {
 public:
-  FindUniqueIdsImpl(SharedVertexList::Pointer vertex, const std::vector<std::vector<size_t>>& nodesInBin, int64_t* uniqueIds)
-  : m_Vertex(vertex)
-  , m_NodesInBin(nodesInBin)
+  FindUniqueIdsImpl(const float* verts, const std::vector<uint64_t>& hashes, const std::vector<size_t>& partitionOffsets, const std::vector<size_t>& partitionNodes, int64_t* uniqueIds)
+  : m_Verts(verts)
+  , m_Hashes(hashes)
+  , m_PartitionOffsets(partitionOffsets)
+  , m_PartitionNodes(partitionNodes)
   , m_UniqueIds(uniqueIds)
   {
   }
@@ -95,22 +172,42 @@ public:
   // -----------------------------------------------------------------------------
   void convert(size_t start, size_t end) const
   {
-    float* verts = m_Vertex->getPointer(0);
-    for(size_t i = start; i < end; i++)
+    std::vector<int64_t> table;
+    for(size_t p = start; p < end; p++)
     {
-      for(size_t j = 0; j < m_NodesInBin[i].size(); j++)
+      size_t count = m_PartitionOffsets[p + 1] - m_PartitionOffsets[p];
+      if(count == 0)
+      {
+        continue;
+      }
+      size_t tableSize = 16;
+      while(tableSize < count * 2)
+      {
+        tableSize <<= 1;
+      }
+      size_t mask = tableSize - 1;
+      table.assign(tableSize, k_EmptySlot);
+
+      for(size_t n = m_PartitionOffsets[p]; n < m_PartitionOffsets[p + 1]; n++)
       {
-        size_t node1 = m_NodesInBin[i][j];
-        if(m_UniqueIds[node1] == static_cast<int64_t>(node1))
+        size_t node = m_PartitionNodes[n];
+        const float* v = m_Verts + node * 3;
+        size_t slot = static_cast<size_t>(m_Hashes[node]) & mask;
+        while(true)
         {
-          for(size_t k = j + 1; k < m_NodesInBin[i].size(); k++)
+          int64_t candidate = table[slot];
+          if(candidate == k_EmptySlot)
           {
-            size_t node2 = m_NodesInBin[i][k];
-            if(verts[node1 * 3] == verts[node2 * 3] && verts[node1 * 3 + 1] == verts[node2 * 3 + 1] && verts[node1 * 3 + 2] == verts[node2 * 3 + 2])
-            {
-              m_UniqueIds[node2] = node1;
-            }
+            table[slot] = static_cast<int64_t>(node);
+            break;
           }
+          const float* c = m_Verts + candidate * 3;
+          if(m_Hashes[candidate] == m_Hashes[node] && c[0] == v[0] && c[1] == v[1] && c[2] == v[2])
+          {
+            m_UniqueIds[node] = candidate;
+            break;
+          }
+          slot = (slot + 1) & mask;
         }
       }
     }
@@ -123,11 +220,39 @@ public:
   }
 
 private:
-  SharedVertexList::Pointer m_Vertex;
-  const std::vector<std::vector<size_t>>& m_NodesInBin;
+  const float* m_Verts = nullptr;
+  const std::vector<uint64_t>& m_Hashes;
+  const std::vector<size_t>& m_PartitionOffsets;
+  const std::vector<size_t>& m_PartitionNodes;
   int64_t* m_UniqueIds = nullptr;
 };
 
+/**
+ * @brief The HashVerticesImpl class computes the weld hash of every vertex
+ */
+class HashVerticesImpl
+{
+public:
+  HashVerticesImpl(const float* verts, std::vector<uint64_t>& hashes)
+  : m_Verts(verts)
+  , m_Hashes(hashes)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      m_Hashes[i] = hashVertex(m_Verts + i * 3);
+    }
+  }
+
+private:
+  const float* m_Verts = nullptr;
+  std::vector<uint64_t>& m_Hashes;
+};
+
 // -----------------------------------------------------------------------------
 // Returns 0 for Binary, 1 for ASCII, anything else is an error.
 int32_t getStlFileType(const std::string& path)
@@ -229,12 +354,6 @@ void ReadStlFile::updateFaceInstancePointers()
 // -----------------------------------------------------------------------------
 void ReadStlFile::initialize()
 {
-  m_minXcoord = std::numeric_limits<float>::max();
-  m_maxXcoord = -std::numeric_limits<float>::max();
-  m_minYcoord = std::numeric_limits<float>::max();
-  m_maxYcoord = -std::numeric_limits<float>::max();
-  m_minZcoord = std::numeric_limits<float>::max();
-  m_maxZcoord = -std::numeric_limits<float>::max();
 }
 
 // -----------------------------------------------------------------------------
@@ -369,6 +488,60 @@ void ReadStlFile::readFile()
     return;
   }
 
+  // Pull the remainder of the file into memory with a single read
+  int64_t fileSize = static_cast<int64_t>(QFileInfo(m_StlFilePath).size());
+  int64_t recordBytes = fileSize - STL_HEADER_LENGTH - static_cast<int64_t>(sizeof(int32_t));
+  if(triCount < 0 || recordBytes < static_cast<int64_t>(triCount) * static_cast<int64_t>(k_StlRecordLength))
+  {
+    QString msg = QString("Error reading Triangles. The file holds %1 bytes of triangle data but the header declares %2 triangles").arg(recordBytes).arg(triCount);
+    setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
+    std::ignore = fclose(f);
+    return;
+  }
+  std::vector<uint8_t> records(static_cast<size_t>(recordBytes));
+  size_t objsRead = std::fread(records.data(), 1, records.size(), f);
+  std::ignore = fclose(f);
+  if(objsRead != records.size())
+  {
+    QString msg = QString("Error reading Triangles. Read %1 of %2 bytes").arg(objsRead).arg(records.size());
+    setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
+    return;
+  }
+
+  // Records are normally a fixed 50 bytes. Only when a (non Magics) file carries
+  // attribute data do we need to walk the records to find where each one starts.
+  std::vector<size_t> recordOffsets;
+  if(!magicsFile)
+  {
+    uint16_t attr = 0;
+    for(size_t t = 0; t < static_cast<size_t>(triCount); t++)
+    {
+      ::memcpy(&attr, records.data() + t * k_StlRecordLength + 48, sizeof(uint16_t));
+      if(attr > 0)
+      {
+        break;
+      }
+    }
+    if(attr > 0)
+    {
+      recordOffsets.resize(static_cast<size_t>(triCount));
+      size_t offset = 0;
+      for(size_t t = 0; t < static_cast<size_t>(triCount); t++)
+      {
+        if(offset + k_StlRecordLength > records.size())
+        {
+          QString msg = QString("Error reading Triangle '%1'. The attribute data runs past the end of the file").arg(t);
+          setErrorCondition(ReadStlFileErrors::k_AttributeParseError, msg);
+          return;
+        }
+        recordOffsets[t] = offset;
+        ::memcpy(&attr, records.data() + offset + 48, sizeof(uint16_t));
+        // Skip past the Triangle Attribute data since we don't know how to read it anyways
+        offset += k_StlRecordLength + static_cast<size_t>(attr);
+      }
+    }
+  }
+
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   triangleGeom->resizeTriList(triCount);
   triangleGeom->resizeVertexList(triCount * 3);
@@ -380,129 +553,15 @@ void ReadStlFile::readFile()
   sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
   updateFaceInstancePointers();
 
-  // Read the triangles
-  static const size_t k_StlElementCount = 12;
-  float v[k_StlElementCount];
-  uint16_t attr;
-  std::vector<uint8_t> triangleAttributeBuffer(std::numeric_limits<uint16_t>::max()); // Just allocate a buffer of max UINT16 elements
-  for(int32_t t = 0; t < triCount; ++t)
+  if(getCancel())
   {
-    size_t objsRead = std::fread(reinterpret_cast<void*>(v), sizeof(float), k_StlElementCount, f); // Read the Triangle
-    if(k_StlElementCount != objsRead)
-    {
-      QString msg = QString("Error reading Triangle '%1'. Object Count was %2 and should have been %3").arg(t, objsRead, k_StlElementCount);
-      setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
-      std::ignore = fclose(f);
-      return;
-    }
-
-    objsRead = std::fread(reinterpret_cast<void*>(&attr), sizeof(uint16_t), 1, f); // Read the Triangle Attribute Data length
-    if(objsRead != 1)
-    {
-      QString msg = QString("Error reading Number of attributes for triangle '%1'. Object Count was %2 and should have been 1").arg(t, objsRead);
-      setErrorCondition(ReadStlFileErrors::k_AttributeParseError, msg);
-      std::ignore = fclose(f);
-      return;
-    }
-    if(attr > 0 && !magicsFile)
-    {
-      std::ignore = std::fseek(f, static_cast<size_t>(attr), SEEK_CUR); // Skip past the Triangle Attribute data since we don't know how to read it anyways
-    }
-    if(v[3] < m_minXcoord)
-    {
-      m_minXcoord = v[3];
-    }
-    if(v[3] > m_maxXcoord)
-    {
-      m_maxXcoord = v[3];
-    }
-    if(v[4] < m_minYcoord)
-    {
-      m_minYcoord = v[4];
-    }
-    if(v[4] > m_maxYcoord)
-    {
-      m_maxYcoord = v[4];
-    }
-    if(v[5] < m_minZcoord)
-    {
-      m_minZcoord = v[5];
-    }
-    if(v[5] > m_maxZcoord)
-    {
-      m_maxZcoord = v[5];
-    }
-    if(v[6] < m_minXcoord)
-    {
-      m_minXcoord = v[6];
-    }
-    if(v[6] > m_maxXcoord)
-    {
-      m_maxXcoord = v[6];
-    }
-    if(v[7] < m_minYcoord)
-    {
-      m_minYcoord = v[7];
-    }
-    if(v[7] > m_maxYcoord)
-    {
-      m_maxYcoord = v[7];
-    }
-    if(v[8] < m_minZcoord)
-    {
-      m_minZcoord = v[8];
-    }
-    if(v[8] > m_maxZcoord)
-    {
-      m_maxZcoord = v[8];
-    }
-    if(v[9] < m_minXcoord)
-    {
-      m_minXcoord = v[9];
-    }
-    if(v[9] > m_maxXcoord)
-    {
-      m_maxXcoord = v[9];
-    }
-    if(v[10] < m_minYcoord)
-    {
-      m_minYcoord = v[10];
-    }
-    if(v[10] > m_maxYcoord)
-    {
-      m_maxYcoord = v[10];
-    }
-    if(v[11] < m_minZcoord)
-    {
-      m_minZcoord = v[11];
-    }
-    if(v[11] > m_maxZcoord)
-    {
-      m_maxZcoord = v[11];
-    }
-    m_FaceNormals[3 * t + 0] = static_cast<double>(v[0]);
-    m_FaceNormals[3 * t + 1] = static_cast<double>(v[1]);
-    m_FaceNormals[3 * t + 2] = static_cast<double>(v[2]);
-    nodes[3 * (3 * t + 0) + 0] = v[3];
-    nodes[3 * (3 * t + 0) + 1] = v[4];
-    nodes[3 * (3 * t + 0) + 2] = v[5];
-    nodes[3 * (3 * t + 1) + 0] = v[6];
-    nodes[3 * (3 * t + 1) + 1] = v[7];
-    nodes[3 * (3 * t + 1) + 2] = v[8];
-    nodes[3 * (3 * t + 2) + 0] = v[9];
-    nodes[3 * (3 * t + 2) + 1] = v[10];
-    nodes[3 * (3 * t + 2) + 2] = v[11];
-    triangles[t * 3] = 3 * t + 0;
-    triangles[t * 3 + 1] = 3 * t + 1;
-    triangles[t * 3 + 2] = 3 * t + 2;
-    if(getCancel())
-    {
-      std::ignore = fclose(f);
-      return;
-    }
+    return;
   }
 
-  std::ignore = fclose(f);
+  // Decode the triangles in parallel
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, static_cast<size_t>(triCount));
+  dataAlg.execute(DecodeStlTrianglesImpl(records.data(), recordOffsets, nodes, triangles, m_FaceNormals));
 }
 
 // -----------------------------------------------------------------------------
@@ -522,33 +581,39 @@ void ReadStlFile::eliminate_duplicate_nodes()
   {
     nNodes = static_cast<size_t>(nNodes_);
   }
-  float stepX = (m_maxXcoord - m_minXcoord) / 100.0f;
-  float stepY = (m_maxYcoord - m_minYcoord) / 100.0f;
-  float stepZ = (m_maxZcoord - m_minZcoord) / 100.0f;
 
-  std::vector<std::vector<size_t>> nodesInBin(100 * 100 * 100);
+  // Hash every vertex on its exact position
+  std::vector<uint64_t> hashes(nNodes);
+  ParallelDataAlgorithm hashAlg;
+  hashAlg.setRange(0, nNodes);
+  hashAlg.execute(HashVerticesImpl(vertex, hashes));
 
-  // determine (xyz) bin each node falls in - used to speed up node comparison
-  int32_t bin = 0, xBin = 0, yBin = 0, zBin = 0;
+  // Partition the vertices by hash with a counting sort. Duplicates always land in
+  // the same partition and each partition keeps its vertices in index order.
+  size_t numPartitions = 1;
+  while(numPartitions < 4096 && numPartitions * 1024 < nNodes)
+  {
+    numPartitions <<= 1;
+  }
+  std::vector<size_t> partitionOffsets(numPartitions + 1, 0);
   for(size_t i = 0; i < nNodes; i++)
   {
-    xBin = static_cast<int32_t>((vertex[i * 3] - m_minXcoord) / stepX);
-    yBin = static_cast<int32_t>((vertex[i * 3 + 1] - m_minYcoord) / stepY);
-    zBin = static_cast<int32_t>((vertex[i * 3 + 2] - m_minZcoord) / stepZ);
-    if(xBin == 100)
-    {
-      xBin = 99;
-    }
-    if(yBin == 100)
-    {
-      yBin = 99;
-    }
-    if(zBin == 100)
+    partitionOffsets[(hashes[i] >> 40) & (numPartitions - 1)]++;
+  }
+  size_t sum = 0;
+  for(size_t p = 0; p <= numPartitions; p++)
+  {
+    size_t count = partitionOffsets[p];
+    partitionOffsets[p] = sum;
+    sum += count;
+  }
+  std::vector<size_t> partitionNodes(nNodes);
+  {
+    std::vector<size_t> cursor(partitionOffsets.begin(), partitionOffsets.end() - 1);
+    for(size_t i = 0; i < nNodes; i++)
     {
-      zBin = 99;
+      partitionNodes[cursor[(hashes[i] >> 40) & (numPartitions - 1)]++] = i;
     }
-    bin = (zBin * 10000) + (yBin * 100) + xBin;
-    nodesInBin[bin].push_back(i);
   }
 
   // Create array to hold unique node numbers
@@ -561,8 +626,8 @@ void ReadStlFile::eliminate_duplicate_nodes()
 
   // Parallel algorithm to find duplicate nodes
   ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0ULL, static_cast<size_t>(100 * 100 * 100));
-  dataAlg.execute(FindUniqueIdsImpl(triangleGeom->getVertices(), nodesInBin, uniqueIds));
+  dataAlg.setRange(0, numPartitions);
+  dataAlg.execute(FindUniqueIdsImpl(vertex, hashes, partitionOffsets, partitionNodes, uniqueIds));
 
   // renumber the unique nodes
   int64_t uniqueCount = 0;
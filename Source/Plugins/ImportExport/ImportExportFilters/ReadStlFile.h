@@ -217,13 +217,6 @@ private:
   QString m_StlFilePath = {""};
   QString m_FaceNormalsArrayName = {SIMPL::FaceData::SurfaceMeshFaceNormals};
 
-  float m_minXcoord = {std::numeric_limits<float>::max()};
-  float m_maxXcoord = {-std::numeric_limits<float>::max()};
-  float m_minYcoord = {std::numeric_limits<float>::max()};
-  float m_maxYcoord = {-std::numeric_limits<float>::max()};
-  float m_minZcoord = {std::numeric_limits<float>::max()};
-  float m_maxZcoord = {-std::numeric_limits<float>::max()};
-
   /**
    * @brief updateFaceInstancePointers Updates raw Face pointers
    */
@@ -50,6 +50,7 @@
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/TextFormatter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -200,39 +201,40 @@ int32_t SPParksSitesWriter::writeFile()
   qint64 estimatedTime = 0;
   float timeDiff = 0.0f;
 
-  int64_t increment = static_cast<int64_t>(totalpoints * 0.01f);
-  size_t count = 0;
   QString buf;
   QTextStream ss(&buf);
-  // Buffer the output with 4096 Bytes which is typically the size of a "Block" on a
-  // modern Hard Drive. This should speed up the writes considerably
-  char buffer[4096];
-  outfile.rdbuf()->pubsetbuf(buffer, 4096);
-  for(size_t k = 0; k < totalpoints; k++)
-  {
-    if(count % increment == 0)
+
+  ImportExport::ParallelTextWriter writer([&outfile](const char* data, size_t length) { return static_cast<bool>(outfile.write(data, static_cast<std::streamsize>(length))); });
+  writer.setProgressCallback([&](size_t itemsWritten, size_t totalItems) {
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
     {
-      currentMillis = QDateTime::currentMSecsSinceEpoch();
-      if(currentMillis - millis > 1000)
-      {
-        buf.clear();
-        ss << static_cast<int>((float)(k) / (float)(totalpoints)*100) << " % Completed ";
-        timeDiff = ((float)k / (float)(currentMillis - startMillis));
-        estimatedTime = (float)(totalpoints - k) / timeDiff;
-        ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-        notifyStatusMessage(buf);
-        millis = QDateTime::currentMSecsSinceEpoch();
-      }
+      buf.clear();
+      ss << static_cast<int>((float)(itemsWritten) / (float)(totalItems)*100) << " % Completed ";
+      timeDiff = ((float)itemsWritten / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalItems - itemsWritten) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
     }
-    count++;
-    //    double temp0 = 0.0;
-    //    double temp1 = 0.0;
-    outfile << k + 1 << " "
-            << m_FeatureIds[k]
-            /* << " " << temp0 << " " << temp1 */
-            << "\n";
-  }
+    return !getCancel();
+  });
+  bool completed = writer.write(totalpoints, [this](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+    for(size_t k = start; k < end; k++)
+    {
+      buffer.appendInt(k + 1);
+      buffer.append(' ');
+      buffer.appendInt(m_FeatureIds[k]);
+      buffer.append('\n');
+    }
+  });
   outfile.close();
+  if(!completed && !getCancel())
+  {
+    QString msg = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-101, msg);
+    return getErrorCode();
+  }
 
   return 0;
 }
@@ -77,6 +77,7 @@ endforeach()
 
 #-------------
 # These are files that need to be compiled into DREAM3DLib but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/TextFormatter.h)
 
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
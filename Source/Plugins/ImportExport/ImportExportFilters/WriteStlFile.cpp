@@ -34,6 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "WriteStlFile.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -46,12 +49,172 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include <QtCore/QDir>
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
+namespace
+{
+constexpr size_t k_StlHeaderLength = 80;
+constexpr size_t k_StlRecordLength = 50;
+constexpr size_t k_RecordsPerChunk = 16384;
+} // namespace
+
+/**
+ * @brief The WriteStlFeaturesImpl class writes one binary STL file per Feature from
+ * triangle lists that have already been bucketed by Feature Id. Records are
+ * assembled in a buffer and flushed in large chunks.
+ */
+class WriteStlFeaturesImpl
+{
+public:
+  WriteStlFeaturesImpl(WriteStlFile* filter, const std::vector<int32_t>& featureIds, const std::vector<MeshIndexType>& bucketOffsets, const std::vector<MeshIndexType>& bucketEntries,
+                       const std::vector<int32_t>& bucketPhases, float* nodes, MeshIndexType* triangles)
+  : m_Filter(filter)
+  , m_FeatureIds(featureIds)
+  , m_BucketOffsets(bucketOffsets)
+  , m_BucketEntries(bucketEntries)
+  , m_BucketPhases(bucketPhases)
+  , m_Nodes(nodes)
+  , m_Triangles(triangles)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void writeFeature(size_t bucket, std::vector<uint8_t>& buffer) const
+  {
+    int32_t featureId = m_FeatureIds[bucket];
+    MeshIndexType start = m_BucketOffsets[bucket];
+    MeshIndexType end = m_BucketOffsets[bucket + 1];
+    int32_t triCount = static_cast<int32_t>(end - start);
+    bool groupByPhase = m_Filter->getGroupByPhase();
+
+    QString filename = m_Filter->getOutputStlDirectory() + "/" + m_Filter->getOutputStlPrefix();
+    QString header = "DREAM3D Generated For Feature ID " + QString::number(featureId);
+    if(groupByPhase)
+    {
+      filename = filename + QString("Ensemble_") + QString::number(m_BucketPhases[bucket]) + QString("_");
+      header = header + " Phase " + QString::number(m_BucketPhases[bucket]);
+    }
+    filename = filename + QString("Feature_") + QString::number(featureId) + ".stl";
+
+    FILE* f = fopen(filename.toLatin1().data(), "wb");
+    if(nullptr == f)
+    {
+      m_Filter->incrementWriteErrorCount();
+      return;
+    }
+
+    // The triangle count is known up front, so the header is written complete
+    uint8_t* data = buffer.data();
+    std::string headerStr = header.toStdString();
+    ::memset(data, 0, k_StlHeaderLength);
+    ::memcpy(data, headerStr.data(), std::min(headerStr.size(), k_StlHeaderLength));
+    ::memcpy(data + k_StlHeaderLength, &triCount, sizeof(int32_t));
+    if(fwrite(data, 1, k_StlHeaderLength + sizeof(int32_t), f) != k_StlHeaderLength + sizeof(int32_t))
+    {
+      m_Filter->incrementWriteErrorCount();
+      fclose(f);
+      return;
+    }
+
+    float record[12] = {0.0f};
+    float* normal = record;
+    float* vert1 = record + 3;
+    float* vert2 = record + 6;
+    float* vert3 = record + 9;
+    uint16_t attrByteCount = 0;
+    float u[3] = {0.0f, 0.0f, 0.0f}, w[3] = {0.0f, 0.0f, 0.0f};
+    float length = 0.0f;
+
+    size_t bufferedRecords = 0;
+    for(MeshIndexType e = start; e < end; e++)
+    {
+      MeshIndexType t = m_BucketEntries[e] / 2;
+      MeshIndexType nId0 = m_Triangles[t * 3];
+      MeshIndexType nId1 = m_Triangles[t * 3 + 1];
+      MeshIndexType nId2 = m_Triangles[t * 3 + 2];
+      if((m_BucketEntries[e] & 1) == 1)
+      {
+        // The Feature is on the back side of this face, so switch the 2 node indices
+        std::swap(nId1, nId2);
+      }
+
+      vert1[0] = m_Nodes[nId0 * 3];
+      vert1[1] = m_Nodes[nId0 * 3 + 1];
+      vert1[2] = m_Nodes[nId0 * 3 + 2];
+      vert2[0] = m_Nodes[nId1 * 3];
+      vert2[1] = m_Nodes[nId1 * 3 + 1];
+      vert2[2] = m_Nodes[nId1 * 3 + 2];
+      vert3[0] = m_Nodes[nId2 * 3];
+      vert3[1] = m_Nodes[nId2 * 3 + 1];
+      vert3[2] = m_Nodes[nId2 * 3 + 2];
+
+      // Compute the normal
+      u[0] = vert2[0] - vert1[0];
+      u[1] = vert2[1] - vert1[1];
+      u[2] = vert2[2] - vert1[2];
+
+      w[0] = vert3[0] - vert1[0];
+      w[1] = vert3[1] - vert1[1];
+      w[2] = vert3[2] - vert1[2];
+
+      normal[0] = u[1] * w[2] - u[2] * w[1];
+      normal[1] = u[2] * w[0] - u[0] * w[2];
+      normal[2] = u[0] * w[1] - u[1] * w[0];
+
+      length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      normal[0] = normal[0] / length;
+      normal[1] = normal[1] / length;
+      normal[2] = normal[2] / length;
+
+      uint8_t* dest = data + bufferedRecords * k_StlRecordLength;
+      ::memcpy(dest, record, sizeof(record));
+      ::memcpy(dest + sizeof(record), &attrByteCount, sizeof(uint16_t));
+      bufferedRecords++;
+
+      if(bufferedRecords == k_RecordsPerChunk || e + 1 == end)
+      {
+        size_t byteCount = bufferedRecords * k_StlRecordLength;
+        if(fwrite(data, 1, byteCount, f) != byteCount)
+        {
+          m_Filter->incrementWriteErrorCount();
+          fclose(f);
+          return;
+        }
+        bufferedRecords = 0;
+      }
+    }
+    fclose(f);
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    std::vector<uint8_t> buffer(k_RecordsPerChunk * k_StlRecordLength);
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      writeFeature(i, buffer);
+    }
+  }
+
+private:
+  WriteStlFile* m_Filter = nullptr;
+  const std::vector<int32_t>& m_FeatureIds;
+  const std::vector<MeshIndexType>& m_BucketOffsets;
+  const std::vector<MeshIndexType>& m_BucketEntries;
+  const std::vector<int32_t>& m_BucketPhases;
+  float* m_Nodes = nullptr;
+  MeshIndexType* m_Triangles = nullptr;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -184,7 +347,6 @@ void WriteStlFile::dataCheck()
 // -----------------------------------------------------------------------------
 void WriteStlFile::execute()
 {
-  int32_t err = 0;
   clearErrorCode();
   clearWarningCode();
   dataCheck();
@@ -215,178 +377,88 @@ void WriteStlFile::execute()
     return;
   }
 
-  // Store all the unique Spins
-  QMap<int32_t, int32_t> uniqueGrainIdtoPhase;
-  if(m_GroupByPhase)
+  if(nTriangles == 0)
   {
-    for(MeshIndexType i = 0; i < nTriangles; i++)
-    {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], m_SurfaceMeshFacePhases[i * 2]);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], m_SurfaceMeshFacePhases[i * 2 + 1]);
-    }
+    return;
   }
-  else
+
+  // Only labels that actually appear in the mesh produce a file. The labels are
+  // compacted to their sorted distinct values, so the buckets are sized by the
+  // number of Features and not by the range of the Feature Ids.
+  std::vector<int32_t> featureIds(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceLabels + nTriangles * 2);
+  std::sort(featureIds.begin(), featureIds.end());
+  featureIds.erase(std::unique(featureIds.begin(), featureIds.end()), featureIds.end());
+  auto bucketOf = [&featureIds](int32_t label) -> size_t { return static_cast<size_t>(std::lower_bound(featureIds.begin(), featureIds.end(), label) - featureIds.begin()); };
+
+  // Bucket the triangles by Feature with a counting sort. Each triangle is
+  // listed under both of its labels and the side is kept so the writer can
+  // flip the winding when the Feature is on the back of the face.
+  size_t numBuckets = featureIds.size();
+  std::vector<MeshIndexType> bucketOffsets(numBuckets + 1, 0);
+  std::vector<int32_t> bucketPhases(numBuckets, 0);
+  for(MeshIndexType t = 0; t < nTriangles; t++)
   {
-    for(MeshIndexType i = 0; i < nTriangles; i++)
+    bucketOffsets[bucketOf(m_SurfaceMeshFaceLabels[t * 2]) + 1]++;
+    // A face with the same label on both sides is only written once, with the forward winding
+    if(m_SurfaceMeshFaceLabels[t * 2 + 1] != m_SurfaceMeshFaceLabels[t * 2])
     {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], 0);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], 0);
+      bucketOffsets[bucketOf(m_SurfaceMeshFaceLabels[t * 2 + 1]) + 1]++;
     }
   }
-
-  unsigned char data[50];
-  float* normal = reinterpret_cast<float*>(data);
-  float* vert1 = reinterpret_cast<float*>(data + 12);
-  float* vert2 = reinterpret_cast<float*>(data + 24);
-  float* vert3 = reinterpret_cast<float*>(data + 36);
-  uint16_t* attrByteCount = reinterpret_cast<uint16_t*>(data + 48);
-  *attrByteCount = 0;
-
-  size_t totalWritten = 0;
-  float u[3] = {0.0f, 0.0f, 0.0f}, w[3] = {0.0f, 0.0f, 0.0f};
-  float length = 0.0f;
-
-  int32_t spin = 0;
-  int32_t triCount = 0;
-
-  // Loop over the unique Spins
-  for(QMap<int32_t, int32_t>::iterator spinIter = uniqueGrainIdtoPhase.begin(); spinIter != uniqueGrainIdtoPhase.end(); ++spinIter)
+  for(size_t b = 0; b < numBuckets; b++)
   {
-    spin = spinIter.key();
-
-    // Generate the output file name
-    QString filename = getOutputStlDirectory() + "/" + getOutputStlPrefix();
-    if(m_GroupByPhase)
-    {
-      filename = filename + QString("Ensemble_") + QString::number(spinIter.value()) + QString("_");
-    }
-    filename = filename + QString("Feature_") + QString::number(spin) + ".stl";
-    FILE* f = fopen(filename.toLatin1().data(), "wb");
-
-    QString ss = QObject::tr("Writing STL for Feature Id %1").arg(spin);
-    notifyStatusMessage(ss);
-
-    QString header = "DREAM3D Generated For Feature ID " + QString::number(spin);
-    if(m_GroupByPhase)
-    {
-      header = header + " Phase " + QString::number(spinIter.value());
-    }
-    err = writeHeader(f, header, 0);
-    if(err < 0)
-    {
-    }
-    triCount = 0; // Reset this to Zero. Increment for every triangle written
+    bucketOffsets[b + 1] += bucketOffsets[b];
+  }
 
-    // Loop over all the triangles for this spin
-    for(MeshIndexType t = 0; t < nTriangles; ++t)
+  // Entries are stored as (triangle index * 2 + side)
+  std::vector<MeshIndexType> bucketEntries(bucketOffsets[numBuckets]);
+  {
+    std::vector<MeshIndexType> cursor(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for(MeshIndexType t = 0; t < nTriangles; t++)
     {
-      // Get the true indices of the 3 nodes
-      MeshIndexType nId0 = triangles[t * 3];
-      MeshIndexType nId1 = triangles[t * 3 + 1];
-      MeshIndexType nId2 = triangles[t * 3 + 2];
-
-      vert1[0] = static_cast<float>(nodes[nId0 * 3]);
-      vert1[1] = static_cast<float>(nodes[nId0 * 3 + 1]);
-      vert1[2] = static_cast<float>(nodes[nId0 * 3 + 2]);
-
-      if(m_SurfaceMeshFaceLabels[t * 2] == spin)
-      {
-        // winding = 0; // 0 = Write it using forward spin
-      }
-      else if(m_SurfaceMeshFaceLabels[t * 2 + 1] == spin)
-      {
-        // winding = 1; // Write it using backward spin
-        // Switch the 2 node indices
-        MeshIndexType temp = nId1;
-        nId1 = nId2;
-        nId2 = temp;
-      }
-      else
-      {
-        continue; // We do not match either spin so move to the next triangle
-      }
-
-      vert2[0] = static_cast<float>(nodes[nId1 * 3]);
-      vert2[1] = static_cast<float>(nodes[nId1 * 3 + 1]);
-      vert2[2] = static_cast<float>(nodes[nId1 * 3 + 2]);
-
-      vert3[0] = static_cast<float>(nodes[nId2 * 3]);
-      vert3[1] = static_cast<float>(nodes[nId2 * 3 + 1]);
-      vert3[2] = static_cast<float>(nodes[nId2 * 3 + 2]);
-
-      // Compute the normal
-      u[0] = vert2[0] - vert1[0];
-      u[1] = vert2[1] - vert1[1];
-      u[2] = vert2[2] - vert1[2];
-
-      w[0] = vert3[0] - vert1[0];
-      w[1] = vert3[1] - vert1[1];
-      w[2] = vert3[2] - vert1[2];
-
-      normal[0] = u[1] * w[2] - u[2] * w[1];
-      normal[1] = u[2] * w[0] - u[0] * w[2];
-      normal[2] = u[0] * w[1] - u[1] * w[0];
-
-      length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
-      normal[0] = normal[0] / length;
-      normal[1] = normal[1] / length;
-      normal[2] = normal[2] / length;
-
-      totalWritten = fwrite(data, 1, 50, f);
-      if(totalWritten != 50)
+      for(MeshIndexType side = 0; side < 2; side++)
       {
-        QString ss = QObject::tr("Error Writing STL File. Not enough elements written for Feature Id %1. Wrote %2 of 50.").arg(spin).arg(totalWritten);
-        setErrorCondition(-1201, ss);
+        if(side == 1 && m_SurfaceMeshFaceLabels[t * 2 + 1] == m_SurfaceMeshFaceLabels[t * 2])
+        {
+          continue;
+        }
+        size_t bucket = bucketOf(m_SurfaceMeshFaceLabels[t * 2 + side]);
+        bucketEntries[cursor[bucket]++] = t * 2 + side;
+        if(m_GroupByPhase)
+        {
+          bucketPhases[bucket] = m_SurfaceMeshFacePhases[t * 2 + side];
+        }
       }
-      triCount++;
     }
-    fclose(f);
-    err = writeNumTrianglesToFile(filename, triCount);
   }
 
-  clearErrorCode();
-  clearWarningCode();
-}
+  QString ss = QObject::tr("Writing STL files for %1 Features").arg(featureIds.size());
+  notifyStatusMessage(ss);
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeHeader(FILE* f, const QString& header, int32_t triCount)
-{
-  if(nullptr == f)
-  {
-    return -1;
-  }
-  char h[80];
-  size_t headlength = 80;
-  if(header.length() < 80)
+  // Each task writes whole Features, so at most one file per worker thread is open at any time
+  m_WriteErrorCount = 0;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, featureIds.size());
+  dataAlg.setGrain(1);
+  dataAlg.execute(WriteStlFeaturesImpl(this, featureIds, bucketOffsets, bucketEntries, bucketPhases, nodes, triangles));
+
+  if(m_WriteErrorCount > 0)
   {
-    headlength = static_cast<size_t>(header.length());
+    ss = QObject::tr("Error writing %1 of %2 STL files to '%3'").arg(m_WriteErrorCount.load()).arg(featureIds.size()).arg(getOutputStlDirectory());
+    setErrorCondition(-1201, ss);
+    return;
   }
 
-  std::string c_str = header.toStdString();
-  ::memset(h, 0, 80);
-  ::memcpy(h, c_str.data(), headlength);
-  // Return the number of bytes written - which should be 80
-  fwrite(h, 1, 80, f);
-  fwrite(&triCount, 1, 4, f);
-  return 0;
+  clearErrorCode();
+  clearWarningCode();
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeNumTrianglesToFile(const QString& filename, int32_t triCount)
+void WriteStlFile::incrementWriteErrorCount()
 {
-  // We need to update the number of triangles in the file
-  int32_t err = 0;
-
-  FILE* out = fopen(filename.toLatin1().data(), "r+b");
-  fseek(out, 80L, SEEK_SET);
-  fwrite(reinterpret_cast<char*>(&triCount), 1, 4, out);
-  fclose(out);
-
-  return err;
+  m_WriteErrorCount++;
 }
 
 // -----------------------------------------------------------------------------
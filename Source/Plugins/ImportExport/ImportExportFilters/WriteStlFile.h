@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include "SIMPLib/SIMPLib.h"
@@ -149,6 +150,11 @@ public:
   DataArrayPath getSurfaceMeshFacePhasesArrayPath() const;
   Q_PROPERTY(DataArrayPath SurfaceMeshFacePhasesArrayPath READ getSurfaceMeshFacePhasesArrayPath WRITE setSurfaceMeshFacePhasesArrayPath)
 
+  /**
+   * @brief incrementWriteErrorCount Records that an STL file could not be written
+   */
+  void incrementWriteErrorCount();
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -245,22 +251,7 @@ private:
   DataArrayPath m_SurfaceMeshFaceLabelsArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels};
   DataArrayPath m_SurfaceMeshFacePhasesArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFacePhases};
 
-  /**
-   * @brief writeHeader Writes the header of the STL file
-   * @param f File instance pointer
-   * @param header Header to write to file
-   * @param triCount Number of triangles
-   * @return Integer error value
-   */
-  int32_t writeHeader(FILE* f, const QString& header, int32_t triCount);
-
-  /**
-   * @brief writeNumTrianglesToFile Writes the number of triangles to the STL file
-   * @param filename Name of the output file
-   * @param triCount Number of triangles
-   * @return Integer error value
-   */
-  int32_t writeNumTrianglesToFile(const QString& filename, int32_t triCount);
+  std::atomic<int32_t> m_WriteErrorCount{0};
 
 public:
   WriteStlFile(const WriteStlFile&) = delete;            // Copy Constructor Not Implemented
@@ -0,0 +1,278 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace ImportExport
+{
+
+/**
+ * @brief The TextBuffer class is a growable character buffer that formats numbers with
+ * std::to_chars instead of going through printf or iostreams. The output matches the
+ * "%d", "%llu" and "%.Nf" printf conversions.
+ */
+class TextBuffer
+{
+public:
+  explicit TextBuffer(size_t capacity = 1024 * 1024)
+  {
+    m_Data.resize(capacity);
+  }
+
+  const char* data() const
+  {
+    return m_Data.data();
+  }
+
+  size_t size() const
+  {
+    return m_Size;
+  }
+
+  void clear()
+  {
+    m_Size = 0;
+  }
+
+  void append(char c)
+  {
+    reserve(1);
+    m_Data[m_Size++] = c;
+  }
+
+  void append(const char* str, size_t length)
+  {
+    reserve(length);
+    ::memcpy(m_Data.data() + m_Size, str, length);
+    m_Size += length;
+  }
+
+  void append(const char* str)
+  {
+    append(str, ::strlen(str));
+  }
+
+  void append(const std::string& str)
+  {
+    append(str.data(), str.size());
+  }
+
+  /**
+   * @brief appendInt Appends any integer type in base 10
+   */
+  template <typename T>
+  void appendInt(T value)
+  {
+    reserve(k_MaxNumberLength);
+    std::to_chars_result result = std::to_chars(m_Data.data() + m_Size, m_Data.data() + m_Data.size(), value);
+    m_Size = static_cast<size_t>(result.ptr - m_Data.data());
+  }
+
+  /**
+   * @brief appendFixed Appends a floating point value in fixed notation with the given
+   * number of digits after the decimal point, the same as the "%.Nf" printf conversion.
+   */
+  void appendFixed(double value, int32_t precision = 6)
+  {
+    reserve(k_MaxNumberLength);
+#if defined(__cpp_lib_to_chars)
+    std::to_chars_result result = std::to_chars(m_Data.data() + m_Size, m_Data.data() + m_Data.size(), value, std::chars_format::fixed, precision);
+    if(result.ec == std::errc())
+    {
+      m_Size = static_cast<size_t>(result.ptr - m_Data.data());
+      return;
+    }
+#endif
+    // Either the standard library has no floating point std::to_chars or the value is
+    // too large to fit the reserved space in fixed notation
+    int32_t length = ::snprintf(nullptr, 0, "%.*f", precision, value);
+    reserve(static_cast<size_t>(length) + 1);
+    ::snprintf(m_Data.data() + m_Size, static_cast<size_t>(length) + 1, "%.*f", precision, value);
+    m_Size += static_cast<size_t>(length);
+  }
+
+private:
+  static constexpr size_t k_MaxNumberLength = 64;
+
+  std::vector<char> m_Data;
+  size_t m_Size = 0;
+
+  void reserve(size_t length)
+  {
+    if(m_Size + length > m_Data.size())
+    {
+      m_Data.resize(std::max(m_Data.size() * 2, m_Size + length));
+    }
+  }
+};
+
+/**
+ * @brief The ParallelTextWriter class writes a large number of text records to an output
+ * sink. Items are split into chunks, a batch of chunks is formatted concurrently into
+ * reusable per chunk buffers, and the buffers are then written out in order so the
+ * output is identical to a serial writer.
+ *
+ * The formatter is called as formatter(TextBuffer& buffer, size_t start, size_t end) and
+ * must append the records for items [start, end) to the buffer.
+ */
+class ParallelTextWriter
+{
+public:
+  using SinkType = std::function<bool(const char* data, size_t length)>;
+  using ProgressType = std::function<bool(size_t itemsWritten, size_t totalItems)>;
+
+  explicit ParallelTextWriter(SinkType sink)
+  : m_Sink(std::move(sink))
+  {
+  }
+
+  /**
+   * @brief FileSink Creates a sink that writes to an already opened FILE
+   */
+  static SinkType FileSink(FILE* f)
+  {
+    return [f](const char* data, size_t length) { return fwrite(data, 1, length, f) == length; };
+  }
+
+  /**
+   * @brief setItemsPerChunk Sets how many items are formatted into each buffer
+   */
+  void setItemsPerChunk(size_t itemsPerChunk)
+  {
+    m_ItemsPerChunk = std::max(itemsPerChunk, static_cast<size_t>(1));
+  }
+
+  /**
+   * @brief setProgressCallback Sets a function that is called after each batch of chunks
+   * has been written. Returning false from the callback stops the writer.
+   */
+  void setProgressCallback(ProgressType progress)
+  {
+    m_Progress = std::move(progress);
+  }
+
+  /**
+   * @brief write Formats and writes totalItems items
+   * @return false if the sink failed or the progress callback asked to stop
+   */
+  template <typename Formatter>
+  bool write(size_t totalItems, const Formatter& formatter)
+  {
+    size_t numChunks = (totalItems + m_ItemsPerChunk - 1) / m_ItemsPerChunk;
+    size_t chunksPerBatch = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1)) * 2;
+    if(m_Buffers.size() < std::min(chunksPerBatch, numChunks))
+    {
+      m_Buffers.resize(std::min(chunksPerBatch, numChunks));
+    }
+
+    for(size_t firstChunk = 0; firstChunk < numChunks; firstChunk += chunksPerBatch)
+    {
+      size_t batchChunks = std::min(chunksPerBatch, numChunks - firstChunk);
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, batchChunks);
+      dataAlg.setGrain(1);
+      dataAlg.execute(FormatChunksImpl<Formatter>(m_Buffers, formatter, firstChunk, m_ItemsPerChunk, totalItems));
+
+      for(size_t c = 0; c < batchChunks; c++)
+      {
+        if(m_Buffers[c].size() > 0 && !m_Sink(m_Buffers[c].data(), m_Buffers[c].size()))
+        {
+          return false;
+        }
+      }
+
+      size_t itemsWritten = std::min((firstChunk + batchChunks) * m_ItemsPerChunk, totalItems);
+      if(m_Progress && !m_Progress(itemsWritten, totalItems))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  SinkType m_Sink;
+  ProgressType m_Progress;
+  size_t m_ItemsPerChunk = 65536;
+  std::vector<TextBuffer> m_Buffers;
+
+  template <typename Formatter>
+  class FormatChunksImpl
+  {
+  public:
+    FormatChunksImpl(std::vector<TextBuffer>& buffers, const Formatter& formatter, size_t firstChunk, size_t itemsPerChunk, size_t totalItems)
+    : m_Buffers(buffers)
+    , m_Formatter(formatter)
+    , m_FirstChunk(firstChunk)
+    , m_ItemsPerChunk(itemsPerChunk)
+    , m_TotalItems(totalItems)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t c = range.min(); c < range.max(); c++)
+      {
+        size_t start = (m_FirstChunk + c) * m_ItemsPerChunk;
+        size_t end = std::min(start + m_ItemsPerChunk, m_TotalItems);
+        TextBuffer& buffer = m_Buffers[c];
+        buffer.clear();
+        m_Formatter(buffer, start, end);
+      }
+    }
+
+  private:
+    std::vector<TextBuffer>& m_Buffers;
+    const Formatter& m_Formatter;
+    size_t m_FirstChunk = 0;
+    size_t m_ItemsPerChunk = 0;
+    size_t m_TotalItems = 0;
+  };
+};
+
+} // namespace ImportExport
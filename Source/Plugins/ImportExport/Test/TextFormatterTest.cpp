@@ -0,0 +1,246 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ImportExport/ImportExportFilters/util/TextFormatter.h"
+
+class TextFormatterTest
+{
+public:
+  TextFormatterTest() = default;
+  virtual ~TextFormatterTest() = default;
+
+  /**
+   * @brief Returns the name of the class for TextFormatterTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("TextFormatterTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestNumberFormatting()
+  {
+    ImportExport::TextBuffer buffer(16);
+    std::string expected;
+    char line[256];
+
+    const double values[] = {0.0, -0.0, 1.0, -1.5, 0.0005, 0.0015, 123456.789, -98765.4321, 1.0e20, 3.0e-7};
+    for(double value : values)
+    {
+      buffer.appendFixed(value);
+      buffer.append(' ');
+      buffer.appendFixed(value, 3);
+      buffer.append('\n');
+      std::snprintf(line, sizeof(line), "%f %.3f\n", value, value);
+      expected += line;
+    }
+
+    buffer.appendInt(std::numeric_limits<int32_t>::min());
+    buffer.append(", ");
+    buffer.appendInt(std::numeric_limits<uint64_t>::max());
+    buffer.append('\n');
+    std::snprintf(line, sizeof(line), "%d, %llu\n", std::numeric_limits<int32_t>::min(), static_cast<unsigned long long>(std::numeric_limits<uint64_t>::max()));
+    expected += line;
+
+    std::string actual(buffer.data(), buffer.size());
+    DREAM3D_REQUIRE(actual == expected)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestChunkOrdering()
+  {
+    const size_t totalItems = 100003;
+    std::string actual;
+    ImportExport::ParallelTextWriter writer([&actual](const char* data, size_t length) {
+      actual.append(data, length);
+      return true;
+    });
+    writer.setItemsPerChunk(997);
+    bool completed = writer.write(totalItems, [](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+      for(size_t i = start; i < end; i++)
+      {
+        buffer.appendInt(i + 1);
+        buffer.append(", ");
+        buffer.appendFixed(static_cast<float>(i) * 0.37f);
+        buffer.append('\n');
+      }
+    });
+    DREAM3D_REQUIRE_EQUAL(completed, true)
+
+    std::string expected;
+    char line[256];
+    for(size_t i = 0; i < totalItems; i++)
+    {
+      std::snprintf(line, sizeof(line), "%llu, %f\n", static_cast<unsigned long long>(i + 1), static_cast<float>(i) * 0.37f);
+      expected += line;
+    }
+    DREAM3D_REQUIRE_EQUAL(actual.size(), expected.size())
+    DREAM3D_REQUIRE(actual == expected)
+
+    // A progress callback returning false stops the writer
+    size_t writtenCount = 0;
+    ImportExport::ParallelTextWriter cancelledWriter([&writtenCount](const char* data, size_t length) {
+      writtenCount += length;
+      return true;
+    });
+    cancelledWriter.setItemsPerChunk(10);
+    cancelledWriter.setProgressCallback([](size_t, size_t) { return false; });
+    completed = cancelledWriter.write(totalItems, [](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+      for(size_t i = start; i < end; i++)
+      {
+        buffer.append('x');
+      }
+    });
+    DREAM3D_REQUIRE_EQUAL(completed, false)
+    DREAM3D_REQUIRE(writtenCount < totalItems)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestINLRecords()
+  {
+    // The cell records of INLWriter: six floats passed to "%f" followed by three "%d" integers and a CRLF
+    const size_t dims[3] = {7, 5, 3};
+    const float origin[3] = {-12.5f, 0.125f, 3.0f};
+    const float res[3] = {0.25f, 1.0f / 3.0f, 1.5f};
+    const size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    std::vector<float> eulers(totalPoints * 3);
+    std::vector<int32_t> featureIds(totalPoints);
+    std::vector<int32_t> phases(totalPoints);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      eulers[i * 3] = static_cast<float>(i) * 0.0731f;
+      eulers[i * 3 + 1] = 3.14159265f - static_cast<float>(i) * 0.0217f;
+      eulers[i * 3 + 2] = -static_cast<float>(i % 11) * 0.5713f;
+      featureIds[i] = static_cast<int32_t>(i * 7919 % 1009) - 5;
+      phases[i] = static_cast<int32_t>(i % 3);
+    }
+    const uint32_t symmetries[3] = {999, 43, 62};
+
+    std::string actual;
+    ImportExport::ParallelTextWriter writer([&actual](const char* data, size_t length) {
+      actual.append(data, length);
+      return true;
+    });
+    writer.setItemsPerChunk(13);
+    bool completed = writer.write(totalPoints, [&](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+      for(size_t index = start; index < end; index++)
+      {
+        size_t x = index % dims[0];
+        size_t y = (index / dims[0]) % dims[1];
+        size_t z = index / (dims[0] * dims[1]);
+        buffer.appendFixed(eulers[index * 3]);
+        buffer.append(' ');
+        buffer.appendFixed(eulers[index * 3 + 1]);
+        buffer.append(' ');
+        buffer.appendFixed(eulers[index * 3 + 2]);
+        buffer.append(' ');
+        buffer.appendFixed(origin[0] + (x * res[0]));
+        buffer.append(' ');
+        buffer.appendFixed(origin[1] + (y * res[1]));
+        buffer.append(' ');
+        buffer.appendFixed(origin[2] + (z * res[2]));
+        buffer.append(' ');
+        buffer.appendInt(featureIds[index]);
+        buffer.append(' ');
+        buffer.appendInt(phases[index]);
+        buffer.append(' ');
+        buffer.appendInt(static_cast<int32_t>(symmetries[phases[index]]));
+        buffer.append("\r\n", 2);
+      }
+    });
+    DREAM3D_REQUIRE_EQUAL(completed, true)
+
+    std::string expected;
+    char line[512];
+    for(size_t z = 0; z < dims[2]; ++z)
+    {
+      for(size_t y = 0; y < dims[1]; ++y)
+      {
+        for(size_t x = 0; x < dims[0]; ++x)
+        {
+          size_t index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
+          float xPos = origin[0] + (x * res[0]);
+          float yPos = origin[1] + (y * res[1]);
+          float zPos = origin[2] + (z * res[2]);
+          std::snprintf(line, sizeof(line), "%f %f %f %f %f %f %d %d %d\r\n", eulers[index * 3], eulers[index * 3 + 1], eulers[index * 3 + 2], xPos, yPos, zPos, featureIds[index], phases[index],
+                        static_cast<int32_t>(symmetries[phases[index]]));
+          expected += line;
+        }
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(actual.size(), expected.size())
+    DREAM3D_REQUIRE(actual == expected)
+
+    return EXIT_SUCCESS;
+  }
+
+  /**
+   * @brief This is the main function
+   */
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestNumberFormatting())
+    DREAM3D_REGISTER_TEST(TestChunkOrdering())
+    DREAM3D_REGISTER_TEST(TestINLRecords())
+  }
+
+private:
+  TextFormatterTest(const TextFormatterTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const TextFormatterTest&) = delete;    // Move assignment Not Implemented
+};
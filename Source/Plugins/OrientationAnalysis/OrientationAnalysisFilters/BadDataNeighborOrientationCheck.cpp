@@ -35,6 +35,9 @@
 
 #include "BadDataNeighborOrientationCheck.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -47,12 +50,103 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The FindSimilarNeighborsImpl class implements a threaded algorithm that compares every
+ * bad Cell with its face neighbors exactly once. The result is stored as a bitmask per Cell, where
+ * bit j is set when the neighbor in direction j has the same phase and a misorientation below the
+ * tolerance. The count of similar neighbors that are already good is stored alongside the mask.
+ * The volume is split into slabs of whole Z planes.
+ */
+class FindSimilarNeighborsImpl
+{
+public:
+  FindSimilarNeighborsImpl(const int64_t* dims, const float* quats, const int32_t* cellPhases, const uint32_t* crystalStructures, const bool* goodVoxels, const LaueOpsContainer& orientationOps,
+                           float misorientationTolerance, uint8_t* similarMask, uint8_t* neighborCount)
+  : m_Dims(dims)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_GoodVoxels(goodVoxels)
+  , m_OrientationOps(orientationOps)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_SimilarMask(similarMask)
+  , m_NeighborCount(neighborCount)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(int64_t zStart, int64_t zEnd) const
+  {
+    const int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    for(int64_t plane = zStart; plane < zEnd; plane++)
+    {
+      for(int64_t row = 0; row < m_Dims[1]; row++)
+      {
+        for(int64_t column = 0; column < m_Dims[0]; column++)
+        {
+          int64_t i = (plane * m_Dims[1] + row) * m_Dims[0] + column;
+          if(m_GoodVoxels[i])
+          {
+            continue;
+          }
+          const bool inBounds[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+          const float* currentQuatPtr = m_Quats + i * 4;
+          QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+          uint32_t phase1 = m_CrystalStructures[m_CellPhases[i]];
+          uint8_t mask = 0;
+          uint8_t count = 0;
+          for(int32_t j = 0; j < 6; j++)
+          {
+            int64_t neighbor = i + neighpoints[j];
+            if(!inBounds[j] || m_CellPhases[i] != m_CellPhases[neighbor] || m_CellPhases[i] <= 0)
+            {
+              continue;
+            }
+            currentQuatPtr = m_Quats + neighbor * 4;
+            QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+            OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+            float w = axisAngle[3];
+            if(w < m_MisorientationTolerance)
+            {
+              mask |= static_cast<uint8_t>(1 << j);
+              if(m_GoodVoxels[neighbor])
+              {
+                count++;
+              }
+            }
+          }
+          m_SimilarMask[i] = mask;
+          m_NeighborCount[i] = count;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(static_cast<int64_t>(range.min()), static_cast<int64_t>(range.max()));
+  }
+
+private:
+  const int64_t* m_Dims = nullptr;
+  const float* m_Quats = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const uint32_t* m_CrystalStructures = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  const LaueOpsContainer& m_OrientationOps;
+  float m_MisorientationTolerance = 0.0f;
+  uint8_t* m_SimilarMask = nullptr;
+  uint8_t* m_NeighborCount = nullptr;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -195,10 +289,6 @@ void BadDataNeighborOrientationCheck::execute()
       static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
-
   int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
   neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
   neighpoints[1] = static_cast<int64_t>(-dims[0]);
@@ -207,143 +297,69 @@ void BadDataNeighborOrientationCheck::execute()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
-  float w = 10000.0f;
-
-  uint32_t phase1 = 0, phase2 = 0;
+  // Compare every bad Cell with its neighbors once. Bad Cells only ever become good, so these
+  // results stay valid for all of the levels below.
+  notifyStatusMessage("Comparing bad Cells with their neighbors");
+  std::vector<uint8_t> similarMask(totalPoints, 0);
+  std::vector<uint8_t> neighborCount(totalPoints, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, static_cast<size_t>(dims[2]));
+  dataAlg.execute(FindSimilarNeighborsImpl(dims, m_Quats, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_OrientationOps, misorientationTolerance, similarMask.data(), neighborCount.data()));
 
-  QVector<int32_t> neighborCount(totalPoints, 0);
-  float* currentQuatPtr = nullptr;
+  if(getCancel())
+  {
+    return;
+  }
 
+  std::vector<int64_t> badVoxels;
   for(size_t i = 0; i < totalPoints; i++)
   {
     if(!m_GoodVoxels[i])
     {
-      column = i % dims[0];
-      row = (i / dims[0]) % dims[1];
-      plane = i / (dims[0] * dims[1]);
-      for(int32_t j = 0; j < 6; j++)
-      {
-        good = 1;
-        neighbor = i + neighpoints[j];
-        if(j == 0 && plane == 0)
-        {
-          good = 0;
-        }
-        if(j == 5 && plane == (dims[2] - 1))
-        {
-          good = 0;
-        }
-        if(j == 1 && row == 0)
-        {
-          good = 0;
-        }
-        if(j == 4 && row == (dims[1] - 1))
-        {
-          good = 0;
-        }
-        if(j == 2 && column == 0)
-        {
-          good = 0;
-        }
-        if(j == 3 && column == (dims[0] - 1))
-        {
-          good = 0;
-        }
-        if(good == 1 && m_GoodVoxels[neighbor])
-        {
-          phase1 = m_CrystalStructures[m_CellPhases[i]];
-          currentQuatPtr = m_Quats + i * 4;
-          QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-          phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-          currentQuatPtr = m_Quats + neighbor * 4;
-          QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-          if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-          {
-            OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-            w = axisAngle[3];
-          }
-          if(w < misorientationTolerance)
-          {
-            neighborCount[i]++;
-          }
-        }
-      }
+      badVoxels.push_back(static_cast<int64_t>(i));
     }
   }
 
-  int32_t currentLevel = 6;
-  int32_t counter = 0;
-
-  while(currentLevel > m_NumberOfNeighbors)
+  // Flipping a Cell only raises the counts of its neighbors, so each level converges to the same
+  // set of good Cells whatever order they are visited in. Only the Cells reached by a flip are
+  // revisited, and the list of bad Cells shrinks as the levels drop.
+  std::vector<int64_t> queue;
+  for(int32_t currentLevel = 6; currentLevel > m_NumberOfNeighbors; currentLevel--)
   {
-    counter = 1;
-    while(counter > 0)
+    if(getCancel())
     {
-      counter = 0;
-      for(size_t i = 0; i < totalPoints; i++)
+      return;
+    }
+    QString ss = QObject::tr("Level %1 of %2 || %3 bad Cells remaining").arg(7 - currentLevel).arg(6 - m_NumberOfNeighbors).arg(badVoxels.size());
+    notifyStatusMessage(ss);
+
+    queue.clear();
+    for(const auto& i : badVoxels)
+    {
+      if(neighborCount[i] >= currentLevel)
       {
-        if(neighborCount[i] >= currentLevel && !m_GoodVoxels[i])
+        m_GoodVoxels[i] = true;
+        queue.push_back(i);
+      }
+    }
+    for(size_t q = 0; q < queue.size(); q++)
+    {
+      int64_t i = queue[q];
+      for(int32_t j = 0; j < 6; j++)
+      {
+        int64_t neighbor = i + neighpoints[j];
+        if((similarMask[i] & (1 << j)) != 0 && !m_GoodVoxels[neighbor])
         {
-          m_GoodVoxels[i] = true;
-          counter++;
-          column = i % dims[0];
-          row = (i / dims[0]) % dims[1];
-          plane = i / (dims[0] * dims[1]);
-          for(int64_t j = 0; j < 6; j++)
+          neighborCount[neighbor]++;
+          if(neighborCount[neighbor] >= currentLevel)
           {
-            good = 1;
-            neighbor = i + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (dims[2] - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (dims[1] - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (dims[0] - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && !m_GoodVoxels[neighbor])
-            {
-
-              currentQuatPtr = m_Quats + i * 4;
-              QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              currentQuatPtr = m_Quats + neighbor * 4;
-              QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-              if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-              {
-                OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                w = axisAngle[3];
-              }
-              if(w < misorientationTolerance)
-              {
-                neighborCount[neighbor]++;
-              }
-            }
+            m_GoodVoxels[neighbor] = true;
+            queue.push_back(neighbor);
           }
         }
       }
     }
-    currentLevel = currentLevel - 1;
+    badVoxels.erase(std::remove_if(badVoxels.begin(), badVoxels.end(), [this](int64_t i) { return m_GoodVoxels[i]; }), badVoxels.end());
   }
 }
 
@@ -53,6 +53,7 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/OrientationBatchConverter.h"
 
 /**
  * @brief The ChangeAngleRepresentationImpl class implements a threaded algorithm to convert an array of
@@ -72,10 +73,7 @@ public:
 
   void convert(size_t start, size_t end) const
   {
-    for(size_t i = start; i < end; i++)
-    {
-      m_CellEulerAngles[i] = m_CellEulerAngles[i] * convFactor;
-    }
+    OrientationAnalysis::OrientationBatch::ScaleValues(m_CellEulerAngles, convFactor, start, end);
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -181,7 +179,7 @@ void ChangeAngleRepresentation::execute()
   {
     conversionFactor = static_cast<float>(M_PI / 180.0f);
   }
-  else if(conversionFactor == SIMPL::EulerAngleConversionType::RadiansToDegrees)
+  else if(m_ConversionType == SIMPL::EulerAngleConversionType::RadiansToDegrees)
   {
     conversionFactor = static_cast<float>(180.0f / M_PI);
   }
@@ -50,6 +50,7 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/OrientationBatchConverter.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -219,37 +220,10 @@ void ConvertOrientations::dataCheck()
 template <typename T>
 void generateRepresentation(ConvertOrientations* filter, typename DataArray<T>::Pointer inputOrientations, typename DataArray<T>::Pointer outputOrientations)
 {
-  using ArrayType = DataArray<T>;
-  using ArrayPointerType = typename ArrayType::Pointer;
-  using OCType = OrientationConverter<ArrayType, T>;
-  std::vector<typename OCType::Pointer> converters(7);
-
-  converters[0] = EulerConverter<ArrayType, T>::New();
-  converters[1] = OrientationMatrixConverter<ArrayType, T>::New();
-  converters[2] = QuaternionConverter<ArrayType, T>::New();
-  converters[3] = AxisAngleConverter<ArrayType, T>::New();
-  converters[4] = RodriguesConverter<ArrayType, T>::New();
-  converters[5] = HomochoricConverter<ArrayType, T>::New();
-  converters[6] = CubochoricConverter<ArrayType, T>::New();
-
-  std::vector<OrientationRepresentation::Type> ocTypes = OCType::GetOrientationTypes();
-
-  converters[filter->getInputType()]->setInputData(inputOrientations);
-  converters[filter->getInputType()]->convertRepresentationTo(ocTypes[filter->getOutputType()]);
-
-  ArrayPointerType output = converters[filter->getInputType()]->getOutputData();
-  if(nullptr == output.get())
-  {
-    QString ss = QObject::tr("There was an error converting the input data using convertor %1").arg(QString::fromStdString(converters[filter->getInputType()]->getNameOfClass()));
-    filter->setErrorCondition(-1004, ss);
-    return;
-  }
-
-  if(!output->copyIntoArray(outputOrientations))
-  {
-    QString ss = QObject::tr("There was an error copying the final results into the output array.");
-    filter->setErrorCondition(-1003, ss);
-  }
+  using OrientationAnalysis::OrientationBatch::Representation;
+  Representation inputType = static_cast<Representation>(filter->getInputType());
+  Representation outputType = static_cast<Representation>(filter->getOutputType());
+  OrientationAnalysis::OrientationBatch::Convert<T>(inputType, outputType, inputOrientations->getPointer(0), outputOrientations->getPointer(0), inputOrientations->getNumberOfTuples());
 }
 
 // -----------------------------------------------------------------------------
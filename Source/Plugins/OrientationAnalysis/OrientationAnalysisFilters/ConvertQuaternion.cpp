@@ -21,6 +21,7 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/OrientationBatchConverter.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -57,23 +58,14 @@ public:
       mapping = {{3, 0, 1, 2}};
     }
 
-    std::array<float, 4> temp = {0.0f, 0.0f, 0.0f, 0.0f};
-    for(size_t i = start; i < end; i++)
+    for(size_t i = start; i < end; i += OrientationAnalysis::OrientationBatch::k_BlockSize)
     {
       if(m_Filter->getCancel())
       {
         return;
       }
-
-      temp[mapping[0]] = m_Input[i * 4];
-      temp[mapping[1]] = m_Input[i * 4 + 1];
-      temp[mapping[2]] = m_Input[i * 4 + 2];
-      temp[mapping[3]] = m_Input[i * 4 + 3];
-
-      m_Output[i * 4] = temp[0];
-      m_Output[i * 4 + 1] = temp[1];
-      m_Output[i * 4 + 2] = temp[2];
-      m_Output[i * 4 + 3] = temp[3];
+      size_t blockEnd = std::min(i + OrientationAnalysis::OrientationBatch::k_BlockSize, end);
+      OrientationAnalysis::OrientationBatch::PermuteQuaternions(m_Input, m_Output, mapping, i, blockEnd);
     }
   }
 
@@ -30,7 +30,11 @@
 
 #include "EMsoftSO3Sampler.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <mutex>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -46,6 +50,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/Orientation.hpp"
@@ -65,6 +70,195 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+// -----------------------------------------------------------------------------
+void appendEulerAngles(std::vector<float>& eulers, const OrientationD& rod)
+{
+  OrientationD eu = OrientationTransformation::ro2eu<OrientationD, OrientationD>(rod);
+  eulers.push_back(static_cast<float>(eu[0]));
+  eulers.push_back(static_cast<float>(eu[1]));
+  eulers.push_back(static_cast<float>(eu[2]));
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Returns the largest cubochoric coordinate that a point inside the fundamental zone can have.
+ * The cubochoric map sends the cube surface max(|x|,|y|,|z|) = s onto the homochoric sphere of radius
+ * (6/pi)^(1/3) s, so a bound on the length of the Rodrigues vectors in the fundamental zone gives a bound
+ * on all three cubochoric coordinates. Returns the semi-edge of the cube when the zone is not bounded.
+ */
+double fundamentalZoneCubochoricBound(int32_t fzType, int32_t fzOrder, double edge)
+{
+  double rodLength = std::numeric_limits<double>::infinity();
+  switch(fzType)
+  {
+  case OrientationAnalysisConstants::DihedralType:
+    // a prism with a regular 2n-gon of unit apothem as cross section
+    rodLength = std::sqrt(1.0 / std::pow(std::cos(SIMPLib::Constants::k_PiD / (2.0 * fzOrder)), 2.0) + LPs::BP[fzOrder - 1] * LPs::BP[fzOrder - 1]);
+    break;
+  case OrientationAnalysisConstants::TetrahedralType:
+    rodLength = 1.0;
+    break;
+  case OrientationAnalysisConstants::OctahedralType:
+    rodLength = std::sqrt(2.0 * LPs::BP[3] * LPs::BP[3] + (1.0 - 2.0 * LPs::BP[3]) * (1.0 - 2.0 * LPs::BP[3]));
+    break;
+  default:
+    break;
+  }
+  if(std::isinf(rodLength))
+  {
+    return edge;
+  }
+  double omega = 2.0 * std::atan(rodLength);
+  double homochoric = std::pow(0.75 * (omega - std::sin(omega)), 1.0 / 3.0);
+  double bound = homochoric * std::pow(SIMPLib::Constants::k_PiD / 6.0, 1.0 / 3.0);
+  // leave some room for round off in the conversions
+  return std::min(edge, bound * (1.0 + 1.0E-4));
+}
+
+/**
+ * @brief The SampleFundamentalZoneImpl class implements a threaded algorithm that samples the cubochoric
+ * grid one x slice at a time and keeps the Euler angles of the points that lie inside the fundamental zone.
+ * Every slice has its own buffer so the slices can be joined in the same order as the serial loops.
+ */
+class SampleFundamentalZoneImpl
+{
+public:
+  SampleFundamentalZoneImpl(EMsoftSO3Sampler* filter, int32_t firstIndex, int32_t lastIndex, double delta, double gridShift, double edge, int32_t fzType, int32_t fzOrder,
+                            std::vector<std::vector<float>>& eulerSlices)
+  : m_Filter(filter)
+  , m_FirstIndex(firstIndex)
+  , m_LastIndex(lastIndex)
+  , m_Delta(delta)
+  , m_GridShift(gridShift)
+  , m_Edge(edge)
+  , m_FZtype(fzType)
+  , m_FZorder(fzOrder)
+  , m_EulerSlices(eulerSlices)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    int32_t rowLength = m_LastIndex - m_FirstIndex + 1;
+    for(size_t slice = start; slice < end; slice++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      std::vector<float>& eulers = m_EulerSlices[slice];
+      double x = (static_cast<double>(m_FirstIndex + static_cast<int32_t>(slice)) + m_GridShift) * m_Delta;
+      if(std::fabs(x) <= m_Edge)
+      {
+        for(int32_t j = m_FirstIndex; j <= m_LastIndex; j++)
+        {
+          double y = (static_cast<double>(j) + m_GridShift) * m_Delta;
+          if(std::fabs(y) > m_Edge)
+          {
+            continue;
+          }
+          for(int32_t k = m_FirstIndex; k <= m_LastIndex; k++)
+          {
+            double z = (static_cast<double>(k) + m_GridShift) * m_Delta;
+            if(std::fabs(z) <= m_Edge)
+            {
+              // convert to Rodrigues representation
+              OrientationD cu(x, y, z);
+              OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
+              if(m_Filter->IsinsideFZ(rod.data(), m_FZtype, m_FZorder))
+              {
+                appendEulerAngles(eulers, rod);
+              }
+            }
+          }
+        }
+      }
+      m_Filter->setUpdateProgress(rowLength * rowLength);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  EMsoftSO3Sampler* m_Filter = nullptr;
+  int32_t m_FirstIndex = 0;
+  int32_t m_LastIndex = 0;
+  double m_Delta = 0.0;
+  double m_GridShift = 0.0;
+  double m_Edge = 0.0;
+  int32_t m_FZtype = 0;
+  int32_t m_FZorder = 0;
+  std::vector<std::vector<float>>& m_EulerSlices;
+};
+
+/**
+ * @brief The SampleMisorientationCubeImpl class implements a threaded algorithm that samples the full
+ * misorientation cube one x slice at a time, composing every point with the reference orientation.
+ */
+class SampleMisorientationCubeImpl
+{
+public:
+  SampleMisorientationCubeImpl(EMsoftSO3Sampler* filter, int32_t numsp, double delta, const OrientationD& sigma, std::vector<std::vector<float>>& eulerSlices)
+  : m_Filter(filter)
+  , m_Numsp(numsp)
+  , m_Delta(delta)
+  , m_Sigma(sigma)
+  , m_EulerSlices(eulerSlices)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    int32_t rowLength = 2 * m_Numsp + 1;
+    for(size_t slice = start; slice < end; slice++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      std::vector<float>& eulers = m_EulerSlices[slice];
+      eulers.reserve(static_cast<size_t>(rowLength * rowLength * 3));
+      double x = static_cast<double>(static_cast<int32_t>(slice) - m_Numsp) * m_Delta;
+      for(int32_t j = -m_Numsp; j <= m_Numsp; j++)
+      {
+        double y = static_cast<double>(j) * m_Delta;
+        for(int32_t k = -m_Numsp; k <= m_Numsp; k++)
+        {
+          double z = static_cast<double>(k) * m_Delta;
+          // convert to Rodrigues representation and apply Rodrigues composition formula
+          OrientationD cu(-x, -y, -z);
+          OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
+          m_Filter->RodriguesComposition(m_Sigma, rod);
+          appendEulerAngles(eulers, rod);
+        }
+      }
+      m_Filter->setUpdateProgress(rowLength * rowLength);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  EMsoftSO3Sampler* m_Filter = nullptr;
+  int32_t m_Numsp = 0;
+  double m_Delta = 0.0;
+  OrientationD m_Sigma;
+  std::vector<std::vector<float>>& m_EulerSlices;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -265,13 +459,14 @@ void EMsoftSO3Sampler::execute()
     return;
   }
 
-  OrientationListArrayType FZlist;
+  // Every slice of the sampling grid collects its own Euler angles; the slices are joined in order at the end
+  std::vector<std::vector<float>> eulerSlices;
 
   if(getsampleModeSelector() == 0)
   {
-    // here we perform the actual calculation; once we have the FZlist,
+    // here we perform the actual calculation; once we have all the slices,
     // we can allocate the data array and copy all entries
-    double x, y, z, delta;
+    double delta;
     int32_t FZtype, FZorder;
 
     // step size for sampling of grid; maximum total number of samples = pow(2*getNumsp()+1,3)
@@ -291,73 +486,36 @@ void EMsoftSO3Sampler::execute()
     // loop over the cube of volume pi^2; note that we do not want to include
     // the opposite edges/facets of the cube, to avoid double counting rotations
     // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-    int Np = getNumsp();
-    int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1);
-    int Dn = Totp / 10;
-    int Dc = Dn;
-    int Di = 0;
-    int Dg = 0;
+    int32_t Np = getNumsp();
 
     // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
     double edge = 0.5 * LPs::ap;
 
-    for(int i = -Np + 1; i < Np + 1; i++)
+    // only the grid rows that can reach the fundamental zone are visited at all
+    int32_t firstIndex = -Np + 1;
+    int32_t lastIndex = Np;
+    double bound = fundamentalZoneCubochoricBound(FZtype, FZorder, edge);
+    if(bound < edge)
     {
-      x = (static_cast<double>(i) + gridShift) * delta;
-
-      if(fabs(x) <= edge)
-      {
-
-        for(int j = -Np + 1; j < Np + 1; j++)
-        {
-          y = (static_cast<double>(j) + gridShift) * delta;
-
-          if(fabs(y) <= edge)
-          {
-
-            for(int k = -Np + 1; k < Np + 1; k++)
-            {
-              z = (static_cast<double>(k) + gridShift) * delta;
-
-              if(fabs(z) <= edge)
-              {
+      firstIndex = std::max(firstIndex, static_cast<int32_t>(std::floor(-bound / delta - gridShift)));
+      lastIndex = std::min(lastIndex, static_cast<int32_t>(std::ceil(bound / delta - gridShift)));
+    }
 
-                // convert to Rodrigues representation
-                OrientationD cu(x, y, z);
-                OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
-
-                // If insideFZ=true, then add this point to FZlist
-                bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-                if(b)
-                {
-                  FZlist.push_back(rod);
-                  Dg += 1;
-                }
-                Di += 1;
-              }
-            }
-          }
-        }
-      }
+    m_TuplesCompleted = 0;
+    m_TotalTuples = static_cast<int64_t>(lastIndex - firstIndex + 1) * (lastIndex - firstIndex + 1) * (lastIndex - firstIndex + 1);
+    m_ProgressIncrement = m_TotalTuples / 10;
+    m_NextProgress = m_ProgressIncrement;
+    eulerSlices.resize(static_cast<size_t>(lastIndex - firstIndex + 1));
 
-      // report on status of computation
-      if(Di > Dc)
-      {
-        QString ss = QString("Euler Angles | Tested: %1 of %2 | Inside RFZ: %3 ").arg(QString::number(Di), QString::number(Totp), QString::number(Dg));
-        notifyStatusMessage(ss);
-        Dc += Dn;
-      }
-      if(getCancel())
-      {
-        break;
-      }
-    }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, eulerSlices.size());
+    dataAlg.execute(SampleFundamentalZoneImpl(this, firstIndex, lastIndex, delta, gridShift, edge, FZtype, FZorder, eulerSlices));
   }
 
   // here are the misorientation sampling cases:
   if(getsampleModeSelector() != 0)
   {
-    // here we perform the actual calculation; once we have the FZlist,
+    // here we perform the actual calculation; once we have all the slices,
     // we can allocate the data array and copy all entries
     double x, y, z, delta, omega, semi;
 
@@ -385,6 +543,10 @@ void EMsoftSO3Sampler::execute()
       int Dc = Dn;
       int Dg = 0;
 
+      eulerSlices.resize(1);
+      std::vector<float>& eulers = eulerSlices[0];
+      eulers.reserve(static_cast<size_t>(Totp) * 3);
+
       // x-y bottom and top planes
       for(int i = -Np; i <= Np; i++)
       {
@@ -397,14 +559,14 @@ void EMsoftSO3Sampler::execute()
             OrientationD cu(-x, -y, -semi);
             OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            appendEulerAngles(eulers, rod);
             Dg += 1;
           }
           {
             OrientationD cu(-x, -y, semi);
             OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            appendEulerAngles(eulers, rod);
             Dg += 1;
           }
         }
@@ -425,14 +587,14 @@ void EMsoftSO3Sampler::execute()
             OrientationD cu(-semi, -y, -z);
             OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            appendEulerAngles(eulers, rod);
             Dg += 1;
           }
           {
             OrientationD cu(semi, -y, -z);
             OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            appendEulerAngles(eulers, rod);
             Dg += 1;
           }
         }
@@ -453,14 +615,14 @@ void EMsoftSO3Sampler::execute()
             OrientationD cu(-x, -semi, -z);
             OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            appendEulerAngles(eulers, rod);
             Dg += 1;
           }
           {
             OrientationD cu(-x, semi, -z);
             OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            appendEulerAngles(eulers, rod);
             Dg += 1;
           }
         }
@@ -481,58 +643,57 @@ void EMsoftSO3Sampler::execute()
     else
     {
       // set counter parameters for the loop over the sub-cube surface
-      int Np = getNumsp();
-      int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1); // see misorientation sampling paper for this expression
-      int Dn = Totp / 20;
-      int Dc = Dn;
-      int Dg = 0;
-
-      for(int i = -Np; i <= Np; i++)
-      {
-        x = static_cast<double>(i) * delta;
-        for(int j = -Np; j <= Np; j++)
-        {
-          y = static_cast<double>(j) * delta;
-          for(int k = -Np; k <= Np; k++)
-          {
-            z = static_cast<double>(k) * delta;
-            // convert to Rodrigues representation and apply Rodrigues composition formula
-            {
-              OrientationD cu(-x, -y, -z);
-              OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
-              RodriguesComposition(sigma, rod);
-              FZlist.push_back(rod);
-              Dg += 1;
-            }
-          }
-        }
-        // report on status of computation
-        if(Dg > Dc)
-        {
-          QString ss = QString("Euler Angles | Generated: %1 / %2").arg(QString::number(Dg), QString::number(Totp));
-          notifyStatusMessage(ss);
-          Dc += Dn;
-        }
-      }
+      int32_t Np = getNumsp();
+      m_TuplesCompleted = 0;
+      m_TotalTuples = static_cast<int64_t>(2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1); // see misorientation sampling paper for this expression
+      m_ProgressIncrement = m_TotalTuples / 20;
+      m_NextProgress = m_ProgressIncrement;
+      eulerSlices.resize(static_cast<size_t>(2 * Np + 1));
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, eulerSlices.size());
+      dataAlg.execute(SampleMisorientationCubeImpl(this, Np, delta, sigma, eulerSlices));
     }
   }
 
-  // resize the EulerAngles array to the number of items in FZlist; don't forget to redefine the hard pointer
+  if(getCancel())
+  {
+    return;
+  }
+
+  size_t numEulers = 0;
+  for(const std::vector<float>& eulers : eulerSlices)
+  {
+    numEulers += eulers.size() / 3;
+  }
+
+  // resize the EulerAngles array to the number of sampled orientations; don't forget to redefine the hard pointer
   AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName().getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
-  std::vector<size_t> tDims(1, FZlist.size());
+  std::vector<size_t> tDims(1, numEulers);
   am->resizeAttributeArrays(tDims);
   m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
 
-  // copy the Rodrigues vectors as Euler angles into the m_EulerAngles array; convert doubles to floats along the way
-  int j = -1;
-  for(const OrientationD& rod : FZlist)
+  // copy the slices into the m_EulerAngles array, releasing each slice as soon as it has been copied
+  float* eulerPtr = m_EulerAngles;
+  for(std::vector<float>& eulers : eulerSlices)
   {
-    j += 1;
-    OrientationD eu = OrientationTransformation::ro2eu<OrientationD, OrientationD>(rod);
+    eulerPtr = std::copy(eulers.begin(), eulers.end(), eulerPtr);
+    std::vector<float>().swap(eulers);
+  }
+}
 
-    m_EulerAngles[j * 3 + 0] = static_cast<float>(eu[0]);
-    m_EulerAngles[j * 3 + 1] = static_cast<float>(eu[1]);
-    m_EulerAngles[j * 3 + 2] = static_cast<float>(eu[2]);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftSO3Sampler::setUpdateProgress(int tuplesCompleted)
+{
+  std::lock_guard<std::mutex> lock(m_ProgressMutex);
+  m_TuplesCompleted += tuplesCompleted;
+  if(m_TuplesCompleted > m_NextProgress)
+  {
+    QString ss = QString("Euler Angles | Tested: %1 of %2").arg(QString::number(m_TuplesCompleted), QString::number(m_TotalTuples));
+    notifyStatusMessage(ss);
+    m_NextProgress += m_ProgressIncrement;
   }
 }
 
@@ -31,6 +31,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -357,6 +358,12 @@ private:
   DataArrayPath m_DataContainerName = {SIMPL::Defaults::ImageDataContainerName, "", ""};
   QString m_EMsoftAttributeMatrixName = {SIMPL::Defaults::CellAttributeMatrixName};
 
+  std::mutex m_ProgressMutex;
+  int64_t m_TuplesCompleted = 0;
+  int64_t m_TotalTuples = 0;
+  int64_t m_ProgressIncrement = 0;
+  int64_t m_NextProgress = 0;
+
 public:
   EMsoftSO3Sampler(const EMsoftSO3Sampler&) = delete;            // Copy Constructor Not Implemented
   EMsoftSO3Sampler(EMsoftSO3Sampler&&) = delete;                 // Move Constructor Not Implemented
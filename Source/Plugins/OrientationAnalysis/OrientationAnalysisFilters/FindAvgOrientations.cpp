@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindAvgOrientations.h"
 
+#include <algorithm>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -42,12 +44,15 @@
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/LaueOps/LaueOps.h"
 
+#include "Generic/GenericFilters/util/CellFeatureReduction.h"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -58,6 +63,83 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+/**
+ * @brief The FindAvgOrientationsImpl class implements a threaded algorithm that averages the orientations of one
+ * range of features. The cells of each feature are visited in increasing order, so every cell is moved to the
+ * same symmetric equivalent as in a single pass over all cells.
+ */
+class FindAvgOrientationsImpl
+{
+public:
+  FindAvgOrientationsImpl(const std::vector<size_t>& cellOffsets, const std::vector<size_t>& cells, const int32_t* cellPhases, const float* quats, const uint32_t* crystalStructures,
+                          const std::vector<LaueOps::Pointer>& orientationOps, float* avgQuats, float* featureEulerAngles)
+  : m_CellOffsets(cellOffsets)
+  , m_Cells(cells)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_AvgQuats(avgQuats)
+  , m_FeatureEulerAngles(featureEulerAngles)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t feature = std::max<size_t>(start, 1); feature < end; feature++)
+    {
+      float* avgQuatsPtr = m_AvgQuats + feature * 4; // Get the pointer to the current average quaternion
+      QuatF::identity().copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
+      float count = 0.0f;
+      for(size_t c = m_CellOffsets[feature]; c < m_CellOffsets[feature + 1]; c++)
+      {
+        size_t i = m_Cells[c];
+        int32_t phase = m_CellPhases[i];
+        if(phase <= 0)
+        {
+          continue;
+        }
+        count += 1.0f;
+
+        QuatF curavgquat(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Makes a copy into curavgquat!!!!
+        curavgquat.scalarDivide(count);
+
+        const float* currentVoxelQuatPtr = m_Quats + i * 4;                                                            // Get the pointer to the current voxel's Quaternion
+        QuatF voxquat(currentVoxelQuatPtr[0], currentVoxelQuatPtr[1], currentVoxelQuatPtr[2], currentVoxelQuatPtr[3]); // Makes a copy into voxquat!!!!
+        QuatF nearestQuat = m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
+
+        curavgquat = curavgquat + nearestQuat;
+        curavgquat.copyInto(avgQuatsPtr, Quaternion<float>::Order::VectorScalar); // Copy back into the m_AvgQuats storage
+      }
+
+      QuatF qAvg(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Create a copy of the quaternion
+      qAvg.scalarDivide(count);
+      qAvg = qAvg.unitQuaternion();
+      qAvg.copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
+
+      OrientationF eu = OrientationTransformation::qu2eu<Quaternion<float>, Orientation<float>>(qAvg);
+      eu.copyInto(m_FeatureEulerAngles + (3 * feature), 3);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const std::vector<size_t>& m_CellOffsets;
+  const std::vector<size_t>& m_Cells;
+  const int32_t* m_CellPhases = nullptr;
+  const float* m_Quats = nullptr;
+  const uint32_t* m_CrystalStructures = nullptr;
+  const std::vector<LaueOps::Pointer>& m_OrientationOps;
+  float* m_AvgQuats = nullptr;
+  float* m_FeatureEulerAngles = nullptr;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -207,55 +289,19 @@ void FindAvgOrientations::execute()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
-  std::vector<float> counts(totalFeatures, 0.0f);
-
-  int32_t phase = 0;
-
   m_AvgQuatsPtr.lock()->initializeWithZeros();
-
-  float* avgQuatsPtr = nullptr;
-  float* currentVoxelQuatPtr = nullptr;
-  // Initialize all Average Quats to Identity
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    avgQuatsPtr = m_AvgQuats + i * 4; // Get the pointer to the current average quaternion
-    QuatF::identity().copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
-  }
   // Initialize all Euler Angles to Zero
   m_FeatureEulerAnglesPtr.lock()->initializeWithZeros();
 
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
-    {
-      counts[m_FeatureIds[i]] += 1.0f;
-      phase = m_CellPhases[i];
+  // The running average makes the result depend on the order of the cells, so the cells are grouped by
+  // feature first and each feature is then averaged on its own in the original cell order
+  std::vector<size_t> cellOffsets;
+  std::vector<size_t> cells;
+  CellFeatureReduction::GroupCells(m_FeatureIds, totalPoints, totalFeatures, cellOffsets, cells);
 
-      avgQuatsPtr = m_AvgQuats + m_FeatureIds[i] * 4;                                   // Get the pointer to the current average quaternion
-      QuatF curavgquat(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Makes a copy into curavgquat!!!!
-      curavgquat.scalarDivide(counts[m_FeatureIds[i]]);
-
-      currentVoxelQuatPtr = m_Quats + i * 4;                                                                         // Get the pointer to the current voxel's Quaternion
-      QuatF voxquat(currentVoxelQuatPtr[0], currentVoxelQuatPtr[1], currentVoxelQuatPtr[2], currentVoxelQuatPtr[3]); // Makes a copy into voxquat!!!!
-      QuatF nearestQuat = m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
-
-      // QuatF qSum(m_AvgQuats + m_FeatureIds[i] * 4); // Makes a copy into qSum!!!!
-      curavgquat = curavgquat + nearestQuat;
-      curavgquat.copyInto(avgQuatsPtr, Quaternion<float>::Order::VectorScalar); // Copy back into the m_AvgQuats storage
-    }
-  }
-
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    avgQuatsPtr = m_AvgQuats + i * 4;                                           // Get the pointer to the current average quaternion
-    QuatF qAvg(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Create a copy of the quaternion
-    qAvg.scalarDivide(counts[i]);
-    qAvg = qAvg.unitQuaternion();
-    qAvg.copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
-
-    OrientationF eu = OrientationTransformation::qu2eu<Quaternion<float>, Orientation<float>>(qAvg);
-    eu.copyInto(m_FeatureEulerAngles + (3 * i), 3);
-  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalFeatures);
+  dataAlg.execute(FindAvgOrientationsImpl(cellOffsets, cells, m_CellPhases, m_Quats, m_CrystalStructures, m_OrientationOps, m_AvgQuats, m_FeatureEulerAngles));
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,634 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FindNeighborPatternSimilarity.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/PatternSimilarityEngine.h"
+#include "OrientationAnalysis/OrientationAnalysisVersion.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindNeighborPatternSimilarity::FindNeighborPatternSimilarity()
+{
+  m_KernelSize[0] = 1;
+  m_KernelSize[1] = 1;
+  m_KernelSize[2] = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindNeighborPatternSimilarity::~FindNeighborPatternSimilarity() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setupFilterParameters()
+{
+  FilterParameterVectorType parameters;
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Kernel Radius", KernelSize, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Minimum Averaging Similarity", MinimumSimilarity, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity));
+  {
+    std::vector<QString> linkedProps = {"AveragedPatternsFile"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Write Averaged Patterns", WriteAveragedPatterns, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity, linkedProps));
+  }
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Averaged Patterns File", AveragedPatternsFile, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity, "*.raw", "Raw Pattern File"));
+
+  {
+    LinkedChoicesFilterParameter::Pointer parameter = LinkedChoicesFilterParameter::New();
+    parameter->setHumanLabel("Pattern Source");
+    parameter->setPropertyName("PatternSource");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(FindNeighborPatternSimilarity, this, PatternSource));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(FindNeighborPatternSimilarity, this, PatternSource));
+
+    std::vector<QString> choices;
+    choices.push_back("Cell Attribute Array");
+    choices.push_back("Raw Pattern File");
+    parameter->setChoices(choices);
+    std::vector<QString> linkedProps;
+    linkedProps.push_back("PatternDataArrayPath");
+    linkedProps.push_back("InputFile");
+    linkedProps.push_back("PatternWidth");
+    linkedProps.push_back("PatternHeight");
+    linkedProps.push_back("FileDataType");
+    linkedProps.push_back("HeaderBytes");
+    parameter->setLinkedProperties(linkedProps);
+    parameter->setEditable(false);
+    parameter->setCategory(FilterParameter::Category::Parameter);
+    parameters.push_back(parameter);
+  }
+  parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Raw Pattern File", InputFile, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity, "*.raw *.data *.up1 *.up2", "Raw Pattern File", 1));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Pattern Width (Pixels)", PatternWidth, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity, 1));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Pattern Height (Pixels)", PatternHeight, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity, 1));
+  {
+    std::vector<QString> choices;
+    choices.push_back("uint8");
+    choices.push_back("uint16");
+    choices.push_back("float32");
+    parameters.push_back(SIMPL_NEW_CHOICE_FP("Pixel Type", FileDataType, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity, choices, false, 1));
+  }
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Header Size (Bytes)", HeaderBytes, FilterParameter::Category::Parameter, FindNeighborPatternSimilarity, 1));
+
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
+  {
+    AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_AM_SELECTION_FP("Cell Attribute Matrix", CellAttributeMatrixPath, FilterParameter::Category::RequiredArray, FindNeighborPatternSimilarity, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    req.daTypes = {SIMPL::TypeNames::UInt8, SIMPL::TypeNames::UInt16, SIMPL::TypeNames::Float};
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Pattern Data", PatternDataArrayPath, FilterParameter::Category::RequiredArray, FindNeighborPatternSimilarity, req, 0));
+  }
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::CreatedArray));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Neighbor Pattern Similarity", SimilarityArrayName, CellAttributeMatrixPath, CellAttributeMatrixPath, FilterParameter::Category::CreatedArray,
+                                                      FindNeighborPatternSimilarity));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::initialize()
+{
+  m_PatternSize = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::dataCheck()
+{
+  clearErrorCode();
+  clearWarningCode();
+  initialize();
+
+  if(m_KernelSize[0] < 0 || m_KernelSize[1] < 0 || m_KernelSize[2] < 0)
+  {
+    QString ss = QObject::tr("The kernel radius may not be negative in any direction");
+    setErrorCondition(-23400, ss);
+    return;
+  }
+  if(m_KernelSize[0] == 0 && m_KernelSize[1] == 0 && m_KernelSize[2] == 0)
+  {
+    QString ss = QObject::tr("The kernel radius must be at least 1 in one direction");
+    setErrorCondition(-23401, ss);
+    return;
+  }
+
+  getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getCellAttributeMatrixPath().getDataContainerName());
+  AttributeMatrix::Pointer cellAttrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath(this, getCellAttributeMatrixPath(), -23402);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+  const size_t numPoints = cellAttrMat->getNumberOfTuples();
+
+  if(m_PatternSource == 0)
+  {
+    m_PatternDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath(this, getPatternDataArrayPath());
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    IDataArray::Pointer patternData = m_PatternDataPtr.lock();
+    if(nullptr == std::dynamic_pointer_cast<UInt8ArrayType>(patternData) && nullptr == std::dynamic_pointer_cast<UInt16ArrayType>(patternData) &&
+       nullptr == std::dynamic_pointer_cast<FloatArrayType>(patternData))
+    {
+      QString ss = QObject::tr("The pattern data must be of type uint8, uint16 or float");
+      setErrorCondition(-23403, ss);
+      return;
+    }
+    if(patternData->getNumberOfTuples() != numPoints)
+    {
+      QString ss = QObject::tr("The pattern data has %1 tuples but the Cell Attribute Matrix has %2").arg(patternData->getNumberOfTuples()).arg(numPoints);
+      setErrorCondition(-23404, ss);
+      return;
+    }
+    m_PatternSize = patternData->getNumberOfComponents();
+  }
+  else if(m_PatternSource == 1)
+  {
+    if(m_PatternWidth <= 0 || m_PatternHeight <= 0)
+    {
+      QString ss = QObject::tr("The pattern width and height must be positive");
+      setErrorCondition(-23405, ss);
+      return;
+    }
+    if(m_FileDataType < 0 || m_FileDataType > 2)
+    {
+      QString ss = QObject::tr("The pixel type of the raw pattern file is not valid");
+      setErrorCondition(-23406, ss);
+      return;
+    }
+    if(m_HeaderBytes < 0)
+    {
+      QString ss = QObject::tr("The header size may not be negative");
+      setErrorCondition(-23407, ss);
+      return;
+    }
+    m_PatternSize = static_cast<size_t>(m_PatternWidth) * static_cast<size_t>(m_PatternHeight);
+
+    QFileInfo fi(getInputFile());
+    if(getInputFile().isEmpty())
+    {
+      QString ss = QObject::tr("The raw pattern file must be set");
+      setErrorCondition(-23408, ss);
+      return;
+    }
+    if(!fi.exists())
+    {
+      QString ss = QObject::tr("The raw pattern file does not exist: '%1'").arg(getInputFile());
+      setErrorCondition(-23409, ss);
+      return;
+    }
+    const size_t elementSize = RawFilePatternSource::ElementSize(static_cast<RawFilePatternSource::DataType>(m_FileDataType));
+    const uint64_t requiredBytes = static_cast<uint64_t>(m_HeaderBytes) + static_cast<uint64_t>(numPoints) * m_PatternSize * elementSize;
+    if(static_cast<uint64_t>(fi.size()) < requiredBytes)
+    {
+      QString ss = QObject::tr("The raw pattern file holds %1 bytes but %2 Cells of %3 x %4 pixel patterns need %5 bytes")
+                       .arg(fi.size())
+                       .arg(numPoints)
+                       .arg(m_PatternWidth)
+                       .arg(m_PatternHeight)
+                       .arg(requiredBytes);
+      setErrorCondition(-23410, ss);
+      return;
+    }
+  }
+  else
+  {
+    QString ss = QObject::tr("The pattern source must be 0 (Cell Attribute Array) or 1 (Raw Pattern File)");
+    setErrorCondition(-23411, ss);
+    return;
+  }
+
+  if(m_WriteAveragedPatterns && getAveragedPatternsFile().isEmpty())
+  {
+    QString ss = QObject::tr("The averaged patterns file must be set");
+    setErrorCondition(-23412, ss);
+    return;
+  }
+
+  std::vector<size_t> cDims(1, 1);
+  DataArrayPath tempPath(getCellAttributeMatrixPath().getDataContainerName(), getCellAttributeMatrixPath().getAttributeMatrixName(), getSimilarityArrayName());
+  m_SimilarityPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
+  if(nullptr != m_SimilarityPtr.lock())
+  {
+    m_Similarity = m_SimilarityPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::execute()
+{
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getCellAttributeMatrixPath().getDataContainerName());
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  std::array<size_t, 3> dims = {{udims[0], udims[1], udims[2]}};
+  std::array<int32_t, 3> kernelRadius = {{m_KernelSize[0], m_KernelSize[1], m_KernelSize[2]}};
+  const size_t numPoints = dims[0] * dims[1] * dims[2];
+
+  std::unique_ptr<PatternTileSource> source;
+  if(m_PatternSource == 0)
+  {
+    IDataArray::Pointer patternData = m_PatternDataPtr.lock();
+    if(UInt8ArrayType::Pointer patterns = std::dynamic_pointer_cast<UInt8ArrayType>(patternData))
+    {
+      source.reset(new ArrayPatternSource<uint8_t>(patterns->getPointer(0), numPoints, m_PatternSize));
+    }
+    else if(UInt16ArrayType::Pointer patterns = std::dynamic_pointer_cast<UInt16ArrayType>(patternData))
+    {
+      source.reset(new ArrayPatternSource<uint16_t>(patterns->getPointer(0), numPoints, m_PatternSize));
+    }
+    else if(FloatArrayType::Pointer patterns = std::dynamic_pointer_cast<FloatArrayType>(patternData))
+    {
+      source.reset(new ArrayPatternSource<float>(patterns->getPointer(0), numPoints, m_PatternSize));
+    }
+  }
+  else
+  {
+    std::unique_ptr<RawFilePatternSource> fileSource(
+        new RawFilePatternSource(getInputFile().toStdString(), m_PatternSize, static_cast<RawFilePatternSource::DataType>(m_FileDataType), static_cast<uint64_t>(m_HeaderBytes)));
+    if(!fileSource->isOpen())
+    {
+      QString ss = QObject::tr("The raw pattern file could not be opened for reading: '%1'").arg(getInputFile());
+      setErrorCondition(-23413, ss);
+      return;
+    }
+    source = std::move(fileSource);
+  }
+
+  PatternSimilarityEngine engine(*source, dims, kernelRadius);
+  engine.setMinimumSimilarity(m_MinimumSimilarity);
+  engine.setCancelCallback([this] { return getCancel(); });
+  engine.setProgressCallback([this](size_t rowsCompleted, size_t totalRows) {
+    size_t increment = std::max<size_t>(totalRows / 100, 1);
+    if(rowsCompleted % increment == 0 || rowsCompleted == totalRows)
+    {
+      QString ss = QObject::tr("Comparing Patterns || Row %1 of %2").arg(rowsCompleted).arg(totalRows);
+      notifyStatusMessage(ss);
+    }
+  });
+
+  std::ofstream averagedOut;
+  if(m_WriteAveragedPatterns)
+  {
+    // Make sure any directory path is also available as the user may have just typed
+    // in a path without actually creating the full path
+    QFileInfo fi(getAveragedPatternsFile());
+    QDir parentPath(fi.path());
+    if(!parentPath.mkpath("."))
+    {
+      QString ss = QObject::tr("Error creating parent path '%1'").arg(parentPath.absolutePath());
+      setErrorCondition(-23414, ss);
+      return;
+    }
+    averagedOut.open(getAveragedPatternsFile().toStdString(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!averagedOut.is_open())
+    {
+      QString ss = QObject::tr("The averaged patterns file could not be opened for writing: '%1'").arg(getAveragedPatternsFile());
+      setErrorCondition(-23415, ss);
+      return;
+    }
+    engine.setAveragedPatternWriter([&averagedOut](size_t firstPattern, size_t count, size_t patternSize, const float* patterns) {
+      static_cast<void>(firstPattern);
+      averagedOut.write(reinterpret_cast<const char*>(patterns), static_cast<std::streamsize>(count * patternSize * sizeof(float)));
+      return static_cast<bool>(averagedOut);
+    });
+  }
+
+  int32_t err = engine.execute(m_Similarity);
+  if(err == PatternSimilarityEngine::k_Canceled)
+  {
+    return;
+  }
+  if(err < 0)
+  {
+    QString ss = QString::fromStdString(engine.getErrorMessage());
+    setErrorCondition(err == PatternSimilarityEngine::k_ReadError ? -23416 : -23417, ss);
+    return;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer FindNeighborPatternSimilarity::newFilterInstance(bool copyFilterParameters) const
+{
+  FindNeighborPatternSimilarity::Pointer filter = FindNeighborPatternSimilarity::New();
+  if(copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getCompiledLibraryName() const
+{
+  return OrientationAnalysisConstants::OrientationAnalysisBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getBrandingString() const
+{
+  return "OrientationAnalysis";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << OrientationAnalysis::Version::Major() << "." << OrientationAnalysis::Version::Minor() << "." << OrientationAnalysis::Version::Patch();
+  return version;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getGroupName() const
+{
+  return SIMPL::FilterGroups::StatisticsFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUuid FindNeighborPatternSimilarity::getUuid() const
+{
+  return QUuid("{e24e8fdf-4723-4f2e-8467-a2671d5d290a}");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::CrystallographyFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getHumanLabel() const
+{
+  return "Find Neighbor Pattern Similarity";
+}
+
+// -----------------------------------------------------------------------------
+FindNeighborPatternSimilarity::Pointer FindNeighborPatternSimilarity::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<FindNeighborPatternSimilarity> FindNeighborPatternSimilarity::New()
+{
+  struct make_shared_enabler : public FindNeighborPatternSimilarity
+  {
+  };
+  std::shared_ptr<make_shared_enabler> val = std::make_shared<make_shared_enabler>();
+  val->setupFilterParameters();
+  return val;
+}
+
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getNameOfClass() const
+{
+  return QString("FindNeighborPatternSimilarity");
+}
+
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::ClassName()
+{
+  return QString("FindNeighborPatternSimilarity");
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setPatternSource(int value)
+{
+  m_PatternSource = value;
+}
+
+// -----------------------------------------------------------------------------
+int FindNeighborPatternSimilarity::getPatternSource() const
+{
+  return m_PatternSource;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setPatternDataArrayPath(const DataArrayPath& value)
+{
+  m_PatternDataArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindNeighborPatternSimilarity::getPatternDataArrayPath() const
+{
+  return m_PatternDataArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setInputFile(const QString& value)
+{
+  m_InputFile = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getInputFile() const
+{
+  return m_InputFile;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setPatternWidth(int value)
+{
+  m_PatternWidth = value;
+}
+
+// -----------------------------------------------------------------------------
+int FindNeighborPatternSimilarity::getPatternWidth() const
+{
+  return m_PatternWidth;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setPatternHeight(int value)
+{
+  m_PatternHeight = value;
+}
+
+// -----------------------------------------------------------------------------
+int FindNeighborPatternSimilarity::getPatternHeight() const
+{
+  return m_PatternHeight;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setFileDataType(int value)
+{
+  m_FileDataType = value;
+}
+
+// -----------------------------------------------------------------------------
+int FindNeighborPatternSimilarity::getFileDataType() const
+{
+  return m_FileDataType;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setHeaderBytes(int value)
+{
+  m_HeaderBytes = value;
+}
+
+// -----------------------------------------------------------------------------
+int FindNeighborPatternSimilarity::getHeaderBytes() const
+{
+  return m_HeaderBytes;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setKernelSize(const IntVec3Type& value)
+{
+  m_KernelSize = value;
+}
+
+// -----------------------------------------------------------------------------
+IntVec3Type FindNeighborPatternSimilarity::getKernelSize() const
+{
+  return m_KernelSize;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setMinimumSimilarity(float value)
+{
+  m_MinimumSimilarity = value;
+}
+
+// -----------------------------------------------------------------------------
+float FindNeighborPatternSimilarity::getMinimumSimilarity() const
+{
+  return m_MinimumSimilarity;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setWriteAveragedPatterns(bool value)
+{
+  m_WriteAveragedPatterns = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindNeighborPatternSimilarity::getWriteAveragedPatterns() const
+{
+  return m_WriteAveragedPatterns;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setAveragedPatternsFile(const QString& value)
+{
+  m_AveragedPatternsFile = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getAveragedPatternsFile() const
+{
+  return m_AveragedPatternsFile;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setCellAttributeMatrixPath(const DataArrayPath& value)
+{
+  m_CellAttributeMatrixPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindNeighborPatternSimilarity::getCellAttributeMatrixPath() const
+{
+  return m_CellAttributeMatrixPath;
+}
+
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setSimilarityArrayName(const QString& value)
+{
+  m_SimilarityArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindNeighborPatternSimilarity::getSimilarityArrayName() const
+{
+  return m_SimilarityArrayName;
+}
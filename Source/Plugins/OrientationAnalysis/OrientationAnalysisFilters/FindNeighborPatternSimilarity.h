@@ -0,0 +1,341 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <memory>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
+
+/**
+ * @brief The FindNeighborPatternSimilarity class. See [Filter documentation](@ref findneighborpatternsimilarity) for details.
+ */
+class OrientationAnalysis_EXPORT FindNeighborPatternSimilarity : public AbstractFilter
+{
+  Q_OBJECT
+
+  // Start Python bindings declarations
+  PYB11_BEGIN_BINDINGS(FindNeighborPatternSimilarity SUPERCLASS AbstractFilter)
+  PYB11_FILTER()
+  PYB11_SHARED_POINTERS(FindNeighborPatternSimilarity)
+  PYB11_FILTER_NEW_MACRO(FindNeighborPatternSimilarity)
+  PYB11_PROPERTY(int PatternSource READ getPatternSource WRITE setPatternSource)
+  PYB11_PROPERTY(DataArrayPath PatternDataArrayPath READ getPatternDataArrayPath WRITE setPatternDataArrayPath)
+  PYB11_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
+  PYB11_PROPERTY(int PatternWidth READ getPatternWidth WRITE setPatternWidth)
+  PYB11_PROPERTY(int PatternHeight READ getPatternHeight WRITE setPatternHeight)
+  PYB11_PROPERTY(int FileDataType READ getFileDataType WRITE setFileDataType)
+  PYB11_PROPERTY(int HeaderBytes READ getHeaderBytes WRITE setHeaderBytes)
+  PYB11_PROPERTY(IntVec3Type KernelSize READ getKernelSize WRITE setKernelSize)
+  PYB11_PROPERTY(float MinimumSimilarity READ getMinimumSimilarity WRITE setMinimumSimilarity)
+  PYB11_PROPERTY(bool WriteAveragedPatterns READ getWriteAveragedPatterns WRITE setWriteAveragedPatterns)
+  PYB11_PROPERTY(QString AveragedPatternsFile READ getAveragedPatternsFile WRITE setAveragedPatternsFile)
+  PYB11_PROPERTY(DataArrayPath CellAttributeMatrixPath READ getCellAttributeMatrixPath WRITE setCellAttributeMatrixPath)
+  PYB11_PROPERTY(QString SimilarityArrayName READ getSimilarityArrayName WRITE setSimilarityArrayName)
+  PYB11_END_BINDINGS()
+  // End Python bindings declarations
+
+public:
+  using Self = FindNeighborPatternSimilarity;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+
+  /**
+   * @brief Returns a NullPointer wrapped by a shared_ptr<>
+   * @return
+   */
+  static Pointer NullPointer();
+
+  /**
+   * @brief Creates a new object wrapped in a shared_ptr<>
+   * @return
+   */
+  static Pointer New();
+
+  /**
+   * @brief Returns the name of the class for FindNeighborPatternSimilarity
+   */
+  QString getNameOfClass() const override;
+  /**
+   * @brief Returns the name of the class for FindNeighborPatternSimilarity
+   */
+  static QString ClassName();
+
+  ~FindNeighborPatternSimilarity() override;
+
+  /**
+   * @brief Setter property for PatternSource
+   */
+  void setPatternSource(int value);
+  /**
+   * @brief Getter property for PatternSource
+   * @return Value of PatternSource
+   */
+  int getPatternSource() const;
+  Q_PROPERTY(int PatternSource READ getPatternSource WRITE setPatternSource)
+
+  /**
+   * @brief Setter property for PatternDataArrayPath
+   */
+  void setPatternDataArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for PatternDataArrayPath
+   * @return Value of PatternDataArrayPath
+   */
+  DataArrayPath getPatternDataArrayPath() const;
+  Q_PROPERTY(DataArrayPath PatternDataArrayPath READ getPatternDataArrayPath WRITE setPatternDataArrayPath)
+
+  /**
+   * @brief Setter property for InputFile
+   */
+  void setInputFile(const QString& value);
+  /**
+   * @brief Getter property for InputFile
+   * @return Value of InputFile
+   */
+  QString getInputFile() const;
+  Q_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
+
+  /**
+   * @brief Setter property for PatternWidth
+   */
+  void setPatternWidth(int value);
+  /**
+   * @brief Getter property for PatternWidth
+   * @return Value of PatternWidth
+   */
+  int getPatternWidth() const;
+  Q_PROPERTY(int PatternWidth READ getPatternWidth WRITE setPatternWidth)
+
+  /**
+   * @brief Setter property for PatternHeight
+   */
+  void setPatternHeight(int value);
+  /**
+   * @brief Getter property for PatternHeight
+   * @return Value of PatternHeight
+   */
+  int getPatternHeight() const;
+  Q_PROPERTY(int PatternHeight READ getPatternHeight WRITE setPatternHeight)
+
+  /**
+   * @brief Setter property for FileDataType
+   */
+  void setFileDataType(int value);
+  /**
+   * @brief Getter property for FileDataType
+   * @return Value of FileDataType
+   */
+  int getFileDataType() const;
+  Q_PROPERTY(int FileDataType READ getFileDataType WRITE setFileDataType)
+
+  /**
+   * @brief Setter property for HeaderBytes
+   */
+  void setHeaderBytes(int value);
+  /**
+   * @brief Getter property for HeaderBytes
+   * @return Value of HeaderBytes
+   */
+  int getHeaderBytes() const;
+  Q_PROPERTY(int HeaderBytes READ getHeaderBytes WRITE setHeaderBytes)
+
+  /**
+   * @brief Setter property for KernelSize
+   */
+  void setKernelSize(const IntVec3Type& value);
+  /**
+   * @brief Getter property for KernelSize
+   * @return Value of KernelSize
+   */
+  IntVec3Type getKernelSize() const;
+  Q_PROPERTY(IntVec3Type KernelSize READ getKernelSize WRITE setKernelSize)
+
+  /**
+   * @brief Setter property for MinimumSimilarity
+   */
+  void setMinimumSimilarity(float value);
+  /**
+   * @brief Getter property for MinimumSimilarity
+   * @return Value of MinimumSimilarity
+   */
+  float getMinimumSimilarity() const;
+  Q_PROPERTY(float MinimumSimilarity READ getMinimumSimilarity WRITE setMinimumSimilarity)
+
+  /**
+   * @brief Setter property for WriteAveragedPatterns
+   */
+  void setWriteAveragedPatterns(bool value);
+  /**
+   * @brief Getter property for WriteAveragedPatterns
+   * @return Value of WriteAveragedPatterns
+   */
+  bool getWriteAveragedPatterns() const;
+  Q_PROPERTY(bool WriteAveragedPatterns READ getWriteAveragedPatterns WRITE setWriteAveragedPatterns)
+
+  /**
+   * @brief Setter property for AveragedPatternsFile
+   */
+  void setAveragedPatternsFile(const QString& value);
+  /**
+   * @brief Getter property for AveragedPatternsFile
+   * @return Value of AveragedPatternsFile
+   */
+  QString getAveragedPatternsFile() const;
+  Q_PROPERTY(QString AveragedPatternsFile READ getAveragedPatternsFile WRITE setAveragedPatternsFile)
+
+  /**
+   * @brief Setter property for CellAttributeMatrixPath
+   */
+  void setCellAttributeMatrixPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for CellAttributeMatrixPath
+   * @return Value of CellAttributeMatrixPath
+   */
+  DataArrayPath getCellAttributeMatrixPath() const;
+  Q_PROPERTY(DataArrayPath CellAttributeMatrixPath READ getCellAttributeMatrixPath WRITE setCellAttributeMatrixPath)
+
+  /**
+   * @brief Setter property for SimilarityArrayName
+   */
+  void setSimilarityArrayName(const QString& value);
+  /**
+   * @brief Getter property for SimilarityArrayName
+   * @return Value of SimilarityArrayName
+   */
+  QString getSimilarityArrayName() const;
+  Q_PROPERTY(QString SimilarityArrayName READ getSimilarityArrayName WRITE setSimilarityArrayName)
+
+  /**
+   * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+   */
+  QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+   */
+  QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  QString getFilterVersion() const override;
+
+  /**
+   * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+   */
+  AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+  /**
+   * @brief getGroupName Reimplemented from @see AbstractFilter class
+   */
+  QString getGroupName() const override;
+
+  /**
+   * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+   */
+  QString getSubGroupName() const override;
+
+  /**
+   * @brief getUuid Return the unique identifier for this filter.
+   * @return A QUuid object.
+   */
+  QUuid getUuid() const override;
+
+  /**
+   * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+   */
+  QString getHumanLabel() const override;
+
+  /**
+   * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void setupFilterParameters() override;
+
+  /**
+   * @brief execute Reimplemented from @see AbstractFilter class
+   */
+  void execute() override;
+
+protected:
+  FindNeighborPatternSimilarity();
+  /**
+   * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
+   */
+  void dataCheck() override;
+
+  /**
+   * @brief Initializes all the private instance variables.
+   */
+  void initialize();
+
+private:
+  IDataArray::WeakPointer m_PatternDataPtr;
+  std::weak_ptr<DataArray<float>> m_SimilarityPtr;
+  float* m_Similarity = nullptr;
+
+  int m_PatternSource = {0};
+  DataArrayPath m_PatternDataArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "PatternData"};
+  QString m_InputFile = {};
+  int m_PatternWidth = {60};
+  int m_PatternHeight = {60};
+  int m_FileDataType = {0};
+  int m_HeaderBytes = {0};
+  IntVec3Type m_KernelSize = {};
+  float m_MinimumSimilarity = {0.0f};
+  bool m_WriteAveragedPatterns = {false};
+  QString m_AveragedPatternsFile = {};
+  DataArrayPath m_CellAttributeMatrixPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""};
+  QString m_SimilarityArrayName = {"NeighborPatternSimilarity"};
+
+  size_t m_PatternSize = 0;
+
+public:
+  FindNeighborPatternSimilarity(const FindNeighborPatternSimilarity&) = delete;            // Copy Constructor Not Implemented
+  FindNeighborPatternSimilarity(FindNeighborPatternSimilarity&&) = delete;                 // Move Constructor Not Implemented
+  FindNeighborPatternSimilarity& operator=(const FindNeighborPatternSimilarity&) = delete; // Copy Assignment Not Implemented
+  FindNeighborPatternSimilarity& operator=(FindNeighborPatternSimilarity&&) = delete;      // Move Assignment Not Implemented
+};
@@ -14,6 +14,7 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/OrientationBatchConverter.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
@@ -31,9 +32,10 @@ enum createdPathID : RenameDataPath::DataID_t
 class GenerateOrientationMatrixTransposeImpl
 {
 public:
-  GenerateOrientationMatrixTransposeImpl(GenerateOrientationMatrixTranspose* filter, float* outputRod)
+  GenerateOrientationMatrixTransposeImpl(GenerateOrientationMatrixTranspose* filter, float* inputMatrices, float* outputMatrices)
   : m_Filter(filter)
-  , m_Output(outputRod)
+  , m_Input(inputMatrices)
+  , m_Output(outputMatrices)
   {
   }
   GenerateOrientationMatrixTransposeImpl(const GenerateOrientationMatrixTransposeImpl&) = default;           // Copy Constructor
@@ -45,22 +47,14 @@ public:
 
   void convert(size_t start, size_t end) const
   {
-    for(size_t i = start; i < end; i++)
+    for(size_t i = start; i < end; i += OrientationAnalysis::OrientationBatch::k_BlockSize)
     {
       if(m_Filter->getCancel())
       {
         return;
       }
-
-      m_Output[i * 4] = m_Output[i * 4];
-      m_Output[i * 4 + 1] = m_Output[i * 4 + 3];
-      m_Output[i * 4 + 2] = m_Output[i * 4 + 6];
-      m_Output[i * 4 + 3] = m_Output[i * 4 + 1];
-      m_Output[i * 4 + 4] = m_Output[i * 4 + 4];
-      m_Output[i * 4 + 5] = m_Output[i * 4 + 7];
-      m_Output[i * 4 + 6] = m_Output[i * 4 + 2];
-      m_Output[i * 4 + 7] = m_Output[i * 4 + 5];
-      m_Output[i * 4 + 8] = m_Output[i * 4 + 8];
+      size_t blockEnd = std::min(i + OrientationAnalysis::OrientationBatch::k_BlockSize, end);
+      OrientationAnalysis::OrientationBatch::TransposeMatrices(m_Input, m_Output, i, blockEnd);
     }
   }
 
@@ -72,6 +66,7 @@ public:
 #endif
 private:
   GenerateOrientationMatrixTranspose* m_Filter = nullptr;
+  float* m_Input;
   float* m_Output;
 };
 
@@ -172,12 +167,12 @@ void GenerateOrientationMatrixTranspose::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), GenerateOrientationMatrixTransposeImpl(this, m_OutputOrientationMatrix), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), GenerateOrientationMatrixTransposeImpl(this, m_OrientationMatrix, m_OutputOrientationMatrix), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    GenerateOrientationMatrixTransposeImpl serial(this, m_OutputOrientationMatrix);
+    GenerateOrientationMatrixTransposeImpl serial(this, m_OrientationMatrix, m_OutputOrientationMatrix);
     serial.convert(0, totalPoints);
   }
 
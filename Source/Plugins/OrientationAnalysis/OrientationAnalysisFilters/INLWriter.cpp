@@ -51,6 +51,8 @@
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/IO/TSL/AngConstants.h"
 
+#include "ImportExport/ImportExportFilters/util/TextFormatter.h"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -359,51 +361,68 @@ int32_t INLWriter::writeFile()
 
   fprintf(f, "# phi1 PHI phi2 x y z FeatureId PhaseId Symmetry\r\n");
 
-  float phi1 = 0.0f, phi = 0.0f, phi2 = 0.0f;
-  float xPos = 0.0f, yPos = 0.0f, zPos = 0.0f;
-  int32_t featureId = 0;
-  int32_t phaseId = 0;
-
-  size_t index = 0;
-  for(size_t z = 0; z < dims[2]; ++z)
-  {
-    for(size_t y = 0; y < dims[1]; ++y)
+  // The cell records are formatted in parallel chunks and written in order, so the output matches "%f %f %f %f %f %f %d %d %d"
+  ImportExport::ParallelTextWriter writer(ImportExport::ParallelTextWriter::FileSink(f));
+  writer.setProgressCallback([this](size_t /* itemsWritten */, size_t /* totalItems */) { return !getCancel(); });
+  bool completed = writer.write(totalPoints, [&](ImportExport::TextBuffer& buffer, size_t start, size_t end) {
+    float xPos = 0.0f, yPos = 0.0f, zPos = 0.0f;
+    int32_t phaseId = 0;
+    uint32_t cellSymmetry = 0;
+    for(size_t index = start; index < end; index++)
     {
-      for(size_t x = 0; x < dims[0]; ++x)
+      size_t x = index % dims[0];
+      size_t y = (index / dims[0]) % dims[1];
+      size_t z = index / (dims[0] * dims[1]);
+      xPos = origin[0] + (x * res[0]);
+      yPos = origin[1] + (y * res[1]);
+      zPos = origin[2] + (z * res[2]);
+      phaseId = m_CellPhases[index];
+      cellSymmetry = m_CrystalStructures[phaseId];
+      if(phaseId > 0)
       {
-        index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
-        phi1 = m_CellEulerAngles[index * 3];
-        phi = m_CellEulerAngles[index * 3 + 1];
-        phi2 = m_CellEulerAngles[index * 3 + 2];
-        xPos = origin[0] + (x * res[0]);
-        yPos = origin[1] + (y * res[1]);
-        zPos = origin[2] + (z * res[2]);
-        featureId = m_FeatureIds[index];
-        phaseId = m_CellPhases[index];
-        symmetry = m_CrystalStructures[phaseId];
-        if(phaseId > 0)
+        if(cellSymmetry == EbsdLib::CrystalStructure::Cubic_High)
         {
-          if(symmetry == EbsdLib::CrystalStructure::Cubic_High)
-          {
-            symmetry = EbsdLib::Ang::PhaseSymmetry::Cubic;
-          }
-          else if(symmetry == EbsdLib::CrystalStructure::Hexagonal_High)
-          {
-            symmetry = EbsdLib::Ang::PhaseSymmetry::DiHexagonal;
-          }
-          else
-          {
-            symmetry = EbsdLib::Ang::PhaseSymmetry::UnknownSymmetry;
-          }
+          cellSymmetry = EbsdLib::Ang::PhaseSymmetry::Cubic;
+        }
+        else if(cellSymmetry == EbsdLib::CrystalStructure::Hexagonal_High)
+        {
+          cellSymmetry = EbsdLib::Ang::PhaseSymmetry::DiHexagonal;
         }
         else
         {
-          symmetry = EbsdLib::Ang::PhaseSymmetry::UnknownSymmetry;
+          cellSymmetry = EbsdLib::Ang::PhaseSymmetry::UnknownSymmetry;
         }
-
-        fprintf(f, "%f %f %f %f %f %f %d %d %d\r\n", phi1, phi, phi2, xPos, yPos, zPos, featureId, phaseId, symmetry);
       }
+      else
+      {
+        cellSymmetry = EbsdLib::Ang::PhaseSymmetry::UnknownSymmetry;
+      }
+
+      buffer.appendFixed(m_CellEulerAngles[index * 3]);
+      buffer.append(' ');
+      buffer.appendFixed(m_CellEulerAngles[index * 3 + 1]);
+      buffer.append(' ');
+      buffer.appendFixed(m_CellEulerAngles[index * 3 + 2]);
+      buffer.append(' ');
+      buffer.appendFixed(xPos);
+      buffer.append(' ');
+      buffer.appendFixed(yPos);
+      buffer.append(' ');
+      buffer.appendFixed(zPos);
+      buffer.append(' ');
+      buffer.appendInt(m_FeatureIds[index]);
+      buffer.append(' ');
+      buffer.appendInt(phaseId);
+      buffer.append(' ');
+      buffer.appendInt(static_cast<int32_t>(cellSymmetry));
+      buffer.append("\r\n", 2);
     }
+  });
+  if(!completed && !getCancel())
+  {
+    QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-1, ss);
+    err = -1;
   }
 
   fclose(f);
@@ -31,6 +31,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ImportEbsdMontage.h"
 
+#include <algorithm>
+#include <mutex>
+
 #include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 
@@ -60,6 +63,11 @@
 #include "OrientationAnalysis/OrientationAnalysisFilters/ReadCtfData.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#endif
+
 enum createdPathID : RenameDataPath::DataID_t
 {
   DataArrayID31 = 31
@@ -118,58 +126,97 @@ void ImportEbsdMontage::setupFilterParameters()
     parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Generate IPF Color Map", GenerateIPFColorMap, FilterParameter::Category::Parameter, ImportEbsdMontage, linkedProps));
     parameters.push_back(SIMPL_NEW_STRING_FP("IPF Colors", CellIPFColorsArrayName, FilterParameter::Category::CreatedArray, ImportEbsdMontage));
   }
+  {
+    std::vector<QString> linkedProps = {"MaxConcurrentTiles", "MemoryBudget"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Read Tiles in Parallel", ParallelImport, FilterParameter::Category::Parameter, ImportEbsdMontage, linkedProps));
+    parameters.push_back(SIMPL_NEW_INTEGER_FP("Maximum Concurrent Tiles (0 = Automatic)", MaxConcurrentTiles, FilterParameter::Category::Parameter, ImportEbsdMontage));
+    parameters.push_back(SIMPL_NEW_INTEGER_FP("Memory Budget (MB, 0 = Unlimited)", MemoryBudget, FilterParameter::Category::Parameter, ImportEbsdMontage));
+  }
   setFilterParameters(parameters);
 }
 
+namespace
+{
+/**
+ * @brief The TileReadTask struct holds the reader and the destination of a single montage tile.
+ */
+struct TileReadTask
+{
+  QString fileName;
+  QString dcName;
+  size_t row = 0;
+  size_t col = 0;
+  AbstractFilter::Pointer reader;
+  DataContainerArray::Pointer dca;
+  size_t estimatedBytes = 0;
+  int32_t errorCode = 0;
+  QString errorLabel;
+};
+
+/**
+ * @brief nextTileBatch Returns the end of the batch of tiles that starts at batchStart. The estimated sizes of the
+ * tiles in a batch add up to at most the memory budget, so the tiles of a batch can all be read at the same time.
+ * A tile larger than the whole budget is a batch of its own.
+ * @param tasks
+ * @param batchStart
+ * @param memoryBudget Budget in bytes, 0 for no limit
+ * @return
+ */
+size_t nextTileBatch(const std::vector<TileReadTask>& tasks, size_t batchStart, size_t memoryBudget)
+{
+  size_t batchEnd = batchStart + 1;
+  size_t batchBytes = tasks[batchStart].estimatedBytes;
+  while(batchEnd < tasks.size() && (memoryBudget == 0 || batchBytes + tasks[batchEnd].estimatedBytes <= memoryBudget))
+  {
+    batchBytes += tasks[batchEnd].estimatedBytes;
+    batchEnd++;
+  }
+  return batchEnd;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <class EbsdReaderClass>
-void readEbsdFile(ImportEbsdMontage* filter, const QString& fileName, std::map<QString, AbstractFilter::Pointer>& prevFilterCache, std::map<QString, AbstractFilter::Pointer>& newFilterCache)
+AbstractFilter::Pointer createEbsdReader(ImportEbsdMontage* filter, TileReadTask& task, std::map<QString, AbstractFilter::Pointer>& prevFilterCache,
+                                         std::map<QString, AbstractFilter::Pointer>& newFilterCache)
 {
-  QFileInfo fi(fileName);
-  QString fname = fi.completeBaseName();
-  if(filter->getDataContainerArray()->doesDataContainerExist(fname))
-  {
-    QString msg = QString("Error: DataContainer '%1' already exists in the DataContainerArray.").arg(fname);
-    filter->setErrorCondition(-74000, msg);
-    return;
-  }
-
-  DataContainerArray::Pointer dca = DataContainerArray::New();
-
+  // Reuse the reader from the previous preflight so its cached header is not parsed again
   typename EbsdReaderClass::Pointer reader = EbsdReaderClass::NullPointer();
-  if(prevFilterCache.find(fileName) != prevFilterCache.end())
+  if(prevFilterCache.find(task.fileName) != prevFilterCache.end())
   {
-    reader = std::dynamic_pointer_cast<EbsdReaderClass>(prevFilterCache[fileName]);
+    reader = std::dynamic_pointer_cast<EbsdReaderClass>(prevFilterCache[task.fileName]);
   }
-  else
+  if(nullptr == reader)
   {
     reader = EbsdReaderClass::New();
-    reader->setInputFile(fileName);
-    reader->setDataContainerName(DataArrayPath(fname));
+    reader->setInputFile(task.fileName);
+    reader->setDataContainerName(DataArrayPath(task.dcName));
   }
-  newFilterCache[fileName] = reader;
-  reader->setDataContainerArray(dca);
+  newFilterCache[task.fileName] = reader;
+  reader->setDataContainerArray(task.dca);
   reader->setCellEnsembleAttributeMatrixName(filter->getCellEnsembleAttributeMatrixName());
   reader->setCellAttributeMatrixName(filter->getCellAttributeMatrixName());
-  if(filter->getInPreflight())
+  return reader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::updateTileProgress(const QString& fileName)
+{
+  size_t tilesRead = m_TilesRead;
+  if(getInPreflight())
   {
-    reader->preflight();
+    QString msg = QString("Caching EBSD Header: [%1/%2] %3").arg(tilesRead).arg(m_TotalTiles).arg(fileName);
+    notifyStatusMessage(msg);
   }
   else
   {
-    reader->execute();
-  }
-  if(reader->getErrorCode() < 0)
-  {
-    QString msg = QString("Sub filter (%1) caused an error.").arg(reader->getHumanLabel());
-    filter->setErrorCondition(reader->getErrorCode(), msg);
-    return;
+    QString msg = QString("Read EBSD File: [%1/%2] %3").arg(tilesRead).arg(m_TotalTiles).arg(fileName);
+    notifyStatusMessage(msg);
   }
-
-  DataContainer::Pointer dc = dca->getDataContainer(fname);
-  filter->getDataContainerArray()->addOrReplaceDataContainer(dc);
 }
 
 // -----------------------------------------------------------------------------
@@ -183,6 +230,13 @@ void ImportEbsdMontage::dataCheck()
   DataArrayPath tempPath;
   QString ss;
 
+  if(m_MaxConcurrentTiles < 0 || m_MemoryBudget < 0)
+  {
+    ss = QObject::tr("The maximum number of concurrent tiles and the memory budget must be zero or positive.");
+    setErrorCondition(-14, ss);
+    return;
+  }
+
   if(m_DefineScanOverlap != OverlapType::None && m_DefineScanOverlap != OverlapType::Pixels && m_DefineScanOverlap != OverlapType::Percent)
   {
     ss = QObject::tr("The OverLap type must either be 0 (None) or 1 (Pixels) or 2 (Percent).");
@@ -237,40 +291,46 @@ void ImportEbsdMontage::dataCheck()
   size_t cols = static_cast<size_t>(m_InputFileListInfo.ColEnd - m_InputFileListInfo.ColStart);
   GridMontage::Pointer gridMontage = GridMontage::New(getMontageName(), rows, cols);
 
-  // Read all the files, caching the pertainent information....
+  // Find all the files and set up a reader for each of them....
+  std::vector<TileReadTask> tasks;
+  tasks.reserve(static_cast<size_t>(totalTiles));
   for(const FilePathGenerator::TileRCIndexRow2D& tileRow2D : tileLayout2d)
   {
-    globalTileOrigin[0] = 0.0; // Reset the X Coord back to Zero for each row.
     for(const FilePathGenerator::TileRCIndex2D& tile2D : tileRow2D)
     {
-      tilesRead++;
       QFileInfo fi(tile2D.FileName);
-      QString fname = fi.completeBaseName();
       if(!fi.exists())
       {
         QString msg = QString("Input EBSD file '%1' does not exist").arg(tile2D.FileName);
         setErrorCondition(-56500, msg);
         continue;
       }
-      if(getInPreflight())
-      {
-        QString msg = QString("Caching EBSD Header: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile2D.FileName);
-        notifyStatusMessage(msg);
-      }
-      else
+      TileReadTask task;
+      task.fileName = tile2D.FileName;
+      task.dcName = fi.completeBaseName();
+      if(getDataContainerArray()->doesDataContainerExist(task.dcName))
       {
-        QString msg = QString("Read EBSD File: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile2D.FileName);
-        notifyStatusMessage(msg);
+        QString msg = QString("Error: DataContainer '%1' already exists in the DataContainerArray.").arg(task.dcName);
+        setErrorCondition(-74000, msg);
+        continue;
       }
-      GridTileIndex gridIndex = gridMontage->getTileIndex(tile2D.data[0], tile2D.data[1]);
+      task.row = static_cast<size_t>(tile2D.data[0]);
+      task.col = static_cast<size_t>(tile2D.data[1]);
+      task.dca = DataContainerArray::New();
+      // The parsed arrays take about as much memory as the ASCII file they came from
+      task.estimatedBytes = getInPreflight() ? 0 : static_cast<size_t>(fi.size());
 
       if(m_InputFileListInfo.FileExtension == S2Q(EbsdLib::Ang::FileExt))
       {
-        readEbsdFile<ReadAngData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
+        task.reader = createEbsdReader<ReadAngData>(this, task, m_FilterCache, newFilterCache);
       }
       if(m_InputFileListInfo.FileExtension == S2Q(EbsdLib::Ctf::FileExt))
       {
-        readEbsdFile<ReadCtfData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
+        task.reader = createEbsdReader<ReadCtfData>(this, task, m_FilterCache, newFilterCache);
+      }
+      if(nullptr != task.reader)
+      {
+        tasks.push_back(task);
       }
     }
   }
@@ -280,6 +340,95 @@ void ImportEbsdMontage::dataCheck()
     return;
   }
 
+  // Read all the files, caching the pertainent information. Each tile is installed into the
+  // montage as soon as it has been read.
+  m_TilesRead = 0;
+  m_TotalTiles = static_cast<size_t>(totalTiles);
+  std::mutex installMutex;
+  auto readTile = [&](TileReadTask& task) {
+    if(getCancel())
+    {
+      return;
+    }
+    if(getInPreflight())
+    {
+      task.reader->preflight();
+    }
+    else
+    {
+      task.reader->execute();
+    }
+    if(task.reader->getErrorCode() < 0)
+    {
+      task.errorCode = task.reader->getErrorCode();
+      task.errorLabel = task.reader->getHumanLabel();
+      return;
+    }
+    DataContainer::Pointer dc = task.dca->getDataContainer(task.dcName);
+    {
+      std::lock_guard<std::mutex> lock(installMutex);
+      getDataContainerArray()->addOrReplaceDataContainer(dc);
+      GridTileIndex gridIndex = gridMontage->getTileIndex(task.row, task.col);
+      gridMontage->setDataContainer(gridIndex, dc);
+    }
+    m_TilesRead++;
+  };
+
+  // The tiles are read in batches that fit into the memory budget. The reading threads never wait on each other;
+  // the next batch is only started from this thread once the previous one is done, and the progress is reported
+  // from here as well. Without parallel reading every tile is a batch of its own.
+  size_t memoryBudget = static_cast<size_t>(std::max(m_MemoryBudget, 0)) * 1024ULL * 1024ULL;
+  bool parallelImport = false;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  parallelImport = m_ParallelImport && tasks.size() > 1;
+  tbb::task_arena arena(m_MaxConcurrentTiles > 0 ? m_MaxConcurrentTiles : static_cast<int>(tbb::task_arena::automatic));
+#endif
+  for(size_t batchStart = 0; batchStart < tasks.size() && !getCancel();)
+  {
+    size_t batchEnd = parallelImport ? nextTileBatch(tasks, batchStart, memoryBudget) : batchStart + 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(parallelImport && batchEnd - batchStart > 1)
+    {
+      arena.execute([&tasks, &readTile, batchStart, batchEnd] {
+        tbb::task_group taskGroup;
+        for(size_t t = batchStart; t < batchEnd; t++)
+        {
+          TileReadTask& task = tasks[t];
+          taskGroup.run([&task, &readTile] { readTile(task); });
+        }
+        taskGroup.wait();
+      });
+    }
+    else
+#endif
+    {
+      for(size_t t = batchStart; t < batchEnd; t++)
+      {
+        readTile(tasks[t]);
+      }
+    }
+    updateTileProgress(tasks[batchEnd - 1].fileName);
+    batchStart = batchEnd;
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+  // Report any reader errors in the same order that the tiles are laid out
+  for(const TileReadTask& task : tasks)
+  {
+    if(task.errorCode < 0)
+    {
+      QString msg = QString("Sub filter (%1) caused an error.").arg(task.errorLabel);
+      setErrorCondition(task.errorCode, msg);
+    }
+  }
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
   tilesRead = 0;
 
   // Copy to local variable since we may be modifying the value.....
@@ -343,7 +492,6 @@ void ImportEbsdMontage::dataCheck()
       QFileInfo fi(tile2D.FileName);
       QString fname = fi.completeBaseName();
 
-      GridTileIndex gridIndex = gridMontage->getTileIndex(tile2D.data[0], tile2D.data[1]);
       QString phasesName;
       QString eulersName;
       QString xtalName;
@@ -390,9 +538,6 @@ void ImportEbsdMontage::dataCheck()
         break;
       }
 
-      // Set the montage's DataContainer for the current index
-      gridMontage->setDataContainer(gridIndex, dc);
-
       if(getCancel())
       {
         return;
@@ -690,3 +835,39 @@ IntVec2Type ImportEbsdMontage::getScanOverlapPixel() const
 {
   return m_ScanOverlapPixel;
 }
+
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::setParallelImport(bool value)
+{
+  m_ParallelImport = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ImportEbsdMontage::getParallelImport() const
+{
+  return m_ParallelImport;
+}
+
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::setMaxConcurrentTiles(int32_t value)
+{
+  m_MaxConcurrentTiles = value;
+}
+
+// -----------------------------------------------------------------------------
+int32_t ImportEbsdMontage::getMaxConcurrentTiles() const
+{
+  return m_MaxConcurrentTiles;
+}
+
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::setMemoryBudget(int32_t value)
+{
+  m_MemoryBudget = value;
+}
+
+// -----------------------------------------------------------------------------
+int32_t ImportEbsdMontage::getMemoryBudget() const
+{
+  return m_MemoryBudget;
+}
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 
@@ -69,6 +70,9 @@ class OrientationAnalysis_EXPORT ImportEbsdMontage : public AbstractFilter
   PYB11_PROPERTY(QString CellIPFColorsArrayName READ getCellIPFColorsArrayName WRITE setCellIPFColorsArrayName)
   PYB11_PROPERTY(int32_t DefineScanOverlap READ getDefineScanOverlap WRITE setDefineScanOverlap)
   PYB11_PROPERTY(FloatVec2Type ScanOverlapPercent READ getScanOverlapPercent WRITE setScanOverlapPercent)
+  PYB11_PROPERTY(bool ParallelImport READ getParallelImport WRITE setParallelImport)
+  PYB11_PROPERTY(int32_t MaxConcurrentTiles READ getMaxConcurrentTiles WRITE setMaxConcurrentTiles)
+  PYB11_PROPERTY(int32_t MemoryBudget READ getMemoryBudget WRITE setMemoryBudget)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -220,6 +224,39 @@ public:
   IntVec2Type getScanOverlapPixel() const;
   Q_PROPERTY(IntVec2Type ScanOverlapPixel READ getScanOverlapPixel WRITE setScanOverlapPixel)
 
+  /**
+   * @brief Setter property for ParallelImport
+   */
+  void setParallelImport(bool value);
+  /**
+   * @brief Getter property for ParallelImport
+   * @return Value of ParallelImport
+   */
+  bool getParallelImport() const;
+  Q_PROPERTY(bool ParallelImport READ getParallelImport WRITE setParallelImport)
+
+  /**
+   * @brief Setter property for MaxConcurrentTiles
+   */
+  void setMaxConcurrentTiles(int32_t value);
+  /**
+   * @brief Getter property for MaxConcurrentTiles
+   * @return Value of MaxConcurrentTiles
+   */
+  int32_t getMaxConcurrentTiles() const;
+  Q_PROPERTY(int32_t MaxConcurrentTiles READ getMaxConcurrentTiles WRITE setMaxConcurrentTiles)
+
+  /**
+   * @brief Setter property for MemoryBudget
+   */
+  void setMemoryBudget(int32_t value);
+  /**
+   * @brief Getter property for MemoryBudget
+   * @return Value of MemoryBudget
+   */
+  int32_t getMemoryBudget() const;
+  Q_PROPERTY(int32_t MemoryBudget READ getMemoryBudget WRITE setMemoryBudget)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -275,6 +312,13 @@ public:
    */
   void execute() override;
 
+  /**
+   * @brief updateTileProgress Sends a status message with the number of tiles read so far. This is
+   * called from the thread that runs the filter once a batch of tiles has been read.
+   * @param fileName The last file of the batch
+   */
+  void updateTileProgress(const QString& fileName);
+
 protected:
   ImportEbsdMontage();
 
@@ -308,6 +352,13 @@ private:
   bool m_GenerateIPFColorMap = false;
   QString m_CellIPFColorsArrayName = QString(SIMPL::CellData::IPFColor);
 
+  bool m_ParallelImport = true;
+  int32_t m_MaxConcurrentTiles = 0;
+  int32_t m_MemoryBudget = 0;
+
+  std::atomic<size_t> m_TilesRead{0};
+  size_t m_TotalTiles = 0;
+
 public:
   ImportEbsdMontage(const ImportEbsdMontage&) = delete;            // Copy Constructor Not Implemented
   ImportEbsdMontage& operator=(const ImportEbsdMontage&) = delete; // Copy Assignment Not Implemented
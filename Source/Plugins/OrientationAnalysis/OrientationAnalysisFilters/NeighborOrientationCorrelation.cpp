@@ -35,6 +35,7 @@
 
 #include "NeighborOrientationCorrelation.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <QtCore/QTextStream>
@@ -50,6 +51,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
@@ -70,9 +72,10 @@ public:
   NeighborOrientationCorrelationTransferDataImpl() = delete;
   NeighborOrientationCorrelationTransferDataImpl(const NeighborOrientationCorrelationTransferDataImpl&) = default;
 
-  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, size_t totalPoints, const std::vector<int64_t>& bestNeighbor, IDataArray::Pointer dataArrayPtr)
+  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, const std::vector<int64_t>& replacedCells, const std::vector<int64_t>& bestNeighbor,
+                                                 IDataArray::Pointer dataArrayPtr)
   : m_Filter(filter)
-  , m_TotalPoints(totalPoints)
+  , m_ReplacedCells(replacedCells)
   , m_BestNeighbor(bestNeighbor)
   , m_DataArrayPtr(dataArrayPtr)
   {
@@ -85,31 +88,165 @@ public:
 
   void operator()() const
   {
-    size_t progIncrement = static_cast<size_t>(m_TotalPoints / 50);
+    size_t totalCells = m_ReplacedCells.size();
+    size_t progIncrement = static_cast<size_t>(totalCells / 50);
     size_t prog = 1;
-    for(size_t i = 0; i < m_TotalPoints; i++)
+    // The Cells are visited in increasing index order so chained copies resolve as in a full sweep
+    for(size_t c = 0; c < totalCells; c++)
     {
-      if(i > prog)
+      if(c > prog)
       {
         prog = prog + progIncrement;
         m_Filter->updateProgress(progIncrement);
       }
-      int64_t neighbor = m_BestNeighbor[i];
-      if(neighbor != -1)
-      {
-        // IDataArray::Pointer p = m_AttrMat->getAttributeArray(m_VoxelArrayNames[m_VoxelArrayIndex]);
-        m_DataArrayPtr->copyTuple(neighbor, i);
-      }
+      int64_t i = m_ReplacedCells[c];
+      m_DataArrayPtr->copyTuple(m_BestNeighbor[i], i);
     }
   }
 
 private:
   NeighborOrientationCorrelation* m_Filter = nullptr;
-  size_t m_TotalPoints = 0;
-  std::vector<int64_t> m_BestNeighbor;
+  const std::vector<int64_t>& m_ReplacedCells;
+  const std::vector<int64_t>& m_BestNeighbor;
   IDataArray::Pointer m_DataArrayPtr;
 };
 
+/**
+ * @brief The FindSelfSimilarityImpl class implements a threaded algorithm that evaluates the
+ * orientation test the neighbor correlation applies to a neighboring Cell for a list of Cells.
+ * The test only depends on the Cell itself, so each result is stored in a per Cell state and
+ * reused until the data of that Cell is replaced.
+ */
+class FindSelfSimilarityImpl
+{
+public:
+  FindSelfSimilarityImpl(const std::vector<int64_t>& cells, const float* quats, const int32_t* cellPhases, const uint32_t* crystalStructures, const LaueOpsContainer& orientationOps,
+                         float misorientationTolerance, uint8_t* similarState)
+  : m_Cells(cells)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_SimilarState(similarState)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t c = start; c < end; c++)
+    {
+      int64_t neighbor2 = m_Cells[c];
+      uint8_t state = k_NotSimilar;
+      if(m_CellPhases[neighbor2] > 0)
+      {
+        uint32_t phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
+        const float* currentQuatPtr = m_Quats + neighbor2 * 4;
+        QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+        QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+        OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+        if(axisAngle[3] < m_MisorientationTolerance)
+        {
+          state = k_Similar;
+        }
+      }
+      m_SimilarState[neighbor2] = state;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+  static constexpr uint8_t k_Unknown = 0;
+  static constexpr uint8_t k_NotSimilar = 1;
+  static constexpr uint8_t k_Similar = 2;
+  static constexpr uint8_t k_Pending = 3;
+
+private:
+  const std::vector<int64_t>& m_Cells;
+  const float* m_Quats = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const uint32_t* m_CrystalStructures = nullptr;
+  const LaueOpsContainer& m_OrientationOps;
+  float m_MisorientationTolerance = 0.0f;
+  uint8_t* m_SimilarState = nullptr;
+};
+
+/**
+ * @brief The FindBestNeighborImpl class implements a threaded algorithm that picks the neighbor
+ * whose data replaces each low confidence Cell. Each pair of neighbors is scored from the cached
+ * per Cell states, and every Cell only writes its own entry of the best neighbor list.
+ */
+class FindBestNeighborImpl
+{
+public:
+  FindBestNeighborImpl(const std::vector<int64_t>& cells, const int64_t* dims, const int32_t* cellPhases, const uint8_t* similarState, std::vector<int64_t>& bestNeighbor)
+  : m_Cells(cells)
+  , m_Dims(dims)
+  , m_CellPhases(cellPhases)
+  , m_SimilarState(similarState)
+  , m_BestNeighbor(bestNeighbor)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    const int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    int32_t neighborSimCount[6] = {0, 0, 0, 0, 0, 0};
+    for(size_t c = start; c < end; c++)
+    {
+      int64_t i = m_Cells[c];
+      int64_t column = i % m_Dims[0];
+      int64_t row = (i / m_Dims[0]) % m_Dims[1];
+      int64_t plane = i / (m_Dims[0] * m_Dims[1]);
+      const bool inBounds[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+      for(size_t j = 0; j < 6; j++)
+      {
+        if(!inBounds[j])
+        {
+          continue;
+        }
+        int64_t neighbor = i + neighpoints[j];
+        for(size_t k = j + 1; k < 6; k++)
+        {
+          int64_t neighbor2 = i + neighpoints[k];
+          if(inBounds[k] && m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_SimilarState[neighbor2] == FindSelfSimilarityImpl::k_Similar)
+          {
+            neighborSimCount[j]++;
+            neighborSimCount[k]++;
+          }
+        }
+      }
+      for(size_t j = 0; j < 6; j++)
+      {
+        if(inBounds[j] && neighborSimCount[j] > 0)
+        {
+          m_BestNeighbor[i] = i + neighpoints[j];
+        }
+        neighborSimCount[j] = 0;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const std::vector<int64_t>& m_Cells;
+  const int64_t* m_Dims = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const uint8_t* m_SimilarState = nullptr;
+  std::vector<int64_t>& m_BestNeighbor;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -246,14 +383,6 @@ void NeighborOrientationCorrelation::execute()
       static_cast<int64_t>(udims[2]),
   };
 
-  size_t count = 1;
-  int32_t best = 0;
-  bool good = true;
-  bool good2 = true;
-  int64_t neighbor = 0;
-  int64_t neighbor2 = 0;
-  int64_t column = 0, row = 0, plane = 0;
-
   int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
   neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
   neighpoints[1] = static_cast<int64_t>(-dims[0]);
@@ -262,14 +391,25 @@ void NeighborOrientationCorrelation::execute()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
-  uint32_t phase1 = 0, phase2 = 0;
-
-  std::vector<int32_t> neighborDiffCount(totalPoints, 0);
-  std::vector<int32_t> neighborSimCount(6, 0);
   std::vector<int64_t> bestNeighbor(totalPoints, -1);
+  std::vector<uint8_t> similarState(totalPoints, FindSelfSimilarityImpl::k_Unknown);
   const int32_t startLevel = 6;
-  float* currentQuatPtr = nullptr;
 
+  // Only Cells that start below the minimum confidence can ever be replaced, and a Cell can only
+  // drop below it again if it was replaced before. The work list therefore starts with the low
+  // confidence Cells and loses every Cell that is neither low confidence nor replaced.
+  std::vector<int64_t> workCells;
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    if(m_ConfidenceIndex[i] < m_MinConfidence)
+    {
+      workCells.push_back(static_cast<int64_t>(i));
+    }
+  }
+
+  std::vector<int64_t> lowCells;
+  std::vector<int64_t> pendingCells;
+  std::vector<int64_t> replacedCells;
   for(int32_t currentLevel = startLevel; currentLevel > m_Level; currentLevel--)
   {
     if(getCancel())
@@ -277,163 +417,54 @@ void NeighborOrientationCorrelation::execute()
       break;
     }
 
-    int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
-    int64_t prog = 1;
-    int64_t progressInt = 0;
-    for(size_t i = 0; i < totalPoints; i++)
+    QString ss = QObject::tr("Level %1 of %2 || Processing Data").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level);
+    notifyStatusMessage(ss);
+
+    lowCells.clear();
+    pendingCells.clear();
+    for(const auto& i : workCells)
     {
-      if(int64_t(i) > prog)
+      if(m_ConfidenceIndex[i] < m_MinConfidence)
       {
-        progressInt = static_cast<int64_t>((static_cast<float>(i) / totalPoints) * 100.0f);
-        QString ss = QObject::tr("Level %1 of %2 || Processing Data %3%").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level).arg(progressInt);
-        notifyStatusMessage(ss);
-        prog = prog + progIncrement;
+        lowCells.push_back(i);
       }
+    }
 
-      if(m_ConfidenceIndex[i] < m_MinConfidence)
+    // Evaluate the orientation test of every neighbor that has no valid cached result yet
+    for(const auto& i : lowCells)
+    {
+      int64_t column = i % dims[0];
+      int64_t row = (i / dims[0]) % dims[1];
+      int64_t plane = i / (dims[0] * dims[1]);
+      const bool inBounds[6] = {plane > 0, row > 0, column > 0, column < dims[0] - 1, row < dims[1] - 1, plane < dims[2] - 1};
+      for(int32_t j = 0; j < 6; j++)
       {
-        count = 0;
-        column = static_cast<int64_t>(i % dims[0]);
-        row = (i / dims[0]) % dims[1];
-        plane = i / (dims[0] * dims[1]);
-        for(size_t j = 0; j < 6; j++)
+        int64_t neighbor = i + neighpoints[j];
+        if(inBounds[j] && similarState[neighbor] == FindSelfSimilarityImpl::k_Unknown)
         {
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good)
-          {
-            phase1 = m_CrystalStructures[m_CellPhases[i]];
-            currentQuatPtr = m_Quats + i * 4;
-            QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-            phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-            currentQuatPtr = m_Quats + neighbor * 4;
-            QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-            OrientationD axisAngle(0.0, 0.0, 0.0, std::numeric_limits<double>::max());
-            if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-            {
-              axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-            }
-            if(axisAngle[3] > misorientationToleranceR)
-            {
-              neighborDiffCount[i]++;
-            }
-            for(size_t k = j + 1; k < 6; k++)
-            {
-              good2 = true;
-              neighbor2 = int64_t(i) + neighpoints[k];
-              if(k == 0 && plane == 0)
-              {
-                good2 = false;
-              }
-              if(k == 5 && plane == (dims[2] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 1 && row == 0)
-              {
-                good2 = false;
-              }
-              if(k == 4 && row == (dims[1] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 2 && column == 0)
-              {
-                good2 = false;
-              }
-              if(k == 3 && column == (dims[0] - 1))
-              {
-                good2 = false;
-              }
-              if(good2)
-              {
-                phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
-                currentQuatPtr = m_Quats + neighbor2 * 4;
-                q1 = QuatF(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-
-                phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                currentQuatPtr = m_Quats + neighbor2 * 4;
-                q2 = QuatF(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-                OrientationD axisAngle(0.0, 0.0, 0.0, std::numeric_limits<double>::max());
-                if(m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
-                {
-                  axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                }
-                if(axisAngle[3] < misorientationToleranceR)
-                {
-                  neighborSimCount[j]++;
-                  neighborSimCount[k]++;
-                }
-              }
-            }
-          }
-        }
-        for(size_t j = 0; j < 6; j++)
-        {
-          best = 0;
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good)
-          {
-            if(neighborSimCount[j] > best)
-            {
-              best = neighborSimCount[j];
-              bestNeighbor[i] = neighbor;
-            }
-            neighborSimCount[j] = 0;
-          }
+          similarState[neighbor] = FindSelfSimilarityImpl::k_Pending;
+          pendingCells.push_back(neighbor);
         }
       }
     }
+    ParallelDataAlgorithm similarityAlg;
+    similarityAlg.setRange(0, pendingCells.size());
+    similarityAlg.execute(FindSelfSimilarityImpl(pendingCells, m_Quats, m_CellPhases, m_CrystalStructures, m_OrientationOps, misorientationToleranceR, similarState.data()));
+
+    ParallelDataAlgorithm bestNeighborAlg;
+    bestNeighborAlg.setRange(0, lowCells.size());
+    bestNeighborAlg.execute(FindBestNeighborImpl(lowCells, dims, m_CellPhases, similarState.data(), bestNeighbor));
+
+    // The work list is sorted, so the replaced Cells are too
+    replacedCells.clear();
+    for(const auto& i : workCells)
+    {
+      if(bestNeighbor[i] != -1)
+      {
+        replacedCells.push_back(i);
+      }
+    }
+
     QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
 
     if(getCancel())
@@ -460,12 +491,12 @@ void NeighborOrientationCorrelation::execute()
     {
       std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
       AttributeMatrix* attrMat = m->getAttributeMatrix(attrMatName).get();
-      m_TotalProgress = voxelArrayNames.size() * totalPoints; // Total number of points to update
+      m_TotalProgress = voxelArrayNames.size() * replacedCells.size(); // Total number of points to update
       // Create and run all the tasks
       for(const auto& arrayName : voxelArrayNames)
       {
         IDataArray::Pointer dataArrayPtr = attrMat->getAttributeArray(arrayName);
-        taskGroup->run(NeighborOrientationCorrelationTransferDataImpl(this, totalPoints, bestNeighbor, dataArrayPtr));
+        taskGroup->run(NeighborOrientationCorrelationTransferDataImpl(this, replacedCells, bestNeighbor, dataArrayPtr));
       }
       // Wait for them to complete.
       taskGroup->wait();
@@ -473,30 +504,34 @@ void NeighborOrientationCorrelation::execute()
     else
 #endif
     {
-      progIncrement = static_cast<int64_t>(totalPoints / 100);
-      prog = 1;
-      progressInt = 0;
-      for(size_t i = 0; i < totalPoints; i++)
+      size_t progIncrement = replacedCells.size() / 100;
+      size_t prog = 1;
+      int64_t progressInt = 0;
+      for(size_t c = 0; c < replacedCells.size(); c++)
       {
-        if(int64_t(i) > prog)
+        if(c > prog)
         {
-          progressInt = static_cast<int64_t>(((float)i / totalPoints) * 100.0f);
+          progressInt = static_cast<int64_t>((static_cast<float>(c) / replacedCells.size()) * 100.0f);
           QString ss = QObject::tr("Level %1 of %2 || Copying Data %3%").arg((startLevel - currentLevel) + 2).arg(startLevel - m_Level).arg(progressInt);
           notifyStatusMessage(ss);
           prog = prog + progIncrement;
         }
-        neighbor = bestNeighbor[i];
-        if(neighbor != -1)
+        int64_t i = replacedCells[c];
+        for(const auto& iter : voxelArrayNames)
         {
-          for(const auto& iter : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(iter);
-            p->copyTuple(neighbor, i);
-          }
+          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(iter);
+          p->copyTuple(bestNeighbor[i], i);
         }
       }
     }
 
+    // The replaced Cells have new data, so their cached results no longer apply
+    for(const auto& i : replacedCells)
+    {
+      similarState[i] = FindSelfSimilarityImpl::k_Unknown;
+    }
+    workCells.erase(std::remove_if(workCells.begin(), workCells.end(), [&](int64_t i) { return m_ConfidenceIndex[i] >= m_MinConfidence && bestNeighbor[i] == -1; }), workCells.end());
+
     currentLevel = currentLevel - 1;
     m_CurrentLevel = currentLevel;
   }
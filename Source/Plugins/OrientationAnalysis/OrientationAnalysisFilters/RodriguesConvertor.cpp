@@ -43,6 +43,7 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/OrientationBatchConverter.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
@@ -68,21 +69,14 @@ public:
 
   void convert(size_t start, size_t end) const
   {
-    for(size_t i = start; i < end; i++)
+    for(size_t i = start; i < end; i += OrientationAnalysis::OrientationBatch::k_BlockSize)
     {
       if(m_Filter->getCancel())
       {
         return;
       }
-      float r0 = m_Input[i * 3];
-      float r1 = m_Input[i * 3 + 1];
-      float r2 = m_Input[i * 3 + 2];
-      float length = sqrtf(r0 * r0 + r1 * r1 + r2 * r2);
-
-      m_Output[i * 4] = r0 / length;
-      m_Output[i * 4 + 1] = r1 / length;
-      m_Output[i * 4 + 2] = r2 / length;
-      m_Output[i * 4 + 3] = length;
+      size_t blockEnd = std::min(i + OrientationAnalysis::OrientationBatch::k_BlockSize, end);
+      OrientationAnalysis::OrientationBatch::RodriguesVectorsToAxisLength(m_Input, m_Output, i, blockEnd);
     }
   }
 
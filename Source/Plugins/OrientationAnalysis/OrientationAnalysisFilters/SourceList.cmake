@@ -41,6 +41,7 @@ set(_PublicFilters
   FindGBPDMetricBased
   FindKernelAvgMisorientations
   FindMisorientations
+  FindNeighborPatternSimilarity
   FindSchmids
   FindSlipTransmissionMetrics
   FindTwinBoundaries
@@ -107,6 +108,11 @@ foreach(f ${_PrivateFilters} )
                         ${${PLUGIN_NAME}_SOURCE_DIR}/Documentation/${_filterGroupName}/${f}.md FALSE)
 endforeach()
 
+#-------------
+# These are files that need to be compiled into DREAM3DLib but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/OrientationBatchConverter.h)
+ADD_SIMPL_SUPPORT_CLASS(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName}/util PatternSimilarityEngine)
+
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
 SIMPL_END_FILTER_GROUP(${OrientationAnalysis_BINARY_DIR} "${_filterGroupName}" "OrientationAnalysis")
@@ -35,6 +35,7 @@
 
 #include "WritePoleFigure.h"
 
+#include <algorithm>
 #include <csetjmp>
 #include <vector>
 
@@ -56,6 +57,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/ColorTable.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdMacros.h"
@@ -76,6 +78,10 @@
 
 #include "hpdf.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_group.h>
+#endif
+
 jmp_buf env;
 
 void error_handler(HPDF_STATUS error_no, HPDF_STATUS detail_no, void* /* user_data */)
@@ -84,6 +90,120 @@ void error_handler(HPDF_STATUS error_no, HPDF_STATUS detail_no, void* /* user_da
   longjmp(env, 1);
 }
 
+namespace
+{
+// Number of Cells handled by one task when partitioning the Euler angles by phase
+constexpr size_t k_PartitionChunkSize = 1ULL << 16;
+} // namespace
+
+/**
+ * @brief The CountPhasesImpl class implements a threaded algorithm that counts how many of the
+ * Cells in each fixed size chunk belong to each phase. These counts give every chunk its own write
+ * offset into the per phase Euler arrays, so the chunks can then be scattered independently.
+ */
+class CountPhasesImpl
+{
+public:
+  CountPhasesImpl(const int32_t* cellPhases, const bool* goodVoxels, size_t numPoints, size_t numPhases, std::vector<size_t>& chunkCounts)
+  : m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_NumPoints(numPoints)
+  , m_NumPhases(numPhases)
+  , m_ChunkCounts(chunkCounts)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      size_t* counts = m_ChunkCounts.data() + chunk * m_NumPhases;
+      size_t last = std::min(m_NumPoints, (chunk + 1) * k_PartitionChunkSize);
+      for(size_t i = chunk * k_PartitionChunkSize; i < last; i++)
+      {
+        int32_t phase = m_CellPhases[i];
+        if(phase > 0 && static_cast<size_t>(phase) < m_NumPhases && (nullptr == m_GoodVoxels || m_GoodVoxels[i]))
+        {
+          counts[phase]++;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const int32_t* m_CellPhases = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  size_t m_NumPoints = 0;
+  size_t m_NumPhases = 0;
+  std::vector<size_t>& m_ChunkCounts;
+};
+
+/**
+ * @brief The ScatterEulersImpl class implements a threaded algorithm that copies the Euler angles of
+ * each chunk into the per phase arrays starting at the offsets found from the chunk counts. The
+ * Cells of a phase keep the order they have in the Cell array.
+ */
+class ScatterEulersImpl
+{
+public:
+  ScatterEulersImpl(const float* cellEulerAngles, const int32_t* cellPhases, const bool* goodVoxels, size_t numPoints, size_t numPhases, const std::vector<size_t>& chunkOffsets,
+                    const std::vector<float*>& phaseEulers)
+  : m_CellEulerAngles(cellEulerAngles)
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_NumPoints(numPoints)
+  , m_NumPhases(numPhases)
+  , m_ChunkOffsets(chunkOffsets)
+  , m_PhaseEulers(phaseEulers)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<size_t> offsets(m_NumPhases, 0);
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      std::copy(m_ChunkOffsets.begin() + chunk * m_NumPhases, m_ChunkOffsets.begin() + (chunk + 1) * m_NumPhases, offsets.begin());
+      size_t last = std::min(m_NumPoints, (chunk + 1) * k_PartitionChunkSize);
+      for(size_t i = chunk * k_PartitionChunkSize; i < last; i++)
+      {
+        int32_t phase = m_CellPhases[i];
+        if(phase > 0 && static_cast<size_t>(phase) < m_NumPhases && (nullptr == m_GoodVoxels || m_GoodVoxels[i]))
+        {
+          float* eu = m_PhaseEulers[phase] + offsets[phase] * 3;
+          eu[0] = m_CellEulerAngles[i * 3];
+          eu[1] = m_CellEulerAngles[i * 3 + 1];
+          eu[2] = m_CellEulerAngles[i * 3 + 2];
+          offsets[phase]++;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const float* m_CellEulerAngles = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  size_t m_NumPoints = 0;
+  size_t m_NumPhases = 0;
+  const std::vector<size_t>& m_ChunkOffsets;
+  const std::vector<float*>& m_PhaseEulers;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -308,6 +428,57 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> makePoleFigures(PoleFigureConfigur
   return ops.generatePoleFigure(config);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> generatePoleFigures(uint32_t crystalStructure, PoleFigureConfiguration_t& config)
+{
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> figures;
+  switch(crystalStructure)
+  {
+  case EbsdLib::CrystalStructure::Cubic_High:
+    figures = makePoleFigures<CubicOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Cubic_Low:
+    figures = makePoleFigures<CubicLowOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Hexagonal_High:
+    figures = makePoleFigures<HexagonalOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Hexagonal_Low:
+    figures = makePoleFigures<HexagonalLowOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Trigonal_High:
+    figures = makePoleFigures<TrigonalOps>(config);
+    //   setWarningCondition(-1010, "Trigonal High Symmetry is not supported for Pole figures. This phase will be omitted from results");
+    break;
+  case EbsdLib::CrystalStructure::Trigonal_Low:
+    figures = makePoleFigures<TrigonalLowOps>(config);
+    //  setWarningCondition(-1010, "Trigonal Low Symmetry is not supported for Pole figures. This phase will be omitted from results");
+    break;
+  case EbsdLib::CrystalStructure::Tetragonal_High:
+    figures = makePoleFigures<TetragonalOps>(config);
+    //  setWarningCondition(-1010, "Tetragonal High Symmetry is not supported for Pole figures. This phase will be omitted from results");
+    break;
+  case EbsdLib::CrystalStructure::Tetragonal_Low:
+    figures = makePoleFigures<TetragonalLowOps>(config);
+    // setWarningCondition(-1010, "Tetragonal Low Symmetry is not supported for Pole figures. This phase will be omitted from results");
+    break;
+  case EbsdLib::CrystalStructure::OrthoRhombic:
+    figures = makePoleFigures<OrthoRhombicOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Monoclinic:
+    figures = makePoleFigures<MonoclinicOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Triclinic:
+    figures = makePoleFigures<TriclinicOps>(config);
+    break;
+  default:
+    break;
+  }
+  return figures;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -628,51 +799,51 @@ void WritePoleFigure::execute()
   // Find how many phases we have by getting the number of Crystal Structures
   size_t numPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
 
-  // Loop over all the voxels gathering the Eulers for a specific phase into an array
+  // Partition the Euler angles by phase in one pass. Every chunk of Cells is counted, the counts
+  // are turned into write offsets and then every chunk scatters its own Cells.
+  const bool* goodVoxels = m_UseGoodVoxels ? m_GoodVoxels : nullptr;
+  size_t numChunks = (numPoints + k_PartitionChunkSize - 1) / k_PartitionChunkSize;
+  std::vector<size_t> chunkOffsets(numChunks * numPhases, 0);
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numChunks);
+    dataAlg.execute(CountPhasesImpl(m_CellPhases, goodVoxels, numPoints, numPhases, chunkOffsets));
+  }
+
+  std::vector<EbsdLib::FloatArrayType::Pointer> subEulers(numPhases);
+  std::vector<float*> phaseEulers(numPhases, nullptr);
   for(size_t phase = 1; phase < numPhases; ++phase)
   {
     size_t count = 0;
-    // First find out how many voxels we are going to have. This is probably faster to loop twice than to
-    // keep allocating memory everytime we find one.
-    for(size_t i = 0; i < numPoints; ++i)
+    for(size_t chunk = 0; chunk < numChunks; chunk++)
     {
-      if(m_CellPhases[i] == phase)
-      {
-        if(!m_UseGoodVoxels || m_GoodVoxels[i])
-        {
-          count++;
-        }
-      }
+      size_t chunkCount = chunkOffsets[chunk * numPhases + phase];
+      chunkOffsets[chunk * numPhases + phase] = count;
+      count += chunkCount;
     }
     std::vector<size_t> eulerCompDim(1, 3);
-    EbsdLib::FloatArrayType::Pointer subEulers = EbsdLib::FloatArrayType::CreateArray(count, eulerCompDim, "Eulers_Per_Phase", true);
-    subEulers->initializeWithValue(std::numeric_limits<float>::signaling_NaN());
-    float* eu = subEulers->getPointer(0);
-
-    // Now loop through the eulers again and this time add them to the subEulers Array
-    count = 0;
-    for(size_t i = 0; i < numPoints; ++i)
-    {
-      if(m_CellPhases[i] == phase)
-      {
-        if(!m_UseGoodVoxels || m_GoodVoxels[i])
-        {
-          eu[count * 3] = m_CellEulerAngles[i * 3];
-          eu[count * 3 + 1] = m_CellEulerAngles[i * 3 + 1];
-          eu[count * 3 + 2] = m_CellEulerAngles[i * 3 + 2];
-          count++;
-        }
-      }
-    }
-    if(subEulers->getNumberOfTuples() == 0)
-    {
-      continue;
-    } // Skip because we have no Pole Figure data
+    subEulers[phase] = EbsdLib::FloatArrayType::CreateArray(count, eulerCompDim, "Eulers_Per_Phase", true);
+    phaseEulers[phase] = subEulers[phase]->getPointer(0);
+  }
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numChunks);
+    dataAlg.execute(ScatterEulersImpl(m_CellEulerAngles, m_CellPhases, goodVoxels, numPoints, numPhases, chunkOffsets, phaseEulers));
+  }
 
-    std::vector<EbsdLib::UInt8ArrayType::Pointer> figures;
+  if(getCancel())
+  {
+    return;
+  }
 
-    PoleFigureConfiguration_t config;
-    config.eulers = subEulers.get();
+  // Generate the pole figures of every phase concurrently. The figures of one phase are independent
+  // of all of the other phases, only the PDF documents are written one after another below.
+  std::vector<PoleFigureConfiguration_t> configs(numPhases);
+  std::vector<std::vector<EbsdLib::UInt8ArrayType::Pointer>> phaseFigures(numPhases);
+  for(size_t phase = 1; phase < numPhases; ++phase)
+  {
+    PoleFigureConfiguration_t& config = configs[phase];
+    config.eulers = subEulers[phase].get();
     config.imageDim = getImageSize();
     config.lambertDim = getLambertSize();
     config.numColors = getNumColors();
@@ -686,55 +857,41 @@ void WritePoleFigure::execute()
     }
 
     config.discreteHeatMap = m_UseDiscreteHeatMap;
+  }
 
-    QString label("Phase_");
-    label.append(QString::number(phase));
-
+  notifyStatusMessage("Generating Pole Figures");
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
+  for(size_t phase = 1; phase < numPhases; ++phase)
+  {
+    if(subEulers[phase]->getNumberOfTuples() == 0)
+    {
+      continue;
+    } // Skip because we have no Pole Figure data
+    uint32_t crystalStructure = m_CrystalStructures[phase];
+    taskGroup->run([&phaseFigures, &configs, phase, crystalStructure] { phaseFigures[phase] = generatePoleFigures(crystalStructure, configs[phase]); });
+  }
+  taskGroup->wait();
+#else
+  for(size_t phase = 1; phase < numPhases; ++phase)
+  {
+    if(subEulers[phase]->getNumberOfTuples() == 0)
+    {
+      continue;
+    } // Skip because we have no Pole Figure data
     QString ss = QObject::tr("Generating Pole Figures for Phase %1").arg(phase);
     notifyStatusMessage(ss);
+    phaseFigures[phase] = generatePoleFigures(m_CrystalStructures[phase], configs[phase]);
+  }
+#endif
 
-    switch(m_CrystalStructures[phase])
-    {
-    case EbsdLib::CrystalStructure::Cubic_High:
-      figures = makePoleFigures<CubicOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Cubic_Low:
-      figures = makePoleFigures<CubicLowOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Hexagonal_High:
-      figures = makePoleFigures<HexagonalOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Hexagonal_Low:
-      figures = makePoleFigures<HexagonalLowOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Trigonal_High:
-      figures = makePoleFigures<TrigonalOps>(config);
-      //   setWarningCondition(-1010, "Trigonal High Symmetry is not supported for Pole figures. This phase will be omitted from results");
-      break;
-    case EbsdLib::CrystalStructure::Trigonal_Low:
-      figures = makePoleFigures<TrigonalLowOps>(config);
-      //  setWarningCondition(-1010, "Trigonal Low Symmetry is not supported for Pole figures. This phase will be omitted from results");
-      break;
-    case EbsdLib::CrystalStructure::Tetragonal_High:
-      figures = makePoleFigures<TetragonalOps>(config);
-      //  setWarningCondition(-1010, "Tetragonal High Symmetry is not supported for Pole figures. This phase will be omitted from results");
-      break;
-    case EbsdLib::CrystalStructure::Tetragonal_Low:
-      figures = makePoleFigures<TetragonalLowOps>(config);
-      // setWarningCondition(-1010, "Tetragonal Low Symmetry is not supported for Pole figures. This phase will be omitted from results");
-      break;
-    case EbsdLib::CrystalStructure::OrthoRhombic:
-      figures = makePoleFigures<OrthoRhombicOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Monoclinic:
-      figures = makePoleFigures<MonoclinicOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Triclinic:
-      figures = makePoleFigures<TriclinicOps>(config);
-      break;
-    default:
-      break;
-    }
+  for(size_t phase = 1; phase < numPhases; ++phase)
+  {
+    std::vector<EbsdLib::UInt8ArrayType::Pointer>& figures = phaseFigures[phase];
+    PoleFigureConfiguration_t& config = configs[phase];
+
+    QString label("Phase_");
+    label.append(QString::number(phase));
 
     if(figures.size() == 3)
     {
@@ -0,0 +1,698 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+
+namespace OrientationAnalysis
+{
+namespace OrientationBatch
+{
+/**
+ * @brief The orientation representations in the order used by the ConvertOrientations choices and by
+ * OrientationConverter::GetOrientationTypes()
+ */
+enum class Representation : int32_t
+{
+  Euler = 0,
+  OrientationMatrix = 1,
+  Quaternion = 2,
+  AxisAngle = 3,
+  Rodrigues = 4,
+  Homochoric = 5,
+  Cubochoric = 6
+};
+
+/**
+ * @brief Number of tuples that are decoded into a block at a time. A block of 9 component doubles stays well
+ * inside the L1 cache, so the intermediate representations of a chained conversion never reach main memory.
+ */
+constexpr size_t k_BlockSize = 256;
+
+constexpr double k_Pi = 3.14159265358979323846;
+constexpr double k_2Pi = 2.0 * k_Pi;
+
+// -----------------------------------------------------------------------------
+inline int32_t ComponentCount(Representation rep)
+{
+  constexpr std::array<int32_t, 7> k_ComponentCounts = {{3, 9, 4, 4, 4, 3, 3}};
+  return k_ComponentCounts[static_cast<size_t>(rep)];
+}
+
+/**
+ * @brief A Block holds up to k_BlockSize orientations with each component stored contiguously, so that
+ * component c of tuple i is at values[c * k_BlockSize + i].
+ */
+using Block = std::array<double, 9 * k_BlockSize>;
+
+/**
+ * @brief A Step converts the first count orientations of one block into another block
+ */
+using Step = void (*)(const Block&, Block&, size_t);
+
+/**
+ * The kernels below follow the conventions of D. Rowenhorst et al., "Consistent representations of and
+ * conversions between 3D rotations", MSMSE 23 (2015) with passive rotations (P = 1), which are the conventions
+ * of OrientationTransformation. Quaternions are stored vector-scalar <x,y,z> w, and the axis-angle and
+ * Rodrigues representations store the unit axis followed by the angle or tan(angle / 2). The loops are free of
+ * calls and data dependent memory access so that the compiler can vectorize them.
+ */
+namespace Kernels
+{
+// -----------------------------------------------------------------------------
+inline double wrapAngle(double angle)
+{
+  angle = std::fmod(angle + k_2Pi, k_2Pi);
+  return angle < 0.0 ? angle + k_2Pi : angle;
+}
+
+// -----------------------------------------------------------------------------
+inline void EulerToMatrix(const Block& in, Block& out, size_t count)
+{
+  const double* phi1 = in.data();
+  const double* Phi = in.data() + k_BlockSize;
+  const double* phi2 = in.data() + 2 * k_BlockSize;
+  double* om = out.data();
+  for(size_t i = 0; i < count; i++)
+  {
+    double c1 = std::cos(phi1[i]);
+    double c2 = std::cos(Phi[i]);
+    double c3 = std::cos(phi2[i]);
+    double s1 = std::sin(phi1[i]);
+    double s2 = std::sin(Phi[i]);
+    double s3 = std::sin(phi2[i]);
+    std::array<double, 9> g = {{c1 * c3 - s1 * s3 * c2, s1 * c3 + c1 * s3 * c2, s3 * s2, -c1 * s3 - s1 * c3 * c2, -s1 * s3 + c1 * c3 * c2, c3 * s2, s1 * s2, -c1 * s2, c2}};
+    for(size_t c = 0; c < 9; c++)
+    {
+      om[c * k_BlockSize + i] = std::fabs(g[c]) < 1.0E-12 ? 0.0 : g[c];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void MatrixToEuler(const Block& in, Block& out, size_t count)
+{
+  const double* om = in.data();
+  double* eu = out.data();
+  for(size_t i = 0; i < count; i++)
+  {
+    double om8 = om[8 * k_BlockSize + i];
+    double phi1 = 0.0;
+    double Phi = 0.0;
+    double phi2 = 0.0;
+    if(1.0 - std::fabs(om8) > 1.0E-12)
+    {
+      double zeta = 1.0 / std::sqrt(1.0 - om8 * om8);
+      phi1 = std::atan2(om[6 * k_BlockSize + i] * zeta, -om[7 * k_BlockSize + i] * zeta);
+      Phi = std::acos(om8);
+      phi2 = std::atan2(om[2 * k_BlockSize + i] * zeta, om[5 * k_BlockSize + i] * zeta);
+    }
+    else
+    {
+      phi1 = std::atan2(om[1 * k_BlockSize + i], om[i]);
+      Phi = om8 > 0.0 ? 0.0 : k_Pi;
+    }
+    eu[i] = wrapAngle(phi1);
+    eu[k_BlockSize + i] = wrapAngle(Phi);
+    eu[2 * k_BlockSize + i] = wrapAngle(phi2);
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void EulerToQuaternion(const Block& in, Block& out, size_t count)
+{
+  const double* phi1 = in.data();
+  const double* Phi = in.data() + k_BlockSize;
+  const double* phi2 = in.data() + 2 * k_BlockSize;
+  double* qx = out.data();
+  double* qy = out.data() + k_BlockSize;
+  double* qz = out.data() + 2 * k_BlockSize;
+  double* qw = out.data() + 3 * k_BlockSize;
+  for(size_t i = 0; i < count; i++)
+  {
+    double cPhi = std::cos(0.5 * Phi[i]);
+    double sPhi = std::sin(0.5 * Phi[i]);
+    double cm = std::cos(0.5 * (phi1[i] - phi2[i]));
+    double sm = std::sin(0.5 * (phi1[i] - phi2[i]));
+    double cp = std::cos(0.5 * (phi1[i] + phi2[i]));
+    double sp = std::sin(0.5 * (phi1[i] + phi2[i]));
+    // Keep the scalar part positive
+    double sign = cPhi * cp < 0.0 ? -1.0 : 1.0;
+    qx[i] = -sign * sPhi * cm;
+    qy[i] = -sign * sPhi * sm;
+    qz[i] = -sign * cPhi * sp;
+    qw[i] = sign * cPhi * cp;
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void QuaternionToEuler(const Block& in, Block& out, size_t count)
+{
+  const double* qx = in.data();
+  const double* qy = in.data() + k_BlockSize;
+  const double* qz = in.data() + 2 * k_BlockSize;
+  const double* qw = in.data() + 3 * k_BlockSize;
+  double* eu = out.data();
+  for(size_t i = 0; i < count; i++)
+  {
+    double q03 = qw[i] * qw[i] + qz[i] * qz[i];
+    double q12 = qx[i] * qx[i] + qy[i] * qy[i];
+    double chi = std::sqrt(q03 * q12);
+    double phi1 = 0.0;
+    double Phi = 0.0;
+    double phi2 = 0.0;
+    if(chi == 0.0 && q12 == 0.0)
+    {
+      phi1 = std::atan2(-2.0 * qw[i] * qz[i], qw[i] * qw[i] - qz[i] * qz[i]);
+    }
+    else if(chi == 0.0)
+    {
+      phi1 = std::atan2(2.0 * qx[i] * qy[i], qx[i] * qx[i] - qy[i] * qy[i]);
+      Phi = k_Pi;
+    }
+    else
+    {
+      phi1 = std::atan2((qx[i] * qz[i] - qw[i] * qy[i]) / chi, (-qw[i] * qx[i] - qy[i] * qz[i]) / chi);
+      Phi = std::atan2(2.0 * chi, q03 - q12);
+      phi2 = std::atan2((qw[i] * qy[i] + qx[i] * qz[i]) / chi, (qy[i] * qz[i] - qw[i] * qx[i]) / chi);
+    }
+    eu[i] = wrapAngle(phi1);
+    eu[k_BlockSize + i] = wrapAngle(Phi);
+    eu[2 * k_BlockSize + i] = wrapAngle(phi2);
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void QuaternionToMatrix(const Block& in, Block& out, size_t count)
+{
+  const double* qx = in.data();
+  const double* qy = in.data() + k_BlockSize;
+  const double* qz = in.data() + 2 * k_BlockSize;
+  const double* qw = in.data() + 3 * k_BlockSize;
+  double* om = out.data();
+  for(size_t i = 0; i < count; i++)
+  {
+    double qq = qw[i] * qw[i] - (qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i]);
+    om[i] = qq + 2.0 * qx[i] * qx[i];
+    om[1 * k_BlockSize + i] = 2.0 * (qx[i] * qy[i] - qw[i] * qz[i]);
+    om[2 * k_BlockSize + i] = 2.0 * (qx[i] * qz[i] + qw[i] * qy[i]);
+    om[3 * k_BlockSize + i] = 2.0 * (qy[i] * qx[i] + qw[i] * qz[i]);
+    om[4 * k_BlockSize + i] = qq + 2.0 * qy[i] * qy[i];
+    om[5 * k_BlockSize + i] = 2.0 * (qy[i] * qz[i] - qw[i] * qx[i]);
+    om[6 * k_BlockSize + i] = 2.0 * (qz[i] * qx[i] - qw[i] * qy[i]);
+    om[7 * k_BlockSize + i] = 2.0 * (qz[i] * qy[i] + qw[i] * qx[i]);
+    om[8 * k_BlockSize + i] = qq + 2.0 * qz[i] * qz[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void MatrixToQuaternion(const Block& in, Block& out, size_t count)
+{
+  const double* om = in.data();
+  double* qx = out.data();
+  double* qy = out.data() + k_BlockSize;
+  double* qz = out.data() + 2 * k_BlockSize;
+  double* qw = out.data() + 3 * k_BlockSize;
+  for(size_t i = 0; i < count; i++)
+  {
+    double om0 = om[i];
+    double om4 = om[4 * k_BlockSize + i];
+    double om8 = om[8 * k_BlockSize + i];
+    // The largest of the four components is found from the diagonal and the other three from the off diagonal
+    // sums, which stays accurate for rotations close to 180 degrees where the scalar part vanishes
+    double t0 = 1.0 + om0 + om4 + om8;
+    double t1 = 1.0 + om0 - om4 - om8;
+    double t2 = 1.0 - om0 + om4 - om8;
+    double t3 = 1.0 - om0 - om4 + om8;
+    double wx = om[7 * k_BlockSize + i] - om[5 * k_BlockSize + i];
+    double wy = om[2 * k_BlockSize + i] - om[6 * k_BlockSize + i];
+    double wz = om[3 * k_BlockSize + i] - om[1 * k_BlockSize + i];
+    double xy = om[1 * k_BlockSize + i] + om[3 * k_BlockSize + i];
+    double xz = om[2 * k_BlockSize + i] + om[6 * k_BlockSize + i];
+    double yz = om[5 * k_BlockSize + i] + om[7 * k_BlockSize + i];
+    double w = 0.0;
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    if(t0 >= t1 && t0 >= t2 && t0 >= t3)
+    {
+      w = 0.5 * std::sqrt(t0);
+      double f = 0.25 / w;
+      x = wx * f;
+      y = wy * f;
+      z = wz * f;
+    }
+    else if(t1 >= t2 && t1 >= t3)
+    {
+      x = 0.5 * std::sqrt(t1);
+      double f = 0.25 / x;
+      w = wx * f;
+      y = xy * f;
+      z = xz * f;
+    }
+    else if(t2 >= t3)
+    {
+      y = 0.5 * std::sqrt(t2);
+      double f = 0.25 / y;
+      w = wy * f;
+      x = xy * f;
+      z = yz * f;
+    }
+    else
+    {
+      z = 0.5 * std::sqrt(t3);
+      double f = 0.25 / z;
+      w = wz * f;
+      x = xz * f;
+      y = yz * f;
+    }
+    if(w < 0.0)
+    {
+      w = -w;
+      x = -x;
+      y = -y;
+      z = -z;
+    }
+    double norm = std::sqrt(w * w + x * x + y * y + z * z);
+    qx[i] = x / norm;
+    qy[i] = y / norm;
+    qz[i] = z / norm;
+    qw[i] = w / norm;
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void QuaternionToAxisAngle(const Block& in, Block& out, size_t count)
+{
+  const double* qx = in.data();
+  const double* qy = in.data() + k_BlockSize;
+  const double* qz = in.data() + 2 * k_BlockSize;
+  const double* qw = in.data() + 3 * k_BlockSize;
+  double* ax = out.data();
+  for(size_t i = 0; i < count; i++)
+  {
+    double length = std::sqrt(qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i]);
+    if(length == 0.0)
+    {
+      ax[i] = 0.0;
+      ax[k_BlockSize + i] = 0.0;
+      ax[2 * k_BlockSize + i] = 1.0;
+      ax[3 * k_BlockSize + i] = 0.0;
+      continue;
+    }
+    // The rotation angle is kept in [0, pi] by flipping the axis for negative scalar parts
+    double s = (qw[i] < 0.0 ? -1.0 : 1.0) / length;
+    ax[i] = qx[i] * s;
+    ax[k_BlockSize + i] = qy[i] * s;
+    ax[2 * k_BlockSize + i] = qz[i] * s;
+    ax[3 * k_BlockSize + i] = 2.0 * std::acos(std::min(std::fabs(qw[i]), 1.0));
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void AxisAngleToQuaternion(const Block& in, Block& out, size_t count)
+{
+  const double* ax = in.data();
+  double* q = out.data();
+  for(size_t i = 0; i < count; i++)
+  {
+    double c = std::cos(0.5 * ax[3 * k_BlockSize + i]);
+    double s = std::sin(0.5 * ax[3 * k_BlockSize + i]);
+    q[i] = ax[i] * s;
+    q[k_BlockSize + i] = ax[k_BlockSize + i] * s;
+    q[2 * k_BlockSize + i] = ax[2 * k_BlockSize + i] * s;
+    q[3 * k_BlockSize + i] = c;
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void AxisAngleToRodrigues(const Block& in, Block& out, size_t count)
+{
+  const double* ax = in.data();
+  double* ro = out.data();
+  for(size_t i = 0; i < count; i++)
+  {
+    double angle = ax[3 * k_BlockSize + i];
+    ro[i] = ax[i];
+    ro[k_BlockSize + i] = ax[k_BlockSize + i];
+    ro[2 * k_BlockSize + i] = ax[2 * k_BlockSize + i];
+    ro[3 * k_BlockSize + i] = std::fabs(angle - k_Pi) < 1.0E-7 ? std::numeric_limits<double>::infinity() : std::tan(0.5 * angle);
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void RodriguesToAxisAngle(const Block& in, Block& out, size_t count)
+{
+  const double* ro = in.data();
+  double* ax = out.data();
+  for(size_t i = 0; i < count; i++)
+  {
+    double t = ro[3 * k_BlockSize + i];
+    double length = std::sqrt(ro[i] * ro[i] + ro[k_BlockSize + i] * ro[k_BlockSize + i] + ro[2 * k_BlockSize + i] * ro[2 * k_BlockSize + i]);
+    if(t == 0.0 || length == 0.0)
+    {
+      ax[i] = 0.0;
+      ax[k_BlockSize + i] = 0.0;
+      ax[2 * k_BlockSize + i] = 1.0;
+      ax[3 * k_BlockSize + i] = 0.0;
+      continue;
+    }
+    ax[i] = ro[i] / length;
+    ax[k_BlockSize + i] = ro[k_BlockSize + i] / length;
+    ax[2 * k_BlockSize + i] = ro[2 * k_BlockSize + i] / length;
+    ax[3 * k_BlockSize + i] = std::isinf(t) ? k_Pi : 2.0 * std::atan(t);
+  }
+}
+
+/**
+ * The homochoric and cubochoric mappings involve series inversions and the Lambert projections, so they are
+ * not written as block kernels. These steps call OrientationTransformation for each tuple in the block.
+ */
+// -----------------------------------------------------------------------------
+inline void AxisAngleToHomochoric(const Block& in, Block& out, size_t count)
+{
+  for(size_t i = 0; i < count; i++)
+  {
+    OrientationD ax(in[i], in[k_BlockSize + i], in[2 * k_BlockSize + i], in[3 * k_BlockSize + i]);
+    OrientationD ho = OrientationTransformation::ax2ho<OrientationD, OrientationD>(ax);
+    out[i] = ho[0];
+    out[k_BlockSize + i] = ho[1];
+    out[2 * k_BlockSize + i] = ho[2];
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void HomochoricToAxisAngle(const Block& in, Block& out, size_t count)
+{
+  for(size_t i = 0; i < count; i++)
+  {
+    OrientationD ho(in[i], in[k_BlockSize + i], in[2 * k_BlockSize + i]);
+    OrientationD ax = OrientationTransformation::ho2ax<OrientationD, OrientationD>(ho);
+    out[i] = ax[0];
+    out[k_BlockSize + i] = ax[1];
+    out[2 * k_BlockSize + i] = ax[2];
+    out[3 * k_BlockSize + i] = ax[3];
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void HomochoricToCubochoric(const Block& in, Block& out, size_t count)
+{
+  for(size_t i = 0; i < count; i++)
+  {
+    OrientationD ho(in[i], in[k_BlockSize + i], in[2 * k_BlockSize + i]);
+    OrientationD cu = OrientationTransformation::ho2cu<OrientationD, OrientationD>(ho);
+    out[i] = cu[0];
+    out[k_BlockSize + i] = cu[1];
+    out[2 * k_BlockSize + i] = cu[2];
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline void CubochoricToHomochoric(const Block& in, Block& out, size_t count)
+{
+  for(size_t i = 0; i < count; i++)
+  {
+    OrientationD cu(in[i], in[k_BlockSize + i], in[2 * k_BlockSize + i]);
+    OrientationD ho = OrientationTransformation::cu2ho<OrientationD, OrientationD>(cu);
+    out[i] = ho[0];
+    out[k_BlockSize + i] = ho[1];
+    out[2 * k_BlockSize + i] = ho[2];
+  }
+}
+} // namespace Kernels
+
+/**
+ * @brief BuildChain Finds the shortest sequence of kernels that converts the input representation into the
+ * output representation. The Euler angles, orientation matrices and quaternions are connected directly, the
+ * axis-angle pairs are reached through the quaternions and the remaining representations through the
+ * axis-angle pairs. An empty chain means the representations are the same.
+ * @param input
+ * @param output
+ * @return
+ */
+inline std::vector<Step> BuildChain(Representation input, Representation output)
+{
+  struct Edge
+  {
+    Representation from;
+    Representation to;
+    Step step;
+  };
+  using R = Representation;
+  const std::array<Edge, 14> edges = {{
+      {R::Euler, R::OrientationMatrix, Kernels::EulerToMatrix},
+      {R::OrientationMatrix, R::Euler, Kernels::MatrixToEuler},
+      {R::Euler, R::Quaternion, Kernels::EulerToQuaternion},
+      {R::Quaternion, R::Euler, Kernels::QuaternionToEuler},
+      {R::Quaternion, R::OrientationMatrix, Kernels::QuaternionToMatrix},
+      {R::OrientationMatrix, R::Quaternion, Kernels::MatrixToQuaternion},
+      {R::Quaternion, R::AxisAngle, Kernels::QuaternionToAxisAngle},
+      {R::AxisAngle, R::Quaternion, Kernels::AxisAngleToQuaternion},
+      {R::AxisAngle, R::Rodrigues, Kernels::AxisAngleToRodrigues},
+      {R::Rodrigues, R::AxisAngle, Kernels::RodriguesToAxisAngle},
+      {R::AxisAngle, R::Homochoric, Kernels::AxisAngleToHomochoric},
+      {R::Homochoric, R::AxisAngle, Kernels::HomochoricToAxisAngle},
+      {R::Homochoric, R::Cubochoric, Kernels::HomochoricToCubochoric},
+      {R::Cubochoric, R::Homochoric, Kernels::CubochoricToHomochoric},
+  }};
+
+  // Breadth first search over the 7 representations
+  std::array<int32_t, 7> previousEdge;
+  previousEdge.fill(-1);
+  std::array<bool, 7> visited = {{false, false, false, false, false, false, false}};
+  std::vector<Representation> queue = {input};
+  visited[static_cast<size_t>(input)] = true;
+  for(size_t head = 0; head < queue.size(); head++)
+  {
+    for(size_t e = 0; e < edges.size(); e++)
+    {
+      size_t to = static_cast<size_t>(edges[e].to);
+      if(edges[e].from == queue[head] && !visited[to])
+      {
+        visited[to] = true;
+        previousEdge[to] = static_cast<int32_t>(e);
+        queue.push_back(edges[e].to);
+      }
+    }
+  }
+
+  std::vector<Step> chain;
+  for(Representation rep = output; rep != input; rep = edges[previousEdge[static_cast<size_t>(rep)]].from)
+  {
+    chain.push_back(edges[previousEdge[static_cast<size_t>(rep)]].step);
+  }
+  std::reverse(chain.begin(), chain.end());
+  return chain;
+}
+
+/**
+ * @brief The ConvertImpl class implements a threaded algorithm that converts orientations one block at a
+ * time, running every kernel of the chain on a block before moving to the next block.
+ */
+template <typename T>
+class ConvertImpl
+{
+public:
+  ConvertImpl(const std::vector<Step>& chain, int32_t inputComponents, int32_t outputComponents, const T* input, T* output, size_t numTuples)
+  : m_Chain(chain)
+  , m_InputComponents(static_cast<size_t>(inputComponents))
+  , m_OutputComponents(static_cast<size_t>(outputComponents))
+  , m_Input(input)
+  , m_Output(output)
+  , m_NumTuples(numTuples)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    Block blockA;
+    Block blockB;
+    for(size_t block = start; block < end; block++)
+    {
+      size_t first = block * k_BlockSize;
+      size_t count = std::min(k_BlockSize, m_NumTuples - first);
+
+      // Scatter the interleaved tuples into the component arrays of the block
+      for(size_t c = 0; c < m_InputComponents; c++)
+      {
+        const T* input = m_Input + first * m_InputComponents + c;
+        double* values = blockA.data() + c * k_BlockSize;
+        for(size_t i = 0; i < count; i++)
+        {
+          values[i] = static_cast<double>(input[i * m_InputComponents]);
+        }
+      }
+
+      Block* current = &blockA;
+      Block* next = &blockB;
+      for(const Step& step : m_Chain)
+      {
+        step(*current, *next, count);
+        std::swap(current, next);
+      }
+
+      for(size_t c = 0; c < m_OutputComponents; c++)
+      {
+        T* output = m_Output + first * m_OutputComponents + c;
+        const double* values = current->data() + c * k_BlockSize;
+        for(size_t i = 0; i < count; i++)
+        {
+          output[i * m_OutputComponents] = static_cast<T>(values[i]);
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const std::vector<Step>& m_Chain;
+  size_t m_InputComponents = 0;
+  size_t m_OutputComponents = 0;
+  const T* m_Input = nullptr;
+  T* m_Output = nullptr;
+  size_t m_NumTuples = 0;
+};
+
+/**
+ * @brief Convert Converts an array of orientations from one representation to another. The tuples are
+ * processed in blocks of k_BlockSize in parallel, and chained conversions such as Euler angles to
+ * Rodrigues vectors pass their intermediate values from kernel to kernel inside the block.
+ * @param input
+ * @param output
+ * @param inputData Interleaved input orientations
+ * @param outputData Interleaved output orientations, which may not overlap the input
+ * @param numTuples
+ */
+template <typename T>
+void Convert(Representation input, Representation output, const T* inputData, T* outputData, size_t numTuples)
+{
+  std::vector<Step> chain = BuildChain(input, output);
+  size_t numBlocks = (numTuples + k_BlockSize - 1) / k_BlockSize;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute(ConvertImpl<T>(chain, ComponentCount(input), ComponentCount(output), inputData, outputData, numTuples));
+}
+
+/**
+ * The kernels below rearrange or rescale the components of orientations without changing the
+ * representation. They work on any range of tuples and are called by the filters from their own threaded
+ * algorithms.
+ */
+// -----------------------------------------------------------------------------
+template <typename T>
+void PermuteQuaternions(const T* input, T* output, const std::array<size_t, 4>& mapping, size_t start, size_t end)
+{
+  for(size_t i = start; i < end; i++)
+  {
+    std::array<T, 4> temp;
+    for(size_t c = 0; c < 4; c++)
+    {
+      temp[mapping[c]] = input[i * 4 + c];
+    }
+    for(size_t c = 0; c < 4; c++)
+    {
+      output[i * 4 + c] = temp[c];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void RodriguesVectorsToAxisLength(const T* input, T* output, size_t start, size_t end)
+{
+  for(size_t i = start; i < end; i++)
+  {
+    T r0 = input[i * 3];
+    T r1 = input[i * 3 + 1];
+    T r2 = input[i * 3 + 2];
+    T length = std::sqrt(r0 * r0 + r1 * r1 + r2 * r2);
+    output[i * 4] = r0 / length;
+    output[i * 4 + 1] = r1 / length;
+    output[i * 4 + 2] = r2 / length;
+    output[i * 4 + 3] = length;
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void ScaleValues(T* data, T factor, size_t start, size_t end)
+{
+  for(size_t i = start; i < end; i++)
+  {
+    data[i] = data[i] * factor;
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void TransposeMatrices(const T* input, T* output, size_t start, size_t end)
+{
+  for(size_t i = start; i < end; i++)
+  {
+    const T* g = input + i * 9;
+    T* gT = output + i * 9;
+    gT[0] = g[0];
+    gT[1] = g[3];
+    gT[2] = g[6];
+    gT[3] = g[1];
+    gT[4] = g[4];
+    gT[5] = g[7];
+    gT[6] = g[2];
+    gT[7] = g[5];
+    gT[8] = g[8];
+  }
+}
+} // namespace OrientationBatch
+} // namespace OrientationAnalysis
@@ -0,0 +1,646 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PatternSimilarityEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The NormalizePatternsImpl class implements a threaded algorithm that normalizes the patterns of a
+ * freshly read scan row.
+ */
+class NormalizePatternsImpl
+{
+public:
+  NormalizePatternsImpl(float* patterns, size_t patternSize, size_t stride)
+  : m_Patterns(patterns)
+  , m_PatternSize(patternSize)
+  , m_Stride(stride)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t x = start; x < end; x++)
+    {
+      PatternSimilarityEngine::NormalizePattern(m_Patterns + x * m_Stride, m_PatternSize, m_Stride);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  float* m_Patterns = nullptr;
+  size_t m_PatternSize = 0;
+  size_t m_Stride = 0;
+};
+
+/**
+ * @brief The ForwardSimilarityImpl class implements a threaded algorithm that computes the NDP between every
+ * pattern of a scan row and its neighbors at the forward kernel offsets. neighborRows holds, for each forward
+ * offset, the patterns of the row the offset lands in or nullptr if that row is outside of the scan.
+ */
+class ForwardSimilarityImpl
+{
+public:
+  ForwardSimilarityImpl(const float* patterns, const std::vector<const float*>& neighborRows, const std::vector<std::array<int32_t, 3>>& offsets, int64_t width, size_t stride,
+                        float* forwardSimilarity)
+  : m_Patterns(patterns)
+  , m_NeighborRows(neighborRows)
+  , m_Offsets(offsets)
+  , m_Width(width)
+  , m_Stride(stride)
+  , m_ForwardSimilarity(forwardSimilarity)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    const size_t numOffsets = m_Offsets.size();
+    for(size_t x = start; x < end; x++)
+    {
+      const float* pattern = m_Patterns + x * m_Stride;
+      float* similarity = m_ForwardSimilarity + x * numOffsets;
+      for(size_t s = 0; s < numOffsets; s++)
+      {
+        int64_t nx = static_cast<int64_t>(x) + m_Offsets[s][0];
+        if(m_NeighborRows[s] == nullptr || nx < 0 || nx >= m_Width)
+        {
+          similarity[s] = 0.0f;
+          continue;
+        }
+        similarity[s] = PatternSimilarityEngine::DotProduct(pattern, m_NeighborRows[s] + nx * m_Stride, m_Stride);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const float* m_Patterns = nullptr;
+  const std::vector<const float*>& m_NeighborRows;
+  const std::vector<std::array<int32_t, 3>>& m_Offsets;
+  int64_t m_Width = 0;
+  size_t m_Stride = 0;
+  float* m_ForwardSimilarity = nullptr;
+};
+
+/**
+ * @brief The CombineSimilarityImpl class implements a threaded algorithm that gathers the forward NDPs of a scan
+ * row and the mirrored NDPs stored by the rows before it into the mean similarity of each point. When averaged
+ * is set it also sums the point's own pattern and the neighbor patterns that reach the minimum similarity into
+ * the NPA pattern of the point.
+ */
+class CombineSimilarityImpl
+{
+public:
+  CombineSimilarityImpl(const float* patterns, const float* forwardSimilarity, const std::vector<const float*>& forwardRows, const std::vector<const float*>& backwardRows,
+                        const std::vector<const float*>& backwardSimilarity, const std::vector<std::array<int32_t, 3>>& offsets, int64_t width, size_t patternSize, size_t stride,
+                        float minimumSimilarity, float* similarity, float* averaged)
+  : m_Patterns(patterns)
+  , m_ForwardSimilarity(forwardSimilarity)
+  , m_ForwardRows(forwardRows)
+  , m_BackwardRows(backwardRows)
+  , m_BackwardSimilarity(backwardSimilarity)
+  , m_Offsets(offsets)
+  , m_Width(width)
+  , m_PatternSize(patternSize)
+  , m_Stride(stride)
+  , m_MinimumSimilarity(minimumSimilarity)
+  , m_Similarity(similarity)
+  , m_Averaged(averaged)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void addPattern(std::vector<float>& sum, const float* pattern) const
+  {
+    for(size_t i = 0; i < m_PatternSize; i++)
+    {
+      sum[i] += pattern[i];
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    const size_t numOffsets = m_Offsets.size();
+    std::vector<float> sum(m_Averaged != nullptr ? m_PatternSize : 0);
+    for(size_t x = start; x < end; x++)
+    {
+      const int64_t ix = static_cast<int64_t>(x);
+      double total = 0.0;
+      size_t count = 0;
+      size_t averagedCount = 1;
+      if(m_Averaged != nullptr)
+      {
+        std::copy(m_Patterns + x * m_Stride, m_Patterns + x * m_Stride + m_PatternSize, sum.begin());
+      }
+
+      for(size_t s = 0; s < numOffsets; s++)
+      {
+        int64_t nx = ix + m_Offsets[s][0];
+        if(m_ForwardRows[s] != nullptr && nx >= 0 && nx < m_Width)
+        {
+          float value = m_ForwardSimilarity[x * numOffsets + s];
+          total += value;
+          count++;
+          if(m_Averaged != nullptr && value >= m_MinimumSimilarity)
+          {
+            addPattern(sum, m_ForwardRows[s] + nx * m_Stride);
+            averagedCount++;
+          }
+        }
+        nx = ix - m_Offsets[s][0];
+        if(m_BackwardRows[s] != nullptr && nx >= 0 && nx < m_Width)
+        {
+          float value = m_BackwardSimilarity[s][nx * numOffsets + s];
+          total += value;
+          count++;
+          if(m_Averaged != nullptr && value >= m_MinimumSimilarity)
+          {
+            addPattern(sum, m_BackwardRows[s] + nx * m_Stride);
+            averagedCount++;
+          }
+        }
+      }
+
+      m_Similarity[x] = count > 0 ? static_cast<float>(total / static_cast<double>(count)) : 0.0f;
+      if(m_Averaged != nullptr)
+      {
+        float* out = m_Averaged + x * m_PatternSize;
+        const float scale = 1.0f / static_cast<float>(averagedCount);
+        for(size_t i = 0; i < m_PatternSize; i++)
+        {
+          out[i] = sum[i] * scale;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const float* m_Patterns = nullptr;
+  const float* m_ForwardSimilarity = nullptr;
+  const std::vector<const float*>& m_ForwardRows;
+  const std::vector<const float*>& m_BackwardRows;
+  const std::vector<const float*>& m_BackwardSimilarity;
+  const std::vector<std::array<int32_t, 3>>& m_Offsets;
+  int64_t m_Width = 0;
+  size_t m_PatternSize = 0;
+  size_t m_Stride = 0;
+  float m_MinimumSimilarity = 0.0f;
+  float* m_Similarity = nullptr;
+  float* m_Averaged = nullptr;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternTileSource::PatternTileSource() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternTileSource::~PatternTileSource() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RawFilePatternSource::RawFilePatternSource(const std::string& filePath, size_t patternSize, DataType dataType, uint64_t headerBytes)
+: m_Stream(filePath, std::ios::in | std::ios::binary)
+, m_PatternSize(patternSize)
+, m_DataType(dataType)
+, m_HeaderBytes(headerBytes)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RawFilePatternSource::~RawFilePatternSource() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t RawFilePatternSource::ElementSize(DataType dataType)
+{
+  switch(dataType)
+  {
+  case DataType::UInt8:
+    return sizeof(uint8_t);
+  case DataType::UInt16:
+    return sizeof(uint16_t);
+  case DataType::Float32:
+    return sizeof(float);
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RawFilePatternSource::isOpen() const
+{
+  return m_Stream.is_open();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t RawFilePatternSource::getPatternSize() const
+{
+  return m_PatternSize;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RawFilePatternSource::readPatterns(size_t firstPattern, size_t count, float* buffer, size_t stride)
+{
+  const size_t elementSize = ElementSize(m_DataType);
+  const size_t patternBytes = m_PatternSize * elementSize;
+  m_ReadBuffer.resize(count * patternBytes);
+
+  m_Stream.clear();
+  m_Stream.seekg(static_cast<std::streamoff>(m_HeaderBytes + static_cast<uint64_t>(firstPattern) * patternBytes));
+  m_Stream.read(m_ReadBuffer.data(), static_cast<std::streamsize>(m_ReadBuffer.size()));
+  if(!m_Stream || static_cast<size_t>(m_Stream.gcount()) != m_ReadBuffer.size())
+  {
+    return false;
+  }
+
+  for(size_t i = 0; i < count; i++)
+  {
+    const char* in = m_ReadBuffer.data() + i * patternBytes;
+    float* out = buffer + i * stride;
+    switch(m_DataType)
+    {
+    case DataType::UInt8:
+      for(size_t j = 0; j < m_PatternSize; j++)
+      {
+        out[j] = static_cast<float>(static_cast<uint8_t>(in[j]));
+      }
+      break;
+    case DataType::UInt16:
+      for(size_t j = 0; j < m_PatternSize; j++)
+      {
+        uint16_t value = 0;
+        std::memcpy(&value, in + j * sizeof(uint16_t), sizeof(uint16_t));
+        out[j] = static_cast<float>(value);
+      }
+      break;
+    case DataType::Float32:
+      std::memcpy(out, in, patternBytes);
+      break;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternSimilarityEngine::PatternSimilarityEngine(PatternTileSource& source, const std::array<size_t, 3>& dims, const std::array<int32_t, 3>& kernelRadius)
+: m_Source(source)
+, m_Dims(dims)
+{
+  for(size_t i = 0; i < 3; i++)
+  {
+    m_KernelRadius[i] = std::max(kernelRadius[i], 0);
+  }
+  m_PatternSize = m_Source.getPatternSize();
+  m_Stride = PaddedPatternSize(m_PatternSize);
+
+  // An offset is forward if it follows the center in memory order, i.e. it is lexicographically positive in (z, y, x)
+  for(int32_t dz = 0; dz <= m_KernelRadius[2]; dz++)
+  {
+    for(int32_t dy = (dz == 0 ? 0 : -m_KernelRadius[1]); dy <= m_KernelRadius[1]; dy++)
+    {
+      for(int32_t dx = (dz == 0 && dy == 0 ? 1 : -m_KernelRadius[0]); dx <= m_KernelRadius[0]; dx++)
+      {
+        m_ForwardOffsets.push_back({{dx, dy, dz}});
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternSimilarityEngine::~PatternSimilarityEngine() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t PatternSimilarityEngine::PaddedPatternSize(size_t patternSize)
+{
+  return (patternSize + k_Lanes - 1) / k_Lanes * k_Lanes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternSimilarityEngine::NormalizePattern(float* pattern, size_t patternSize, size_t stride)
+{
+  double mean = 0.0;
+  for(size_t i = 0; i < patternSize; i++)
+  {
+    mean += pattern[i];
+  }
+  mean = patternSize > 0 ? mean / static_cast<double>(patternSize) : 0.0;
+
+  double norm = 0.0;
+  for(size_t i = 0; i < patternSize; i++)
+  {
+    double value = pattern[i] - mean;
+    norm += value * value;
+  }
+  norm = std::sqrt(norm);
+
+  const double scale = norm > 0.0 ? 1.0 / norm : 0.0;
+  for(size_t i = 0; i < patternSize; i++)
+  {
+    pattern[i] = static_cast<float>((pattern[i] - mean) * scale);
+  }
+  std::fill(pattern + patternSize, pattern + stride, 0.0f);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float PatternSimilarityEngine::DotProduct(const float* a, const float* b, size_t stride)
+{
+  // k_Lanes independent partial sums keep the loop free of a loop carried dependency on a single accumulator,
+  // which lets the compiler keep them in vector registers and issue one fused multiply add per register and step.
+  std::array<float, k_Lanes> partial = {};
+  for(size_t i = 0; i < stride; i += k_Lanes)
+  {
+    for(size_t j = 0; j < k_Lanes; j++)
+    {
+      partial[j] += a[i + j] * b[i + j];
+    }
+  }
+  float sum = 0.0f;
+  for(size_t j = 0; j < k_Lanes; j++)
+  {
+    sum += partial[j];
+  }
+  return sum;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternSimilarityEngine::setMinimumSimilarity(float value)
+{
+  m_MinimumSimilarity = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternSimilarityEngine::setAveragedPatternWriter(const PatternWriter& writer)
+{
+  m_PatternWriter = writer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternSimilarityEngine::setProgressCallback(const ProgressCallback& callback)
+{
+  m_ProgressCallback = callback;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternSimilarityEngine::setCancelCallback(const CancelCallback& callback)
+{
+  m_CancelCallback = callback;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::string PatternSimilarityEngine::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t PatternSimilarityEngine::getPeakResidentRows() const
+{
+  return m_PeakResidentRows;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<std::array<int32_t, 3>> PatternSimilarityEngine::getForwardOffsets() const
+{
+  return m_ForwardOffsets;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t PatternSimilarityEngine::lastDependentRow(size_t row) const
+{
+  size_t z = row / m_Dims[1];
+  size_t y = row % m_Dims[1];
+  z = std::min(z + static_cast<size_t>(m_KernelRadius[2]), m_Dims[2] - 1);
+  y = std::min(y + static_cast<size_t>(m_KernelRadius[1]), m_Dims[1] - 1);
+  return z * m_Dims[1] + y;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PatternSimilarityEngine::loadRow(size_t row)
+{
+  const size_t width = m_Dims[0];
+  std::unique_ptr<PatternRow> patternRow(new PatternRow);
+  patternRow->patterns.resize(width * m_Stride);
+  if(!m_Source.readPatterns(row * width, width, patternRow->patterns.data(), m_Stride))
+  {
+    m_ErrorMessage = "Could not read the patterns of scan points " + std::to_string(row * width) + " to " + std::to_string((row + 1) * width - 1);
+    return false;
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, width);
+  dataAlg.execute(NormalizePatternsImpl(patternRow->patterns.data(), m_PatternSize, m_Stride));
+
+  patternRow->forwardSimilarity.resize(width * m_ForwardOffsets.size());
+  m_Rows[row] = std::move(patternRow);
+  m_ResidentRows.push_back(row);
+  m_PeakResidentRows = std::max(m_PeakResidentRows, m_ResidentRows.size());
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t PatternSimilarityEngine::execute(float* similarity)
+{
+  m_ErrorMessage.clear();
+  m_Rows.clear();
+  m_ResidentRows.clear();
+  m_PeakResidentRows = 0;
+
+  const size_t width = m_Dims[0];
+  const size_t height = m_Dims[1];
+  const size_t depth = m_Dims[2];
+  const size_t numRows = height * depth;
+  if(width == 0 || numRows == 0)
+  {
+    return 0;
+  }
+  m_Rows.resize(numRows);
+
+  const size_t numOffsets = m_ForwardOffsets.size();
+  std::vector<const float*> forwardRows(numOffsets, nullptr);
+  std::vector<const float*> backwardRows(numOffsets, nullptr);
+  std::vector<const float*> backwardSimilarity(numOffsets, nullptr);
+  std::vector<float> averaged(m_PatternWriter ? width * m_PatternSize : 0);
+
+  const int64_t ry = m_KernelRadius[1];
+  const int64_t rz = m_KernelRadius[2];
+
+  for(size_t row = 0; row < numRows; row++)
+  {
+    if(m_CancelCallback && m_CancelCallback())
+    {
+      m_Rows.clear();
+      m_ResidentRows.clear();
+      return k_Canceled;
+    }
+
+    const int64_t z = static_cast<int64_t>(row / height);
+    const int64_t y = static_cast<int64_t>(row % height);
+
+    // Read every row the kernel of this row reaches that is not in memory yet
+    for(int64_t nz = std::max<int64_t>(z - rz, 0); nz <= std::min<int64_t>(z + rz, depth - 1); nz++)
+    {
+      for(int64_t ny = std::max<int64_t>(y - ry, 0); ny <= std::min<int64_t>(y + ry, height - 1); ny++)
+      {
+        size_t neighborRow = static_cast<size_t>(nz) * height + static_cast<size_t>(ny);
+        if(m_Rows[neighborRow] == nullptr && !loadRow(neighborRow))
+        {
+          m_Rows.clear();
+          m_ResidentRows.clear();
+          return k_ReadError;
+        }
+      }
+    }
+
+    for(size_t s = 0; s < numOffsets; s++)
+    {
+      const std::array<int32_t, 3>& offset = m_ForwardOffsets[s];
+      int64_t ny = y + offset[1];
+      int64_t nz = z + offset[2];
+      forwardRows[s] = (ny >= 0 && ny < static_cast<int64_t>(height) && nz < static_cast<int64_t>(depth)) ? m_Rows[nz * height + ny]->patterns.data() : nullptr;
+      ny = y - offset[1];
+      nz = z - offset[2];
+      bool inside = (ny >= 0 && ny < static_cast<int64_t>(height) && nz >= 0);
+      backwardRows[s] = inside ? m_Rows[nz * height + ny]->patterns.data() : nullptr;
+      backwardSimilarity[s] = inside ? m_Rows[nz * height + ny]->forwardSimilarity.data() : nullptr;
+    }
+
+    PatternRow& current = *m_Rows[row];
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, width);
+      dataAlg.execute(ForwardSimilarityImpl(current.patterns.data(), forwardRows, m_ForwardOffsets, static_cast<int64_t>(width), m_Stride, current.forwardSimilarity.data()));
+    }
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, width);
+      dataAlg.execute(CombineSimilarityImpl(current.patterns.data(), current.forwardSimilarity.data(), forwardRows, backwardRows, backwardSimilarity, m_ForwardOffsets, static_cast<int64_t>(width),
+                                            m_PatternSize, m_Stride, m_MinimumSimilarity, similarity + row * width, m_PatternWriter ? averaged.data() : nullptr));
+    }
+
+    if(m_PatternWriter && !m_PatternWriter(row * width, width, m_PatternSize, averaged.data()))
+    {
+      m_ErrorMessage = "Could not write the averaged patterns of scan points " + std::to_string(row * width) + " to " + std::to_string((row + 1) * width - 1);
+      m_Rows.clear();
+      m_ResidentRows.clear();
+      return k_WriteError;
+    }
+
+    // Release the rows that no later row can reach
+    auto released = std::remove_if(m_ResidentRows.begin(), m_ResidentRows.end(), [this, row](size_t residentRow) {
+      if(lastDependentRow(residentRow) > row)
+      {
+        return false;
+      }
+      m_Rows[residentRow].reset();
+      return true;
+    });
+    m_ResidentRows.erase(released, m_ResidentRows.end());
+
+    if(m_ProgressCallback)
+    {
+      m_ProgressCallback(row + 1, numRows);
+    }
+  }
+
+  m_Rows.clear();
+  return 0;
+}
@@ -0,0 +1,286 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
+
+/**
+ * @brief The PatternTileSource class is the interface the PatternSimilarityEngine reads diffraction patterns
+ * through. Patterns are requested one scan row at a time in (mostly) increasing order, so an implementation
+ * only ever has to hold a single row of raw patterns.
+ */
+class OrientationAnalysis_EXPORT PatternTileSource
+{
+public:
+  virtual ~PatternTileSource();
+
+  /**
+   * @brief Returns the number of pixels in a single pattern
+   */
+  virtual size_t getPatternSize() const = 0;
+
+  /**
+   * @brief Converts count patterns starting at firstPattern to float and writes pattern i to buffer + i * stride.
+   * The entries between getPatternSize() and stride are left untouched.
+   * @return false if the patterns could not be read
+   */
+  virtual bool readPatterns(size_t firstPattern, size_t count, float* buffer, size_t stride) = 0;
+
+protected:
+  PatternTileSource();
+
+public:
+  PatternTileSource(const PatternTileSource&) = delete;            // Copy Constructor Not Implemented
+  PatternTileSource(PatternTileSource&&) = delete;                 // Move Constructor Not Implemented
+  PatternTileSource& operator=(const PatternTileSource&) = delete; // Copy Assignment Not Implemented
+  PatternTileSource& operator=(PatternTileSource&&) = delete;      // Move Assignment Not Implemented
+};
+
+/**
+ * @brief The ArrayPatternSource class serves patterns that are already in memory, such as the PatternData
+ * array created by ImportH5OimData.
+ */
+template <typename T>
+class ArrayPatternSource : public PatternTileSource
+{
+public:
+  ArrayPatternSource(const T* data, size_t numPatterns, size_t patternSize)
+  : m_Data(data)
+  , m_NumPatterns(numPatterns)
+  , m_PatternSize(patternSize)
+  {
+  }
+  ~ArrayPatternSource() override = default;
+
+  size_t getPatternSize() const override
+  {
+    return m_PatternSize;
+  }
+
+  bool readPatterns(size_t firstPattern, size_t count, float* buffer, size_t stride) override
+  {
+    if(firstPattern + count > m_NumPatterns)
+    {
+      return false;
+    }
+    for(size_t i = 0; i < count; i++)
+    {
+      const T* pattern = m_Data + (firstPattern + i) * m_PatternSize;
+      float* out = buffer + i * stride;
+      for(size_t j = 0; j < m_PatternSize; j++)
+      {
+        out[j] = static_cast<float>(pattern[j]);
+      }
+    }
+    return true;
+  }
+
+private:
+  const T* m_Data = nullptr;
+  size_t m_NumPatterns = 0;
+  size_t m_PatternSize = 0;
+};
+
+/**
+ * @brief The RawFilePatternSource class reads patterns from a flat binary file of native endian values that are
+ * stored pattern after pattern, scan row after scan row, behind an optional header. Only the scan row that is
+ * requested is read, so the file may be much larger than the available memory.
+ */
+class OrientationAnalysis_EXPORT RawFilePatternSource : public PatternTileSource
+{
+public:
+  enum class DataType : int32_t
+  {
+    UInt8 = 0,
+    UInt16 = 1,
+    Float32 = 2
+  };
+
+  RawFilePatternSource(const std::string& filePath, size_t patternSize, DataType dataType, uint64_t headerBytes);
+  ~RawFilePatternSource() override;
+
+  /**
+   * @brief Returns the size in bytes of a single pattern pixel of the given type
+   */
+  static size_t ElementSize(DataType dataType);
+
+  /**
+   * @brief Returns true if the file could be opened for reading
+   */
+  bool isOpen() const;
+
+  size_t getPatternSize() const override;
+
+  bool readPatterns(size_t firstPattern, size_t count, float* buffer, size_t stride) override;
+
+private:
+  std::ifstream m_Stream;
+  size_t m_PatternSize = 0;
+  DataType m_DataType = DataType::UInt8;
+  uint64_t m_HeaderBytes = 0;
+  std::vector<char> m_ReadBuffer;
+};
+
+/**
+ * @brief The PatternSimilarityEngine class computes the normalized dot product (NDP) between every pattern of an
+ * image scan and the patterns inside a kernel around it. The mean NDP of each scan point is a neighbor pattern
+ * similarity map that serves as an image quality map, and the neighbors whose NDP reaches a minimum similarity
+ * can be averaged into neighbor pattern averaged (NPA) patterns.
+ *
+ * The scan is processed one row of patterns at a time. The kernel is split into the offsets that come after a
+ * point in memory order and the mirrored offsets that come before it. The NDP to each forward offset is computed
+ * once and stored at index (x * numForwardOffsets + offset) of the row that owns the point, and the mirrored
+ * values are read back from the row of the neighbor. Rows are read from the PatternTileSource when they first
+ * enter the kernel of the current row and are released as soon as no later row can reach them, so only about
+ * (2 * kernelRadius[1] + 1) rows (or planes for a 3D kernel) of patterns are held in memory.
+ */
+class OrientationAnalysis_EXPORT PatternSimilarityEngine
+{
+public:
+  /**
+   * @brief Receives the NPA patterns of count consecutive scan points starting at firstPattern
+   * @return false to abort the computation
+   */
+  using PatternWriter = std::function<bool(size_t firstPattern, size_t count, size_t patternSize, const float* patterns)>;
+  using ProgressCallback = std::function<void(size_t rowsCompleted, size_t totalRows)>;
+  using CancelCallback = std::function<bool()>;
+
+  /**
+   * @brief Number of floats processed per step of the dot product. Normalized patterns are zero padded to a
+   * multiple of this, so the dot product has no remainder loop.
+   */
+  static constexpr size_t k_Lanes = 16;
+
+  static constexpr int32_t k_ReadError = -1;
+  static constexpr int32_t k_WriteError = -2;
+  static constexpr int32_t k_Canceled = -3;
+
+  PatternSimilarityEngine(PatternTileSource& source, const std::array<size_t, 3>& dims, const std::array<int32_t, 3>& kernelRadius);
+  ~PatternSimilarityEngine();
+
+  /**
+   * @brief Neighbors with at least this NDP contribute to the NPA patterns. The default is 0.
+   */
+  void setMinimumSimilarity(float value);
+
+  /**
+   * @brief Enables the NPA patterns. The writer is called once per scan row in increasing order.
+   */
+  void setAveragedPatternWriter(const PatternWriter& writer);
+
+  void setProgressCallback(const ProgressCallback& callback);
+
+  void setCancelCallback(const CancelCallback& callback);
+
+  /**
+   * @brief Computes the mean NDP of every scan point into similarity, which must hold dims[0] * dims[1] * dims[2]
+   * values. Points without neighbors get 0.
+   * @return 0 on success or one of the negative error codes above
+   */
+  int32_t execute(float* similarity);
+
+  /**
+   * @brief Returns a description of the last error
+   */
+  std::string getErrorMessage() const;
+
+  /**
+   * @brief Returns the largest number of pattern rows that were held in memory at the same time
+   */
+  size_t getPeakResidentRows() const;
+
+  /**
+   * @brief Returns the kernel offsets {x, y, z} that follow a point in memory order
+   */
+  std::vector<std::array<int32_t, 3>> getForwardOffsets() const;
+
+  /**
+   * @brief Returns patternSize rounded up to a multiple of k_Lanes
+   */
+  static size_t PaddedPatternSize(size_t patternSize);
+
+  /**
+   * @brief Shifts the first patternSize values of pattern to a zero mean, scales them to a unit length and zeroes
+   * the padding up to stride. A constant pattern becomes all zeros.
+   */
+  static void NormalizePattern(float* pattern, size_t patternSize, size_t stride);
+
+  /**
+   * @brief Returns the dot product of two zero padded patterns. stride must be a multiple of k_Lanes.
+   */
+  static float DotProduct(const float* a, const float* b, size_t stride);
+
+protected:
+  struct PatternRow
+  {
+    std::vector<float> patterns;
+    std::vector<float> forwardSimilarity;
+  };
+
+  bool loadRow(size_t row);
+  size_t lastDependentRow(size_t row) const;
+
+private:
+  PatternTileSource& m_Source;
+  std::array<size_t, 3> m_Dims = {{0, 0, 0}};
+  std::array<int32_t, 3> m_KernelRadius = {{1, 1, 0}};
+  float m_MinimumSimilarity = 0.0f;
+  PatternWriter m_PatternWriter;
+  ProgressCallback m_ProgressCallback;
+  CancelCallback m_CancelCallback;
+
+  size_t m_PatternSize = 0;
+  size_t m_Stride = 0;
+  std::vector<std::array<int32_t, 3>> m_ForwardOffsets;
+  std::vector<std::unique_ptr<PatternRow>> m_Rows;
+  std::vector<size_t> m_ResidentRows;
+  size_t m_PeakResidentRows = 0;
+  std::string m_ErrorMessage;
+
+public:
+  PatternSimilarityEngine(const PatternSimilarityEngine&) = delete;            // Copy Constructor Not Implemented
+  PatternSimilarityEngine(PatternSimilarityEngine&&) = delete;                 // Move Constructor Not Implemented
+  PatternSimilarityEngine& operator=(const PatternSimilarityEngine&) = delete; // Copy Assignment Not Implemented
+  PatternSimilarityEngine& operator=(PatternSimilarityEngine&&) = delete;      // Move Assignment Not Implemented
+};
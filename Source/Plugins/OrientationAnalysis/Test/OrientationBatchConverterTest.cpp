@@ -0,0 +1,256 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/OrientationBatchConverter.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+using namespace OrientationAnalysis;
+
+class OrientationBatchConverterTest
+{
+public:
+  OrientationBatchConverterTest() = default;
+  ~OrientationBatchConverterTest() = default;
+  OrientationBatchConverterTest(const OrientationBatchConverterTest&) = delete;            // Copy Constructor
+  OrientationBatchConverterTest(OrientationBatchConverterTest&&) = delete;                 // Move Constructor
+  OrientationBatchConverterTest& operator=(const OrientationBatchConverterTest&) = delete; // Copy Assignment
+  OrientationBatchConverterTest& operator=(OrientationBatchConverterTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<double> createEulers(size_t numTuples)
+  {
+    std::mt19937_64 generator(5489);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<double> eulers(numTuples * 3);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      eulers[i * 3] = distribution(generator) * SIMPLib::Constants::k_2PiD;
+      eulers[i * 3 + 1] = distribution(generator) * SIMPLib::Constants::k_PiD;
+      eulers[i * 3 + 2] = distribution(generator) * SIMPLib::Constants::k_2PiD;
+    }
+    return eulers;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestEulerToMatrix()
+  {
+    // 1000 tuples spans several blocks and leaves a partial block at the end
+    const size_t numTuples = 1000;
+    std::vector<double> eulers = createEulers(numTuples);
+    std::vector<double> matrices(numTuples * 9);
+    OrientationBatch::Convert<double>(OrientationBatch::Representation::Euler, OrientationBatch::Representation::OrientationMatrix, eulers.data(), matrices.data(), numTuples);
+
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      OrientationD om = OrientationTransformation::eu2om<OrientationD, OrientationD>(OrientationD(eulers.data() + i * 3, 3));
+      for(size_t c = 0; c < 9; c++)
+      {
+        DREAM3D_REQUIRE(std::fabs(om[c] - matrices[i * 9 + c]) < 1.0E-9)
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Converts the Euler angles into the given representation with OrientationTransformation
+  // -----------------------------------------------------------------------------
+  std::vector<double> createInputs(OrientationBatch::Representation rep, const std::vector<double>& eulers, size_t numTuples)
+  {
+    using R = OrientationBatch::Representation;
+    size_t numComponents = static_cast<size_t>(OrientationBatch::ComponentCount(rep));
+    std::vector<double> values(numTuples * numComponents);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      OrientationD eu(eulers[i * 3], eulers[i * 3 + 1], eulers[i * 3 + 2]);
+      OrientationD value = eu;
+      switch(rep)
+      {
+      case R::Euler:
+        break;
+      case R::OrientationMatrix:
+        value = OrientationTransformation::eu2om<OrientationD, OrientationD>(eu);
+        break;
+      case R::Quaternion:
+        value = OrientationTransformation::eu2qu<OrientationD, OrientationD>(eu);
+        break;
+      case R::AxisAngle:
+        value = OrientationTransformation::eu2ax<OrientationD, OrientationD>(eu);
+        break;
+      case R::Rodrigues:
+        value = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+        break;
+      case R::Homochoric:
+        value = OrientationTransformation::eu2ho<OrientationD, OrientationD>(eu);
+        break;
+      case R::Cubochoric:
+        value = OrientationTransformation::eu2cu<OrientationD, OrientationD>(eu);
+        break;
+      }
+      for(size_t c = 0; c < numComponents; c++)
+      {
+        values[i * numComponents + c] = value[c];
+      }
+    }
+    return values;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs every kernel on its own and compares each output component with OrientationTransformation
+  // -----------------------------------------------------------------------------
+  int TestKernels()
+  {
+    using R = OrientationBatch::Representation;
+    using Transform = std::function<OrientationD(const OrientationD&)>;
+    struct KernelCase
+    {
+      R from;
+      R to;
+      Transform reference;
+    };
+    const std::vector<KernelCase> cases = {
+        {R::Euler, R::OrientationMatrix, [](const OrientationD& o) { return OrientationTransformation::eu2om<OrientationD, OrientationD>(o); }},
+        {R::OrientationMatrix, R::Euler, [](const OrientationD& o) { return OrientationTransformation::om2eu<OrientationD, OrientationD>(o); }},
+        {R::Euler, R::Quaternion, [](const OrientationD& o) { return OrientationTransformation::eu2qu<OrientationD, OrientationD>(o); }},
+        {R::Quaternion, R::Euler, [](const OrientationD& o) { return OrientationTransformation::qu2eu<OrientationD, OrientationD>(o); }},
+        {R::Quaternion, R::OrientationMatrix, [](const OrientationD& o) { return OrientationTransformation::qu2om<OrientationD, OrientationD>(o); }},
+        {R::OrientationMatrix, R::Quaternion, [](const OrientationD& o) { return OrientationTransformation::om2qu<OrientationD, OrientationD>(o); }},
+        {R::Quaternion, R::AxisAngle, [](const OrientationD& o) { return OrientationTransformation::qu2ax<OrientationD, OrientationD>(o); }},
+        {R::AxisAngle, R::Quaternion, [](const OrientationD& o) { return OrientationTransformation::ax2qu<OrientationD, OrientationD>(o); }},
+        {R::AxisAngle, R::Rodrigues, [](const OrientationD& o) { return OrientationTransformation::ax2ro<OrientationD, OrientationD>(o); }},
+        {R::Rodrigues, R::AxisAngle, [](const OrientationD& o) { return OrientationTransformation::ro2ax<OrientationD, OrientationD>(o); }},
+        {R::AxisAngle, R::Homochoric, [](const OrientationD& o) { return OrientationTransformation::ax2ho<OrientationD, OrientationD>(o); }},
+        {R::Homochoric, R::AxisAngle, [](const OrientationD& o) { return OrientationTransformation::ho2ax<OrientationD, OrientationD>(o); }},
+        {R::Homochoric, R::Cubochoric, [](const OrientationD& o) { return OrientationTransformation::ho2cu<OrientationD, OrientationD>(o); }},
+        {R::Cubochoric, R::Homochoric, [](const OrientationD& o) { return OrientationTransformation::cu2ho<OrientationD, OrientationD>(o); }},
+    };
+
+    const size_t numTuples = 1000;
+    std::vector<double> eulers = createEulers(numTuples);
+    for(const KernelCase& kernelCase : cases)
+    {
+      size_t inputComponents = static_cast<size_t>(OrientationBatch::ComponentCount(kernelCase.from));
+      size_t outputComponents = static_cast<size_t>(OrientationBatch::ComponentCount(kernelCase.to));
+      std::vector<double> inputs = createInputs(kernelCase.from, eulers, numTuples);
+      std::vector<double> outputs(numTuples * outputComponents);
+      // Neighboring representations are converted by a single kernel
+      OrientationBatch::Convert<double>(kernelCase.from, kernelCase.to, inputs.data(), outputs.data(), numTuples);
+
+      for(size_t i = 0; i < numTuples; i++)
+      {
+        OrientationD expected = kernelCase.reference(OrientationD(inputs.data() + i * inputComponents, inputComponents));
+        for(size_t c = 0; c < outputComponents; c++)
+        {
+          // tan(angle / 2) of the Rodrigues vectors grows without bound, so the tolerance is relative for large values
+          double tolerance = 1.0E-9 * std::max(1.0, std::fabs(expected[c]));
+          DREAM3D_REQUIRE(std::fabs(expected[c] - outputs[i * outputComponents + c]) < tolerance)
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRoundTrips()
+  {
+    const size_t numTuples = 1000;
+    std::vector<double> eulers = createEulers(numTuples);
+    std::vector<double> reference(numTuples * 9);
+    OrientationBatch::Convert<double>(OrientationBatch::Representation::Euler, OrientationBatch::Representation::OrientationMatrix, eulers.data(), reference.data(), numTuples);
+
+    for(int32_t r = 1; r <= static_cast<int32_t>(OrientationBatch::Representation::Cubochoric); r++)
+    {
+      OrientationBatch::Representation rep = static_cast<OrientationBatch::Representation>(r);
+      std::vector<double> converted(numTuples * OrientationBatch::ComponentCount(rep));
+      std::vector<double> matrices(numTuples * 9);
+      OrientationBatch::Convert<double>(OrientationBatch::Representation::Euler, rep, eulers.data(), converted.data(), numTuples);
+      OrientationBatch::Convert<double>(rep, OrientationBatch::Representation::OrientationMatrix, converted.data(), matrices.data(), numTuples);
+
+      for(size_t i = 0; i < numTuples * 9; i++)
+      {
+        // Rodrigues vectors near 180 degree rotations lose precision, so allow a loose tolerance
+        DREAM3D_REQUIRE(std::fabs(reference[i] - matrices[i]) < 1.0E-4)
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFloatCopy()
+  {
+    std::vector<float> quats = {0.0f, 0.0f, 0.0f, 1.0f, 0.5f, 0.5f, 0.5f, 0.5f};
+    std::vector<float> output(quats.size(), -1.0f);
+    OrientationBatch::Convert<float>(OrientationBatch::Representation::Quaternion, OrientationBatch::Representation::Quaternion, quats.data(), output.data(), 2);
+    for(size_t i = 0; i < quats.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(quats[i], output[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  /**
+   * @brief
+   */
+  void operator()()
+  {
+    std::cout << "########### OrientationBatchConverterTest ##############" << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestEulerToMatrix())
+    DREAM3D_REGISTER_TEST(TestKernels())
+    DREAM3D_REGISTER_TEST(TestRoundTrips())
+    DREAM3D_REGISTER_TEST(TestFloatCopy())
+  }
+};
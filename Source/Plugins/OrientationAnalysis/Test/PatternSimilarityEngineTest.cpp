@@ -0,0 +1,331 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/PatternSimilarityEngine.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class PatternSimilarityEngineTest
+{
+public:
+  PatternSimilarityEngineTest() = default;
+  ~PatternSimilarityEngineTest() = default;
+  PatternSimilarityEngineTest(const PatternSimilarityEngineTest&) = delete;            // Copy Constructor
+  PatternSimilarityEngineTest(PatternSimilarityEngineTest&&) = delete;                 // Move Constructor
+  PatternSimilarityEngineTest& operator=(const PatternSimilarityEngineTest&) = delete; // Copy Assignment
+  PatternSimilarityEngineTest& operator=(PatternSimilarityEngineTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::PatternSimilarityEngineTest::RawPatternFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<uint16_t> createPatterns(size_t numPatterns, size_t patternSize)
+  {
+    std::mt19937_64 generator(5489);
+    std::uniform_int_distribution<uint16_t> distribution(0, 4095);
+    std::vector<uint16_t> patterns(numPatterns * patternSize);
+    for(size_t i = 0; i < numPatterns; i++)
+    {
+      // Neighboring points share a smooth background so that the similarities spread over a useful range
+      for(size_t j = 0; j < patternSize; j++)
+      {
+        patterns[i * patternSize + j] = static_cast<uint16_t>((distribution(generator) / 4) + 1000 * (j % 7) + (i % 3) * 200);
+      }
+    }
+    return patterns;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<double> normalize(const uint16_t* pattern, size_t patternSize)
+  {
+    std::vector<double> out(pattern, pattern + patternSize);
+    double mean = 0.0;
+    for(double value : out)
+    {
+      mean += value;
+    }
+    mean /= static_cast<double>(patternSize);
+    double norm = 0.0;
+    for(double& value : out)
+    {
+      value -= mean;
+      norm += value * value;
+    }
+    norm = std::sqrt(norm);
+    for(double& value : out)
+    {
+      value = norm > 0.0 ? value / norm : 0.0;
+    }
+    return out;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Computes the similarity map and the averaged patterns by visiting every neighbor of every point
+  // -----------------------------------------------------------------------------
+  void bruteForce(const std::vector<uint16_t>& patterns, const std::array<size_t, 3>& dims, const std::array<int32_t, 3>& radius, size_t patternSize, float minimumSimilarity,
+                  std::vector<float>& similarity, std::vector<float>& averaged)
+  {
+    const int64_t width = dims[0];
+    const int64_t height = dims[1];
+    const int64_t depth = dims[2];
+    const size_t numPoints = dims[0] * dims[1] * dims[2];
+    std::vector<std::vector<double>> normalized(numPoints);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      normalized[i] = normalize(patterns.data() + i * patternSize, patternSize);
+    }
+    similarity.assign(numPoints, 0.0f);
+    averaged.assign(numPoints * patternSize, 0.0f);
+    for(int64_t z = 0; z < depth; z++)
+    {
+      for(int64_t y = 0; y < height; y++)
+      {
+        for(int64_t x = 0; x < width; x++)
+        {
+          size_t point = (z * height + y) * width + x;
+          std::vector<double> sum = normalized[point];
+          double total = 0.0;
+          size_t count = 0;
+          size_t averagedCount = 1;
+          for(int64_t dz = -radius[2]; dz <= radius[2]; dz++)
+          {
+            for(int64_t dy = -radius[1]; dy <= radius[1]; dy++)
+            {
+              for(int64_t dx = -radius[0]; dx <= radius[0]; dx++)
+              {
+                int64_t nx = x + dx;
+                int64_t ny = y + dy;
+                int64_t nz = z + dz;
+                if((dx == 0 && dy == 0 && dz == 0) || nx < 0 || nx >= width || ny < 0 || ny >= height || nz < 0 || nz >= depth)
+                {
+                  continue;
+                }
+                size_t neighbor = (nz * height + ny) * width + nx;
+                double dot = 0.0;
+                for(size_t j = 0; j < patternSize; j++)
+                {
+                  dot += normalized[point][j] * normalized[neighbor][j];
+                }
+                total += dot;
+                count++;
+                if(dot >= minimumSimilarity)
+                {
+                  for(size_t j = 0; j < patternSize; j++)
+                  {
+                    sum[j] += normalized[neighbor][j];
+                  }
+                  averagedCount++;
+                }
+              }
+            }
+          }
+          similarity[point] = count > 0 ? static_cast<float>(total / count) : 0.0f;
+          for(size_t j = 0; j < patternSize; j++)
+          {
+            averaged[point * patternSize + j] = static_cast<float>(sum[j] / averagedCount);
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDotProduct()
+  {
+    const size_t patternSize = 37;
+    const size_t stride = PatternSimilarityEngine::PaddedPatternSize(patternSize);
+    DREAM3D_REQUIRE_EQUAL(stride, 48)
+
+    std::vector<float> a(stride, 7.0f);
+    std::vector<float> b(stride, 0.0f);
+    for(size_t i = 0; i < patternSize; i++)
+    {
+      a[i] = static_cast<float>(i);
+      b[i] = static_cast<float>(patternSize - i);
+    }
+    PatternSimilarityEngine::NormalizePattern(a.data(), patternSize, stride);
+    PatternSimilarityEngine::NormalizePattern(b.data(), patternSize, stride);
+    DREAM3D_REQUIRE_EQUAL(a[stride - 1], 0.0f)
+    DREAM3D_REQUIRE(std::fabs(PatternSimilarityEngine::DotProduct(a.data(), a.data(), stride) - 1.0f) < 1.0E-5f)
+    DREAM3D_REQUIRE(std::fabs(PatternSimilarityEngine::DotProduct(a.data(), b.data(), stride) + 1.0f) < 1.0E-5f)
+
+    // A constant pattern has no contrast and is not similar to anything
+    std::vector<float> flat(stride, 3.0f);
+    PatternSimilarityEngine::NormalizePattern(flat.data(), patternSize, stride);
+    DREAM3D_REQUIRE_EQUAL(PatternSimilarityEngine::DotProduct(flat.data(), a.data(), stride), 0.0f)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAgainstBruteForce()
+  {
+    const size_t patternSize = 37;
+    const float minimumSimilarity = 0.05f;
+    const std::vector<std::array<size_t, 3>> allDims = {{{9, 6, 1}}, {{7, 5, 4}}, {{1, 3, 2}}};
+    const std::vector<std::array<int32_t, 3>> allRadii = {{{1, 1, 0}}, {{1, 1, 1}}, {{2, 0, 1}}, {{0, 2, 0}}};
+
+    for(const std::array<size_t, 3>& dims : allDims)
+    {
+      const size_t numPoints = dims[0] * dims[1] * dims[2];
+      std::vector<uint16_t> patterns = createPatterns(numPoints, patternSize);
+      for(const std::array<int32_t, 3>& radius : allRadii)
+      {
+        std::vector<float> expectedSimilarity;
+        std::vector<float> expectedAveraged;
+        bruteForce(patterns, dims, radius, patternSize, minimumSimilarity, expectedSimilarity, expectedAveraged);
+
+        ArrayPatternSource<uint16_t> source(patterns.data(), numPoints, patternSize);
+        PatternSimilarityEngine engine(source, dims, radius);
+        engine.setMinimumSimilarity(minimumSimilarity);
+        std::vector<float> averaged(numPoints * patternSize, -10.0f);
+        size_t nextPattern = 0;
+        engine.setAveragedPatternWriter([&](size_t firstPattern, size_t count, size_t size, const float* values) {
+          if(firstPattern != nextPattern || size != patternSize)
+          {
+            return false;
+          }
+          std::copy(values, values + count * size, averaged.begin() + firstPattern * size);
+          nextPattern += count;
+          return true;
+        });
+
+        std::vector<float> similarity(numPoints, -10.0f);
+        int32_t err = engine.execute(similarity.data());
+        DREAM3D_REQUIRE_EQUAL(err, 0)
+        DREAM3D_REQUIRE_EQUAL(nextPattern, numPoints)
+        for(size_t i = 0; i < numPoints; i++)
+        {
+          DREAM3D_REQUIRE(std::fabs(similarity[i] - expectedSimilarity[i]) < 1.0E-5f)
+        }
+        for(size_t i = 0; i < averaged.size(); i++)
+        {
+          DREAM3D_REQUIRE(std::fabs(averaged[i] - expectedAveraged[i]) < 1.0E-5f)
+        }
+
+        // Only the rows inside the kernel reach of the current row may be held in memory
+        size_t rowsPerPlane = dims[1];
+        size_t maxRows = (2 * radius[2] + 1) * rowsPerPlane + 2 * radius[1] + 1;
+        if(radius[2] == 0)
+        {
+          maxRows = 2 * radius[1] + 1;
+        }
+        DREAM3D_REQUIRE(engine.getPeakResidentRows() <= maxRows)
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRawFileSource()
+  {
+    const std::array<size_t, 3> dims = {{8, 5, 1}};
+    const size_t patternSize = 21;
+    const size_t numPoints = dims[0] * dims[1] * dims[2];
+    const uint64_t headerBytes = 13;
+    std::vector<uint16_t> patterns = createPatterns(numPoints, patternSize);
+
+    {
+      std::ofstream out(UnitTest::PatternSimilarityEngineTest::RawPatternFile.toStdString(), std::ios::out | std::ios::binary);
+      std::vector<char> header(headerBytes, 'H');
+      out.write(header.data(), header.size());
+      out.write(reinterpret_cast<const char*>(patterns.data()), patterns.size() * sizeof(uint16_t));
+    }
+
+    std::vector<float> expected(numPoints, 0.0f);
+    {
+      ArrayPatternSource<uint16_t> source(patterns.data(), numPoints, patternSize);
+      PatternSimilarityEngine engine(source, dims, {{1, 1, 0}});
+      DREAM3D_REQUIRE_EQUAL(engine.execute(expected.data()), 0)
+    }
+
+    RawFilePatternSource source(UnitTest::PatternSimilarityEngineTest::RawPatternFile.toStdString(), patternSize, RawFilePatternSource::DataType::UInt16, headerBytes);
+    DREAM3D_REQUIRE(source.isOpen())
+    std::vector<float> similarity(numPoints, 0.0f);
+    PatternSimilarityEngine engine(source, dims, {{1, 1, 0}});
+    DREAM3D_REQUIRE_EQUAL(engine.execute(similarity.data()), 0)
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(similarity[i], expected[i])
+    }
+
+    // A scan that is larger than the file has to fail instead of reading past its end
+    RawFilePatternSource shortSource(UnitTest::PatternSimilarityEngineTest::RawPatternFile.toStdString(), patternSize, RawFilePatternSource::DataType::UInt16, headerBytes);
+    std::vector<float> tooLarge(numPoints * 2, 0.0f);
+    PatternSimilarityEngine tooLargeEngine(shortSource, {{dims[0], dims[1] * 2, 1}}, {{1, 1, 0}});
+    DREAM3D_REQUIRE_EQUAL(tooLargeEngine.execute(tooLarge.data()), PatternSimilarityEngine::k_ReadError)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "########### PatternSimilarityEngineTest ##############" << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestDotProduct())
+    DREAM3D_REGISTER_TEST(TestAgainstBruteForce())
+    DREAM3D_REGISTER_TEST(TestRawFileSource())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
@@ -34,7 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
 
 #include <QtCore/QTextStream>
 
@@ -44,17 +48,270 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec2FilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+namespace
+{
+// Upper bound on the number of histogram keys gathered per pass over a slice pair. Bounds the
+// scratch memory of each worker thread when the slices are large.
+constexpr size_t k_MaxKeysPerPass = 1ULL << 22;
+} // namespace
+
+/**
+ * @brief The MutualInformationShiftsImpl class implements a threaded algorithm that finds the
+ * relative shift between each pair of neighboring slices. The slice pairs are independent of
+ * one another so each one is handled by a single thread. Every unevaluated shift of the current
+ * 7x7 neighborhood is gathered in one pass over the sampled Cells of the slice pair, where each
+ * sample becomes a packed (current, reference) Feature Id key. Sorting the keys of a shift groups
+ * its joint histogram into runs, so the mutual information only visits the nonzero bins, in the
+ * same order and with the same single precision arithmetic as a dense joint histogram would.
+ */
+class MutualInformationShiftsImpl
+{
+public:
+  MutualInformationShiftsImpl(AlignSectionsMutualInformation* filter, const int32_t* miFeatureIds, const int32_t* featureCounts, const int64_t* dims, const int64_t* roi,
+                              std::vector<int64_t>& newXShifts, std::vector<int64_t>& newYShifts)
+  : m_Filter(filter)
+  , m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featureCounts)
+  , m_Dims(dims)
+  , m_Roi(roi)
+  , m_NewXShifts(newXShifts)
+  , m_NewYShifts(newYShifts)
+  {
+  }
+
+  struct Shift
+  {
+    int64_t x;
+    int64_t y;
+    int64_t gridIndex;
+  };
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> validCounts;
+    std::vector<uint32_t> refCounts;
+    std::vector<Shift> candidates;
+    std::vector<float> values;
+    std::unordered_map<int64_t, float> misorients;
+
+    for(size_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t slice = (m_Dims[2] - 1) - static_cast<int64_t>(iter);
+      const int32_t* curSlice = m_MIFeatureIds + slice * m_Dims[0] * m_Dims[1];
+      const int32_t* refSlice = m_MIFeatureIds + (slice + 1) * m_Dims[0] * m_Dims[1];
+      uint64_t featureCount2 = static_cast<uint64_t>(m_FeatureCounts[slice + 1]);
+      refCounts.assign(featureCount2, 0);
+      misorients.clear();
+
+      float mindisorientation = std::numeric_limits<float>::max();
+      int64_t oldxshift = -1;
+      int64_t oldyshift = -1;
+      int64_t newxshift = 0;
+      int64_t newyshift = 0;
+      while(newxshift != oldxshift || newyshift != oldyshift)
+      {
+        oldxshift = newxshift;
+        oldyshift = newyshift;
+        candidates.clear();
+        for(int64_t j = -3; j < 4; j++)
+        {
+          for(int64_t k = -3; k < 4; k++)
+          {
+            int64_t xIndex = k + oldxshift + m_Dims[0] / 2;
+            int64_t yIndex = j + oldyshift + m_Dims[1] / 2;
+            if(yIndex < 0 || llabs(k + oldxshift) >= (m_Dims[0] / 2) || (j + oldyshift) >= (m_Dims[1] / 2))
+            {
+              continue;
+            }
+            int64_t gridIndex = xIndex * m_Dims[1] + yIndex;
+            auto evaluated = misorients.find(gridIndex);
+            if(evaluated == misorients.end() || evaluated->second == 0)
+            {
+              candidates.push_back({k + oldxshift, j + oldyshift, gridIndex});
+            }
+          }
+        }
+        evaluateShifts(curSlice, refSlice, featureCount2, candidates, keys, validCounts, refCounts, values);
+
+        // Visit the results in the same order as the neighborhood was scanned so ties resolve identically
+        for(size_t s = 0; s < candidates.size(); s++)
+        {
+          float disorientation = values[s];
+          misorients[candidates[s].gridIndex] = disorientation;
+          if(disorientation < mindisorientation)
+          {
+            newxshift = candidates[s].x;
+            newyshift = candidates[s].y;
+            mindisorientation = disorientation;
+          }
+        }
+      }
+      m_NewXShifts[iter] = newxshift;
+      m_NewYShifts[iter] = newyshift;
+      m_Filter->updateShiftProgress();
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  AlignSectionsMutualInformation* m_Filter = nullptr;
+  const int32_t* m_MIFeatureIds = nullptr;
+  const int32_t* m_FeatureCounts = nullptr;
+  const int64_t* m_Dims = nullptr;
+  const int64_t* m_Roi = nullptr;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+
+  /**
+   * @brief Returns the number of sample positions start, start + 4, ... that lie below bound
+   */
+  static int64_t samplesBelow(int64_t start, int64_t bound)
+  {
+    return bound <= start ? 0 : (bound - start + 3) / 4;
+  }
+
+  /**
+   * @brief Computes the inverse mutual information of every candidate shift. The candidates are
+   * processed in batches that share one pass over the sampled rows of the slice pair.
+   */
+  void evaluateShifts(const int32_t* curSlice, const int32_t* refSlice, uint64_t featureCount2, const std::vector<Shift>& candidates, std::vector<uint64_t>& keys,
+                      std::vector<uint64_t>& validCounts, std::vector<uint32_t>& refCounts, std::vector<float>& values) const
+  {
+    const int64_t xStart = m_Roi[0];
+    const int64_t yStart = m_Roi[2];
+    const int64_t numCols = samplesBelow(xStart, m_Roi[1] + 1);
+    const int64_t numRows = samplesBelow(yStart, m_Roi[3] + 1);
+    const size_t samplesPerShift = static_cast<size_t>(numCols * numRows);
+    const size_t shiftsPerPass = std::max<size_t>(1, k_MaxKeysPerPass / std::max<size_t>(1, samplesPerShift));
+
+    values.resize(candidates.size());
+    for(size_t first = 0; first < candidates.size(); first += shiftsPerPass)
+    {
+      size_t last = std::min(first + shiftsPerPass, candidates.size());
+      keys.resize((last - first) * samplesPerShift);
+      validCounts.assign(last - first, 0);
+
+      for(int64_t row = 0; row < numRows; row++)
+      {
+        int64_t l = yStart + row * 4;
+        const int32_t* refRow = refSlice + l * m_Dims[0] + xStart;
+        for(size_t s = first; s < last; s++)
+        {
+          uint64_t* out = keys.data() + (s - first) * samplesPerShift + row * numCols;
+          int64_t y = l + candidates[s].y;
+          int64_t dx = candidates[s].x;
+          // Samples shifted off of the current slice land in the (0, 0) bin without adding to the count
+          int64_t colBegin = 0;
+          int64_t colEnd = 0;
+          if(y >= 0 && y < m_Dims[1])
+          {
+            colEnd = std::min(numCols, samplesBelow(xStart, m_Dims[0] - dx));
+            colBegin = std::min(colEnd, samplesBelow(xStart, -dx));
+          }
+          std::fill(out, out + colBegin, 0);
+          if(colEnd > colBegin)
+          {
+            // Feature Ids from form_features_sections() are never negative, so every in-bounds sample is counted
+            const int32_t* curRow = curSlice + y * m_Dims[0] + xStart + dx;
+            for(int64_t c = colBegin; c < colEnd; c++)
+            {
+              out[c] = static_cast<uint64_t>(curRow[c * 4]) * featureCount2 + static_cast<uint64_t>(refRow[c * 4]);
+            }
+            validCounts[s - first] += static_cast<uint64_t>(colEnd - colBegin);
+          }
+          std::fill(out + colEnd, out + numCols, 0);
+        }
+      }
+
+      for(size_t s = first; s < last; s++)
+      {
+        uint64_t* begin = keys.data() + (s - first) * samplesPerShift;
+        uint64_t* end = begin + samplesPerShift;
+        std::sort(begin, end);
+        values[s] = 1.0f / mutualInformation(begin, end, static_cast<float>(validCounts[s - first]), featureCount2, refCounts);
+      }
+    }
+  }
+
+  /**
+   * @brief Computes the mutual information of one shift from its sorted histogram keys
+   */
+  static float mutualInformation(const uint64_t* begin, const uint64_t* end, float count, uint64_t featureCount2, std::vector<uint32_t>& refCounts)
+  {
+    for(const uint64_t* key = begin; key != end; ++key)
+    {
+      refCounts[*key % featureCount2]++;
+    }
+
+    float disorientation = 0.0f;
+    const uint64_t* group = begin;
+    while(group != end)
+    {
+      // All bins of one current Feature Id are contiguous, which gives its marginal count
+      uint64_t curgnum = *group / featureCount2;
+      const uint64_t* groupEnd = group;
+      while(groupEnd != end && *groupEnd / featureCount2 == curgnum)
+      {
+        ++groupEnd;
+      }
+      float mutualinfo1 = static_cast<float>(groupEnd - group) / count;
+
+      const uint64_t* run = group;
+      while(run != groupEnd)
+      {
+        const uint64_t* runEnd = run;
+        while(runEnd != groupEnd && *runEnd == *run)
+        {
+          ++runEnd;
+        }
+        float mutualinfo12 = static_cast<float>(runEnd - run) / count;
+        float mutualinfo2 = static_cast<float>(refCounts[*run % featureCount2]) / count;
+        float value = 0.0f;
+        if(mutualinfo1 > 0 && mutualinfo2 > 0)
+        {
+          value = (mutualinfo12 / (mutualinfo1 * mutualinfo2));
+        }
+        if(value != 0)
+        {
+          disorientation = disorientation + (mutualinfo12 * logf(value));
+        }
+        run = runEnd;
+      }
+      group = groupEnd;
+    }
+
+    for(const uint64_t* key = begin; key != end; ++key)
+    {
+      refCounts[*key % featureCount2] = 0;
+    }
+    return disorientation;
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -91,6 +348,10 @@ void AlignSectionsMutualInformation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance", MisorientationTolerance, FilterParameter::Category::Parameter, AlignSectionsMutualInformation));
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, AlignSectionsMutualInformation, linkedProps));
+  linkedProps = {"RegionOfInterestMin", "RegionOfInterestMax"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Restrict to Region of Interest", UseRegionOfInterest, FilterParameter::Category::Parameter, AlignSectionsMutualInformation, linkedProps));
+  parameters.push_back(SIMPL_NEW_INT_VEC2_FP("Region of Interest Minimum (X, Y)", RegionOfInterestMin, FilterParameter::Category::Parameter, AlignSectionsMutualInformation));
+  parameters.push_back(SIMPL_NEW_INT_VEC2_FP("Region of Interest Maximum (X, Y)", RegionOfInterestMax, FilterParameter::Category::Parameter, AlignSectionsMutualInformation));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -127,6 +388,7 @@ void AlignSectionsMutualInformation::readFilterParameters(AbstractFilterParamete
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
+  setUseRegionOfInterest(reader->readValue("UseRegionOfInterest", getUseRegionOfInterest()));
   reader->closeFilterGroup();
 }
 
@@ -157,6 +419,27 @@ void AlignSectionsMutualInformation::dataCheck()
     return;
   }
 
+  if(m_UseRegionOfInterest)
+  {
+    ImageGeom::Pointer image = getDataContainerArray()->getDataContainer(getDataContainerName())->getGeometryAs<ImageGeom>();
+    SizeVec3Type udims = image->getDimensions();
+    for(size_t i = 0; i < 2; i++)
+    {
+      if(m_RegionOfInterestMin[i] < 0 || m_RegionOfInterestMin[i] > m_RegionOfInterestMax[i] || m_RegionOfInterestMax[i] >= static_cast<int32_t>(udims[i]))
+      {
+        QString ss = QObject::tr("The Region of Interest (%1,%2) to (%3,%4) must have its minimum less than or equal to its maximum and lie inside the Image Geometry with dimensions (%5,%6)")
+                         .arg(m_RegionOfInterestMin[0])
+                         .arg(m_RegionOfInterestMin[1])
+                         .arg(m_RegionOfInterestMax[0])
+                         .arg(m_RegionOfInterestMax[1])
+                         .arg(udims[0])
+                         .arg(udims[1]);
+        setErrorCondition(-3011, ss);
+        return;
+      }
+    }
+  }
+
   m_FeatureCounts = DataArray<int32_t>::CreateArray(0, std::string("m_FeatureCounts"), true);
 
   QVector<DataArrayPath> dataArrayPaths;
@@ -230,180 +513,43 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
+  // Cells of the reference slice that are sampled, as {xMin, xMax, yMin, yMax}
+  int64_t roi[4] = {0, dims[0] - 1, 0, dims[1] - 1};
+  if(m_UseRegionOfInterest)
+  {
+    roi[0] = m_RegionOfInterestMin[0];
+    roi[1] = m_RegionOfInterestMax[0];
+    roi[2] = m_RegionOfInterestMin[1];
+    roi[3] = m_RegionOfInterestMax[1];
+  }
 
   form_features_sections();
 
-  std::vector<std::vector<float>> misorients;
-  misorients.resize(dims[0]);
-  for(int64_t a = 0; a < dims[0]; a++)
+  // Every pair of neighboring slices is aligned independently, then the shifts are accumulated in order
+  std::vector<int64_t> newXShifts(dims[2], 0);
+  std::vector<int64_t> newYShifts(dims[2], 0);
+  m_ShiftsCompleted = 0;
+  m_TotalShifts = static_cast<size_t>(dims[2] - 1);
+  m_ShiftProgress = 0;
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, static_cast<size_t>(dims[2]));
+  dataAlg.execute(MutualInformationShiftsImpl(this, miFeatureIds, featurecounts, dims, roi, newXShifts, newYShifts));
+
+  if(getCancel())
   {
-    misorients[a].assign(dims[1], 0.0f);
+    return;
   }
 
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    float prog = ((float)iter / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newXShifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newYShifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      outFile << slice << "	" << slice + 1 << "	" << newXShifts[iter] << "	" << newYShifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
-    }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
   }
 
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
@@ -414,6 +560,22 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsMutualInformation::updateShiftProgress()
+{
+  std::lock_guard<std::mutex> lock(m_ProgressMutex);
+  m_ShiftsCompleted++;
+  int32_t progressInt = static_cast<int32_t>((static_cast<float>(m_ShiftsCompleted) / static_cast<float>(m_TotalShifts)) * 100.0f);
+  if(progressInt > m_ShiftProgress)
+  {
+    m_ShiftProgress = progressInt;
+    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progressInt);
+    notifyStatusMessage(ss);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -722,6 +884,42 @@ bool AlignSectionsMutualInformation::getUseGoodVoxels() const
   return m_UseGoodVoxels;
 }
 
+// -----------------------------------------------------------------------------
+void AlignSectionsMutualInformation::setUseRegionOfInterest(bool value)
+{
+  m_UseRegionOfInterest = value;
+}
+
+// -----------------------------------------------------------------------------
+bool AlignSectionsMutualInformation::getUseRegionOfInterest() const
+{
+  return m_UseRegionOfInterest;
+}
+
+// -----------------------------------------------------------------------------
+void AlignSectionsMutualInformation::setRegionOfInterestMin(const IntVec2Type& value)
+{
+  m_RegionOfInterestMin = value;
+}
+
+// -----------------------------------------------------------------------------
+IntVec2Type AlignSectionsMutualInformation::getRegionOfInterestMin() const
+{
+  return m_RegionOfInterestMin;
+}
+
+// -----------------------------------------------------------------------------
+void AlignSectionsMutualInformation::setRegionOfInterestMax(const IntVec2Type& value)
+{
+  m_RegionOfInterestMax = value;
+}
+
+// -----------------------------------------------------------------------------
+IntVec2Type AlignSectionsMutualInformation::getRegionOfInterestMax() const
+{
+  return m_RegionOfInterestMax;
+}
+
 // -----------------------------------------------------------------------------
 void AlignSectionsMutualInformation::setQuatsArrayPath(const DataArrayPath& value)
 {
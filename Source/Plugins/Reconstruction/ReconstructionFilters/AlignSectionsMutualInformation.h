@@ -36,8 +36,10 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLArray.hpp"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 
@@ -62,6 +64,9 @@ class Reconstruction_EXPORT AlignSectionsMutualInformation : public AlignSection
   PYB11_FILTER_NEW_MACRO(AlignSectionsMutualInformation)
   PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
   PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+  PYB11_PROPERTY(bool UseRegionOfInterest READ getUseRegionOfInterest WRITE setUseRegionOfInterest)
+  PYB11_PROPERTY(IntVec2Type RegionOfInterestMin READ getRegionOfInterestMin WRITE setRegionOfInterestMin)
+  PYB11_PROPERTY(IntVec2Type RegionOfInterestMax READ getRegionOfInterestMax WRITE setRegionOfInterestMax)
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
@@ -131,6 +136,39 @@ public:
   bool getUseGoodVoxels() const;
   Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+  /**
+   * @brief Setter property for UseRegionOfInterest
+   */
+  void setUseRegionOfInterest(bool value);
+  /**
+   * @brief Getter property for UseRegionOfInterest
+   * @return Value of UseRegionOfInterest
+   */
+  bool getUseRegionOfInterest() const;
+  Q_PROPERTY(bool UseRegionOfInterest READ getUseRegionOfInterest WRITE setUseRegionOfInterest)
+
+  /**
+   * @brief Setter property for RegionOfInterestMin
+   */
+  void setRegionOfInterestMin(const IntVec2Type& value);
+  /**
+   * @brief Getter property for RegionOfInterestMin
+   * @return Value of RegionOfInterestMin
+   */
+  IntVec2Type getRegionOfInterestMin() const;
+  Q_PROPERTY(IntVec2Type RegionOfInterestMin READ getRegionOfInterestMin WRITE setRegionOfInterestMin)
+
+  /**
+   * @brief Setter property for RegionOfInterestMax
+   */
+  void setRegionOfInterestMax(const IntVec2Type& value);
+  /**
+   * @brief Getter property for RegionOfInterestMax
+   * @return Value of RegionOfInterestMax
+   */
+  IntVec2Type getRegionOfInterestMax() const;
+  Q_PROPERTY(IntVec2Type RegionOfInterestMax READ getRegionOfInterestMax WRITE setRegionOfInterestMax)
+
   /**
    * @brief Setter property for QuatsArrayPath
    */
@@ -235,6 +273,11 @@ public:
    */
   void execute() override;
 
+  /**
+   * @brief updateShiftProgress Records that the shift between one more pair of slices has been found
+   */
+  void updateShiftProgress();
+
 protected:
   AlignSectionsMutualInformation();
   /**
@@ -272,6 +315,9 @@ private:
 
   float m_MisorientationTolerance = {};
   bool m_UseGoodVoxels = {};
+  bool m_UseRegionOfInterest = false;
+  IntVec2Type m_RegionOfInterestMin = {0, 0};
+  IntVec2Type m_RegionOfInterestMax = {0, 0};
   DataArrayPath m_QuatsArrayPath = {};
   DataArrayPath m_CellPhasesArrayPath = {};
   DataArrayPath m_GoodVoxelsArrayPath = {};
@@ -281,6 +327,11 @@ private:
   Int32ArrayType::Pointer m_MIFeaturesPtr;
   uint64_t m_RandomSeed;
 
+  std::mutex m_ProgressMutex;
+  size_t m_ShiftsCompleted = 0;
+  size_t m_TotalShifts = 0;
+  int32_t m_ShiftProgress = 0;
+
 public:
   AlignSectionsMutualInformation(const AlignSectionsMutualInformation&) = delete;            // Copy Constructor Not Implemented
   AlignSectionsMutualInformation(AlignSectionsMutualInformation&&) = delete;                 // Move Constructor Not Implemented
@@ -34,6 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "CalculateArrayHistogram.h"
 
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <QtCore/QStringList>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -41,22 +46,26 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
+#include "StatsToolbox/StatsToolboxFilters/util/HistogramEngine.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
 enum createdPathID : RenameDataPath::DataID_t
 {
   AttributeMatrixID21 = 21,
   AttributeMatrixID22 = 22,
+  AttributeMatrixID23 = 23,
 
   DataContainerID = 1
 };
@@ -84,6 +93,13 @@ void CalculateArrayHistogram::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Min & Max Range", UserDefinedRange, FilterParameter::Category::Parameter, CalculateArrayHistogram, linkedProps));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Min Value", MinRange, FilterParameter::Category::Parameter, CalculateArrayHistogram));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Max Value", MaxRange, FilterParameter::Category::Parameter, CalculateArrayHistogram));
+  linkedProps = {"MaskArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Category::Parameter, CalculateArrayHistogram, linkedProps));
+  linkedProps = {"FeatureIdsArrayPath", "CellFeatureAttributeMatrixPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Histogram per Feature", UseFeatureIds, FilterParameter::Category::Parameter, CalculateArrayHistogram, linkedProps));
+  linkedProps = {"Percentiles", "PercentilesAttributeMatrixName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Percentiles", ComputePercentiles, FilterParameter::Category::Parameter, CalculateArrayHistogram, linkedProps));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Percentiles", Percentiles, FilterParameter::Category::Parameter, CalculateArrayHistogram));
   linkedProps.clear();
   linkedProps.push_back("NewDataContainerName");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("New Data Container", NewDataContainer, FilterParameter::Category::Parameter, CalculateArrayHistogram, linkedProps));
@@ -91,9 +107,28 @@ void CalculateArrayHistogram::setupFilterParameters()
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Category::Any);
     parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Attribute Array to Histogram", SelectedArrayPath, FilterParameter::Category::RequiredArray, CalculateArrayHistogram, req));
   }
+  {
+    MultiDataArraySelectionFilterParameter::RequirementType req =
+        MultiDataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Any, IGeometry::Type::Any);
+    parameters.push_back(SIMPL_NEW_MDA_SELECTION_FP("Additional Attribute Arrays to Histogram", AdditionalArrayPaths, FilterParameter::Category::RequiredArray, CalculateArrayHistogram, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Bool, 1, AttributeMatrix::Category::Any);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Mask", MaskArrayPath, FilterParameter::Category::RequiredArray, CalculateArrayHistogram, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Category::Any);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Feature Ids", FeatureIdsArrayPath, FilterParameter::Category::RequiredArray, CalculateArrayHistogram, req));
+  }
+  {
+    AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(AttributeMatrix::Category::Feature);
+    parameters.push_back(SIMPL_NEW_AM_SELECTION_FP("Feature Attribute Matrix", CellFeatureAttributeMatrixPath, FilterParameter::Category::RequiredArray, CalculateArrayHistogram, req));
+  }
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container ", NewDataContainerName, FilterParameter::Category::CreatedArray, CalculateArrayHistogram));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Attribute Matrix", NewAttributeMatrixName, NewDataContainerName, FilterParameter::Category::CreatedArray, CalculateArrayHistogram));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Histogram", NewDataArrayName, NewDataContainerName, NewAttributeMatrixName, FilterParameter::Category::CreatedArray, CalculateArrayHistogram));
+  parameters.push_back(
+      SIMPL_NEW_AM_WITH_LINKED_DC_FP("Percentiles Attribute Matrix", PercentilesAttributeMatrixName, NewDataContainerName, FilterParameter::Category::CreatedArray, CalculateArrayHistogram));
   setFilterParameters(parameters);
 }
 
@@ -104,12 +139,21 @@ void CalculateArrayHistogram::readFilterParameters(AbstractFilterParametersReade
 {
   reader->openFilterGroup(this, index);
   setSelectedArrayPath(reader->readDataArrayPath("SelectedArrayPath", getSelectedArrayPath()));
+  setAdditionalArrayPaths(reader->readDataArrayPathVector("AdditionalArrayPaths", getAdditionalArrayPaths()));
   setNumberOfBins(reader->readValue("NumberOfBins", getNumberOfBins()));
   setNormalize(reader->readValue("Normalize", false));
   setNewAttributeMatrixName(reader->readString("NewAttributeMatrixName", getNewAttributeMatrixName()));
   setNewDataArrayName(reader->readString("NewDataArrayName", getNewDataArrayName()));
   setNewDataContainer(reader->readValue("NewDataContainer", false));
   setNewDataContainerName(reader->readDataArrayPath("NewDataContainerName", getNewDataContainerName()));
+  setUseMask(reader->readValue("UseMask", getUseMask()));
+  setMaskArrayPath(reader->readDataArrayPath("MaskArrayPath", getMaskArrayPath()));
+  setUseFeatureIds(reader->readValue("UseFeatureIds", getUseFeatureIds()));
+  setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
+  setCellFeatureAttributeMatrixPath(reader->readDataArrayPath("CellFeatureAttributeMatrixPath", getCellFeatureAttributeMatrixPath()));
+  setComputePercentiles(reader->readValue("ComputePercentiles", getComputePercentiles()));
+  setPercentiles(reader->readString("Percentiles", getPercentiles()));
+  setPercentilesAttributeMatrixName(reader->readString("PercentilesAttributeMatrixName", getPercentilesAttributeMatrixName()));
   reader->closeFilterGroup();
 }
 
@@ -140,6 +184,30 @@ void CalculateArrayHistogram::initialize()
 {
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CalculateArrayHistogram::parsePercentiles()
+{
+  m_PercentileValues.clear();
+  QStringList tokens = m_Percentiles.split(',');
+  for(const QString& token : tokens)
+  {
+    if(token.trimmed().isEmpty())
+    {
+      continue;
+    }
+    bool ok = false;
+    double value = token.trimmed().toDouble(&ok);
+    if(!ok || value < 0.0 || value > 100.0)
+    {
+      return false;
+    }
+    m_PercentileValues.push_back(value);
+  }
+  return !m_PercentileValues.empty();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -148,6 +216,10 @@ void CalculateArrayHistogram::dataCheck()
   clearErrorCode();
   clearWarningCode();
   DataArrayPath tempPath;
+  m_InDataArrays.clear();
+  m_HistogramArrays.clear();
+  m_FeatureHistogramArrays.clear();
+  m_PercentileArrays.clear();
 
   if(!m_NewDataContainer)
   {
@@ -161,6 +233,13 @@ void CalculateArrayHistogram::dataCheck()
     return;
   }
 
+  if(m_ComputePercentiles && !parsePercentiles())
+  {
+    QString ss = QObject::tr("The percentiles (%1) must be a comma separated list of numbers between 0 and 100").arg(m_Percentiles);
+    setErrorCondition(-11012, ss);
+    return;
+  }
+
   std::vector<size_t> tDims(1, m_NumberOfBins);
   std::vector<size_t> cDims(1, 2);
 
@@ -174,50 +253,126 @@ void CalculateArrayHistogram::dataCheck()
     newArrayName = getNewDataArrayName();
   }
 
-  m_InDataArrayPtr = getDataContainerArray()->getPrereqIDataArrayFromPath(this, getSelectedArrayPath());
-  if(getErrorCode() < 0)
+  std::vector<DataArrayPath> inputPaths = {getSelectedArrayPath()};
+  inputPaths.insert(inputPaths.end(), m_AdditionalArrayPaths.begin(), m_AdditionalArrayPaths.end());
+  for(const DataArrayPath& inputPath : inputPaths)
   {
-    return;
+    IDataArrayWkPtrType inDataArrayPtr = getDataContainerArray()->getPrereqIDataArrayFromPath(this, inputPath);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    if(nullptr != inDataArrayPtr.lock())
+    {
+      int32_t cDims = inDataArrayPtr.lock()->getNumberOfComponents();
+      if(cDims != 1)
+      {
+        QString ss = QObject::tr("Selected array has number of components %1 and is not a scalar array. The path is %2").arg(cDims).arg(inputPath.serialize());
+        setErrorCondition(-11003, ss);
+        return;
+      }
+    }
+    m_InDataArrays.push_back(inDataArrayPtr);
   }
-  if(nullptr != m_InDataArrayPtr.lock())
+  m_InDataArrayPtr = m_InDataArrays[0];
+
+  // The mask and the feature ids must line up with the histogrammed arrays
+  std::vector<DataArrayPath> tuplePaths = inputPaths;
+  if(m_UseMask)
   {
-    int32_t cDims = m_InDataArrayPtr.lock()->getNumberOfComponents();
-    if(cDims != 1)
+    std::vector<size_t> maskDims(1, 1);
+    m_MaskPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<bool>>(this, getMaskArrayPath(), maskDims);
+    if(nullptr != m_MaskPtr.lock())
     {
-      QString ss = QObject::tr("Selected array has number of components %1 and is not a scalar array. The path is %2").arg(cDims).arg(getSelectedArrayPath().serialize());
-      setErrorCondition(-11003, ss);
-      return;
+      m_Mask = m_MaskPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      tuplePaths.push_back(getMaskArrayPath());
     }
   }
+  if(m_UseFeatureIds)
+  {
+    std::vector<size_t> featureIdsDims(1, 1);
+    m_FeatureIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>>(this, getFeatureIdsArrayPath(), featureIdsDims);
+    if(nullptr != m_FeatureIdsPtr.lock())
+    {
+      m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      tuplePaths.push_back(getFeatureIdsArrayPath());
+    }
+  }
+  getDataContainerArray()->validateNumberOfTuples(this, tuplePaths);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
 
+  DataContainer::Pointer dc;
   if(m_NewDataContainer) // create a new data container
   {
-    DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer(this, getNewDataContainerName(), DataContainerID);
+    dc = getDataContainerArray()->createNonPrereqDataContainer(this, getNewDataContainerName(), DataContainerID);
     if(getErrorCode() < 0)
     {
       return;
     }
-    AttributeMatrix::Pointer attrMat = m->createNonPrereqAttributeMatrix(this, getNewAttributeMatrixName(), tDims, AttributeMatrix::Type::Generic, AttributeMatrixID21);
+    AttributeMatrix::Pointer attrMat = dc->createNonPrereqAttributeMatrix(this, getNewAttributeMatrixName(), tDims, AttributeMatrix::Type::Generic, AttributeMatrixID21);
     if(getErrorCode() < 0 || nullptr == attrMat.get())
     {
       return;
     }
-    tempPath.update(getNewDataContainerName().getDataContainerName(), getNewAttributeMatrixName(), newArrayName);
   }
   else // use existing data container
   {
-    DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(m_SelectedArrayPath.getDataContainerName());
+    dc = getDataContainerArray()->getDataContainer(m_SelectedArrayPath.getDataContainerName());
     AttributeMatrix::Pointer attrMat = dc->createNonPrereqAttributeMatrix(this, getNewAttributeMatrixName(), tDims, AttributeMatrix::Type::Generic, AttributeMatrixID22);
     if(getErrorCode() < 0 || nullptr == attrMat.get())
     {
       return;
     }
-    tempPath.update(dc->getName(), getNewAttributeMatrixName(), newArrayName);
   }
 
-  // histogram array
-  m_NewDataArrayPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<double>>(
-      this, tempPath, 0, cDims); /* Assigns the shared_ptr<>(this, tempPath, 0, dims); Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(m_ComputePercentiles)
+  {
+    std::vector<size_t> percentileDims(1, m_PercentileValues.size());
+    AttributeMatrix::Pointer attrMat = dc->createNonPrereqAttributeMatrix(this, getPercentilesAttributeMatrixName(), percentileDims, AttributeMatrix::Type::Generic, AttributeMatrixID23);
+    if(getErrorCode() < 0 || nullptr == attrMat.get())
+    {
+      return;
+    }
+  }
+
+  for(size_t i = 0; i < inputPaths.size(); i++)
+  {
+    // The first array keeps the plain histogram name so existing pipelines find their output
+    QString arrayName = (i == 0) ? newArrayName : newArrayName + "_" + inputPaths[i].getDataArrayName();
+
+    // histogram array
+    tempPath.update(dc->getName(), getNewAttributeMatrixName(), arrayName);
+    m_HistogramArrays.push_back(getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<double>>(this, tempPath, 0, cDims));
+
+    if(m_UseFeatureIds)
+    {
+      std::vector<size_t> binDims(1, m_NumberOfBins);
+      tempPath.update(getCellFeatureAttributeMatrixPath().getDataContainerName(), getCellFeatureAttributeMatrixPath().getAttributeMatrixName(), arrayName);
+      m_FeatureHistogramArrays.push_back(getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>>(this, tempPath, 0, binDims));
+    }
+
+    if(m_ComputePercentiles)
+    {
+      tempPath.update(dc->getName(), getPercentilesAttributeMatrixName(), arrayName);
+      m_PercentileArrays.push_back(getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<double>>(this, tempPath, 0, cDims));
+    }
+
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+  }
+
+  m_NewDataArrayPtr = m_HistogramArrays[0];
   if(nullptr != m_NewDataArrayPtr.lock())
   {
     m_NewDataArray = m_NewDataArrayPtr.lock()->getPointer(0);
@@ -228,16 +383,23 @@ void CalculateArrayHistogram::dataCheck()
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool userRange, double minRange, double maxRange, DoubleArrayType::Pointer newDataArray, int& overflow)
+void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool userRange, double minRange, double maxRange, const bool* mask, const int32_t* featureIds,
+                   Int32ArrayType::Pointer featureHistogram, const std::vector<double>& percentiles, DoubleArrayType::Pointer percentileArray, DoubleArrayType::Pointer newDataArray,
+                   size_t& overflow)
 {
   typename DataArray<T>::Pointer inputDataPtr = std::dynamic_pointer_cast<DataArray<T>>(inDataPtr);
-  overflow = 0;
-  newDataArray->initializeWithZeros(); // we must initialize the histogram array to prepare for incrementing the array elements
   double* newDataArrayPtr = newDataArray->getPointer(0);
 
   T* inputArrayPtr = inputDataPtr->getPointer(0);
   size_t numPoints = inputDataPtr->getNumberOfTuples();
-  int32_t bin = 0;
+
+  // The range of the data places the automatic bins and bounds the quantile sketch
+  HistogramEngine::Range range;
+  if(!userRange || nullptr != percentileArray)
+  {
+    range = HistogramEngine::FindRange(inputArrayPtr, numPoints, mask);
+  }
+
   float min = std::numeric_limits<float>::max();
   float max = -1.0 * std::numeric_limits<float>::max();
   if(userRange)
@@ -245,46 +407,46 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
     min = static_cast<float>(minRange);
     max = static_cast<float>(maxRange);
   }
-  else
+  else if(range.count > 0)
   {
-    for(size_t i = 0; i < numPoints; i++) // min and max in the input array
-    {
-      if(static_cast<float>(inputArrayPtr[i]) > max)
-      {
-        max = static_cast<float>(inputArrayPtr[i]);
-      }
-      if(static_cast<float>(inputArrayPtr[i]) < min)
-      {
-        min = static_cast<float>(inputArrayPtr[i]);
-      }
-    }
+    min = static_cast<float>(range.min);
+    max = static_cast<float>(range.max);
   }
-
   float increment = (max - min) / (numberOfBins);
-  if(numberOfBins == 1) // if one bin, just set the first element to total number of points
+
+  std::unique_ptr<HistogramEngine::QuantileSketch> sketch;
+  if(nullptr != percentileArray)
   {
-    newDataArrayPtr[0] = max;
-    newDataArrayPtr[1] = numPoints;
+    sketch = std::make_unique<HistogramEngine::QuantileSketch>(range.min, range.max, std::is_integral<T>::value);
   }
-  else
+
+  size_t numFeatures = (nullptr != featureHistogram) ? featureHistogram->getNumberOfTuples() : 0;
+  HistogramEngine::Histogram histogram =
+      HistogramEngine::Compute(inputArrayPtr, numPoints, mask, min, increment, numberOfBins, (nullptr != featureHistogram) ? featureIds : nullptr, numFeatures, sketch.get());
+  overflow = histogram.overflow;
+
+  for(int32_t i = 0; i < numberOfBins; i++)
   {
-    for(size_t i = 0; i < numPoints; i++) // sort into bins to create the histogram
+    newDataArrayPtr[i * 2] = min + increment * (i + 1);
+    newDataArrayPtr[i * 2 + 1] = static_cast<double>(histogram.counts[i]);
+  }
+
+  if(nullptr != featureHistogram)
+  {
+    int32_t* featureHistogramPtr = featureHistogram->getPointer(0);
+    for(size_t i = 0; i < histogram.featureCounts.size(); i++)
     {
-      bin = size_t((inputArrayPtr[i] - min) / increment); // find bin for this input array value
-      if((bin >= 0) && (bin < numberOfBins))              // make certain bin is in range
-      {
-        newDataArrayPtr[bin * 2 + 1]++; // increment histogram element corresponding to this input array value
-      }
-      else
-      {
-        overflow++;
-      }
+      featureHistogramPtr[i] = static_cast<int32_t>(histogram.featureCounts[i]);
     }
   }
 
-  for(int32_t i = 0; i < numberOfBins; i++)
+  if(nullptr != percentileArray)
   {
-    newDataArrayPtr[i * 2] = min + increment * (i + 1);
+    for(size_t i = 0; i < percentiles.size(); i++)
+    {
+      percentileArray->setComponent(i, 0, percentiles[i]);
+      percentileArray->setComponent(i, 1, sketch->percentile(percentiles[i]));
+    }
   }
 }
 
@@ -298,13 +460,27 @@ void CalculateArrayHistogram::execute()
   {
     return;
   }
-  int overflow = 0;
-  EXECUTE_FUNCTION_TEMPLATE(this, findHistogram, m_InDataArrayPtr.lock(), m_InDataArrayPtr.lock(), m_NumberOfBins, m_UserDefinedRange, m_MinRange, m_MaxRange, m_NewDataArrayPtr.lock(), overflow)
 
-  if(overflow > 0)
+  for(size_t i = 0; i < m_InDataArrays.size(); i++)
   {
-    QString ss = QString("%1 values were not catagorized into a bin.").arg(overflow);
-    setWarningCondition(-2000, ss);
+    if(getCancel())
+    {
+      return;
+    }
+
+    IDataArray::Pointer inDataPtr = m_InDataArrays[i].lock();
+    Int32ArrayType::Pointer featureHistogram = m_UseFeatureIds ? m_FeatureHistogramArrays[i].lock() : Int32ArrayType::NullPointer();
+    DoubleArrayType::Pointer percentileArray = m_ComputePercentiles ? m_PercentileArrays[i].lock() : DoubleArrayType::NullPointer();
+    const bool* mask = m_UseMask ? m_Mask : nullptr;
+    size_t overflow = 0;
+    EXECUTE_FUNCTION_TEMPLATE(this, findHistogram, inDataPtr, inDataPtr, m_NumberOfBins, m_UserDefinedRange, m_MinRange, m_MaxRange, mask, m_FeatureIds, featureHistogram, m_PercentileValues,
+                              percentileArray, m_HistogramArrays[i].lock(), overflow)
+
+    if(overflow > 0)
+    {
+      QString ss = QString("%1 values of %2 were not catagorized into a bin.").arg(overflow).arg(inDataPtr->getName());
+      setWarningCondition(-2000, ss);
+    }
   }
 }
 
@@ -527,3 +703,111 @@ DataArrayPath CalculateArrayHistogram::getNewDataContainerName() const
 {
   return m_NewDataContainerName;
 }
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setAdditionalArrayPaths(const std::vector<DataArrayPath>& value)
+{
+  m_AdditionalArrayPaths = value;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<DataArrayPath> CalculateArrayHistogram::getAdditionalArrayPaths() const
+{
+  return m_AdditionalArrayPaths;
+}
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setUseMask(bool value)
+{
+  m_UseMask = value;
+}
+
+// -----------------------------------------------------------------------------
+bool CalculateArrayHistogram::getUseMask() const
+{
+  return m_UseMask;
+}
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setMaskArrayPath(const DataArrayPath& value)
+{
+  m_MaskArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath CalculateArrayHistogram::getMaskArrayPath() const
+{
+  return m_MaskArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setUseFeatureIds(bool value)
+{
+  m_UseFeatureIds = value;
+}
+
+// -----------------------------------------------------------------------------
+bool CalculateArrayHistogram::getUseFeatureIds() const
+{
+  return m_UseFeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setFeatureIdsArrayPath(const DataArrayPath& value)
+{
+  m_FeatureIdsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath CalculateArrayHistogram::getFeatureIdsArrayPath() const
+{
+  return m_FeatureIdsArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setCellFeatureAttributeMatrixPath(const DataArrayPath& value)
+{
+  m_CellFeatureAttributeMatrixPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath CalculateArrayHistogram::getCellFeatureAttributeMatrixPath() const
+{
+  return m_CellFeatureAttributeMatrixPath;
+}
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setComputePercentiles(bool value)
+{
+  m_ComputePercentiles = value;
+}
+
+// -----------------------------------------------------------------------------
+bool CalculateArrayHistogram::getComputePercentiles() const
+{
+  return m_ComputePercentiles;
+}
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setPercentiles(const QString& value)
+{
+  m_Percentiles = value;
+}
+
+// -----------------------------------------------------------------------------
+QString CalculateArrayHistogram::getPercentiles() const
+{
+  return m_Percentiles;
+}
+
+// -----------------------------------------------------------------------------
+void CalculateArrayHistogram::setPercentilesAttributeMatrixName(const QString& value)
+{
+  m_PercentilesAttributeMatrixName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString CalculateArrayHistogram::getPercentilesAttributeMatrixName() const
+{
+  return m_PercentilesAttributeMatrixName;
+}
@@ -68,6 +68,15 @@ class StatsToolbox_EXPORT CalculateArrayHistogram : public AbstractFilter
   PYB11_PROPERTY(QString NewDataArrayName READ getNewDataArrayName WRITE setNewDataArrayName)
   PYB11_PROPERTY(bool NewDataContainer READ getNewDataContainer WRITE setNewDataContainer)
   PYB11_PROPERTY(DataArrayPath NewDataContainerName READ getNewDataContainerName WRITE setNewDataContainerName)
+  PYB11_PROPERTY(std::vector<DataArrayPath> AdditionalArrayPaths READ getAdditionalArrayPaths WRITE setAdditionalArrayPaths)
+  PYB11_PROPERTY(bool UseMask READ getUseMask WRITE setUseMask)
+  PYB11_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
+  PYB11_PROPERTY(bool UseFeatureIds READ getUseFeatureIds WRITE setUseFeatureIds)
+  PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
+  PYB11_PROPERTY(DataArrayPath CellFeatureAttributeMatrixPath READ getCellFeatureAttributeMatrixPath WRITE setCellFeatureAttributeMatrixPath)
+  PYB11_PROPERTY(bool ComputePercentiles READ getComputePercentiles WRITE setComputePercentiles)
+  PYB11_PROPERTY(QString Percentiles READ getPercentiles WRITE setPercentiles)
+  PYB11_PROPERTY(QString PercentilesAttributeMatrixName READ getPercentilesAttributeMatrixName WRITE setPercentilesAttributeMatrixName)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -211,6 +220,105 @@ public:
   DataArrayPath getNewDataContainerName() const;
   Q_PROPERTY(DataArrayPath NewDataContainerName READ getNewDataContainerName WRITE setNewDataContainerName)
 
+  /**
+   * @brief Setter property for AdditionalArrayPaths
+   */
+  void setAdditionalArrayPaths(const std::vector<DataArrayPath>& value);
+  /**
+   * @brief Getter property for AdditionalArrayPaths
+   * @return Value of AdditionalArrayPaths
+   */
+  std::vector<DataArrayPath> getAdditionalArrayPaths() const;
+  Q_PROPERTY(DataArrayPathVec AdditionalArrayPaths READ getAdditionalArrayPaths WRITE setAdditionalArrayPaths)
+
+  /**
+   * @brief Setter property for UseMask
+   */
+  void setUseMask(bool value);
+  /**
+   * @brief Getter property for UseMask
+   * @return Value of UseMask
+   */
+  bool getUseMask() const;
+  Q_PROPERTY(bool UseMask READ getUseMask WRITE setUseMask)
+
+  /**
+   * @brief Setter property for MaskArrayPath
+   */
+  void setMaskArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for MaskArrayPath
+   * @return Value of MaskArrayPath
+   */
+  DataArrayPath getMaskArrayPath() const;
+  Q_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
+
+  /**
+   * @brief Setter property for UseFeatureIds
+   */
+  void setUseFeatureIds(bool value);
+  /**
+   * @brief Getter property for UseFeatureIds
+   * @return Value of UseFeatureIds
+   */
+  bool getUseFeatureIds() const;
+  Q_PROPERTY(bool UseFeatureIds READ getUseFeatureIds WRITE setUseFeatureIds)
+
+  /**
+   * @brief Setter property for FeatureIdsArrayPath
+   */
+  void setFeatureIdsArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for FeatureIdsArrayPath
+   * @return Value of FeatureIdsArrayPath
+   */
+  DataArrayPath getFeatureIdsArrayPath() const;
+  Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
+
+  /**
+   * @brief Setter property for CellFeatureAttributeMatrixPath
+   */
+  void setCellFeatureAttributeMatrixPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for CellFeatureAttributeMatrixPath
+   * @return Value of CellFeatureAttributeMatrixPath
+   */
+  DataArrayPath getCellFeatureAttributeMatrixPath() const;
+  Q_PROPERTY(DataArrayPath CellFeatureAttributeMatrixPath READ getCellFeatureAttributeMatrixPath WRITE setCellFeatureAttributeMatrixPath)
+
+  /**
+   * @brief Setter property for ComputePercentiles
+   */
+  void setComputePercentiles(bool value);
+  /**
+   * @brief Getter property for ComputePercentiles
+   * @return Value of ComputePercentiles
+   */
+  bool getComputePercentiles() const;
+  Q_PROPERTY(bool ComputePercentiles READ getComputePercentiles WRITE setComputePercentiles)
+
+  /**
+   * @brief Setter property for Percentiles
+   */
+  void setPercentiles(const QString& value);
+  /**
+   * @brief Getter property for Percentiles
+   * @return Value of Percentiles
+   */
+  QString getPercentiles() const;
+  Q_PROPERTY(QString Percentiles READ getPercentiles WRITE setPercentiles)
+
+  /**
+   * @brief Setter property for PercentilesAttributeMatrixName
+   */
+  void setPercentilesAttributeMatrixName(const QString& value);
+  /**
+   * @brief Getter property for PercentilesAttributeMatrixName
+   * @return Value of PercentilesAttributeMatrixName
+   */
+  QString getPercentilesAttributeMatrixName() const;
+  Q_PROPERTY(QString PercentilesAttributeMatrixName READ getPercentilesAttributeMatrixName WRITE setPercentilesAttributeMatrixName)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -295,6 +403,12 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief parsePercentiles Parses the comma separated list of percentiles into m_PercentileValues
+   * @return Whether every entry is a number in [0, 100]
+   */
+  bool parsePercentiles();
+
 private:
   IDataArrayWkPtrType m_InDataArrayPtr;
   void* m_InDataArray = nullptr;
@@ -312,6 +426,26 @@ private:
   QString m_NewDataArrayName = {SIMPL::CellData::Histogram};
   bool m_NewDataContainer = {false};
   DataArrayPath m_NewDataContainerName = {SIMPL::Defaults::NewDataContainerName, "", ""};
+  std::vector<DataArrayPath> m_AdditionalArrayPaths = {};
+  bool m_UseMask = {false};
+  DataArrayPath m_MaskArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask};
+  bool m_UseFeatureIds = {false};
+  DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
+  DataArrayPath m_CellFeatureAttributeMatrixPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""};
+  bool m_ComputePercentiles = {false};
+  QString m_Percentiles = {"5, 25, 50, 75, 95"};
+  QString m_PercentilesAttributeMatrixName = {"Percentiles"};
+
+  std::weak_ptr<DataArray<bool>> m_MaskPtr;
+  bool* m_Mask = nullptr;
+  std::weak_ptr<DataArray<int32_t>> m_FeatureIdsPtr;
+  int32_t* m_FeatureIds = nullptr;
+
+  std::vector<IDataArrayWkPtrType> m_InDataArrays;
+  std::vector<std::weak_ptr<DataArray<double>>> m_HistogramArrays;
+  std::vector<std::weak_ptr<DataArray<int32_t>>> m_FeatureHistogramArrays;
+  std::vector<std::weak_ptr<DataArray<double>>> m_PercentileArrays;
+  std::vector<double> m_PercentileValues;
 
 public:
   CalculateArrayHistogram(const CalculateArrayHistogram&) = delete;            // Copy Constructor Not Implemented
@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "Generic/GenericFilters/util/CellFeatureReduction.h"
+
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
@@ -157,26 +159,26 @@ void findAverage(IDataArray::Pointer inDataPtr, FloatArrayType::Pointer averageA
   size_t numPoints = inputDataPtr->getNumberOfTuples();
   size_t numFeatures = averageArray->getNumberOfTuples();
 
-  std::vector<float> counts(numFeatures, 0.0f);
+  // Sum and number of cells of each feature in one pass
+  std::vector<double> sums = CellFeatureReduction::Sum<double>(fIds, numPoints, numFeatures, 2, [cPtr](size_t cell, double* featureSums) {
+    featureSums[0] += static_cast<double>(cPtr[cell]);
+    featureSums[1] += 1.0;
+  });
 
-  int32_t feature = 0;
-  float value = 0.0f;
-  for(size_t i = 0; i < numPoints; i++)
+  // Feature 0 keeps the plain sum of its cells
+  if(numFeatures > 0)
   {
-    value = float(cPtr[i]);
-    feature = fIds[i];
-    aPtr[feature] += value;
-    counts[feature] += 1.0f;
+    aPtr[0] = static_cast<float>(sums[0]);
   }
   for(size_t i = 1; i < numFeatures; i++)
   {
-    if(counts[i] == 0)
+    if(sums[2 * i + 1] == 0.0)
     {
       aPtr[i] = 0;
     }
     else
     {
-      aPtr[i] /= counts[i];
+      aPtr[i] = static_cast<float>(sums[2 * i] / sums[2 * i + 1]);
     }
   }
 }
@@ -43,6 +43,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "Generic/GenericFilters/util/CellFeatureReduction.h"
+
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
@@ -151,25 +153,19 @@ void FindBoundaryElementFractions::find_surface_voxel_fractions()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_BoundaryCellFractionsPtr.lock()->getNumberOfTuples();
 
-  FloatArrayType::Pointer m_SurfVoxCounts = FloatArrayType::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_SurfVoxCounts"), true);
-  m_SurfVoxCounts->initializeWithZeros();
-  float* surfvoxcounts = m_SurfVoxCounts->getPointer(0);
-  FloatArrayType::Pointer m_VoxCounts = FloatArrayType::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_VoxCounts"), true);
-  m_VoxCounts->initializeWithZeros();
-  float* voxcounts = m_VoxCounts->getPointer(0);
-
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    voxcounts[gnum]++;
-    if(m_BoundaryCells[j] > 0)
+  // Number of cells and number of boundary cells of each feature in one pass
+  int8_t* boundaryCells = m_BoundaryCells;
+  std::vector<uint64_t> counts = CellFeatureReduction::Sum<uint64_t>(m_FeatureIds, totalPoints, numfeatures, 2, [boundaryCells](size_t cell, uint64_t* featureCounts) {
+    featureCounts[0]++;
+    if(boundaryCells[cell] > 0)
     {
-      surfvoxcounts[gnum]++;
+      featureCounts[1]++;
     }
-  }
+  });
+
   for(size_t i = 1; i < numfeatures; i++)
   {
-    m_BoundaryCellFractions[i] = surfvoxcounts[i] / voxcounts[i];
+    m_BoundaryCellFractions[i] = static_cast<float>(counts[2 * i + 1]) / static_cast<float>(counts[2 * i]);
   }
 }
 
@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindLargestCrossSections.h"
 
+#include <array>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -43,17 +45,21 @@
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
+#include "StatsToolbox/StatsToolboxFilters/util/PlaneCrossSections.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
   DataArrayID30 = 30,
   DataArrayID31 = 31,
+  DataArrayID32 = 32,
+  DataArrayID33 = 33,
 };
 
 // -----------------------------------------------------------------------------
@@ -87,6 +93,10 @@ void FindLargestCrossSections::setupFilterParameters()
     parameter->setCategory(FilterParameter::Category::Parameter);
     parameters.push_back(parameter);
   }
+  std::vector<QString> linkedProps = {"AllCrossSectionsArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute All Planes", ComputeAllPlanes, FilterParameter::Category::Parameter, FindLargestCrossSections, linkedProps));
+  linkedProps = {"PlaneIndicesArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Store Plane Indices", StorePlaneIndices, FilterParameter::Category::Parameter, FindLargestCrossSections, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -96,6 +106,8 @@ void FindLargestCrossSections::setupFilterParameters()
   {
     DataArrayCreationFilterParameter::RequirementType req = DataArrayCreationFilterParameter::CreateRequirement(AttributeMatrix::Type::CellFeature, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Largest Cross Sections", LargestCrossSectionsArrayPath, FilterParameter::Category::CreatedArray, FindLargestCrossSections, req));
+    parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Largest Cross Sections (All Planes)", AllCrossSectionsArrayPath, FilterParameter::Category::CreatedArray, FindLargestCrossSections, req));
+    parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Largest Cross Section Plane Indices", PlaneIndicesArrayPath, FilterParameter::Category::CreatedArray, FindLargestCrossSections, req));
   }
   setFilterParameters(parameters);
 }
@@ -107,6 +119,10 @@ void FindLargestCrossSections::readFilterParameters(AbstractFilterParametersRead
   setLargestCrossSectionsArrayPath(reader->readDataArrayPath("LargestCrossSectionsArrayPath", getLargestCrossSectionsArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
   setPlane(reader->readValue("Plane", getPlane()));
+  setComputeAllPlanes(reader->readValue("ComputeAllPlanes", getComputeAllPlanes()));
+  setAllCrossSectionsArrayPath(reader->readDataArrayPath("AllCrossSectionsArrayPath", getAllCrossSectionsArrayPath()));
+  setStorePlaneIndices(reader->readValue("StorePlaneIndices", getStorePlaneIndices()));
+  setPlaneIndicesArrayPath(reader->readDataArrayPath("PlaneIndicesArrayPath", getPlaneIndicesArrayPath()));
   reader->closeFilterGroup();
 }
 
@@ -138,6 +154,39 @@ void FindLargestCrossSections::dataCheck()
     m_LargestCrossSections = m_LargestCrossSectionsPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 
+  std::vector<DataArrayPath> featureDataArrayPaths = {getLargestCrossSectionsArrayPath()};
+
+  if(m_ComputeAllPlanes)
+  {
+    std::vector<size_t> planeDims(1, 3);
+    m_AllCrossSectionsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, getAllCrossSectionsArrayPath(), 0, planeDims, "", DataArrayID32);
+    if(nullptr != m_AllCrossSectionsPtr.lock())
+    {
+      m_AllCrossSections = m_AllCrossSectionsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    featureDataArrayPaths.push_back(getAllCrossSectionsArrayPath());
+  }
+
+  if(m_StorePlaneIndices)
+  {
+    // One plane index per computed orientation
+    std::vector<size_t> indexDims(1, m_ComputeAllPlanes ? 3 : 1);
+    m_PlaneIndicesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>>(this, getPlaneIndicesArrayPath(), -1, indexDims, "", DataArrayID33);
+    if(nullptr != m_PlaneIndicesPtr.lock())
+    {
+      m_PlaneIndices = m_PlaneIndicesPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    featureDataArrayPaths.push_back(getPlaneIndicesArrayPath());
+  }
+
+  getDataContainerArray()->validateNumberOfTuples(this, featureDataArrayPaths);
+
+  if(m_Plane > 2)
+  {
+    QString ss = QObject::tr("The Plane of Interest must be 0 (XY), 1 (XZ) or 2 (YZ), but is %1").arg(m_Plane);
+    setErrorCondition(-3013, ss);
+  }
+
   ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getFeatureIdsArrayPath().getDataContainerName());
   if(getErrorCode() < 0)
   {
@@ -160,76 +209,50 @@ void FindLargestCrossSections::dataCheck()
 void FindLargestCrossSections::find_crosssections()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
 
   size_t numfeatures = m_LargestCrossSectionsPtr.lock()->getNumberOfTuples();
 
-  DoubleArrayType::Pointer m_FeatureCounts = DoubleArrayType::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_FeatureCounts"), true);
-  double* featurecounts = m_FeatureCounts->getPointer(0);
+  SizeVec3Type udims = image->getDimensions();
+  PlaneCrossSections::Dimensions dims = {{udims[0], udims[1], udims[2]}};
 
-  size_t outPlane = 0, inPlane1 = 0, inPlane2 = 0;
-  float res_scalar = 0.0f, area = 0.0f;
-  size_t stride1 = 0, stride2 = 0, stride3 = 0;
-  size_t istride = 0, jstride = 0, kstride = 0;
-  size_t point = 0, gnum = 0;
+  // Area of a single Cell in the XY, XZ and YZ planes
+  FloatVec3Type spacing = image->getSpacing();
+  std::array<float, 3> resScalars = {{spacing[0] * spacing[1], spacing[0] * spacing[2], spacing[1] * spacing[2]}};
 
-  FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
-
-  if(m_Plane == 0)
+  std::vector<PlaneCrossSections::Orientation> orientations;
+  if(m_ComputeAllPlanes)
   {
-    outPlane = m->getGeometryAs<ImageGeom>()->getZPoints();
-    inPlane1 = m->getGeometryAs<ImageGeom>()->getXPoints();
-    inPlane2 = m->getGeometryAs<ImageGeom>()->getYPoints();
-
-    res_scalar = spacing[0] * spacing[1];
-    stride1 = inPlane1 * inPlane2;
-    stride2 = 1;
-    stride3 = inPlane1;
+    orientations = {PlaneCrossSections::Orientation::XY, PlaneCrossSections::Orientation::XZ, PlaneCrossSections::Orientation::YZ};
   }
-  if(m_Plane == 1)
+  else
   {
-    outPlane = m->getGeometryAs<ImageGeom>()->getYPoints();
-    inPlane1 = m->getGeometryAs<ImageGeom>()->getXPoints();
-    inPlane2 = m->getGeometryAs<ImageGeom>()->getZPoints();
-    res_scalar = spacing[0] * spacing[2];
-    stride1 = inPlane1;
-    stride2 = 1;
-    stride3 = inPlane1 * inPlane2;
+    orientations = {static_cast<PlaneCrossSections::Orientation>(m_Plane)};
   }
-  if(m_Plane == 2)
-  {
-    outPlane = m->getGeometryAs<ImageGeom>()->getXPoints();
-    inPlane1 = m->getGeometryAs<ImageGeom>()->getYPoints();
-    inPlane2 = m->getGeometryAs<ImageGeom>()->getZPoints();
-    res_scalar = spacing[1] * spacing[2];
-    stride1 = 1;
-    stride2 = inPlane1;
-    stride3 = inPlane1 * inPlane2;
-  }
-  for(size_t i = 0; i < outPlane; i++)
+
+  std::vector<PlaneCrossSections::Result> results = PlaneCrossSections::Find(m_FeatureIds, dims, numfeatures, orientations);
+
+  size_t numOrientations = orientations.size();
+  for(size_t o = 0; o < numOrientations; o++)
   {
-    for(size_t g = 0; g < numfeatures * 1; g++)
-    {
-      featurecounts[g] = 0.0f;
-    }
-    istride = i * stride1;
-    for(size_t j = 0; j < inPlane1; j++)
-    {
-      jstride = j * stride2;
-      for(size_t k = 0; k < inPlane2; k++)
-      {
-        kstride = k * stride3;
-        point = istride + jstride + kstride;
-        gnum = m_FeatureIds[point];
-        featurecounts[gnum]++;
-      }
-    }
+    const PlaneCrossSections::Result& result = results[o];
+    uint32_t plane = static_cast<uint32_t>(orientations[o]);
+    float res_scalar = resScalars[plane];
     for(size_t g = 1; g < numfeatures; g++)
     {
-      area = featurecounts[g] * res_scalar;
-      if(area > m_LargestCrossSections[g])
+      float area = static_cast<float>(static_cast<double>(result.counts[g]) * res_scalar);
+      if(plane == m_Plane)
       {
         m_LargestCrossSections[g] = area;
       }
+      if(m_ComputeAllPlanes)
+      {
+        m_AllCrossSections[g * 3 + plane] = area;
+      }
+      if(m_StorePlaneIndices)
+      {
+        m_PlaneIndices[g * numOrientations + o] = static_cast<int32_t>(result.planes[g]);
+      }
     }
   }
 }
@@ -383,3 +406,51 @@ DataArrayPath FindLargestCrossSections::getLargestCrossSectionsArrayPath() const
 {
   return m_LargestCrossSectionsArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void FindLargestCrossSections::setComputeAllPlanes(bool value)
+{
+  m_ComputeAllPlanes = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindLargestCrossSections::getComputeAllPlanes() const
+{
+  return m_ComputeAllPlanes;
+}
+
+// -----------------------------------------------------------------------------
+void FindLargestCrossSections::setAllCrossSectionsArrayPath(const DataArrayPath& value)
+{
+  m_AllCrossSectionsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindLargestCrossSections::getAllCrossSectionsArrayPath() const
+{
+  return m_AllCrossSectionsArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void FindLargestCrossSections::setStorePlaneIndices(bool value)
+{
+  m_StorePlaneIndices = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindLargestCrossSections::getStorePlaneIndices() const
+{
+  return m_StorePlaneIndices;
+}
+
+// -----------------------------------------------------------------------------
+void FindLargestCrossSections::setPlaneIndicesArrayPath(const DataArrayPath& value)
+{
+  m_PlaneIndicesArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindLargestCrossSections::getPlaneIndicesArrayPath() const
+{
+  return m_PlaneIndicesArrayPath;
+}
@@ -58,6 +58,10 @@ class StatsToolbox_EXPORT FindLargestCrossSections : public AbstractFilter
   PYB11_PROPERTY(unsigned int Plane READ getPlane WRITE setPlane)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath LargestCrossSectionsArrayPath READ getLargestCrossSectionsArrayPath WRITE setLargestCrossSectionsArrayPath)
+  PYB11_PROPERTY(bool ComputeAllPlanes READ getComputeAllPlanes WRITE setComputeAllPlanes)
+  PYB11_PROPERTY(DataArrayPath AllCrossSectionsArrayPath READ getAllCrossSectionsArrayPath WRITE setAllCrossSectionsArrayPath)
+  PYB11_PROPERTY(bool StorePlaneIndices READ getStorePlaneIndices WRITE setStorePlaneIndices)
+  PYB11_PROPERTY(DataArrayPath PlaneIndicesArrayPath READ getPlaneIndicesArrayPath WRITE setPlaneIndicesArrayPath)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -124,6 +128,50 @@ public:
   DataArrayPath getLargestCrossSectionsArrayPath() const;
   Q_PROPERTY(DataArrayPath LargestCrossSectionsArrayPath READ getLargestCrossSectionsArrayPath WRITE setLargestCrossSectionsArrayPath)
 
+  /**
+   * @brief Setter property for ComputeAllPlanes
+   */
+  void setComputeAllPlanes(bool value);
+  /**
+   * @brief Getter property for ComputeAllPlanes
+   * @return Value of ComputeAllPlanes
+   */
+  bool getComputeAllPlanes() const;
+  Q_PROPERTY(bool ComputeAllPlanes READ getComputeAllPlanes WRITE setComputeAllPlanes)
+
+  /**
+   * @brief Setter property for AllCrossSectionsArrayPath
+   */
+  void setAllCrossSectionsArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for AllCrossSectionsArrayPath
+   * @return Value of AllCrossSectionsArrayPath
+   */
+  DataArrayPath getAllCrossSectionsArrayPath() const;
+  Q_PROPERTY(DataArrayPath AllCrossSectionsArrayPath READ getAllCrossSectionsArrayPath WRITE setAllCrossSectionsArrayPath)
+
+  /**
+   * @brief Setter property for StorePlaneIndices
+   */
+  void setStorePlaneIndices(bool value);
+  /**
+   * @brief Getter property for StorePlaneIndices
+   * @return Value of StorePlaneIndices
+   */
+  bool getStorePlaneIndices() const;
+  Q_PROPERTY(bool StorePlaneIndices READ getStorePlaneIndices WRITE setStorePlaneIndices)
+
+  /**
+   * @brief Setter property for PlaneIndicesArrayPath
+   */
+  void setPlaneIndicesArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for PlaneIndicesArrayPath
+   * @return Value of PlaneIndicesArrayPath
+   */
+  DataArrayPath getPlaneIndicesArrayPath() const;
+  Q_PROPERTY(DataArrayPath PlaneIndicesArrayPath READ getPlaneIndicesArrayPath WRITE setPlaneIndicesArrayPath)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -197,7 +245,8 @@ protected:
   void initialize();
 
   /**
-   * @brief find_crosssections Determines the largest area for a Feature in the defined plane of an Image Geometry
+   * @brief find_crosssections Determines the largest area for a Feature in the defined plane of an Image Geometry,
+   * or in all three planes if ComputeAllPlanes is set
    */
   void find_crosssections();
 
@@ -206,10 +255,18 @@ private:
   int32_t* m_FeatureIds = nullptr;
   std::weak_ptr<DataArray<float>> m_LargestCrossSectionsPtr;
   float* m_LargestCrossSections = nullptr;
+  std::weak_ptr<DataArray<float>> m_AllCrossSectionsPtr;
+  float* m_AllCrossSections = nullptr;
+  std::weak_ptr<DataArray<int32_t>> m_PlaneIndicesPtr;
+  int32_t* m_PlaneIndices = nullptr;
 
   unsigned int m_Plane = {0};
   DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
   DataArrayPath m_LargestCrossSectionsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::LargestCrossSections};
+  bool m_ComputeAllPlanes = {false};
+  DataArrayPath m_AllCrossSectionsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, "LargestCrossSectionsAllPlanes"};
+  bool m_StorePlaneIndices = {false};
+  DataArrayPath m_PlaneIndicesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, "LargestCrossSectionPlanes"};
 
 public:
   FindLargestCrossSections(const FindLargestCrossSections&) = delete;            // Copy Constructor Not Implemented
@@ -48,6 +48,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "Generic/GenericFilters/util/CellFeatureReduction.h"
+
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
@@ -189,20 +191,12 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<uint64_t>::Pointer m_FeatureCounts = DataArray<uint64_t>::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_FeatureCounts"), true);
-  m_FeatureCounts->initializeWithZeros();
-  uint64_t* featurecounts = m_FeatureCounts->getPointer(0);
+  std::vector<uint64_t> featurecounts = CellFeatureReduction::Sum<uint64_t>(m_FeatureIds, totalPoints, numfeatures, 1, [](size_t, uint64_t* count) { (*count)++; });
 
   float rad = 0.0f;
   float diameter = 0.0f;
   float res_scalar = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
-
   FloatVec3Type spacing = image->getSpacing();
 
   if(image->getXPoints() == 1 || image->getYPoints() == 1 || image->getZPoints() == 1)
@@ -295,23 +289,23 @@ void FindSizes::findSizesUnstructured(IGeometry::Pointer igeom)
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<float>::Pointer m_FeatureCounts = DataArray<float>::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_FeatureCounts"), true);
-  m_FeatureCounts->initializeWithZeros();
-  float* featurecounts = m_FeatureCounts->getPointer(0);
-
   float rad = 0.0f;
   float diameter = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
+  // Number of elements and summed element size of each feature in one pass
+  std::vector<double> sums = CellFeatureReduction::Sum<double>(m_FeatureIds, totalPoints, numfeatures, 2, [sizes](size_t element, double* featureSums) {
+    featureSums[0] += 1.0;
+    featureSums[1] += static_cast<double>(sizes[element]);
+  });
+  for(size_t i = 0; i < numfeatures; i++)
   {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-    m_Volumes[gnum] += sizes[j];
+    m_Volumes[i] = static_cast<float>(sums[2 * i + 1]);
   }
+
   float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_PiF;
   for(size_t i = 1; i < numfeatures; i++)
   {
-    m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
+    m_NumElements[i] = static_cast<int32_t>(sums[2 * i]);
     rad = m_Volumes[i] / vol_term;
     diameter = 2.0f * powf(rad, 0.3333333333f);
     m_EquivalentDiameters[i] = diameter;
@@ -37,9 +37,11 @@
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
@@ -48,12 +50,18 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "StatsToolbox/StatsToolboxFilters/util/PatchStatistics.h"
 
 enum createdPathID : RenameDataPath::DataID_t
 {
   AttributeMatrixID21 = 21,
 
   DataArrayID31 = 31,
+  DataArrayID32 = 32,
+  DataArrayID33 = 33,
+  DataArrayID34 = 34,
 
   DataContainerID = 1
 };
@@ -86,6 +94,11 @@ void QuiltCellData::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Quilt Step (Voxels)", QuiltStep, FilterParameter::Category::Parameter, QuiltCellData));
   parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Patch Size (Voxels)", PatchSize, FilterParameter::Category::Parameter, QuiltCellData));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Summed Area Tables", UseSummedAreaTable, FilterParameter::Category::Parameter, QuiltCellData));
+  std::vector<QString> linkedProps = {"VarianceArrayName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Variance", ComputeVariance, FilterParameter::Category::Parameter, QuiltCellData, linkedProps));
+  linkedProps = {"MinimumArrayName", "MaximumArrayName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Minimum and Maximum", ComputeMinMax, FilterParameter::Category::Parameter, QuiltCellData, linkedProps));
 
   {
     DataArraySelectionFilterParameter::RequirementType req;
@@ -95,6 +108,9 @@ void QuiltCellData::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Output DataContainer Name", OutputDataContainerName, FilterParameter::Category::CreatedArray, QuiltCellData));
   parameters.push_back(SIMPL_NEW_STRING_FP("Output AttributeMatrix Name", OutputAttributeMatrixName, FilterParameter::Category::CreatedArray, QuiltCellData));
   parameters.push_back(SIMPL_NEW_STRING_FP("Output Data Array Name", OutputArrayName, FilterParameter::Category::CreatedArray, QuiltCellData));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Variance Array Name", VarianceArrayName, FilterParameter::Category::CreatedArray, QuiltCellData));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Minimum Array Name", MinimumArrayName, FilterParameter::Category::CreatedArray, QuiltCellData));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Maximum Array Name", MaximumArrayName, FilterParameter::Category::CreatedArray, QuiltCellData));
 
   setFilterParameters(parameters);
 }
@@ -111,6 +127,12 @@ void QuiltCellData::readFilterParameters(AbstractFilterParametersReader* reader,
   setOutputArrayName(reader->readString("OutputArrayName", getOutputArrayName()));
   setQuiltStep(reader->readIntVec3("QuiltStep", getQuiltStep()));
   setPatchSize(reader->readIntVec3("PatchSize", getPatchSize()));
+  setUseSummedAreaTable(reader->readValue("UseSummedAreaTable", getUseSummedAreaTable()));
+  setComputeVariance(reader->readValue("ComputeVariance", getComputeVariance()));
+  setVarianceArrayName(reader->readString("VarianceArrayName", getVarianceArrayName()));
+  setComputeMinMax(reader->readValue("ComputeMinMax", getComputeMinMax()));
+  setMinimumArrayName(reader->readString("MinimumArrayName", getMinimumArrayName()));
+  setMaximumArrayName(reader->readString("MaximumArrayName", getMaximumArrayName()));
   reader->closeFilterGroup();
 }
 
@@ -241,82 +263,166 @@ void QuiltCellData::dataCheck()
   {
     m_OutputArray = m_OutputArrayPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  if(m_ComputeVariance)
+  {
+    tempPath.update(getOutputDataContainerName().getDataContainerName(), getOutputAttributeMatrixName(), getVarianceArrayName());
+    m_VarianceArrayPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, dims, "", DataArrayID32);
+    if(nullptr != m_VarianceArrayPtr.lock())
+    {
+      m_VarianceArray = m_VarianceArrayPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
+  if(m_ComputeMinMax)
+  {
+    tempPath.update(getOutputDataContainerName().getDataContainerName(), getOutputAttributeMatrixName(), getMinimumArrayName());
+    m_MinimumArrayPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, dims, "", DataArrayID33);
+    if(nullptr != m_MinimumArrayPtr.lock())
+    {
+      m_MinimumArray = m_MinimumArrayPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+    tempPath.update(getOutputDataContainerName().getDataContainerName(), getOutputAttributeMatrixName(), getMaximumArrayName());
+    m_MaximumArrayPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, dims, "", DataArrayID34);
+    if(nullptr != m_MaximumArrayPtr.lock())
+    {
+      m_MaximumArray = m_MaximumArrayPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
 }
 
+namespace
+{
 // -----------------------------------------------------------------------------
-//
+// The voxels covered by a patch of the given size around a center voxel, clipped to the image. A patch spans
+// [-floor(size / 2), floor(size / 2)) around its center, and a size of 1 only covers the center itself.
 // -----------------------------------------------------------------------------
-template <typename T>
-float quiltData(IDataArray::Pointer inputData, int64_t xc, int64_t yc, int64_t zc, IntVec3Type pSize, int64_t xDim, int64_t yDim, int64_t zDim)
+PatchStatistics::Window patchWindow(int64_t center, int32_t patchSize, int64_t dim)
 {
-  float value = 0.0;
-  typename DataArray<T>::Pointer cellArray = std::dynamic_pointer_cast<DataArray<T>>(inputData);
-  if(nullptr == cellArray)
+  int64_t rangeMin = -static_cast<int64_t>(floorf(static_cast<float>(patchSize) / 2.0f));
+  int64_t rangeMax = static_cast<int64_t>(floorf(static_cast<float>(patchSize) / 2.0f));
+  if(patchSize == 1)
   {
-    return 0.0;
+    rangeMin = 0;
+    rangeMax = 1;
   }
 
-  T* cPtr = cellArray->getPointer(0);
+  PatchStatistics::Window window;
+  window.begin = std::max<int64_t>(center + rangeMin, 0);
+  window.end = std::min<int64_t>(center + rangeMax, dim);
+  return window;
+}
+} // namespace
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+float quiltData(const T* cPtr, const PatchStatistics::Window& xWindow, const PatchStatistics::Window& yWindow, const PatchStatistics::Window& zWindow, int64_t xDim, int64_t yDim)
+{
+  float value = 0.0;
   int64_t zStride = 0, yStride = 0;
   float count = 0;
 
-  int xRangeMin = -floorf((float)pSize[0] / 2.0f);
-  int xRangeMax = floorf((float)pSize[0] / 2.0f);
-  int yRangeMin = -floorf((float)pSize[1] / 2.0f);
-  int yRangeMax = floorf((float)pSize[1] / 2.0f);
-  int zRangeMin = -floorf((float)pSize[2] / 2.0f);
-  int zRangeMax = floorf((float)pSize[2] / 2.0f);
-
-  if(pSize[0] == 1)
+  for(int64_t z = zWindow.begin; z < zWindow.end; z++)
   {
-    xRangeMin = 0;
-    xRangeMax = 1;
+    zStride = (z * xDim * yDim);
+    for(int64_t y = yWindow.begin; y < yWindow.end; y++)
+    {
+      yStride = (y * xDim);
+      for(int64_t x = xWindow.begin; x < xWindow.end; x++)
+      {
+        value += cPtr[zStride + yStride + x];
+        count++;
+      }
+    }
   }
-
-  if(pSize[1] == 1)
+  if(count == 0)
+  {
+    value = 0;
+  }
+  else
   {
-    yRangeMin = 0;
-    yRangeMax = 1;
+    value /= count;
   }
+  return value;
+}
 
-  if(pSize[2] == 1)
+/**
+ * @brief The QuiltCellDataImpl class implements a threaded algorithm that averages the input array over the patches
+ * of a range of output cells by summing each patch explicitly.
+ */
+template <typename T>
+class QuiltCellDataImpl
+{
+public:
+  QuiltCellDataImpl(const T* cPtr, const PatchStatistics::Dimensions& dims, const PatchStatistics::Windows& windows, float* outputArray)
+  : m_CellArray(cPtr)
+  , m_Dims(dims)
+  , m_Windows(windows)
+  , m_OutputArray(outputArray)
   {
-    zRangeMin = 0;
-    zRangeMax = 1;
   }
 
-  for(int64_t k = zRangeMin; k < zRangeMax; k++)
+  void convert(size_t start, size_t end) const
   {
-    if((zc + k) >= 0 && (zc + k) < zDim)
+    size_t nx = m_Windows.x.size();
+    size_t ny = m_Windows.y.size();
+    for(size_t index = start; index < end; index++)
     {
-      zStride = ((zc + k) * xDim * yDim);
-      for(int64_t j = yRangeMin; j < yRangeMax; j++)
-      {
-        if((yc + j) >= 0 && (yc + j) < yDim)
-        {
-          yStride = ((yc + j) * xDim);
-          for(int64_t i = xRangeMin; i < xRangeMax; i++)
-          {
-            if((xc + i) >= 0 && (xc + i) < xDim)
-            {
-              value += cPtr[zStride + yStride + (xc + i)];
-              count++;
-            }
-          }
-        }
-      }
+      m_OutputArray[index] = quiltData<T>(m_CellArray, m_Windows.x[index % nx], m_Windows.y[(index / nx) % ny], m_Windows.z[index / (nx * ny)], m_Dims[0], m_Dims[1]);
     }
   }
-  if(count == 0)
+
+  void operator()(const SIMPLRange& range) const
   {
-    value = 0;
+    convert(range.min(), range.max());
+  }
+
+private:
+  const T* m_CellArray = nullptr;
+  PatchStatistics::Dimensions m_Dims;
+  const PatchStatistics::Windows& m_Windows;
+  float* m_OutputArray = nullptr;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+void quiltArray(IDataArray::Pointer inputData, const PatchStatistics::Dimensions& dims, const PatchStatistics::Windows& windows, bool useSummedAreaTable, float* outputArray,
+                float* varianceArray, float* minimumArray, float* maximumArray)
+{
+  typename DataArray<T>::Pointer cellArray = std::dynamic_pointer_cast<DataArray<T>>(inputData);
+  if(nullptr == cellArray)
+  {
+    return;
+  }
+  const T* cPtr = cellArray->getPointer(0);
+
+  if(useSummedAreaTable)
+  {
+    PatchStatistics::MeanAndVariance(cPtr, dims, windows, outputArray, varianceArray);
   }
   else
   {
-    value /= count;
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, windows.count());
+    dataAlg.execute(QuiltCellDataImpl<T>(cPtr, dims, windows, outputArray));
+
+    if(nullptr != varianceArray)
+    {
+      // The variance needs the summed area tables anyway, they just do not replace the explicit means
+      std::vector<float> tableMeans(windows.count());
+      PatchStatistics::MeanAndVariance(cPtr, dims, windows, tableMeans.data(), varianceArray);
+    }
+  }
+
+  if(nullptr != minimumArray)
+  {
+    PatchStatistics::Extrema(cPtr, dims, windows, minimumArray, maximumArray);
   }
-  return value;
 }
 
 // -----------------------------------------------------------------------------
@@ -347,74 +453,34 @@ void QuiltCellData::execute()
     return;
   }
 
-  QString dType = inputData->getTypeAsString();
-
-  int64_t dims[3] = {0, 0, 0};
+  PatchStatistics::Dimensions dims = {{0, 0, 0}};
   dims[0] = static_cast<int64_t>(dcDims[0]);
   dims[1] = static_cast<int64_t>(dcDims[1]);
   dims[2] = static_cast<int64_t>(dcDims[2]);
 
-  int64_t zStride = 0, yStride = 0;
-  int64_t xc = 0, yc = 0, zc = 0;
+  // The patches form a grid, so the voxels they cover are the same for every output cell along each axis
+  PatchStatistics::Windows windows;
+  for(size_t i = 0; i < dc2Dims[0]; i++)
+  {
+    int64_t xc = i * m_QuiltStep[0] + m_QuiltStep[0] / 2;
+    windows.x.push_back(patchWindow(xc, m_PatchSize[0], dims[0]));
+  }
+  for(size_t j = 0; j < dc2Dims[1]; j++)
+  {
+    int64_t yc = j * m_QuiltStep[1] + m_QuiltStep[1] / 2;
+    windows.y.push_back(patchWindow(yc, m_PatchSize[1], dims[1]));
+  }
   for(size_t k = 0; k < dc2Dims[2]; k++)
   {
-    zStride = (k * dc2Dims[0] * dc2Dims[1]);
-    for(size_t j = 0; j < dc2Dims[1]; j++)
-    {
-      yStride = (j * dc2Dims[0]);
-      for(size_t i = 0; i < dc2Dims[0]; i++)
-      {
-        xc = i * m_QuiltStep[0] + m_QuiltStep[0] / 2;
-        yc = j * m_QuiltStep[1] + m_QuiltStep[1] / 2;
-        // zc = k * m_QuiltStep[2] + m_QuiltStep[2] / 2;
-        zc = 0;
-        if(dType.compare("int8_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<int8_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("uint8_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<uint8_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("int16_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<int16_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("uint16_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<uint16_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("int32_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<int32_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("uint32_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<uint32_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("int64_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<int64_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("uint64_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<uint64_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("float") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<float>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("double") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<double>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("bool") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<bool>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-      }
-    }
+    // int64_t zc = k * m_QuiltStep[2] + m_QuiltStep[2] / 2;
+    int64_t zc = 0;
+    windows.z.push_back(patchWindow(zc, m_PatchSize[2], dims[2]));
   }
+
+  float* varianceArray = m_ComputeVariance ? m_VarianceArray : nullptr;
+  float* minimumArray = m_ComputeMinMax ? m_MinimumArray : nullptr;
+  float* maximumArray = m_ComputeMinMax ? m_MaximumArray : nullptr;
+  EXECUTE_FUNCTION_TEMPLATE(this, quiltArray, inputData, inputData, dims, windows, m_UseSummedAreaTable, m_OutputArray, varianceArray, minimumArray, maximumArray)
 }
 
 // -----------------------------------------------------------------------------
@@ -589,3 +655,75 @@ QString QuiltCellData::getOutputArrayName() const
 {
   return m_OutputArrayName;
 }
+
+// -----------------------------------------------------------------------------
+void QuiltCellData::setUseSummedAreaTable(bool value)
+{
+  m_UseSummedAreaTable = value;
+}
+
+// -----------------------------------------------------------------------------
+bool QuiltCellData::getUseSummedAreaTable() const
+{
+  return m_UseSummedAreaTable;
+}
+
+// -----------------------------------------------------------------------------
+void QuiltCellData::setComputeVariance(bool value)
+{
+  m_ComputeVariance = value;
+}
+
+// -----------------------------------------------------------------------------
+bool QuiltCellData::getComputeVariance() const
+{
+  return m_ComputeVariance;
+}
+
+// -----------------------------------------------------------------------------
+void QuiltCellData::setVarianceArrayName(const QString& value)
+{
+  m_VarianceArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString QuiltCellData::getVarianceArrayName() const
+{
+  return m_VarianceArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void QuiltCellData::setComputeMinMax(bool value)
+{
+  m_ComputeMinMax = value;
+}
+
+// -----------------------------------------------------------------------------
+bool QuiltCellData::getComputeMinMax() const
+{
+  return m_ComputeMinMax;
+}
+
+// -----------------------------------------------------------------------------
+void QuiltCellData::setMinimumArrayName(const QString& value)
+{
+  m_MinimumArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString QuiltCellData::getMinimumArrayName() const
+{
+  return m_MinimumArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void QuiltCellData::setMaximumArrayName(const QString& value)
+{
+  m_MaximumArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString QuiltCellData::getMaximumArrayName() const
+{
+  return m_MaximumArrayName;
+}
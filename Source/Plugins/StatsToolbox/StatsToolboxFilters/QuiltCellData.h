@@ -72,6 +72,12 @@ class StatsToolbox_EXPORT QuiltCellData : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath OutputDataContainerName READ getOutputDataContainerName WRITE setOutputDataContainerName)
   PYB11_PROPERTY(QString OutputAttributeMatrixName READ getOutputAttributeMatrixName WRITE setOutputAttributeMatrixName)
   PYB11_PROPERTY(QString OutputArrayName READ getOutputArrayName WRITE setOutputArrayName)
+  PYB11_PROPERTY(bool UseSummedAreaTable READ getUseSummedAreaTable WRITE setUseSummedAreaTable)
+  PYB11_PROPERTY(bool ComputeVariance READ getComputeVariance WRITE setComputeVariance)
+  PYB11_PROPERTY(QString VarianceArrayName READ getVarianceArrayName WRITE setVarianceArrayName)
+  PYB11_PROPERTY(bool ComputeMinMax READ getComputeMinMax WRITE setComputeMinMax)
+  PYB11_PROPERTY(QString MinimumArrayName READ getMinimumArrayName WRITE setMinimumArrayName)
+  PYB11_PROPERTY(QString MaximumArrayName READ getMaximumArrayName WRITE setMaximumArrayName)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -172,6 +178,72 @@ public:
   QString getOutputArrayName() const;
   Q_PROPERTY(QString OutputArrayName READ getOutputArrayName WRITE setOutputArrayName)
 
+  /**
+   * @brief Setter property for UseSummedAreaTable
+   */
+  void setUseSummedAreaTable(bool value);
+  /**
+   * @brief Getter property for UseSummedAreaTable
+   * @return Value of UseSummedAreaTable
+   */
+  bool getUseSummedAreaTable() const;
+  Q_PROPERTY(bool UseSummedAreaTable READ getUseSummedAreaTable WRITE setUseSummedAreaTable)
+
+  /**
+   * @brief Setter property for ComputeVariance
+   */
+  void setComputeVariance(bool value);
+  /**
+   * @brief Getter property for ComputeVariance
+   * @return Value of ComputeVariance
+   */
+  bool getComputeVariance() const;
+  Q_PROPERTY(bool ComputeVariance READ getComputeVariance WRITE setComputeVariance)
+
+  /**
+   * @brief Setter property for VarianceArrayName
+   */
+  void setVarianceArrayName(const QString& value);
+  /**
+   * @brief Getter property for VarianceArrayName
+   * @return Value of VarianceArrayName
+   */
+  QString getVarianceArrayName() const;
+  Q_PROPERTY(QString VarianceArrayName READ getVarianceArrayName WRITE setVarianceArrayName)
+
+  /**
+   * @brief Setter property for ComputeMinMax
+   */
+  void setComputeMinMax(bool value);
+  /**
+   * @brief Getter property for ComputeMinMax
+   * @return Value of ComputeMinMax
+   */
+  bool getComputeMinMax() const;
+  Q_PROPERTY(bool ComputeMinMax READ getComputeMinMax WRITE setComputeMinMax)
+
+  /**
+   * @brief Setter property for MinimumArrayName
+   */
+  void setMinimumArrayName(const QString& value);
+  /**
+   * @brief Getter property for MinimumArrayName
+   * @return Value of MinimumArrayName
+   */
+  QString getMinimumArrayName() const;
+  Q_PROPERTY(QString MinimumArrayName READ getMinimumArrayName WRITE setMinimumArrayName)
+
+  /**
+   * @brief Setter property for MaximumArrayName
+   */
+  void setMaximumArrayName(const QString& value);
+  /**
+   * @brief Getter property for MaximumArrayName
+   * @return Value of MaximumArrayName
+   */
+  QString getMaximumArrayName() const;
+  Q_PROPERTY(QString MaximumArrayName READ getMaximumArrayName WRITE setMaximumArrayName)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -248,6 +320,12 @@ protected:
 private:
   std::weak_ptr<DataArray<float>> m_OutputArrayPtr;
   float* m_OutputArray = nullptr;
+  std::weak_ptr<DataArray<float>> m_VarianceArrayPtr;
+  float* m_VarianceArray = nullptr;
+  std::weak_ptr<DataArray<float>> m_MinimumArrayPtr;
+  float* m_MinimumArray = nullptr;
+  std::weak_ptr<DataArray<float>> m_MaximumArrayPtr;
+  float* m_MaximumArray = nullptr;
 
   DataArrayPath m_SelectedCellArrayPath = {"", "", ""};
   IntVec3Type m_QuiltStep = {};
@@ -255,6 +333,12 @@ private:
   DataArrayPath m_OutputDataContainerName = {SIMPL::Defaults::NewImageDataContainerName, "", ""};
   QString m_OutputAttributeMatrixName = {SIMPL::Defaults::CellAttributeMatrixName};
   QString m_OutputArrayName = {"Quilt_Data"};
+  bool m_UseSummedAreaTable = {false};
+  bool m_ComputeVariance = {false};
+  QString m_VarianceArrayName = {"Quilt_Variance"};
+  bool m_ComputeMinMax = {false};
+  QString m_MinimumArrayName = {"Quilt_Minimum"};
+  QString m_MaximumArrayName = {"Quilt_Maximum"};
 
 public:
   QuiltCellData(const QuiltCellData&) = delete;            // Copy Constructor Not Implemented
@@ -0,0 +1,463 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "Generic/GenericFilters/util/CellFeatureReduction.h"
+
+/**
+ * @brief The HistogramEngine class bins the values of a scalar array in parallel. The values are split into one
+ * contiguous block per thread and each block counts into its own copy of the bins, which are added together
+ * afterwards. Besides the histogram itself a single pass can count the bins of every feature and fill a quantile
+ * sketch, and a mask can leave values out of all of them.
+ */
+class HistogramEngine
+{
+public:
+  /**
+   * @brief The Range struct holds the smallest and largest value of an array and the number of values that were
+   * looked at. min is larger than max if there were no values.
+   */
+  struct Range
+  {
+    double min = std::numeric_limits<double>::max();
+    double max = -std::numeric_limits<double>::max();
+    size_t count = 0;
+  };
+
+  /**
+   * @brief The QuantileSketch class estimates percentiles from a fine histogram over the full range of the data
+   * instead of sorting the values. Integer data whose range fits into the sketch gets one bin per integer, which
+   * makes the percentiles exact. Otherwise the range is split into MaxBins equal bins and a percentile is
+   * interpolated within its bin, so it is off by at most (max - min) / MaxBins.
+   */
+  class QuantileSketch
+  {
+  public:
+    static constexpr size_t MaxBins = size_t(1) << 16;
+
+    QuantileSketch() = default;
+
+    QuantileSketch(double min, double max, bool integral)
+    : m_Min(min)
+    , m_Max(max)
+    {
+      if(max <= min)
+      {
+        m_NumBins = 1;
+      }
+      else if(integral && max - min < static_cast<double>(MaxBins))
+      {
+        m_NumBins = static_cast<size_t>(max - min) + 1;
+        m_Width = 1.0;
+        m_Exact = true;
+      }
+      else
+      {
+        m_NumBins = MaxBins;
+        m_Width = (max - min) / static_cast<double>(MaxBins);
+      }
+      m_Counts.assign(m_NumBins, 0);
+    }
+
+    /**
+     * @brief binCount Returns the number of bins of the sketch
+     */
+    size_t binCount() const
+    {
+      return m_NumBins;
+    }
+
+    /**
+     * @brief bin Returns the bin of a value. Values outside the range of the sketch go into the first or last bin.
+     * @param value Value that is not NaN
+     */
+    size_t bin(double value) const
+    {
+      if(m_Width <= 0.0 || value <= m_Min)
+      {
+        return 0;
+      }
+      return std::min(static_cast<size_t>((value - m_Min) / m_Width), m_NumBins - 1);
+    }
+
+    /**
+     * @brief counts Returns the number of values in each bin
+     */
+    std::vector<size_t>& counts()
+    {
+      return m_Counts;
+    }
+
+    /**
+     * @brief percentile Returns the value below or at which the given percentage of the values lies, using the
+     * nearest rank definition: the value at rank ceil(percent / 100 * N) of the N values in increasing order.
+     * @param percent Percentage in [0, 100]
+     * @return NaN if the sketch holds no values
+     */
+    double percentile(double percent) const
+    {
+      size_t total = 0;
+      for(size_t count : m_Counts)
+      {
+        total += count;
+      }
+      if(total == 0)
+      {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+
+      double rank = std::max(std::ceil(std::min(std::max(percent, 0.0), 100.0) / 100.0 * static_cast<double>(total)), 1.0);
+      // The smallest and largest value are known exactly
+      if(rank <= 1.0)
+      {
+        return m_Min;
+      }
+      if(rank >= static_cast<double>(total))
+      {
+        return m_Max;
+      }
+
+      size_t before = 0;
+      size_t b = 0;
+      while(b < m_NumBins - 1 && static_cast<double>(before + m_Counts[b]) < rank)
+      {
+        before += m_Counts[b];
+        b++;
+      }
+
+      if(m_Exact || m_Width <= 0.0)
+      {
+        return m_Min + static_cast<double>(b) * m_Width;
+      }
+      // Spread the values of the bin evenly over its width
+      double fraction = (rank - static_cast<double>(before) - 0.5) / static_cast<double>(std::max<size_t>(m_Counts[b], 1));
+      double value = m_Min + (static_cast<double>(b) + fraction) * m_Width;
+      return std::min(std::max(value, m_Min), m_Max);
+    }
+
+  private:
+    double m_Min = 0.0;
+    double m_Max = 0.0;
+    double m_Width = 0.0;
+    size_t m_NumBins = 0;
+    bool m_Exact = false;
+    std::vector<size_t> m_Counts;
+  };
+
+  /**
+   * @brief The Histogram struct holds the result of Compute
+   */
+  struct Histogram
+  {
+    // Number of values in each bin
+    std::vector<size_t> counts;
+    // Number of values that fell outside of all bins
+    size_t overflow = 0;
+    // Number of values in each bin of each feature, numFeatures x numBins values
+    std::vector<size_t> featureCounts;
+  };
+
+  /**
+   * @brief FindRange Finds the smallest and largest value of an array, leaving out NaN values and the values
+   * whose mask entry is false.
+   * @param values
+   * @param numValues
+   * @param mask Optional mask, nullptr to use all values
+   * @return
+   */
+  template <typename T>
+  static Range FindRange(const T* values, size_t numValues, const bool* mask)
+  {
+    size_t numBlocks = CellFeatureReduction::BlockCount(numValues, 1, 1);
+    std::vector<Range> ranges(numBlocks);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute(FindRangeImpl<T>(values, numValues, mask, numBlocks, ranges));
+
+    Range range;
+    for(const Range& blockRange : ranges)
+    {
+      range.min = std::min(range.min, blockRange.min);
+      range.max = std::max(range.max, blockRange.max);
+      range.count += blockRange.count;
+    }
+    return range;
+  }
+
+  /**
+   * @brief Compute Bins the values of an array into numBins bins of the given width starting at min. Bin i
+   * holds the values in [min + i * increment, min + (i + 1) * increment). With a single bin every value is put
+   * into that bin, whatever its value.
+   * @param values
+   * @param numValues
+   * @param mask Optional mask, nullptr to use all values
+   * @param min Lower edge of the first bin
+   * @param increment Width of the bins
+   * @param numBins
+   * @param featureIds Optional feature id of each value, nullptr to skip the per feature histograms. Values whose
+   * feature id is outside [0, numFeatures) are only counted in the overall histogram
+   * @param numFeatures
+   * @param sketch Optional quantile sketch that receives all values that are not NaN, nullptr to skip it
+   * @return
+   */
+  template <typename T>
+  static Histogram Compute(const T* values, size_t numValues, const bool* mask, float min, float increment, int32_t numBins, const int32_t* featureIds, size_t numFeatures,
+                           QuantileSketch* sketch)
+  {
+    Layout layout;
+    layout.numBins = static_cast<size_t>(std::max(numBins, 1));
+    layout.numFeatures = (nullptr != featureIds) ? numFeatures : 0;
+    layout.sketchBins = (nullptr != sketch) ? sketch->binCount() : 0;
+
+    size_t numBlocks = CellFeatureReduction::BlockCount(numValues, 1, layout.size());
+    std::vector<size_t> accumulators(numBlocks * layout.size(), 0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute(BinValuesImpl<T>(values, numValues, mask, min, increment, featureIds, sketch, layout, numBlocks, accumulators));
+
+    // Add the counts of all blocks into those of the first block
+    for(size_t block = 1; block < numBlocks; block++)
+    {
+      const size_t* blockCounts = accumulators.data() + block * layout.size();
+      for(size_t i = 0; i < layout.size(); i++)
+      {
+        accumulators[i] += blockCounts[i];
+      }
+    }
+
+    Histogram histogram;
+    histogram.counts.assign(accumulators.begin(), accumulators.begin() + layout.numBins);
+    histogram.overflow = accumulators[layout.overflowOffset()];
+    if(nullptr != sketch)
+    {
+      std::copy_n(accumulators.begin() + layout.sketchOffset(), layout.sketchBins, sketch->counts().begin());
+    }
+    if(nullptr != featureIds)
+    {
+      histogram.featureCounts.assign(accumulators.begin() + layout.featureOffset(), accumulators.begin() + layout.size());
+    }
+    return histogram;
+  }
+
+protected:
+  HistogramEngine() = default;
+
+public:
+  HistogramEngine(const HistogramEngine&) = delete;            // Copy Constructor Not Implemented
+  HistogramEngine(HistogramEngine&&) = delete;                 // Move Constructor Not Implemented
+  HistogramEngine& operator=(const HistogramEngine&) = delete; // Copy Assignment Not Implemented
+  HistogramEngine& operator=(HistogramEngine&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  /**
+   * @brief The Layout struct describes the counts of one block: the bins, the overflow count, the bins of the
+   * quantile sketch and the bins of every feature, one after another.
+   */
+  struct Layout
+  {
+    size_t numBins = 1;
+    size_t sketchBins = 0;
+    size_t numFeatures = 0;
+
+    size_t overflowOffset() const
+    {
+      return numBins;
+    }
+    size_t sketchOffset() const
+    {
+      return numBins + 1;
+    }
+    size_t featureOffset() const
+    {
+      return sketchOffset() + sketchBins;
+    }
+    size_t size() const
+    {
+      return featureOffset() + numFeatures * numBins;
+    }
+  };
+
+  /**
+   * @brief The FindRangeImpl class implements a threaded algorithm that finds the range of the values of one block.
+   */
+  template <typename T>
+  class FindRangeImpl
+  {
+  public:
+    FindRangeImpl(const T* values, size_t numValues, const bool* mask, size_t numBlocks, std::vector<Range>& ranges)
+    : m_Values(values)
+    , m_NumValues(numValues)
+    , m_Mask(mask)
+    , m_NumBlocks(numBlocks)
+    , m_Ranges(ranges)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t block = start; block < end; block++)
+      {
+        Range& range = m_Ranges[block];
+        size_t first = m_NumValues * block / m_NumBlocks;
+        size_t last = m_NumValues * (block + 1) / m_NumBlocks;
+        for(size_t i = first; i < last; i++)
+        {
+          if(nullptr != m_Mask && !m_Mask[i])
+          {
+            continue;
+          }
+          double value = static_cast<double>(m_Values[i]);
+          if(std::isnan(value))
+          {
+            continue;
+          }
+          range.min = std::min(range.min, value);
+          range.max = std::max(range.max, value);
+          range.count++;
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    const T* m_Values = nullptr;
+    size_t m_NumValues = 0;
+    const bool* m_Mask = nullptr;
+    size_t m_NumBlocks = 1;
+    std::vector<Range>& m_Ranges;
+  };
+
+  /**
+   * @brief The BinValuesImpl class implements a threaded algorithm that counts the values of one block into the
+   * bins of that block.
+   */
+  template <typename T>
+  class BinValuesImpl
+  {
+  public:
+    BinValuesImpl(const T* values, size_t numValues, const bool* mask, float min, float increment, const int32_t* featureIds, const QuantileSketch* sketch, const Layout& layout,
+                  size_t numBlocks, std::vector<size_t>& accumulators)
+    : m_Values(values)
+    , m_NumValues(numValues)
+    , m_Mask(mask)
+    , m_Min(min)
+    , m_Increment(increment)
+    , m_FeatureIds(featureIds)
+    , m_Sketch(sketch)
+    , m_Layout(layout)
+    , m_NumBlocks(numBlocks)
+    , m_Accumulators(accumulators)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      int32_t numBins = static_cast<int32_t>(m_Layout.numBins);
+      for(size_t block = start; block < end; block++)
+      {
+        size_t* counts = m_Accumulators.data() + block * m_Layout.size();
+        size_t* sketchCounts = counts + m_Layout.sketchOffset();
+        size_t* featureCounts = counts + m_Layout.featureOffset();
+        size_t first = m_NumValues * block / m_NumBlocks;
+        size_t last = m_NumValues * (block + 1) / m_NumBlocks;
+        for(size_t i = first; i < last; i++)
+        {
+          if(nullptr != m_Mask && !m_Mask[i])
+          {
+            continue;
+          }
+          if(nullptr != m_Sketch && !std::isnan(static_cast<double>(m_Values[i])))
+          {
+            sketchCounts[m_Sketch->bin(static_cast<double>(m_Values[i]))]++;
+          }
+
+          int32_t bin = 0;
+          if(numBins > 1)
+          {
+            auto offset = (m_Values[i] - m_Min) / m_Increment;
+            if(!(offset >= 0 && offset < numBins))
+            {
+              counts[m_Layout.overflowOffset()]++;
+              continue;
+            }
+            bin = static_cast<int32_t>(offset);
+          }
+          counts[bin]++;
+
+          if(nullptr != m_FeatureIds)
+          {
+            int32_t featureId = m_FeatureIds[i];
+            if(featureId >= 0 && static_cast<size_t>(featureId) < m_Layout.numFeatures)
+            {
+              featureCounts[static_cast<size_t>(featureId) * m_Layout.numBins + bin]++;
+            }
+          }
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    const T* m_Values = nullptr;
+    size_t m_NumValues = 0;
+    const bool* m_Mask = nullptr;
+    float m_Min = 0.0f;
+    float m_Increment = 1.0f;
+    const int32_t* m_FeatureIds = nullptr;
+    const QuantileSketch* m_Sketch = nullptr;
+    Layout m_Layout;
+    size_t m_NumBlocks = 1;
+    std::vector<size_t>& m_Accumulators;
+  };
+};
@@ -0,0 +1,516 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The PatchStatistics class computes the mean, variance, minimum and maximum of a scalar image over a grid
+ * of boxes (patches). The boxes are given per axis: box (i, j, k) covers windows.x[i] x windows.y[j] x
+ * windows.z[k], so each axis can have its own spacing, patch size and clipping at the image border.
+ *
+ * The mean and variance come from summed volume tables (3D summed area tables) of the values and of their squares.
+ * The tables are built once with one parallel prefix sum pass per axis, after which the sum over any box takes
+ * eight lookups no matter how large the box is. The minimum and maximum are found with one pass per axis, each of
+ * which reduces the values along that axis over the windows of the axis.
+ */
+class PatchStatistics
+{
+public:
+  /**
+   * @brief The Window struct is the range [begin, end) of voxels covered by the boxes along one axis
+   */
+  struct Window
+  {
+    int64_t begin = 0;
+    int64_t end = 0;
+
+    int64_t size() const
+    {
+      return end > begin ? end - begin : 0;
+    }
+  };
+
+  /**
+   * @brief The Windows struct holds the windows of the boxes along each axis. The output of box (i, j, k) is stored
+   * at (k * y.size() + j) * x.size() + i.
+   */
+  struct Windows
+  {
+    std::vector<Window> x;
+    std::vector<Window> y;
+    std::vector<Window> z;
+
+    size_t count() const
+    {
+      return x.size() * y.size() * z.size();
+    }
+  };
+
+  using Dimensions = std::array<int64_t, 3>;
+
+  /**
+   * @brief MeanAndVariance Computes the mean and optionally the variance of the values in every box. Boxes that
+   * hold no voxels get 0 for both.
+   * @param values Scalar values in x fastest order
+   * @param dims Dimensions of the image
+   * @param windows Windows of the boxes, clipped to the image
+   * @param mean Output mean of each box
+   * @param variance Optional output population variance of each box, nullptr to skip it and the table of squares
+   */
+  template <typename T>
+  static void MeanAndVariance(const T* values, const Dimensions& dims, const Windows& windows, float* mean, float* variance)
+  {
+    // The values are summed relative to the first one so that the tables keep their precision for data that sits
+    // far away from zero
+    double shift = (dims[0] * dims[1] * dims[2] > 0) ? static_cast<double>(values[0]) : 0.0;
+
+    std::vector<double> sums = BuildTable(values, dims, shift, false);
+    std::vector<double> squares;
+    if(nullptr != variance)
+    {
+      squares = BuildTable(values, dims, shift, true);
+    }
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, windows.count());
+    dataAlg.execute(BoxMomentsImpl(dims, windows, shift, sums, squares, mean, variance));
+  }
+
+  /**
+   * @brief Extrema Computes the minimum and maximum of the values in every box. Boxes that hold no voxels get 0
+   * for both.
+   * @param values Scalar values in x fastest order
+   * @param dims Dimensions of the image
+   * @param windows Windows of the boxes, clipped to the image
+   * @param minimum Output minimum of each box
+   * @param maximum Output maximum of each box
+   */
+  template <typename T>
+  static void Extrema(const T* values, const Dimensions& dims, const Windows& windows, float* minimum, float* maximum)
+  {
+    size_t nx = windows.x.size();
+    size_t ny = windows.y.size();
+    size_t nz = windows.z.size();
+
+    // Reduce along x for every row of the image, then along y for every slice and last along z
+    std::vector<double> rowMin(nx * dims[1] * dims[2]);
+    std::vector<double> rowMax(rowMin.size());
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, dims[1] * dims[2]);
+      dataAlg.execute(ReduceRowsImpl<T>(values, dims, windows.x, rowMin, rowMax));
+    }
+
+    std::vector<double> sliceMin(nx * ny * dims[2]);
+    std::vector<double> sliceMax(sliceMin.size());
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, dims[2] * ny);
+      dataAlg.execute(ReduceAxisImpl(rowMin, rowMax, nx, dims[1], windows.y, sliceMin, sliceMax));
+    }
+
+    std::vector<double> boxMin(nx * ny * nz);
+    std::vector<double> boxMax(boxMin.size());
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, nz);
+      dataAlg.execute(ReduceAxisImpl(sliceMin, sliceMax, nx * ny, dims[2], windows.z, boxMin, boxMax));
+    }
+
+    for(size_t i = 0; i < boxMin.size(); i++)
+    {
+      bool empty = boxMin[i] > boxMax[i];
+      minimum[i] = empty ? 0.0f : static_cast<float>(boxMin[i]);
+      maximum[i] = empty ? 0.0f : static_cast<float>(boxMax[i]);
+    }
+  }
+
+protected:
+  PatchStatistics() = default;
+
+public:
+  PatchStatistics(const PatchStatistics&) = delete;            // Copy Constructor Not Implemented
+  PatchStatistics(PatchStatistics&&) = delete;                 // Move Constructor Not Implemented
+  PatchStatistics& operator=(const PatchStatistics&) = delete; // Copy Assignment Not Implemented
+  PatchStatistics& operator=(PatchStatistics&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  /**
+   * @brief TableIndex Returns the index of entry (i, j, k) of a summed volume table. The table has one extra
+   * leading row of zeros along each axis, so entry (i, j, k) holds the sum over the voxels [0, i) x [0, j) x [0, k).
+   */
+  static size_t TableIndex(const Dimensions& dims, int64_t i, int64_t j, int64_t k)
+  {
+    return static_cast<size_t>((k * (dims[1] + 1) + j) * (dims[0] + 1) + i);
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  static std::vector<double> BuildTable(const T* values, const Dimensions& dims, double shift, bool squares)
+  {
+    std::vector<double> table(static_cast<size_t>((dims[0] + 1) * (dims[1] + 1) * (dims[2] + 1)), 0.0);
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, dims[1] * dims[2]);
+      dataAlg.execute(PrefixSumRowsImpl<T>(values, dims, shift, squares, table));
+    }
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(1, dims[2] + 1);
+      dataAlg.execute(PrefixSumColumnsImpl(dims, table));
+    }
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(1, dims[1] + 1);
+      dataAlg.execute(PrefixSumPillarsImpl(dims, table));
+    }
+    return table;
+  }
+
+  /**
+   * @brief The PrefixSumRowsImpl class implements a threaded algorithm that writes the running sums along x of
+   * a range of image rows into a summed volume table.
+   */
+  template <typename T>
+  class PrefixSumRowsImpl
+  {
+  public:
+    PrefixSumRowsImpl(const T* values, const Dimensions& dims, double shift, bool squares, std::vector<double>& table)
+    : m_Values(values)
+    , m_Dims(dims)
+    , m_Shift(shift)
+    , m_Squares(squares)
+    , m_Table(table)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t row = start; row < end; row++)
+      {
+        int64_t j = static_cast<int64_t>(row) % m_Dims[1];
+        int64_t k = static_cast<int64_t>(row) / m_Dims[1];
+        const T* rowValues = m_Values + row * m_Dims[0];
+        double* tableRow = m_Table.data() + TableIndex(m_Dims, 0, j + 1, k + 1);
+        double sum = 0.0;
+        for(int64_t i = 0; i < m_Dims[0]; i++)
+        {
+          double value = static_cast<double>(rowValues[i]) - m_Shift;
+          sum += m_Squares ? value * value : value;
+          tableRow[i + 1] = sum;
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    const T* m_Values = nullptr;
+    Dimensions m_Dims;
+    double m_Shift = 0.0;
+    bool m_Squares = false;
+    std::vector<double>& m_Table;
+  };
+
+  /**
+   * @brief The PrefixSumColumnsImpl class implements a threaded algorithm that adds up the rows of a range of
+   * table slices along y.
+   */
+  class PrefixSumColumnsImpl
+  {
+  public:
+    PrefixSumColumnsImpl(const Dimensions& dims, std::vector<double>& table)
+    : m_Dims(dims)
+    , m_Table(table)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t k = start; k < end; k++)
+      {
+        for(int64_t j = 2; j <= m_Dims[1]; j++)
+        {
+          const double* previous = m_Table.data() + TableIndex(m_Dims, 0, j - 1, k);
+          double* current = m_Table.data() + TableIndex(m_Dims, 0, j, k);
+          for(int64_t i = 1; i <= m_Dims[0]; i++)
+          {
+            current[i] += previous[i];
+          }
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    Dimensions m_Dims;
+    std::vector<double>& m_Table;
+  };
+
+  /**
+   * @brief The PrefixSumPillarsImpl class implements a threaded algorithm that adds up the slices of a range of
+   * table rows along z.
+   */
+  class PrefixSumPillarsImpl
+  {
+  public:
+    PrefixSumPillarsImpl(const Dimensions& dims, std::vector<double>& table)
+    : m_Dims(dims)
+    , m_Table(table)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t j = start; j < end; j++)
+      {
+        for(int64_t k = 2; k <= m_Dims[2]; k++)
+        {
+          const double* previous = m_Table.data() + TableIndex(m_Dims, 0, j, k - 1);
+          double* current = m_Table.data() + TableIndex(m_Dims, 0, j, k);
+          for(int64_t i = 1; i <= m_Dims[0]; i++)
+          {
+            current[i] += previous[i];
+          }
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    Dimensions m_Dims;
+    std::vector<double>& m_Table;
+  };
+
+  /**
+   * @brief The BoxMomentsImpl class implements a threaded algorithm that reads the mean and variance of a range of
+   * boxes from the summed volume tables.
+   */
+  class BoxMomentsImpl
+  {
+  public:
+    BoxMomentsImpl(const Dimensions& dims, const Windows& windows, double shift, const std::vector<double>& sums, const std::vector<double>& squares, float* mean, float* variance)
+    : m_Dims(dims)
+    , m_Windows(windows)
+    , m_Shift(shift)
+    , m_Sums(sums)
+    , m_Squares(squares)
+    , m_Mean(mean)
+    , m_Variance(variance)
+    {
+    }
+
+    double boxSum(const std::vector<double>& table, const Window& x, const Window& y, const Window& z) const
+    {
+      auto at = [&](int64_t i, int64_t j, int64_t k) { return table[TableIndex(m_Dims, i, j, k)]; };
+      return at(x.end, y.end, z.end) - at(x.begin, y.end, z.end) - at(x.end, y.begin, z.end) - at(x.end, y.end, z.begin) + at(x.begin, y.begin, z.end) + at(x.begin, y.end, z.begin) +
+             at(x.end, y.begin, z.begin) - at(x.begin, y.begin, z.begin);
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      size_t nx = m_Windows.x.size();
+      size_t ny = m_Windows.y.size();
+      for(size_t index = start; index < end; index++)
+      {
+        const Window& x = m_Windows.x[index % nx];
+        const Window& y = m_Windows.y[(index / nx) % ny];
+        const Window& z = m_Windows.z[index / (nx * ny)];
+        int64_t count = x.size() * y.size() * z.size();
+        if(count == 0)
+        {
+          m_Mean[index] = 0.0f;
+          if(nullptr != m_Variance)
+          {
+            m_Variance[index] = 0.0f;
+          }
+          continue;
+        }
+
+        double average = boxSum(m_Sums, x, y, z) / static_cast<double>(count);
+        m_Mean[index] = static_cast<float>(m_Shift + average);
+        if(nullptr != m_Variance)
+        {
+          double averageSquare = boxSum(m_Squares, x, y, z) / static_cast<double>(count);
+          m_Variance[index] = static_cast<float>(std::max(averageSquare - average * average, 0.0));
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    Dimensions m_Dims;
+    const Windows& m_Windows;
+    double m_Shift = 0.0;
+    const std::vector<double>& m_Sums;
+    const std::vector<double>& m_Squares;
+    float* m_Mean = nullptr;
+    float* m_Variance = nullptr;
+  };
+
+  /**
+   * @brief The ReduceRowsImpl class implements a threaded algorithm that finds the minimum and maximum over each x
+   * window of a range of image rows.
+   */
+  template <typename T>
+  class ReduceRowsImpl
+  {
+  public:
+    ReduceRowsImpl(const T* values, const Dimensions& dims, const std::vector<Window>& windows, std::vector<double>& minimum, std::vector<double>& maximum)
+    : m_Values(values)
+    , m_Dims(dims)
+    , m_Windows(windows)
+    , m_Minimum(minimum)
+    , m_Maximum(maximum)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      size_t nx = m_Windows.size();
+      for(size_t row = start; row < end; row++)
+      {
+        const T* rowValues = m_Values + row * m_Dims[0];
+        for(size_t w = 0; w < nx; w++)
+        {
+          double minimum = std::numeric_limits<double>::infinity();
+          double maximum = -std::numeric_limits<double>::infinity();
+          for(int64_t i = m_Windows[w].begin; i < m_Windows[w].end; i++)
+          {
+            double value = static_cast<double>(rowValues[i]);
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+          }
+          m_Minimum[row * nx + w] = minimum;
+          m_Maximum[row * nx + w] = maximum;
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    const T* m_Values = nullptr;
+    Dimensions m_Dims;
+    const std::vector<Window>& m_Windows;
+    std::vector<double>& m_Minimum;
+    std::vector<double>& m_Maximum;
+  };
+
+  /**
+   * @brief The ReduceAxisImpl class implements a threaded algorithm that finds the minimum and maximum of partially
+   * reduced values over the windows of the next axis, for a range of output lines. The input holds `length` lines
+   * of `lineSize` values per outer index and the output holds windows.size() lines per outer index.
+   */
+  class ReduceAxisImpl
+  {
+  public:
+    ReduceAxisImpl(const std::vector<double>& inMinimum, const std::vector<double>& inMaximum, size_t lineSize, int64_t length, const std::vector<Window>& windows,
+                   std::vector<double>& outMinimum, std::vector<double>& outMaximum)
+    : m_InMinimum(inMinimum)
+    , m_InMaximum(inMaximum)
+    , m_LineSize(lineSize)
+    , m_Length(static_cast<size_t>(length))
+    , m_Windows(windows)
+    , m_OutMinimum(outMinimum)
+    , m_OutMaximum(outMaximum)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t line = start; line < end; line++)
+      {
+        size_t outer = line / m_Windows.size();
+        const Window& window = m_Windows[line % m_Windows.size()];
+        double* outMinimum = m_OutMinimum.data() + line * m_LineSize;
+        double* outMaximum = m_OutMaximum.data() + line * m_LineSize;
+        std::fill(outMinimum, outMinimum + m_LineSize, std::numeric_limits<double>::infinity());
+        std::fill(outMaximum, outMaximum + m_LineSize, -std::numeric_limits<double>::infinity());
+        for(int64_t in = window.begin; in < window.end; in++)
+        {
+          const double* inMinimum = m_InMinimum.data() + (outer * m_Length + static_cast<size_t>(in)) * m_LineSize;
+          const double* inMaximum = m_InMaximum.data() + (outer * m_Length + static_cast<size_t>(in)) * m_LineSize;
+          for(size_t i = 0; i < m_LineSize; i++)
+          {
+            outMinimum[i] = std::min(outMinimum[i], inMinimum[i]);
+            outMaximum[i] = std::max(outMaximum[i], inMaximum[i]);
+          }
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    const std::vector<double>& m_InMinimum;
+    const std::vector<double>& m_InMaximum;
+    size_t m_LineSize = 0;
+    size_t m_Length = 0;
+    const std::vector<Window>& m_Windows;
+    std::vector<double>& m_OutMinimum;
+    std::vector<double>& m_OutMaximum;
+  };
+};
@@ -0,0 +1,335 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The PlaneCrossSections class finds, for every feature, the plane of an image that holds the most cells of
+ * that feature. The planes of each requested orientation are split into contiguous blocks, and the blocks of all
+ * orientations are swept concurrently in a single parallel pass. Each block counts the cells of one plane at a time
+ * with a sparse counter: only the features that were seen on the plane are compared and reset afterwards, so a
+ * plane costs the number of its cells instead of the number of features. The block maxima are merged in plane
+ * order, so ties go to the lowest plane index no matter how the blocks were scheduled.
+ */
+class PlaneCrossSections
+{
+public:
+  /**
+   * @brief The Orientation enum names the planes by the two axes they span, in the order of the "Plane of Interest"
+   * choices of FindLargestCrossSections.
+   */
+  enum class Orientation : uint32_t
+  {
+    XY = 0,
+    XZ = 1,
+    YZ = 2
+  };
+
+  using Dimensions = std::array<size_t, 3>;
+
+  /**
+   * @brief The Result struct holds the largest cross section of every feature for one orientation
+   */
+  struct Result
+  {
+    // Number of cells of the feature on its largest plane, 0 for features without cells
+    std::vector<size_t> counts;
+    // Index of that plane along the axis normal to the planes, -1 for features without cells
+    std::vector<int64_t> planes;
+  };
+
+  /**
+   * @brief Find Finds the largest cross section of every feature for each of the given orientations. Cells whose
+   * feature id is outside [0, numFeatures) are ignored.
+   * @param featureIds Feature id of each cell in x fastest order
+   * @param dims Dimensions of the image
+   * @param numFeatures
+   * @param orientations Orientations to find the cross sections for
+   * @return One result per orientation, in the order of the orientations
+   */
+  static std::vector<Result> Find(const int32_t* featureIds, const Dimensions& dims, size_t numFeatures, const std::vector<Orientation>& orientations)
+  {
+    // Every block keeps its own maxima, so the number of blocks is bounded by a memory budget as well
+    size_t numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    size_t byMemory = std::max<size_t>(k_MaxBlockValues / std::max<size_t>(numFeatures * orientations.size(), 1), 1);
+
+    std::vector<Block> blocks;
+    for(size_t o = 0; o < orientations.size(); o++)
+    {
+      size_t numPlanes = dims[NormalAxis(orientations[o])];
+      size_t numBlocks = std::max<size_t>(std::min({numThreads, byMemory, numPlanes}), 1);
+      for(size_t b = 0; b < numBlocks; b++)
+      {
+        Block block;
+        block.orientation = o;
+        block.firstPlane = numPlanes * b / numBlocks;
+        block.lastPlane = numPlanes * (b + 1) / numBlocks;
+        blocks.push_back(block);
+      }
+    }
+
+    std::vector<size_t> blockCounts(blocks.size() * numFeatures, 0);
+    std::vector<int64_t> blockPlanes(blocks.size() * numFeatures, -1);
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, blocks.size());
+      dataAlg.execute(SweepPlanesImpl(featureIds, dims, numFeatures, orientations, blocks, blockCounts, blockPlanes));
+    }
+
+    std::vector<Result> results(orientations.size());
+    for(Result& result : results)
+    {
+      result.counts.assign(numFeatures, 0);
+      result.planes.assign(numFeatures, -1);
+    }
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numFeatures);
+      dataAlg.execute(MergeBlocksImpl(numFeatures, blocks, blockCounts, blockPlanes, results));
+    }
+    return results;
+  }
+
+  /**
+   * @brief NormalAxis Returns the axis (0 = x, 1 = y, 2 = z) along which the planes of an orientation are stacked
+   * @param orientation
+   * @return
+   */
+  static size_t NormalAxis(Orientation orientation)
+  {
+    switch(orientation)
+    {
+    case Orientation::XY:
+      return 2;
+    case Orientation::XZ:
+      return 1;
+    case Orientation::YZ:
+      return 0;
+    }
+    return 2;
+  }
+
+protected:
+  PlaneCrossSections() = default;
+
+public:
+  PlaneCrossSections(const PlaneCrossSections&) = delete;            // Copy Constructor Not Implemented
+  PlaneCrossSections(PlaneCrossSections&&) = delete;                 // Move Constructor Not Implemented
+  PlaneCrossSections& operator=(const PlaneCrossSections&) = delete; // Copy Assignment Not Implemented
+  PlaneCrossSections& operator=(PlaneCrossSections&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  // Upper bound on the number of per block maxima of all blocks together
+  static constexpr size_t k_MaxBlockValues = size_t(1) << 24;
+
+  /**
+   * @brief The Block struct is a contiguous range [firstPlane, lastPlane) of planes of one orientation
+   */
+  struct Block
+  {
+    size_t orientation = 0;
+    size_t firstPlane = 0;
+    size_t lastPlane = 0;
+  };
+
+  /**
+   * @brief The SweepPlanesImpl class implements a threaded algorithm that counts the cells of every feature on each
+   * plane of a block and keeps the largest count of each feature within the block.
+   */
+  class SweepPlanesImpl
+  {
+  public:
+    SweepPlanesImpl(const int32_t* featureIds, const Dimensions& dims, size_t numFeatures, const std::vector<Orientation>& orientations, const std::vector<Block>& blocks,
+                    std::vector<size_t>& blockCounts, std::vector<int64_t>& blockPlanes)
+    : m_FeatureIds(featureIds)
+    , m_Dims(dims)
+    , m_NumFeatures(numFeatures)
+    , m_Orientations(orientations)
+    , m_Blocks(blocks)
+    , m_BlockCounts(blockCounts)
+    , m_BlockPlanes(blockPlanes)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      // The counter is zeroed once per call; after that only the features seen on a plane are reset
+      std::vector<size_t> counter(m_NumFeatures, 0);
+      std::vector<int32_t> seen;
+
+      for(size_t b = start; b < end; b++)
+      {
+        const Block& block = m_Blocks[b];
+        size_t* counts = m_BlockCounts.data() + b * m_NumFeatures;
+        int64_t* planes = m_BlockPlanes.data() + b * m_NumFeatures;
+        for(size_t plane = block.firstPlane; plane < block.lastPlane; plane++)
+        {
+          countPlane(m_Orientations[block.orientation], plane, counter, seen);
+          for(int32_t featureId : seen)
+          {
+            if(counter[featureId] > counts[featureId])
+            {
+              counts[featureId] = counter[featureId];
+              planes[featureId] = static_cast<int64_t>(plane);
+            }
+            counter[featureId] = 0;
+          }
+          seen.clear();
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    const int32_t* m_FeatureIds = nullptr;
+    Dimensions m_Dims;
+    size_t m_NumFeatures = 0;
+    const std::vector<Orientation>& m_Orientations;
+    const std::vector<Block>& m_Blocks;
+    std::vector<size_t>& m_BlockCounts;
+    std::vector<int64_t>& m_BlockPlanes;
+
+    void countCell(size_t index, std::vector<size_t>& counter, std::vector<int32_t>& seen) const
+    {
+      int32_t featureId = m_FeatureIds[index];
+      if(featureId < 0 || static_cast<size_t>(featureId) >= m_NumFeatures)
+      {
+        return;
+      }
+      if(counter[featureId]++ == 0)
+      {
+        seen.push_back(featureId);
+      }
+    }
+
+    void countPlane(Orientation orientation, size_t plane, std::vector<size_t>& counter, std::vector<int32_t>& seen) const
+    {
+      size_t xDim = m_Dims[0];
+      size_t yDim = m_Dims[1];
+      size_t zDim = m_Dims[2];
+      // The cells of each plane are visited in memory order
+      switch(orientation)
+      {
+      case Orientation::XY:
+        for(size_t index = plane * xDim * yDim; index < (plane + 1) * xDim * yDim; index++)
+        {
+          countCell(index, counter, seen);
+        }
+        break;
+      case Orientation::XZ:
+        for(size_t z = 0; z < zDim; z++)
+        {
+          size_t row = (z * yDim + plane) * xDim;
+          for(size_t x = 0; x < xDim; x++)
+          {
+            countCell(row + x, counter, seen);
+          }
+        }
+        break;
+      case Orientation::YZ:
+        for(size_t z = 0; z < zDim; z++)
+        {
+          for(size_t y = 0; y < yDim; y++)
+          {
+            countCell((z * yDim + y) * xDim + plane, counter, seen);
+          }
+        }
+        break;
+      }
+    }
+  };
+
+  /**
+   * @brief The MergeBlocksImpl class implements a threaded algorithm that merges the maxima of the blocks of each
+   * orientation, one range of features at a time.
+   */
+  class MergeBlocksImpl
+  {
+  public:
+    MergeBlocksImpl(size_t numFeatures, const std::vector<Block>& blocks, const std::vector<size_t>& blockCounts, const std::vector<int64_t>& blockPlanes, std::vector<Result>& results)
+    : m_NumFeatures(numFeatures)
+    , m_Blocks(blocks)
+    , m_BlockCounts(blockCounts)
+    , m_BlockPlanes(blockPlanes)
+    , m_Results(results)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      // The blocks of an orientation are stored in plane order, so keeping the first largest count keeps the lowest
+      // plane index
+      for(size_t b = 0; b < m_Blocks.size(); b++)
+      {
+        Result& result = m_Results[m_Blocks[b].orientation];
+        const size_t* counts = m_BlockCounts.data() + b * m_NumFeatures;
+        const int64_t* planes = m_BlockPlanes.data() + b * m_NumFeatures;
+        for(size_t f = start; f < end; f++)
+        {
+          if(counts[f] > result.counts[f])
+          {
+            result.counts[f] = counts[f];
+            result.planes[f] = planes[f];
+          }
+        }
+      }
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      convert(range.min(), range.max());
+    }
+
+  private:
+    size_t m_NumFeatures = 0;
+    const std::vector<Block>& m_Blocks;
+    const std::vector<size_t>& m_BlockCounts;
+    const std::vector<int64_t>& m_BlockPlanes;
+    std::vector<Result>& m_Results;
+  };
+};
@@ -58,6 +58,13 @@ static const QString Duration_Name("Faithful Duration");
 static const QString WaitTime_Name("Faithful Wait Time");
 static const QString DurationHistogram_Name("Duration Histogram");
 static const QString WaitTimeHistogram_Name("Wait Time Histogram");
+static const QString Feature_AMName("Feature Data");
+static const QString Percentiles_AMName("Percentiles");
+static const QString A_Name("A");
+static const QString B_Name("B");
+static const QString Mask_Name("Mask");
+static const QString FeatureIds_Name("FeatureIds");
+static const QString Histogram_Name("Histogram");
 
 static const int Faithful_Rows = 272;
 static const int Faithful_Cols = 3;
@@ -262,6 +269,205 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createHistogramFilter(const DataContainerArray::Pointer& dca, Observer& obs)
+  {
+    QString filtName = "CalculateArrayHistogram";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+    filter->connect(filter.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), &obs, SLOT(processPipelineMessage(const AbstractMessage::Pointer&)));
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds 12 cells with two integer arrays: A holds i and B holds 2 * i for cell i. Cells 3 and 7 are masked
+  // out and cell i belongs to feature i % 3 of a feature attribute matrix with 3 tuples.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createMaskedFeatureData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(DCName);
+
+    std::vector<size_t> tDims(1, 12);
+    std::vector<size_t> cDims(1, 1);
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, Data_AMName, AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer a = Int32ArrayType::CreateArray(tDims, cDims, A_Name, true);
+    Int32ArrayType::Pointer b = Int32ArrayType::CreateArray(tDims, cDims, B_Name, true);
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(tDims, cDims, Mask_Name, true);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, FeatureIds_Name, true);
+    for(size_t i = 0; i < tDims[0]; i++)
+    {
+      a->setValue(i, static_cast<int32_t>(i));
+      b->setValue(i, static_cast<int32_t>(2 * i));
+      mask->setValue(i, i != 3 && i != 7);
+      featureIds->setValue(i, static_cast<int32_t>(i % 3));
+    }
+    am->insertOrAssign(a);
+    am->insertOrAssign(b);
+    am->insertOrAssign(mask);
+    am->insertOrAssign(featureIds);
+    dc->addOrReplaceAttributeMatrix(am);
+
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({3}, Feature_AMName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+    dca->addOrReplaceDataContainer(dc);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Histograms A and B of createMaskedFeatureData into 4 bins of width 6 over [0, 24) with the mask, the per
+  // feature histograms and the percentiles turned on
+  // -----------------------------------------------------------------------------
+  void TestMaskFeaturesAndPercentiles()
+  {
+    Observer obs;
+    DataContainerArray::Pointer dca = createMaskedFeatureData();
+    AbstractFilter::Pointer filter = createHistogramFilter(dca, obs);
+
+    QVariant var;
+    bool propWasSet;
+
+    var.setValue(DataArrayPath(DCName, Data_AMName, A_Name));
+    propWasSet = filter->setProperty("SelectedArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPathVec{DataArrayPath(DCName, Data_AMName, B_Name)});
+    propWasSet = filter->setProperty("AdditionalArrayPaths", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(4);
+    propWasSet = filter->setProperty("NumberOfBins", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(true);
+    propWasSet = filter->setProperty("UserDefinedRange", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(0.0);
+    propWasSet = filter->setProperty("MinRange", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(24.0);
+    propWasSet = filter->setProperty("MaxRange", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(false);
+    propWasSet = filter->setProperty("NewDataContainer", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(Hist_AMName);
+    propWasSet = filter->setProperty("NewAttributeMatrixName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(Histogram_Name);
+    propWasSet = filter->setProperty("NewDataArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(true);
+    propWasSet = filter->setProperty("UseMask", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(DCName, Data_AMName, Mask_Name));
+    propWasSet = filter->setProperty("MaskArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(true);
+    propWasSet = filter->setProperty("UseFeatureIds", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(DCName, Data_AMName, FeatureIds_Name));
+    propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(DCName, Feature_AMName, ""));
+    propWasSet = filter->setProperty("CellFeatureAttributeMatrixPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(true);
+    propWasSet = filter->setProperty("ComputePercentiles", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(QString("10, 50, 100"));
+    propWasSet = filter->setProperty("Percentiles", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(Percentiles_AMName);
+    propWasSet = filter->setProperty("PercentilesAttributeMatrixName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+    // Every value that is not masked out lies in [0, 24)
+    DREAM3D_REQUIRE_EQUAL(filter->getWarningCode(), 0)
+
+    DataContainer::Pointer dc = dca->getDataContainer(DCName);
+    AttributeMatrix::Pointer histAM = dc->getAttributeMatrix(Hist_AMName);
+    AttributeMatrix::Pointer featureAM = dc->getAttributeMatrix(Feature_AMName);
+    AttributeMatrix::Pointer percentilesAM = dc->getAttributeMatrix(Percentiles_AMName);
+    DREAM3D_REQUIRE_VALID_POINTER(histAM.get())
+    DREAM3D_REQUIRE_VALID_POINTER(percentilesAM.get())
+    DREAM3D_REQUIRE_EQUAL(percentilesAM->getNumberOfTuples(), 3)
+
+    // The selected array keeps the plain name and every additional array appends its own name
+    const QString names[2] = {Histogram_Name, Histogram_Name + "_" + B_Name};
+
+    // The unmasked values of A are 0 1 2 4 5 | 6 8 9 10 11 and those of B are 0 2 4 | 8 10 | 12 16 | 18 20 22
+    const double expectedCounts[2][4] = {{5.0, 5.0, 0.0, 0.0}, {3.0, 2.0, 2.0, 3.0}};
+    // Feature 0 holds cells 0 6 9, feature 1 cells 1 4 10 and feature 2 cells 2 5 8 11
+    const int32_t expectedFeatureCounts[2][3][4] = {{{1, 2, 0, 0}, {2, 1, 0, 0}, {2, 2, 0, 0}}, {{1, 0, 1, 1}, {1, 1, 0, 1}, {1, 1, 1, 1}}};
+    // Integer data gives exact percentiles: the smallest value, the 5th of the 10 values and the largest value
+    const double expectedPercentiles[2][3][2] = {{{10.0, 0.0}, {50.0, 5.0}, {100.0, 11.0}}, {{10.0, 0.0}, {50.0, 10.0}, {100.0, 22.0}}};
+
+    for(size_t n = 0; n < 2; n++)
+    {
+      DoubleArrayType::Pointer histogram = histAM->getAttributeArrayAs<DoubleArrayType>(names[n]);
+      DREAM3D_REQUIRE_VALID_POINTER(histogram.get())
+      DREAM3D_REQUIRE_EQUAL(histogram->getNumberOfTuples(), 4)
+      DREAM3D_REQUIRE_EQUAL(histogram->getNumberOfComponents(), 2)
+      for(size_t bin = 0; bin < 4; bin++)
+      {
+        DREAM3D_REQUIRE_EQUAL(histogram->getComponent(bin, 0), 6.0 * (bin + 1))
+        DREAM3D_REQUIRE_EQUAL(histogram->getComponent(bin, 1), expectedCounts[n][bin])
+      }
+
+      Int32ArrayType::Pointer featureHistogram = featureAM->getAttributeArrayAs<Int32ArrayType>(names[n]);
+      DREAM3D_REQUIRE_VALID_POINTER(featureHistogram.get())
+      DREAM3D_REQUIRE_EQUAL(featureHistogram->getNumberOfTuples(), 3)
+      DREAM3D_REQUIRE_EQUAL(featureHistogram->getNumberOfComponents(), 4)
+      for(size_t feature = 0; feature < 3; feature++)
+      {
+        for(size_t bin = 0; bin < 4; bin++)
+        {
+          DREAM3D_REQUIRE_EQUAL(featureHistogram->getComponent(feature, bin), expectedFeatureCounts[n][feature][bin])
+        }
+      }
+
+      DoubleArrayType::Pointer percentiles = percentilesAM->getAttributeArrayAs<DoubleArrayType>(names[n]);
+      DREAM3D_REQUIRE_VALID_POINTER(percentiles.get())
+      DREAM3D_REQUIRE_EQUAL(percentiles->getNumberOfComponents(), 2)
+      for(size_t p = 0; p < 3; p++)
+      {
+        DREAM3D_REQUIRE_EQUAL(percentiles->getComponent(p, 0), expectedPercentiles[n][p][0])
+        DREAM3D_REQUIRE_EQUAL(percentiles->getComponent(p, 1), expectedPercentiles[n][p][1])
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Percentiles outside [0, 100] are rejected before anything is created
+  // -----------------------------------------------------------------------------
+  void TestInvalidPercentiles()
+  {
+    Observer obs;
+    DataContainerArray::Pointer dca = createMaskedFeatureData();
+    AbstractFilter::Pointer filter = createHistogramFilter(dca, obs);
+
+    QVariant var;
+    var.setValue(DataArrayPath(DCName, Data_AMName, A_Name));
+    filter->setProperty("SelectedArrayPath", var);
+    var.setValue(true);
+    filter->setProperty("ComputePercentiles", var);
+    var.setValue(QString("50, 150"));
+    filter->setProperty("Percentiles", var);
+
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -11012)
+    DREAM3D_REQUIRE_EQUAL(dca->getDataContainer(DCName)->doesAttributeMatrixExist(Percentiles_AMName), false)
+  }
+
   /**
    * @brief
    */
@@ -271,6 +477,8 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
     // DREAM3D_REGISTER_TEST( CalculateArrayHistogramTest() )
     DREAM3D_REGISTER_TEST(TestFaithful())
+    DREAM3D_REGISTER_TEST(TestMaskFeaturesAndPercentiles())
+    DREAM3D_REGISTER_TEST(TestInvalidPercentiles())
   }
 
 private:
@@ -0,0 +1,238 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolbox/StatsToolboxFilters/util/HistogramEngine.h"
+
+class HistogramEngineTest
+{
+public:
+  HistogramEngineTest() = default;
+  ~HistogramEngineTest() = default;
+  HistogramEngineTest(const HistogramEngineTest&) = delete;            // Copy Constructor
+  HistogramEngineTest(HistogramEngineTest&&) = delete;                 // Move Constructor
+  HistogramEngineTest& operator=(const HistogramEngineTest&) = delete; // Copy Assignment
+  HistogramEngineTest& operator=(HistogramEngineTest&&) = delete;      // Move Assignment
+
+  const size_t k_NumValues = 200003;
+  const size_t k_NumFeatures = 37;
+  const int32_t k_NumBins = 16;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<float> createValues()
+  {
+    std::mt19937_64 generator(5489);
+    std::normal_distribution<float> distribution(10.0f, 3.0f);
+    std::vector<float> values(k_NumValues);
+    for(float& value : values)
+    {
+      value = distribution(generator);
+    }
+    values[17] = std::nanf("");
+    return values;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRange()
+  {
+    std::vector<float> values = createValues();
+    std::unique_ptr<bool[]> mask(new bool[k_NumValues]);
+    for(size_t i = 0; i < k_NumValues; i++)
+    {
+      mask[i] = (i % 3 != 0);
+    }
+
+    HistogramEngine::Range range = HistogramEngine::FindRange(values.data(), k_NumValues, mask.get());
+    double min = std::numeric_limits<double>::max();
+    double max = -std::numeric_limits<double>::max();
+    size_t count = 0;
+    for(size_t i = 0; i < k_NumValues; i++)
+    {
+      if(mask[i] && !std::isnan(values[i]))
+      {
+        min = std::min(min, static_cast<double>(values[i]));
+        max = std::max(max, static_cast<double>(values[i]));
+        count++;
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(range.min, min)
+    DREAM3D_REQUIRE_EQUAL(range.max, max)
+    DREAM3D_REQUIRE_EQUAL(range.count, count)
+
+    HistogramEngine::Range empty = HistogramEngine::FindRange(values.data(), 0, nullptr);
+    DREAM3D_REQUIRE_EQUAL(empty.count, 0)
+    DREAM3D_REQUIRE(empty.min > empty.max)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCompute()
+  {
+    std::vector<float> values = createValues();
+    std::unique_ptr<bool[]> mask(new bool[k_NumValues]);
+    std::vector<int32_t> featureIds(k_NumValues);
+    for(size_t i = 0; i < k_NumValues; i++)
+    {
+      mask[i] = (i % 5 != 0);
+      // Some values belong to no valid feature
+      featureIds[i] = static_cast<int32_t>(i % (k_NumFeatures + 2)) - 1;
+    }
+
+    float min = 4.0f;
+    float increment = 0.75f;
+    HistogramEngine::Histogram histogram = HistogramEngine::Compute(values.data(), k_NumValues, mask.get(), min, increment, k_NumBins, featureIds.data(), k_NumFeatures, nullptr);
+
+    std::vector<size_t> counts(k_NumBins, 0);
+    std::vector<size_t> featureCounts(k_NumFeatures * k_NumBins, 0);
+    size_t overflow = 0;
+    for(size_t i = 0; i < k_NumValues; i++)
+    {
+      if(!mask[i])
+      {
+        continue;
+      }
+      float offset = (values[i] - min) / increment;
+      if(!(offset >= 0 && offset < k_NumBins))
+      {
+        overflow++;
+        continue;
+      }
+      int32_t bin = static_cast<int32_t>(offset);
+      counts[bin]++;
+      if(featureIds[i] >= 0 && featureIds[i] < static_cast<int32_t>(k_NumFeatures))
+      {
+        featureCounts[featureIds[i] * k_NumBins + bin]++;
+      }
+    }
+    DREAM3D_REQUIRE(histogram.counts == counts)
+    DREAM3D_REQUIRE(histogram.featureCounts == featureCounts)
+    DREAM3D_REQUIRE_EQUAL(histogram.overflow, overflow)
+
+    // A single bin takes every value
+    HistogramEngine::Histogram single = HistogramEngine::Compute(values.data(), k_NumValues, nullptr, min, 100.0f, 1, nullptr, 0, nullptr);
+    DREAM3D_REQUIRE_EQUAL(single.counts[0], k_NumValues)
+    DREAM3D_REQUIRE_EQUAL(single.overflow, 0)
+    DREAM3D_REQUIRE(single.featureCounts.empty())
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestIntegerPercentiles()
+  {
+    std::mt19937_64 generator(5489);
+    std::uniform_int_distribution<int32_t> distribution(0, 4095);
+    std::vector<uint16_t> values(k_NumValues);
+    for(uint16_t& value : values)
+    {
+      value = static_cast<uint16_t>(distribution(generator));
+    }
+
+    HistogramEngine::Range range = HistogramEngine::FindRange(values.data(), k_NumValues, nullptr);
+    HistogramEngine::QuantileSketch sketch(range.min, range.max, true);
+    HistogramEngine::Compute(values.data(), k_NumValues, nullptr, 0.0f, 256.0f, k_NumBins, nullptr, 0, &sketch);
+
+    std::vector<uint16_t> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    for(double percent : {0.0, 1.0, 25.0, 50.0, 75.0, 99.0, 100.0})
+    {
+      size_t rank = std::max(static_cast<size_t>(std::ceil(percent / 100.0 * k_NumValues)), size_t(1));
+      DREAM3D_REQUIRE_EQUAL(sketch.percentile(percent), static_cast<double>(sorted[rank - 1]))
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFloatPercentiles()
+  {
+    std::vector<float> values = createValues();
+    HistogramEngine::Range range = HistogramEngine::FindRange(values.data(), k_NumValues, nullptr);
+    HistogramEngine::QuantileSketch sketch(range.min, range.max, false);
+    HistogramEngine::Compute(values.data(), k_NumValues, nullptr, 0.0f, 1.0f, k_NumBins, nullptr, 0, &sketch);
+
+    std::vector<float> sorted;
+    for(float value : values)
+    {
+      if(!std::isnan(value))
+      {
+        sorted.push_back(value);
+      }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    double tolerance = (range.max - range.min) / static_cast<double>(HistogramEngine::QuantileSketch::MaxBins);
+    for(double percent : {0.0, 5.0, 50.0, 95.0, 100.0})
+    {
+      size_t rank = std::max(static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size())), size_t(1));
+      DREAM3D_REQUIRE(std::abs(sketch.percentile(percent) - sorted[rank - 1]) <= tolerance)
+    }
+
+    HistogramEngine::QuantileSketch emptySketch(0.0, 1.0, false);
+    DREAM3D_REQUIRE(std::isnan(emptySketch.percentile(50.0)))
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "########### HistogramEngineTest ##############" << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestRange())
+    DREAM3D_REGISTER_TEST(TestCompute())
+    DREAM3D_REGISTER_TEST(TestIntegerPercentiles())
+    DREAM3D_REGISTER_TEST(TestFloatPercentiles())
+  }
+};
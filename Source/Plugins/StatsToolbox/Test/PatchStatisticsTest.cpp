@@ -0,0 +1,163 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolbox/StatsToolboxFilters/util/PatchStatistics.h"
+
+class PatchStatisticsTest
+{
+public:
+  PatchStatisticsTest() = default;
+  ~PatchStatisticsTest() = default;
+  PatchStatisticsTest(const PatchStatisticsTest&) = delete;            // Copy Constructor
+  PatchStatisticsTest(PatchStatisticsTest&&) = delete;                 // Move Constructor
+  PatchStatisticsTest& operator=(const PatchStatisticsTest&) = delete; // Copy Assignment
+  PatchStatisticsTest& operator=(PatchStatisticsTest&&) = delete;      // Move Assignment
+
+  const PatchStatistics::Dimensions k_Dims = {{37, 29, 11}};
+
+  // -----------------------------------------------------------------------------
+  // Overlapping windows that are clipped at both ends of the axis, plus an empty one
+  // -----------------------------------------------------------------------------
+  std::vector<PatchStatistics::Window> createWindows(int64_t dim, int64_t step, int64_t size)
+  {
+    std::vector<PatchStatistics::Window> windows;
+    for(int64_t center = 0; center < dim; center += step)
+    {
+      PatchStatistics::Window window;
+      window.begin = std::max<int64_t>(center - size / 2, 0);
+      window.end = std::min<int64_t>(center + size / 2 + 1, dim);
+      windows.push_back(window);
+    }
+    windows.push_back(PatchStatistics::Window());
+    return windows;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPatchStatistics()
+  {
+    std::mt19937_64 generator(5489);
+    std::uniform_int_distribution<int32_t> distribution(1000, 1255);
+    std::vector<uint16_t> values(static_cast<size_t>(k_Dims[0] * k_Dims[1] * k_Dims[2]));
+    for(uint16_t& value : values)
+    {
+      value = static_cast<uint16_t>(distribution(generator));
+    }
+
+    PatchStatistics::Windows windows;
+    windows.x = createWindows(k_Dims[0], 3, 7);
+    windows.y = createWindows(k_Dims[1], 4, 4);
+    windows.z = createWindows(k_Dims[2], 2, 5);
+
+    std::vector<float> mean(windows.count());
+    std::vector<float> variance(windows.count());
+    std::vector<float> minimum(windows.count());
+    std::vector<float> maximum(windows.count());
+    PatchStatistics::MeanAndVariance(values.data(), k_Dims, windows, mean.data(), variance.data());
+    PatchStatistics::Extrema(values.data(), k_Dims, windows, minimum.data(), maximum.data());
+
+    size_t index = 0;
+    for(const PatchStatistics::Window& z : windows.z)
+    {
+      for(const PatchStatistics::Window& y : windows.y)
+      {
+        for(const PatchStatistics::Window& x : windows.x)
+        {
+          double sum = 0.0;
+          double sumSquares = 0.0;
+          double min = std::numeric_limits<double>::max();
+          double max = -std::numeric_limits<double>::max();
+          int64_t count = 0;
+          for(int64_t k = z.begin; k < z.end; k++)
+          {
+            for(int64_t j = y.begin; j < y.end; j++)
+            {
+              for(int64_t i = x.begin; i < x.end; i++)
+              {
+                double value = values[static_cast<size_t>((k * k_Dims[1] + j) * k_Dims[0] + i)];
+                sum += value;
+                sumSquares += value * value;
+                min = std::min(min, value);
+                max = std::max(max, value);
+                count++;
+              }
+            }
+          }
+
+          if(count == 0)
+          {
+            DREAM3D_REQUIRE_EQUAL(mean[index], 0.0f)
+            DREAM3D_REQUIRE_EQUAL(variance[index], 0.0f)
+            DREAM3D_REQUIRE_EQUAL(minimum[index], 0.0f)
+            DREAM3D_REQUIRE_EQUAL(maximum[index], 0.0f)
+          }
+          else
+          {
+            double expectedMean = sum / count;
+            double expectedVariance = sumSquares / count - expectedMean * expectedMean;
+            DREAM3D_REQUIRE(std::abs(mean[index] - expectedMean) < 1.0E-3)
+            DREAM3D_REQUIRE(std::abs(variance[index] - expectedVariance) < 1.0E-2)
+            DREAM3D_REQUIRE_EQUAL(minimum[index], static_cast<float>(min))
+            DREAM3D_REQUIRE_EQUAL(maximum[index], static_cast<float>(max))
+          }
+          index++;
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "########### PatchStatisticsTest ##############" << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestPatchStatistics())
+  }
+};
@@ -0,0 +1,146 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolbox/StatsToolboxFilters/util/PlaneCrossSections.h"
+
+class PlaneCrossSectionsTest
+{
+public:
+  PlaneCrossSectionsTest() = default;
+  ~PlaneCrossSectionsTest() = default;
+  PlaneCrossSectionsTest(const PlaneCrossSectionsTest&) = delete;            // Copy Constructor
+  PlaneCrossSectionsTest(PlaneCrossSectionsTest&&) = delete;                 // Move Constructor
+  PlaneCrossSectionsTest& operator=(const PlaneCrossSectionsTest&) = delete; // Copy Assignment
+  PlaneCrossSectionsTest& operator=(PlaneCrossSectionsTest&&) = delete;      // Move Assignment
+
+  const PlaneCrossSections::Dimensions k_Dims = {{23, 17, 13}};
+  const size_t k_NumFeatures = 40;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPlaneCrossSections()
+  {
+    // Blocky features so that many of them span several planes, plus ids outside [0, numFeatures) that must be
+    // ignored. Feature 39 never occurs.
+    std::mt19937_64 generator(5489);
+    std::uniform_int_distribution<int32_t> distribution(-1, static_cast<int32_t>(k_NumFeatures));
+    std::vector<int32_t> featureIds(k_Dims[0] * k_Dims[1] * k_Dims[2]);
+    for(size_t z = 0; z < k_Dims[2]; z++)
+    {
+      for(size_t y = 0; y < k_Dims[1]; y++)
+      {
+        for(size_t x = 0; x < k_Dims[0]; x++)
+        {
+          size_t index = (z * k_Dims[1] + y) * k_Dims[0] + x;
+          featureIds[index] = static_cast<int32_t>((x / 5 + 5 * (y / 4) + 3 * (z / 3)) % (k_NumFeatures - 1));
+          if(generator() % 7 == 0)
+          {
+            featureIds[index] = distribution(generator);
+            if(featureIds[index] == static_cast<int32_t>(k_NumFeatures - 1))
+            {
+              featureIds[index] = 0;
+            }
+          }
+        }
+      }
+    }
+
+    std::vector<PlaneCrossSections::Orientation> orientations = {PlaneCrossSections::Orientation::XY, PlaneCrossSections::Orientation::XZ, PlaneCrossSections::Orientation::YZ};
+    std::vector<PlaneCrossSections::Result> results = PlaneCrossSections::Find(featureIds.data(), k_Dims, k_NumFeatures, orientations);
+    DREAM3D_REQUIRE_EQUAL(results.size(), orientations.size())
+
+    for(size_t o = 0; o < orientations.size(); o++)
+    {
+      size_t normalAxis = PlaneCrossSections::NormalAxis(orientations[o]);
+      std::vector<size_t> expectedCounts(k_NumFeatures, 0);
+      std::vector<int64_t> expectedPlanes(k_NumFeatures, -1);
+      for(size_t plane = 0; plane < k_Dims[normalAxis]; plane++)
+      {
+        std::vector<size_t> counts(k_NumFeatures, 0);
+        for(size_t index = 0; index < featureIds.size(); index++)
+        {
+          size_t coords[3] = {index % k_Dims[0], (index / k_Dims[0]) % k_Dims[1], index / (k_Dims[0] * k_Dims[1])};
+          if(coords[normalAxis] == plane && featureIds[index] >= 0 && featureIds[index] < static_cast<int32_t>(k_NumFeatures))
+          {
+            counts[featureIds[index]]++;
+          }
+        }
+        for(size_t f = 0; f < k_NumFeatures; f++)
+        {
+          if(counts[f] > expectedCounts[f])
+          {
+            expectedCounts[f] = counts[f];
+            expectedPlanes[f] = static_cast<int64_t>(plane);
+          }
+        }
+      }
+
+      for(size_t f = 0; f < k_NumFeatures; f++)
+      {
+        DREAM3D_REQUIRE_EQUAL(results[o].counts[f], expectedCounts[f])
+        DREAM3D_REQUIRE_EQUAL(results[o].planes[f], expectedPlanes[f])
+      }
+      DREAM3D_REQUIRE_EQUAL(results[o].planes[k_NumFeatures - 1], -1)
+    }
+
+    // A single orientation gives the same result as the combined sweep
+    std::vector<PlaneCrossSections::Result> yz = PlaneCrossSections::Find(featureIds.data(), k_Dims, k_NumFeatures, {PlaneCrossSections::Orientation::YZ});
+    DREAM3D_REQUIRE_EQUAL(yz.size(), 1)
+    DREAM3D_REQUIRE(yz[0].counts == results[2].counts)
+    DREAM3D_REQUIRE(yz[0].planes == results[2].planes)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "########### PlaneCrossSectionsTest ##############" << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestPlaneCrossSections())
+  }
+};
@@ -34,17 +34,21 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "BinaryNodesTrianglesReader.h"
 
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include <QtCore/QFile>
 #include <QtCore/QString>
-#include <QtCore/QtDebug>
-#include <sstream>
 
-#include "SIMPLib/Common/ScopedFileMonitor.hpp"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
 #include "SIMPLib/Geometry/MeshStructs.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "BinaryNodesTrianglesReader.h"
 
@@ -59,6 +63,161 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+/**
+ * @brief The ReadNodesImpl class implements a threaded algorithm that decodes the records of a mapped nodes
+ * file into the vertex list and the node types, counting the records whose node id is out of range. Each node id
+ * is claimed by the first record that reaches it, and the records that find their node id already claimed are
+ * counted as duplicates and do not write a node type. Without a claim list every record writes its node type,
+ * which is only valid on a single thread.
+ */
+class ReadNodesImpl
+{
+public:
+  ReadNodesImpl(const uchar* records, size_t numNodes, float* vertices, int8_t* nodeTypes, std::vector<std::atomic<uint8_t>>* claimed, std::atomic<size_t>& invalidRecords,
+                std::atomic<size_t>& duplicateRecords)
+  : m_Records(records)
+  , m_NumNodes(numNodes)
+  , m_Vertices(vertices)
+  , m_NodeTypes(nodeTypes)
+  , m_Claimed(claimed)
+  , m_InvalidRecords(invalidRecords)
+  , m_DuplicateRecords(duplicateRecords)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    SurfaceMesh::NodesFile::NodesFileRecord_t record;
+    size_t invalid = 0;
+    size_t duplicates = 0;
+    for(size_t i = start; i < end; i++)
+    {
+      // The records are not guaranteed to be aligned within the mapped file
+      std::memcpy(&record, m_Records + i * SurfaceMesh::NodesFile::ByteCount, SurfaceMesh::NodesFile::ByteCount);
+      m_Vertices[i * 3] = record.x;
+      m_Vertices[i * 3 + 1] = record.y;
+      m_Vertices[i * 3 + 2] = record.z;
+      if(record.nodeId < 0 || static_cast<size_t>(record.nodeId) >= m_NumNodes)
+      {
+        invalid++;
+        continue;
+      }
+      if(m_Claimed != nullptr && (*m_Claimed)[record.nodeId].exchange(1) != 0)
+      {
+        duplicates++;
+        continue;
+      }
+      m_NodeTypes[record.nodeId] = static_cast<int8_t>(record.nodeKind);
+    }
+    if(invalid > 0)
+    {
+      m_InvalidRecords += invalid;
+    }
+    if(duplicates > 0)
+    {
+      m_DuplicateRecords += duplicates;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const uchar* m_Records = nullptr;
+  size_t m_NumNodes = 0;
+  float* m_Vertices = nullptr;
+  int8_t* m_NodeTypes = nullptr;
+  std::vector<std::atomic<uint8_t>>* m_Claimed = nullptr;
+  std::atomic<size_t>& m_InvalidRecords;
+  std::atomic<size_t>& m_DuplicateRecords;
+};
+
+/**
+ * @brief The ReadTrianglesImpl class implements a threaded algorithm that decodes the records of a mapped
+ * triangles file into the triangle list and the face labels, counting the records whose triangle id or node
+ * ids are out of range. The triangle ids are claimed the same way as the node ids of @see ReadNodesImpl.
+ */
+class ReadTrianglesImpl
+{
+public:
+  ReadTrianglesImpl(const uchar* records, size_t numTriangles, size_t numNodes, MeshIndexType* triangles, int32_t* faceLabels, std::vector<std::atomic<uint8_t>>* claimed,
+                    std::atomic<size_t>& invalidRecords, std::atomic<size_t>& duplicateRecords)
+  : m_Records(records)
+  , m_NumTriangles(numTriangles)
+  , m_NumNodes(numNodes)
+  , m_Triangles(triangles)
+  , m_FaceLabels(faceLabels)
+  , m_Claimed(claimed)
+  , m_InvalidRecords(invalidRecords)
+  , m_DuplicateRecords(duplicateRecords)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    SurfaceMesh::TrianglesFile::TrianglesFileRecord_t record;
+    size_t invalid = 0;
+    size_t duplicates = 0;
+    for(size_t i = start; i < end; i++)
+    {
+      std::memcpy(&record, m_Records + i * SurfaceMesh::TrianglesFile::ByteCount, SurfaceMesh::TrianglesFile::ByteCount);
+      if(!isValidNode(record.nodeId_0) || !isValidNode(record.nodeId_1) || !isValidNode(record.nodeId_2) || record.triId < 0 || static_cast<size_t>(record.triId) >= m_NumTriangles)
+      {
+        invalid++;
+        continue;
+      }
+      m_Triangles[i * 3] = record.nodeId_0;
+      m_Triangles[i * 3 + 1] = record.nodeId_1;
+      m_Triangles[i * 3 + 2] = record.nodeId_2;
+      if(m_Claimed != nullptr && (*m_Claimed)[record.triId].exchange(1) != 0)
+      {
+        duplicates++;
+        continue;
+      }
+      m_FaceLabels[record.triId * 2] = record.label_0;
+      m_FaceLabels[record.triId * 2 + 1] = record.label_1;
+    }
+    if(invalid > 0)
+    {
+      m_InvalidRecords += invalid;
+    }
+    if(duplicates > 0)
+    {
+      m_DuplicateRecords += duplicates;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const uchar* m_Records = nullptr;
+  size_t m_NumTriangles = 0;
+  size_t m_NumNodes = 0;
+  MeshIndexType* m_Triangles = nullptr;
+  int32_t* m_FaceLabels = nullptr;
+  std::vector<std::atomic<uint8_t>>* m_Claimed = nullptr;
+  std::atomic<size_t>& m_InvalidRecords;
+  std::atomic<size_t>& m_DuplicateRecords;
+
+  // -----------------------------------------------------------------------------
+  bool isValidNode(int32_t nodeId) const
+  {
+    return nodeId >= 0 && static_cast<size_t>(nodeId) < m_NumNodes;
+  }
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -141,10 +300,10 @@ void BinaryNodesTrianglesReader::dataCheck()
     setErrorCondition(-387, ss);
   }
 
-  if(getBinaryNodesFile().isEmpty())
+  if(getBinaryTrianglesFile().isEmpty())
   {
-    QString ss = QObject::tr("%1 needs the Binary Nodes File path set and it was not.").arg(ClassName());
-    setErrorCondition(-387, ss);
+    QString ss = QObject::tr("%1 needs the Binary Triangles File path set and it was not.").arg(ClassName());
+    setErrorCondition(-388, ss);
   }
 
   DataArrayPath tempPath;
@@ -221,60 +380,78 @@ int BinaryNodesTrianglesReader::read()
   AttributeMatrix::Pointer vertAttrMat = sm->getAttributeMatrix(getVertexAttributeMatrixName());
   AttributeMatrix::Pointer faceAttrMat = sm->getAttributeMatrix(getFaceAttributeMatrixName());
 
-  // Open the Nodes file for reading
-  FILE* nodesFile = fopen(m_BinaryNodesFile.toLatin1().data(), "rb+");
-  if(nodesFile == nullptr)
+  // Both files are mapped into memory and the records are decoded in parallel straight into the geometry
+  QFile nodesFile(m_BinaryNodesFile);
+  if(!nodesFile.open(QIODevice::ReadOnly))
   {
     QString ss = QObject::tr("Error opening nodes file '%1'").arg(m_BinaryNodesFile);
     setErrorCondition(-786, ss);
     return getErrorCode();
   }
-  ScopedFileMonitor nodesMonitor(nodesFile);
 
   // Calculate how many nodes are in the file based on the file size
-  fseek(nodesFile, 0, SEEK_END);
-  size_t fLength = ftell(nodesFile);
-  size_t nNodes = fLength / SurfaceMesh::NodesFile::ByteCount;
-  fseek(nodesFile, 0, SEEK_SET);
-  fLength = ftell(nodesFile);
-  if(0 != fLength)
-  {
-    QString ss = QObject::tr("%1: Error Could not rewind to beginning of file after nodes count.'%2'").arg(getNameOfClass()).arg(m_BinaryNodesFile);
-    setErrorCondition(-787, ss);
+  size_t nNodes = static_cast<size_t>(nodesFile.size()) / SurfaceMesh::NodesFile::ByteCount;
+  if(static_cast<size_t>(nodesFile.size()) % SurfaceMesh::NodesFile::ByteCount != 0)
+  {
+    QString ss = QObject::tr("%1: The size of the nodes file '%2' is not a multiple of the %3 byte record size. The file may be truncated.")
+                     .arg(getNameOfClass())
+                     .arg(m_BinaryNodesFile)
+                     .arg(SurfaceMesh::NodesFile::ByteCount);
+    setErrorCondition(-792, ss);
     return getErrorCode();
   }
   {
-    QString ss = QObject::tr("Calc Node Count from Nodes.bin File: ").arg(nNodes);
+    QString ss = QObject::tr("Calc Node Count from Nodes.bin File: %1").arg(nNodes);
     notifyStatusMessage(ss);
   }
-  // Open the triangles file for reading
-  FILE* triFile = fopen(m_BinaryTrianglesFile.toLatin1().data(), "rb+");
-  if(triFile == nullptr)
+
+  QFile triFile(m_BinaryTrianglesFile);
+  if(!triFile.open(QIODevice::ReadOnly))
   {
     QString ss = QObject::tr("%1: Error opening Triangles file '%2'").arg(getNameOfClass()).arg(m_BinaryTrianglesFile);
     setErrorCondition(-788, ss);
     return getErrorCode();
   }
 
-  ScopedFileMonitor trianglesMonitor(triFile);
   // Calculate how many Triangles are in the file based in the file size
-  fseek(triFile, 0, SEEK_END);
-  fLength = ftell(triFile);
-  size_t nTriangles = fLength / SurfaceMesh::TrianglesFile::ByteCount;
-  fseek(triFile, 0, SEEK_SET);
-  fLength = ftell(triFile);
-  if(0 != fLength)
-  {
-    QString ss = QObject::tr("%1: Error Could not rewind to beginning of file after triangles count.'%2'").arg(getNameOfClass()).arg(m_BinaryTrianglesFile);
-    setErrorCondition(-789, ss);
+  size_t nTriangles = static_cast<size_t>(triFile.size()) / SurfaceMesh::TrianglesFile::ByteCount;
+  if(static_cast<size_t>(triFile.size()) % SurfaceMesh::TrianglesFile::ByteCount != 0)
+  {
+    QString ss = QObject::tr("%1: The size of the Triangles file '%2' is not a multiple of the %3 byte record size. The file may be truncated.")
+                     .arg(getNameOfClass())
+                     .arg(m_BinaryTrianglesFile)
+                     .arg(SurfaceMesh::TrianglesFile::ByteCount);
+    setErrorCondition(-793, ss);
     return getErrorCode();
   }
-
   {
     QString ss = QObject::tr("Calc Triangle Count from Triangles.bin File: %1").arg(nTriangles);
     notifyStatusMessage(ss);
   }
 
+  const uchar* nodeRecords = nullptr;
+  if(nNodes > 0)
+  {
+    nodeRecords = nodesFile.map(0, static_cast<qint64>(nNodes * SurfaceMesh::NodesFile::ByteCount));
+    if(nodeRecords == nullptr)
+    {
+      QString ss = QObject::tr("%1: Error mapping nodes file '%2' into memory: %3").arg(getNameOfClass()).arg(m_BinaryNodesFile).arg(nodesFile.errorString());
+      setErrorCondition(-787, ss);
+      return getErrorCode();
+    }
+  }
+  const uchar* triangleRecords = nullptr;
+  if(nTriangles > 0)
+  {
+    triangleRecords = triFile.map(0, static_cast<qint64>(nTriangles * SurfaceMesh::TrianglesFile::ByteCount));
+    if(triangleRecords == nullptr)
+    {
+      QString ss = QObject::tr("%1: Error mapping Triangles file '%2' into memory: %3").arg(getNameOfClass()).arg(m_BinaryTrianglesFile).arg(triFile.errorString());
+      setErrorCondition(-789, ss);
+      return getErrorCode();
+    }
+  }
+
   // Allocate all the nodes
   triangleGeom->resizeVertexList(nNodes);
   float* m_NodeList = triangleGeom->getVertexPointer(0);
@@ -286,20 +463,27 @@ int BinaryNodesTrianglesReader::read()
     QString ss = QObject::tr("Reading Nodes file into Memory");
     notifyStatusMessage(ss);
   }
-  size_t nread = 0;
-  SurfaceMesh::NodesFile::NodesFileRecord_t nRecord;
 
-  for(size_t i = 0; i < nNodes; i++)
+  std::atomic<size_t> invalidNodes(0);
+  std::atomic<size_t> duplicateNodes(0);
   {
-    nread = fread(&nRecord, SurfaceMesh::NodesFile::ByteCount, 1, nodesFile); // Read one set of positions from the nodes file
-    if(nread != 1)
-    {
-      break;
-    }
-    m_NodeList[i * 3] = nRecord.x;
-    m_NodeList[i * 3 + 1] = nRecord.y;
-    m_NodeList[i * 3 + 2] = nRecord.z;
-    m_SurfaceMeshNodeTypes[nRecord.nodeId] = nRecord.nodeKind;
+    std::vector<std::atomic<uint8_t>> claimed(nNodes);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, nNodes);
+    dataAlg.execute(ReadNodesImpl(nodeRecords, nNodes, m_NodeList, m_SurfaceMeshNodeTypes, &claimed, invalidNodes, duplicateNodes));
+  }
+  if(invalidNodes > 0)
+  {
+    QString ss = QObject::tr("%1: %2 records of the nodes file '%3' have a node id outside of [0, %4)").arg(getNameOfClass()).arg(invalidNodes.load()).arg(m_BinaryNodesFile).arg(nNodes);
+    setErrorCondition(-790, ss);
+    return getErrorCode();
+  }
+  if(duplicateNodes > 0)
+  {
+    // Decode the node types again in file order so that the last record of each node id wins, as it does when
+    // the file is read sequentially
+    std::atomic<size_t> ignored(0);
+    ReadNodesImpl(nodeRecords, nNodes, m_NodeList, m_SurfaceMeshNodeTypes, nullptr, ignored, ignored).convert(0, nNodes);
   }
 
   {
@@ -309,30 +493,54 @@ int BinaryNodesTrianglesReader::read()
 
   // Allocate all the Triangle Objects
   triangleGeom->resizeTriList(nTriangles);
-  triangleGeom->getTriangles()->initializeWithValue(0xABABABABABABABAB);
   MeshIndexType* m_TriangleList = triangleGeom->getTriPointer(0);
 
   tDims[0] = nTriangles;
   faceAttrMat->resizeAttributeArrays(tDims);
   updateFaceInstancePointers();
 
-  SurfaceMesh::TrianglesFile::TrianglesFileRecord_t tRecord;
-  for(size_t i = 0; i < nTriangles; i++)
+  std::atomic<size_t> invalidTriangles(0);
+  std::atomic<size_t> duplicateTriangles(0);
   {
-    // Read from the Input Triangles Temp File
-    nread = fread(&tRecord, SurfaceMesh::TrianglesFile::ByteCount, 1, triFile);
-    if(nread != 1)
-    {
-      break;
-    }
-    m_TriangleList[i * 3] = tRecord.nodeId_0;
-    m_TriangleList[i * 3 + 1] = tRecord.nodeId_1;
-    m_TriangleList[i * 3 + 2] = tRecord.nodeId_2;
-    m_FaceLabels[tRecord.triId * 2] = tRecord.label_0;
-    m_FaceLabels[tRecord.triId * 2 + 1] = tRecord.label_1;
+    std::vector<std::atomic<uint8_t>> claimed(nTriangles);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, nTriangles);
+    dataAlg.execute(ReadTrianglesImpl(triangleRecords, nTriangles, nNodes, m_TriangleList, m_FaceLabels, &claimed, invalidTriangles, duplicateTriangles));
+  }
+  if(invalidTriangles > 0)
+  {
+    QString ss = QObject::tr("%1: %2 records of the Triangles file '%3' have a triangle id outside of [0, %4) or a node id outside of [0, %5)")
+                     .arg(getNameOfClass())
+                     .arg(invalidTriangles.load())
+                     .arg(m_BinaryTrianglesFile)
+                     .arg(nTriangles)
+                     .arg(nNodes);
+    setErrorCondition(-791, ss);
+    return getErrorCode();
+  }
+  if(duplicateTriangles > 0)
+  {
+    // As for the nodes, the last record of each triangle id sets its face labels
+    std::atomic<size_t> ignored(0);
+    ReadTrianglesImpl(triangleRecords, nTriangles, nNodes, m_TriangleList, m_FaceLabels, nullptr, ignored, ignored).convert(0, nTriangles);
+    QString ss = QObject::tr("%1: %2 records of the Triangles file '%3' repeat a triangle id. The last record of each triangle id sets its face labels.")
+                     .arg(getNameOfClass())
+                     .arg(duplicateTriangles.load())
+                     .arg(m_BinaryTrianglesFile);
+    setWarningCondition(-795, ss);
+  }
+
+  // Updating the instance pointers clears the warnings, so the duplicate node ids are reported last
+  if(duplicateNodes > 0)
+  {
+    QString ss = QObject::tr("%1: %2 records of the nodes file '%3' repeat a node id. The last record of each node id sets its node type.")
+                     .arg(getNameOfClass())
+                     .arg(duplicateNodes.load())
+                     .arg(m_BinaryNodesFile);
+    setWarningCondition(-794, ss);
   }
 
-  // The ScopedFileMonitor classes will take care of closing the files
+  // The QFile destructors will unmap and close the files
 
   return getErrorCode();
 }
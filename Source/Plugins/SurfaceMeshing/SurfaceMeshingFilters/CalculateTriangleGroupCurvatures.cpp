@@ -35,27 +35,100 @@
 
 #include "CalculateTriangleGroupCurvatures.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/task.h>
-#include <tbb/task_group.h>
-#endif
-
-#include <Eigen/Dense>
+#include <algorithm>
 
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/MatrixMath.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The FindRingNeighborsImpl class implements a threaded algorithm that finds, for each triangle, the
+ * other triangles that share one of its vertices and lie on the same feature face. The first pass only
+ * counts the neighbors so the compressed rows can be allocated; the second pass writes them.
+ */
+class FindRingNeighborsImpl
+{
+public:
+  FindRingNeighborsImpl(const MeshIndexType* triangles, const int32_t* faceLabels, const int32_t* featureFaceIds, const std::vector<int64_t>& vertexOffsets,
+                        const std::vector<int64_t>& vertexTriangles, std::vector<int64_t>& neighborOffsets, int64_t* neighbors)
+  : m_Triangles(triangles)
+  , m_FaceLabels(faceLabels)
+  , m_FeatureFaceIds(featureFaceIds)
+  , m_VertexOffsets(vertexOffsets)
+  , m_VertexTriangles(vertexTriangles)
+  , m_NeighborOffsets(neighborOffsets)
+  , m_Neighbors(neighbors)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<int64_t> candidates;
+    for(size_t t = start; t < end; t++)
+    {
+      int32_t label0 = m_FaceLabels[t * 2];
+      int32_t label1 = m_FaceLabels[t * 2 + 1];
+      candidates.clear();
+      for(size_t k = 0; k < 3; k++)
+      {
+        MeshIndexType vert = m_Triangles[t * 3 + k];
+        for(int64_t v = m_VertexOffsets[vert]; v < m_VertexOffsets[vert + 1]; v++)
+        {
+          int64_t tid = m_VertexTriangles[v];
+          if(tid == static_cast<int64_t>(t) || m_FeatureFaceIds[tid] != m_FeatureFaceIds[t])
+          {
+            continue;
+          }
+          bool check0 = m_FaceLabels[tid * 2] == label0 && m_FaceLabels[tid * 2 + 1] == label1;
+          bool check1 = m_FaceLabels[tid * 2 + 1] == label0 && m_FaceLabels[tid * 2] == label1;
+          if(check0 || check1)
+          {
+            candidates.push_back(tid);
+          }
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+      if(nullptr == m_Neighbors)
+      {
+        m_NeighborOffsets[t + 1] = static_cast<int64_t>(candidates.size());
+      }
+      else
+      {
+        std::copy(candidates.begin(), candidates.end(), m_Neighbors + m_NeighborOffsets[t]);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const MeshIndexType* m_Triangles = nullptr;
+  const int32_t* m_FaceLabels = nullptr;
+  const int32_t* m_FeatureFaceIds = nullptr;
+  const std::vector<int64_t>& m_VertexOffsets;
+  const std::vector<int64_t>& m_VertexTriangles;
+  std::vector<int64_t>& m_NeighborOffsets;
+  int64_t* m_Neighbors = nullptr;
+};
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring, std::vector<int64_t> triangleIds, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1,
-                                                                   DoubleArrayType::Pointer principleCurvature2, DoubleArrayType::Pointer principleDirection1,
-                                                                   DoubleArrayType::Pointer principleDirection2, DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature,
-                                                                   TriangleGeom::Pointer trianglesGeom, DataArray<int32_t>::Pointer surfaceMeshFaceLabels,
+CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring, const TriangleRingAdjacency& adjacency, const std::vector<TriangleChunk_t>& chunks, std::atomic<size_t>& nextChunk,
+                                                                   bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1, DoubleArrayType::Pointer principleCurvature2,
+                                                                   DoubleArrayType::Pointer principleDirection1, DoubleArrayType::Pointer principleDirection2,
+                                                                   DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature,
                                                                    DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids, AbstractFilter* parent)
 : m_NRing(nring)
-, m_TriangleIds(triangleIds)
+, m_Adjacency(adjacency)
+, m_Chunks(chunks)
+, m_NextChunk(nextChunk)
 , m_UseNormalsForCurveFitting(useNormalsForCurveFitting)
 , m_PrincipleCurvature1(principleCurvature1)
 , m_PrincipleCurvature2(principleCurvature2)
@@ -63,8 +136,6 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
 , m_PrincipleDirection2(principleDirection2)
 , m_GaussianCurvature(gaussianCurvature)
 , m_MeanCurvature(meanCurvature)
-, m_TrianglesPtr(trianglesGeom)
-, m_SurfaceMeshFaceLabels(surfaceMeshFaceLabels)
 , m_SurfaceMeshFaceNormals(surfaceMeshFaceNormals)
 , m_SurfaceMeshTriangleCentroids(surfaceMeshTriangleCentroids)
 , m_ParentFilter(parent)
@@ -78,230 +149,274 @@ CalculateTriangleGroupCurvatures::~CalculateTriangleGroupCurvatures() = default;
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void subtractVector3d(DataArray<double>::Pointer data, double* v)
+void CalculateTriangleGroupCurvatures::BuildAdjacency(const TriangleGeom::Pointer& triangleGeom, const int32_t* faceLabels, const int32_t* featureFaceIds, size_t numFeatureFaces,
+                                                      TriangleRingAdjacency& adjacency)
 {
-  size_t count = data->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
+  MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+  size_t numTriangles = triangleGeom->getNumberOfTris();
+  size_t numVertices = triangleGeom->getNumberOfVertices();
+
+  // Group the triangles by feature face Id. The counting sort keeps the triangles of each group in increasing Id order
+  adjacency.groupOffsets.assign(numFeatureFaces + 1, 0);
+  for(size_t t = 0; t < numTriangles; t++)
   {
-    double* ptr = data->getPointer(i * 3);
-    ptr[0] = ptr[0] - v[0];
-    ptr[1] = ptr[1] - v[1];
-    ptr[2] = ptr[2] - v[2];
+    adjacency.groupOffsets[featureFaceIds[t] + 1]++;
   }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void CalculateTriangleGroupCurvatures::operator()() const
-{
-  int32_t err = 0;
-
-  if(m_TriangleIds.size() == 0)
+  adjacency.maxGroupSize = 0;
+  for(size_t f = 0; f < numFeatureFaces; f++)
   {
-    return;
+    adjacency.maxGroupSize = std::max(adjacency.maxGroupSize, adjacency.groupOffsets[f + 1]);
+    adjacency.groupOffsets[f + 1] += adjacency.groupOffsets[f];
+  }
+  adjacency.groupTriangles.resize(numTriangles);
+  adjacency.localIndex.resize(numTriangles);
+  std::vector<int64_t> cursor(adjacency.groupOffsets.begin(), adjacency.groupOffsets.end() - 1);
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    int32_t featureFaceId = featureFaceIds[t];
+    int64_t position = cursor[featureFaceId]++;
+    adjacency.groupTriangles[position] = static_cast<int64_t>(t);
+    adjacency.localIndex[t] = position - adjacency.groupOffsets[featureFaceId];
   }
 
-  // Instantiate a FindNRingNeighbors class to use during the loop
-  FindNRingNeighbors::Pointer nRingNeighborAlg = FindNRingNeighbors::New();
-
-  int32_t* faceLabels = m_SurfaceMeshFaceLabels->getPointer(0);
-
-  int32_t* fl = faceLabels + m_TriangleIds[0] * 2;
-  int32_t feature0 = 0;
-  int32_t feature1 = 0;
-  if(fl[0] < fl[1])
+  // Vertex to triangle connectivity
+  std::vector<int64_t> vertexOffsets(numVertices + 1, 0);
+  for(size_t i = 0; i < numTriangles * 3; i++)
   {
-    feature0 = fl[0];
-    feature1 = fl[1];
+    vertexOffsets[triangles[i] + 1]++;
   }
-  else
+  for(size_t v = 0; v < numVertices; v++)
   {
-    feature0 = fl[1];
-    feature1 = fl[0];
+    vertexOffsets[v + 1] += vertexOffsets[v];
   }
+  std::vector<int64_t> vertexTriangles(static_cast<size_t>(vertexOffsets[numVertices]));
+  cursor.assign(vertexOffsets.begin(), vertexOffsets.end() - 1);
+  for(size_t i = 0; i < numTriangles * 3; i++)
+  {
+    vertexTriangles[cursor[triangles[i]]++] = static_cast<int64_t>(i / 3);
+  }
+  std::vector<int64_t>().swap(cursor);
 
-  bool computeGaussian = (m_GaussianCurvature.get() != nullptr);
-  bool computeMean = (m_MeanCurvature.get() != nullptr);
-  bool computeDirection = (m_PrincipleDirection1.get() != nullptr);
+  // Triangle to triangle connectivity, counted first and then filled in
+  adjacency.neighborOffsets.assign(numTriangles + 1, 0);
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numTriangles);
+    dataAlg.execute(FindRingNeighborsImpl(triangles, faceLabels, featureFaceIds, vertexOffsets, vertexTriangles, adjacency.neighborOffsets, nullptr));
+  }
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    adjacency.neighborOffsets[t + 1] += adjacency.neighborOffsets[t];
+  }
+  adjacency.neighbors.resize(static_cast<size_t>(adjacency.neighborOffsets[numTriangles]));
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numTriangles);
+    dataAlg.execute(FindRingNeighborsImpl(triangles, faceLabels, featureFaceIds, vertexOffsets, vertexTriangles, adjacency.neighborOffsets, adjacency.neighbors.data()));
+  }
+}
 
-  std::vector<int64_t>::size_type tCount = m_TriangleIds.size();
-  // For each triangle in the group
-  for(std::vector<int64_t>::size_type i = 0; i < tCount; ++i)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<CalculateTriangleGroupCurvatures::TriangleChunk_t> CalculateTriangleGroupCurvatures::BuildChunks(const TriangleRingAdjacency& adjacency, int64_t chunkSize)
+{
+  std::vector<TriangleChunk_t> chunks;
+  for(size_t f = 0; f + 1 < adjacency.groupOffsets.size(); f++)
   {
-    if(m_ParentFilter->getCancel() == true)
+    for(int64_t begin = adjacency.groupOffsets[f]; begin < adjacency.groupOffsets[f + 1]; begin += chunkSize)
     {
-      return;
+      chunks.emplace_back(begin, std::min(begin + chunkSize, adjacency.groupOffsets[f + 1]));
     }
-    int64_t triId = m_TriangleIds[i];
-    nRingNeighborAlg->setTriangleId(triId);
-    nRingNeighborAlg->setRegionId0(feature0);
-    nRingNeighborAlg->setRegionId1(feature1);
-    nRingNeighborAlg->setRing(m_NRing);
-    err = nRingNeighborAlg->generate(m_TrianglesPtr, faceLabels);
-    Q_ASSERT(err >= 0);
-
-    UniqueFaceIds_t triPatch = nRingNeighborAlg->getNRingTriangles();
-    Q_ASSERT(triPatch.size() > 1);
-
-    DataArray<double>::Pointer patchCentroids = extractPatchData(triId, triPatch, m_SurfaceMeshTriangleCentroids->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Centroids"));
-    DataArray<double>::Pointer patchNormals = extractPatchData(triId, triPatch, m_SurfaceMeshFaceNormals->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Normals"));
-
-    // Translate the patch to the 0,0,0 origin
-    double sub[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    subtractVector3d(patchCentroids, sub);
-
-    double np[3] = {patchNormals->getComponent(0, 0), patchNormals->getComponent(0, 1), patchNormals->getComponent(0, 2)};
-
-    double seedCentroid[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    double firstCentroid[3] = {patchCentroids->getComponent(1, 0), patchCentroids->getComponent(1, 1), patchCentroids->getComponent(1, 2)};
-
-    double temp[3] = {firstCentroid[0] - seedCentroid[0], firstCentroid[1] - seedCentroid[1], firstCentroid[2] - seedCentroid[2]};
-    double vp[3] = {0.0, 0.0, 0.0};
-
-    // Cross Product of np and temp
-    MatrixMath::Normalize3x1(np);
-    MatrixMath::CrossProduct(np, temp, vp);
-    MatrixMath::Normalize3x1(vp);
-
-    // get the third orthogonal vector
-    double up[3] = {0.0, 0.0, 0.0};
-    MatrixMath::CrossProduct(vp, np, up);
+  }
+  return chunks;
+}
 
-    // this constitutes a rotation matrix to a local coordinate system
-    double rot[3][3] = {{up[0], up[1], up[2]}, {vp[0], vp[1], vp[2]}, {np[0], np[1], np[2]}};
-    double out[3] = {0.0, 0.0, 0.0};
-    // Transform all centroids and normals to new coordinate system
-    for(size_t m = 0; m < patchCentroids->getNumberOfTuples(); ++m)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CalculateTriangleGroupCurvatures::operator()() const
+{
+  // Scratch space that is reused for every triangle this worker handles
+  std::vector<uint32_t> stamps(static_cast<size_t>(m_Adjacency.maxGroupSize), 0);
+  std::vector<int64_t> patch;
+  std::vector<double> design;
+  Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr;
+  uint32_t stamp = 0;
+
+  for(size_t chunk = m_NextChunk++; chunk < m_Chunks.size(); chunk = m_NextChunk++)
+  {
+    if(m_ParentFilter->getCancel())
     {
-      ::memcpy(out, patchCentroids->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchCentroids->getPointer(m * 3), out);
-      ::memcpy(patchCentroids->getPointer(m * 3), out, 3 * sizeof(double));
-
-      ::memcpy(out, patchNormals->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchNormals->getPointer(m * 3), out);
-      ::memcpy(patchNormals->getPointer(m * 3), out, 3 * sizeof(double));
-
-      // We rotate the normals now but we dont use them yet. If we start using part 3 of Goldfeathers paper then we
-      // will need the normals.
+      return;
     }
-
+    for(int64_t i = m_Chunks[chunk].first; i < m_Chunks[chunk].second; i++)
     {
-      // Solve the Least Squares fit
-      static const uint32_t NO_NORMALS = 3;
-      static const uint32_t USE_NORMALS = 7;
-      uint32_t cols = NO_NORMALS;
-      if(m_UseNormalsForCurveFitting == true)
+      stamp++;
+      if(stamp == 0)
       {
-        cols = USE_NORMALS;
+        std::fill(stamps.begin(), stamps.end(), 0);
+        stamp = 1;
       }
-      size_t rows = patchCentroids->getNumberOfTuples();
-      Eigen::MatrixXd A(rows, cols);
-      Eigen::VectorXd b(rows);
-      double x = 0.0, y = 0.0, z = 0.0;
-      for(size_t m = 0; m < rows; ++m)
+      findNRingPatch(m_Adjacency.groupTriangles[i], stamps, stamp, patch);
+      if(patch.size() > 1)
       {
-        x = patchCentroids->getComponent(m, 0);
-        y = patchCentroids->getComponent(m, 1);
-        z = patchCentroids->getComponent(m, 2);
-
-        A(m) = 0.5 * x * x;            // 1/2 x^2
-        A(m + rows) = x * y;           // x*y
-        A(m + rows * 2) = 0.5 * y * y; // 1/2 y^2
-        if(m_UseNormalsForCurveFitting == true)
-        {
-          A(m + rows * 3) = x * x * x;
-          A(m + rows * 4) = x * x * y;
-          A(m + rows * 5) = x * y * y;
-          A(m + rows * 6) = y * y * y;
-        }
-        b[m] = z; // The Z Values
-      }
-
-      Eigen::Matrix2d M;
-
-      if(false == m_UseNormalsForCurveFitting)
-      {
-        typedef Eigen::Matrix<double, NO_NORMALS, 1> Vector3d;
-        Vector3d sln1 = A.colPivHouseholderQr().solve(b);
-        // Now that we have the A, B, C constants we can solve the Eigen value/vector problem
-        // to get the principal curvatures and pricipal directions.
-        M << sln1(0), sln1(1), sln1(1), sln1(2);
-      }
-      else
-      {
-        typedef Eigen::Matrix<double, USE_NORMALS, 1> Vector7d;
-        Vector7d sln1 = A.colPivHouseholderQr().solve(b);
-        // Now that we have the A, B, C, D, E, F & G constants we can solve the Eigen value/vector problem
-        // to get the principal curvatures and pricipal directions.
-        M << sln1(0), sln1(1), sln1(1), sln1(2);
+        fitPatch(patch, design, qr);
       }
+    }
+  }
+}
 
-      Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(M);
-      Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::RealVectorType eValues = eig.eigenvalues();
-      Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::MatrixType eVectors = eig.eigenvectors();
-
-      // Kappa1 >= Kappa2
-      double kappa1 = eValues(0) * -1; // Kappa 1
-      double kappa2 = eValues(1) * -1; // kappa 2
-      Q_ASSERT(kappa1 >= kappa2);
-      m_PrincipleCurvature1->setValue(triId, kappa1);
-      m_PrincipleCurvature2->setValue(triId, kappa2);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CalculateTriangleGroupCurvatures::findNRingPatch(int64_t triId, std::vector<uint32_t>& stamps, uint32_t stamp, std::vector<int64_t>& patch) const
+{
+  const int64_t* neighborOffsets = m_Adjacency.neighborOffsets.data();
+  const int64_t* neighbors = m_Adjacency.neighbors.data();
+  const int64_t* localIndex = m_Adjacency.localIndex.data();
 
-      if(computeGaussian == true)
-      {
-        m_GaussianCurvature->setValue(triId, kappa1 * kappa2);
-      }
-      if(computeMean == true)
-      {
-        m_MeanCurvature->setValue(triId, (kappa1 + kappa2) / 2.0);
-      }
+  patch.clear();
+  patch.push_back(triId);
+  stamps[localIndex[triId]] = stamp;
 
-      if(computeDirection == true)
+  // Each ring adds the unvisited neighbors of the triangles that the previous ring added
+  size_t ringBegin = 0;
+  for(int64_t ring = 0; ring < m_NRing; ++ring)
+  {
+    size_t ringEnd = patch.size();
+    for(size_t p = ringBegin; p < ringEnd; p++)
+    {
+      int64_t t = patch[p];
+      for(int64_t n = neighborOffsets[t]; n < neighborOffsets[t + 1]; n++)
       {
-        Eigen::Matrix3d e_rot_T;
-        e_rot_T.row(0) = Eigen::Vector3d(up[0], vp[0], np[0]);
-        e_rot_T.row(1) = Eigen::Vector3d(up[1], vp[1], np[1]);
-        e_rot_T.row(2) = Eigen::Vector3d(up[2], vp[2], np[2]);
-
-        // Rotate our principal directions back into the original coordinate system
-        Eigen::Vector3d dir1(eVectors.col(0)(0), eVectors.col(0)(1), 0.0);
-        dir1 = e_rot_T * dir1;
-        ::memcpy(m_PrincipleDirection1->getPointer(triId * 3), dir1.data(), 3 * sizeof(double));
-
-        Eigen::Vector3d dir2(eVectors.col(1)(0), eVectors.col(1)(1), 0.0);
-        dir2 = e_rot_T * dir2;
-        ::memcpy(m_PrincipleDirection2->getPointer(triId * 3), dir2.data(), 3 * sizeof(double));
+        int64_t tid = neighbors[n];
+        uint32_t& visited = stamps[localIndex[tid]];
+        if(visited != stamp)
+        {
+          visited = stamp;
+          patch.push_back(tid);
+        }
       }
     }
-  } // End Loop over this triangle
+    if(ringEnd == patch.size())
+    {
+      break;
+    }
+    ringBegin = ringEnd;
+  }
+
+  // The seed stays first and the rest of the patch is used in increasing Id order
+  std::sort(patch.begin() + 1, patch.end());
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const
+void CalculateTriangleGroupCurvatures::fitPatch(const std::vector<int64_t>& patch, std::vector<double>& design, Eigen::ColPivHouseholderQR<Eigen::MatrixXd>& qr) const
 {
-  std::vector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer extractedData = DataArray<double>::CreateArray(triPatch.size(), cDims, name, true);
-  // This little chunk makes sure the current seed triangles centroid and normal data appear
-  // first in the returned arrays which makes the next steps a tad easier.
-  int32_t i = 0;
-  extractedData->setComponent(i, 0, data[triId * 3]);
-  extractedData->setComponent(i, 1, data[triId * 3 + 1]);
-  extractedData->setComponent(i, 2, data[triId * 3 + 2]);
-  ++i;
-  triPatch.erase(triId);
-
-  for(UniqueFaceIds_t::iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
+  static constexpr int NO_NORMALS = 3;
+  static constexpr int USE_NORMALS = 7;
+
+  const double* centroids = m_SurfaceMeshTriangleCentroids->getPointer(0);
+  const double* normals = m_SurfaceMeshFaceNormals->getPointer(0);
+  int64_t triId = patch[0];
+  const double* seedCentroid = centroids + triId * 3;
+  const double* firstCentroid = centroids + patch[1] * 3;
+
+  double np[3] = {normals[triId * 3], normals[triId * 3 + 1], normals[triId * 3 + 2]};
+  double temp[3] = {firstCentroid[0] - seedCentroid[0], firstCentroid[1] - seedCentroid[1], firstCentroid[2] - seedCentroid[2]};
+  double vp[3] = {0.0, 0.0, 0.0};
+
+  // Cross Product of np and temp
+  MatrixMath::Normalize3x1(np);
+  MatrixMath::CrossProduct(np, temp, vp);
+  MatrixMath::Normalize3x1(vp);
+
+  // get the third orthogonal vector
+  double up[3] = {0.0, 0.0, 0.0};
+  MatrixMath::CrossProduct(vp, np, up);
+
+  // this constitutes a rotation matrix to a local coordinate system
+  double rot[3][3] = {{up[0], up[1], up[2]}, {vp[0], vp[1], vp[2]}, {np[0], np[1], np[2]}};
+
+  // Translate each centroid of the patch to the 0,0,0 origin and transform it to the local coordinate system.
+  // The rows of the least squares system are written into the worker's reusable design buffer (column major).
+  Eigen::Index rows = static_cast<Eigen::Index>(patch.size());
+  Eigen::Index cols = m_UseNormalsForCurveFitting ? USE_NORMALS : NO_NORMALS;
+  if(design.size() < static_cast<size_t>(rows * (cols + 1)))
   {
-    int64_t t = *iter;
-    extractedData->setComponent(i, 0, data[t * 3]);
-    extractedData->setComponent(i, 1, data[t * 3 + 1]);
-    extractedData->setComponent(i, 2, data[t * 3 + 2]);
-    ++i;
+    design.resize(static_cast<size_t>(rows * (cols + 1)));
+  }
+  Eigen::Map<Eigen::MatrixXd> A(design.data(), rows, cols);
+  Eigen::Map<Eigen::VectorXd> b(design.data() + rows * cols, rows);
+  for(Eigen::Index m = 0; m < rows; m++)
+  {
+    int64_t t = patch[static_cast<size_t>(m)];
+    double centroid[3] = {centroids[t * 3] - seedCentroid[0], centroids[t * 3 + 1] - seedCentroid[1], centroids[t * 3 + 2] - seedCentroid[2]};
+    double out[3] = {0.0, 0.0, 0.0};
+    MatrixMath::Multiply3x3with3x1(rot, centroid, out);
+    double x = out[0];
+    double y = out[1];
+
+    A(m, 0) = 0.5 * x * x; // 1/2 x^2
+    A(m, 1) = x * y;       // x*y
+    A(m, 2) = 0.5 * y * y; // 1/2 y^2
+    if(m_UseNormalsForCurveFitting)
+    {
+      A(m, 3) = x * x * x;
+      A(m, 4) = x * x * y;
+      A(m, 5) = x * y * y;
+      A(m, 6) = y * y * y;
+    }
+    b(m) = out[2]; // The Z Values
   }
-  triPatch.insert(triId);
 
-  return extractedData;
+  // Solve the least squares system on the design matrix itself so that small or degenerate patches
+  // get the same answer as before; the normal equations would square its condition number. The
+  // worker's decomposition keeps its storage between patches, and the solution has a fixed size.
+  qr.compute(A);
+  Eigen::Matrix<double, USE_NORMALS, 1> sln1 = Eigen::Matrix<double, USE_NORMALS, 1>::Zero();
+  sln1.head(cols) = qr.solve(b);
+  // Now that we have the A, B, C (and D, E, F & G) constants we can solve the Eigen value/vector problem
+  // to get the principal curvatures and pricipal directions.
+  Eigen::Matrix2d M;
+  M << sln1(0), sln1(1), sln1(1), sln1(2);
+
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(M);
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::RealVectorType eValues = eig.eigenvalues();
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::MatrixType eVectors = eig.eigenvectors();
+
+  // Kappa1 >= Kappa2
+  double kappa1 = eValues(0) * -1; // Kappa 1
+  double kappa2 = eValues(1) * -1; // kappa 2
+  Q_ASSERT(kappa1 >= kappa2);
+  m_PrincipleCurvature1->setValue(triId, kappa1);
+  m_PrincipleCurvature2->setValue(triId, kappa2);
+
+  if(m_GaussianCurvature.get() != nullptr)
+  {
+    m_GaussianCurvature->setValue(triId, kappa1 * kappa2);
+  }
+  if(m_MeanCurvature.get() != nullptr)
+  {
+    m_MeanCurvature->setValue(triId, (kappa1 + kappa2) / 2.0);
+  }
+
+  if(m_PrincipleDirection1.get() != nullptr)
+  {
+    Eigen::Matrix3d e_rot_T;
+    e_rot_T.row(0) = Eigen::Vector3d(up[0], vp[0], np[0]);
+    e_rot_T.row(1) = Eigen::Vector3d(up[1], vp[1], np[1]);
+    e_rot_T.row(2) = Eigen::Vector3d(up[2], vp[2], np[2]);
+
+    // Rotate our principal directions back into the original coordinate system
+    Eigen::Vector3d dir1(eVectors.col(0)(0), eVectors.col(0)(1), 0.0);
+    dir1 = e_rot_T * dir1;
+    ::memcpy(m_PrincipleDirection1->getPointer(triId * 3), dir1.data(), 3 * sizeof(double));
+
+    Eigen::Vector3d dir2(eVectors.col(1)(0), eVectors.col(1)(1), 0.0);
+    dir2 = e_rot_T * dir2;
+    ::memcpy(m_PrincipleDirection2->getPointer(triId * 3), dir2.data(), 3 * sizeof(double));
+  }
 }
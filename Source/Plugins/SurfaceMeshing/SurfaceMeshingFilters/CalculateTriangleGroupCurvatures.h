@@ -35,7 +35,11 @@
 
 #pragma once
 
-#include <set>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -43,41 +47,87 @@
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 /**
- * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for a group of triangles
+ * @brief The TriangleRingAdjacency struct holds the connectivity that the N-Ring searches walk, stored
+ * in compressed row form. Two triangles are neighbors when they share a vertex, have the same
+ * feature face Id and separate the same pair of features. The triangles are also grouped by feature
+ * face Id so that every triangle has a small index inside its own group.
+ */
+struct TriangleRingAdjacency
+{
+  std::vector<int64_t> neighborOffsets;
+  std::vector<int64_t> neighbors;
+  std::vector<int64_t> groupOffsets;
+  std::vector<int64_t> groupTriangles;
+  std::vector<int64_t> localIndex;
+  int64_t maxGroupSize = 0;
+};
+
+/**
+ * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for groups of triangles
  * where each triangle in the group will have the 2 Principal Curvature values computed and optionally
- * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed.
+ * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed. Each instance is
+ * one worker that keeps taking chunks of triangles until none are left, reusing its own scratch buffers.
  */
 class CalculateTriangleGroupCurvatures
 {
 public:
-  CalculateTriangleGroupCurvatures(int64_t nring, std::vector<int64_t> triangleIds, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1,
-                                   DoubleArrayType::Pointer principleCurvature2, DoubleArrayType::Pointer principleDirection1, DoubleArrayType::Pointer principleDirection2,
-                                   DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature, TriangleGeom::Pointer trianglesGeom,
-                                   DataArray<int32_t>::Pointer surfaceMeshFaceLabels, DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids,
+  using TriangleChunk_t = std::pair<int64_t, int64_t>;
+
+  CalculateTriangleGroupCurvatures(int64_t nring, const TriangleRingAdjacency& adjacency, const std::vector<TriangleChunk_t>& chunks, std::atomic<size_t>& nextChunk,
+                                   bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1, DoubleArrayType::Pointer principleCurvature2,
+                                   DoubleArrayType::Pointer principleDirection1, DoubleArrayType::Pointer principleDirection2, DoubleArrayType::Pointer gaussianCurvature,
+                                   DoubleArrayType::Pointer meanCurvature, DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids,
                                    AbstractFilter* parent);
 
   virtual ~CalculateTriangleGroupCurvatures();
 
   void operator()() const;
 
-  typedef std::set<int64_t> UniqueFaceIds_t;
+  /**
+   * @brief BuildAdjacency Builds the vertex to triangle connectivity and from it the triangle to triangle
+   * connectivity used by the N-Ring searches
+   * @param triangleGeom The triangle geometry
+   * @param faceLabels The pair of feature Ids on either side of each triangle
+   * @param featureFaceIds The feature face Id of each triangle
+   * @param numFeatureFaces One more than the largest feature face Id
+   * @param adjacency The connectivity that is filled in
+   */
+  static void BuildAdjacency(const TriangleGeom::Pointer& triangleGeom, const int32_t* faceLabels, const int32_t* featureFaceIds, size_t numFeatureFaces, TriangleRingAdjacency& adjacency);
+
+  /**
+   * @brief BuildChunks Splits the triangles of every feature face into chunks of at most chunkSize triangles
+   * @param adjacency The connectivity holding the triangle groups
+   * @param chunkSize The largest number of triangles in a chunk
+   * @return The [begin, end) ranges into the grouped triangle list
+   */
+  static std::vector<TriangleChunk_t> BuildChunks(const TriangleRingAdjacency& adjacency, int64_t chunkSize);
 
 protected:
   CalculateTriangleGroupCurvatures();
 
   /**
-   * @brief extractPatchData Extracts out the needed data values from the global arrays
+   * @brief findNRingPatch Collects the seed triangle followed by all of the triangles that are at most
+   * NRing steps away from it, in increasing Id order
    * @param triId The seed triangle Id
-   * @param triPatch The group of triangles being used
-   * @param data The data to extract from
-   * @param name The name of the data array being used
-   * @return Shared pointer to the extracted data
+   * @param stamps Last search that visited each triangle of the seed's group
+   * @param stamp The value marking the current search
+   * @param patch The patch that is filled in
+   */
+  void findNRingPatch(int64_t triId, std::vector<uint32_t>& stamps, uint32_t stamp, std::vector<int64_t>& patch) const;
+
+  /**
+   * @brief fitPatch Fits a quadric to the patch around the seed triangle and stores the curvature values
+   * @param patch The seed triangle followed by its neighborhood
+   * @param design Reusable storage for the least squares system
+   * @param qr Reusable decomposition of the least squares system
    */
-  DataArray<double>::Pointer extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const;
+  void fitPatch(const std::vector<int64_t>& patch, std::vector<double>& design, Eigen::ColPivHouseholderQR<Eigen::MatrixXd>& qr) const;
 
 private:
   int64_t m_NRing;
-  std::vector<int64_t> m_TriangleIds;
+  const TriangleRingAdjacency& m_Adjacency;
+  const std::vector<TriangleChunk_t>& m_Chunks;
+  std::atomic<size_t>& m_NextChunk;
   bool m_UseNormalsForCurveFitting;
   DoubleArrayType::Pointer m_PrincipleCurvature1;
   DoubleArrayType::Pointer m_PrincipleCurvature2;
@@ -85,8 +135,6 @@ private:
   DoubleArrayType::Pointer m_PrincipleDirection2;
   DoubleArrayType::Pointer m_GaussianCurvature;
   DoubleArrayType::Pointer m_MeanCurvature;
-  TriangleGeom::Pointer m_TrianglesPtr;
-  DataArray<int32_t>::Pointer m_SurfaceMeshFaceLabels;
   DataArray<double>::Pointer m_SurfaceMeshFaceNormals;
   DataArray<double>::Pointer m_SurfaceMeshTriangleCentroids;
   AbstractFilter* m_ParentFilter;
@@ -34,6 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FeatureFaceCurvatureFilter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/DataContainers/DataContainer.h"
@@ -159,8 +163,6 @@ void FeatureFaceCurvatureFilter::readFilterParameters(AbstractFilterParametersRe
 void FeatureFaceCurvatureFilter::initialize()
 {
   m_SurfaceMeshFaceEdges = nullptr;
-  m_TotalFeatureFaces = -1;
-  m_CompletedFeatureFaces = -1;
 }
 
 // -----------------------------------------------------------------------------
@@ -314,17 +316,6 @@ void FeatureFaceCurvatureFilter::execute()
   // Just to double check we have everything.
   int64_t numTriangles = triangleGeom->getNumberOfTris();
 
-  // Make sure the Face Connectivity is created because the FindNRing algorithm needs this and will
-  // assert if the data is NOT in the SurfaceMesh Data Container
-  ElementDynamicList::Pointer vertLinks = triangleGeom->getElementsContainingVert();
-  if(nullptr == vertLinks.get())
-  {
-    triangleGeom->findElementsContainingVert();
-  }
-
-  // get the QMap from the SharedFeatureFaces filter
-  SharedFeatureFaces_t sharedFeatureFaces;
-
   int32_t maxFaceId = 0;
   for(int64_t t = 0; t < numTriangles; ++t)
   {
@@ -333,84 +324,39 @@ void FeatureFaceCurvatureFilter::execute()
       maxFaceId = m_SurfaceMeshFeatureFaceIds[t];
     }
   }
-  std::vector<int32_t> faceSizes(maxFaceId + 1, 0);
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    faceSizes[m_SurfaceMeshFeatureFaceIds[t]]++;
-  }
 
-  // Allocate all the vectors that we need
-  for(size_t iter = 0; iter < faceSizes.size(); ++iter)
+  // Build the connectivity that every N-Ring search walks once, instead of searching the vertex lists per triangle
+  notifyStatusMessage("Building Triangle Connectivity");
+  TriangleRingAdjacency adjacency;
+  CalculateTriangleGroupCurvatures::BuildAdjacency(triangleGeom, m_SurfaceMeshFaceLabels, m_SurfaceMeshFeatureFaceIds, static_cast<size_t>(maxFaceId) + 1, adjacency);
+  if(getCancel())
   {
-    FaceIds_t v;
-    v.reserve(faceSizes[iter]);
-    sharedFeatureFaces[iter] = v;
-  }
-
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    sharedFeatureFaces[m_SurfaceMeshFeatureFaceIds[t]].push_back(t);
+    return;
   }
 
-  m_TotalFeatureFaces = sharedFeatureFaces.size();
-  m_CompletedFeatureFaces = 0;
+  // Large feature faces are split into chunks so that they do not end up on a single thread
+  std::vector<CalculateTriangleGroupCurvatures::TriangleChunk_t> chunks = CalculateTriangleGroupCurvatures::BuildChunks(adjacency, 1024);
+  std::atomic<size_t> nextChunk(0);
 
+  notifyStatusMessage("Computing Curvatures");
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-#else
-
-#endif
-  // typedef here for conveneince
-  typedef SharedFeatureFaces_t::iterator SharedFeatureFaceIterator_t;
-
-  for(SharedFeatureFaceIterator_t iter = sharedFeatureFaces.begin(); iter != sharedFeatureFaces.end(); ++iter)
+  uint32_t numWorkers = std::max(std::thread::hardware_concurrency(), 1U);
+  for(uint32_t w = 0; w < numWorkers; w++)
   {
-    QString ss = QObject::tr("Working on Face Id %1/%2").arg((*iter).first).arg(maxFaceId);
-    notifyStatusMessage(ss);
-
-    FaceIds_t& triangleIds = (*iter).second;
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(true)
-    {
-      g->run(CalculateTriangleGroupCurvatures(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                              m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
-                                              m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
-                                              m_SurfaceMeshTriangleCentroidsPtr.lock(), this));
-    }
-    else
-#endif
-    {
-      CalculateTriangleGroupCurvatures curvature(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                                 m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
-                                                 m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
-                                                 m_SurfaceMeshTriangleCentroidsPtr.lock(), this);
-      curvature();
-    }
+    g->run(CalculateTriangleGroupCurvatures(m_NRing, adjacency, chunks, nextChunk, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
+                                            m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
+                                            m_SurfaceMeshMeanCurvaturesPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_SurfaceMeshTriangleCentroidsPtr.lock(), this));
   }
-  // *********************** END END END END END END  ********************************************************************
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   g->wait(); // Wait for all the threads to complete before moving on.
-
+#else
+  CalculateTriangleGroupCurvatures curvature(m_NRing, adjacency, chunks, nextChunk, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
+                                             m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
+                                             m_SurfaceMeshMeanCurvaturesPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_SurfaceMeshTriangleCentroidsPtr.lock(), this);
+  curvature();
 #endif
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-void FeatureFaceCurvatureFilter::tbbTaskProgress()
-{
-  m_CompletedFeatureFaces++;
-
-  QString ss = QObject::tr("%1/%2 Complete").arg(m_CompletedFeatureFaces).arg(m_TotalFeatureFaces);
-  notifyStatusMessage(ss);
-}
-
-#endif
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -346,10 +346,6 @@ public:
    */
   void execute() override;
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  virtual void tbbTaskProgress();
-#endif
-
 protected:
   FeatureFaceCurvatureFilter();
   /**
@@ -404,8 +400,6 @@ private:
   DataArray<int32_t>::WeakPointer m_SurfaceMeshUniqueEdgesPtr;
 
   int32_t* m_SurfaceMeshFaceEdges;
-  int32_t m_TotalFeatureFaces;
-  int32_t m_CompletedFeatureFaces;
 
 public:
   FeatureFaceCurvatureFilter(const FeatureFaceCurvatureFilter&) = delete;            // Copy Constructor Not Implemented
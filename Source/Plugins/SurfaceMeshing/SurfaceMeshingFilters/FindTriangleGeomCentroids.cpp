@@ -34,8 +34,6 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindTriangleGeomCentroids.h"
 
-#include <set>
-
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -47,10 +45,10 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Math/MatrixMath.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleFeatureReduction.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -167,45 +165,11 @@ void FindTriangleGeomCentroids::execute()
   float* vertPtr = triangles->getVertexPointer(0);
 
   MeshIndexType numTriangles = triangles->getNumberOfTris();
+  MeshIndexType numVertices = triangles->getNumberOfVertices();
   MeshIndexType* tris = triangles->getTriPointer(0);
 
   MeshIndexType numFeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
-  std::vector<std::set<MeshIndexType>> vertexSets(numFeatures);
-
-  for(MeshIndexType i = 0; i < numTriangles; i++)
-  {
-    if(m_FaceLabels[2 * i + 0] > 0)
-    {
-      vertexSets[m_FaceLabels[2 * i + 0]].insert(tris[3 * i + 0]);
-      vertexSets[m_FaceLabels[2 * i + 0]].insert(tris[3 * i + 1]);
-      vertexSets[m_FaceLabels[2 * i + 0]].insert(tris[3 * i + 2]);
-    }
-    if(m_FaceLabels[2 * i + 1] > 0)
-    {
-      vertexSets[m_FaceLabels[2 * i + 1]].insert(tris[3 * i + 0]);
-      vertexSets[m_FaceLabels[2 * i + 1]].insert(tris[3 * i + 1]);
-      vertexSets[m_FaceLabels[2 * i + 1]].insert(tris[3 * i + 2]);
-    }
-  }
-
-  std::set<MeshIndexType>::iterator it;
-  for(MeshIndexType i = 0; i < numFeatures; i++)
-  {
-    for(it = vertexSets[i].begin(); it != vertexSets[i].end(); ++it)
-    {
-      int32_t vert = *it;
-      m_Centroids[3 * i + 0] += vertPtr[3 * vert + 0];
-      m_Centroids[3 * i + 1] += vertPtr[3 * vert + 1];
-      m_Centroids[3 * i + 2] += vertPtr[3 * vert + 2];
-    }
-    if(!vertexSets[i].empty())
-    {
-      m_Centroids[3 * i + 0] /= vertexSets[i].size();
-      m_Centroids[3 * i + 1] /= vertexSets[i].size();
-      m_Centroids[3 * i + 2] /= vertexSets[i].size();
-    }
-    vertexSets[i].clear();
-  }
+  TriangleFeatureReduction::FindVertexCentroids(tris, vertPtr, m_FaceLabels, numTriangles, numVertices, numFeatures, m_Centroids);
 }
 
 // -----------------------------------------------------------------------------
@@ -34,7 +34,6 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindTriangleGeomNeighbors.h"
 
-#include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -49,6 +48,7 @@
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceGrouping.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -161,120 +161,29 @@ void FindTriangleGeomNeighbors::execute()
   size_t totalFaces = m_FaceLabelsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
-  int32_t feature1 = 0;
-  int32_t feature2 = 0;
-  int32_t nnum = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
-  for(size_t i = 1; i < totalFeatures; i++)
+  // Group the faces by their pair of Feature labels once, then every distinct pair is a neighbor relation
+  notifyStatusMessage("Finding Neighbors || Grouping Shared Faces");
+  FeatureFaceGroups groups;
+  std::vector<int32_t> faceIds(totalFaces, 0);
+  FeatureFaceGrouping::GroupFeatureFaces(m_FaceLabels, totalFaces, faceIds.data(), groups);
+  if(getCancel())
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
+    return;
   }
 
-  for(size_t j = 0; j < totalFaces; j++)
-  {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalFaces) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    feature1 = m_FaceLabels[2 * j];
-    feature2 = m_FaceLabels[2 * j + 1];
-    if(feature1 > 0)
-    {
-      if(feature2 > 0)
-      {
-        nnum = m_NumNeighbors[feature1];
-        neighborlist[feature1].push_back(feature2);
-        nnum++;
-        m_NumNeighbors[feature1] = nnum;
-      }
-    }
-    if(feature2 > 0)
-    {
-      if(feature1 > 0)
-      {
-        nnum = m_NumNeighbors[feature2];
-        neighborlist[feature2].push_back(feature1);
-        nnum++;
-        m_NumNeighbors[feature2] = nnum;
-      }
-    }
-  }
+  notifyStatusMessage("Finding Neighbors || Determining Neighbor Lists");
+  std::vector<int64_t> neighborOffsets;
+  std::vector<int32_t> neighbors;
+  FeatureFaceGrouping::FindFeatureNeighbors(groups, totalFeatures, neighborOffsets, neighbors);
 
   // We do this to create new set of NeighborList objects
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
-    {
-      int32_t neigh = iter.key(); // get the neighbor feature
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-    }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
+    m_NumNeighbors[i] = static_cast<int32_t>(neighborOffsets[i + 1] - neighborOffsets[i]);
 
     // Set the vector for each list into the NeighborList Object
     NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    sharedNeiLst->assign(neighbors.begin() + neighborOffsets[i], neighbors.begin() + neighborOffsets[i + 1]);
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
   }
 }
@@ -34,7 +34,7 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindTriangleGeomSizes.h"
 
-#include <set>
+#include <algorithm>
 
 #include <QtCore/QTextStream>
 
@@ -46,10 +46,10 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Math/MatrixMath.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleFeatureReduction.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -142,18 +142,6 @@ void FindTriangleGeomSizes::dataCheck()
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float FindTriangleGeomSizes::findTetrahedronVolume(MeshIndexType vertIds[3], float* vertPtr)
-{
-  float vertMatrix[3][3] = {{vertPtr[3 * vertIds[1] + 0] - vertPtr[3 * vertIds[0] + 0], vertPtr[3 * vertIds[2] + 0] - vertPtr[3 * vertIds[0] + 0], 0.0f - vertPtr[3 * vertIds[0] + 0]},
-                            {vertPtr[3 * vertIds[1] + 1] - vertPtr[3 * vertIds[0] + 1], vertPtr[3 * vertIds[2] + 1] - vertPtr[3 * vertIds[0] + 1], 0.0f - vertPtr[3 * vertIds[0] + 1]},
-                            {vertPtr[3 * vertIds[1] + 2] - vertPtr[3 * vertIds[0] + 2], vertPtr[3 * vertIds[2] + 2] - vertPtr[3 * vertIds[0] + 2], 0.0f - vertPtr[3 * vertIds[0] + 2]}};
-
-  return (MatrixMath::Determinant3x3(vertMatrix) / 6.0f);
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -169,46 +157,26 @@ void FindTriangleGeomSizes::execute()
   TriangleGeom::Pointer triangles = getDataContainerArray()->getDataContainer(m_FaceLabelsArrayPath.getDataContainerName())->getGeometryAs<TriangleGeom>();
   float* vertPtr = triangles->getVertexPointer(0);
 
-  std::set<int32_t> featureSet;
   MeshIndexType numTriangles = triangles->getNumberOfTris();
 
-  for(MeshIndexType i = 0; i < numTriangles; i++)
+  int32_t maxLabel = 0;
+  for(MeshIndexType i = 0; i < numTriangles * 2; i++)
   {
-    if(m_FaceLabels[2 * i + 0] > 0)
-    {
-      featureSet.insert(m_FaceLabels[2 * i + 0]);
-    }
-    if(m_FaceLabels[2 * i + 1] > 0)
-    {
-      featureSet.insert(m_FaceLabels[2 * i + 1]);
-    }
+    maxLabel = std::max(maxLabel, m_FaceLabels[i]);
   }
 
-  std::vector<size_t> tDims(1, featureSet.size() + 1);
+  size_t numFeatures = static_cast<size_t>(maxLabel) + 1;
+  std::vector<size_t> tDims(1, numFeatures);
   AttributeMatrix::Pointer featAttrMat = getDataContainerArray()->getDataContainer(m_FaceLabelsArrayPath.getDataContainerName())->getAttributeMatrix(m_FeatureAttributeMatrixName);
   featAttrMat->resizeAttributeArrays(tDims);
   m_Volumes = m_VolumesPtr.lock()->getPointer(0);
 
-  MeshIndexType vertsAtTri[3] = {0, 0, 0};
+  TriangleFeatureMoments moments;
+  TriangleFeatureReduction::FindFeatureMoments(triangles->getTriPointer(0), vertPtr, m_FaceLabels, numTriangles, numFeatures, moments);
 
-  for(MeshIndexType i = 0; i < numTriangles; i++)
+  for(size_t i = 0; i < numFeatures; i++)
   {
-    triangles->getVertsAtTri(i, vertsAtTri);
-    if(m_FaceLabels[2 * i + 0] == -1)
-    {
-      std::swap(vertsAtTri[2], vertsAtTri[1]);
-      m_Volumes[m_FaceLabels[2 * i + 1]] += findTetrahedronVolume(vertsAtTri, vertPtr);
-    }
-    else if(m_FaceLabels[2 * i + 1] == -1)
-    {
-      m_Volumes[m_FaceLabels[2 * i + 0]] += findTetrahedronVolume(vertsAtTri, vertPtr);
-    }
-    else
-    {
-      m_Volumes[m_FaceLabels[2 * i + 0]] += findTetrahedronVolume(vertsAtTri, vertPtr);
-      std::swap(vertsAtTri[2], vertsAtTri[1]);
-      m_Volumes[m_FaceLabels[2 * i + 1]] += findTetrahedronVolume(vertsAtTri, vertPtr);
-    }
+    m_Volumes[i] = static_cast<float>(moments.volumes[i]);
   }
 }
 
@@ -183,16 +183,6 @@ public:
 protected:
   FindTriangleGeomSizes();
 
-  /**
-   * @brief findTetrahedronVolume Computes the signed volume of the tetrahedron where the
-   * base of the tetrahedron is given by triangle defined by the vertIds indices and a
-   * fourth point set to the origin
-   * @param vertIds Indices of triangle vertices for the base of the tetrahedron
-   * @param vertPtr Vertex coordinates for triangle base
-   * @return float Signed volume of tetrahedron
-   */
-  float findTetrahedronVolume(MeshIndexType vertIds[3], float* vertPtr);
-
   /**
    * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
    */
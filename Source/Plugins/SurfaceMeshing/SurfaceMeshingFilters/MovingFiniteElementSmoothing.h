@@ -67,6 +67,7 @@ class SurfaceMeshing_EXPORT MovingFiniteElementSmoothing : public SurfaceMeshFil
   Q_OBJECT
   // PYB11_BEGIN_BINDINGS(MovingFiniteElementSmoothing SUPERCLASS SurfaceMeshFilter)
   // PYB11_PROPERTY(int IterationSteps READ getIterationSteps WRITE setIterationSteps)
+  // PYB11_PROPERTY(double ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
   // PYB11_PROPERTY(bool NodeConstraints READ getNodeConstraints WRITE setNodeConstraints)
   // PYB11_PROPERTY(bool ConstrainSurfaceNodes READ getConstrainSurfaceNodes WRITE setConstrainSurfaceNodes)
   // PYB11_PROPERTY(bool ConstrainQuadPoints READ getConstrainQuadPoints WRITE setConstrainQuadPoints)
@@ -105,6 +106,17 @@ public:
   int getIterationSteps() const;
 
   Q_PROPERTY(int IterationSteps READ getIterationSteps WRITE setIterationSteps)
+  /**
+   * @brief Setter property for ConvergenceTolerance
+   */
+  void setConvergenceTolerance(double value);
+  /**
+   * @brief Getter property for ConvergenceTolerance
+   * @return Value of ConvergenceTolerance
+   */
+  double getConvergenceTolerance() const;
+
+  Q_PROPERTY(double ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
   /**
    * @brief Setter property for NodeConstraints
    */
@@ -168,6 +180,20 @@ public:
   Q_PROPERTY(DataArrayPath SurfaceMeshNodeTypeArrayPath READ getSurfaceMeshNodeTypeArrayPath WRITE setSurfaceMeshNodeTypeArrayPath)
 
   QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+   */
+  QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  QString getFilterVersion() const override;
   AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
   QString getGroupName() const override;
   QString getSubGroupName() const override;
@@ -218,7 +244,8 @@ private:
   std::weak_ptr<DataArray<int8_t>> m_SurfaceMeshNodeTypePtr;
   int8_t* m_SurfaceMeshNodeType = nullptr;
 
-  int m_IterationSteps = {1};
+  int m_IterationSteps = {100};
+  double m_ConvergenceTolerance = {1.0e-4};
   bool m_NodeConstraints = {true};
   bool m_ConstrainSurfaceNodes = {true};
   bool m_ConstrainQuadPoints = {true};
@@ -46,6 +46,7 @@
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceGrouping.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -182,69 +183,26 @@ void SharedFeatureFaceFilter::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t totalPoints = triangleGeom->getNumberOfTris();
 
-  QMap<uint64_t, int32_t> faceSizeMap;
-  QMap<uint64_t, int32_t> faceIdMap; // This maps a unique 64 bit integer to an increasing 32 bit integer
-  int32_t index = 1;
-  struct
-  {
-    int g;
-    int r;
-  } faceId;
-  uint64_t* faceId_64 = reinterpret_cast<uint64_t*>(&faceId);
-  int32_t fl0 = -1;
-  int32_t fl1 = -1;
-
-  std::vector<std::pair<int32_t, int32_t>> faceLabelMap;
-  faceLabelMap.push_back(std::pair<int32_t, int32_t>(0, 0));
-
-  // Loop through all the Triangles and figure out how many triangles we have in each one.
-  for(int64_t t = 0; t < totalPoints; ++t)
-  {
-    fl0 = m_SurfaceMeshFaceLabels[t * 2];
-    fl1 = m_SurfaceMeshFaceLabels[t * 2 + 1];
-    if(fl0 < fl1)
-    {
-      faceId.g = fl0;
-      faceId.r = fl1;
-    }
-    else
-    {
-      faceId.g = fl1;
-      faceId.r = fl0;
-    }
-
-    QMap<uint64_t, int32_t>::iterator iter = faceSizeMap.find(*faceId_64);
-    if(iter == faceSizeMap.end())
-    {
-      faceSizeMap[*faceId_64] = 1;
-      faceIdMap[*faceId_64] = index;
-      m_SurfaceMeshFeatureFaceIds[t] = index;
-      faceLabelMap.push_back(std::pair<int32_t, int32_t>(faceId.g, faceId.r));
-      ++index;
-    }
-    else
-    {
-      iter.value()++;
-      m_SurfaceMeshFeatureFaceIds[t] = faceIdMap[*faceId_64];
-    }
-  }
+  // Group the triangles by their (unordered) pair of Feature labels. Face ids are handed out in the order
+  // in which each pair first appears in the triangle list.
+  FeatureFaceGroups groups;
+  FeatureFaceGrouping::GroupFeatureFaces(m_SurfaceMeshFaceLabels, static_cast<size_t>(totalPoints), m_SurfaceMeshFeatureFaceIds, groups);
+  size_t numFaces = groups.faceOffsets.size() - 1;
 
   // resize + update pointers
-  std::vector<size_t> tDims(1, index);
+  std::vector<size_t> tDims(1, numFaces);
   faceFeatureAttrMat->resizeAttributeArrays(tDims);
   m_SurfaceMeshFeatureFaceLabels = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getPointer(0);
   m_SurfaceMeshFeatureFaceNumTriangles = m_SurfaceMeshFeatureFaceNumTrianglesPtr.lock()->getPointer(0);
 
-  for(int32_t i = 0; i < index; i++)
+  for(size_t i = 0; i < numFaces; i++)
   {
     // get feature face labels
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = faceLabelMap[i].first;
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = faceLabelMap[i].second;
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = groups.faceLabels[2 * i + 0];
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = groups.faceLabels[2 * i + 1];
 
     // get feature triangle count
-    faceId.g = faceLabelMap[i].first;
-    faceId.r = faceLabelMap[i].second;
-    m_SurfaceMeshFeatureFaceNumTriangles[i] = faceSizeMap[*faceId_64];
+    m_SurfaceMeshFeatureFaceNumTriangles[i] = static_cast<int32_t>(groups.faceOffsets[i + 1] - groups.faceOffsets[i]);
   }
 }
 
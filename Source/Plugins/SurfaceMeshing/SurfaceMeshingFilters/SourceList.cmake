@@ -23,6 +23,7 @@ set(_PublicFilters
   FindTriangleGeomShapes
   FindTriangleGeomSizes
   LaplacianSmoothing
+  MovingFiniteElementSmoothing
   QuickSurfaceMesh
   ReverseTriangleWinding
   SharedFeatureFaceFilter
@@ -31,6 +32,7 @@ set(_PublicFilters
   TriangleDihedralAngleFilter
   TriangleNormalFilter
   GenerateGeometryConnectivity
+  VerifyTriangleWinding
 )
 
 if(SIMPL_USE_EIGEN)
@@ -75,15 +77,27 @@ endforeach()
 ADD_SIMPL_SUPPORT_MOC_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} BinaryNodesTrianglesReader.h)
 ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} BinaryNodesTrianglesReader.cpp)
 
+ADD_SIMPL_SUPPORT_MOC_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} SurfaceMeshFilter.h)
+ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} SurfaceMeshFilter.cpp)
+
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} MeshFunctions.h)
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} MeshLinearAlgebra.h)
 
-ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} FindNRingNeighbors.h)
-ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} FindNRingNeighbors.cpp)
-
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleOps.h)
 ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleOps.cpp)
 
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/FeatureFaceGrouping.h)
+ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/FeatureFaceGrouping.cpp)
+
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleWinding.h)
+ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleWinding.cpp)
+
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/MovingFiniteElementSolver.h)
+ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/MovingFiniteElementSolver.cpp)
+
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleFeatureReduction.h)
+ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleFeatureReduction.cpp)
+
 
 SIMPL_END_FILTER_GROUP(${SurfaceMeshing_BINARY_DIR} "${_filterGroupName}" "Surface Meshing Filters")
 
@@ -34,286 +34,21 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "VerifyTriangleWinding.h"
 
-#include <QtCore/QString>
-#include <deque>
-#include <iostream>
-#include <limits>
-#include <queue>
-
-#ifdef _MSC_VER
-#include <hash_set>
-// using namespace stdext;
-#define STDEXT stdext
-#else
-#include <ext/hash_set>
-// using namespace __gnu_cxx;
-#define STDEXT __gnu_cxx
-#endif
-
-#include <QtCore/QDebug>
+#include <QtCore/QTextStream>
 
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Math/MatrixMath.h"
-
-#include "SurfaceMeshing/SurfaceMeshingFilters/ReverseTriangleWinding.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/Plane.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleOps.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/Vector3.h"
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class Mesh
-{
-public:
-  using Self = Mesh;
-  using Pointer = std::shared_ptr<Self>;
-  using ConstPointer = std::shared_ptr<const Self>;
-  using WeakPointer = std::weak_ptr<Self>;
-  using ConstWeakPointer = std::weak_ptr<const Self>;
-  static Pointer NullPointer();
-  Pointer NullPointer()
-  {
-    return Pointer(static_cast<Self*>(nullptr));
-  }
-
-  static Pointer New();
-
-  virtual ~Mesh()
-  {
-  }
-  int getMaxLabel()
-  {
-    return -1;
-  }
-  int getMinLabel()
-  {
-    return -1;
-  }
-  void setMaxLabel(int32_t l)
-  {
-    m_MaxLabel = l;
-  }
-  void setMinLabel(int32_t l)
-  {
-    m_MinLabel = l;
-  }
-  void incrementMaxLabel()
-  {
-    m_MaxLabel++;
-  }
-
-protected:
-  Mesh()
-  {
-  }
-
-private:
-  int32_t m_MinLabel;
-  int32_t m_MaxLabel;
-
-  Mesh(const Mesh&);           // Copy Constructor Not Implemented
-  void operator=(const Mesh&); // Operator '=' Not Implemented
-};
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class LabelVisitorInfo
-{
-public:
-  //   typedef Mesh<int32_t>::Pointer                MeshPtrType;
-  typedef FaceArray::Face_t FaceType;
-  typedef QVector<int32_t> FaceListType;
-
-  using Self = LabelVisitorInfo;
-  using Pointer = std::shared_ptr<Self>;
-  using ConstPointer = std::shared_ptr<const Self>;
-  using WeakPointer = std::weak_ptr<Self>;
-  using ConstWeakPointer = std::weak_ptr<const Self>;
-  static Pointer NullPointer();
-  Pointer NullPointer()
-  {
-    return Pointer(static_cast<Self*>(nullptr));
-  }
-
-  static Pointer New(int32_t label, size_t tIndex)
-  {
-    Pointer sharedPtr(new LabelVisitorInfo(label, tIndex));
-    return sharedPtr;
-  }
-
-  virtual ~LabelVisitorInfo()
-  {
-  }
-
-private:
-  int32_t m_Label;
-
-public:
-  int32_t getLabel()
-  {
-    if(m_Relabeled)
-    {
-      return m_NewLabel;
-    }
-    return m_Label;
-  }
-
-  // -----------------------------------------------------------------------------
-  void setStartIndex(const size_t& value)
-  {
-    m_StartIndex = value;
-  }
-
-  // -----------------------------------------------------------------------------
-  size_t getStartIndex() const
-  {
-    return m_StartIndex;
-  }
-
-  // -----------------------------------------------------------------------------
-  void setPrimed(bool value)
-  {
-    m_Primed = value;
-  }
-
-  // -----------------------------------------------------------------------------
-  bool getPrimed() const
-  {
-    return m_Primed;
-  }
-
-  // -----------------------------------------------------------------------------
-  void setNewLabel(int32_t value)
-  {
-    m_NewLabel = value;
-  }
-
-  // -----------------------------------------------------------------------------
-  int32_t getNewLabel() const
-  {
-    return m_NewLabel;
-  }
-
-  // -----------------------------------------------------------------------------
-  void setRelabeled(bool value)
-  {
-    m_Relabeled = value;
-  }
-
-  // -----------------------------------------------------------------------------
-  bool getRelabeled() const
-  {
-    return m_Relabeled;
-  }
-
-  QSet<int32_t> m_Faces;
-  QSet<int32_t> m_OriginalFaceList;
-
-  /**
-   *
-   * @param mesh
-   * @param masterVisited
-   * @return
-   */
-  Pointer relabelFaces(Mesh::Pointer mesh, DataArray<int32_t>::Pointer masterFaceListPtr, const QVector<bool>& masterVisited)
-  {
-    size_t triangleIndex = *(m_Faces.begin());
-    int32_t newLabel = mesh->getMaxLabel() + 1;
-    mesh->incrementMaxLabel();
-    int32_t* masterFaceList = masterFaceListPtr->getPointer(0);
-    LabelVisitorInfo::Pointer p = LabelVisitorInfo::New(m_Label, triangleIndex);
-
-    p->setPrimed(false);
-    p->setNewLabel(newLabel);
-    p->setRelabeled(true);
-    p->m_Faces = m_Faces;            // This will make a copy of the current set of triangles
-    p->m_OriginalFaceList = m_Faces; // Make a copy that does NOT get updated
-    bool seedIsSet = false;
-    for(QSet<int32_t>::iterator triIter = p->m_Faces.begin(); triIter != p->m_Faces.end(); ++triIter)
-    {
-      if(masterFaceList[(*triIter) * 2] == m_Label)
-      {
-        masterFaceList[(*triIter) * 2] = newLabel;
-      }
-      if(masterFaceList[(*triIter) * 2 + 1] == m_Label)
-      {
-        masterFaceList[(*triIter) * 2 + 1] = newLabel;
-      }
-      if(masterVisited[*triIter])
-      {
-        p->setStartIndex(*triIter);
-        seedIsSet = true;
-      }
-    }
-    if(seedIsSet)
-    {
-      p->setPrimed(true);
-    }
-
-    return p;
-  }
-
-  /**
-   *
-   * @param mesh
-   */
-  void revertFaceLabels(DataArray<int32_t>::Pointer masterFaceListPtr)
-  {
-    int32_t* masterFaceList = masterFaceListPtr->getPointer(0);
-
-    if(m_Relabeled == true)
-    {
-      //  qDebug() << "    Reverting Label " << m_NewLabel << " To " << m_Label << "\n";
-      for(QSet<int32_t>::iterator triIter = m_OriginalFaceList.begin(); triIter != m_OriginalFaceList.end(); ++triIter)
-      {
-        if(masterFaceList[(*triIter) * 2] == m_NewLabel)
-        {
-          masterFaceList[(*triIter) * 2] = m_Label;
-        }
-        if(masterFaceList[(*triIter) * 2 + 1] == m_NewLabel)
-        {
-          masterFaceList[(*triIter) * 2 + 1] = m_Label;
-        }
-      }
-      m_Relabeled = false;
-      m_NewLabel = m_Label;
-      m_Primed = false;
-    }
-  }
-
-protected:
-  LabelVisitorInfo(int32_t label, size_t tIndex)
-  : m_Label(label)
-  , m_StartIndex(tIndex)
-  , m_Primed(false)
-  , m_NewLabel(label)
-  , m_Relabeled(false)
-  {
-  }
 
-private:
-  size_t m_StartIndex = {};
-  bool m_Primed = {};
-  int32_t m_NewLabel = {};
-  bool m_Relabeled = {};
-
-  LabelVisitorInfo(const LabelVisitorInfo&); // Copy Constructor Not Implemented
-  void operator=(const LabelVisitorInfo&);   // Operator '=' Not Implemented
-};
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleWinding.h"
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-VerifyTriangleWinding::VerifyTriangleWinding()
-: m_SurfaceDataContainerName(SIMPL::Defaults::DataContainerName)
-, m_SurfaceMeshNodeFacesArrayName(SIMPL::VertexData::SurfaceMeshNodeFaces)
-, m_SurfaceMeshFaceLabelsArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels)
-, m_SurfaceMeshFaceLabelsArrayName(SIMPL::FaceData::SurfaceMeshFaceLabels)
-, m_SurfaceMeshFaceLabels(nullptr) = default;
+VerifyTriangleWinding::VerifyTriangleWinding() = default;
 
 // -----------------------------------------------------------------------------
 //
@@ -325,13 +60,12 @@ VerifyTriangleWinding::~VerifyTriangleWinding() = default;
 // -----------------------------------------------------------------------------
 void VerifyTriangleWinding::setupFilterParameters()
 {
-  SurfaceMeshFilter::setupFilterParameters();
   FilterParameterVectorType parameters;
-
-  parameters.push_back(SeparatorFilterParameter::Create("Required Information", FilterParameter::Category::Uncategorized));
-  parameters.push_back(DataArraySelectionFilterParameter::Create("SurfaceMeshFaceLabels", "SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath(),
-                                                                 FilterParameter::Category::Uncategorized, SIMPL_BIND_SETTER(VerifyTriangleWinding, this, SurfaceMeshFaceLabelsArrayPath),
-                                                                 SIMPL_BIND_GETTER(VerifyTriangleWinding, this, SurfaceMeshFaceLabelsArrayPath)));
+  parameters.push_back(SeparatorFilterParameter::Create("Face Data", FilterParameter::Category::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 2, AttributeMatrix::Type::Face, IGeometry::Type::Triangle);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Labels", SurfaceMeshFaceLabelsArrayPath, FilterParameter::Category::RequiredArray, VerifyTriangleWinding, req));
+  }
   setFilterParameters(parameters);
 }
 
@@ -359,65 +93,19 @@ void VerifyTriangleWinding::dataCheck()
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer sm = getDataContainerArray()->getPrereqDataContainer(this, getSurfaceMeshFaceLabelsArrayPath().getDataContainerName(), false);
-  if(getErrorCondition() < 0)
-  {
-    return;
-  }
 
-  IGeometry::Pointer geom = sm->getGeometry();
-  if(nullptr == geom.get())
+  getDataContainerArray()->getPrereqGeometryFromDataContainer<TriangleGeom>(this, getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
+  if(getErrorCode() < 0)
   {
-    QString ss = QObject::tr("DataContainer Geometry is missing.");
-    setErrorCondition(-385, ss);
     return;
   }
 
-  TriangleGeom::Pointer triangles = sm->getGeometryAs<TriangleGeom>();
-  if(nullptr == triangles.get())
-  {
-    QString ss = QObject::tr("DataContainer Geometry is not compatible. The Geometry type is %1").arg(geom->getGeometryTypeAsString());
-    setErrorCondition(-384, ss);
-    return;
-  }
-
-  // We MUST have Nodes
-  if(nullptr == triangles->getVertices().get())
-  {
-    setErrorCondition(-386, "DataContainer Geometry missing Vertices");
-  }
-  // We MUST have Triangles defined also.
-  if(nullptr == triangles->getTriangles().get())
-  {
-    setErrorCondition(-387, "DataContainer Geometry missing Triangles");
-  }
-  else
+  std::vector<size_t> cDims(1, 2);
+  m_SurfaceMeshFaceLabelsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>>(this, getSurfaceMeshFaceLabelsArrayPath(), cDims);
+  if(nullptr != m_SurfaceMeshFaceLabelsPtr.lock())
   {
-    std::vector<size_t> dims(1, 2);
-    m_SurfaceMeshFaceLabelsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getSurfaceMeshFaceLabelsArrayPath(), dims);
-    if(nullptr != m_SurfaceMeshFaceLabelsPtr.lock())
-    {
-      m_SurfaceMeshFaceLabels = m_SurfaceMeshFaceLabelsPtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
-  }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void VerifyTriangleWinding::preflight()
-{
-  setInPreflight(true);
-  Q_EMIT preflightAboutToExecute();
-  Q_EMIT updateFilterParameters(this);
-  dataCheck();
-  Q_EMIT preflightExecuted();
-  setInPreflight(false);
-
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
-  QString ss = QObject::tr("Filter is NOT updated for IGeometry Redesign. A Programmer needs to check this filter. Please report this to the DREAM3D developers.");
-  setErrorCondition(0xABABABAB, ss);
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
+    m_SurfaceMeshFaceLabels = m_SurfaceMeshFaceLabelsPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
 }
 
 // -----------------------------------------------------------------------------
@@ -426,445 +114,64 @@ void VerifyTriangleWinding::preflight()
 void VerifyTriangleWinding::execute()
 {
   dataCheck();
-  if(getErrorCondition() < 0)
+  if(getErrorCode() < 0)
   {
     return;
   }
 
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-
-  FaceArray::Pointer facesPtr = sm->getFaces();
-
-  notifyStatusMessage("Generating Face List for each Node");
-  // Make sure the Face Connectivity is created because the FindNRing algorithm needs this and will
-  // assert if the data is NOT in the SurfaceMesh Data Container
-  if(nullptr == facesPtr->getFacesContainingVert())
-  {
-    facesPtr->findFacesContainingVert();
-  }
-  if(getCancel())
-  {
-    return;
-  }
-  if(nullptr == facesPtr->getFaceNeighbors())
-  {
-    facesPtr->findFaceNeighbors();
-  }
-  if(getCancel())
-  {
-    return;
-  }
-  if(facesPtr->getUniqueEdges() == nullptr)
-  {
-    facesPtr->generateUniqueEdgeIds();
-  }
-
   // Execute the actual verification step.
-  notifyStatusMessage("Generating Connectivity Complete. Starting Analysis");
   verifyTriangleWinding();
 }
 
 // -----------------------------------------------------------------------------
-// Groups the triangles according to which Feature they are a part of
+//
 // -----------------------------------------------------------------------------
-void VerifyTriangleWinding::getLabelTriangelMap(LabelFaceMap_t& trianglesToLabelMap)
+int VerifyTriangleWinding::verifyTriangleWinding()
 {
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-  FaceArray::Pointer masterFaceList = sm->getFaces();
-  if(nullptr == masterFaceList.get())
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+  MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+  float* vertices = triangleGeom->getVertexPointer(0);
+  size_t numTriangles = triangleGeom->getNumberOfTris();
+
+  notifyStatusMessage("Finding Shared Edges");
+  TriangleEdgeMap edges;
+  TriangleWinding::BuildEdgeMap(triangles, numTriangles, edges);
+  if(getCancel())
   {
-    setErrorCondition(-556, "The SurfaceMesh DataContainer Does NOT contain Faces");
-    return;
+    return -1;
   }
 
-  int ntri = masterFaceList->getNumberOfTuples();
-  // FaceArray::Face_t* triangles = masterFaceList->getPointer(0);
-
-  // Loop over all the triangles and group them according to which feature/region they are a part of
-  for(int t = 0; t < ntri; ++t)
+  notifyStatusMessage("Verifying Winding of each Feature");
+  std::vector<uint8_t> flips;
+  size_t numFlipped = TriangleWinding::FindWindingFlips(triangles, vertices, m_SurfaceMeshFaceLabels, numTriangles, edges, flips);
+  if(getCancel())
   {
-    int32_t* label = m_SurfaceMeshFaceLabels + t * 2;
-    trianglesToLabelMap[label[0]].insert(t);
-    trianglesToLabelMap[label[1]].insert(t);
+    return -1;
   }
+
+  TriangleWinding::ApplyWindingFlips(triangles, numTriangles, flips);
+  notifyStatusMessage(QObject::tr("Reversed the winding of %1 of %2 triangles").arg(numFlipped).arg(numTriangles));
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t VerifyTriangleWinding::getSeedTriangle(int32_t label, QSet<int32_t>& triangleIndices)
+QString VerifyTriangleWinding::getBrandingString() const
 {
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-
-  VertexArray::Vert_t* verts = sm->getVertices()->getPointer(0);
-  FaceArray::Face_t* triangles = sm->getFaces()->getPointer(0);
-
-  float xMax = std::numeric_limits<float>::min();
-  float avgX = 0.0f;
-  int32_t seedFaceIdx = 0;
-
-  for(QSet<int32_t>::iterator iter = triangleIndices.begin(); iter != triangleIndices.end(); ++iter)
-  {
-    int32_t i = *iter;
-    avgX = (verts[triangles[i].verts[0]].pos[0] + verts[triangles[i].verts[1]].pos[0] + verts[triangles[i].verts[2]].pos[0]) / 3.0;
-    if(avgX > xMax)
-    {
-      xMax = avgX;
-      seedFaceIdx = i;
-    }
-  }
-  // Now we have the "right most" triangle based on x component of the centroid of the triangles for this label.
-  // Lets now figure out if the normal points generally in the positive or negative X direction.
-
-  int32_t* faceLabel = m_SurfaceMeshFaceLabels + seedFaceIdx * 2;
-  VectorType normal;
-  if(faceLabel[0] == label)
-  {
-    normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[0]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[2]]);
-  }
-  else
-  {
-    normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[2]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[0]]);
-  }
-
-  if(normal.x < 0.0f)
-  {
-    ReverseTriangleWinding::Pointer reverse = ReverseTriangleWinding::New();
-    reverse->setDataContainerArray(getDataContainerArray());
-    connect(reverse.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)), this, SLOT(broadcastPipelineMessage(const PipelineMessage&)));
-    reverse->setMessagePrefix(getMessagePrefix());
-    reverse->execute();
-    if(reverse->getErrorCondition() < 0)
-    {
-      setErrorCondition(reverse->getErrorCondition(), "Error Reversing the Face Winding");
-      return -1;
-    }
-    if(faceLabel[0] == label)
-    {
-      normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[0]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[2]]);
-    }
-    else
-    {
-      normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[2]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[0]]);
-    }
-    if(normal.x < 0.0f)
-    {
-      setErrorCondition(-802, "Error After attempted triangle winding reversal. Face normal is still oriented in wrong direction.");
-      seedFaceIdx = -1;
-    }
-  }
-
-  return seedFaceIdx;
+  return "SurfaceMeshing";
 }
 
-#define PRINT_FACE(index, triangles)                                                                                                                                                                   \
-  qDebug() << " " << triangles[index].verts[0] << " " << triangles[index].verts[1] << " " << triangles[index].verts[2] << "\n";                                                                        \
-  qDebug() << "Face ID: " << index << "\n";                                                                                                                                                            \
-  qDebug() << "Face.labels[0] " << triangles[index].labels[0] << "\n";                                                                                                                                 \
-  qDebug() << "Face.labels[1] " << triangles[index].labels[1] << "\n";
-
-#define PRINT_VERT(index) qDebug() << index << " " << verts[index].pos[0] << " " << verts[index].pos[1] << " " << verts[index].pos[2] << "\n";
-
-#define PRINT_NORMAL(i, nodes, triangles)                                                                                                                                                              \
-  {                                                                                                                                                                                                    \
-    VectorType normal = TriangleOps::computeNormal(nodes[triangles[i].verts[0]], nodes[triangles[i].verts[1]], nodes[triangles[i].verts[2]]);                                                          \
-    qDebug() << normal.x << " " << normal.y << " " << normal.z << "\n";                                                                                                                                \
-  }
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int VerifyTriangleWinding::verifyTriangleWinding()
+QString VerifyTriangleWinding::getFilterVersion() const
 {
-  int err = 0;
-  //  qDebug() << "--------------------------------------------------------------" << "\n";
-  //  FaceListType& masterFaceList = *(mesh->triangles());  // Create a reference variable for better syntax
-  //  NodeVector&       masterNodeList = *(mesh->nodes());
-
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-  // get the triangle definitions - use the pointer to the start of the Struct Array
-  FaceArray::Pointer masterFaceList = sm->getFaces();
-  if(nullptr == masterFaceList.get())
-  {
-    setErrorCondition(-556, "The SurfaceMesh DataContainer Does NOT contain Faces");
-    return getErrorCondition();
-  }
-  FaceArray::Face_t* triangles = masterFaceList->getPointer(0);
-
-  int numFaces = masterFaceList->getNumberOfTuples();
-
-  VertexArray::Pointer masterNodeListPtr = sm->getVertices();
-  if(nullptr == masterNodeListPtr.get())
-  {
-    setErrorCondition(-555, "The SurfaceMesh DataContainer Does NOT contain Nodes");
-    return getErrorCondition();
-  }
-
-  Mesh::Pointer mesh = Mesh::New();
-  int min = std::numeric_limits<int32_t>::max();
-  int max = std::numeric_limits<int32_t>::min();
-  // Set the min and Max labels in the Mesh class;
-  for(int n = 0; n < numFaces; ++n)
-  {
-    int l = m_SurfaceMeshFaceLabels[n * 2];
-    if(l < min)
-    {
-      min = l;
-    }
-    if(l > max)
-    {
-      max = l;
-    }
-    l = m_SurfaceMeshFaceLabels[n * 2 + 1];
-    if(l < min)
-    {
-      min = l;
-    }
-    if(l > max)
-    {
-      max = l;
-    }
-  }
-  mesh->setMaxLabel(max);
-  mesh->setMinLabel(min);
-
-  // Get a grouping of triangles by feature ID
-  LabelFaceMap_t trianglesToLabelMap;
-  getLabelTriangelMap(trianglesToLabelMap);
-  //  for(LabelFaceMap_t::iterator iter = trianglesToLabelMap.begin(); iter != trianglesToLabelMap.end(); ++iter)
-  //  {
-  //    qDebug() << "Feature: " << iter.key() << "   Face Count: " << iter.value().size() << "\n";
-  //  }
-
-  int32_t currentLabel = 0;
-
-  // Find the first Non Zero Feature Id (Label). This is going to be our starting feature.
-  for(LabelFaceMap_t::iterator iter = trianglesToLabelMap.begin(); iter != trianglesToLabelMap.end(); ++iter)
-  {
-    if(iter.key() > 0)
-    {
-      currentLabel = iter.key();
-      break;
-    }
-  }
-
-  std::deque<LabelVisitorInfo::Pointer> labelObjectsToVisit;
-
-  // Keeps a list of all the triangles that have been visited.
-  QVector<bool> masterVisited(masterFaceList->getNumberOfTuples(), false);
-
-  STDEXT::hash_set<int32_t> labelsVisitedSet;
-  STDEXT::hash_set<int32_t> labelsToVisitSet;
-  int32_t triIndex = 0;
-
-  bool firstLabel = false;
-
-  // Get the first triangle in the list
-  // FaceArray::Face_t& triangle = triangles[triIndex];
-
-  // Now that we have the starting Feature, lets try and get a seed triangle that is oriented in the proper direction.
-  /* Make sure the winding is correct on the first triangle of the first label that will be checked. */
-  triIndex = getSeedTriangle(currentLabel, trianglesToLabelMap[currentLabel]);
-  if(getErrorCondition() < 0 || triIndex < 0)
-  {
-    return -1;
-  }
-
-  LabelVisitorInfo::Pointer ldo = LabelVisitorInfo::New(currentLabel, triIndex);
-  labelObjectsToVisit.push_back(ldo);
-  LabelVisitorInfo::Pointer curLdo = LabelVisitorInfo::NullPointer();
-  labelsToVisitSet.insert(currentLabel);
-
-  float total = (float)(trianglesToLabelMap.size());
-  float curPercent = 0.0;
-  int progressIndex = 0;
-
-  // Start looping on all the Face Labels (Feature Ids) values
-  while(labelObjectsToVisit.empty() == false)
-  {
-    if(getCancel())
-    {
-      return -1;
-    }
-    if((progressIndex / total * 100.0f) > (curPercent))
-    {
-      QString ss = QObject::tr("%1% Complete").arg(static_cast<int>(progressIndex / total * 100.0f));
-      notifyStatusMessage(ss);
-      curPercent += 5.0f;
-    }
-    ++progressIndex;
-
-    QMap<int32_t, int32_t> neighborlabels;
-
-    curLdo = labelObjectsToVisit.front();
-    labelObjectsToVisit.pop_front();
-    currentLabel = curLdo->getLabel();
-    labelsToVisitSet.erase(currentLabel);
-    labelsVisitedSet.insert(currentLabel);
-    if(curLdo->getPrimed() == false && curLdo->getRelabeled() == false)
-    {
-      curLdo->m_Faces = trianglesToLabelMap[currentLabel];
-      curLdo->setPrimed(true);
-    }
-    else if(curLdo->getPrimed() == false && curLdo->getRelabeled() == true)
-    {
-      //    qDebug() << "    Reint32_ting could not find a starting index. Using first index in triangle set" << "\n";
-      curLdo->setStartIndex(*(curLdo->m_Faces.begin()));
-      curLdo->setPrimed(true);
-    }
-
-    if(firstLabel == true)
-    {
-      triIndex = 0;
-      firstLabel = false;
-    }
-    else
-    {
-      triIndex = curLdo->getStartIndex();
-    }
-    // Get the number of triangles remaining to be visited for the current label
-    QSet<int32_t>::size_type nLabelTriStart = curLdo->m_Faces.size();
-
-    STDEXT::hash_set<int> localVisited;
-    std::deque<int> triangleDeque;
-    // FaceArray::Face_t& triangle = triangles[triIndex];
-    triangleDeque.push_back(triIndex);
-
-    while(triangleDeque.empty() == false)
-    {
-      int32_t triangleIndex = triangleDeque.front();
-      FaceArray::Face_t& triangle = triangles[triangleIndex];
-      int32_t* faceLabel = m_SurfaceMeshFaceLabels + (triangleIndex * 2); // Here we are getting a new pointer offset from the start of the labels array
-
-      //   qDebug() << " $ tIndex: " << triangleIndex << "\n";
-      FaceArray::Pointer facesPtr = sm->getFaces();
-      if(facesPtr == nullptr)
-      {
-        break;
-      }
-      // FaceArray::Face_t* faces = facesPtr->getPointer(0);
-
-      QVector<int32_t> adjTris = TriangleOps::findAdjacentTriangles(facesPtr, triangleIndex, m_SurfaceMeshFaceLabelsPtr.lock(), currentLabel);
-
-      for(FaceList_t::iterator adjTri = adjTris.begin(); adjTri != adjTris.end(); ++adjTri)
-      {
-        // qDebug() << "  ^ AdjTri index: " << *adjTri << "\n";
-        if(masterVisited[*adjTri] == false)
-        {
-          //    qDebug() << "   * Checking Winding: " << *adjTri << "\n";
-          if(TriangleOps::verifyWinding(triangle, triangles[*adjTri], faceLabel, m_SurfaceMeshFaceLabels + (*adjTri * 2), currentLabel) == true)
-          {
-            //   qDebug() << "Face winding flipped for triangle id = " << *adjTri << " Feature Id: " << currentLabel << "\n";
-          }
-        }
-
-        if(localVisited.find(*adjTri) == localVisited.end() && find(triangleDeque.begin(), triangleDeque.end(), *adjTri) == triangleDeque.end())
-        {
-          // qDebug() << "   # Adding to Deque: " << *adjTri << "\n";
-          triangleDeque.push_back(*adjTri);
-          localVisited.insert(*adjTri);
-          masterVisited[*adjTri] = true;
-        }
-      }
-
-      // Just add the neighbor label to a set so we end up with a list of unique
-      // labels that are neighbors to the current label
-      if(currentLabel != faceLabel[0])
-      {
-        neighborlabels.insert(faceLabel[0], triangleIndex);
-      }
-      if(currentLabel != faceLabel[1])
-      {
-        neighborlabels.insert(faceLabel[1], triangleIndex);
-      }
-
-      localVisited.insert(triangleIndex);
-      masterVisited[triangleIndex] = true;
-      curLdo->m_Faces.remove(triangleIndex);
-      triangleDeque.pop_front();
-    } // End of loop to visit all triangles in the 'currentLabel'
-
-    // Find the Next label to push onto the end of the labels List, but ONLY if it is NOT
-    // currently on the list and NOT currently on the label visited list.
-    for(QMap<int32_t, int32_t>::iterator neigh = neighborlabels.begin(); neigh != neighborlabels.end(); ++neigh)
-    {
-      int32_t triangleIndex = neigh.value();
-      int32_t* triangleLabel = m_SurfaceMeshFaceLabels + triangleIndex * 2;
-
-      if(labelsToVisitSet.find(triangleLabel[0]) == labelsToVisitSet.end() && (labelsVisitedSet.find(triangleLabel[0]) == labelsVisitedSet.end()))
-      {
-        // Push the int32_t value into the "set"
-        labelsToVisitSet.insert(triangleLabel[0]);
-        LabelVisitorInfo::Pointer l = LabelVisitorInfo::New(triangleLabel[0], triangleIndex);
-        labelObjectsToVisit.push_back(l);
-        // qDebug() << "    Adding Label " << triangle.labels[0] << " to visit starting at tIndex " << triangleIndex << "\n";
-      }
-      if(labelsToVisitSet.find(triangleLabel[1]) == labelsToVisitSet.end() && (labelsVisitedSet.find(triangleLabel[1]) == labelsVisitedSet.end()))
-      {
-        // Push the int32_t value into the "set"
-        labelsToVisitSet.insert(triangleLabel[1]);
-        LabelVisitorInfo::Pointer l = LabelVisitorInfo::New(triangleLabel[1], triangleIndex);
-        labelObjectsToVisit.push_back(l);
-        //  qDebug() << "    Adding Label " << triangle.labels[1] << " to visit starting at tIndex " << triangleIndex << "\n";
-      }
-    }
-
-    QSet<int32_t>::size_type nLabelTriEnd = curLdo->m_Faces.size();
-    if(nLabelTriStart == nLabelTriEnd)
-    {
-      // qDebug() << "    !--!++! No new triangles visited for int32_t " << currentLabel << "\n";
-    }
-    else if(nLabelTriEnd == 0)
-    {
-      //  qDebug() << "    No Faces remain to be visited for label " << "\n";
-      // If this currentLabel was the result of a "relabeling" then revert back to the original
-      // label for those triangles.
-      curLdo->revertFaceLabels(m_SurfaceMeshFaceLabelsPtr.lock());
-    }
-    else
-    {
-      // qDebug() << "    Not all triangles visited for label"  << "\n";
-      // qDebug() << "    " << nLabelTriEnd << " Faces Remaining to be visited" << "\n";
-      // At this point relabel the remaining triangles
-      //      if (currentLabel == 28) {
-      //        qDebug() << "break" << "\n";
-      //      }
-      LabelVisitorInfo::Pointer p = curLdo->relabelFaces(mesh, m_SurfaceMeshFaceLabelsPtr.lock(), masterVisited);
-      labelObjectsToVisit.push_back(p);
-      labelsToVisitSet.insert(p->getLabel());
-      // Revert the current labelVisitorObject to its original label
-      curLdo->revertFaceLabels(m_SurfaceMeshFaceLabelsPtr.lock());
-      // qDebug() << "    New label " << mesh->getMaxLabel() << " added to visit" << "\n";
-    }
-
-  } // End of Loop over each int32_t
-
-  // qDebug() << "Total: "<< total << "\n";
-  // qDebug() << "labelsToVisitSet.size() :" << labelsToVisitSet.size() << "\n";
-  if(labelsToVisitSet.size() != 0)
-  {
-    // qDebug() << " labelsToVisitSet:" << "\n";
-    for(STDEXT::hash_set<int32_t>::iterator iter = labelsToVisitSet.begin(); iter != labelsToVisitSet.end(); ++iter)
-    {
-      // qDebug() << "  int32_t: " << *iter << "\n";
-    }
-  }
-  // qDebug() << "labelsVisited.size() :" << labelsVisitedSet.size() << "\n";
-
-  QSet<int32_t> thelabels = TriangleOps::generateUniqueLabels(m_SurfaceMeshFaceLabelsPtr.lock());
-  for(STDEXT::hash_set<int32_t>::iterator iter = labelsVisitedSet.begin(); iter != labelsVisitedSet.end(); ++iter)
-  {
-    thelabels.remove(*iter);
-  }
-
-  // qDebug() << "labels NOT visited:" << "\n";
-  for(QSet<int32_t>::iterator iter = thelabels.begin(); iter != thelabels.end(); ++iter)
-  {
-    // qDebug() << "  int32_t: " << *iter << "\n";
-  }
-
-  // qDebug() << "--------------------------------------------------------------" << "\n";
-  return err;
+  QString version;
+  QTextStream vStream(&version);
+  vStream << SurfaceMeshing::Version::Major() << "." << SurfaceMeshing::Version::Minor() << "." << SurfaceMeshing::Version::Patch();
+  return version;
 }
 
 // -----------------------------------------------------------------------------
@@ -949,30 +256,6 @@ QString VerifyTriangleWinding::ClassName()
   return QString("VerifyTriangleWinding");
 }
 
-// -----------------------------------------------------------------------------
-void VerifyTriangleWinding::setSurfaceDataContainerName(const QString& value)
-{
-  m_SurfaceDataContainerName = value;
-}
-
-// -----------------------------------------------------------------------------
-QString VerifyTriangleWinding::getSurfaceDataContainerName() const
-{
-  return m_SurfaceDataContainerName;
-}
-
-// -----------------------------------------------------------------------------
-void VerifyTriangleWinding::setSurfaceMeshNodeFacesArrayName(const QString& value)
-{
-  m_SurfaceMeshNodeFacesArrayName = value;
-}
-
-// -----------------------------------------------------------------------------
-QString VerifyTriangleWinding::getSurfaceMeshNodeFacesArrayName() const
-{
-  return m_SurfaceMeshNodeFacesArrayName;
-}
-
 // -----------------------------------------------------------------------------
 void VerifyTriangleWinding::setSurfaceMeshFaceLabelsArrayPath(const DataArrayPath& value)
 {
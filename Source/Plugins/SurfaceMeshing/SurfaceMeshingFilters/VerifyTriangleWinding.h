@@ -81,28 +81,6 @@ public:
   static QString ClassName();
 
   ~VerifyTriangleWinding() override;
-  /**
-   * @brief Setter property for SurfaceDataContainerName
-   */
-  void setSurfaceDataContainerName(const QString& value);
-  /**
-   * @brief Getter property for SurfaceDataContainerName
-   * @return Value of SurfaceDataContainerName
-   */
-  QString getSurfaceDataContainerName() const;
-
-  /**
-   * @brief Setter property for SurfaceMeshNodeFacesArrayName
-   */
-  void setSurfaceMeshNodeFacesArrayName(const QString& value);
-  /**
-   * @brief Getter property for SurfaceMeshNodeFacesArrayName
-   * @return Value of SurfaceMeshNodeFacesArrayName
-   */
-  QString getSurfaceMeshNodeFacesArrayName() const;
-
-  typedef QMap<int, QSet<int>> LabelFaceMap_t;
-  typedef QVector<int32_t> FaceList_t;
 
   /**
    * @brief This returns the group that the filter belonds to. You can select
@@ -122,6 +100,20 @@ public:
   Q_PROPERTY(DataArrayPath SurfaceMeshFaceLabelsArrayPath READ getSurfaceMeshFaceLabelsArrayPath WRITE setSurfaceMeshFaceLabelsArrayPath)
 
   QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+   */
+  QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  QString getFilterVersion() const override;
   AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
   QString getGroupName() const override;
   QString getSubGroupName() const override;
@@ -169,36 +161,19 @@ protected:
   void initialize();
 
   /**
-   * @brief This method generates a mapping between a "Label" (Feature Id) and the set of triangles that belong to that
-   * lable value.
-   * @param trianglesToLabelMap
-   */
-  void getLabelTriangelMap(LabelFaceMap_t& trianglesToLabelMap);
-
-  /**
-   * @brief This method verifies the winding of all the triangles and makes them consistent
+   * @brief This method verifies the winding of all the triangles and makes them consistent. The
+   * triangles around each Feature are oriented so that their normals point out of the first Feature
+   * in their Face Labels.
    * @return
    */
   int verifyTriangleWinding();
 
-  /**
-   * @brief VerifyTriangleWinding::getSeedTriangle
-   * @param label
-   * @param triangleIndices
-   * @return
-   */
-  int32_t getSeedTriangle(int32_t label, QSet<int32_t>& triangleIndices);
-
 private:
   std::weak_ptr<DataArray<int32_t>> m_SurfaceMeshFaceLabelsPtr;
   int32_t* m_SurfaceMeshFaceLabels = nullptr;
 
-  QString m_SurfaceDataContainerName = {SIMPL::Defaults::DataContainerName};
-  QString m_SurfaceMeshNodeFacesArrayName = {SIMPL::VertexData::SurfaceMeshNodeFaces};
   DataArrayPath m_SurfaceMeshFaceLabelsArrayPath = {SIMPL::Defaults::DataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels};
 
-  bool m_DoNodeFaceConnectivityFilter;
-
 public:
   VerifyTriangleWinding(const VerifyTriangleWinding&) = delete;            // Copy Constructor Not Implemented
   VerifyTriangleWinding(VerifyTriangleWinding&&) = delete;                 // Move Constructor Not Implemented
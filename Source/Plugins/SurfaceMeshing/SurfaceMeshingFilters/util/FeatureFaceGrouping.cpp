@@ -0,0 +1,433 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FeatureFaceGrouping.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace
+{
+constexpr size_t k_ChunkSize = 1ULL << 16;
+constexpr size_t k_RadixBits = 8;
+constexpr size_t k_RadixBuckets = 1ULL << k_RadixBits;
+constexpr uint32_t k_SignFlip = 0x80000000u;
+
+/**
+ * @brief The PackLabelsImpl class implements a threaded algorithm that packs the label pair of each
+ * triangle into a sort key and stores the triangle id as the value.
+ */
+class PackLabelsImpl
+{
+public:
+  PackLabelsImpl(const int32_t* faceLabels, std::vector<uint64_t>& keys, std::vector<int64_t>& values)
+  : m_FaceLabels(faceLabels)
+  , m_Keys(keys)
+  , m_Values(values)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      m_Keys[t] = FeatureFaceGrouping::PackLabels(m_FaceLabels[t * 2], m_FaceLabels[t * 2 + 1]);
+      m_Values[t] = static_cast<int64_t>(t);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const int32_t* m_FaceLabels = nullptr;
+  std::vector<uint64_t>& m_Keys;
+  std::vector<int64_t>& m_Values;
+};
+
+/**
+ * @brief The RadixHistogramImpl class implements a threaded algorithm that counts the digit values of
+ * each chunk of keys for one radix pass.
+ */
+class RadixHistogramImpl
+{
+public:
+  RadixHistogramImpl(const std::vector<uint64_t>& keys, size_t shift, std::vector<size_t>& chunkCounts)
+  : m_Keys(keys)
+  , m_Shift(shift)
+  , m_ChunkCounts(chunkCounts)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      size_t* counts = m_ChunkCounts.data() + chunk * k_RadixBuckets;
+      std::fill(counts, counts + k_RadixBuckets, 0);
+      size_t last = std::min(m_Keys.size(), (chunk + 1) * k_ChunkSize);
+      for(size_t i = chunk * k_ChunkSize; i < last; i++)
+      {
+        counts[(m_Keys[i] >> m_Shift) & (k_RadixBuckets - 1)]++;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const std::vector<uint64_t>& m_Keys;
+  size_t m_Shift = 0;
+  std::vector<size_t>& m_ChunkCounts;
+};
+
+/**
+ * @brief The RadixScatterImpl class implements a threaded algorithm that moves each chunk of keys and
+ * values to the positions found from the chunk histograms. Each chunk writes its entries in order,
+ * which keeps the pass stable.
+ */
+class RadixScatterImpl
+{
+public:
+  RadixScatterImpl(const std::vector<uint64_t>& keysIn, const std::vector<int64_t>& valuesIn, std::vector<uint64_t>& keysOut, std::vector<int64_t>& valuesOut, size_t shift,
+                   const std::vector<size_t>& chunkOffsets)
+  : m_KeysIn(keysIn)
+  , m_ValuesIn(valuesIn)
+  , m_KeysOut(keysOut)
+  , m_ValuesOut(valuesOut)
+  , m_Shift(shift)
+  , m_ChunkOffsets(chunkOffsets)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    size_t offsets[k_RadixBuckets];
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      std::copy(m_ChunkOffsets.begin() + chunk * k_RadixBuckets, m_ChunkOffsets.begin() + (chunk + 1) * k_RadixBuckets, offsets);
+      size_t last = std::min(m_KeysIn.size(), (chunk + 1) * k_ChunkSize);
+      for(size_t i = chunk * k_ChunkSize; i < last; i++)
+      {
+        size_t& pos = offsets[(m_KeysIn[i] >> m_Shift) & (k_RadixBuckets - 1)];
+        m_KeysOut[pos] = m_KeysIn[i];
+        m_ValuesOut[pos] = m_ValuesIn[i];
+        pos++;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const std::vector<uint64_t>& m_KeysIn;
+  const std::vector<int64_t>& m_ValuesIn;
+  std::vector<uint64_t>& m_KeysOut;
+  std::vector<int64_t>& m_ValuesOut;
+  size_t m_Shift = 0;
+  const std::vector<size_t>& m_ChunkOffsets;
+};
+
+/**
+ * @brief The AssignFacesImpl class implements a threaded algorithm that copies the triangles of each run
+ * of equal keys into the face lists and writes the face id of each triangle.
+ */
+class AssignFacesImpl
+{
+public:
+  AssignFacesImpl(const std::vector<int64_t>& sortedTriangles, const std::vector<size_t>& runStarts, const std::vector<int32_t>& runFaceIds, FeatureFaceGroups& groups,
+                  int32_t* triangleFaceIds)
+  : m_SortedTriangles(sortedTriangles)
+  , m_RunStarts(runStarts)
+  , m_RunFaceIds(runFaceIds)
+  , m_Groups(groups)
+  , m_TriangleFaceIds(triangleFaceIds)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t run = start; run < end; run++)
+    {
+      int32_t faceId = m_RunFaceIds[run];
+      int64_t* faceTriangles = m_Groups.faceTriangles.data() + m_Groups.faceOffsets[faceId];
+      for(size_t i = m_RunStarts[run]; i < m_RunStarts[run + 1]; i++)
+      {
+        int64_t t = m_SortedTriangles[i];
+        *faceTriangles++ = t;
+        m_TriangleFaceIds[t] = faceId;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const std::vector<int64_t>& m_SortedTriangles;
+  const std::vector<size_t>& m_RunStarts;
+  const std::vector<int32_t>& m_RunFaceIds;
+  FeatureFaceGroups& m_Groups;
+  int32_t* m_TriangleFaceIds = nullptr;
+};
+
+/**
+ * @brief The SortNeighborsImpl class implements a threaded algorithm that sorts the neighbor list of each feature.
+ */
+class SortNeighborsImpl
+{
+public:
+  SortNeighborsImpl(const std::vector<int64_t>& neighborOffsets, std::vector<int32_t>& neighbors)
+  : m_NeighborOffsets(neighborOffsets)
+  , m_Neighbors(neighbors)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t f = start; f < end; f++)
+    {
+      std::sort(m_Neighbors.begin() + m_NeighborOffsets[f], m_Neighbors.begin() + m_NeighborOffsets[f + 1]);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const std::vector<int64_t>& m_NeighborOffsets;
+  std::vector<int32_t>& m_Neighbors;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureFaceGrouping::FeatureFaceGrouping() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureFaceGrouping::~FeatureFaceGrouping() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t FeatureFaceGrouping::PackLabels(int32_t label0, int32_t label1)
+{
+  if(label1 < label0)
+  {
+    std::swap(label0, label1);
+  }
+  // Flipping the sign bit maps the signed labels onto unsigned values in the same order
+  return (static_cast<uint64_t>(static_cast<uint32_t>(label0) ^ k_SignFlip) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(label1) ^ k_SignFlip);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureFaceGrouping::RadixSort(std::vector<uint64_t>& keys, std::vector<int64_t>& values)
+{
+  size_t numKeys = keys.size();
+  size_t numChunks = (numKeys + k_ChunkSize - 1) / k_ChunkSize;
+  std::vector<size_t> chunkCounts(numChunks * k_RadixBuckets, 0);
+  std::vector<size_t> chunkOffsets(numChunks * k_RadixBuckets, 0);
+  std::vector<uint64_t> keysTemp(numKeys);
+  std::vector<int64_t> valuesTemp(numKeys);
+
+  for(size_t shift = 0; shift < 64; shift += k_RadixBits)
+  {
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numChunks);
+      dataAlg.execute(RadixHistogramImpl(keys, shift, chunkCounts));
+    }
+
+    // Bucket major, chunk minor prefix sum. A pass where every key has the same digit is skipped, which
+    // removes most of the passes since feature labels rarely use their upper bits.
+    size_t offset = 0;
+    bool singleBucket = false;
+    for(size_t bucket = 0; bucket < k_RadixBuckets; bucket++)
+    {
+      size_t bucketStart = offset;
+      for(size_t chunk = 0; chunk < numChunks; chunk++)
+      {
+        chunkOffsets[chunk * k_RadixBuckets + bucket] = offset;
+        offset += chunkCounts[chunk * k_RadixBuckets + bucket];
+      }
+      if(offset - bucketStart == numKeys)
+      {
+        singleBucket = true;
+      }
+    }
+    if(singleBucket)
+    {
+      continue;
+    }
+
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numChunks);
+      dataAlg.execute(RadixScatterImpl(keys, values, keysTemp, valuesTemp, shift, chunkOffsets));
+    }
+    keys.swap(keysTemp);
+    values.swap(valuesTemp);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureFaceGrouping::GroupFeatureFaces(const int32_t* faceLabels, size_t numTriangles, int32_t* triangleFaceIds, FeatureFaceGroups& groups)
+{
+  std::vector<uint64_t> keys(numTriangles);
+  std::vector<int64_t> sortedTriangles(numTriangles);
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numTriangles);
+    dataAlg.execute(PackLabelsImpl(faceLabels, keys, sortedTriangles));
+  }
+  RadixSort(keys, sortedTriangles);
+
+  // Each run of equal keys is one face. The sort is stable, so the first triangle of a run is the
+  // triangle where that label pair first appears.
+  std::vector<size_t> runStarts;
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    if(i == 0 || keys[i] != keys[i - 1])
+    {
+      runStarts.push_back(i);
+    }
+  }
+  size_t numRuns = runStarts.size();
+  runStarts.push_back(numTriangles);
+
+  std::vector<size_t> runOrder(numRuns);
+  std::iota(runOrder.begin(), runOrder.end(), 0);
+  std::sort(runOrder.begin(), runOrder.end(), [&](size_t a, size_t b) { return sortedTriangles[runStarts[a]] < sortedTriangles[runStarts[b]]; });
+
+  std::vector<int32_t> runFaceIds(numRuns, 0);
+  groups.faceLabels.assign((numRuns + 1) * 2, 0);
+  groups.faceOffsets.assign(numRuns + 2, 0);
+  for(size_t k = 0; k < numRuns; k++)
+  {
+    size_t run = runOrder[k];
+    int32_t faceId = static_cast<int32_t>(k + 1);
+    uint64_t key = keys[runStarts[run]];
+    runFaceIds[run] = faceId;
+    groups.faceLabels[faceId * 2] = static_cast<int32_t>(static_cast<uint32_t>(key >> 32) ^ k_SignFlip);
+    groups.faceLabels[faceId * 2 + 1] = static_cast<int32_t>(static_cast<uint32_t>(key) ^ k_SignFlip);
+    groups.faceOffsets[faceId + 1] = groups.faceOffsets[faceId] + static_cast<int64_t>(runStarts[run + 1] - runStarts[run]);
+  }
+
+  groups.faceTriangles.resize(numTriangles);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRuns);
+  dataAlg.execute(AssignFacesImpl(sortedTriangles, runStarts, runFaceIds, groups, triangleFaceIds));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureFaceGrouping::FindFeatureNeighbors(const FeatureFaceGroups& groups, size_t numFeatures, std::vector<int64_t>& neighborOffsets, std::vector<int32_t>& neighbors)
+{
+  size_t numFaces = groups.faceLabels.size() / 2;
+  auto validLabel = [numFeatures](int32_t label) { return label > 0 && static_cast<size_t>(label) < numFeatures; };
+
+  // Every face is a distinct label pair, so counting each face once per feature gives unique neighbors
+  neighborOffsets.assign(numFeatures + 1, 0);
+  for(size_t f = 1; f < numFaces; f++)
+  {
+    int32_t label0 = groups.faceLabels[f * 2];
+    int32_t label1 = groups.faceLabels[f * 2 + 1];
+    if(validLabel(label0) && validLabel(label1))
+    {
+      neighborOffsets[label0 + 1]++;
+      if(label1 != label0)
+      {
+        neighborOffsets[label1 + 1]++;
+      }
+    }
+  }
+  for(size_t i = 0; i < numFeatures; i++)
+  {
+    neighborOffsets[i + 1] += neighborOffsets[i];
+  }
+
+  neighbors.resize(static_cast<size_t>(neighborOffsets[numFeatures]));
+  std::vector<int64_t> fill(neighborOffsets.begin(), neighborOffsets.end() - 1);
+  for(size_t f = 1; f < numFaces; f++)
+  {
+    int32_t label0 = groups.faceLabels[f * 2];
+    int32_t label1 = groups.faceLabels[f * 2 + 1];
+    if(validLabel(label0) && validLabel(label1))
+    {
+      neighbors[fill[label0]++] = label1;
+      if(label1 != label0)
+      {
+        neighbors[fill[label1]++] = label0;
+      }
+    }
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numFeatures);
+  dataAlg.execute(SortNeighborsImpl(neighborOffsets, neighbors));
+}
@@ -0,0 +1,105 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The FeatureFaceGroups struct holds the shared feature faces of a triangle mesh in CSR form. Face 0
+ * is a placeholder with no triangles so that the face ids can be used directly as tuple indices.
+ */
+struct FeatureFaceGroups
+{
+  std::vector<int32_t> faceLabels;    // Two feature labels per face, smaller label first
+  std::vector<int64_t> faceOffsets;   // The triangles of face f are faceTriangles[faceOffsets[f]] to faceTriangles[faceOffsets[f + 1] - 1]
+  std::vector<int64_t> faceTriangles; // Triangle ids grouped by face, in increasing order within each face
+};
+
+/**
+ * @brief The FeatureFaceGrouping class groups the triangles of a mesh by the unordered pair of feature labels
+ * they separate. The label pairs are packed into 64 bit keys and ordered with a parallel radix sort, so no map
+ * lookups are needed per triangle.
+ */
+class FeatureFaceGrouping
+{
+public:
+  virtual ~FeatureFaceGrouping();
+
+  /**
+   * @brief PackLabels Packs an unordered pair of feature labels into a key whose unsigned order matches the
+   * signed order of (smaller label, larger label)
+   */
+  static uint64_t PackLabels(int32_t label0, int32_t label1);
+
+  /**
+   * @brief RadixSort Sorts the keys in place and applies the same permutation to the values. The sort is
+   * stable, so equal keys keep the order of their values.
+   * @param keys
+   * @param values
+   */
+  static void RadixSort(std::vector<uint64_t>& keys, std::vector<int64_t>& values);
+
+  /**
+   * @brief GroupFeatureFaces Assigns a face id to each triangle. Face ids start at 1 and are numbered in the
+   * order in which each label pair first appears in the triangle list.
+   * @param faceLabels The two feature labels of each triangle
+   * @param numTriangles
+   * @param triangleFaceIds Output face id of each triangle
+   * @param groups Output faces
+   */
+  static void GroupFeatureFaces(const int32_t* faceLabels, size_t numTriangles, int32_t* triangleFaceIds, FeatureFaceGroups& groups);
+
+  /**
+   * @brief FindFeatureNeighbors Builds the sorted list of neighboring features of each feature from the faces.
+   * Only labels in [1, numFeatures) are used.
+   * @param groups The faces found by GroupFeatureFaces
+   * @param numFeatures
+   * @param neighborOffsets Output CSR offsets, one more than the number of features
+   * @param neighbors Output neighbor feature ids
+   */
+  static void FindFeatureNeighbors(const FeatureFaceGroups& groups, size_t numFeatures, std::vector<int64_t>& neighborOffsets, std::vector<int32_t>& neighbors);
+
+protected:
+  FeatureFaceGrouping();
+
+public:
+  FeatureFaceGrouping(const FeatureFaceGrouping&) = delete;            // Copy Constructor Not Implemented
+  FeatureFaceGrouping(FeatureFaceGrouping&&) = delete;                 // Move Constructor Not Implemented
+  FeatureFaceGrouping& operator=(const FeatureFaceGrouping&) = delete; // Copy Assignment Not Implemented
+  FeatureFaceGrouping& operator=(FeatureFaceGrouping&&) = delete;      // Move Assignment Not Implemented
+};
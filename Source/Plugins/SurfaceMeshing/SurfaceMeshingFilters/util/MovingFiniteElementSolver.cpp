@@ -0,0 +1,752 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "MovingFiniteElementSolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleWinding.h"
+
+namespace
+{
+// Nodes are processed in fixed chunks so that the partial sums, and therefore the results, do not depend on
+// how the chunks are spread over the threads
+constexpr size_t k_ChunkSize = 4096;
+
+const double k_AreaScale = 4000.0;
+const double k_TripleLineScale = 19000.0; //  arbitrary choice for triple line smoothing !
+const double k_Epsilon = 1.0;
+const double k_Small = 1.0e-12;
+const double k_Large = 1.0e+50;
+const double k_One12th = 1.0 / 12.0;
+const double k_BoundaryTolerance = 1.0e-5;
+const int k_MaxSolverIterations = 4000;
+const double k_SolverTolerance = 1.0e-5;
+
+/**
+ * @brief The TriangleGeometry struct holds the area, circularity and unit normal of a triangle
+ */
+struct TriangleGeometry
+{
+  double area = 0.0;
+  double quality = 0.0;
+  double normal[3] = {0.0, 0.0, 0.0};
+};
+
+// -----------------------------------------------------------------------------
+double distance(const double* p0, const double* p1)
+{
+  double dx = p1[0] - p0[0];
+  double dy = p1[1] - p0[1];
+  double dz = p1[2] - p0[2];
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// -----------------------------------------------------------------------------
+double triangleArea(const double p[3][3], double* normal = nullptr)
+{
+  double a[3] = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+  double b[3] = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+  double c[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+  double norm = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+  if(normal != nullptr)
+  {
+    double rnorm = norm > 0.0 ? 1.0 / norm : 1.0;
+    normal[0] = c[0] * rnorm;
+    normal[1] = c[1] * rnorm;
+    normal[2] = c[2] * rnorm;
+  }
+  return 0.5 * norm;
+}
+
+// -----------------------------------------------------------------------------
+double triangleCircularity(const double p[3][3], double area)
+{
+  double a = distance(p[0], p[1]);
+  double b = distance(p[1], p[2]);
+  double c = distance(p[2], p[0]);
+  double s = 0.5 * (a + b + c); //  1/2 perimeter
+  double r = area / s;
+  double R = a * b * c / 4.0 / area;
+  return R / r;
+}
+
+// -----------------------------------------------------------------------------
+double tripleLineLength(const double* nodes, const int64_t* neighbors, const double* position)
+{
+  return distance(position, nodes + neighbors[0] * 3) + distance(nodes + neighbors[1] * 3, position);
+}
+
+// -----------------------------------------------------------------------------
+size_t chunkCount(size_t numNodes)
+{
+  return (numNodes + k_ChunkSize - 1) / k_ChunkSize;
+}
+
+/**
+ * @brief The BlockPatternImpl class implements a threaded algorithm that finds the nodes each node shares a
+ * triangle with. The first pass counts the blocks of each row of the stiffness matrix and the second pass fills
+ * in their columns.
+ */
+class BlockPatternImpl
+{
+public:
+  BlockPatternImpl(const MeshIndexType* triangles, MovingFiniteElementMesh& mesh, bool fill)
+  : m_Triangles(triangles)
+  , m_Mesh(mesh)
+  , m_Fill(fill)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<int64_t> columns;
+    for(size_t n = start; n < end; n++)
+    {
+      columns.clear();
+      columns.push_back(static_cast<int64_t>(n));
+      for(int64_t e = m_Mesh.nodeOffsets[n]; e < m_Mesh.nodeOffsets[n + 1]; e++)
+      {
+        const MeshIndexType* tri = m_Triangles + (m_Mesh.nodeCorners[e] / 3) * 3;
+        columns.insert(columns.end(), {static_cast<int64_t>(tri[0]), static_cast<int64_t>(tri[1]), static_cast<int64_t>(tri[2])});
+      }
+      std::sort(columns.begin(), columns.end());
+      columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+      if(!m_Fill)
+      {
+        m_Mesh.blockOffsets[n + 1] = static_cast<int64_t>(columns.size());
+        continue;
+      }
+
+      int64_t rowStart = m_Mesh.blockOffsets[n];
+      std::copy(columns.begin(), columns.end(), m_Mesh.blockColumns.begin() + rowStart);
+      auto blockOf = [&columns, rowStart](int64_t node) { return rowStart + (std::lower_bound(columns.begin(), columns.end(), node) - columns.begin()); };
+      m_Mesh.diagonalBlocks[n] = blockOf(static_cast<int64_t>(n));
+      for(int64_t e = m_Mesh.nodeOffsets[n]; e < m_Mesh.nodeOffsets[n + 1]; e++)
+      {
+        const MeshIndexType* tri = m_Triangles + (m_Mesh.nodeCorners[e] / 3) * 3;
+        for(int64_t b = 0; b < 3; b++)
+        {
+          m_Mesh.cornerBlocks[e * 3 + b] = blockOf(static_cast<int64_t>(tri[b]));
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const MeshIndexType* m_Triangles = nullptr;
+  MovingFiniteElementMesh& m_Mesh;
+  bool m_Fill = false;
+};
+
+/**
+ * @brief The AssembleImpl class implements a threaded algorithm that computes the force on each node and its
+ * row of the stiffness matrix from the triangles around it. Only the entries of the node itself are written.
+ */
+class AssembleImpl
+{
+public:
+  AssembleImpl(const MeshIndexType* triangles, const double* nodes, double qualityScale, MovingFiniteElementMesh& mesh)
+  : m_Triangles(triangles)
+  , m_Nodes(nodes)
+  , m_QualityScale(qualityScale)
+  , m_Mesh(mesh)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t n = start; n < end; n++)
+    {
+      assembleNode(static_cast<int64_t>(n));
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const MeshIndexType* m_Triangles = nullptr;
+  const double* m_Nodes = nullptr;
+  double m_QualityScale = 0.0;
+  MovingFiniteElementMesh& m_Mesh;
+
+  // -----------------------------------------------------------------------------
+  void assembleNode(int64_t n) const
+  {
+    double* force = m_Mesh.forces.data() + n * 3;
+    force[0] = force[1] = force[2] = 0.0;
+    double* row = m_Mesh.blockValues.data() + m_Mesh.blockOffsets[n] * 9;
+    std::fill(row, row + (m_Mesh.blockOffsets[n + 1] - m_Mesh.blockOffsets[n]) * 9, 0.0);
+
+    // The change in triple line length does not depend on the triangle, so it is found once per coordinate
+    double lineChange[3] = {0.0, 0.0, 0.0};
+    bool tripleLine = (m_Mesh.nodeMasks[n] & MovingFiniteElementMesh::TripleLine) != 0;
+    if(tripleLine)
+    {
+      const int64_t* neighbors = m_Mesh.tripleNeighbors.data() + n * 2;
+      double length = tripleLineLength(m_Nodes, neighbors, m_Nodes + n * 3);
+      for(size_t j = 0; j < 3; j++)
+      {
+        double moved[3] = {m_Nodes[n * 3], m_Nodes[n * 3 + 1], m_Nodes[n * 3 + 2]};
+        moved[j] += k_Small;
+        lineChange[j] = tripleLineLength(m_Nodes, neighbors, moved) - length;
+      }
+    }
+
+    for(int64_t e = m_Mesh.nodeOffsets[n]; e < m_Mesh.nodeOffsets[n + 1]; e++)
+    {
+      int64_t t = m_Mesh.nodeCorners[e] / 3;
+      int64_t corner = m_Mesh.nodeCorners[e] % 3;
+      const MeshIndexType* tri = m_Triangles + t * 3;
+      double p[3][3];
+      for(size_t v = 0; v < 3; v++)
+      {
+        std::copy(m_Nodes + tri[v] * 3, m_Nodes + tri[v] * 3 + 3, p[v]);
+      }
+      TriangleGeometry geom;
+      geom.area = triangleArea(p, geom.normal);
+      geom.quality = triangleCircularity(p, geom.area);
+      if(corner == 0)
+      {
+        m_Mesh.triangleQualities[t] = geom.quality;
+      }
+
+      // Finite difference of the area and quality energies with respect to each coordinate of the node
+      for(size_t j = 0; j < 3; j++)
+      {
+        double moved[3][3];
+        std::copy(&p[0][0], &p[0][0] + 9, &moved[0][0]);
+        moved[corner][j] += k_Small;
+        double movedArea = triangleArea(moved);
+        double movedQuality = triangleCircularity(moved, movedArea);
+        force[j] -= (k_AreaScale * (movedArea - geom.area) + m_QualityScale * (movedQuality - geom.quality) * geom.area) / k_Small;
+        if(tripleLine)
+        {
+          force[j] -= k_TripleLineScale * lineChange[j];
+        }
+      }
+
+      for(int64_t b = 0; b < 3; b++)
+      {
+        double* block = m_Mesh.blockValues.data() + m_Mesh.cornerBlocks[e * 3 + b] * 9;
+        double scale = k_One12th * (static_cast<int64_t>(tri[b]) == n ? 2.0 : 1.0) * geom.area;
+        for(size_t k = 0; k < 3; k++)
+        {
+          for(size_t j = 0; j < 3; j++)
+          {
+            block[k * 3 + j] += scale * geom.normal[j] * geom.normal[k];
+          }
+        }
+      }
+    }
+
+    double* diagonal = m_Mesh.blockValues.data() + m_Mesh.diagonalBlocks[n] * 9;
+    for(size_t s = 0; s < 3; s++)
+    {
+      diagonal[s * 4] += k_Epsilon;
+      if((m_Mesh.nodeMasks[n] & (1 << s)) != 0)
+      {
+        diagonal[s * 4] = k_Large;
+      }
+    }
+  }
+};
+
+/**
+ * @brief The MultiplyImpl class implements a threaded algorithm that multiplies a vector by the stiffness
+ * matrix and sums the products of the input and output vectors for each chunk of nodes.
+ */
+class MultiplyImpl
+{
+public:
+  MultiplyImpl(const MovingFiniteElementMesh& mesh, size_t numNodes, const std::vector<double>& input, std::vector<double>& output, std::vector<double>& partialSums)
+  : m_Mesh(mesh)
+  , m_NumNodes(numNodes)
+  , m_Input(input)
+  , m_Output(output)
+  , m_PartialSums(partialSums)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t c = start; c < end; c++)
+    {
+      double sum = 0.0;
+      size_t last = std::min((c + 1) * k_ChunkSize, m_NumNodes);
+      for(size_t n = c * k_ChunkSize; n < last; n++)
+      {
+        double y[3] = {0.0, 0.0, 0.0};
+        for(int64_t b = m_Mesh.blockOffsets[n]; b < m_Mesh.blockOffsets[n + 1]; b++)
+        {
+          const double* block = m_Mesh.blockValues.data() + b * 9;
+          const double* x = m_Input.data() + m_Mesh.blockColumns[b] * 3;
+          for(size_t k = 0; k < 3; k++)
+          {
+            y[k] += block[k * 3] * x[0] + block[k * 3 + 1] * x[1] + block[k * 3 + 2] * x[2];
+          }
+        }
+        for(size_t k = 0; k < 3; k++)
+        {
+          m_Output[n * 3 + k] = y[k];
+          sum += m_Input[n * 3 + k] * y[k];
+        }
+      }
+      m_PartialSums[c] = sum;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const MovingFiniteElementMesh& m_Mesh;
+  size_t m_NumNodes = 0;
+  const std::vector<double>& m_Input;
+  std::vector<double>& m_Output;
+  std::vector<double>& m_PartialSums;
+};
+
+/**
+ * @brief The AxpyImpl class implements a threaded algorithm that computes y = a * x + b * y for up to two pairs of
+ * vectors and sums the squares of the first result for each chunk of nodes.
+ */
+class AxpyImpl
+{
+public:
+  AxpyImpl(size_t numNodes, double a, double b, const std::vector<double>& x0, std::vector<double>& y0, const std::vector<double>* x1, std::vector<double>* y1, double c, double d,
+           std::vector<double>& partialSums)
+  : m_NumNodes(numNodes)
+  , m_A(a)
+  , m_B(b)
+  , m_X0(x0)
+  , m_Y0(y0)
+  , m_X1(x1)
+  , m_Y1(y1)
+  , m_C(c)
+  , m_D(d)
+  , m_PartialSums(partialSums)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t c = start; c < end; c++)
+    {
+      double sum = 0.0;
+      size_t last = std::min((c + 1) * k_ChunkSize, m_NumNodes) * 3;
+      for(size_t i = c * k_ChunkSize * 3; i < last; i++)
+      {
+        // A zero b overwrites y without reading it
+        m_Y0[i] = m_B == 0.0 ? m_A * m_X0[i] : m_A * m_X0[i] + m_B * m_Y0[i];
+        sum += m_Y0[i] * m_Y0[i];
+        if(m_Y1 != nullptr)
+        {
+          (*m_Y1)[i] = m_C * (*m_X1)[i] + m_D * (*m_Y1)[i];
+        }
+      }
+      m_PartialSums[c] = sum;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  size_t m_NumNodes = 0;
+  double m_A = 0.0;
+  double m_B = 0.0;
+  const std::vector<double>& m_X0;
+  std::vector<double>& m_Y0;
+  const std::vector<double>* m_X1 = nullptr;
+  std::vector<double>* m_Y1 = nullptr;
+  double m_C = 0.0;
+  double m_D = 0.0;
+  std::vector<double>& m_PartialSums;
+};
+
+/**
+ * @brief The MoveNodesImpl class implements a threaded algorithm that moves the unconstrained coordinates of each
+ * node along its velocity and finds the largest displacement and the number of held coordinates for each chunk of
+ * nodes.
+ */
+class MoveNodesImpl
+{
+public:
+  MoveNodesImpl(size_t numNodes, const MovingFiniteElementMesh& mesh, double* nodes, std::vector<double>& partialMax, std::vector<size_t>& partialHeld)
+  : m_NumNodes(numNodes)
+  , m_Mesh(mesh)
+  , m_Nodes(nodes)
+  , m_PartialMax(partialMax)
+  , m_PartialHeld(partialHeld)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    double dt = m_Mesh.timeStep;
+    for(size_t c = start; c < end; c++)
+    {
+      double maxDisplacement = 0.0;
+      size_t held = 0;
+      size_t last = std::min((c + 1) * k_ChunkSize, m_NumNodes);
+      for(size_t n = c * k_ChunkSize; n < last; n++)
+      {
+        for(size_t s = 0; s < 3; s++)
+        {
+          // A coordinate that would move by more than a unit in one step is held in place
+          double velocity = m_Mesh.velocities[n * 3 + s];
+          if((m_Mesh.nodeMasks[n] & (1 << s)) != 0)
+          {
+            continue;
+          }
+          if(std::fabs(dt * velocity) >= 1.0)
+          {
+            held++;
+            continue;
+          }
+          m_Nodes[n * 3 + s] += dt * velocity;
+          maxDisplacement = std::max(maxDisplacement, std::fabs(dt * velocity));
+        }
+      }
+      m_PartialMax[c] = maxDisplacement;
+      m_PartialHeld[c] = held;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  size_t m_NumNodes = 0;
+  const MovingFiniteElementMesh& m_Mesh;
+  double* m_Nodes = nullptr;
+  std::vector<double>& m_PartialMax;
+  std::vector<size_t>& m_PartialHeld;
+};
+
+// -----------------------------------------------------------------------------
+double sumOf(const std::vector<double>& partialSums)
+{
+  return std::accumulate(partialSums.begin(), partialSums.end(), 0.0);
+}
+
+// -----------------------------------------------------------------------------
+double multiply(MovingFiniteElementMesh& mesh, size_t numNodes, const std::vector<double>& input, std::vector<double>& output)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, chunkCount(numNodes));
+  dataAlg.execute(MultiplyImpl(mesh, numNodes, input, output, mesh.partialSums));
+  return sumOf(mesh.partialSums);
+}
+
+// -----------------------------------------------------------------------------
+double axpy(MovingFiniteElementMesh& mesh, size_t numNodes, double a, double b, const std::vector<double>& x0, std::vector<double>& y0, const std::vector<double>* x1 = nullptr,
+            std::vector<double>* y1 = nullptr, double c = 0.0, double d = 0.0)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, chunkCount(numNodes));
+  dataAlg.execute(AxpyImpl(numNodes, a, b, x0, y0, x1, y1, c, d, mesh.partialSums));
+  return sumOf(mesh.partialSums);
+}
+
+/**
+ * @brief solveVelocities Solves K v = F with the conjugate residual method, starting from the velocities of the
+ * previous step
+ * @return The number of iterations, 0 if the starting guess was already good enough, or -1 if the solve did
+ * not converge
+ */
+int solveVelocities(MovingFiniteElementMesh& mesh, size_t numNodes)
+{
+  std::vector<double>& x = mesh.velocities;
+  std::vector<double>& r = mesh.residual;
+  std::vector<double>& p = mesh.direction;
+  std::vector<double>& Ar = mesh.residualProduct;
+  std::vector<double>& Ap = mesh.directionProduct;
+
+  // r = F - K x
+  double bnorm = std::sqrt(axpy(mesh, numNodes, 1.0, 0.0, mesh.forces, r));
+  multiply(mesh, numNodes, x, Ar);
+  double rnorm = std::sqrt(axpy(mesh, numNodes, -1.0, 1.0, Ar, r));
+  if(bnorm == 0.0)
+  {
+    std::fill(x.begin(), x.end(), 0.0);
+    return 0;
+  }
+  if((rnorm / bnorm) <= k_SolverTolerance)
+  {
+    return 0;
+  }
+
+  axpy(mesh, numNodes, 1.0, 0.0, r, p);
+  double inner1 = multiply(mesh, numNodes, r, Ar);
+  double ApAp = axpy(mesh, numNodes, 1.0, 0.0, Ar, Ap);
+
+  for(int iteration = 1; iteration <= k_MaxSolverIterations; iteration++)
+  {
+    double alpha = inner1 / ApAp;
+    axpy(mesh, numNodes, alpha, 1.0, p, x);
+    rnorm = std::sqrt(axpy(mesh, numNodes, -alpha, 1.0, Ap, r));
+    if(rnorm / bnorm < k_SolverTolerance)
+    {
+      return iteration;
+    }
+    double inner2 = multiply(mesh, numNodes, r, Ar);
+    double beta = inner2 / inner1;
+    inner1 = inner2;
+    // Ap = Ar + beta * Ap must be summed for the next step, while p = r + beta * p comes along
+    ApAp = axpy(mesh, numNodes, 1.0, beta, Ar, Ap, &r, &p, 1.0, beta);
+  }
+
+  return -1;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MovingFiniteElementSolver::MovingFiniteElementSolver() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MovingFiniteElementSolver::~MovingFiniteElementSolver() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MovingFiniteElementSolver::BuildMesh(const MeshIndexType* triangles, size_t numTriangles, const double* nodes, size_t numNodes, const int8_t* nodeTypes, bool constrainBoundary,
+                                          bool constrainSurfaceNodes, bool constrainQuadPoints, bool smoothTripleLines, MovingFiniteElementMesh& mesh)
+{
+  // Find the minimum and maximum dimension of the data
+  double min[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+  double max[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+  for(size_t i = 0; i < numNodes; i++)
+  {
+    for(size_t j = 0; j < 3; j++)
+    {
+      min[j] = std::min(min[j], nodes[i * 3 + j]);
+      max[j] = std::max(max[j], nodes[i * 3 + j]);
+    }
+  }
+  // time step, change if mesh moves too much, little
+  mesh.timeStep = (40.0e-6) * (10 / max[1]);
+
+  // Nodes on a face of the bounding box may only move in the plane of that face, or not at all when surface
+  // nodes are constrained. Quad points are held in all 3 coordinates.
+  mesh.nodeMasks.assign(numNodes, 0);
+  for(size_t r = 0; r < numNodes; r++)
+  {
+    uint8_t mask = 0;
+    if(constrainBoundary)
+    {
+      for(size_t j = 0; j < 3; j++)
+      {
+        if(std::fabs(nodes[r * 3 + j] - max[j]) < k_BoundaryTolerance || std::fabs(nodes[r * 3 + j] - min[j]) < k_BoundaryTolerance)
+        {
+          mask |= static_cast<uint8_t>(1 << j);
+        }
+      }
+      if(constrainSurfaceNodes && mask != 0)
+      {
+        mask = MovingFiniteElementMesh::ConstrainX | MovingFiniteElementMesh::ConstrainY | MovingFiniteElementMesh::ConstrainZ;
+      }
+    }
+    if(constrainQuadPoints && nodeTypes[r] == SIMPL::SurfaceMesh::NodeType::QuadPoint)
+    {
+      mask = MovingFiniteElementMesh::ConstrainX | MovingFiniteElementMesh::ConstrainY | MovingFiniteElementMesh::ConstrainZ;
+    }
+    mesh.nodeMasks[r] = mask;
+  }
+
+  // Group the triangle corners by node
+  mesh.nodeOffsets.assign(numNodes + 1, 0);
+  for(size_t c = 0; c < numTriangles * 3; c++)
+  {
+    mesh.nodeOffsets[triangles[c] + 1]++;
+  }
+  std::partial_sum(mesh.nodeOffsets.begin(), mesh.nodeOffsets.end(), mesh.nodeOffsets.begin());
+  mesh.nodeCorners.resize(numTriangles * 3);
+  std::vector<int64_t> fill(mesh.nodeOffsets.begin(), mesh.nodeOffsets.end() - 1);
+  for(size_t c = 0; c < numTriangles * 3; c++)
+  {
+    mesh.nodeCorners[fill[triangles[c]]++] = static_cast<int64_t>(c);
+  }
+
+  // Each node is coupled to itself and to every node it shares a triangle with
+  mesh.blockOffsets.assign(numNodes + 1, 0);
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numNodes);
+    dataAlg.execute(BlockPatternImpl(triangles, mesh, false));
+  }
+  std::partial_sum(mesh.blockOffsets.begin(), mesh.blockOffsets.end(), mesh.blockOffsets.begin());
+  mesh.blockColumns.resize(static_cast<size_t>(mesh.blockOffsets.back()));
+  mesh.cornerBlocks.resize(numTriangles * 9);
+  mesh.diagonalBlocks.resize(numNodes);
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numNodes);
+    dataAlg.execute(BlockPatternImpl(triangles, mesh, true));
+  }
+
+  // A triple line runs along the edges shared by 3 or more triangles. A triple line node is only smoothed along
+  // the line when it has exactly 2 such neighbors.
+  mesh.tripleNeighbors.assign(numNodes * 2, -1);
+  if(smoothTripleLines)
+  {
+    TriangleEdgeMap edges;
+    TriangleWinding::BuildEdgeMap(triangles, numTriangles, edges);
+    std::vector<uint8_t> lineCounts(numNodes, 0);
+    for(size_t e = 0; e + 1 < edges.edgeOffsets.size(); e++)
+    {
+      if(edges.edgeOffsets[e + 1] - edges.edgeOffsets[e] < 3)
+      {
+        continue;
+      }
+      int64_t h = edges.halfEdges[edges.edgeOffsets[e]];
+      MeshIndexType ends[2] = {triangles[h], triangles[(h / 3) * 3 + (h + 1) % 3]};
+      for(size_t k = 0; k < 2; k++)
+      {
+        MeshIndexType node = ends[k];
+        if(nodeTypes[node] != SIMPL::SurfaceMesh::NodeType::TriplePoint && nodeTypes[node] != SIMPL::SurfaceMesh::NodeType::SurfaceTriplePoint)
+        {
+          continue;
+        }
+        if(lineCounts[node] < 2)
+        {
+          mesh.tripleNeighbors[node * 2 + lineCounts[node]] = static_cast<int64_t>(ends[1 - k]);
+        }
+        lineCounts[node] = std::min<uint8_t>(lineCounts[node] + 1, 3);
+      }
+    }
+    for(size_t n = 0; n < numNodes; n++)
+    {
+      if(lineCounts[n] == 2)
+      {
+        mesh.nodeMasks[n] |= MovingFiniteElementMesh::TripleLine;
+      }
+    }
+  }
+
+  mesh.blockValues.assign(mesh.blockColumns.size() * 9, 0.0);
+  mesh.forces.assign(numNodes * 3, 0.0);
+  mesh.velocities.assign(numNodes * 3, 0.0);
+  mesh.residual.assign(numNodes * 3, 0.0);
+  mesh.direction.assign(numNodes * 3, 0.0);
+  mesh.residualProduct.assign(numNodes * 3, 0.0);
+  mesh.directionProduct.assign(numNodes * 3, 0.0);
+  mesh.triangleQualities.assign(numTriangles, 0.0);
+  mesh.partialSums.assign(chunkCount(numNodes), 0.0);
+  mesh.partialCounts.assign(chunkCount(numNodes), 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MovingFiniteElementStep MovingFiniteElementSolver::UpdateNodes(const MeshIndexType* triangles, size_t numTriangles, double qualityScale, double* nodes, MovingFiniteElementMesh& mesh)
+{
+  size_t numNodes = mesh.nodeMasks.size();
+  MovingFiniteElementStep step;
+  if(numNodes == 0)
+  {
+    return step;
+  }
+
+  // The forces and the stiffness matrix are rebuilt from the current node positions
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numNodes);
+    dataAlg.execute(AssembleImpl(triangles, nodes, qualityScale, mesh));
+  }
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    step.maxQuality = std::max(step.maxQuality, mesh.triangleQualities[t]);
+    step.averageQuality += mesh.triangleQualities[t];
+  }
+  step.averageQuality = numTriangles > 0 ? step.averageQuality / numTriangles : 0.0;
+
+  // solve for node velocities
+  step.solverIterations = solveVelocities(mesh, numNodes);
+  if(step.solverIterations < 0)
+  {
+    // The velocities of a diverged solve are not used, and must not be the starting guess of the next solve either
+    std::fill(mesh.velocities.begin(), mesh.velocities.end(), 0.0);
+    return step;
+  }
+
+  // update node positions
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, chunkCount(numNodes));
+    dataAlg.execute(MoveNodesImpl(numNodes, mesh, nodes, mesh.partialSums, mesh.partialCounts));
+  }
+  step.maxDisplacement = *std::max_element(mesh.partialSums.begin(), mesh.partialSums.end());
+  step.heldCoordinates = std::accumulate(mesh.partialCounts.begin(), mesh.partialCounts.end(), static_cast<size_t>(0));
+
+  return step;
+}
@@ -0,0 +1,141 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/Geometry/IGeometry.h"
+
+/**
+ * @brief The MovingFiniteElementMesh struct caches the connectivity of a triangle mesh that is smoothed with the
+ * moving finite element method. Everything in it depends only on the triangles and the starting node positions,
+ * so it is built once and reused by every update step.
+ */
+struct MovingFiniteElementMesh
+{
+  enum NodeMask : uint8_t
+  {
+    ConstrainX = 1,
+    ConstrainY = 2,
+    ConstrainZ = 4,
+    TripleLine = 8
+  };
+
+  std::vector<int64_t> nodeOffsets;     // The corners of node n are nodeCorners[nodeOffsets[n]] to nodeCorners[nodeOffsets[n + 1] - 1]
+  std::vector<int64_t> nodeCorners;     // Corner ids (triangle * 3 + corner) grouped by node
+  std::vector<int64_t> cornerBlocks;    // For each entry of nodeCorners, the blocks that couple the node to the 3 nodes of the triangle
+  std::vector<int64_t> blockOffsets;    // The blocks of row n are blockOffsets[n] to blockOffsets[n + 1] - 1
+  std::vector<int64_t> blockColumns;    // The node of each 3x3 block of the stiffness matrix
+  std::vector<int64_t> diagonalBlocks;  // The block that couples each node to itself
+  std::vector<uint8_t> nodeMasks;       // Constraint and triple line bits of each node
+  std::vector<int64_t> tripleNeighbors; // The 2 neighbors of each triple line node along the line
+  double timeStep = 0.0;
+
+  // Scratch space that is reused by every update step. The velocities of one step are the starting guess of the next.
+  std::vector<double> blockValues;
+  std::vector<double> forces;
+  std::vector<double> velocities;
+  std::vector<double> residual;
+  std::vector<double> direction;
+  std::vector<double> residualProduct;
+  std::vector<double> directionProduct;
+  std::vector<double> triangleQualities;
+  std::vector<double> partialSums;
+  std::vector<size_t> partialCounts;
+};
+
+/**
+ * @brief The MovingFiniteElementStep struct reports the state of the mesh after one update step
+ */
+struct MovingFiniteElementStep
+{
+  int solverIterations = 0; // -1 if the velocity solve did not converge, in which case no node was moved
+  double maxQuality = 0.0;
+  double averageQuality = 0.0;
+  double maxDisplacement = 0.0;
+  size_t heldCoordinates = 0; // Coordinates that were not moved because their step was too large
+};
+
+/**
+ * @brief The MovingFiniteElementSolver class moves the nodes of a triangle mesh with the moving finite element
+ * method. Each node gathers the forces and the stiffness matrix row from the triangles around it, so the
+ * assembly runs in parallel over the nodes without any two threads writing to the same entry. The velocities
+ * are found with a conjugate residual solve whose products and sums are also split over the nodes.
+ */
+class MovingFiniteElementSolver
+{
+public:
+  virtual ~MovingFiniteElementSolver();
+
+  /**
+   * @brief BuildMesh Builds the node to triangle connectivity, the sparsity of the stiffness matrix and the
+   * node masks
+   * @param triangles
+   * @param numTriangles
+   * @param nodes Node positions
+   * @param numNodes
+   * @param nodeTypes
+   * @param constrainBoundary Whether nodes on the bounding box may only move in the plane of the box face
+   * @param constrainSurfaceNodes Whether nodes on the bounding box are fixed
+   * @param constrainQuadPoints Whether quad points are fixed
+   * @param smoothTripleLines Whether triple line nodes get the line smoothing force
+   * @param mesh Output cached mesh
+   */
+  static void BuildMesh(const MeshIndexType* triangles, size_t numTriangles, const double* nodes, size_t numNodes, const int8_t* nodeTypes, bool constrainBoundary, bool constrainSurfaceNodes,
+                        bool constrainQuadPoints, bool smoothTripleLines, MovingFiniteElementMesh& mesh);
+
+  /**
+   * @brief UpdateNodes Runs one update step, moving the nodes along the solved velocities. The nodes are left
+   * where they are if the velocity solve does not converge
+   * @param triangles
+   * @param numTriangles
+   * @param qualityScale Weight of the triangle quality force
+   * @param nodes Node positions, updated in place
+   * @param mesh The cached mesh from BuildMesh
+   * @return The quality of the mesh before the step and the largest node displacement
+   */
+  static MovingFiniteElementStep UpdateNodes(const MeshIndexType* triangles, size_t numTriangles, double qualityScale, double* nodes, MovingFiniteElementMesh& mesh);
+
+protected:
+  MovingFiniteElementSolver();
+
+public:
+  MovingFiniteElementSolver(const MovingFiniteElementSolver&) = delete;            // Copy Constructor Not Implemented
+  MovingFiniteElementSolver(MovingFiniteElementSolver&&) = delete;                 // Move Constructor Not Implemented
+  MovingFiniteElementSolver& operator=(const MovingFiniteElementSolver&) = delete; // Copy Assignment Not Implemented
+  MovingFiniteElementSolver& operator=(MovingFiniteElementSolver&&) = delete;      // Move Assignment Not Implemented
+};
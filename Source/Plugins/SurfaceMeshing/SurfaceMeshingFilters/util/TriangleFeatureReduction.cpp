@@ -0,0 +1,412 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TriangleFeatureReduction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+namespace
+{
+// Volume, surface area, 3 first moments and 6 second moments
+constexpr size_t k_MomentValues = 11;
+// Summed x, y and z and the number of vertices
+constexpr size_t k_CentroidValues = 4;
+// Blocks smaller than this are not worth a thread of their own
+constexpr size_t k_MinBlockSize = 16384;
+// Upper bound on the number of accumulator values of all blocks together
+constexpr size_t k_MaxAccumulatorValues = size_t(1) << 26;
+
+// -----------------------------------------------------------------------------
+size_t blockCount(size_t numItems, size_t numFeatures, size_t stride)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  size_t numThreads = static_cast<size_t>(std::max(tbb::this_task_arena::max_concurrency(), 1));
+#else
+  // ParallelDataAlgorithm runs serially without TBB, so more blocks would only cost memory
+  size_t numThreads = 1;
+#endif
+  size_t byMemory = std::max<size_t>(k_MaxAccumulatorValues / std::max<size_t>(numFeatures * stride, 1), 1);
+  size_t bySize = std::max<size_t>(numItems / k_MinBlockSize, 1);
+  return std::min({numThreads, byMemory, bySize});
+}
+
+/**
+ * @brief The TriangleMomentsImpl class implements a threaded algorithm that sums the tetrahedron integrals of
+ * one block of triangles into the accumulators of that block.
+ */
+class TriangleMomentsImpl
+{
+public:
+  TriangleMomentsImpl(const MeshIndexType* triangles, const float* vertices, const int32_t* faceLabels, size_t numTriangles, size_t numFeatures, size_t numBlocks, std::vector<double>& accumulators)
+  : m_Triangles(triangles)
+  , m_Vertices(vertices)
+  , m_FaceLabels(faceLabels)
+  , m_NumTriangles(numTriangles)
+  , m_NumFeatures(numFeatures)
+  , m_NumBlocks(numBlocks)
+  , m_Accumulators(accumulators)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t block = start; block < end; block++)
+    {
+      double* sums = m_Accumulators.data() + block * m_NumFeatures * k_MomentValues;
+      size_t first = m_NumTriangles * block / m_NumBlocks;
+      size_t last = m_NumTriangles * (block + 1) / m_NumBlocks;
+      for(size_t t = first; t < last; t++)
+      {
+        addTriangle(t, sums);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const MeshIndexType* m_Triangles = nullptr;
+  const float* m_Vertices = nullptr;
+  const int32_t* m_FaceLabels = nullptr;
+  size_t m_NumTriangles = 0;
+  size_t m_NumFeatures = 0;
+  size_t m_NumBlocks = 1;
+  std::vector<double>& m_Accumulators;
+
+  // -----------------------------------------------------------------------------
+  void addTriangle(size_t t, double* sums) const
+  {
+    double p[3][3];
+    for(size_t v = 0; v < 3; v++)
+    {
+      const float* vertex = m_Vertices + m_Triangles[t * 3 + v] * 3;
+      p[v][0] = vertex[0];
+      p[v][1] = vertex[1];
+      p[v][2] = vertex[2];
+    }
+
+    double a[3] = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+    double b[3] = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+    double cross[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    double area = 0.5 * std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+    // Signed volume of the tetrahedron formed with the origin, positive when the normal of the triangle
+    // points toward the origin
+    double volume = -(p[0][0] * (p[1][1] * p[2][2] - p[1][2] * p[2][1]) - p[0][1] * (p[1][0] * p[2][2] - p[1][2] * p[2][0]) + p[0][2] * (p[1][0] * p[2][1] - p[1][1] * p[2][0])) / 6.0;
+
+    // The integral of x_i x_j over a tetrahedron is V / 20 * (sum of x_i x_j over the vertices + the product of
+    // the vertex sums). The origin adds nothing to either sum.
+    double s[3] = {p[0][0] + p[1][0] + p[2][0], p[0][1] + p[1][1] + p[2][1], p[0][2] + p[1][2] + p[2][2]};
+    const size_t pairs[6][2] = {{0, 0}, {1, 1}, {2, 2}, {0, 1}, {1, 2}, {0, 2}};
+    double values[k_MomentValues];
+    values[0] = volume;
+    values[1] = area;
+    for(size_t i = 0; i < 3; i++)
+    {
+      values[2 + i] = volume * s[i] / 4.0;
+    }
+    for(size_t q = 0; q < 6; q++)
+    {
+      size_t i = pairs[q][0];
+      size_t j = pairs[q][1];
+      values[5 + q] = volume / 20.0 * (p[0][i] * p[0][j] + p[1][i] * p[1][j] + p[2][i] * p[2][j] + s[i] * s[j]);
+    }
+
+    // The second label sees the triangle with the opposite winding, which flips the sign of every integral
+    // except the area
+    for(size_t k = 0; k < 2; k++)
+    {
+      int32_t label = m_FaceLabels[t * 2 + k];
+      if(label <= 0 || static_cast<size_t>(label) >= m_NumFeatures)
+      {
+        continue;
+      }
+      double sign = (k == 0) ? 1.0 : -1.0;
+      double* featureSums = sums + static_cast<size_t>(label) * k_MomentValues;
+      featureSums[1] += area;
+      featureSums[0] += sign * values[0];
+      for(size_t q = 2; q < k_MomentValues; q++)
+      {
+        featureSums[q] += sign * values[q];
+      }
+    }
+  }
+};
+
+/**
+ * @brief The VertexCentroidsImpl class implements a threaded algorithm that adds each vertex of one block of
+ * vertices once to every feature whose triangles use it.
+ */
+class VertexCentroidsImpl
+{
+public:
+  VertexCentroidsImpl(const float* vertices, const int32_t* faceLabels, const std::vector<int64_t>& vertexOffsets, const std::vector<int64_t>& vertexTriangles, size_t numVertices, size_t numFeatures,
+                      size_t numBlocks, std::vector<double>& accumulators)
+  : m_Vertices(vertices)
+  , m_FaceLabels(faceLabels)
+  , m_VertexOffsets(vertexOffsets)
+  , m_VertexTriangles(vertexTriangles)
+  , m_NumVertices(numVertices)
+  , m_NumFeatures(numFeatures)
+  , m_NumBlocks(numBlocks)
+  , m_Accumulators(accumulators)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<int32_t> labels;
+    for(size_t block = start; block < end; block++)
+    {
+      double* sums = m_Accumulators.data() + block * m_NumFeatures * k_CentroidValues;
+      size_t first = m_NumVertices * block / m_NumBlocks;
+      size_t last = m_NumVertices * (block + 1) / m_NumBlocks;
+      for(size_t v = first; v < last; v++)
+      {
+        labels.clear();
+        for(int64_t e = m_VertexOffsets[v]; e < m_VertexOffsets[v + 1]; e++)
+        {
+          int64_t t = m_VertexTriangles[e];
+          for(size_t k = 0; k < 2; k++)
+          {
+            int32_t label = m_FaceLabels[t * 2 + k];
+            if(label > 0 && static_cast<size_t>(label) < m_NumFeatures)
+            {
+              labels.push_back(label);
+            }
+          }
+        }
+        std::sort(labels.begin(), labels.end());
+        labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+        for(int32_t label : labels)
+        {
+          double* featureSums = sums + static_cast<size_t>(label) * k_CentroidValues;
+          featureSums[0] += m_Vertices[v * 3];
+          featureSums[1] += m_Vertices[v * 3 + 1];
+          featureSums[2] += m_Vertices[v * 3 + 2];
+          featureSums[3] += 1.0;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const float* m_Vertices = nullptr;
+  const int32_t* m_FaceLabels = nullptr;
+  const std::vector<int64_t>& m_VertexOffsets;
+  const std::vector<int64_t>& m_VertexTriangles;
+  size_t m_NumVertices = 0;
+  size_t m_NumFeatures = 0;
+  size_t m_NumBlocks = 1;
+  std::vector<double>& m_Accumulators;
+};
+
+/**
+ * @brief The MergeBlocksImpl class implements a threaded algorithm that adds the accumulators of all blocks
+ * together, one feature at a time, in block order.
+ */
+class MergeBlocksImpl
+{
+public:
+  MergeBlocksImpl(const std::vector<double>& accumulators, size_t numBlocks, size_t numFeatures, size_t stride, std::vector<double>& totals)
+  : m_Accumulators(accumulators)
+  , m_NumBlocks(numBlocks)
+  , m_NumFeatures(numFeatures)
+  , m_Stride(stride)
+  , m_Totals(totals)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t f = start; f < end; f++)
+    {
+      for(size_t q = 0; q < m_Stride; q++)
+      {
+        double sum = 0.0;
+        for(size_t block = 0; block < m_NumBlocks; block++)
+        {
+          sum += m_Accumulators[(block * m_NumFeatures + f) * m_Stride + q];
+        }
+        m_Totals[f * m_Stride + q] = sum;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const std::vector<double>& m_Accumulators;
+  size_t m_NumBlocks = 1;
+  size_t m_NumFeatures = 0;
+  size_t m_Stride = 1;
+  std::vector<double>& m_Totals;
+};
+
+// -----------------------------------------------------------------------------
+void mergeBlocks(const std::vector<double>& accumulators, size_t numBlocks, size_t numFeatures, size_t stride, std::vector<double>& totals)
+{
+  totals.resize(numFeatures * stride);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numFeatures);
+  dataAlg.execute(MergeBlocksImpl(accumulators, numBlocks, numFeatures, stride, totals));
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleFeatureReduction::TriangleFeatureReduction() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleFeatureReduction::~TriangleFeatureReduction() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleFeatureReduction::FindFeatureMoments(const MeshIndexType* triangles, const float* vertices, const int32_t* faceLabels, size_t numTriangles, size_t numFeatures,
+                                                  TriangleFeatureMoments& moments)
+{
+  size_t numBlocks = blockCount(numTriangles, numFeatures, k_MomentValues);
+  std::vector<double> accumulators(numBlocks * numFeatures * k_MomentValues, 0.0);
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute(TriangleMomentsImpl(triangles, vertices, faceLabels, numTriangles, numFeatures, numBlocks, accumulators));
+  }
+
+  std::vector<double> totals;
+  mergeBlocks(accumulators, numBlocks, numFeatures, k_MomentValues, totals);
+
+  moments.volumes.resize(numFeatures);
+  moments.surfaceAreas.resize(numFeatures);
+  moments.firstMoments.resize(numFeatures * 3);
+  moments.secondMoments.resize(numFeatures * 6);
+  for(size_t f = 0; f < numFeatures; f++)
+  {
+    const double* featureTotals = totals.data() + f * k_MomentValues;
+    moments.volumes[f] = featureTotals[0];
+    moments.surfaceAreas[f] = featureTotals[1];
+    std::copy(featureTotals + 2, featureTotals + 5, moments.firstMoments.begin() + f * 3);
+    std::copy(featureTotals + 5, featureTotals + 11, moments.secondMoments.begin() + f * 6);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleFeatureReduction::CentralSecondMoments(const TriangleFeatureMoments& moments, size_t feature, const float center[3], double central[6])
+{
+  // Integral of (x_i - c_i)(x_j - c_j) = M_ij - c_i m_j - c_j m_i + V c_i c_j
+  const size_t pairs[6][2] = {{0, 0}, {1, 1}, {2, 2}, {0, 1}, {1, 2}, {0, 2}};
+  const double* first = moments.firstMoments.data() + feature * 3;
+  const double* second = moments.secondMoments.data() + feature * 6;
+  double volume = moments.volumes[feature];
+  for(size_t q = 0; q < 6; q++)
+  {
+    double ci = center[pairs[q][0]];
+    double cj = center[pairs[q][1]];
+    central[q] = second[q] - ci * first[pairs[q][1]] - cj * first[pairs[q][0]] + volume * ci * cj;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleFeatureReduction::FindVertexCentroids(const MeshIndexType* triangles, const float* vertices, const int32_t* faceLabels, size_t numTriangles, size_t numVertices, size_t numFeatures,
+                                                   float* centroids)
+{
+  // Group the triangles by vertex
+  std::vector<int64_t> vertexOffsets(numVertices + 1, 0);
+  for(size_t c = 0; c < numTriangles * 3; c++)
+  {
+    vertexOffsets[triangles[c] + 1]++;
+  }
+  std::partial_sum(vertexOffsets.begin(), vertexOffsets.end(), vertexOffsets.begin());
+  std::vector<int64_t> vertexTriangles(numTriangles * 3);
+  std::vector<int64_t> fill(vertexOffsets.begin(), vertexOffsets.end() - 1);
+  for(size_t c = 0; c < numTriangles * 3; c++)
+  {
+    vertexTriangles[fill[triangles[c]]++] = static_cast<int64_t>(c / 3);
+  }
+
+  size_t numBlocks = blockCount(numVertices, numFeatures, k_CentroidValues);
+  std::vector<double> accumulators(numBlocks * numFeatures * k_CentroidValues, 0.0);
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute(VertexCentroidsImpl(vertices, faceLabels, vertexOffsets, vertexTriangles, numVertices, numFeatures, numBlocks, accumulators));
+  }
+
+  std::vector<double> totals;
+  mergeBlocks(accumulators, numBlocks, numFeatures, k_CentroidValues, totals);
+
+  for(size_t f = 0; f < numFeatures; f++)
+  {
+    const double* featureTotals = totals.data() + f * k_CentroidValues;
+    double count = featureTotals[3] > 0.0 ? featureTotals[3] : 1.0;
+    centroids[f * 3] = static_cast<float>(featureTotals[0] / count);
+    centroids[f * 3 + 1] = static_cast<float>(featureTotals[1] / count);
+    centroids[f * 3 + 2] = static_cast<float>(featureTotals[2] / count);
+  }
+}
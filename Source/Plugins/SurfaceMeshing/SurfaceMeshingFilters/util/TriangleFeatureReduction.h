@@ -0,0 +1,109 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/Geometry/IGeometry.h"
+
+/**
+ * @brief The TriangleFeatureMoments struct holds the integrals over the volume enclosed by the triangles of
+ * each feature. The triangles are wound so that their normals point into the feature with the first label
+ * and out of the feature with the second label.
+ */
+struct TriangleFeatureMoments
+{
+  std::vector<double> volumes;       // Signed enclosed volume of each feature
+  std::vector<double> surfaceAreas;  // Total area of the triangles of each feature
+  std::vector<double> firstMoments;  // Integrals of x, y and z over each feature
+  std::vector<double> secondMoments; // Integrals of xx, yy, zz, xy, yz and xz over each feature
+};
+
+/**
+ * @brief The TriangleFeatureReduction class sums per feature quantities over the triangles of a mesh. The
+ * triangles are split into one block per thread and each block is summed into its own accumulators, which are
+ * then added together in block order, so the result does not depend on the thread scheduling.
+ */
+class TriangleFeatureReduction
+{
+public:
+  virtual ~TriangleFeatureReduction();
+
+  /**
+   * @brief FindFeatureMoments Computes the volume, surface area and the first and second moments of every
+   * feature in a single pass over the triangles. Each triangle contributes the tetrahedron it forms with the
+   * origin, and the moments of that tetrahedron are integrated exactly. Only labels in [1, numFeatures) are used.
+   * @param triangles
+   * @param vertices
+   * @param faceLabels
+   * @param numTriangles
+   * @param numFeatures
+   * @param moments Output moments
+   */
+  static void FindFeatureMoments(const MeshIndexType* triangles, const float* vertices, const int32_t* faceLabels, size_t numTriangles, size_t numFeatures, TriangleFeatureMoments& moments);
+
+  /**
+   * @brief CentralSecondMoments Moves the second moments of a feature from the origin to the given center
+   * @param moments
+   * @param feature
+   * @param center
+   * @param central Output integrals of xx, yy, zz, xy, yz and xz relative to the center
+   */
+  static void CentralSecondMoments(const TriangleFeatureMoments& moments, size_t feature, const float center[3], double central[6]);
+
+  /**
+   * @brief FindVertexCentroids Finds the average position of the distinct vertices of the triangles of each
+   * feature. Only labels in [1, numFeatures) are used and features without triangles are left at the origin.
+   * @param triangles
+   * @param vertices
+   * @param faceLabels
+   * @param numTriangles
+   * @param numVertices
+   * @param numFeatures
+   * @param centroids Output centroids, 3 per feature
+   */
+  static void FindVertexCentroids(const MeshIndexType* triangles, const float* vertices, const int32_t* faceLabels, size_t numTriangles, size_t numVertices, size_t numFeatures, float* centroids);
+
+protected:
+  TriangleFeatureReduction();
+
+public:
+  TriangleFeatureReduction(const TriangleFeatureReduction&) = delete;            // Copy Constructor Not Implemented
+  TriangleFeatureReduction(TriangleFeatureReduction&&) = delete;                 // Move Constructor Not Implemented
+  TriangleFeatureReduction& operator=(const TriangleFeatureReduction&) = delete; // Copy Assignment Not Implemented
+  TriangleFeatureReduction& operator=(TriangleFeatureReduction&&) = delete;      // Move Assignment Not Implemented
+};
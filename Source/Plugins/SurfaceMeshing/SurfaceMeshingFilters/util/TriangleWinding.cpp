@@ -0,0 +1,421 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TriangleWinding.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceGrouping.h"
+
+namespace
+{
+/**
+ * @brief The EdgeKeysImpl class implements a threaded algorithm that packs the two vertices of each half
+ * edge into a key that is the same for both directions of the edge.
+ */
+class EdgeKeysImpl
+{
+public:
+  EdgeKeysImpl(const MeshIndexType* triangles, std::vector<uint64_t>& keys, std::vector<int64_t>& halfEdges)
+  : m_Triangles(triangles)
+  , m_Keys(keys)
+  , m_HalfEdges(halfEdges)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t h = start; h < end; h++)
+    {
+      size_t t = h / 3;
+      uint64_t v0 = m_Triangles[h];
+      uint64_t v1 = m_Triangles[t * 3 + (h + 1) % 3];
+      m_Keys[h] = v0 < v1 ? (v0 << 32) | v1 : (v1 << 32) | v0;
+      m_HalfEdges[h] = static_cast<int64_t>(h);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const MeshIndexType* m_Triangles = nullptr;
+  std::vector<uint64_t>& m_Keys;
+  std::vector<int64_t>& m_HalfEdges;
+};
+
+/**
+ * @brief The OrientFeatureImpl class implements a threaded algorithm that walks the triangles of each feature
+ * breadth first and records which of the triangles owned by the feature must be flipped.
+ */
+class OrientFeatureImpl
+{
+public:
+  OrientFeatureImpl(const MeshIndexType* triangles, const float* vertices, const int32_t* faceLabels, const TriangleEdgeMap& edges, const std::vector<int64_t>& labelOffsets,
+                    const std::vector<int64_t>& labelTriangles, const std::vector<int64_t>& labelSlots, std::vector<uint8_t>& flips)
+  : m_Triangles(triangles)
+  , m_Vertices(vertices)
+  , m_FaceLabels(faceLabels)
+  , m_Edges(edges)
+  , m_LabelOffsets(labelOffsets)
+  , m_LabelTriangles(labelTriangles)
+  , m_LabelSlots(labelSlots)
+  , m_Flips(flips)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<int8_t> state;
+    std::vector<int64_t> queue;
+    for(size_t label = start; label < end; label++)
+    {
+      orientFeature(static_cast<int32_t>(label), state, queue);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const MeshIndexType* m_Triangles = nullptr;
+  const float* m_Vertices = nullptr;
+  const int32_t* m_FaceLabels = nullptr;
+  const TriangleEdgeMap& m_Edges;
+  const std::vector<int64_t>& m_LabelOffsets;
+  const std::vector<int64_t>& m_LabelTriangles;
+  const std::vector<int64_t>& m_LabelSlots;
+  std::vector<uint8_t>& m_Flips;
+
+  /**
+   * @brief slotOf Returns the position of triangle t in the triangle list of the label, or -1 if the
+   * triangle does not bound that feature
+   */
+  int64_t slotOf(int64_t t, int32_t label) const
+  {
+    if(m_FaceLabels[t * 2] == label)
+    {
+      return m_LabelSlots[t * 2];
+    }
+    if(m_FaceLabels[t * 2 + 1] == label)
+    {
+      return m_LabelSlots[t * 2 + 1];
+    }
+    return -1;
+  }
+
+  /**
+   * @brief edgeDirection Returns +1 if half edge h runs from the smaller to the larger vertex when its
+   * triangle is wound outward for the label, and -1 otherwise
+   */
+  int edgeDirection(int64_t h, int32_t label) const
+  {
+    int64_t t = h / 3;
+    MeshIndexType v0 = m_Triangles[h];
+    MeshIndexType v1 = m_Triangles[t * 3 + (h + 1) % 3];
+    int direction = v0 < v1 ? 1 : -1;
+    return m_FaceLabels[t * 2] == label ? direction : -direction;
+  }
+
+  /**
+   * @brief normalX Returns the x component of the normal of triangle t when it is wound outward for the label
+   */
+  double normalX(int64_t t, int32_t label, bool flipped) const
+  {
+    const float* p0 = m_Vertices + m_Triangles[t * 3] * 3;
+    const float* p1 = m_Vertices + m_Triangles[t * 3 + 1] * 3;
+    const float* p2 = m_Vertices + m_Triangles[t * 3 + 2] * 3;
+    double nx = static_cast<double>(p1[1] - p0[1]) * (p2[2] - p0[2]) - static_cast<double>(p1[2] - p0[2]) * (p2[1] - p0[1]);
+    bool reversed = (m_FaceLabels[t * 2] != label) != flipped;
+    return reversed ? -nx : nx;
+  }
+
+  // -----------------------------------------------------------------------------
+  void orientFeature(int32_t label, std::vector<int8_t>& state, std::vector<int64_t>& queue) const
+  {
+    const int64_t* list = m_LabelTriangles.data() + m_LabelOffsets[label];
+    int64_t count = m_LabelOffsets[label + 1] - m_LabelOffsets[label];
+    state.assign(static_cast<size_t>(count), -1);
+
+    for(int64_t seed = 0; seed < count; seed++)
+    {
+      if(state[seed] >= 0)
+      {
+        continue;
+      }
+
+      // Walk one connected surface of the feature. The state of each triangle is whether it must be flipped
+      // relative to the seed so that every shared edge is crossed in opposite directions.
+      queue.clear();
+      queue.push_back(seed);
+      state[seed] = 0;
+      for(size_t q = 0; q < queue.size(); q++)
+      {
+        int64_t t = list[queue[q]];
+        int8_t tState = state[queue[q]];
+        for(int64_t h = t * 3; h < t * 3 + 3; h++)
+        {
+          // Only an edge with exactly one other triangle of this feature is followed. Where more surfaces of the
+          // feature meet at an edge the neighbors can not be paired without the geometry, so each surface is
+          // reached through its other edges instead.
+          int64_t edge = m_Edges.triangleEdges[h];
+          int64_t neighborHalfEdge = -1;
+          int64_t neighborSlot = -1;
+          int64_t numNeighbors = 0;
+          for(int64_t e = m_Edges.edgeOffsets[edge]; e < m_Edges.edgeOffsets[edge + 1]; e++)
+          {
+            int64_t nh = m_Edges.halfEdges[e];
+            int64_t slot = (nh / 3 == t) ? -1 : slotOf(nh / 3, label);
+            if(slot >= 0)
+            {
+              neighborHalfEdge = nh;
+              neighborSlot = slot;
+              numNeighbors++;
+            }
+          }
+          if(numNeighbors != 1 || state[neighborSlot] >= 0)
+          {
+            continue;
+          }
+          state[neighborSlot] = static_cast<int8_t>(edgeDirection(h, label) == edgeDirection(neighborHalfEdge, label) ? 1 - tState : tState);
+          queue.push_back(neighborSlot);
+        }
+      }
+
+      // The right most triangle of a closed surface must have a normal that points in +X. Ties go to the
+      // lowest triangle id so the result does not depend on the walk order.
+      int64_t rightMost = -1;
+      double xMax = std::numeric_limits<double>::lowest();
+      for(int64_t slot : queue)
+      {
+        int64_t t = list[slot];
+        const MeshIndexType* tri = m_Triangles + t * 3;
+        double x = (static_cast<double>(m_Vertices[tri[0] * 3]) + m_Vertices[tri[1] * 3] + m_Vertices[tri[2] * 3]) / 3.0;
+        if(rightMost < 0 || x > xMax || (x == xMax && t < list[rightMost]))
+        {
+          xMax = x;
+          rightMost = slot;
+        }
+      }
+      bool reverseSurface = normalX(list[rightMost], label, state[rightMost] == 1) < 0.0;
+
+      for(int64_t slot : queue)
+      {
+        int64_t t = list[slot];
+        int32_t owner = m_FaceLabels[t * 2] > 0 ? m_FaceLabels[t * 2] : m_FaceLabels[t * 2 + 1];
+        if(owner == label)
+        {
+          m_Flips[t] = static_cast<uint8_t>((state[slot] == 1) != reverseSurface);
+        }
+      }
+    }
+  }
+};
+
+/**
+ * @brief The ApplyFlipsImpl class implements a threaded algorithm that reverses the winding of the flagged triangles
+ */
+class ApplyFlipsImpl
+{
+public:
+  ApplyFlipsImpl(MeshIndexType* triangles, const std::vector<uint8_t>& flips)
+  : m_Triangles(triangles)
+  , m_Flips(flips)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      if(m_Flips[t] != 0)
+      {
+        std::swap(m_Triangles[t * 3], m_Triangles[t * 3 + 2]);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  MeshIndexType* m_Triangles = nullptr;
+  const std::vector<uint8_t>& m_Flips;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleWinding::TriangleWinding() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleWinding::~TriangleWinding() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleWinding::BuildEdgeMap(const MeshIndexType* triangles, size_t numTriangles, TriangleEdgeMap& edges)
+{
+  size_t numHalfEdges = numTriangles * 3;
+  std::vector<uint64_t> keys(numHalfEdges);
+  edges.halfEdges.resize(numHalfEdges);
+
+  MeshIndexType maxVertex = 0;
+  for(size_t h = 0; h < numHalfEdges; h++)
+  {
+    maxVertex = std::max(maxVertex, triangles[h]);
+  }
+
+  if(static_cast<uint64_t>(maxVertex) <= std::numeric_limits<uint32_t>::max())
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numHalfEdges);
+    dataAlg.execute(EdgeKeysImpl(triangles, keys, edges.halfEdges));
+    FeatureFaceGrouping::RadixSort(keys, edges.halfEdges);
+  }
+  else
+  {
+    // The vertex ids do not fit in a packed key, so order the half edges by their vertex pairs directly
+    auto vertexPair = [triangles](int64_t h) {
+      MeshIndexType v0 = triangles[h];
+      MeshIndexType v1 = triangles[(h / 3) * 3 + (h + 1) % 3];
+      return v0 < v1 ? std::make_pair(v0, v1) : std::make_pair(v1, v0);
+    };
+    std::iota(edges.halfEdges.begin(), edges.halfEdges.end(), 0);
+    std::stable_sort(edges.halfEdges.begin(), edges.halfEdges.end(), [&](int64_t a, int64_t b) { return vertexPair(a) < vertexPair(b); });
+    for(size_t i = 0; i < numHalfEdges; i++)
+    {
+      std::pair<MeshIndexType, MeshIndexType> pair = vertexPair(edges.halfEdges[i]);
+      keys[i] = (i > 0 && pair == vertexPair(edges.halfEdges[i - 1])) ? keys[i - 1] : i;
+    }
+  }
+
+  edges.edgeOffsets.clear();
+  edges.triangleEdges.resize(numHalfEdges);
+  for(size_t i = 0; i < numHalfEdges; i++)
+  {
+    if(i == 0 || keys[i] != keys[i - 1])
+    {
+      edges.edgeOffsets.push_back(static_cast<int64_t>(i));
+    }
+    edges.triangleEdges[edges.halfEdges[i]] = static_cast<int64_t>(edges.edgeOffsets.size() - 1);
+  }
+  edges.edgeOffsets.push_back(static_cast<int64_t>(numHalfEdges));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t TriangleWinding::FindWindingFlips(const MeshIndexType* triangles, const float* vertices, const int32_t* faceLabels, size_t numTriangles, const TriangleEdgeMap& edges,
+                                         std::vector<uint8_t>& flips)
+{
+  flips.assign(numTriangles, 0);
+
+  int32_t maxLabel = 0;
+  for(size_t i = 0; i < numTriangles * 2; i++)
+  {
+    maxLabel = std::max(maxLabel, faceLabels[i]);
+  }
+
+  // Group the triangles by feature. A triangle appears in the lists of both of its positive labels and
+  // remembers its position in each list.
+  std::vector<int64_t> labelOffsets(static_cast<size_t>(maxLabel) + 2, 0);
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    int32_t label0 = faceLabels[t * 2];
+    int32_t label1 = faceLabels[t * 2 + 1];
+    if(label0 > 0)
+    {
+      labelOffsets[label0 + 1]++;
+    }
+    if(label1 > 0 && label1 != label0)
+    {
+      labelOffsets[label1 + 1]++;
+    }
+  }
+  std::partial_sum(labelOffsets.begin(), labelOffsets.end(), labelOffsets.begin());
+
+  std::vector<int64_t> labelTriangles(static_cast<size_t>(labelOffsets.back()));
+  std::vector<int64_t> labelSlots(numTriangles * 2, -1);
+  std::vector<int64_t> fill(labelOffsets.begin(), labelOffsets.end() - 1);
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    for(size_t k = 0; k < 2; k++)
+    {
+      int32_t label = faceLabels[t * 2 + k];
+      if(label > 0 && (k == 0 || label != faceLabels[t * 2]))
+      {
+        labelSlots[t * 2 + k] = fill[label] - labelOffsets[label];
+        labelTriangles[fill[label]++] = static_cast<int64_t>(t);
+      }
+    }
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, static_cast<size_t>(maxLabel) + 1);
+  dataAlg.execute(OrientFeatureImpl(triangles, vertices, faceLabels, edges, labelOffsets, labelTriangles, labelSlots, flips));
+
+  return static_cast<size_t>(std::count(flips.begin(), flips.end(), 1));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleWinding::ApplyWindingFlips(MeshIndexType* triangles, size_t numTriangles, const std::vector<uint8_t>& flips)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTriangles);
+  dataAlg.execute(ApplyFlipsImpl(triangles, flips));
+}
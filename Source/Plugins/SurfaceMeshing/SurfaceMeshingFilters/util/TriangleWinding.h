@@ -0,0 +1,104 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/Geometry/IGeometry.h"
+
+/**
+ * @brief The TriangleEdgeMap struct holds the unique edges of a triangle mesh. Half edge k of triangle t runs
+ * from vertex k to vertex (k + 1) % 3 and has the id t * 3 + k.
+ */
+struct TriangleEdgeMap
+{
+  std::vector<int64_t> edgeOffsets;   // The half edges of edge e are halfEdges[edgeOffsets[e]] to halfEdges[edgeOffsets[e + 1] - 1]
+  std::vector<int64_t> halfEdges;     // Half edge ids grouped by edge
+  std::vector<int64_t> triangleEdges; // The edge of each half edge
+};
+
+/**
+ * @brief The TriangleWinding class makes the winding of the triangles around each feature consistent. The
+ * triangles that bound a feature are walked breadth first across shared edges and each connected surface
+ * is oriented so that its normals point out of the feature. Features are processed in parallel and only
+ * the flags of the triangles are written during the walk, so the mesh is not modified until every feature
+ * is done.
+ */
+class TriangleWinding
+{
+public:
+  virtual ~TriangleWinding();
+
+  /**
+   * @brief BuildEdgeMap Finds the triangles that share each edge of the mesh
+   * @param triangles
+   * @param numTriangles
+   * @param edges Output edge map
+   */
+  static void BuildEdgeMap(const MeshIndexType* triangles, size_t numTriangles, TriangleEdgeMap& edges);
+
+  /**
+   * @brief FindWindingFlips Determines which triangles need their winding reversed. The winding of a triangle
+   * is outward for the feature in its first label, so that feature decides the flag. Triangles whose labels
+   * are both less than 1 are never flipped.
+   * @param triangles
+   * @param vertices
+   * @param faceLabels
+   * @param numTriangles
+   * @param edges The edge map from BuildEdgeMap
+   * @param flips Output flag for each triangle
+   * @return The number of triangles that need to be flipped
+   */
+  static size_t FindWindingFlips(const MeshIndexType* triangles, const float* vertices, const int32_t* faceLabels, size_t numTriangles, const TriangleEdgeMap& edges, std::vector<uint8_t>& flips);
+
+  /**
+   * @brief ApplyWindingFlips Reverses the winding of every flagged triangle
+   * @param triangles
+   * @param numTriangles
+   * @param flips
+   */
+  static void ApplyWindingFlips(MeshIndexType* triangles, size_t numTriangles, const std::vector<uint8_t>& flips);
+
+protected:
+  TriangleWinding();
+
+public:
+  TriangleWinding(const TriangleWinding&) = delete;            // Copy Constructor Not Implemented
+  TriangleWinding(TriangleWinding&&) = delete;                 // Move Constructor Not Implemented
+  TriangleWinding& operator=(const TriangleWinding&) = delete; // Copy Assignment Not Implemented
+  TriangleWinding& operator=(TriangleWinding&&) = delete;      // Move Assignment Not Implemented
+};
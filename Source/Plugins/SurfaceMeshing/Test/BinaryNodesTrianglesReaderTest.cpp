@@ -0,0 +1,298 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/MeshStructs.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/BinaryNodesTrianglesReader.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class BinaryNodesTrianglesReaderTest
+{
+
+public:
+  BinaryNodesTrianglesReaderTest() = default;
+  ~BinaryNodesTrianglesReaderTest() = default;
+
+  /**
+   * @brief Returns the name of the class for BinaryNodesTrianglesReaderTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("BinaryNodesTrianglesReaderTest");
+  }
+
+  BinaryNodesTrianglesReaderTest(const BinaryNodesTrianglesReaderTest&) = delete;            // Copy Constructor Not Implemented
+  BinaryNodesTrianglesReaderTest(BinaryNodesTrianglesReaderTest&&) = delete;                 // Move Constructor Not Implemented
+  BinaryNodesTrianglesReaderTest& operator=(const BinaryNodesTrianglesReaderTest&) = delete; // Copy Assignment Not Implemented
+  BinaryNodesTrianglesReaderTest& operator=(BinaryNodesTrianglesReaderTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::BinaryNodesTrianglesReaderTest::NodesFile);
+    QFile::remove(UnitTest::BinaryNodesTrianglesReaderTest::TrianglesFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // The nodes of a tetrahedron. The records are written in reverse node id order so that the node types land
+  // at the node id and not at the record position.
+  // -----------------------------------------------------------------------------
+  std::vector<SurfaceMesh::NodesFile::NodesFileRecord_t> createNodes()
+  {
+    std::vector<SurfaceMesh::NodesFile::NodesFileRecord_t> nodes(4);
+    for(int32_t i = 0; i < 4; i++)
+    {
+      nodes[i].nodeId = 3 - i;
+      nodes[i].nodeKind = 2 + i;
+      nodes[i].x = static_cast<float>(i == 1);
+      nodes[i].y = static_cast<float>(i == 2);
+      nodes[i].z = static_cast<float>(i == 3);
+    }
+    return nodes;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The faces of the tetrahedron, with the triangle ids in a different order than the records
+  // -----------------------------------------------------------------------------
+  std::vector<SurfaceMesh::TrianglesFile::TrianglesFileRecord_t> createTriangles()
+  {
+    const int32_t faces[4][3] = {{0, 2, 1}, {0, 1, 3}, {0, 3, 2}, {1, 2, 3}};
+    const int32_t triIds[4] = {2, 0, 3, 1};
+    std::vector<SurfaceMesh::TrianglesFile::TrianglesFileRecord_t> triangles(4);
+    for(size_t i = 0; i < 4; i++)
+    {
+      triangles[i].triId = triIds[i];
+      triangles[i].nodeId_0 = faces[i][0];
+      triangles[i].nodeId_1 = faces[i][1];
+      triangles[i].nodeId_2 = faces[i][2];
+      triangles[i].label_0 = 10 + static_cast<int32_t>(i);
+      triangles[i].label_1 = -1;
+    }
+    return triangles;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes the records, leaving off the last removeBytes bytes of the file
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void writeRecords(const QString& filePath, const std::vector<T>& records, size_t byteCount, size_t removeBytes = 0)
+  {
+    QByteArray bytes;
+    for(const T& record : records)
+    {
+      bytes.append(reinterpret_cast<const char*>(&record), static_cast<int>(byteCount));
+    }
+    bytes.chop(static_cast<int>(removeBytes));
+    QFile file(filePath);
+    file.open(QIODevice::WriteOnly);
+    file.write(bytes);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  BinaryNodesTrianglesReader::Pointer runReader(const std::vector<SurfaceMesh::NodesFile::NodesFileRecord_t>& nodes, const std::vector<SurfaceMesh::TrianglesFile::TrianglesFileRecord_t>& triangles,
+                                                DataContainerArray::Pointer dca, size_t removeNodeBytes = 0, size_t removeTriangleBytes = 0)
+  {
+    writeRecords(UnitTest::BinaryNodesTrianglesReaderTest::NodesFile, nodes, SurfaceMesh::NodesFile::ByteCount, removeNodeBytes);
+    writeRecords(UnitTest::BinaryNodesTrianglesReaderTest::TrianglesFile, triangles, SurfaceMesh::TrianglesFile::ByteCount, removeTriangleBytes);
+
+    BinaryNodesTrianglesReader::Pointer reader = BinaryNodesTrianglesReader::New();
+    reader->setDataContainerArray(dca);
+    reader->setBinaryNodesFile(UnitTest::BinaryNodesTrianglesReaderTest::NodesFile);
+    reader->setBinaryTrianglesFile(UnitTest::BinaryNodesTrianglesReaderTest::TrianglesFile);
+    reader->execute();
+    return reader;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestValidFiles()
+  {
+    std::vector<SurfaceMesh::NodesFile::NodesFileRecord_t> nodes = createNodes();
+    std::vector<SurfaceMesh::TrianglesFile::TrianglesFileRecord_t> triangles = createTriangles();
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    BinaryNodesTrianglesReader::Pointer reader = runReader(nodes, triangles, dca);
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), 0)
+    DREAM3D_REQUIRE_EQUAL(reader->getWarningCode(), 0)
+
+    DataContainer::Pointer dc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    DREAM3D_REQUIRE(dc.get() != nullptr)
+    TriangleGeom::Pointer triangleGeom = dc->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE(triangleGeom.get() != nullptr)
+    DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfVertices(), 4)
+    DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfTris(), 4)
+
+    Int8ArrayType::Pointer nodeTypes = dc->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    Int32ArrayType::Pointer faceLabels = dc->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    DREAM3D_REQUIRE(nodeTypes.get() != nullptr)
+    DREAM3D_REQUIRE(faceLabels.get() != nullptr)
+
+    // The vertices are stored in record order and the node types at the node id of the record
+    float* vertices = triangleGeom->getVertexPointer(0);
+    for(size_t i = 0; i < 4; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(vertices[i * 3], nodes[i].x)
+      DREAM3D_REQUIRE_EQUAL(vertices[i * 3 + 1], nodes[i].y)
+      DREAM3D_REQUIRE_EQUAL(vertices[i * 3 + 2], nodes[i].z)
+      DREAM3D_REQUIRE_EQUAL(nodeTypes->getValue(nodes[i].nodeId), nodes[i].nodeKind)
+    }
+
+    // The triangles are stored in record order and the face labels at the triangle id of the record
+    MeshIndexType* tris = triangleGeom->getTriPointer(0);
+    for(size_t i = 0; i < 4; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(tris[i * 3], triangles[i].nodeId_0)
+      DREAM3D_REQUIRE_EQUAL(tris[i * 3 + 1], triangles[i].nodeId_1)
+      DREAM3D_REQUIRE_EQUAL(tris[i * 3 + 2], triangles[i].nodeId_2)
+      DREAM3D_REQUIRE_EQUAL(faceLabels->getComponent(triangles[i].triId, 0), triangles[i].label_0)
+      DREAM3D_REQUIRE_EQUAL(faceLabels->getComponent(triangles[i].triId, 1), triangles[i].label_1)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestInvalidIds()
+  {
+    {
+      std::vector<SurfaceMesh::NodesFile::NodesFileRecord_t> nodes = createNodes();
+      nodes[2].nodeId = 4;
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      BinaryNodesTrianglesReader::Pointer reader = runReader(nodes, createTriangles(), dca);
+      DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -790)
+    }
+    {
+      std::vector<SurfaceMesh::TrianglesFile::TrianglesFileRecord_t> triangles = createTriangles();
+      triangles[1].triId = -1;
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      BinaryNodesTrianglesReader::Pointer reader = runReader(createNodes(), triangles, dca);
+      DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -791)
+    }
+    {
+      std::vector<SurfaceMesh::TrianglesFile::TrianglesFileRecord_t> triangles = createTriangles();
+      triangles[3].nodeId_2 = 4;
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      BinaryNodesTrianglesReader::Pointer reader = runReader(createNodes(), triangles, dca);
+      DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -791)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestTruncatedFiles()
+  {
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      BinaryNodesTrianglesReader::Pointer reader = runReader(createNodes(), createTriangles(), dca, 3, 0);
+      DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -792)
+    }
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      BinaryNodesTrianglesReader::Pointer reader = runReader(createNodes(), createTriangles(), dca, 0, 5);
+      DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -793)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDuplicateIds()
+  {
+    // The last record of a repeated id wins, as it does when the files are read one record at a time
+    {
+      std::vector<SurfaceMesh::NodesFile::NodesFileRecord_t> nodes = createNodes();
+      nodes[3].nodeId = nodes[1].nodeId;
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      BinaryNodesTrianglesReader::Pointer reader = runReader(nodes, createTriangles(), dca);
+      DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), 0)
+      DREAM3D_REQUIRE_EQUAL(reader->getWarningCode(), -794)
+      DataContainer::Pointer dc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+      Int8ArrayType::Pointer nodeTypes = dc->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+      DREAM3D_REQUIRE_EQUAL(nodeTypes->getValue(nodes[1].nodeId), nodes[3].nodeKind)
+    }
+    {
+      std::vector<SurfaceMesh::TrianglesFile::TrianglesFileRecord_t> triangles = createTriangles();
+      triangles[2].triId = triangles[0].triId;
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      BinaryNodesTrianglesReader::Pointer reader = runReader(createNodes(), triangles, dca);
+      DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), 0)
+      DREAM3D_REQUIRE_EQUAL(reader->getWarningCode(), -795)
+      DataContainer::Pointer dc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+      Int32ArrayType::Pointer faceLabels = dc->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+      DREAM3D_REQUIRE_EQUAL(faceLabels->getComponent(triangles[0].triId, 0), triangles[2].label_0)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestValidFiles())
+    DREAM3D_REGISTER_TEST(TestInvalidIds())
+    DREAM3D_REGISTER_TEST(TestTruncatedFiles())
+    DREAM3D_REGISTER_TEST(TestDuplicateIds())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+};
@@ -0,0 +1,300 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QDebug>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+class FeatureFaceCurvatureFilterTest
+{
+
+public:
+  FeatureFaceCurvatureFilterTest() = default;
+  virtual ~FeatureFaceCurvatureFilterTest() = default;
+
+  /**
+   * @brief Returns the name of the class for FeatureFaceCurvatureFilterTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("FeatureFaceCurvatureFilterTest");
+  }
+
+  FeatureFaceCurvatureFilterTest(const FeatureFaceCurvatureFilterTest&) = delete;            // Copy Constructor Not Implemented
+  FeatureFaceCurvatureFilterTest(FeatureFaceCurvatureFilterTest&&) = delete;                 // Move Constructor Not Implemented
+  FeatureFaceCurvatureFilterTest& operator=(const FeatureFaceCurvatureFilterTest&) = delete; // Copy Assignment Not Implemented
+  FeatureFaceCurvatureFilterTest& operator=(FeatureFaceCurvatureFilterTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FeatureFaceCurvatureFilter Filter from the FilterManager
+    QString filtName = "FeatureFaceCurvatureFilter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Creates a sphere of the given radius by subdividing an icosahedron and projecting the new vertices onto the
+  // sphere. The triangles are wound so that their normals point outwards.
+  // -----------------------------------------------------------------------------
+  void createIcosphere(double radius, int32_t subdivisions, std::vector<double>& vertices, std::vector<size_t>& triangles)
+  {
+    const double t = (1.0 + std::sqrt(5.0)) / 2.0;
+    vertices = {-1.0, t, 0.0, 1.0, t, 0.0, -1.0, -t, 0.0, 1.0, -t, 0.0, 0.0, -1.0, t, 0.0, 1.0, t, 0.0, -1.0, -t, 0.0, 1.0, -t, t, 0.0, -1.0, t, 0.0, 1.0, -t, 0.0, -1.0, -t, 0.0, 1.0};
+    triangles = {0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+                 3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1};
+
+    auto project = [&vertices, radius](size_t v) {
+      double length = std::sqrt(vertices[v * 3] * vertices[v * 3] + vertices[v * 3 + 1] * vertices[v * 3 + 1] + vertices[v * 3 + 2] * vertices[v * 3 + 2]);
+      for(size_t k = 0; k < 3; k++)
+      {
+        vertices[v * 3 + k] *= radius / length;
+      }
+    };
+    for(size_t v = 0; v < 12; v++)
+    {
+      project(v);
+    }
+
+    for(int32_t level = 0; level < subdivisions; level++)
+    {
+      std::map<std::pair<size_t, size_t>, size_t> midpoints;
+      auto midpoint = [&](size_t a, size_t b) {
+        std::pair<size_t, size_t> key(std::min(a, b), std::max(a, b));
+        auto iter = midpoints.find(key);
+        if(iter != midpoints.end())
+        {
+          return iter->second;
+        }
+        size_t v = vertices.size() / 3;
+        for(size_t k = 0; k < 3; k++)
+        {
+          vertices.push_back(0.5 * (vertices[a * 3 + k] + vertices[b * 3 + k]));
+        }
+        project(v);
+        midpoints[key] = v;
+        return v;
+      };
+
+      std::vector<size_t> subdivided;
+      for(size_t i = 0; i < triangles.size(); i += 3)
+      {
+        size_t a = triangles[i];
+        size_t b = triangles[i + 1];
+        size_t c = triangles[i + 2];
+        size_t ab = midpoint(a, b);
+        size_t bc = midpoint(b, c);
+        size_t ca = midpoint(c, a);
+        std::vector<size_t> quad = {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca};
+        subdivided.insert(subdivided.end(), quad.begin(), quad.end());
+      }
+      triangles.swap(subdivided);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSphereCurvature(bool useNormalsForCurveFitting)
+  {
+    // A sphere of radius R has both principal curvatures equal to 1/R, a mean curvature of 1/R and a
+    // Gaussian curvature of 1/R^2 everywhere, and its principal directions lie in the tangent plane
+    const double radius = 2.0;
+    std::vector<double> sphereVertices;
+    std::vector<size_t> sphereTriangles;
+    createIcosphere(radius, 3, sphereVertices, sphereTriangles);
+    size_t numVertices = sphereVertices.size() / 3;
+    size_t numTriangles = sphereTriangles.size() / 3;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(numVertices);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTriangles, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    size_t* tris = triangle->getTriPointer(0);
+    for(size_t i = 0; i < numVertices * 3; i++)
+    {
+      vertices[i] = static_cast<float>(sphereVertices[i]);
+    }
+    for(size_t i = 0; i < numTriangles * 3; i++)
+    {
+      tris[i] = sphereTriangles[i];
+    }
+
+    std::vector<size_t> tDims(1, numTriangles);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+
+    std::vector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels, true);
+    faceAttrMat->insertOrAssign(faceLabels);
+    cDims[0] = 1;
+    Int32ArrayType::Pointer featureFaceIds = Int32ArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFeatureFaceId, true);
+    faceAttrMat->insertOrAssign(featureFaceIds);
+    cDims[0] = 3;
+    DoubleArrayType::Pointer normals = DoubleArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFaceNormals, true);
+    faceAttrMat->insertOrAssign(normals);
+    DoubleArrayType::Pointer centroids = DoubleArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFaceCentroids, true);
+    faceAttrMat->insertOrAssign(centroids);
+
+    // The whole sphere is a single feature face between Feature 1 inside and Feature 0 outside
+    for(size_t t = 0; t < numTriangles; t++)
+    {
+      faceLabels->setComponent(t, 0, 1);
+      faceLabels->setComponent(t, 1, 0);
+      featureFaceIds->setValue(t, 1);
+
+      double p[3][3];
+      for(size_t a = 0; a < 3; a++)
+      {
+        for(size_t k = 0; k < 3; k++)
+        {
+          p[a][k] = sphereVertices[sphereTriangles[t * 3 + a] * 3 + k];
+        }
+      }
+      double u[3] = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+      double w[3] = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+      double n[3] = {u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0]};
+      double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      for(size_t k = 0; k < 3; k++)
+      {
+        normals->setComponent(t, k, n[k] / length);
+        centroids->setComponent(t, k, (p[0][k] + p[1][k] + p[2][k]) / 3.0);
+      }
+    }
+
+    QString filtName = "FeatureFaceCurvatureFilter";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer curvatureFilter = factory->create();
+    DREAM3D_REQUIRE(curvatureFilter.get() != nullptr)
+    curvatureFilter->setDataContainerArray(dca);
+
+    bool propWasSet = curvatureFilter->setProperty("NRing", 3);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = curvatureFilter->setProperty("ComputeMeanCurvature", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = curvatureFilter->setProperty("ComputeGaussianCurvature", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = curvatureFilter->setProperty("ComputePrincipalDirectionVectors", true);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = curvatureFilter->setProperty("UseNormalsForCurveFitting", useNormalsForCurveFitting);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    curvatureFilter->execute();
+    int32_t err = curvatureFilter->getErrorCode();
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+
+    DoubleArrayType::Pointer kappa1 = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshPrincipalCurvature1);
+    DoubleArrayType::Pointer kappa2 = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshPrincipalCurvature2);
+    DoubleArrayType::Pointer meanCurvature = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshMeanCurvatures);
+    DoubleArrayType::Pointer gaussianCurvature = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshGaussianCurvatures);
+    DoubleArrayType::Pointer direction1 = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshPrincipalDirection1);
+    DoubleArrayType::Pointer direction2 = faceAttrMat->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshPrincipalDirection2);
+    DREAM3D_REQUIRE(kappa1.get() != nullptr)
+    DREAM3D_REQUIRE(kappa2.get() != nullptr)
+    DREAM3D_REQUIRE(meanCurvature.get() != nullptr)
+    DREAM3D_REQUIRE(gaussianCurvature.get() != nullptr)
+    DREAM3D_REQUIRE(direction1.get() != nullptr)
+    DREAM3D_REQUIRE(direction2.get() != nullptr)
+
+    // The patches are fitted through the flat triangle centroids, so a 1280 triangle sphere is within 10%
+    const double expected = 1.0 / radius;
+    for(size_t t = 0; t < numTriangles; t++)
+    {
+      DREAM3D_REQUIRE(kappa1->getValue(t) >= kappa2->getValue(t))
+      DREAM3D_REQUIRE(std::fabs(kappa1->getValue(t) - expected) < 0.1 * expected)
+      DREAM3D_REQUIRE(std::fabs(kappa2->getValue(t) - expected) < 0.1 * expected)
+      DREAM3D_REQUIRE(std::fabs(meanCurvature->getValue(t) - expected) < 0.1 * expected)
+      DREAM3D_REQUIRE(std::fabs(gaussianCurvature->getValue(t) - expected * expected) < 0.2 * expected * expected)
+
+      double dot1 = 0.0;
+      double dot2 = 0.0;
+      for(size_t k = 0; k < 3; k++)
+      {
+        dot1 += direction1->getComponent(t, k) * normals->getComponent(t, k);
+        dot2 += direction2->getComponent(t, k) * normals->getComponent(t, k);
+      }
+      DREAM3D_REQUIRE(std::fabs(dot1) < 1.0e-6)
+      DREAM3D_REQUIRE(std::fabs(dot2) < 1.0e-6)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSphereCurvature(false))
+    DREAM3D_REGISTER_TEST(TestSphereCurvature(true))
+  }
+
+private:
+};
@@ -0,0 +1,220 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleFeatureReduction.h"
+
+class TriangleFeatureReductionTest
+{
+public:
+  TriangleFeatureReductionTest() = default;
+  ~TriangleFeatureReductionTest() = default;
+  TriangleFeatureReductionTest(const TriangleFeatureReductionTest&) = delete;            // Copy Constructor
+  TriangleFeatureReductionTest(TriangleFeatureReductionTest&&) = delete;                 // Move Constructor
+  TriangleFeatureReductionTest& operator=(const TriangleFeatureReductionTest&) = delete; // Copy Assignment
+  TriangleFeatureReductionTest& operator=(TriangleFeatureReductionTest&&) = delete;      // Move Assignment
+
+  // Each face of the cube is split into k_CubeDivisions x k_CubeDivisions squares, which is enough triangles
+  // for the reduction to be split into several blocks when more than one thread is available
+  const size_t k_CubeDivisions = 80;
+  const float k_CubeCorner[3] = {1.0f, 2.0f, 3.0f};
+  const float k_TetrahedronCorner[3] = {-2.0f, 1.0f, 0.5f};
+  const double k_Tolerance = 1.0e-5;
+
+  // -----------------------------------------------------------------------------
+  // Feature 1 is the unit cube at k_CubeCorner with Face Labels (1, 0), wound so that the normals point into
+  // the cube. Feature 2 is the corner tetrahedron of the unit cube at k_TetrahedronCorner with Face Labels
+  // (0, 2), wound so that the normals point out of the tetrahedron.
+  // -----------------------------------------------------------------------------
+  void createMesh(std::vector<float>& vertices, std::vector<MeshIndexType>& triangles, std::vector<int32_t>& labels)
+  {
+    const size_t n = k_CubeDivisions;
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      size_t u = (axis + 1) % 3;
+      size_t w = (axis + 2) % 3;
+      for(size_t side = 0; side < 2; side++)
+      {
+        MeshIndexType first = vertices.size() / 3;
+        for(size_t j = 0; j <= n; j++)
+        {
+          for(size_t i = 0; i <= n; i++)
+          {
+            float p[3] = {0.0f, 0.0f, 0.0f};
+            p[axis] = static_cast<float>(side);
+            p[u] = static_cast<float>(i) / static_cast<float>(n);
+            p[w] = static_cast<float>(j) / static_cast<float>(n);
+            for(size_t k = 0; k < 3; k++)
+            {
+              vertices.push_back(k_CubeCorner[k] + p[k]);
+            }
+          }
+        }
+
+        // (u, w) is right handed around the axis, so this order winds towards -axis on the far side
+        for(size_t j = 0; j < n; j++)
+        {
+          for(size_t i = 0; i < n; i++)
+          {
+            MeshIndexType v00 = first + j * (n + 1) + i;
+            MeshIndexType v10 = v00 + 1;
+            MeshIndexType v01 = v00 + n + 1;
+            MeshIndexType v11 = v01 + 1;
+            std::vector<MeshIndexType> quad = side == 0 ? std::vector<MeshIndexType>{v00, v10, v11, v00, v11, v01} : std::vector<MeshIndexType>{v00, v11, v10, v00, v01, v11};
+            triangles.insert(triangles.end(), quad.begin(), quad.end());
+            labels.insert(labels.end(), {1, 0, 1, 0});
+          }
+        }
+      }
+    }
+
+    MeshIndexType first = vertices.size() / 3;
+    const float corners[4][3] = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    for(const auto& corner : corners)
+    {
+      for(size_t k = 0; k < 3; k++)
+      {
+        vertices.push_back(k_TetrahedronCorner[k] + corner[k]);
+      }
+    }
+    const MeshIndexType faces[4][3] = {{0, 2, 1}, {0, 1, 3}, {0, 3, 2}, {1, 2, 3}};
+    for(const auto& face : faces)
+    {
+      for(MeshIndexType v : face)
+      {
+        triangles.push_back(first + v);
+      }
+      labels.insert(labels.end(), {0, 2});
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFeatureMoments()
+  {
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> triangles;
+    std::vector<int32_t> labels;
+    createMesh(vertices, triangles, labels);
+    size_t numTriangles = triangles.size() / 3;
+
+    TriangleFeatureMoments moments;
+    TriangleFeatureReduction::FindFeatureMoments(triangles.data(), vertices.data(), labels.data(), numTriangles, 3, moments);
+    DREAM3D_REQUIRE_EQUAL(moments.volumes.size(), 3)
+
+    // Nothing is assigned to Feature 0
+    DREAM3D_REQUIRE_EQUAL(moments.volumes[0], 0.0)
+    DREAM3D_REQUIRE_EQUAL(moments.surfaceAreas[0], 0.0)
+
+    // The unit cube: the central second moments are 1/12 on the diagonal and 0 off the diagonal
+    float cubeCenter[3] = {k_CubeCorner[0] + 0.5f, k_CubeCorner[1] + 0.5f, k_CubeCorner[2] + 0.5f};
+    double cubeCentral[6] = {1.0 / 12.0, 1.0 / 12.0, 1.0 / 12.0, 0.0, 0.0, 0.0};
+
+    // The corner tetrahedron of the unit cube: a volume of 1/6 and an area of 3/2 + sqrt(3)/2. About its
+    // centroid the integral of x^2 is 1/160 and the integral of xy is -1/480.
+    float tetCenter[3] = {k_TetrahedronCorner[0] + 0.25f, k_TetrahedronCorner[1] + 0.25f, k_TetrahedronCorner[2] + 0.25f};
+    double tetCentral[6] = {1.0 / 160.0, 1.0 / 160.0, 1.0 / 160.0, -1.0 / 480.0, -1.0 / 480.0, -1.0 / 480.0};
+
+    const double volumes[3] = {0.0, 1.0, 1.0 / 6.0};
+    const double areas[3] = {0.0, 6.0, 1.5 + std::sqrt(3.0) / 2.0};
+    const float* centers[3] = {nullptr, cubeCenter, tetCenter};
+    const double* centrals[3] = {nullptr, cubeCentral, tetCentral};
+    const size_t pairs[6][2] = {{0, 0}, {1, 1}, {2, 2}, {0, 1}, {1, 2}, {0, 2}};
+    for(size_t f = 1; f < 3; f++)
+    {
+      DREAM3D_REQUIRE(std::fabs(moments.volumes[f] - volumes[f]) < k_Tolerance)
+      DREAM3D_REQUIRE(std::fabs(moments.surfaceAreas[f] - areas[f]) < k_Tolerance)
+      for(size_t i = 0; i < 3; i++)
+      {
+        DREAM3D_REQUIRE(std::fabs(moments.firstMoments[f * 3 + i] - volumes[f] * centers[f][i]) < k_Tolerance)
+      }
+
+      // The second moments about the origin follow from the parallel axis theorem
+      double central[6];
+      TriangleFeatureReduction::CentralSecondMoments(moments, f, centers[f], central);
+      for(size_t q = 0; q < 6; q++)
+      {
+        double origin = centrals[f][q] + volumes[f] * centers[f][pairs[q][0]] * centers[f][pairs[q][1]];
+        DREAM3D_REQUIRE(std::fabs(moments.secondMoments[f * 6 + q] - origin) < k_Tolerance)
+        DREAM3D_REQUIRE(std::fabs(central[q] - centrals[f][q]) < k_Tolerance)
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestVertexCentroids()
+  {
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> triangles;
+    std::vector<int32_t> labels;
+    createMesh(vertices, triangles, labels);
+    size_t numTriangles = triangles.size() / 3;
+    size_t numVertices = vertices.size() / 3;
+
+    // The faces of the cube do not share vertices, but each face is symmetric about the center of the cube
+    std::vector<float> centroids(9, -1.0f);
+    TriangleFeatureReduction::FindVertexCentroids(triangles.data(), vertices.data(), labels.data(), numTriangles, numVertices, 3, centroids.data());
+    for(size_t i = 0; i < 3; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(centroids[i], 0.0f)
+      DREAM3D_REQUIRE(std::fabs(centroids[3 + i] - (k_CubeCorner[i] + 0.5f)) < k_Tolerance)
+      DREAM3D_REQUIRE(std::fabs(centroids[6 + i] - (k_TetrahedronCorner[i] + 0.25f)) < k_Tolerance)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- TriangleFeatureReductionTest ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFeatureMoments())
+    DREAM3D_REGISTER_TEST(TestVertexCentroids())
+  }
+};
@@ -0,0 +1,277 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QDebug>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+class VerifyTriangleWindingTest
+{
+
+public:
+  VerifyTriangleWindingTest() = default;
+  virtual ~VerifyTriangleWindingTest() = default;
+
+  /**
+   * @brief Returns the name of the class for VerifyTriangleWindingTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("VerifyTriangleWindingTest");
+  }
+
+  VerifyTriangleWindingTest(const VerifyTriangleWindingTest&) = delete;            // Copy Constructor Not Implemented
+  VerifyTriangleWindingTest(VerifyTriangleWindingTest&&) = delete;                 // Move Constructor Not Implemented
+  VerifyTriangleWindingTest& operator=(const VerifyTriangleWindingTest&) = delete; // Copy Assignment Not Implemented
+  VerifyTriangleWindingTest& operator=(VerifyTriangleWindingTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the VerifyTriangleWinding Filter from the FilterManager
+    QString filtName = "VerifyTriangleWinding";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds two unit cubes side by side along X: Feature 1 fills [0, 1] and Feature 2 fills [1, 2]. Every unit
+  // square of the boundary is split into two triangles wound so that the normal points out of the first Feature
+  // in the Face Labels. The shared wall at x = 1 is labeled (1, 2). The expected normal of each triangle is stored.
+  // -----------------------------------------------------------------------------
+  void createTwoCubes(std::vector<float>& vertices, std::vector<size_t>& triangles, std::vector<int32_t>& labels, std::vector<float>& expectedNormals)
+  {
+    vertices.clear();
+    for(size_t z = 0; z < 2; z++)
+    {
+      for(size_t y = 0; y < 2; y++)
+      {
+        for(size_t x = 0; x < 3; x++)
+        {
+          vertices.push_back(static_cast<float>(x));
+          vertices.push_back(static_cast<float>(y));
+          vertices.push_back(static_cast<float>(z));
+        }
+      }
+    }
+    auto vertexId = [](size_t p[3]) { return p[0] + 3 * (p[1] + 2 * p[2]); };
+
+    triangles.clear();
+    labels.clear();
+    expectedNormals.clear();
+    for(size_t cube = 0; cube < 2; cube++)
+    {
+      for(size_t axis = 0; axis < 3; axis++)
+      {
+        for(size_t side = 0; side < 2; side++)
+        {
+          int32_t label0 = static_cast<int32_t>(cube) + 1;
+          int32_t label1 = -1;
+          if(axis == 0 && cube == 1 && side == 0)
+          {
+            continue; // The shared wall is added once, by the first cube
+          }
+          if(axis == 0 && cube == 0 && side == 1)
+          {
+            label1 = 2;
+          }
+          float normal[3] = {0.0f, 0.0f, 0.0f};
+          normal[axis] = side == 1 ? 1.0f : -1.0f;
+
+          // The corners of the square in order around its edge
+          size_t u = (axis + 1) % 3;
+          size_t w = (axis + 2) % 3;
+          size_t corners[4] = {0, 0, 0, 0};
+          const size_t uw[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+          for(size_t c = 0; c < 4; c++)
+          {
+            size_t p[3] = {cube, 0, 0};
+            p[axis] = (axis == 0 ? cube : 0) + side;
+            p[u] = (u == 0 ? cube : 0) + uw[c][0];
+            p[w] = (w == 0 ? cube : 0) + uw[c][1];
+            corners[c] = vertexId(p);
+          }
+
+          // (u, w) is right handed around the axis, so the corner order winds towards +axis
+          if(side == 0)
+          {
+            std::swap(corners[1], corners[3]);
+          }
+          const size_t split[2][3] = {{0, 1, 2}, {0, 2, 3}};
+          for(size_t h = 0; h < 2; h++)
+          {
+            for(size_t k = 0; k < 3; k++)
+            {
+              triangles.push_back(corners[split[h][k]]);
+              expectedNormals.push_back(normal[k]);
+            }
+            labels.push_back(label0);
+            labels.push_back(label1);
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Returns the dot product of the winding normal of a triangle with the expected normal
+  // -----------------------------------------------------------------------------
+  float windingAlignment(const float* vertices, const size_t* tri, const float* expectedNormal)
+  {
+    const float* p0 = vertices + tri[0] * 3;
+    const float* p1 = vertices + tri[1] * 3;
+    const float* p2 = vertices + tri[2] * 3;
+    float a[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+    float b[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+    float n[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    return n[0] * expectedNormal[0] + n[1] * expectedNormal[1] + n[2] * expectedNormal[2];
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRestoreFlippedTriangles(bool flipAll)
+  {
+    std::vector<float> meshVertices;
+    std::vector<size_t> meshTriangles;
+    std::vector<int32_t> meshLabels;
+    std::vector<float> expectedNormals;
+    createTwoCubes(meshVertices, meshTriangles, meshLabels, expectedNormals);
+    size_t numVertices = meshVertices.size() / 3;
+    size_t numTriangles = meshTriangles.size() / 3;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(numVertices);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTriangles, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    size_t* tris = triangle->getTriPointer(0);
+    for(size_t i = 0; i < numVertices * 3; i++)
+    {
+      vertices[i] = meshVertices[i];
+    }
+    for(size_t i = 0; i < numTriangles * 3; i++)
+    {
+      tris[i] = meshTriangles[i];
+    }
+
+    std::vector<size_t> tDims(1, numTriangles);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+
+    std::vector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels, true);
+    faceAttrMat->insertOrAssign(faceLabels);
+    for(size_t i = 0; i < numTriangles * 2; i++)
+    {
+      faceLabels->setValue(i, meshLabels[i]);
+    }
+
+    // Reverse a known subset of the triangles, or all of them so that every feature starts inside out
+    for(size_t t = 0; t < numTriangles; t++)
+    {
+      DREAM3D_REQUIRE(windingAlignment(vertices, tris + t * 3, expectedNormals.data() + t * 3) > 0.0f)
+      if(flipAll || t % 3 == 0)
+      {
+        std::swap(tris[t * 3 + 1], tris[t * 3 + 2]);
+      }
+    }
+
+    QString filtName = "VerifyTriangleWinding";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer windingFilter = factory->create();
+    DREAM3D_REQUIRE(windingFilter.get() != nullptr)
+    windingFilter->setDataContainerArray(dca);
+
+    QVariant var;
+    DataArrayPath path(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    var.setValue(path);
+    bool propWasSet = windingFilter->setProperty("SurfaceMeshFaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    windingFilter->execute();
+    int32_t err = windingFilter->getErrorCode();
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+
+    for(size_t t = 0; t < numTriangles; t++)
+    {
+      DREAM3D_REQUIRE(windingAlignment(vertices, tris + t * 3, expectedNormals.data() + t * 3) > 0.0f)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestRestoreFlippedTriangles(false))
+    DREAM3D_REGISTER_TEST(TestRestoreFlippedTriangles(true))
+  }
+
+private:
+};
@@ -34,7 +34,7 @@
 # ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 set(${PLUGIN_NAME}_Utilities_MOC_HDRS
-
+  ${${PLUGIN_NAME}_SOURCE_DIR}/Gui/Utilities/StatsGenPreviewService.h
 )
 
 
@@ -45,6 +45,7 @@ set(${PLUGIN_NAME}_Utilities_HDRS
 
 set(${PLUGIN_NAME}_Utilities_SRCS
   ${${PLUGIN_NAME}_SOURCE_DIR}/Gui/Utilities/PoleFigureImageUtilities.cpp
+  ${${PLUGIN_NAME}_SOURCE_DIR}/Gui/Utilities/StatsGenPreviewService.cpp
 
 )
 # QT5_WRAP_CPP( ${PLUGIN_NAME}_Generated_MOC_SRCS ${${PLUGIN_NAME}_Utilities_MOC_HDRS} )
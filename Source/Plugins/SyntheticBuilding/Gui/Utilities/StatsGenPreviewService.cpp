@@ -0,0 +1,478 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "StatsGenPreviewService.h"
+
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QMetaObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+#include "EbsdLib/LaueOps/CubicLowOps.h"
+#include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/LaueOps/HexagonalLowOps.h"
+#include "EbsdLib/LaueOps/HexagonalOps.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/MonoclinicOps.h"
+#include "EbsdLib/LaueOps/OrthoRhombicOps.h"
+#include "EbsdLib/LaueOps/TetragonalLowOps.h"
+#include "EbsdLib/LaueOps/TetragonalOps.h"
+#include "EbsdLib/LaueOps/TriclinicOps.h"
+#include "EbsdLib/LaueOps/TrigonalLowOps.h"
+#include "EbsdLib/LaueOps/TrigonalOps.h"
+#include "EbsdLib/Texture/StatsGen.hpp"
+#include "EbsdLib/Utilities/PoleFigureUtilities.h"
+
+#include "SyntheticBuilding/Gui/Utilities/PoleFigureImageUtilities.h"
+
+namespace
+{
+constexpr int k_DefaultDebounceInterval = 250;
+constexpr size_t k_ImageCacheSize = 8;
+
+/**
+ * @brief The PreviewJob class runs one preview computation on the thread pool
+ */
+class PreviewJob : public QRunnable
+{
+public:
+  explicit PreviewJob(std::function<void()> function)
+  : m_Function(std::move(function))
+  {
+  }
+  ~PreviewJob() override = default;
+
+  void run() override
+  {
+    m_Function();
+  }
+
+private:
+  std::function<void()> m_Function;
+};
+
+void AppendValues(const std::vector<float>& values, QByteArray& key)
+{
+  int32_t count = static_cast<int32_t>(values.size());
+  key.append(reinterpret_cast<const char*>(&count), sizeof(count));
+  key.append(reinterpret_cast<const char*>(values.data()), static_cast<int>(values.size() * sizeof(float)));
+}
+
+void AppendInt(int32_t value, QByteArray& key)
+{
+  key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+QByteArray CreateODFPreviewKey(const StatsGenPreviewService::ODFPreviewRequest& request)
+{
+  QByteArray key;
+  AppendInt(static_cast<int32_t>(request.odf.crystalStructure), key);
+  AppendValues(request.odf.e1s, key);
+  AppendValues(request.odf.e2s, key);
+  AppendValues(request.odf.e3s, key);
+  AppendValues(request.odf.weights, key);
+  AppendValues(request.odf.sigmas, key);
+  AppendInt(request.samplePoints, key);
+  AppendInt(request.imageSize, key);
+  AppendInt(request.lambertSize, key);
+  AppendInt(request.discrete ? 1 : 0, key);
+  AppendInt(request.layout, key);
+  return key;
+}
+} // namespace
+
+/**
+ * @brief The SharedState struct is shared by the service and its running jobs. The jobs only deliver their results
+ * while the service is alive, and they stop early once their generation is no longer the current one.
+ */
+struct StatsGenPreviewService::SharedState
+{
+  std::mutex mutex;
+  StatsGenPreviewService* service = nullptr;
+  std::atomic<uint64_t> odfGeneration = {0};
+  std::atomic<uint64_t> mdfGeneration = {0};
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StatsGenPreviewService::StatsGenPreviewService(QObject* parent)
+: QObject(parent)
+, m_State(std::make_shared<SharedState>())
+{
+  m_State->service = this;
+
+  m_ODFTimer.setSingleShot(true);
+  m_ODFTimer.setInterval(k_DefaultDebounceInterval);
+  connect(&m_ODFTimer, &QTimer::timeout, this, &StatsGenPreviewService::startODFPreview);
+
+  m_MDFTimer.setSingleShot(true);
+  m_MDFTimer.setInterval(k_DefaultDebounceInterval);
+  connect(&m_MDFTimer, &QTimer::timeout, this, &StatsGenPreviewService::startMDFPreview);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StatsGenPreviewService::~StatsGenPreviewService()
+{
+  // Running jobs keep the shared state alive, so they find the service gone and throw their results away
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  m_State->service = nullptr;
+  m_State->odfGeneration++;
+  m_State->mdfGeneration++;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenPreviewService::setDebounceInterval(int value)
+{
+  m_ODFTimer.setInterval(value);
+  m_MDFTimer.setInterval(value);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int StatsGenPreviewService::getDebounceInterval() const
+{
+  return m_ODFTimer.interval();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenPreviewService::requestODFPreview(const ODFPreviewRequest& request)
+{
+  m_PendingODF = std::make_unique<ODFPreviewRequest>(request);
+  m_State->odfGeneration++;
+  m_ODFTimer.start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenPreviewService::requestMDFPreview(const MDFPreviewRequest& request)
+{
+  m_PendingMDF = std::make_unique<MDFPreviewRequest>(request);
+  m_State->mdfGeneration++;
+  m_MDFTimer.start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenPreviewService::cancel()
+{
+  m_ODFTimer.stop();
+  m_MDFTimer.stop();
+  m_PendingODF.reset();
+  m_PendingMDF.reset();
+  m_State->odfGeneration++;
+  m_State->mdfGeneration++;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenPreviewService::startODFPreview()
+{
+  // Only one ODF job runs at a time. A request that arrives while it runs waits for it to finish.
+  if(m_ODFRunning || nullptr == m_PendingODF)
+  {
+    return;
+  }
+  std::shared_ptr<ODFPreviewRequest> request(m_PendingODF.release());
+  QByteArray key = CreateODFPreviewKey(*request);
+
+  for(auto iter = m_ImageCache.begin(); iter != m_ImageCache.end(); ++iter)
+  {
+    if(iter->first == key)
+    {
+      m_ImageCache.splice(m_ImageCache.begin(), m_ImageCache, iter);
+      Q_EMIT odfPreviewReady(m_ImageCache.front().second);
+      return;
+    }
+  }
+
+  m_ODFRunning = true;
+  std::shared_ptr<SharedState> state = m_State;
+  uint64_t generation = state->odfGeneration;
+  QThreadPool::globalInstance()->start(new PreviewJob([state, generation, request, key]() {
+    auto isCancelled = [&state, generation]() { return state->odfGeneration != generation; };
+    QString errorMessage;
+    QImage image;
+    try
+    {
+      image = GenerateODFPreview(*request, isCancelled, errorMessage);
+    } catch(const std::exception& e)
+    {
+      errorMessage = QString::fromLatin1(e.what());
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    StatsGenPreviewService* service = state->service;
+    if(nullptr != service)
+    {
+      QMetaObject::invokeMethod(
+          service, [service, generation, key, image, errorMessage]() { service->odfPreviewFinished(generation, key, image, errorMessage); }, Qt::QueuedConnection);
+    }
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenPreviewService::odfPreviewFinished(uint64_t generation, const QByteArray& key, const QImage& image, const QString& errorMessage)
+{
+  m_ODFRunning = false;
+  if(!image.isNull())
+  {
+    // A result that is no longer wanted is still correct for its texture, so it is kept for when the user returns to it
+    m_ImageCache.emplace_front(key, image);
+    if(m_ImageCache.size() > k_ImageCacheSize)
+    {
+      m_ImageCache.pop_back();
+    }
+  }
+
+  if(generation == m_State->odfGeneration)
+  {
+    if(!image.isNull())
+    {
+      Q_EMIT odfPreviewReady(image);
+    }
+    else if(!errorMessage.isEmpty())
+    {
+      Q_EMIT odfPreviewFailed(errorMessage);
+    }
+  }
+
+  if(!m_ODFTimer.isActive())
+  {
+    startODFPreview();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenPreviewService::startMDFPreview()
+{
+  if(m_MDFRunning || nullptr == m_PendingMDF)
+  {
+    return;
+  }
+  std::shared_ptr<MDFPreviewRequest> request(m_PendingMDF.release());
+
+  m_MDFRunning = true;
+  std::shared_ptr<SharedState> state = m_State;
+  uint64_t generation = state->mdfGeneration;
+  QThreadPool::globalInstance()->start(new PreviewJob([state, generation, request]() {
+    QString errorMessage;
+    QVector<double> x;
+    QVector<double> y;
+    if(state->mdfGeneration == generation)
+    {
+      try
+      {
+        std::shared_ptr<const TextureComputeService::MDFPlotData> plot = TextureComputeService::Instance()->mdfPlot(request->odf, request->mdf, request->samples);
+        if(plot->error < 0)
+        {
+          errorMessage = QString("Error creating the MDF Plot");
+        }
+        else
+        {
+          x.resize(static_cast<int>(plot->x.size()));
+          y.resize(static_cast<int>(plot->x.size()));
+          for(int i = 0; i < x.size(); i++)
+          {
+            x[i] = static_cast<double>(plot->x[i]);
+            y[i] = static_cast<double>(plot->y[i]);
+          }
+        }
+      } catch(const std::exception& e)
+      {
+        errorMessage = QString::fromLatin1(e.what());
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    StatsGenPreviewService* service = state->service;
+    if(nullptr != service)
+    {
+      QMetaObject::invokeMethod(
+          service, [service, generation, x, y, errorMessage]() { service->mdfPreviewFinished(generation, x, y, errorMessage); }, Qt::QueuedConnection);
+    }
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenPreviewService::mdfPreviewFinished(uint64_t generation, const QVector<double>& x, const QVector<double>& y, const QString& errorMessage)
+{
+  m_MDFRunning = false;
+  if(generation == m_State->mdfGeneration)
+  {
+    if(!errorMessage.isEmpty())
+    {
+      Q_EMIT mdfPreviewFailed(errorMessage);
+    }
+    else
+    {
+      Q_EMIT mdfPreviewReady(x, y);
+    }
+  }
+
+  if(!m_MDFTimer.isActive())
+  {
+    startMDFPreview();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QImage StatsGenPreviewService::GenerateODFPreview(const ODFPreviewRequest& request, const std::function<bool()>& isCancelled, QString& errorMessage)
+{
+  using ContainerType = std::vector<float>;
+
+  std::shared_ptr<const ContainerType> odfPtr = TextureComputeService::Instance()->odf(request.odf);
+  if(isCancelled())
+  {
+    return QImage();
+  }
+  const ContainerType& odf = *odfPtr;
+
+  int npoints = request.samplePoints;
+  std::vector<size_t> dims(1, 3);
+  EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(npoints, dims, "Eulers", true);
+  PoleFigureConfiguration_t config;
+  config.eulers = eulers.get();
+  config.imageDim = request.imageSize;
+  config.lambertDim = request.lambertSize;
+  config.numColors = 16;
+  config.discrete = request.discrete;
+  config.discreteHeatMap = false;
+
+  int err = 0;
+  LaueOps::Pointer ops = LaueOps::NullPointer();
+  switch(request.odf.crystalStructure)
+  {
+  case EbsdLib::CrystalStructure::Triclinic: // 4; Triclinic -1
+    err = StatsGen::GenODFPlotData<float, TriclinicOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = TriclinicOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Monoclinic: // 5; Monoclinic 2/m
+    err = StatsGen::GenODFPlotData<float, MonoclinicOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = MonoclinicOps::New();
+    break;
+  case EbsdLib::CrystalStructure::OrthoRhombic: // 6; Orthorhombic mmm
+    err = StatsGen::GenODFPlotData<float, OrthoRhombicOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = OrthoRhombicOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Tetragonal_Low: // 7; Tetragonal-Low 4/m
+    err = StatsGen::GenODFPlotData<float, TetragonalLowOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = TetragonalLowOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Tetragonal_High: // 8; Tetragonal-High 4/mmm
+    err = StatsGen::GenODFPlotData<float, TetragonalOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = TetragonalOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Trigonal_Low: // 9; Trigonal-Low -3
+    err = StatsGen::GenODFPlotData<float, TrigonalLowOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = TrigonalLowOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Trigonal_High: // 10; Trigonal-High -3m
+    err = StatsGen::GenODFPlotData<float, TrigonalOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = TrigonalOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Hexagonal_Low: // 2; Hexagonal-Low 6/m
+    err = StatsGen::GenODFPlotData<float, HexagonalLowOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = HexagonalLowOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Hexagonal_High: // 0; Hexagonal-High 6/mmm
+    err = StatsGen::GenODFPlotData<float, HexagonalOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = HexagonalOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Cubic_Low: // 3; Cubic Cubic-Low m3 (Tetrahedral)
+    err = StatsGen::GenODFPlotData<float, CubicLowOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = CubicLowOps::New();
+    break;
+  case EbsdLib::CrystalStructure::Cubic_High: // 1; Cubic Cubic-High m3m
+    err = StatsGen::GenODFPlotData<float, CubicOps, ContainerType>(odf, eulers->getPointer(0), npoints);
+    ops = CubicOps::New();
+    break;
+  default:
+    err = -1;
+    break;
+  }
+
+  if(err < 0 || nullptr == ops.get())
+  {
+    errorMessage = QString("Error creating the ODF Plots");
+    return QImage();
+  }
+  if(isCancelled())
+  {
+    return QImage();
+  }
+
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> figures = ops->generatePoleFigure(config);
+  if(figures.size() < 3)
+  {
+    errorMessage = QString("Error creating the ODF Plots");
+    return QImage();
+  }
+  if(isCancelled())
+  {
+    return QImage();
+  }
+
+  std::vector<UInt8ArrayType::Pointer> convertedFigures;
+  for(const auto& figure : figures)
+  {
+    convertedFigures.emplace_back(figure->moveToDataArrayType<UInt8ArrayType>());
+  }
+
+  return PoleFigureImageUtilities::Create3ImagePoleFigure(convertedFigures[0].get(), convertedFigures[1].get(), convertedFigures[2].get(), config, request.layout);
+}
@@ -0,0 +1,161 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <utility>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+#include <QtGui/QImage>
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/TextureComputeService.h"
+
+/**
+ * @class StatsGenPreviewService StatsGenPreviewService.h SyntheticBuilding/Gui/Utilities/StatsGenPreviewService.h
+ * @brief Computes the ODF pole figures and the MDF plot of the StatsGenerator widgets on the global thread pool.
+ * Requests are collected for a short interval after the last edit so typing into a table only computes the final
+ * values. A request that is replaced by a newer one stops at its next check and its result is dropped, so only the
+ * newest preview is ever delivered. Pole figure images are kept for the last few requests and the ODF and MDF data
+ * come from the TextureComputeService, which the StatsGenerator filters share.
+ */
+class StatsGenPreviewService : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief The ODFPreviewRequest struct holds the texture and the pole figure settings of an ODF preview
+   */
+  struct ODFPreviewRequest
+  {
+    TextureComputeService::ODFInput odf;
+    int samplePoints = 1000;
+    int imageSize = 226;
+    int lambertSize = 32;
+    bool discrete = true;
+    int layout = 0;
+  };
+
+  /**
+   * @brief The MDFPreviewRequest struct holds the texture and the misorientation entries of an MDF preview
+   */
+  struct MDFPreviewRequest
+  {
+    TextureComputeService::ODFInput odf;
+    TextureComputeService::MDFInput mdf;
+    int samples = 100000;
+  };
+
+  StatsGenPreviewService(QObject* parent = nullptr);
+  ~StatsGenPreviewService() override;
+
+  /**
+   * @brief Setter property for DebounceInterval, the time in milliseconds to wait after the last request
+   */
+  void setDebounceInterval(int value);
+  /**
+   * @brief Getter property for DebounceInterval
+   * @return Value of DebounceInterval
+   */
+  int getDebounceInterval() const;
+
+  /**
+   * @brief requestODFPreview Schedules an ODF preview. Replaces any ODF preview that was requested before.
+   * @param request
+   */
+  void requestODFPreview(const ODFPreviewRequest& request);
+
+  /**
+   * @brief requestMDFPreview Schedules an MDF preview. Replaces any MDF preview that was requested before.
+   * @param request
+   */
+  void requestMDFPreview(const MDFPreviewRequest& request);
+
+  /**
+   * @brief cancel Drops the pending requests and the results of the running ones
+   */
+  void cancel();
+
+  /**
+   * @brief GenerateODFPreview Computes the 3 pole figures of the ODF and combines them into one image. This runs on
+   * the calling thread and does not need the service, so it can also be used without a GUI.
+   * @param request
+   * @param isCancelled Checked between the steps. The computation stops when it returns true.
+   * @param errorMessage Set when the image could not be generated
+   * @return The image, or a null image if the computation failed or was cancelled
+   */
+  static QImage GenerateODFPreview(const ODFPreviewRequest& request, const std::function<bool()>& isCancelled, QString& errorMessage);
+
+Q_SIGNALS:
+  void odfPreviewReady(const QImage& image);
+  void odfPreviewFailed(const QString& message);
+  void mdfPreviewReady(const QVector<double>& x, const QVector<double>& y);
+  void mdfPreviewFailed(const QString& message);
+
+protected Q_SLOTS:
+  void startODFPreview();
+  void startMDFPreview();
+
+protected:
+  void odfPreviewFinished(uint64_t generation, const QByteArray& key, const QImage& image, const QString& errorMessage);
+  void mdfPreviewFinished(uint64_t generation, const QVector<double>& x, const QVector<double>& y, const QString& errorMessage);
+
+private:
+  struct SharedState;
+
+  std::shared_ptr<SharedState> m_State;
+  QTimer m_ODFTimer;
+  QTimer m_MDFTimer;
+  std::unique_ptr<ODFPreviewRequest> m_PendingODF;
+  std::unique_ptr<MDFPreviewRequest> m_PendingMDF;
+  bool m_ODFRunning = false;
+  bool m_MDFRunning = false;
+  std::list<std::pair<QByteArray, QImage>> m_ImageCache;
+
+public:
+  StatsGenPreviewService(const StatsGenPreviewService&) = delete;            // Copy Constructor Not Implemented
+  StatsGenPreviewService(StatsGenPreviewService&&) = delete;                 // Move Constructor Not Implemented
+  StatsGenPreviewService& operator=(const StatsGenPreviewService&) = delete; // Copy Assignment Not Implemented
+  StatsGenPreviewService& operator=(StatsGenPreviewService&&) = delete;      // Move Assignment Not Implemented
+};
@@ -91,7 +91,7 @@
 #include "EbsdLib/Texture/StatsGen.hpp"
 #include "EbsdLib/Texture/Texture.hpp"
 
-#include "SyntheticBuilding/Gui/Widgets/StatsProgressWidget.h"
+#include "SyntheticBuilding/Gui/Utilities/StatsGenPreviewService.h"
 #include "SyntheticBuilding/Gui/Widgets/TableModels/SGMDFTableModel.h"
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingFilters/StatsGeneratorUtilities.h"
@@ -142,6 +142,9 @@ void StatsGenMDFWidget::setupGui()
   QAbstractItemDelegate* aid = m_MDFTableModel->getItemDelegate();
   m_MDFTableView->setItemDelegate(aid);
   m_PlotCurve = new QwtPlotCurve;
+
+  m_PreviewService = new StatsGenPreviewService(this);
+  connect(m_PreviewService, &StatsGenPreviewService::mdfPreviewReady, this, &StatsGenMDFWidget::mdfPreviewReady);
 }
 
 // -----------------------------------------------------------------------------
@@ -217,43 +220,28 @@ void StatsGenMDFWidget::initQwtPlot(const QString& xAxisName, const QString& yAx
 void StatsGenMDFWidget::updatePlots()
 {
   // Generate the ODF Data from the current values in the ODFTableModel
-  std::vector<float> e1s;
-  std::vector<float> e2s;
-  std::vector<float> e3s;
-  std::vector<float> weights;
-  std::vector<float> sigmas;
   if(nullptr == m_ODFTableModel)
   {
     return;
   }
-  // Initialize xMax and yMax....
-  e1s = m_ODFTableModel->getData(SGODFTableModel::Euler1);
-  e2s = m_ODFTableModel->getData(SGODFTableModel::Euler2);
-  e3s = m_ODFTableModel->getData(SGODFTableModel::Euler3);
-  weights = m_ODFTableModel->getData(SGODFTableModel::Weight);
-  sigmas = m_ODFTableModel->getData(SGODFTableModel::Sigma);
-
-  // Convert Degrees to Radians for ODF
-  for(size_t i = 0; i < e1s.size(); i++)
+  TextureComputeService::ODFInput odfInput;
+  odfInput.crystalStructure = m_CrystalStructure;
+  odfInput.e1s = m_ODFTableModel->getData(SGODFTableModel::Euler1);
+  odfInput.e2s = m_ODFTableModel->getData(SGODFTableModel::Euler2);
+  odfInput.e3s = m_ODFTableModel->getData(SGODFTableModel::Euler3);
+  odfInput.weights = m_ODFTableModel->getData(SGODFTableModel::Weight);
+  odfInput.sigmas = m_ODFTableModel->getData(SGODFTableModel::Sigma);
+
+  // Convert Degrees to Radians for ODF. This is the same conversion the ODF widget uses, so both widgets ask
+  // the preview service for the same ODF and it is only computed once.
+  for(size_t i = 0; i < odfInput.e1s.size(); i++)
   {
-    e1s[i] = e1s[i] * static_cast<float>(SIMPLib::Constants::k_PiOver180D);
-    e2s[i] = e2s[i] * static_cast<float>(SIMPLib::Constants::k_PiOver180D);
-    e3s[i] = e3s[i] * static_cast<float>(SIMPLib::Constants::k_PiOver180D);
+    odfInput.e1s[i] = odfInput.e1s[i] * SIMPLib::Constants::k_PiOver180F;
+    odfInput.e2s[i] = odfInput.e2s[i] * SIMPLib::Constants::k_PiOver180F;
+    odfInput.e3s[i] = odfInput.e3s[i] * SIMPLib::Constants::k_PiOver180F;
   }
 
-  StatsProgressWidget progress("Calculating/Updating the ODF", "Cancel", nullptr);
-  progress.setLabelText("Please Wait...");
-  progress.setProgTitle("Generating ODF Plot Data...");
-  progress.setVisible(true);
-  progress.show();
-  qApp->processEvents();
-
-  progress.setValue(0);
-  progress.setLabelText("Calculating ODF");
-
-  std::vector<float> odf = StatsGeneratorUtilities::GenerateODFData(m_CrystalStructure, e1s, e2s, e3s, weights, sigmas);
-
-  updateMDFPlot(odf);
+  updateMDFPlot(odfInput);
 
   Q_EMIT dataChanged();
 }
@@ -269,24 +257,16 @@ void StatsGenMDFWidget::on_m_MDFUpdateBtn_clicked()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void StatsGenMDFWidget::updateMDFPlot(std::vector<float>& odf)
+void StatsGenMDFWidget::updateMDFPlot(const TextureComputeService::ODFInput& odfInput)
 {
-  int err = 0;
-  int size = 100000;
-
-  StatsProgressWidget progress("Calculating/Updating the MDF", "Cancel", nullptr);
-  progress.setLabelText("Please Wait...");
-  progress.setProgTitle("Generating MDF Plot Data...");
-  progress.setVisible(true);
-  progress.show();
-  qApp->processEvents();
-
   // These are the input vectors
-  using ContainerType = std::vector<float>;
-
-  ContainerType angles = m_MDFTableModel->getData(SGMDFTableModel::Angle);
-  ContainerType axes = m_MDFTableModel->getData(SGMDFTableModel::Axis);
-  ContainerType weights = m_MDFTableModel->getData(SGMDFTableModel::Weight);
+  StatsGenPreviewService::MDFPreviewRequest request;
+  request.odf = odfInput;
+  std::vector<float>& angles = request.mdf.angles;
+  std::vector<float>& axes = request.mdf.axes;
+  angles = m_MDFTableModel->getData(SGMDFTableModel::Angle);
+  axes = m_MDFTableModel->getData(SGMDFTableModel::Axis);
+  request.mdf.weights = m_MDFTableModel->getData(SGMDFTableModel::Weight);
 
   // Ensure that the angle is in range of [0,pi] and Convert Angles to Radians
   for(auto& angle : angles)
@@ -327,79 +307,16 @@ void StatsGenMDFWidget::updateMDFPlot(std::vector<float>& odf)
     }
   }
 
-  // These are the output vectors
-  ContainerType x;
-  ContainerType y;
-  ContainerType mdf;
-
-  progress.setValue(1);
-  progress.setLabelText("Calculating and Generating MDF.....");
-
-  //// ODF/MDF Update Codes
-  switch(m_CrystalStructure)
-  {
-  case EbsdLib::CrystalStructure::Triclinic: // 4; Triclinic -1
-    Texture::CalculateMDFData<float, TriclinicOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, TriclinicOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Monoclinic: // 5; Monoclinic 2/m
-    Texture::CalculateMDFData<float, MonoclinicOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, MonoclinicOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::OrthoRhombic: // 6; Orthorhombic mmm
-    Texture::CalculateMDFData<float, OrthoRhombicOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, OrthoRhombicOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Tetragonal_Low: // 7; Tetragonal-Low 4/m
-    Texture::CalculateMDFData<float, TetragonalLowOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, TetragonalLowOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Tetragonal_High: // 8; Tetragonal-High 4/mmm
-    Texture::CalculateMDFData<float, TetragonalOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, TetragonalOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Trigonal_Low: // 9; Trigonal-Low -3
-    Texture::CalculateMDFData<float, TrigonalLowOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, TrigonalLowOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Trigonal_High: // 10; Trigonal-High -3m
-    Texture::CalculateMDFData<float, TrigonalOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, TrigonalOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Hexagonal_Low: // 2; Hexagonal-Low 6/m
-    Texture::CalculateMDFData<float, HexagonalLowOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, HexagonalLowOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Hexagonal_High: // 0; Hexagonal-High 6/mmm
-    Texture::CalculateMDFData<float, HexagonalOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, HexagonalOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Cubic_Low: // 3; Cubic Cubic-Low m3 (Tetrahedral)
-    Texture::CalculateMDFData<float, CubicLowOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, CubicLowOps, ContainerType>(mdf, x, y, size);
-    break;
-  case EbsdLib::CrystalStructure::Cubic_High: // 1; Cubic Cubic-High m3m
-    Texture::CalculateMDFData<float, CubicOps, ContainerType>(angles, axes, weights, odf, mdf, static_cast<size_t>(angles.size()));
-    err = StatsGen::GenMDFPlotData<float, CubicOps, ContainerType>(mdf, x, y, size);
-    break;
-  default:
-    err = -1;
-    break;
-  }
-
-  if(err < 0)
-  {
-    return;
-  }
+  // The MDF is computed on the thread pool and shows up in mdfPreviewReady()
+  m_PreviewService->requestMDFPreview(request);
+}
 
-  m_MDFPlot->setAxisScale(QwtPlot::xBottom, 0.0, x.size() * 5.0, 10);
-  QVector<double> xD(static_cast<int>(x.size()));
-  QVector<double> yD(static_cast<int>(x.size()));
-  for(ContainerType::size_type i = 0; i < x.size(); ++i)
-  {
-    xD[i] = static_cast<double>(x[i]);
-    yD[i] = static_cast<double>(y[i]);
-  }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenMDFWidget::mdfPreviewReady(const QVector<double>& xD, const QVector<double>& yD)
+{
+  m_MDFPlot->setAxisScale(QwtPlot::xBottom, 0.0, xD.size() * 5.0, 10);
 
   // This will actually plot the XY data in the Qwt plot widget
   QwtPlotCurve* curve = m_PlotCurve;
@@ -607,7 +524,13 @@ int StatsGenMDFWidget::getMisorientationData(StatsData* statsData, PhaseType::Ty
     e3s[i] *= SIMPLib::Constants::k_PiOver180F;
   }
 
-  std::vector<float> odf = StatsGeneratorUtilities::GenerateODFData(m_CrystalStructure, e1s, e2s, e3s, odf_weights, sigmas, !preflight);
+  // The previews have usually computed this ODF already, so it normally comes straight from the cache
+  std::vector<float> odf;
+  if(!preflight)
+  {
+    TextureComputeService::ODFInput odfInput = {m_CrystalStructure, e1s, e2s, e3s, odf_weights, sigmas};
+    odf = *(TextureComputeService::Instance()->odf(odfInput));
+  }
 
   // Now use the ODF data to generate the MDF data ************************************************
   std::vector<float> angles = m_MDFTableModel->getData(SGMDFTableModel::Angle);
@@ -49,8 +49,10 @@
 #include "EbsdLib/Core/EbsdLibConstants.h"
 
 #include "SyntheticBuilding/Gui/Widgets/TableModels/SGODFTableModel.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/TextureComputeService.h"
 
 class SGMDFTableModel;
+class StatsGenPreviewService;
 class QwtPlot;
 class QwtPlotCurve;
 class QwtPlotPicker;
@@ -143,12 +145,23 @@ protected Q_SLOTS:
    */
   void tableDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
 
+  /**
+   * @brief mdfPreviewReady Plots the MDF of the last requested misorientation entries
+   * @param xD
+   * @param yD
+   */
+  void mdfPreviewReady(const QVector<double>& xD, const QVector<double>& yD);
+
 Q_SIGNALS:
 
   void dataChanged();
 
 protected:
-  void updateMDFPlot(std::vector<float>& odf);
+  /**
+   * @brief updateMDFPlot Requests the MDF of the table entries on top of the ODF from the preview service
+   * @param odfInput
+   */
+  void updateMDFPlot(const TextureComputeService::ODFInput& odfInput);
 
 private:
   SGODFTableModel* m_ODFTableModel = nullptr;
@@ -161,6 +174,7 @@ private:
 
   QwtPlotPicker* m_PlotPicker = nullptr;
   QwtPickerMachine* m_PlotPickerMachine = nullptr;
+  StatsGenPreviewService* m_PreviewService = nullptr;
 
   QString m_OpenDialogLastFilePath; // Must be last in the list
 
@@ -90,8 +90,8 @@
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
 
 #include "SyntheticBuilding/Gui/Utilities/PoleFigureImageUtilities.h"
+#include "SyntheticBuilding/Gui/Utilities/StatsGenPreviewService.h"
 #include "SyntheticBuilding/Gui/Widgets/StatsGenMDFWidget.h"
-#include "SyntheticBuilding/Gui/Widgets/StatsProgressWidget.h"
 #include "SyntheticBuilding/Gui/Widgets/TableModels/SGODFTableModel.h"
 #include "SyntheticBuilding/Gui/Widgets/TextureDialog.h"
 #include "SyntheticBuilding/SyntheticBuildingFilters/StatsGeneratorUtilities.h"
@@ -374,6 +374,10 @@ void StatsGenODFWidget::setupGui()
   m_PlotCurves.push_back(new QwtPlotCurve);
   m_PlotCurves.push_back(new QwtPlotCurve);
 
+  m_PreviewService = new StatsGenPreviewService(this);
+  connect(m_PreviewService, &StatsGenPreviewService::odfPreviewReady, this, &StatsGenODFWidget::odfPreviewReady);
+  connect(m_PreviewService, &StatsGenPreviewService::odfPreviewFailed, this, &StatsGenODFWidget::odfPreviewFailed);
+
   m_ButtonGroup.addButton(m_WeightSpreads);
   m_ButtonGroup.addButton(m_WeightSpreadsBulkLoad);
   on_m_WeightSpreads_clicked(true);
@@ -502,7 +506,6 @@ void StatsGenODFWidget::updatePlots()
   m_AbortUpdate = false;
   calculateODF();
   m_AbortUpdate = true;
-  updatePFStatus(QString(""));
   Q_EMIT odfDataChanged();
 }
 
@@ -519,48 +522,30 @@ void StatsGenODFWidget::on_m_CalculateODFBtn_clicked()
 // -----------------------------------------------------------------------------
 void StatsGenODFWidget::calculateODF()
 {
-  int err = 0;
   if(m_AbortUpdate)
   {
     return;
   }
-  StatsProgressWidget progress("Calculating/Updating the ODF", "Cancel", nullptr);
-  progress.setLabelText("Please Wait...");
-  progress.setProgTitle("Generating ODF Plot Data...");
-  progress.setVisible(true);
-  progress.show();
-  qApp->processEvents();
-
-  progress.setValue(0);
-  progress.setLabelText("Calculating ODF");
 
   using ContainerType = std::vector<float>;
-  ContainerType e1s;
-  ContainerType e2s;
-  ContainerType e3s;
-  ContainerType weights;
-  ContainerType sigmas;
-  ContainerType odf;
 
   SGODFTableModel* tableModel = nullptr;
 
-  int npoints = 0;
+  StatsGenPreviewService::ODFPreviewRequest request;
   if(m_WeightSpreads->isChecked())
   {
     tableModel = m_ODFTableModel;
-    npoints = pfSamplePoints->value();
+    request.samplePoints = pfSamplePoints->value();
   }
   else
   {
     tableModel = m_OdfBulkTableModel;
-    npoints = tableModel->rowCount();
+    request.samplePoints = tableModel->rowCount();
   }
 
-  e1s = tableModel->getData(SGODFTableModel::Euler1);
-  e2s = tableModel->getData(SGODFTableModel::Euler2);
-  e3s = tableModel->getData(SGODFTableModel::Euler3);
-  weights = tableModel->getData(SGODFTableModel::Weight);
-  sigmas = tableModel->getData(SGODFTableModel::Sigma);
+  ContainerType e1s = tableModel->getData(SGODFTableModel::Euler1);
+  ContainerType e2s = tableModel->getData(SGODFTableModel::Euler2);
+  ContainerType e3s = tableModel->getData(SGODFTableModel::Euler3);
 
   // Convert from Degrees to Radians
   for(ContainerType::size_type i = 0; i < e1s.size(); i++)
@@ -569,117 +554,43 @@ void StatsGenODFWidget::calculateODF()
     e2s[i] = e2s[i] * SIMPLib::Constants::k_PiOver180F;
     e3s[i] = e3s[i] * SIMPLib::Constants::k_PiOver180F;
   }
-  size_t numEntries = static_cast<size_t>(e1s.size());
-
-  int imageSize = m_PFImageSize->value();
-  int lamberSize = m_PFLambertSize->value();
-  int numColors = 16;
-
-  std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(npoints, dims, "Eulers", true);
-  PoleFigureConfiguration_t config;
-  config.eulers = eulers.get();
-  config.imageDim = imageSize;
-  config.lambertDim = lamberSize;
-  config.numColors = numColors;
-  config.discrete = true;
-  config.discreteHeatMap = false;
 
+  request.odf.crystalStructure = m_CrystalStructure;
+  request.odf.e1s = std::move(e1s);
+  request.odf.e2s = std::move(e2s);
+  request.odf.e3s = std::move(e3s);
+  request.odf.weights = tableModel->getData(SGODFTableModel::Weight);
+  request.odf.sigmas = tableModel->getData(SGODFTableModel::Sigma);
+  request.imageSize = m_PFImageSize->value();
+  request.lambertSize = m_PFLambertSize->value();
   // Check if the user wants a Discreet or Lambert PoleFigure
-  if(m_PFTypeCB->currentIndex() == 1)
-  {
-    config.discrete = false;
-  }
-  std::vector<EbsdLib::UInt8ArrayType::Pointer> figures;
+  request.discrete = (m_PFTypeCB->currentIndex() != 1);
+  request.layout = m_ImageLayoutCB->currentIndex();
 
-  //// ODF/MDF Update Codes
-  LaueOps::Pointer ops = LaueOps::NullPointer();
-  switch(m_CrystalStructure)
-  {
-  case EbsdLib::CrystalStructure::Triclinic: // 4; Triclinic -1
-    Texture::CalculateODFData<float, TriclinicOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, TriclinicOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = TriclinicOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Monoclinic: // 5; Monoclinic 2/m
-    Texture::CalculateODFData<float, MonoclinicOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, MonoclinicOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = MonoclinicOps::New();
-    break;
-  case EbsdLib::CrystalStructure::OrthoRhombic: // 6; Orthorhombic mmm
-    Texture::CalculateODFData<float, OrthoRhombicOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, OrthoRhombicOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = OrthoRhombicOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Tetragonal_Low: // 7; Tetragonal-Low 4/m
-    Texture::CalculateODFData<float, TetragonalLowOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, TetragonalLowOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = TetragonalLowOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Tetragonal_High: // 8; Tetragonal-High 4/mmm
-    Texture::CalculateODFData<float, TetragonalOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, TetragonalOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = TetragonalOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Trigonal_Low: // 9; Trigonal-Low -3
-    Texture::CalculateODFData<float, TrigonalLowOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, TrigonalLowOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = TrigonalLowOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Trigonal_High: // 10; Trigonal-High -3m
-    Texture::CalculateODFData<float, TrigonalOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, TrigonalOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = TrigonalOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Hexagonal_Low: // 2; Hexagonal-Low 6/m
-    Texture::CalculateODFData<float, HexagonalLowOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, HexagonalLowOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = HexagonalLowOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Hexagonal_High: // 0; Hexagonal-High 6/mmm
-    Texture::CalculateODFData<float, HexagonalOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, HexagonalOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = HexagonalOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Cubic_Low: // 3; Cubic Cubic-Low m3 (Tetrahedral)
-    Texture::CalculateODFData<float, CubicLowOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, CubicLowOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = CubicLowOps::New();
-    break;
-  case EbsdLib::CrystalStructure::Cubic_High: // 1; Cubic Cubic-High m3m
-    Texture::CalculateODFData<float, CubicOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-    err = StatsGen::GenODFPlotData<float, CubicOps, ContainerType>(odf, eulers->getPointer(0), npoints);
-    ops = CubicOps::New();
-    break;
-  default:
-    err = -1;
-    break;
-  }
-
-  if(err < 0)
-  {
-    QString ss("Error creating the ODF Plots");
-    QMessageBox::StandardButton reply;
-    reply = QMessageBox::critical(nullptr, QString("ODF Generation Error"), ss, QMessageBox::Ok);
-    Q_UNUSED(reply);
-  }
-  else
-  {
-    if(nullptr != ops.get())
-    {
-      figures = ops->generatePoleFigure(config);
-    }
+  // The pole figures are computed on the thread pool and show up in odfPreviewReady()
+  updatePFStatus(QString("Generating Pole Figures..."));
+  m_PreviewService->requestODFPreview(request);
+}
 
-    std::vector<UInt8ArrayType::Pointer> convertedFigures;
-    for(const auto& figure : figures)
-    {
-      convertedFigures.emplace_back(figure->moveToDataArrayType<UInt8ArrayType>());
-    }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenODFWidget::odfPreviewReady(const QImage& image)
+{
+  updatePFStatus(QString(""));
+  m_PoleFigureLabel->setPixmap(QPixmap::fromImage(image));
+  Q_EMIT dataChanged();
+}
 
-    QImage image = PoleFigureImageUtilities::Create3ImagePoleFigure(convertedFigures[0].get(), convertedFigures[1].get(), convertedFigures[2].get(), config, m_ImageLayoutCB->currentIndex());
-    m_PoleFigureLabel->setPixmap(QPixmap::fromImage(image));
-    Q_EMIT dataChanged();
-  }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StatsGenODFWidget::odfPreviewFailed(const QString& message)
+{
+  updatePFStatus(QString(""));
+  QMessageBox::StandardButton reply;
+  reply = QMessageBox::critical(nullptr, QString("ODF Generation Error"), message, QMessageBox::Ok);
+  Q_UNUSED(reply);
 }
 
 // -----------------------------------------------------------------------------
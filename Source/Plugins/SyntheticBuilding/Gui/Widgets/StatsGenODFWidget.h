@@ -53,6 +53,7 @@
 #include "SyntheticBuilding/Gui/Utilities/PoleFigureImageUtilities.h"
 
 class SGODFTableModel;
+class StatsGenPreviewService;
 class StatsGenMDFWidget;
 class QwtPlot;
 class QwtPlotZoomer;
@@ -137,6 +138,18 @@ protected Q_SLOTS:
   void on_m_PFLambertSize_valueChanged(int i);
   void updatePFStatus(const QString& msg);
 
+  /**
+   * @brief odfPreviewReady Shows the pole figures of the last requested ODF
+   * @param image
+   */
+  void odfPreviewReady(const QImage& image);
+
+  /**
+   * @brief odfPreviewFailed
+   * @param message
+   */
+  void odfPreviewFailed(const QString& message);
+
 Q_SIGNALS:
   void dataChanged();
   void bulkLoadEvent(bool fail);
@@ -144,7 +157,7 @@ Q_SIGNALS:
 
 protected:
   /**
-   * @brief calculateODF
+   * @brief calculateODF Requests the pole figures of the current ODF from the preview service
    */
   void calculateODF();
 
@@ -164,6 +177,7 @@ private:
   QButtonGroup m_ButtonGroup;
   QButtonGroup m_ODFGroup;
   bool m_AbortUpdate = true;
+  StatsGenPreviewService* m_PreviewService = nullptr;
 
   QString m_OpenDialogLastFilePath; // Must be last in the list
 
@@ -34,22 +34,150 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AddBadData.h"
 
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
-#include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/CounterRandom.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
+namespace
+{
+// Streams of the counter based generator, one for each draw made for a cell
+constexpr uint64_t k_BoundaryNoiseStream = 1ULL << 32;
+constexpr uint64_t k_PoissonNoiseStream = k_BoundaryNoiseStream + 1;
+
+/**
+ * @brief The MarkBadDataImpl class implements a threaded algorithm that decides which cells become "bad" data. The
+ * random numbers of a cell only depend on the seed and the cell index.
+ */
+class MarkBadDataImpl
+{
+public:
+  MarkBadDataImpl(const CounterRandom& random, const int32_t* gbEuclideanDistances, bool boundaryNoise, float boundaryVolFraction, bool poissonNoise, float poissonVolFraction,
+                  std::vector<uint8_t>& badData)
+  : m_Random(random)
+  , m_GBEuclideanDistances(gbEuclideanDistances)
+  , m_BoundaryNoise(boundaryNoise)
+  , m_BoundaryVolFraction(boundaryVolFraction)
+  , m_PoissonNoise(poissonNoise)
+  , m_PoissonVolFraction(poissonVolFraction)
+  , m_BadData(badData)
+  {
+  }
+  virtual ~MarkBadDataImpl() = default;
+
+  void mark(size_t start, size_t end) const
+  {
+    float random = 0.0f;
+    for(size_t i = start; i < end; i++)
+    {
+      uint8_t bad = 0;
+      if(m_BoundaryNoise && m_GBEuclideanDistances[i] < 1)
+      {
+        random = static_cast<float>(m_Random.uniform(i, k_BoundaryNoiseStream));
+        if(random < m_BoundaryVolFraction)
+        {
+          bad = 1;
+        }
+      }
+      if(m_PoissonNoise)
+      {
+        random = static_cast<float>(m_Random.uniform(i, k_PoissonNoiseStream));
+        if(random < m_PoissonVolFraction)
+        {
+          bad = 1;
+        }
+      }
+      m_BadData[i] = bad;
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    mark(range.min(), range.max());
+  }
+
+private:
+  const CounterRandom& m_Random;
+  const int32_t* m_GBEuclideanDistances = nullptr;
+  bool m_BoundaryNoise = false;
+  float m_BoundaryVolFraction = 0.0f;
+  bool m_PoissonNoise = false;
+  float m_PoissonVolFraction = 0.0f;
+  std::vector<uint8_t>& m_BadData;
+};
+
+/**
+ * @brief The ResetBadDataImpl class implements a threaded algorithm that sets every component of the "bad" cells
+ * of one typed array to 0
+ */
+template <typename T>
+class ResetBadDataImpl
+{
+public:
+  ResetBadDataImpl(T* data, size_t numComps, const std::vector<uint8_t>& badData)
+  : m_Data(data)
+  , m_NumComps(numComps)
+  , m_BadData(badData)
+  {
+  }
+  virtual ~ResetBadDataImpl() = default;
+
+  void reset(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(m_BadData[i] != 0)
+      {
+        std::fill(m_Data + i * m_NumComps, m_Data + (i + 1) * m_NumComps, static_cast<T>(0));
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    reset(range.min(), range.max());
+  }
+
+private:
+  T* m_Data = nullptr;
+  size_t m_NumComps = 0;
+  const std::vector<uint8_t>& m_BadData;
+};
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool resetBadData(const IDataArray::Pointer& p, const std::vector<uint8_t>& badData)
+{
+  typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T>>(p);
+  if(nullptr == array)
+  {
+    return false;
+  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, badData.size());
+  dataAlg.execute(ResetBadDataImpl<T>(array->getPointer(0), array->getNumberOfComponents(), badData));
+  return true;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -73,6 +201,10 @@ void AddBadData::setupFilterParameters()
   linkedProps.push_back("BoundaryVolFraction");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Add Boundary Noise", BoundaryNoise, FilterParameter::Category::Parameter, AddBadData, linkedProps));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Volume Fraction of Boundary Noise", BoundaryVolFraction, FilterParameter::Category::Parameter, AddBadData));
+  linkedProps.clear();
+  linkedProps.push_back("SeedValue");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Fixed Random Seed", UseSeed, FilterParameter::Category::Parameter, AddBadData, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Random Seed", SeedValue, FilterParameter::Category::Parameter, AddBadData));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -92,6 +224,8 @@ void AddBadData::readFilterParameters(AbstractFilterParametersReader* reader, in
   setPoissonVolFraction(reader->readValue("PoissonVolFraction", getPoissonVolFraction()));
   setBoundaryNoise(reader->readValue("BoundaryNoise", getBoundaryNoise()));
   setBoundaryVolFraction(reader->readValue("BoundaryVolFraction", getBoundaryVolFraction()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
   reader->closeFilterGroup();
 }
 
@@ -146,41 +280,39 @@ void AddBadData::execute()
 void AddBadData::add_noise()
 {
   notifyStatusMessage("Adding Noise");
-  SIMPL_RANDOMNG_NEW()
+  uint64_t seed = m_UseSeed ? static_cast<uint64_t>(m_SeedValue) : static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+  CounterRandom random(seed);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getGBEuclideanDistancesArrayPath().getDataContainerName());
 
   QString attMatName = getGBEuclideanDistancesArrayPath().getAttributeMatrixName();
   QList<QString> voxelArrayNames = m->getAttributeMatrix(attMatName)->getAttributeArrayNames();
 
-  float random = 0.0f;
   size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  for(size_t i = 0; i < totalPoints; ++i)
+  std::vector<uint8_t> badData(totalPoints, 0);
   {
-    if(m_BoundaryNoise && m_GBEuclideanDistances[i] < 1)
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, totalPoints);
+    dataAlg.execute(MarkBadDataImpl(random, m_GBEuclideanDistances, m_BoundaryNoise, m_BoundaryVolFraction, m_PoissonNoise, m_PoissonVolFraction, badData));
+  }
+
+  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  {
+    IDataArray::Pointer p = m->getAttributeMatrix(attMatName)->getAttributeArray(*iter);
+    bool reset = resetBadData<int8_t>(p, badData) || resetBadData<uint8_t>(p, badData) || resetBadData<int16_t>(p, badData) || resetBadData<uint16_t>(p, badData) ||
+                 resetBadData<int32_t>(p, badData) || resetBadData<uint32_t>(p, badData) || resetBadData<int64_t>(p, badData) || resetBadData<uint64_t>(p, badData) ||
+                 resetBadData<float>(p, badData) || resetBadData<double>(p, badData) || resetBadData<bool>(p, badData);
+    if(reset)
     {
-      random = static_cast<float>(rg.genrand_res53());
-      if(random < m_BoundaryVolFraction)
-      {
-        for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attMatName)->getAttributeArray(*iter);
-          int var = 0;
-          p->initializeTuple(i, &var);
-        }
-      }
+      continue;
     }
-    if(m_PoissonNoise)
+    // Arrays that are not plain numeric arrays are reset one tuple at a time
+    int var = 0;
+    for(size_t i = 0; i < totalPoints; ++i)
     {
-      random = static_cast<float>(rg.genrand_res53());
-      if(random < m_PoissonVolFraction)
+      if(badData[i] != 0)
       {
-        for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attMatName)->getAttributeArray(*iter);
-          int var = 0;
-          p->initializeTuple(i, &var);
-        }
+        p->initializeTuple(i, &var);
       }
     }
   }
@@ -345,3 +477,27 @@ float AddBadData::getBoundaryVolFraction() const
 {
   return m_BoundaryVolFraction;
 }
+
+// -----------------------------------------------------------------------------
+void AddBadData::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool AddBadData::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void AddBadData::setSeedValue(int value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+int AddBadData::getSeedValue() const
+{
+  return m_SeedValue;
+}
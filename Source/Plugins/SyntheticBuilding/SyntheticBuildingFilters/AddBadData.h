@@ -60,6 +60,8 @@ class SyntheticBuilding_EXPORT AddBadData : public AbstractFilter
   PYB11_PROPERTY(float PoissonVolFraction READ getPoissonVolFraction WRITE setPoissonVolFraction)
   PYB11_PROPERTY(bool BoundaryNoise READ getBoundaryNoise WRITE setBoundaryNoise)
   PYB11_PROPERTY(float BoundaryVolFraction READ getBoundaryVolFraction WRITE setBoundaryVolFraction)
+  PYB11_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+  PYB11_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -148,6 +150,28 @@ public:
   float getBoundaryVolFraction() const;
   Q_PROPERTY(float BoundaryVolFraction READ getBoundaryVolFraction WRITE setBoundaryVolFraction)
 
+  /**
+   * @brief Setter property for UseSeed
+   */
+  void setUseSeed(bool value);
+  /**
+   * @brief Getter property for UseSeed
+   * @return Value of UseSeed
+   */
+  bool getUseSeed() const;
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  /**
+   * @brief Setter property for SeedValue
+   */
+  void setSeedValue(int value);
+  /**
+   * @brief Getter property for SeedValue
+   * @return Value of SeedValue
+   */
+  int getSeedValue() const;
+  Q_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -235,6 +259,8 @@ private:
   float m_PoissonVolFraction = {0.0f};
   bool m_BoundaryNoise = {false};
   float m_BoundaryVolFraction = {0.0f};
+  bool m_UseSeed = {false};
+  int m_SeedValue = {0};
 
 public:
   AddBadData(const AddBadData&) = delete;            // Copy Constructor Not Implemented
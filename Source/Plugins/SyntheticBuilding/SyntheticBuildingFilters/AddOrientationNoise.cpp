@@ -35,27 +35,121 @@
 
 #include "AddOrientationNoise.h"
 
+#include <array>
+#include <cmath>
+
+#include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
-#include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/CounterRandom.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
+namespace
+{
+// First stream of the counter based generator; every attempt at a cell uses the next two streams
+constexpr uint64_t k_OrientationNoiseStream = 2ULL << 32;
+
+/**
+ * @brief The AddOrientationNoiseImpl class implements a threaded algorithm that rotates the orientation of each
+ * cell by a random axis-angle pair. The random numbers of a cell only depend on the seed and the cell index.
+ */
+class AddOrientationNoiseImpl
+{
+public:
+  AddOrientationNoiseImpl(const CounterRandom& random, float magnitude, float* cellEulerAngles)
+  : m_Random(random)
+  , m_Magnitude(magnitude)
+  , m_CellEulerAngles(cellEulerAngles)
+  {
+  }
+  virtual ~AddOrientationNoiseImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float newg[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float rot[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float w = 0.0f;
+    float nx = 0.0f;
+    float ny = 0.0f;
+    float nz = 0.0f;
+    for(size_t i = start; i < end; i++)
+    {
+      OrientationTransformation::eu2om<OrientationF, OrientationF>(OrientationF(m_CellEulerAngles + 3 * i, 3)).toGMatrix(g);
+      // Each attempt draws from its own two streams, so a rejected axis-angle pair is replaced by a new one
+      for(uint64_t attempt = 0;; attempt++)
+      {
+        std::array<double, 2> first = m_Random.uniformPair(i, k_OrientationNoiseStream + 2 * attempt);
+        std::array<double, 2> second = m_Random.uniformPair(i, k_OrientationNoiseStream + 2 * attempt + 1);
+        nx = static_cast<float>(first[0]);
+        ny = static_cast<float>(first[1]);
+        nz = static_cast<float>(second[0]);
+
+        // Make sure the Axis Angle is of Unit norm for the vector portion.
+        float sqrOfSumSqr = std::sqrt(nx * nx + ny * ny + nz * nz);
+        nx /= sqrOfSumSqr;
+        ny /= sqrOfSumSqr;
+        nz /= sqrOfSumSqr;
+
+        w = static_cast<float>(second[1]) * m_Magnitude;
+        // Make sure w is within the range of [0, Pi)
+        while(w < 0.0F && w > SIMPLib::Constants::k_PiF)
+        {
+          if(w < 0.0F)
+          {
+            w += SIMPLib::Constants::k_PiF;
+          }
+          if(w >= SIMPLib::Constants::k_PiF)
+          {
+            w -= SIMPLib::Constants::k_PiF;
+          }
+        }
+        OrientationF ax(nx, ny, nz, w);
+        OrientationTransformation::ResultType result = OrientationTransformation::ax_check(ax);
+        if(result.result >= 0)
+        {
+          OrientationTransformation::ax2om<OrientationF, OrientationF>(ax).toGMatrix(rot);
+          MatrixMath::Multiply3x3with3x3(g, rot, newg);
+          OrientationF eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(newg));
+          eu.copyInto(m_CellEulerAngles + 3 * i, 3);
+          break;
+        }
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const CounterRandom& m_Random;
+  float m_Magnitude = 0.0f;
+  float* m_CellEulerAngles = nullptr;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -72,6 +166,9 @@ void AddOrientationNoise::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Magnitude of Orientation Noise (Degrees)", Magnitude, FilterParameter::Category::Parameter, AddOrientationNoise));
+  std::vector<QString> linkedProps = {"SeedValue"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Fixed Random Seed", UseSeed, FilterParameter::Category::Parameter, AddOrientationNoise, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Random Seed", SeedValue, FilterParameter::Category::Parameter, AddOrientationNoise));
   parameters.push_back(SeparatorFilterParameter::Create("Element Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Float, 3, AttributeMatrix::Category::Element);
@@ -87,6 +184,8 @@ void AddOrientationNoise::readFilterParameters(AbstractFilterParametersReader* r
   reader->openFilterGroup(this, index);
   setCellEulerAnglesArrayPath(reader->readDataArrayPath("CellEulerAnglesArrayPath", getCellEulerAnglesArrayPath()));
   setMagnitude(reader->readValue("Magnitude", getMagnitude()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
   reader->closeFilterGroup();
 }
 
@@ -137,59 +236,16 @@ void AddOrientationNoise::execute()
 void AddOrientationNoise::add_orientation_noise()
 {
   notifyStatusMessage("Adding Orientation Noise");
-  SIMPL_RANDOMNG_NEW()
+  uint64_t seed = m_UseSeed ? static_cast<uint64_t>(m_SeedValue) : static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+  CounterRandom random(seed);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getCellEulerAnglesArrayPath().getDataContainerName());
   float magnitude = m_Magnitude * SIMPLib::Constants::k_PiD / 180.0f;
 
-  float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  float newg[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  float rot[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  float w = 0.0f;
-  float nx = 0.0f;
-  float ny = 0.0f;
-  float nz = 0.0f;
   size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  for(size_t i = 0; i < totalPoints; ++i)
-  {
-    OrientationTransformation::eu2om<OrientationF, OrientationF>(OrientationF(m_CellEulerAngles + 3 * i, 3)).toGMatrix(g);
-    nx = static_cast<float>(rg.genrand_res53());
-    ny = static_cast<float>(rg.genrand_res53());
-    nz = static_cast<float>(rg.genrand_res53());
-
-    // Make sure the Axis Angle is of Unit norm for the vector portion.
-    float sqrOfSumSqr = std::sqrt(nx * nx + ny * ny + nz * nz);
-    nx /= sqrOfSumSqr;
-    ny /= sqrOfSumSqr;
-    nz /= sqrOfSumSqr;
-
-    w = static_cast<float>(rg.genrand_res53()) * magnitude;
-    // Make sure w is within the range of [0, Pi)
-    while(w < 0.0F && w > SIMPLib::Constants::k_PiF)
-    {
-      if(w < 0.0F)
-      {
-        w += SIMPLib::Constants::k_PiF;
-      }
-      if(w >= SIMPLib::Constants::k_PiF)
-      {
-        w -= SIMPLib::Constants::k_PiF;
-      }
-    }
-    OrientationF ax(nx, ny, nz, w);
-    OrientationTransformation::ResultType result = OrientationTransformation::ax_check(ax);
-    if(result.result < 0)
-    {
-      i--;
-    }
-    else
-    {
-      OrientationTransformation::ax2om<OrientationF, OrientationF>(ax).toGMatrix(rot);
-      MatrixMath::Multiply3x3with3x3(g, rot, newg);
-      OrientationF eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(newg));
-      eu.copyInto(m_CellEulerAngles + 3 * i, 3);
-    }
-  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalPoints);
+  dataAlg.execute(AddOrientationNoiseImpl(random, magnitude, m_CellEulerAngles));
 }
 
 // -----------------------------------------------------------------------------
@@ -315,3 +371,27 @@ DataArrayPath AddOrientationNoise::getCellEulerAnglesArrayPath() const
 {
   return m_CellEulerAnglesArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void AddOrientationNoise::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool AddOrientationNoise::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void AddOrientationNoise::setSeedValue(int value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+int AddOrientationNoise::getSeedValue() const
+{
+  return m_SeedValue;
+}
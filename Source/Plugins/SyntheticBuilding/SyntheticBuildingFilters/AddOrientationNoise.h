@@ -57,6 +57,8 @@ class SyntheticBuilding_EXPORT AddOrientationNoise : public AbstractFilter
   PYB11_FILTER_NEW_MACRO(AddOrientationNoise)
   PYB11_PROPERTY(float Magnitude READ getMagnitude WRITE setMagnitude)
   PYB11_PROPERTY(DataArrayPath CellEulerAnglesArrayPath READ getCellEulerAnglesArrayPath WRITE setCellEulerAnglesArrayPath)
+  PYB11_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+  PYB11_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -112,6 +114,28 @@ public:
   DataArrayPath getCellEulerAnglesArrayPath() const;
   Q_PROPERTY(DataArrayPath CellEulerAnglesArrayPath READ getCellEulerAnglesArrayPath WRITE setCellEulerAnglesArrayPath)
 
+  /**
+   * @brief Setter property for UseSeed
+   */
+  void setUseSeed(bool value);
+  /**
+   * @brief Getter property for UseSeed
+   * @return Value of UseSeed
+   */
+  bool getUseSeed() const;
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  /**
+   * @brief Setter property for SeedValue
+   */
+  void setSeedValue(int value);
+  /**
+   * @brief Getter property for SeedValue
+   * @return Value of SeedValue
+   */
+  int getSeedValue() const;
+  Q_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -195,6 +219,8 @@ private:
   float* m_CellEulerAngles = nullptr;
 
   float m_Magnitude = {1.0f};
+  bool m_UseSeed = {false};
+  int m_SeedValue = {0};
   DataArrayPath m_CellEulerAnglesArrayPath = {"", "", ""};
 
 public:
@@ -34,27 +34,35 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "EstablishMatrixPhase.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
-#include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/StatsData/BoundaryStatsData.h"
 #include "SIMPLib/StatsData/MatrixStatsData.h"
 #include "SIMPLib/StatsData/PrecipitateStatsData.h"
 #include "SIMPLib/StatsData/PrimaryStatsData.h"
 #include "SIMPLib/StatsData/TransformationStatsData.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/CounterRandom.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -67,6 +75,89 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+namespace
+{
+// Stream of the counter based generator used for the matrix phase draw of a cell
+constexpr uint64_t k_MatrixPhaseStream = 3ULL << 32;
+
+/**
+ * @brief The EstablishMatrixPhaseImpl class implements a threaded algorithm that assigns the unassigned cells to a
+ * randomly chosen matrix phase. The random number of a cell only depends on the seed and the cell index. The
+ * first cell of every matrix phase is recorded so the matrix Features can be created in the order a serial
+ * pass over the cells would have created them.
+ */
+class EstablishMatrixPhaseImpl
+{
+public:
+  EstablishMatrixPhaseImpl(const CounterRandom& random, bool useMask, const bool* mask, int32_t* featureIds, int32_t* cellPhases, size_t firstMatrixFeature, const std::vector<int32_t>& matrixPhases,
+                           const std::vector<float>& matrixPhaseFractions, std::vector<std::atomic<size_t>>& firstCell)
+  : m_Random(random)
+  , m_UseMask(useMask)
+  , m_Mask(mask)
+  , m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_FirstMatrixFeature(firstMatrixFeature)
+  , m_MatrixPhases(matrixPhases)
+  , m_MatrixPhaseFractions(matrixPhaseFractions)
+  , m_FirstCell(firstCell)
+  {
+  }
+  virtual ~EstablishMatrixPhaseImpl() = default;
+
+  void assign(size_t start, size_t end) const
+  {
+    size_t numMatrixPhases = m_MatrixPhases.size();
+    std::vector<size_t> firstCell(numMatrixPhases, std::numeric_limits<size_t>::max());
+    float random = 0.0f;
+    size_t j = 0;
+    for(size_t i = start; i < end; i++)
+    {
+      if(numMatrixPhases > 0 && ((!m_UseMask && m_FeatureIds[i] <= 0) || (m_UseMask && m_Mask[i] && m_FeatureIds[i] <= 0)))
+      {
+        random = static_cast<float>(m_Random.uniform(i, k_MatrixPhaseStream));
+        j = 0;
+        while(j + 1 < numMatrixPhases && random > m_MatrixPhaseFractions[j])
+        {
+          j++;
+        }
+        m_FeatureIds[i] = static_cast<int32_t>(m_FirstMatrixFeature + j);
+        m_CellPhases[i] = m_MatrixPhases[j];
+        firstCell[j] = std::min(firstCell[j], i);
+      }
+      else if(m_UseMask && !m_Mask[i])
+      {
+        m_FeatureIds[i] = 0;
+        m_CellPhases[i] = 0;
+      }
+    }
+
+    for(j = 0; j < numMatrixPhases; j++)
+    {
+      size_t current = m_FirstCell[j].load();
+      while(firstCell[j] < current && !m_FirstCell[j].compare_exchange_weak(current, firstCell[j]))
+      {
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    assign(range.min(), range.max());
+  }
+
+private:
+  const CounterRandom& m_Random;
+  bool m_UseMask = false;
+  const bool* m_Mask = nullptr;
+  int32_t* m_FeatureIds = nullptr;
+  int32_t* m_CellPhases = nullptr;
+  size_t m_FirstMatrixFeature = 0;
+  const std::vector<int32_t>& m_MatrixPhases;
+  const std::vector<float>& m_MatrixPhaseFractions;
+  std::vector<std::atomic<size_t>>& m_FirstCell;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -91,6 +182,9 @@ void EstablishMatrixPhase::setupFilterParameters()
   FilterParameterVectorType parameters;
   std::vector<QString> linkedProps = {"MaskArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Category::Parameter, EstablishMatrixPhase, linkedProps));
+  linkedProps = {"SeedValue"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Fixed Random Seed", UseSeed, FilterParameter::Category::Parameter, EstablishMatrixPhase, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Random Seed", SeedValue, FilterParameter::Category::Parameter, EstablishMatrixPhase));
 
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
@@ -165,6 +259,8 @@ void EstablishMatrixPhase::readFilterParameters(AbstractFilterParametersReader*
   setNumFeaturesArrayName(reader->readString("NumFeaturesArrayName", getNumFeaturesArrayName()));
   setInputStatsArrayPath(reader->readDataArrayPath("InputStatsArrayPath", getInputStatsArrayPath()));
   setInputPhaseTypesArrayPath(reader->readDataArrayPath("InputPhaseTypesArrayPath", getInputPhaseTypesArrayPath()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
   reader->closeFilterGroup();
 }
 
@@ -327,7 +423,8 @@ void EstablishMatrixPhase::execute()
 void EstablishMatrixPhase::establish_matrix()
 {
   notifyStatusMessage("Establishing Matrix");
-  SIMPL_RANDOMNG_NEW()
+  uint64_t seed = m_UseSeed ? static_cast<uint64_t>(m_SeedValue) : static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+  CounterRandom random(seed);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
 
@@ -359,7 +456,6 @@ void EstablishMatrixPhase::establish_matrix()
     currentnumfeatures = 1;
   }
   firstMatrixFeature = currentnumfeatures;
-  float random = 0.0f;
   float totalmatrixfractions = 0.0f;
 
   for(size_t i = 1; i < numensembles; ++i)
@@ -391,34 +487,41 @@ void EstablishMatrixPhase::establish_matrix()
       matrixphasefractions[i] = matrixphasefractions[i] + matrixphasefractions[i - 1];
     }
   }
-  size_t j = 0;
-  for(size_t i = 0; i < totalPoints; ++i)
+  std::vector<std::atomic<size_t>> firstCell(matrixphases.size());
+  for(std::atomic<size_t>& cell : firstCell)
+  {
+    cell.store(std::numeric_limits<size_t>::max());
+  }
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, totalPoints);
+    dataAlg.execute(EstablishMatrixPhaseImpl(random, m_UseMask, m_Mask, m_FeatureIds, m_CellPhases, firstMatrixFeature, matrixphases, matrixphasefractions, firstCell));
+  }
+
+  // Create the matrix Features in the order their first cells appear
+  std::vector<size_t> usedPhases;
+  for(size_t j = 0; j < matrixphases.size(); j++)
   {
-    if((!m_UseMask && m_FeatureIds[i] <= 0) || (m_UseMask && m_Mask[i] && m_FeatureIds[i] <= 0))
+    if(firstCell[j].load() != std::numeric_limits<size_t>::max())
     {
-      random = static_cast<float>(rg.genrand_res53());
-      j = 0;
-      while(random > matrixphasefractions[j])
-      {
-        j++;
-      }
-      if(m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples() <= (firstMatrixFeature + j))
-      {
-        tDims[0] = (firstMatrixFeature + j) + 1;
-        m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->resizeAttributeArrays(tDims);
-        updateFeatureInstancePointers();
-        m_NumFeatures[j] = 1;
-      }
-      m_FeatureIds[i] = (firstMatrixFeature + j);
-      m_CellPhases[i] = matrixphases[j];
-      m_FeaturePhases[(firstMatrixFeature + j)] = matrixphases[j];
+      usedPhases.push_back(j);
     }
-    else if(m_UseMask && !m_Mask[i])
+  }
+  std::sort(usedPhases.begin(), usedPhases.end(), [&firstCell](size_t a, size_t b) { return firstCell[a].load() < firstCell[b].load(); });
+  for(size_t j : usedPhases)
+  {
+    if(m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples() <= (firstMatrixFeature + j))
     {
-      m_FeatureIds[i] = 0;
-      m_CellPhases[i] = 0;
+      tDims[0] = (firstMatrixFeature + j) + 1;
+      m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->resizeAttributeArrays(tDims);
+      updateFeatureInstancePointers();
+      m_NumFeatures[j] = 1;
     }
   }
+  for(size_t j : usedPhases)
+  {
+    m_FeaturePhases[(firstMatrixFeature + j)] = matrixphases[j];
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -664,3 +767,27 @@ DataArrayPath EstablishMatrixPhase::getInputPhaseNamesArrayPath() const
 {
   return m_InputPhaseNamesArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void EstablishMatrixPhase::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool EstablishMatrixPhase::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void EstablishMatrixPhase::setSeedValue(int value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+int EstablishMatrixPhase::getSeedValue() const
+{
+  return m_SeedValue;
+}
@@ -34,8 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "InsertAtoms.h"
 
+#include <algorithm>
+
 #include "SIMPLib/Common/Constants.h"
-#include "SIMPLib/DataArrays/DynamicListArray.hpp"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -48,23 +50,16 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
-#include "SIMPLib/Math/GeometryMath.h"
-#include "SIMPLib/Math/MatrixMath.h"
-#include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/FeatureLatticeFill.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
-
 using QuatF = Quaternion<float>;
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -75,218 +70,104 @@ enum createdPathID : RenameDataPath::DataID_t
 };
 
 /**
- * @brief The InsertAtomsImpl class implements a threaded algorithm that inserts vertex points ('atoms') onto surface meshed Features
+ * @brief The InsertAtomsImpl class implements a threaded algorithm that inserts vertex points ('atoms') onto surface meshed Features.
+ * Each Feature writes only its own atom buffer.
  */
 class InsertAtomsImpl
 {
-  TriangleGeom::Pointer m_Faces;
-  Int32Int32DynamicListArray::Pointer m_FaceIds;
-  VertexGeom::Pointer m_FaceBBs;
-  float* m_AvgQuats;
+  const MeshIndexType* m_Triangles;
+  const float* m_Vertices;
+  const std::vector<size_t>& m_FaceOffsets;
+  const std::vector<int64_t>& m_FaceIds;
+  const float* m_AvgQuats;
   FloatVec3Type m_LatticeConstants;
   uint32_t m_Basis;
-  QVector<VertexGeom::Pointer> m_Points;
-  QVector<BoolArrayType::Pointer> m_InFeature;
+  std::vector<std::vector<float>>& m_FeatureAtoms;
+  AbstractFilter* m_Filter;
 
 public:
-  InsertAtomsImpl(const TriangleGeom::Pointer& faces, const Int32Int32DynamicListArray::Pointer& faceIds, const VertexGeom::Pointer& faceBBs, float* avgQuats, FloatVec3Type latticeConstants,
-                  uint32_t basis, const QVector<VertexGeom::Pointer>& points, const QVector<BoolArrayType::Pointer>& inFeature)
-  : m_Faces(faces)
+  InsertAtomsImpl(const MeshIndexType* triangles, const float* vertices, const std::vector<size_t>& faceOffsets, const std::vector<int64_t>& faceIds, const float* avgQuats,
+                  FloatVec3Type latticeConstants, uint32_t basis, std::vector<std::vector<float>>& featureAtoms, AbstractFilter* filter)
+  : m_Triangles(triangles)
+  , m_Vertices(vertices)
+  , m_FaceOffsets(faceOffsets)
   , m_FaceIds(faceIds)
-  , m_FaceBBs(faceBBs)
   , m_AvgQuats(avgQuats)
   , m_LatticeConstants(latticeConstants)
   , m_Basis(basis)
-  , m_Points(points)
-  , m_InFeature(inFeature)
+  , m_FeatureAtoms(featureAtoms)
+  , m_Filter(filter)
   {
   }
   virtual ~InsertAtomsImpl() = default;
 
   void checkPoints(size_t start, size_t end) const
   {
-    float radius = 0.0f;
-    FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, std::string("_INTERNAL_USE_ONLY_Lower_Left"), true);
-    FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, std::string("_INTERNAL_USE_ONLY_Upper_Right"), true);
-    FloatArrayType::Pointer ll_rotPtr = FloatArrayType::CreateArray(3, std::string("_INTERNAL_USE_ONLY_Lower_Left_Rotated"), true);
-    FloatArrayType::Pointer ur_rotPtr = FloatArrayType::CreateArray(3, std::string("_INTERNAL_USE_ONLY_Upper_Right_Rotated"), true);
-    float* ll = llPtr->getPointer(0);
-    float* ur = urPtr->getPointer(0);
-    float* ll_rot = ll_rotPtr->getPointer(0);
-    float* ur_rot = ur_rotPtr->getPointer(0);
-    float* point = nullptr;
-    char code = ' ';
-    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float latticeConstants[3] = {m_LatticeConstants[0], m_LatticeConstants[1], m_LatticeConstants[2]};
 
     for(size_t iter = start; iter < end; iter++)
     {
-      Int32Int32DynamicListArray::ElementList& faceIds = m_FaceIds->getElementList(iter);
+      if(m_Filter->getCancel())
       {
-        float* currentAvgQuatPtr = m_AvgQuats + iter * 4;
-        QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
-        OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g);
+        return;
       }
-      // find bounding box for current feature
-      GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), faceIds, ll, ur);
-      GeometryMath::FindBoundingBoxOfRotatedFaces(m_Faces.get(), faceIds, g, ll_rot, ur_rot);
-      GeometryMath::FindDistanceBetweenPoints(ll, ur, radius);
-
-      generatePoints(iter, m_Points, m_InFeature, m_AvgQuats, m_LatticeConstants, m_Basis, ll_rot, ur_rot);
-
-      // check points in vertex array to see if they are in the bounding box of the feature
-      int64_t numPoints = m_Points[iter]->getNumberOfVertices();
-      VertexGeom::Pointer vertArray = m_Points[iter];
-      BoolArrayType::Pointer boolArray = m_InFeature[iter];
-      for(int64_t i = 0; i < numPoints; i++)
+      size_t numFaces = m_FaceOffsets[iter + 1] - m_FaceOffsets[iter];
+      if(numFaces == 0)
       {
-        point = vertArray->getVertexPointer(i);
-        if(!boolArray->getValue(i))
-        {
-          code = GeometryMath::PointInPolyhedron(m_Faces.get(), faceIds, m_FaceBBs.get(), point, ll, ur, radius);
-          if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
-          {
-            m_InFeature[iter]->setValue(i, true);
-          }
-        }
+        continue;
+      }
+      {
+        const float* currentAvgQuatPtr = m_AvgQuats + iter * 4;
+        QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
+        OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g);
       }
+      FeatureLatticeFill::FillFeature(m_Triangles, m_Vertices, m_FaceIds.data() + m_FaceOffsets[iter], numFaces, g, latticeConstants, m_Basis, m_FeatureAtoms[iter]);
     }
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  void operator()(const SIMPLRange& range) const
+  {
+    checkPoints(range.min(), range.max());
+  }
+};
+
+/**
+ * @brief The AssignAtomsImpl class implements a threaded algorithm that copies the atoms of each Feature into the
+ * final vertex list, starting at the offset of that Feature
+ */
+class AssignAtomsImpl
+{
+  const std::vector<std::vector<float>>& m_FeatureAtoms;
+  const std::vector<size_t>& m_AtomOffsets;
+  float* m_Vertices;
+  int32_t* m_AtomFeatureLabels;
+
+public:
+  AssignAtomsImpl(const std::vector<std::vector<float>>& featureAtoms, const std::vector<size_t>& atomOffsets, float* vertices, int32_t* atomFeatureLabels)
+  : m_FeatureAtoms(featureAtoms)
+  , m_AtomOffsets(atomOffsets)
+  , m_Vertices(vertices)
+  , m_AtomFeatureLabels(atomFeatureLabels)
   {
-    checkPoints(r.begin(), r.end());
   }
-#endif
+  virtual ~AssignAtomsImpl() = default;
 
-  void generatePoints(size_t iter, QVector<VertexGeom::Pointer> points, QVector<BoolArrayType::Pointer> inFeature, float* m_AvgQuats, FloatVec3Type latticeConstants, uint32_t basis, const float* ll,
-                      const float* ur) const
+  void assign(size_t start, size_t end) const
   {
-    float gT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-    {
-      float* currentAvgQuatPtr = m_AvgQuats + iter * 4;
-      QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
-      float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-      OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g);
-      MatrixMath::Transpose3x3(g, gT);
-    }
-    float minx = ll[0];
-    float miny = ll[1];
-    float minz = ll[2];
-    float maxx = ur[0];
-    float maxy = ur[1];
-    float maxz = ur[2];
-    float deltaX = maxx - minx;
-    float deltaY = maxy - miny;
-    float deltaZ = maxz - minz;
-    int64_t atomMult = 1;
-    if(basis == 0)
-    {
-      atomMult = 1;
-    }
-    if(basis == 1)
+    for(size_t i = start; i < end; i++)
     {
-      atomMult = 2;
-    }
-    if(basis == 2)
-    {
-      atomMult = 4;
-    }
-    if(basis == 3)
-    {
-      atomMult = 8;
-    }
-    int64_t xPoints = (int64_t(deltaX / latticeConstants[0]) + 1);
-    int64_t yPoints = (int64_t(deltaY / latticeConstants[1]) + 1);
-    int64_t zPoints = (int64_t(deltaZ / latticeConstants[2]) + 1);
-    int64_t nPoints = atomMult * xPoints * yPoints * zPoints;
-
-    points[iter]->resizeVertexList(nPoints);
-    inFeature[iter]->resizeTuples(nPoints);
-
-    int64_t count = 0;
-    float coords[3] = {0.0f, 0.0f, 0.0f};
-    float coordsT[3] = {0.0f, 0.0f, 0.0f};
-    for(int64_t k = 0; k < zPoints; k++)
-    {
-      for(int64_t j = 0; j < yPoints; j++)
-      {
-        for(int64_t i = 0; i < xPoints; i++)
-        {
-          coords[0] = float(i) * latticeConstants[0] + minx;
-          coords[1] = float(j) * latticeConstants[1] + miny;
-          coords[2] = float(k) * latticeConstants[2] + minz;
-          MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-          points[iter]->setCoords(count, coordsT);
-          count++;
-          if(basis == 1)
-          {
-            coords[0] = coords[0] + (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2] + (0.5f * latticeConstants[2]);
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-          }
-          if(basis == 2)
-          {
-            // makes the (0.5,0.5,0) atom
-            coords[0] = coords[0] + (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2];
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // makes the (0.5,0,0.5) atom
-            coords[0] = coords[0];
-            coords[1] = coords[1] - (0.5f * latticeConstants[1]);
-            coords[2] = coords[2] + (0.5f * latticeConstants[2]);
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // makes the (0,0.5,0.5) atom
-            coords[0] = coords[0] - (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2];
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-          }
-          if(basis == 3)
-          {
-            // (+0.25,+0.25,+0.25) for (0,0,0)
-            coords[0] = coords[0] + (0.25f * latticeConstants[0]);
-            coords[1] = coords[1] - (0.25f * latticeConstants[1]);
-            coords[2] = coords[2] - (0.25f * latticeConstants[2]);
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // (+0.25,+0.25,+0.25) for (0.5,0.5,0)
-            coords[0] = coords[0] + (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2];
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // (+0.25,+0.25,+0.25) for (0.5,0,0.5)
-            coords[0] = coords[0];
-            coords[1] = coords[1] - (0.5f * latticeConstants[1]);
-            coords[2] = coords[2] + (0.5f * latticeConstants[2]);
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // (+0.25,+0.25,+0.25) for (0,0.5,0.5)
-            coords[0] = coords[0] - (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2];
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-          }
-        }
-      }
+      const std::vector<float>& atoms = m_FeatureAtoms[i];
+      size_t offset = m_AtomOffsets[i];
+      std::copy(atoms.begin(), atoms.end(), m_Vertices + 3 * offset);
+      std::fill(m_AtomFeatureLabels + offset, m_AtomFeatureLabels + m_AtomOffsets[i + 1], static_cast<int32_t>(i));
     }
   }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    assign(range.min(), range.max());
+  }
 };
 
 // -----------------------------------------------------------------------------
@@ -454,22 +335,15 @@ void InsertAtoms::dataCheck()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertAtoms::assign_points(QVector<VertexGeom::Pointer> points, QVector<BoolArrayType::Pointer> inFeature)
+void InsertAtoms::assign_points(const std::vector<std::vector<float>>& featureAtoms)
 {
-  size_t count = 0;
-  int32_t numFeatures = points.size();
-  for(int32_t i = 0; i < numFeatures; i++)
+  size_t numFeatures = featureAtoms.size();
+  std::vector<size_t> atomOffsets(numFeatures + 1, 0);
+  for(size_t i = 0; i < numFeatures; i++)
   {
-    int64_t numPoints = points[i]->getNumberOfVertices();
-    bool* inside = inFeature[i]->getPointer(0);
-    for(int64_t j = 0; j < numPoints; j++)
-    {
-      if(inside[j])
-      {
-        count++;
-      }
-    }
+    atomOffsets[i + 1] = atomOffsets[i] + featureAtoms[i].size() / 3;
   }
+  size_t count = atomOffsets[numFeatures];
 
   DataContainer::Pointer v = getDataContainerArray()->getDataContainer(getVertexDataContainerName());
 
@@ -480,24 +354,11 @@ void InsertAtoms::assign_points(QVector<VertexGeom::Pointer> points, QVector<Boo
   vertexAttrMat->resizeAttributeArrays(tDims);
   updateVertexInstancePointers();
 
-  count = 0;
-  float coords[3] = {0.0f, 0.0f, 0.0f};
-  for(int32_t i = 0; i < numFeatures; i++)
+  if(count > 0)
   {
-    int64_t numPoints = points[i]->getNumberOfVertices();
-    bool* inside = inFeature[i]->getPointer(0);
-    for(int64_t j = 0; j < numPoints; j++)
-    {
-      if(inside[j])
-      {
-        coords[0] = points[i]->getVertexPointer(j)[0];
-        coords[1] = points[i]->getVertexPointer(j)[1];
-        coords[2] = points[i]->getVertexPointer(j)[2];
-        vertices->setCoords(count, coords);
-        m_AtomFeatureLabels[count] = i;
-        count++;
-      }
-    }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numFeatures);
+    dataAlg.execute(AssignAtomsImpl(featureAtoms, atomOffsets, vertices->getVertexPointer(0), m_AtomFeatureLabels));
   }
   v->setGeometry(vertices);
 }
@@ -563,19 +424,11 @@ void InsertAtoms::execute()
   latticeConstants[2] = m_LatticeConstants[2] / 10000.0f;
 
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-  SIMPL_RANDOMNG_NEW()
 
   // pull down faces
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t numFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-  // create array to hold bounding vertices for each face
-  FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, std::string("Lower_Left_Internal_Use_Only"), true);
-  FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, std::string("Upper_Right_Internal_Use_Only"), true);
-  float* ll = llPtr->getPointer(0);
-  float* ur = urPtr->getPointer(0);
-  VertexGeom::Pointer faceBBs = VertexGeom::CreateGeometry(2 * numFaces, "faceBBs");
-
   // walk through faces to see how many features there are
   int32_t g1 = 0, g2 = 0;
   int32_t maxFeatureId = 0;
@@ -596,74 +449,55 @@ void InsertAtoms::execute()
   // add one to account for feature 0
   int32_t numFeatures = maxFeatureId + 1;
 
-  // create a dynamic list array to hold face lists
-  Int32Int32DynamicListArray::Pointer faceLists = Int32Int32DynamicListArray::New();
-  QVector<int32_t> linkCount(numFeatures, 0);
-
-  // fill out lists with number of references to cells
-  Int32ArrayType::Pointer linkLocPtr = Int32ArrayType::CreateArray(numFaces, std::string("_INTERNAL_USE_ONLY_cell refs"), true);
-  linkLocPtr->initializeWithZeros();
-  int32_t* linkLoc = linkLocPtr->getPointer(0);
-
   // traverse data to determine number of faces belonging to each feature
+  std::vector<size_t> faceOffsets(numFeatures + 1, 0);
   for(int64_t i = 0; i < numFaces; i++)
   {
     g1 = m_SurfaceMeshFaceLabels[2 * i];
     g2 = m_SurfaceMeshFaceLabels[2 * i + 1];
     if(g1 > 0)
     {
-      linkCount[g1]++;
+      faceOffsets[g1 + 1]++;
     }
     if(g2 > 0)
     {
-      linkCount[g2]++;
+      faceOffsets[g2 + 1]++;
     }
   }
-
-  // now allocate storage for the faces
-  faceLists->allocateLists(linkCount);
+  for(int32_t i = 0; i < numFeatures; i++)
+  {
+    faceOffsets[i + 1] += faceOffsets[i];
+  }
 
   // traverse data again to get the faces belonging to each feature
+  std::vector<int64_t> faceIds(faceOffsets[numFeatures]);
+  std::vector<size_t> linkLoc(faceOffsets.begin(), faceOffsets.end() - 1);
   for(int64_t i = 0; i < numFaces; i++)
   {
     g1 = m_SurfaceMeshFaceLabels[2 * i];
     g2 = m_SurfaceMeshFaceLabels[2 * i + 1];
     if(g1 > 0)
     {
-      faceLists->insertCellReference(g1, (linkLoc[g1])++, i);
+      faceIds[linkLoc[g1]++] = i;
     }
     if(g2 > 0)
     {
-      faceLists->insertCellReference(g2, (linkLoc[g2])++, i);
+      faceIds[linkLoc[g2]++] = i;
     }
-    // find bounding box for each face
-    GeometryMath::FindBoundingBoxOfFace(triangleGeom.get(), i, ll, ur);
-    faceBBs->setCoords(2 * i, ll);
-    faceBBs->setCoords(2 * i + 1, ur);
   }
 
-  // generate the list of sampling points fom subclass
-  QVector<VertexGeom::Pointer> points(numFeatures);
-  QVector<BoolArrayType::Pointer> inFeature(numFeatures);
-  for(int32_t i = 0; i < numFeatures; i++)
-  {
-    points[i] = VertexGeom::CreateGeometry(0, "_INTERNAL_USE_ONLY_points");
-    inFeature[i] = BoolArrayType::CreateArray(0, std::string("_INTERNAL_USE_ONLY_inside"), true);
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(true)
+  // every feature fills its own list of atoms, so the result does not depend on the number of threads
+  std::vector<std::vector<float>> featureAtoms(numFeatures);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numFeatures);
+  dataAlg.execute(
+      InsertAtomsImpl(triangleGeom->getTriangles()->getPointer(0), triangleGeom->getVertexPointer(0), faceOffsets, faceIds, m_AvgQuats, latticeConstants, m_Basis, featureAtoms, this));
+  if(getCancel())
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), InsertAtomsImpl(triangleGeom, faceLists, faceBBs, m_AvgQuats, latticeConstants, m_Basis, points, inFeature), tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    InsertAtomsImpl serial(triangleGeom, faceLists, faceBBs, m_AvgQuats, latticeConstants, m_Basis, points, inFeature);
-    serial.checkPoints(0, numFeatures);
+    return;
   }
 
-  assign_points(points, inFeature);
+  assign_points(featureAtoms);
 }
 
 // -----------------------------------------------------------------------------
@@ -36,6 +36,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -248,10 +249,9 @@ protected:
 
   /**
    * @brief assign_points Assigns Feature Ids to the generated 'atoms'
-   * @param points VertexGeom object of 'atom' points
-   * @param inFeature Boolean array to determine inside/outside relationships for points
+   * @param featureAtoms Coordinates of the 'atoms' inside each Feature, 3 per 'atom'
    */
-  virtual void assign_points(QVector<VertexGeom::Pointer> points, QVector<BoolArrayType::Pointer> inFeature);
+  virtual void assign_points(const std::vector<std::vector<float>>& featureAtoms);
 
   /**
    * @brief updateVertexInstancePointers updates raw Vertex pointers
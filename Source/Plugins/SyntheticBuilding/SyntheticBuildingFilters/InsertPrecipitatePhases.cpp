@@ -37,6 +37,7 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "InsertPrecipitatePhases.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <random>
@@ -44,6 +45,7 @@
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
 
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -61,6 +63,7 @@
 #include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/StatsData/PrecipitateStatsData.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "EbsdLib/Core/Orientation.hpp"
@@ -72,7 +75,53 @@
 namespace
 {
 OrthoRhombicOps::Pointer m_OrthoOps;
-}
+
+// Number of candidate moves that are evaluated together when the candidate moves are evaluated in parallel
+constexpr size_t k_CandidateMoveBatchSize = 16;
+
+struct CandidateMove
+{
+  int32_t feature;
+  float position[3];
+};
+} // namespace
+
+/**
+ * @brief The EvaluateCandidateMovesImpl class implements a threaded algorithm that computes the radial
+ * distribution function error each candidate move would lead to without moving any precipitate
+ */
+class EvaluateCandidateMovesImpl
+{
+public:
+  EvaluateCandidateMovesImpl(const RadialDistributionTracker& tracker, const std::vector<CandidateMove>& candidates, bool doubleCount, std::vector<float>& errors)
+  : m_Tracker(tracker)
+  , m_Candidates(candidates)
+  , m_DoubleCount(doubleCount)
+  , m_Errors(errors)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      m_Errors[i] = m_Tracker.evaluateMove(m_Candidates[i].feature, m_Candidates[i].position, m_DoubleCount);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const RadialDistributionTracker& m_Tracker;
+  const std::vector<CandidateMove>& m_Candidates;
+  bool m_DoubleCount = true;
+  std::vector<float>& m_Errors;
+};
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -114,6 +163,7 @@ void InsertPrecipitatePhases::setupFilterParameters()
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Periodic Boundaries", PeriodicBoundaries, FilterParameter::Category::Parameter, InsertPrecipitatePhases));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Match Radial Distribution Function", MatchRDF, FilterParameter::Category::Parameter, InsertPrecipitatePhases));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Evaluate Candidate Moves in Parallel", ParallelCandidateMoves, FilterParameter::Category::Parameter, InsertPrecipitatePhases));
   std::vector<QString> linkedProps = {"MaskArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Category::Parameter, InsertPrecipitatePhases, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -248,6 +298,7 @@ void InsertPrecipitatePhases::readFilterParameters(AbstractFilterParametersReade
   setMaskArrayPath(reader->readDataArrayPath("MaskArrayPath", getMaskArrayPath()));
   setPeriodicBoundaries(reader->readValue("PeriodicBoundaries", getPeriodicBoundaries()));
   setMatchRDF(reader->readValue("MatchRDF", getMatchRDF()));
+  setParallelCandidateMoves(reader->readValue("ParallelCandidateMoves", getParallelCandidateMoves()));
   setUseMask(reader->readValue("UseMask", getUseMask()));
   bool haveFeatures = reader->readValue("HaveFeatures", false);
   if(haveFeatures)
@@ -332,8 +383,6 @@ void InsertPrecipitatePhases::initialize()
   m_FeatureSizeDist.clear();
   m_SimFeatureSizeDist.clear();
   m_RdfTargetDist.clear();
-  m_RdfCurrentDist.clear();
-  m_RdfCurrentDistNorm.clear();
   m_RandomCentroids.clear();
   m_RdfRandom.clear();
   m_FeatureSizeDistStep.clear();
@@ -802,7 +851,6 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   float precipboundaryfraction = 0.0f;
   float random = 0.0f;
   float xc = 0.0f, yc = 0.0f, zc = 0.0f;
-  float oldxc = 0.0f, oldyc = 0.0f, oldzc = 0.0f;
   int32_t randomfeature = 0;
   int32_t acceptedmoves = 0;
   double totalprecipitatefractions = 0.0;
@@ -977,11 +1025,6 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
         m_rdfMin = rdfTarget->getMinDistance();
 
         m_StepSize = (m_rdfMax - m_rdfMin) / float(m_numRDFbins);
-        float max_box_distance = sqrtf((m_SizeX * m_SizeX) + (m_SizeY * m_SizeY) + (m_SizeZ * m_SizeZ));
-
-        int32_t current_num_bins = static_cast<int32_t>(ceil((max_box_distance - m_rdfMin) / (m_StepSize)));
-
-        m_RdfCurrentDist.resize(current_num_bins + 1);
       }
     }
   }
@@ -1312,15 +1355,22 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
       }
       testFile.close();
     }
+
+    // Only the bins that exist in both the target and the current distribution are compared, so the
+    // tracker does not need to count any distance beyond them
+    size_t numComparedBins = std::min(m_RdfTargetDist.size(), static_cast<size_t>(current_num_bins + 1));
+    m_RdfTracker.initialize(m_RdfTargetDist, m_RdfRandom, m_rdfMin, m_StepSize, numComparedBins, boxdims, numfeatures);
+    m_RdfTracker.setFeatureData(m_Centroids, m_FeaturePhases);
   }
 
   if(m_MatchRDF)
   {
     // calculate the initial current RDF - this will change as we move particles
-    // around
+    // around. Each precipitate only sees the ones added before it, so every
+    // distance is counted twice when the second precipitate of the pair is added
     for(size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
     {
-      m_oldRDFerror = check_RDFerror(int32_t(i), -1000, false);
+      m_oldRDFerror = check_RDFerror(int32_t(i), -1000, true);
     }
 
     std::ofstream testFile;
@@ -1343,6 +1393,13 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
     uint64_t estimatedTime = 0;
     float timeDiff = 0.0f;
 
+    // Without the parallel evaluation each candidate move is decided on its own. With it, a batch
+    // of candidates is drawn and only the best of them is carried out if it improves the error.
+    size_t candidateBatchSize = m_ParallelCandidateMoves ? k_CandidateMoveBatchSize : 1;
+    std::vector<CandidateMove> candidates;
+    std::vector<float> candidateErrors;
+    candidates.reserve(candidateBatchSize);
+
     for(int32_t iteration = 0; iteration < totalAdjustments; ++iteration)
     {
       if(getCancel())
@@ -1465,31 +1522,41 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
       xc = static_cast<float>((column * m_XRes) + (m_XRes * 0.5));
       yc = static_cast<float>((row * m_YRes) + (m_YRes * 0.5));
       zc = static_cast<float>((plane * m_ZRes) + (m_ZRes * 0.5));
-      oldxc = m_Centroids[3 * randomfeature];
-      oldyc = m_Centroids[3 * randomfeature + 1];
-      oldzc = m_Centroids[3 * randomfeature + 2];
-      m_currentRDFerror = check_RDFerror(-1000, randomfeature, true);
-      update_exclusionZones(-1000, randomfeature, exclusionZonesPtr);
-      move_precipitate(randomfeature, xc, yc, zc);
-      m_currentRDFerror = check_RDFerror(randomfeature, -1000, true);
-      update_exclusionZones(randomfeature, -1000, exclusionZonesPtr);
-      if(m_currentRDFerror >= m_oldRDFerror)
+      CandidateMove candidate = {randomfeature, {xc, yc, zc}};
+      candidates.push_back(candidate);
+      if(candidates.size() < candidateBatchSize && iteration < totalAdjustments - 1)
       {
-        m_oldRDFerror = m_currentRDFerror;
-        update_availablepoints(availablePoints, availablePointsInv);
-        acceptedmoves++;
+        continue;
+      }
+
+      // The moves are evaluated without touching the precipitates, so a rejected
+      // move never has to be carried out and undone. They count the distances
+      // the same way as the check_RDFerror calls that carry out the move.
+      candidateErrors.resize(candidates.size());
+      if(candidates.size() > 1)
+      {
+        ParallelDataAlgorithm dataAlg;
+        dataAlg.setRange(0, candidates.size());
+        dataAlg.execute(EvaluateCandidateMovesImpl(m_RdfTracker, candidates, true, candidateErrors));
       }
       else
       {
-        m_currentRDFerror = check_RDFerror(-1000, randomfeature, true);
-        update_exclusionZones(-1000, randomfeature, exclusionZonesPtr);
-        move_precipitate(randomfeature, oldxc, oldyc, oldzc);
-        m_currentRDFerror = check_RDFerror(randomfeature, -1000, true);
-        update_exclusionZones(randomfeature, -1000, exclusionZonesPtr);
-        m_oldRDFerror = m_currentRDFerror;
-        m_PointsToRemove.clear();
-        m_PointsToAdd.clear();
+        candidateErrors[0] = m_RdfTracker.evaluateMove(candidate.feature, candidate.position, true);
+      }
+      size_t best = static_cast<size_t>(std::max_element(candidateErrors.begin(), candidateErrors.end()) - candidateErrors.begin());
+      m_currentRDFerror = candidateErrors[best];
+      if(m_currentRDFerror >= m_oldRDFerror)
+      {
+        const CandidateMove& move = candidates[best];
+        check_RDFerror(-1000, move.feature, true);
+        update_exclusionZones(-1000, move.feature, exclusionZonesPtr);
+        move_precipitate(move.feature, move.position[0], move.position[1], move.position[2]);
+        m_oldRDFerror = check_RDFerror(move.feature, -1000, true);
+        update_exclusionZones(move.feature, -1000, exclusionZonesPtr);
+        update_availablepoints(availablePoints, availablePointsInv);
+        acceptedmoves++;
       }
+      candidates.clear();
 
       if(write_test_outputs && iteration % 100 == 0)
       {
@@ -1506,9 +1573,10 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   {
     std::ofstream testFile3;
     testFile3.open(getNameOfClass().toStdString() + "_current.txt");
-    for(size_t i = 0; i < m_RdfCurrentDistNorm.size(); i++)
+    const std::vector<float>& rdfCurrentDistNorm = m_RdfTracker.getNormalizedDistribution();
+    for(size_t i = 0; i < rdfCurrentDistNorm.size(); i++)
     {
-      testFile3 << "\n" << m_RdfCurrentDistNorm[i];
+      testFile3 << "\n" << rdfCurrentDistNorm[i];
     }
     testFile3.close();
 
@@ -1925,161 +1993,21 @@ void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& a
   m_PointsToAdd.clear();
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::determine_currentRDF(int32_t gnum, int32_t add, bool double_count)
-{
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  float xn = 0.0f, yn = 0.0f, zn = 0.0f;
-  float r = 0.0f;
-
-  size_t iter = 0;
-  int32_t numPPTfeatures = 1;
-  int32_t rdfBin = 0;
-
-  int32_t phase = m_FeaturePhases[gnum];
-  while(phase != m_PrecipitatePhases[iter])
-  {
-    iter++;
-  }
-
-  x = m_Centroids[3 * gnum];
-  y = m_Centroids[3 * gnum + 1];
-  z = m_Centroids[3 * gnum + 2];
-  size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
-
-  for(size_t n = size_t(m_FirstPrecipitateFeature); n < numFeatures; n++)
-  {
-    if(m_FeaturePhases[n] == phase && n != gnum)
-    {
-      xn = m_Centroids[3 * n];
-      yn = m_Centroids[3 * n + 1];
-      zn = m_Centroids[3 * n + 2];
-      r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
-
-      rdfBin = (r - m_rdfMin) / m_StepSize;
-
-      if(r < m_rdfMin)
-      {
-        rdfBin = -1;
-      }
-      // if (r < 6.0)
-      //{
-      //  int stop = 0;
-      //}
-      // if (rdfBin >= m_numRDFbins) {rdfBin = m_numRDFbins;}
-      if(double_count)
-      {
-        m_RdfCurrentDist[rdfBin + 1] += 2 * add;
-      }
-      else if(!double_count)
-      {
-        m_RdfCurrentDist[rdfBin + 1] += add;
-      }
-
-      numPPTfeatures += 1;
-    }
-  }
-
-  m_RdfCurrentDistNorm = normalizeRDF(m_RdfCurrentDist, m_numRDFbins, m_StepSize, m_rdfMin, numPPTfeatures);
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-std::vector<float> InsertPrecipitatePhases::normalizeRDF(std::vector<float> rdf, int32_t num_bins, float stepSize, float rdfmin, int32_t numPPTfeatures)
-{
-  //  //Normalizing the RDF by number density of particles
-  //  (4/3*pi*(r2^3-r1^3)*numPPTfeatures/volume)
-  //  float normfactor;
-  //  float r1;
-  //  float r2;
-  //  float oneovervolume = 1.0f/volume;
-  //  float finiteAdjFactor = .5;
-
-  //  r1 = 0*finiteAdjFactor;
-  //  r2 = rdfmin*finiteAdjFactor;
-  //  normfactor = 4.0f/3.0f*SIMPLib::Constants::k_Pi*((r2*r2*r2) -
-  //  (r1*r1*r1))*numPPTfeatures*oneovervolume;
-  //  rdf[0] = rdf[0];
-
-  //  for (size_t i = 1; i < num_bins+2; i++)
-  //  {
-  //    r1 = (rdfmin + (i-1)*stepSize);
-  //    r2 = (r1 + stepSize);
-  //    r1 = r1*finiteAdjFactor;
-  //    r2 = r2*finiteAdjFactor;
-  //    normfactor = 4.0f/3.0f*SIMPLib::Constants::k_Pi*((r2*r2*r2) -
-  //    (r1*r1*r1))*numPPTfeatures*oneovervolume;
-  //    rdf[i] = rdf[i]/normfactor;
-  //  }
-
-  for(size_t i = 0; i < rdf.size(); i++)
-  {
-    rdf[i] = rdf[i] / m_RdfRandom[i];
-  }
-
-  return rdf;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 float InsertPrecipitatePhases::check_RDFerror(int32_t gadd, int32_t gremove, bool double_count)
 {
-  float rdferror = 0.0f;
-  float bhattdist = 0.0f;
-
   if(gadd > 0)
   {
-    determine_currentRDF(gadd, 1, double_count);
+    m_RdfTracker.addFeature(gadd, double_count);
   }
   if(gremove > 0)
   {
-    determine_currentRDF(gremove, -1, double_count);
-  }
-
-  if(m_RdfCurrentDistNorm.size() > m_RdfTargetDist.size())
-  {
-    compare_1Ddistributions(m_RdfTargetDist, m_RdfCurrentDistNorm, bhattdist);
-  }
-  else
-  {
-    compare_1Ddistributions(m_RdfCurrentDistNorm, m_RdfTargetDist, bhattdist);
+    m_RdfTracker.removeFeature(gremove, double_count);
   }
-  rdferror = bhattdist;
-  return rdferror;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1, std::vector<float> array2, float& bhattdist)
-{
-  bhattdist = 0;
-  float sum_array1 = 0.0f;
-  float sum_array2 = 0.0f;
-
-  //  for (std::vector<float>::iterator j=array1.begin(); j!=array1.end(); j++)
-  //  {sum_array1 += *j;}
-
-  //  for (std::vector<float>::iterator j=array2.begin(); j!=array2.end(); j++)
-  //  {sum_array2 += *j;}
 
-  size_t array1Size = array1.size();
-  for(size_t i = 0; i < array1Size; i++)
-  {
-    sum_array1 = sum_array1 + array1[i];
-    sum_array2 = sum_array2 + array2[i];
-  }
-
-  for(size_t i = 0; i < array1Size; i++)
-  {
-    array1[i] = array1[i] / sum_array1;
-    array2[i] = array2[i] / sum_array2;
-    bhattdist = bhattdist + sqrtf((array1[i] * array2[i]));
-  }
+  return m_RdfTracker.getError();
 }
 
 // -----------------------------------------------------------------------------
@@ -3102,6 +3030,18 @@ bool InsertPrecipitatePhases::getMatchRDF() const
   return m_MatchRDF;
 }
 
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::setParallelCandidateMoves(bool value)
+{
+  m_ParallelCandidateMoves = value;
+}
+
+// -----------------------------------------------------------------------------
+bool InsertPrecipitatePhases::getParallelCandidateMoves() const
+{
+  return m_ParallelCandidateMoves;
+}
+
 // -----------------------------------------------------------------------------
 void InsertPrecipitatePhases::setWriteGoalAttributes(bool value)
 {
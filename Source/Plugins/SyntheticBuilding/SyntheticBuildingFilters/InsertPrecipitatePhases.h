@@ -47,6 +47,7 @@
 #include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/RadialDistributionTracker.h"
 
 class IDataArray;
 using IDataArrayShPtrType = std::shared_ptr<IDataArray>;
@@ -85,6 +86,7 @@ class SyntheticBuilding_EXPORT InsertPrecipitatePhases : public AbstractFilter
   PYB11_PROPERTY(QString PrecipInputFile READ getPrecipInputFile WRITE setPrecipInputFile)
   PYB11_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
   PYB11_PROPERTY(bool MatchRDF READ getMatchRDF WRITE setMatchRDF)
+  PYB11_PROPERTY(bool ParallelCandidateMoves READ getParallelCandidateMoves WRITE setParallelCandidateMoves)
   PYB11_PROPERTY(bool WriteGoalAttributes READ getWriteGoalAttributes WRITE setWriteGoalAttributes)
   PYB11_PROPERTY(DataArrayPath InputStatsArrayPath READ getInputStatsArrayPath WRITE setInputStatsArrayPath)
   PYB11_PROPERTY(DataArrayPath InputPhaseTypesArrayPath READ getInputPhaseTypesArrayPath WRITE setInputPhaseTypesArrayPath)
@@ -234,6 +236,17 @@ public:
   bool getMatchRDF() const;
   Q_PROPERTY(bool MatchRDF READ getMatchRDF WRITE setMatchRDF)
 
+  /**
+   * @brief Setter property for ParallelCandidateMoves
+   */
+  void setParallelCandidateMoves(bool value);
+  /**
+   * @brief Getter property for ParallelCandidateMoves
+   * @return Value of ParallelCandidateMoves
+   */
+  bool getParallelCandidateMoves() const;
+  Q_PROPERTY(bool ParallelCandidateMoves READ getParallelCandidateMoves WRITE setParallelCandidateMoves)
+
   /**
    * @brief Setter property for WriteGoalAttributes
    */
@@ -593,26 +606,6 @@ protected:
    */
   void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
 
-  /**
-   * @brief determine_currentRDF Determines the radial distribution function about a given precipitate
-   * @param featureNum Index for the precipitate to determine RDF
-   * @param add Determines amount to iterate RDF bins
-   * @param double_count Determines whether to double count items in bins
-   */
-  void determine_currentRDF(int32_t featureNum, int32_t add, bool double_count);
-
-  /**
-   * @brief normalizeRDF Normalizes a radial distribution function
-   * @param rdf RDF to normalize
-   * @param num_bins Number of bins in the discretized RDF
-   * @param stepsize Bin sted size for discretized RDF
-   * @param rdfmin Minimum value for RDF
-   * @param numPPTfeatures Number of precipiate Features
-   * @param volume Volume for a given precipitate
-   * @return Normalized RDF
-   */
-  std::vector<float> normalizeRDF(std::vector<float> rdf, int num_bins, float stepsize, float rdfmin, int32_t numPPTfeatures);
-
   /**
    * @brief check_RDFerror Computes the error between the current radial distribution function
    * and the goal radial distribution function
@@ -638,12 +631,6 @@ protected:
    */
   void write_goal_attributes();
 
-  /**
-   * @brief compare_1Ddistributions Computes the 1D Bhattacharyya distance
-   * @param sqrerror Float 1D Bhattacharyya distance
-   */
-  void compare_1Ddistributions(std::vector<float>, std::vector<float>, float& sqrerror);
-
   /**
    * @brief compare_2Ddistributions Computes the 2D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
@@ -694,6 +681,7 @@ private:
   QString m_PrecipInputFile = {};
   bool m_PeriodicBoundaries = {false};
   bool m_MatchRDF = {false};
+  bool m_ParallelCandidateMoves = {false};
   bool m_WriteGoalAttributes = {false};
   DataArrayPath m_InputStatsArrayPath = {SIMPL::Defaults::StatsGenerator, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::Statistics};
   DataArrayPath m_InputPhaseTypesArrayPath = {SIMPL::Defaults::StatsGenerator, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::PhaseTypes};
@@ -752,8 +740,7 @@ private:
   std::vector<std::vector<float>> m_FeatureSizeDist;
   std::vector<std::vector<float>> m_SimFeatureSizeDist;
   std::vector<float> m_RdfTargetDist;
-  std::vector<float> m_RdfCurrentDist;
-  std::vector<float> m_RdfCurrentDistNorm;
+  RadialDistributionTracker m_RdfTracker;
 
   std::vector<float> m_RandomCentroids;
   std::vector<float> m_RdfRandom;
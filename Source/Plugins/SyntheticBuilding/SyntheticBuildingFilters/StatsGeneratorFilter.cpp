@@ -57,6 +57,7 @@
 #include "SyntheticBuilding/FilterParameters/StatsGeneratorFilterParameter.h"
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingFilters/StatsGeneratorUtilities.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/TextureComputeService.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
@@ -404,8 +405,10 @@ void StatsGeneratorFilter::execute()
         }
       }
 
-      // Compute the ODF representation that will be used to determine the MDF
-      std::vector<float> odf = StatsGeneratorUtilities::GenerateODFData(crystalStruct, e1s, e2s, e3s, weights, sigmas);
+      // Compute the ODF representation that will be used to determine the MDF. This is the ODF that was just
+      // binned above, so the service hands back that result instead of computing it again
+      TextureComputeService::ODFInput odfInput = {crystalStruct, e1s, e2s, e3s, weights, sigmas};
+      std::vector<float> odf = *(TextureComputeService::Instance()->odf(odfInput));
 
       // Compute the binned MDF and set it into the StatsDataArray
       StatsGeneratorUtilities::GenerateMisorientationBinData(statsData.get(), phaseType, crystalStruct, odf, mdf_angles, mdf_axes, mdf_weights);
@@ -56,6 +56,8 @@
 #include "EbsdLib/Texture/StatsGen.hpp"
 #include "EbsdLib/Texture/Texture.hpp"
 
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/TextureComputeService.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -75,49 +77,11 @@ void StatsGeneratorUtilities::GenerateODFBinData(StatsData* statsData, PhaseType
   using ContainerType = std::vector<float>;
 
   ContainerType odf;
-  size_t numEntries = e1s.size();
-  //// ODF/MDF Update Codes
+  // The ODF comes from the shared service, so generating the MDF of the same phase afterwards reuses it
   if(computeODF)
   {
-    LaueOps::Pointer ops = LaueOps::NullPointer();
-    switch(crystalStructure)
-    {
-    case EbsdLib::CrystalStructure::Triclinic: // 4; Triclinic -1
-      Texture::CalculateODFData<float, TriclinicOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Monoclinic: // 5; Monoclinic 2/m
-      Texture::CalculateODFData<float, MonoclinicOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::OrthoRhombic: // 6; Orthorhombic mmm
-      Texture::CalculateODFData<float, OrthoRhombicOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Tetragonal_Low: // 7; Tetragonal-Low 4/m
-      Texture::CalculateODFData<float, TetragonalLowOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Tetragonal_High: // 8; Tetragonal-High 4/mmm
-      Texture::CalculateODFData<float, TetragonalOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Trigonal_Low: // 9; Trigonal-Low -3
-      Texture::CalculateODFData<float, TrigonalLowOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Trigonal_High: // 10; Trigonal-High -3m
-      Texture::CalculateODFData<float, TrigonalOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Hexagonal_Low: // 2; Hexagonal-Low 6/m
-      Texture::CalculateODFData<float, HexagonalLowOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Hexagonal_High: // 0; Hexagonal-High 6/mmm
-      Texture::CalculateODFData<float, HexagonalOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Cubic_Low: // 3; Cubic Cubic-Low m3 (Tetrahedral)
-      Texture::CalculateODFData<float, CubicLowOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    case EbsdLib::CrystalStructure::Cubic_High: // 1; Cubic Cubic-High m3m
-      Texture::CalculateODFData<float, CubicOps, ContainerType>(e1s, e2s, e3s, weights, sigmas, true, odf, numEntries);
-      break;
-    default:
-      break;
-    }
+    TextureComputeService::ODFInput input = {crystalStructure, e1s, e2s, e3s, weights, sigmas};
+    odf = *(TextureComputeService::Instance()->odf(input));
   }
 
   if(!odf.empty())
@@ -398,3 +362,66 @@ void StatsGeneratorUtilities::GenerateMisorientationBinData(StatsData* statsData
     }
   }
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int StatsGeneratorUtilities::GenerateMDFPlotData(unsigned int crystalStructure, const std::vector<float>& odf, std::vector<float>& angles, std::vector<float>& axes, std::vector<float>& weights,
+                                                 std::vector<float>& x, std::vector<float>& y, int size)
+{
+  using ContainerType = std::vector<float>;
+
+  int err = 0;
+  ContainerType mdf;
+  switch(crystalStructure)
+  {
+  case EbsdLib::CrystalStructure::Triclinic: // 4; Triclinic -1
+    Texture::CalculateMDFData<float, TriclinicOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, TriclinicOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Monoclinic: // 5; Monoclinic 2/m
+    Texture::CalculateMDFData<float, MonoclinicOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, MonoclinicOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::OrthoRhombic: // 6; Orthorhombic mmm
+    Texture::CalculateMDFData<float, OrthoRhombicOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, OrthoRhombicOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Tetragonal_Low: // 7; Tetragonal-Low 4/m
+    Texture::CalculateMDFData<float, TetragonalLowOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, TetragonalLowOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Tetragonal_High: // 8; Tetragonal-High 4/mmm
+    Texture::CalculateMDFData<float, TetragonalOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, TetragonalOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Trigonal_Low: // 9; Trigonal-Low -3
+    Texture::CalculateMDFData<float, TrigonalLowOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, TrigonalLowOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Trigonal_High: // 10; Trigonal-High -3m
+    Texture::CalculateMDFData<float, TrigonalOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, TrigonalOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Hexagonal_Low: // 2; Hexagonal-Low 6/m
+    Texture::CalculateMDFData<float, HexagonalLowOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, HexagonalLowOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Hexagonal_High: // 0; Hexagonal-High 6/mmm
+    Texture::CalculateMDFData<float, HexagonalOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, HexagonalOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Cubic_Low: // 3; Cubic Cubic-Low m3 (Tetrahedral)
+    Texture::CalculateMDFData<float, CubicLowOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, CubicLowOps, ContainerType>(mdf, x, y, size);
+    break;
+  case EbsdLib::CrystalStructure::Cubic_High: // 1; Cubic Cubic-High m3m
+    Texture::CalculateMDFData<float, CubicOps, ContainerType>(angles, axes, weights, odf, mdf, angles.size());
+    err = StatsGen::GenMDFPlotData<float, CubicOps, ContainerType>(mdf, x, y, size);
+    break;
+  default:
+    err = -1;
+    break;
+  }
+  return err;
+}
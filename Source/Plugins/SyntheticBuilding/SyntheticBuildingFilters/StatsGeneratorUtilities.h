@@ -68,6 +68,22 @@ public:
   static void GenerateMisorientationBinData(StatsData* statsData, PhaseType::Type phaseType, unsigned int crystalStruct, std::vector<float>& odf, std::vector<float>& angles, std::vector<float>& axes,
                                             std::vector<float>& weights, bool computeMDF = true);
 
+  /**
+   * @brief GenerateMDFPlotData Computes the MDF of the misorientation entries on top of the ODF and samples it
+   * into the plotted MDF curve
+   * @param crystalStructure
+   * @param odf
+   * @param angles Misorientation angles in radians
+   * @param axes Unit misorientation axes, 3 values per angle
+   * @param weights
+   * @param x Output misorientation angles of the curve
+   * @param y Output frequencies of the curve
+   * @param size Number of random misorientations used for the curve
+   * @return Negative if the crystal structure is not supported
+   */
+  static int GenerateMDFPlotData(unsigned int crystalStructure, const std::vector<float>& odf, std::vector<float>& angles, std::vector<float>& axes, std::vector<float>& weights,
+                                 std::vector<float>& x, std::vector<float>& y, int size);
+
 protected:
   StatsGeneratorUtilities();
 
@@ -0,0 +1,132 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief The CounterRandom class is a counter based random number generator (Philox4x32-10, Salmon et al.,
+ * "Parallel Random Numbers: As Easy as 1, 2, 3", SC11). Every block of random numbers is a pure function of the
+ * seed and a counter, so the numbers for an element can be drawn from its index in any order and on any thread.
+ * A filter draws the numbers of element i from the counter (i, stream), using a different stream for every
+ * independent draw it needs for that element. Filters keep their streams in separate ranges (the filter in the
+ * upper 32 bits) so the same seed does not give correlated noise in two filters of one pipeline.
+ */
+class CounterRandom
+{
+public:
+  using Block = std::array<uint32_t, 4>;
+
+  explicit CounterRandom(uint64_t seed)
+  : m_Key({static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)})
+  {
+  }
+  ~CounterRandom() = default;
+
+  CounterRandom(const CounterRandom&) = default;            // Copy Constructor Default Implemented
+  CounterRandom(CounterRandom&&) = default;                 // Move Constructor Default Implemented
+  CounterRandom& operator=(const CounterRandom&) = default; // Copy Assignment Default Implemented
+  CounterRandom& operator=(CounterRandom&&) = default;      // Move Assignment Default Implemented
+
+  /**
+   * @brief generate Returns the four 32 bit random words of the counter (index, stream)
+   * @param index
+   * @param stream
+   * @return
+   */
+  Block generate(uint64_t index, uint64_t stream) const
+  {
+    Block ctr = {static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+    std::array<uint32_t, 2> key = m_Key;
+    for(int32_t round = 0; round < 10; round++)
+    {
+      if(round > 0)
+      {
+        key[0] += k_Weyl0;
+        key[1] += k_Weyl1;
+      }
+      uint64_t product0 = static_cast<uint64_t>(k_Multiplier0) * ctr[0];
+      uint64_t product1 = static_cast<uint64_t>(k_Multiplier1) * ctr[2];
+      ctr = {static_cast<uint32_t>(product1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(product1), static_cast<uint32_t>(product0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(product0)};
+    }
+    return ctr;
+  }
+
+  /**
+   * @brief uniform Returns a random double in [0, 1) with 53 bits of resolution, the same resolution as
+   * SIMPLibRandom::genrand_res53()
+   * @param index
+   * @param stream
+   * @return
+   */
+  double uniform(uint64_t index, uint64_t stream) const
+  {
+    Block block = generate(index, stream);
+    return ToUnitInterval(block[0], block[1]);
+  }
+
+  /**
+   * @brief uniformPair Returns two independent random doubles in [0, 1) from a single block
+   * @param index
+   * @param stream
+   * @return
+   */
+  std::array<double, 2> uniformPair(uint64_t index, uint64_t stream) const
+  {
+    Block block = generate(index, stream);
+    return {ToUnitInterval(block[0], block[1]), ToUnitInterval(block[2], block[3])};
+  }
+
+  /**
+   * @brief ToUnitInterval Combines two 32 bit words into a double in [0, 1)
+   * @param a
+   * @param b
+   * @return
+   */
+  static double ToUnitInterval(uint32_t a, uint32_t b)
+  {
+    return (static_cast<double>(a >> 5) * 67108864.0 + static_cast<double>(b >> 6)) * (1.0 / 9007199254740992.0);
+  }
+
+private:
+  static constexpr uint32_t k_Multiplier0 = 0xD2511F53;
+  static constexpr uint32_t k_Multiplier1 = 0xCD9E8D57;
+  static constexpr uint32_t k_Weyl0 = 0x9E3779B9;
+  static constexpr uint32_t k_Weyl1 = 0xBB67AE85;
+
+  std::array<uint32_t, 2> m_Key;
+};
@@ -0,0 +1,386 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FeatureLatticeFill.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "SIMPLib/Math/MatrixMath.h"
+
+namespace
+{
+using BasisStep = std::array<float, 3>;
+
+// -----------------------------------------------------------------------------
+// Steps in lattice units from one atom of the basis to the next, starting at the lattice point itself
+const std::vector<BasisStep>& basisSteps(uint32_t basis)
+{
+  static const std::vector<BasisStep> k_SimpleCubic = {};
+  static const std::vector<BasisStep> k_BodyCentered = {{{0.5f, 0.5f, 0.5f}}};
+  static const std::vector<BasisStep> k_FaceCentered = {{{0.5f, 0.5f, 0.0f}}, {{0.0f, -0.5f, 0.5f}}, {{-0.5f, 0.5f, 0.0f}}};
+  // Face centered cubic plus the same four atoms shifted by (0.25, 0.25, 0.25)
+  static const std::vector<BasisStep> k_Diamond = {{{0.5f, 0.5f, 0.0f}},    {{0.0f, -0.5f, 0.5f}}, {{-0.5f, 0.5f, 0.0f}}, {{0.25f, -0.25f, -0.25f}},
+                                                   {{0.5f, 0.5f, 0.0f}},    {{0.0f, -0.5f, 0.5f}}, {{-0.5f, 0.5f, 0.0f}}};
+  switch(basis)
+  {
+  case 1:
+    return k_BodyCentered;
+  case 2:
+    return k_FaceCentered;
+  case 3:
+    return k_Diamond;
+  default:
+    return k_SimpleCubic;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Edge function of the row (y, z) against the edge from a to b in the yz plane. The edge is always evaluated
+// from its lower vertex index, so two triangles that share an edge get exactly opposite values. A row that lies
+// on the edge is treated as if it were moved by (e, e^2), so it is inside exactly one of the two triangles.
+double edgeFunction(const float* pa, const float* pb, MeshIndexType ia, MeshIndexType ib, float y, float z, int32_t& side)
+{
+  bool flip = ia > ib;
+  if(flip)
+  {
+    std::swap(pa, pb);
+  }
+  double dy = static_cast<double>(pb[1]) - static_cast<double>(pa[1]);
+  double dz = static_cast<double>(pb[2]) - static_cast<double>(pa[2]);
+  double value = dy * (static_cast<double>(z) - pa[2]) - dz * (static_cast<double>(y) - pa[1]);
+  side = (value > 0.0) ? 1 : ((value < 0.0) ? -1 : 0);
+  if(side == 0)
+  {
+    side = (dz != 0.0) ? ((dz > 0.0) ? -1 : 1) : ((dy > 0.0) ? 1 : ((dy < 0.0) ? -1 : 0));
+  }
+  if(flip)
+  {
+    value = -value;
+    side = -side;
+  }
+  return value;
+}
+
+// -----------------------------------------------------------------------------
+// Adds the x coordinate where the row (y, z) crosses the triangle, if it does
+void addCrossing(const float* tri, const MeshIndexType* ids, float y, float z, std::vector<double>& crossings)
+{
+  float minY = std::min({tri[1], tri[4], tri[7]});
+  float maxY = std::max({tri[1], tri[4], tri[7]});
+  float minZ = std::min({tri[2], tri[5], tri[8]});
+  float maxZ = std::max({tri[2], tri[5], tri[8]});
+  if(y < minY || y > maxY || z < minZ || z > maxZ)
+  {
+    return;
+  }
+
+  // w[c] belongs to the edge opposite vertex c and is proportional to the barycentric coordinate of vertex c
+  double w[3] = {0.0, 0.0, 0.0};
+  int32_t side[3] = {0, 0, 0};
+  for(size_t c = 0; c < 3; c++)
+  {
+    size_t a = (c + 1) % 3;
+    size_t b = (c + 2) % 3;
+    w[c] = edgeFunction(tri + 3 * a, tri + 3 * b, ids[a], ids[b], y, z, side[c]);
+  }
+  if(side[0] == 0 || side[0] != side[1] || side[0] != side[2])
+  {
+    return;
+  }
+  double sum = w[0] + w[1] + w[2];
+  if(sum == 0.0)
+  {
+    return;
+  }
+  crossings.push_back((w[0] * tri[0] + w[1] * tri[3] + w[2] * tri[6]) / sum);
+}
+
+// -----------------------------------------------------------------------------
+// Points on a crossing count as inside
+bool insideRow(const std::vector<double>& crossings, float x)
+{
+  size_t below = static_cast<size_t>(std::lower_bound(crossings.begin(), crossings.end(), static_cast<double>(x)) - crossings.begin());
+  size_t upTo = static_cast<size_t>(std::upper_bound(crossings.begin(), crossings.end(), static_cast<double>(x)) - crossings.begin());
+  return (below % 2 == 1) || (upTo % 2 == 1);
+}
+
+// -----------------------------------------------------------------------------
+// Range of lattice indices along one axis whose rows may touch [minValue, maxValue]
+void rowRange(float minValue, float maxValue, float origin, float spacing, float minOffset, float maxOffset, int64_t numPoints, int64_t& low, int64_t& high)
+{
+  low = static_cast<int64_t>(std::floor((minValue - origin) / spacing - maxOffset)) - 1;
+  high = static_cast<int64_t>(std::ceil((maxValue - origin) / spacing - minOffset)) + 1;
+  low = std::max<int64_t>(low, 0);
+  high = std::min<int64_t>(high, numPoints - 1);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureLatticeFill::FeatureLatticeFill() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureLatticeFill::~FeatureLatticeFill() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureLatticeFill::AtomsPerLatticePoint(uint32_t basis)
+{
+  return basisSteps(basis).size() + 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureLatticeFill::FillFeature(const MeshIndexType* triangles, const float* vertices, const int64_t* faces, size_t numFaces, const float g[3][3], const float latticeConstants[3],
+                                     uint32_t basis, std::vector<float>& atoms)
+{
+  if(numFaces == 0)
+  {
+    return;
+  }
+
+  float gRot[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  float gT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  for(size_t r = 0; r < 3; r++)
+  {
+    for(size_t c = 0; c < 3; c++)
+    {
+      gRot[r][c] = g[r][c];
+    }
+  }
+  MatrixMath::Transpose3x3(gRot, gT);
+
+  // Rotate the triangles into the crystal frame and find their bounding box there
+  std::vector<float> rotated(9 * numFaces);
+  std::vector<MeshIndexType> ids(3 * numFaces);
+  float ll[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+  float ur[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+  float vertex[3] = {0.0f, 0.0f, 0.0f};
+  for(size_t f = 0; f < numFaces; f++)
+  {
+    for(size_t c = 0; c < 3; c++)
+    {
+      MeshIndexType id = triangles[3 * faces[f] + c];
+      ids[3 * f + c] = id;
+      vertex[0] = vertices[3 * id];
+      vertex[1] = vertices[3 * id + 1];
+      vertex[2] = vertices[3 * id + 2];
+      float* rot = rotated.data() + 9 * f + 3 * c;
+      MatrixMath::Multiply3x3with3x1(gRot, vertex, rot);
+      for(size_t d = 0; d < 3; d++)
+      {
+        ll[d] = std::min(ll[d], rot[d]);
+        ur[d] = std::max(ur[d], rot[d]);
+      }
+    }
+  }
+
+  const float* a = latticeConstants;
+  int64_t xPoints = (int64_t((ur[0] - ll[0]) / a[0]) + 1);
+  int64_t yPoints = (int64_t((ur[1] - ll[1]) / a[1]) + 1);
+  int64_t zPoints = (int64_t((ur[2] - ll[2]) / a[2]) + 1);
+
+  const std::vector<BasisStep>& steps = basisSteps(basis);
+  size_t atomMult = steps.size() + 1;
+  std::vector<std::array<float, 3>> coords(atomMult);
+
+  // The atoms of a lattice point are placed by adding the steps one after another, exactly as the lattice was
+  // always generated, so every atom of a row has the same y and z
+  auto basisCoords = [&](int64_t i, int64_t j, int64_t k) {
+    float c[3] = {float(i) * a[0] + ll[0], float(j) * a[1] + ll[1], float(k) * a[2] + ll[2]};
+    coords[0] = {{c[0], c[1], c[2]}};
+    for(size_t s = 0; s < steps.size(); s++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        c[d] = c[d] + (steps[s][d] * a[d]);
+      }
+      coords[s + 1] = {{c[0], c[1], c[2]}};
+    }
+  };
+
+  // Offsets of the atoms of the basis in lattice units, only used to find the rows a triangle may cross
+  float minOffset[3] = {0.0f, 0.0f, 0.0f};
+  float maxOffset[3] = {0.0f, 0.0f, 0.0f};
+  {
+    float offset[3] = {0.0f, 0.0f, 0.0f};
+    for(const BasisStep& step : steps)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        offset[d] += step[d];
+        minOffset[d] = std::min(minOffset[d], offset[d]);
+        maxOffset[d] = std::max(maxOffset[d], offset[d]);
+      }
+    }
+  }
+
+  // Sort the triangles into the planes of rows they may cross
+  std::vector<size_t> planeOffsets(static_cast<size_t>(zPoints) + 1, 0);
+  std::vector<size_t> planeFaces;
+  {
+    for(size_t f = 0; f < numFaces; f++)
+    {
+      const float* tri = rotated.data() + 9 * f;
+      int64_t low = 0, high = 0;
+      rowRange(std::min({tri[2], tri[5], tri[8]}), std::max({tri[2], tri[5], tri[8]}), ll[2], a[2], minOffset[2], maxOffset[2], zPoints, low, high);
+      for(int64_t k = low; k <= high; k++)
+      {
+        planeOffsets[k + 1]++;
+      }
+    }
+    for(int64_t k = 0; k < zPoints; k++)
+    {
+      planeOffsets[k + 1] += planeOffsets[k];
+    }
+    planeFaces.resize(planeOffsets.back());
+    std::vector<size_t> fill(planeOffsets.begin(), planeOffsets.end() - 1);
+    for(size_t f = 0; f < numFaces; f++)
+    {
+      const float* tri = rotated.data() + 9 * f;
+      int64_t low = 0, high = 0;
+      rowRange(std::min({tri[2], tri[5], tri[8]}), std::max({tri[2], tri[5], tri[8]}), ll[2], a[2], minOffset[2], maxOffset[2], zPoints, low, high);
+      for(int64_t k = low; k <= high; k++)
+      {
+        planeFaces[fill[k]++] = f;
+      }
+    }
+  }
+
+  std::vector<size_t> rowOffsets(static_cast<size_t>(yPoints) + 1, 0);
+  std::vector<size_t> rowFaces;
+  std::vector<std::vector<double>> crossings(atomMult);
+  float coordsT[3] = {0.0f, 0.0f, 0.0f};
+  for(int64_t k = 0; k < zPoints; k++)
+  {
+    size_t planeStart = planeOffsets[k];
+    size_t planeEnd = planeOffsets[k + 1];
+    if(planeStart == planeEnd)
+    {
+      continue;
+    }
+
+    // Sort the triangles of this plane into the rows they may cross
+    std::fill(rowOffsets.begin(), rowOffsets.end(), 0);
+    for(size_t p = planeStart; p < planeEnd; p++)
+    {
+      const float* tri = rotated.data() + 9 * planeFaces[p];
+      int64_t low = 0, high = 0;
+      rowRange(std::min({tri[1], tri[4], tri[7]}), std::max({tri[1], tri[4], tri[7]}), ll[1], a[1], minOffset[1], maxOffset[1], yPoints, low, high);
+      for(int64_t j = low; j <= high; j++)
+      {
+        rowOffsets[j + 1]++;
+      }
+    }
+    for(int64_t j = 0; j < yPoints; j++)
+    {
+      rowOffsets[j + 1] += rowOffsets[j];
+    }
+    rowFaces.resize(rowOffsets.back());
+    std::vector<size_t> fill(rowOffsets.begin(), rowOffsets.end() - 1);
+    for(size_t p = planeStart; p < planeEnd; p++)
+    {
+      const float* tri = rotated.data() + 9 * planeFaces[p];
+      int64_t low = 0, high = 0;
+      rowRange(std::min({tri[1], tri[4], tri[7]}), std::max({tri[1], tri[4], tri[7]}), ll[1], a[1], minOffset[1], maxOffset[1], yPoints, low, high);
+      for(int64_t j = low; j <= high; j++)
+      {
+        rowFaces[fill[j]++] = planeFaces[p];
+      }
+    }
+
+    for(int64_t j = 0; j < yPoints; j++)
+    {
+      if(rowOffsets[j] == rowOffsets[j + 1])
+      {
+        continue;
+      }
+
+      // One intersection pass over the candidate triangles for the row of each atom of the basis
+      basisCoords(0, j, k);
+      double minCrossing = std::numeric_limits<double>::max();
+      double maxCrossing = std::numeric_limits<double>::lowest();
+      for(size_t b = 0; b < atomMult; b++)
+      {
+        crossings[b].clear();
+        for(size_t r = rowOffsets[j]; r < rowOffsets[j + 1]; r++)
+        {
+          size_t f = rowFaces[r];
+          addCrossing(rotated.data() + 9 * f, ids.data() + 3 * f, coords[b][1], coords[b][2], crossings[b]);
+        }
+        std::sort(crossings[b].begin(), crossings[b].end());
+        // An open surface leaves an unpaired crossing, which would otherwise fill the rest of the row
+        if(crossings[b].size() % 2 == 1)
+        {
+          crossings[b].pop_back();
+        }
+        if(!crossings[b].empty())
+        {
+          minCrossing = std::min(minCrossing, crossings[b].front());
+          maxCrossing = std::max(maxCrossing, crossings[b].back());
+        }
+      }
+      if(minCrossing > maxCrossing)
+      {
+        continue;
+      }
+
+      int64_t low = 0, high = 0;
+      rowRange(static_cast<float>(minCrossing), static_cast<float>(maxCrossing), ll[0], a[0], minOffset[0], maxOffset[0], xPoints, low, high);
+      for(int64_t i = low; i <= high; i++)
+      {
+        basisCoords(i, j, k);
+        for(size_t b = 0; b < atomMult; b++)
+        {
+          if(!crossings[b].empty() && insideRow(crossings[b], coords[b][0]))
+          {
+            MatrixMath::Multiply3x3with3x1(gT, coords[b].data(), coordsT);
+            atoms.push_back(coordsT[0]);
+            atoms.push_back(coordsT[1]);
+            atoms.push_back(coordsT[2]);
+          }
+        }
+      }
+    }
+  }
+}
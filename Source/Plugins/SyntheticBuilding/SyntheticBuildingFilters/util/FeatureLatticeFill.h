@@ -0,0 +1,86 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/Geometry/IGeometry.h"
+
+/**
+ * @brief The FeatureLatticeFill class places atoms on the crystal lattice of a Feature that is bounded by a
+ * closed set of triangles. The triangles are rotated into the crystal frame of the Feature, where every lattice
+ * row runs along the crystal x axis. Each row that crosses the triangles is intersected with them once, and the
+ * atoms of the row that fall between an entering and an exiting crossing are kept.
+ */
+class FeatureLatticeFill
+{
+public:
+  virtual ~FeatureLatticeFill();
+
+  /**
+   * @brief AtomsPerLatticePoint Returns the number of atoms the basis places at each lattice point
+   * @param basis 0=Simple Cubic, 1=Body Centered Cubic, 2=Face Centered Cubic, 3=Cubic Diamond
+   * @return
+   */
+  static size_t AtomsPerLatticePoint(uint32_t basis);
+
+  /**
+   * @brief FillFeature Appends the positions of the atoms inside a Feature. The lattice starts at the lower
+   * corner of the bounding box of the rotated triangles. The atoms are appended in the order of the lattice points,
+   * z slowest and x fastest, with the atoms of the basis of each lattice point next to each other.
+   * @param triangles Vertex indices of all triangles
+   * @param vertices Vertex coordinates
+   * @param faces Indices of the triangles that bound the Feature
+   * @param numFaces Number of triangles that bound the Feature
+   * @param g Orientation matrix that rotates sample coordinates into the crystal frame of the Feature
+   * @param latticeConstants Lattice constants a, b and c
+   * @param basis 0=Simple Cubic, 1=Body Centered Cubic, 2=Face Centered Cubic, 3=Cubic Diamond
+   * @param atoms Output coordinates, 3 per atom
+   */
+  static void FillFeature(const MeshIndexType* triangles, const float* vertices, const int64_t* faces, size_t numFaces, const float g[3][3], const float latticeConstants[3], uint32_t basis,
+                          std::vector<float>& atoms);
+
+protected:
+  FeatureLatticeFill();
+
+public:
+  FeatureLatticeFill(const FeatureLatticeFill&) = delete;            // Copy Constructor Not Implemented
+  FeatureLatticeFill(FeatureLatticeFill&&) = delete;                 // Move Constructor Not Implemented
+  FeatureLatticeFill& operator=(const FeatureLatticeFill&) = delete; // Copy Assignment Not Implemented
+  FeatureLatticeFill& operator=(FeatureLatticeFill&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,254 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "RadialDistributionTracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Upper bound on the number of cells per Feature so sparse volumes do not allocate huge empty grids
+constexpr size_t k_MaxCellsPerFeature = 2;
+constexpr size_t k_MinCells = 64;
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RadialDistributionTracker::RadialDistributionTracker() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RadialDistributionTracker::~RadialDistributionTracker() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RadialDistributionTracker::initialize(const std::vector<float>& targetDist, const std::vector<float>& randomDist, float rdfMin, float stepSize, size_t numBins,
+                                           const std::array<float, 3>& boxDims, size_t numFeatures)
+{
+  numBins = std::min({numBins, targetDist.size(), randomDist.size()});
+  m_TargetDist.assign(targetDist.begin(), targetDist.begin() + numBins);
+  m_RandomDist.assign(randomDist.begin(), randomDist.begin() + numBins);
+  m_CurrentDist.assign(numBins, 0.0);
+  m_CurrentDistNorm.assign(numBins, 0.0f);
+  m_RdfMin = rdfMin;
+  m_StepSize = stepSize;
+
+  // Any distance that lands in a compared bin is shorter than the cutoff. The extra bin covers the rounding
+  // of the bin index.
+  float cutoff = rdfMin + static_cast<float>(numBins) * stepSize;
+  size_t maxCells = std::max(k_MinCells, k_MaxCellsPerFeature * numFeatures);
+  for(size_t i = 0; i < 3; i++)
+  {
+    m_CellDims[i] = 1;
+    if(cutoff > 0.0f && boxDims[i] > cutoff)
+    {
+      m_CellDims[i] = static_cast<int64_t>(boxDims[i] / cutoff);
+    }
+  }
+  while(static_cast<size_t>(m_CellDims[0] * m_CellDims[1] * m_CellDims[2]) > maxCells)
+  {
+    for(size_t i = 0; i < 3; i++)
+    {
+      m_CellDims[i] = std::max<int64_t>(m_CellDims[i] / 2, 1);
+    }
+  }
+  for(size_t i = 0; i < 3; i++)
+  {
+    m_CellSize[i] = boxDims[i] > 0.0f ? boxDims[i] / static_cast<float>(m_CellDims[i]) : 1.0f;
+  }
+
+  m_Cells.assign(static_cast<size_t>(m_CellDims[0] * m_CellDims[1] * m_CellDims[2]), std::vector<int32_t>());
+  m_FeatureCell.assign(numFeatures, -1);
+  m_FeatureSlot.assign(numFeatures, 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RadialDistributionTracker::setFeatureData(const float* centroids, const int32_t* featurePhases)
+{
+  m_Centroids = centroids;
+  m_FeaturePhases = featurePhases;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::array<int64_t, 3> RadialDistributionTracker::findCell(const float* position) const
+{
+  std::array<int64_t, 3> cell = {{0, 0, 0}};
+  for(size_t i = 0; i < 3; i++)
+  {
+    int64_t c = static_cast<int64_t>(std::floor(position[i] / m_CellSize[i]));
+    cell[i] = std::min(std::max(c, int64_t(0)), m_CellDims[i] - 1);
+  }
+  return cell;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RadialDistributionTracker::addDistances(const float* position, int32_t phase, int32_t skipFeature, double weight, std::vector<double>& counts) const
+{
+  const int32_t numBins = static_cast<int32_t>(counts.size());
+  std::array<int64_t, 3> cell = findCell(position);
+  float x = position[0];
+  float y = position[1];
+  float z = position[2];
+
+  for(int64_t k = std::max<int64_t>(cell[2] - 1, 0); k <= std::min(cell[2] + 1, m_CellDims[2] - 1); k++)
+  {
+    for(int64_t j = std::max<int64_t>(cell[1] - 1, 0); j <= std::min(cell[1] + 1, m_CellDims[1] - 1); j++)
+    {
+      for(int64_t i = std::max<int64_t>(cell[0] - 1, 0); i <= std::min(cell[0] + 1, m_CellDims[0] - 1); i++)
+      {
+        const std::vector<int32_t>& members = m_Cells[(k * m_CellDims[1] + j) * m_CellDims[0] + i];
+        for(int32_t n : members)
+        {
+          if(n == skipFeature || m_FeaturePhases[n] != phase)
+          {
+            continue;
+          }
+          float xn = m_Centroids[3 * n];
+          float yn = m_Centroids[3 * n + 1];
+          float zn = m_Centroids[3 * n + 2];
+          float r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+          int32_t rdfBin = -1;
+          if(r >= m_RdfMin)
+          {
+            rdfBin = static_cast<int32_t>((r - m_RdfMin) / m_StepSize);
+          }
+          if(rdfBin + 1 < numBins)
+          {
+            counts[rdfBin + 1] += weight;
+          }
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RadialDistributionTracker::addFeature(int32_t feature, bool doubleCount)
+{
+  const float* position = m_Centroids + 3 * feature;
+  addDistances(position, m_FeaturePhases[feature], feature, doubleCount ? 2.0 : 1.0, m_CurrentDist);
+
+  std::array<int64_t, 3> cell = findCell(position);
+  int64_t cellIndex = (cell[2] * m_CellDims[1] + cell[1]) * m_CellDims[0] + cell[0];
+  std::vector<int32_t>& members = m_Cells[cellIndex];
+  m_FeatureCell[feature] = cellIndex;
+  m_FeatureSlot[feature] = members.size();
+  members.push_back(feature);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RadialDistributionTracker::removeFeature(int32_t feature, bool doubleCount)
+{
+  int64_t cellIndex = m_FeatureCell[feature];
+  if(cellIndex < 0)
+  {
+    return;
+  }
+  std::vector<int32_t>& members = m_Cells[cellIndex];
+  size_t slot = m_FeatureSlot[feature];
+  members[slot] = members.back();
+  m_FeatureSlot[members[slot]] = slot;
+  members.pop_back();
+  m_FeatureCell[feature] = -1;
+
+  addDistances(m_Centroids + 3 * feature, m_FeaturePhases[feature], feature, doubleCount ? -2.0 : -1.0, m_CurrentDist);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float RadialDistributionTracker::compare(const std::vector<double>& counts, std::vector<float>& normalized) const
+{
+  size_t numBins = counts.size();
+  float sumCurrent = 0.0f;
+  float sumTarget = 0.0f;
+  for(size_t i = 0; i < numBins; i++)
+  {
+    normalized[i] = static_cast<float>(counts[i]) / m_RandomDist[i];
+    sumCurrent = sumCurrent + normalized[i];
+    sumTarget = sumTarget + m_TargetDist[i];
+  }
+
+  float bhattdist = 0.0f;
+  for(size_t i = 0; i < numBins; i++)
+  {
+    bhattdist = bhattdist + sqrtf((normalized[i] / sumCurrent) * (m_TargetDist[i] / sumTarget));
+  }
+  return bhattdist;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float RadialDistributionTracker::getError()
+{
+  return compare(m_CurrentDist, m_CurrentDistNorm);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float RadialDistributionTracker::evaluateMove(int32_t feature, const float position[3], bool doubleCount) const
+{
+  std::vector<double> counts = m_CurrentDist;
+  std::vector<float> normalized(counts.size(), 0.0f);
+  int32_t phase = m_FeaturePhases[feature];
+  double weight = doubleCount ? 2.0 : 1.0;
+  addDistances(m_Centroids + 3 * feature, phase, feature, -weight, counts);
+  addDistances(position, phase, feature, weight, counts);
+  return compare(counts, normalized);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<float>& RadialDistributionTracker::getNormalizedDistribution() const
+{
+  return m_CurrentDistNorm;
+}
@@ -0,0 +1,165 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The RadialDistributionTracker class keeps the radial distribution function of the precipitates up to
+ * date while they are added, removed and moved. The precipitates are binned into a grid of cells that are at
+ * least as large as the largest distance that takes part in the comparison with the target distribution, so only
+ * the precipitates in the neighboring cells are visited when a precipitate changes. Distances beyond the compared
+ * bins do not change the error and are not counted.
+ */
+class RadialDistributionTracker
+{
+public:
+  RadialDistributionTracker();
+  virtual ~RadialDistributionTracker();
+
+  /**
+   * @brief initialize Sets up the histogram and the cell grid. Bin 0 holds all distances smaller than rdfMin
+   * and bin i holds the distances in [rdfMin + (i - 1) * stepSize, rdfMin + i * stepSize).
+   * @param targetDist Target distribution
+   * @param randomDist Distribution of randomly placed precipitates used to normalize the current distribution
+   * @param rdfMin Smallest binned distance
+   * @param stepSize Width of a bin
+   * @param numBins Number of bins that are compared with the target distribution
+   * @param boxDims Dimensions of the volume
+   * @param numFeatures Total number of Features
+   */
+  void initialize(const std::vector<float>& targetDist, const std::vector<float>& randomDist, float rdfMin, float stepSize, size_t numBins, const std::array<float, 3>& boxDims,
+                  size_t numFeatures);
+
+  /**
+   * @brief setFeatureData Sets the Feature arrays. They must be set again after the Feature Attribute Matrix is resized.
+   * @param centroids
+   * @param featurePhases
+   */
+  void setFeatureData(const float* centroids, const int32_t* featurePhases);
+
+  /**
+   * @brief addFeature Adds the distances between a Feature at its current centroid and the tracked Features of the
+   * same phase, then starts tracking the Feature
+   * @param feature
+   * @param doubleCount Whether to count each distance for both Features
+   */
+  void addFeature(int32_t feature, bool doubleCount);
+
+  /**
+   * @brief removeFeature Removes the distances between a tracked Feature and the other tracked Features of the same
+   * phase, then stops tracking the Feature
+   * @param feature
+   * @param doubleCount Whether each distance was counted for both Features
+   */
+  void removeFeature(int32_t feature, bool doubleCount);
+
+  /**
+   * @brief getError Normalizes the current distribution and returns its Bhattacharyya coefficient with the target
+   * @return
+   */
+  float getError();
+
+  /**
+   * @brief evaluateMove Returns the error the distribution would have if a tracked Feature were moved to a new
+   * position. Nothing is changed, so several moves may be evaluated at the same time from different threads.
+   * @param feature
+   * @param position
+   * @param doubleCount Whether each distance is counted for both Features, as passed to removeFeature and addFeature
+   * @return
+   */
+  float evaluateMove(int32_t feature, const float position[3], bool doubleCount) const;
+
+  /**
+   * @brief getNormalizedDistribution Returns the distribution normalized by the last call to getError
+   * @return
+   */
+  const std::vector<float>& getNormalizedDistribution() const;
+
+protected:
+  /**
+   * @brief findCell Returns the cell that holds a position
+   * @param position
+   * @return
+   */
+  std::array<int64_t, 3> findCell(const float* position) const;
+
+  /**
+   * @brief addDistances Adds weight to the bins of the distances between a position and the tracked Features of a
+   * phase, skipping one Feature
+   * @param position
+   * @param phase
+   * @param skipFeature
+   * @param weight
+   * @param counts
+   */
+  void addDistances(const float* position, int32_t phase, int32_t skipFeature, double weight, std::vector<double>& counts) const;
+
+  /**
+   * @brief compare Normalizes the counts by the random distribution and returns the Bhattacharyya coefficient with
+   * the target distribution
+   * @param counts
+   * @param normalized Storage for the normalized counts
+   * @return
+   */
+  float compare(const std::vector<double>& counts, std::vector<float>& normalized) const;
+
+private:
+  std::vector<float> m_TargetDist;
+  std::vector<float> m_RandomDist;
+  std::vector<double> m_CurrentDist; // Kept in double so the counts stay exact past 2^24
+  std::vector<float> m_CurrentDistNorm;
+  float m_RdfMin = 0.0f;
+  float m_StepSize = 1.0f;
+
+  std::array<int64_t, 3> m_CellDims = {{1, 1, 1}};
+  std::array<float, 3> m_CellSize = {{1.0f, 1.0f, 1.0f}};
+  std::vector<std::vector<int32_t>> m_Cells;
+  std::vector<int64_t> m_FeatureCell;
+  std::vector<size_t> m_FeatureSlot;
+
+  const float* m_Centroids = nullptr;
+  const int32_t* m_FeaturePhases = nullptr;
+
+public:
+  RadialDistributionTracker(const RadialDistributionTracker&) = delete;            // Copy Constructor Not Implemented
+  RadialDistributionTracker(RadialDistributionTracker&&) = delete;                 // Move Constructor Not Implemented
+  RadialDistributionTracker& operator=(const RadialDistributionTracker&) = delete; // Copy Assignment Not Implemented
+  RadialDistributionTracker& operator=(RadialDistributionTracker&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,225 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TextureComputeService.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/StatsGeneratorUtilities.h"
+
+namespace
+{
+// The first word of a signature says which kind of result it describes
+constexpr uint32_t k_ODFKind = 1;
+constexpr uint32_t k_MDFPlotKind = 2;
+
+// 64 bit FNV-1a over the words of a signature
+uint64_t HashSignature(const std::vector<uint32_t>& signature)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for(uint32_t word : signature)
+  {
+    for(int32_t shift = 0; shift < 32; shift += 8)
+    {
+      hash ^= static_cast<uint64_t>((word >> shift) & 0xFFu);
+      hash *= 1099511628211ULL;
+    }
+  }
+  return hash;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TextureComputeService::TextureComputeService(size_t capacity)
+: m_Capacity(std::max<size_t>(capacity, 1))
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TextureComputeService::~TextureComputeService() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TextureComputeService* TextureComputeService::Instance()
+{
+  static TextureComputeService s_Instance;
+  return &s_Instance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TextureComputeService::AppendValues(const FloatVector& values, Signature& signature)
+{
+  // The bit patterns are compared, and the length separates the vectors so two inputs can not run together
+  signature.push_back(static_cast<uint32_t>(values.size()));
+  size_t offset = signature.size();
+  signature.resize(offset + values.size());
+  if(!values.empty())
+  {
+    std::memcpy(signature.data() + offset, values.data(), values.size() * sizeof(float));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TextureComputeService::AppendODFInput(const ODFInput& input, Signature& signature)
+{
+  signature.push_back(static_cast<uint32_t>(input.crystalStructure));
+  AppendValues(input.e1s, signature);
+  AppendValues(input.e2s, signature);
+  AppendValues(input.e3s, signature);
+  AppendValues(input.weights, signature);
+  AppendValues(input.sigmas, signature);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::shared_ptr<const TextureComputeService::FloatVector> TextureComputeService::odf(const ODFInput& input)
+{
+  Signature signature = {k_ODFKind};
+  AppendODFInput(input, signature);
+
+  ResultPointer result = lookup(std::move(signature), [&input]() -> ResultPointer {
+    ODFInput copy = input;
+    return std::make_shared<const FloatVector>(StatsGeneratorUtilities::GenerateODFData(copy.crystalStructure, copy.e1s, copy.e2s, copy.e3s, copy.weights, copy.sigmas));
+  });
+  return std::static_pointer_cast<const FloatVector>(result);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::shared_ptr<const TextureComputeService::MDFPlotData> TextureComputeService::mdfPlot(const ODFInput& odfInput, const MDFInput& mdfInput, int samples)
+{
+  Signature signature = {k_MDFPlotKind, static_cast<uint32_t>(samples)};
+  AppendODFInput(odfInput, signature);
+  AppendValues(mdfInput.angles, signature);
+  AppendValues(mdfInput.axes, signature);
+  AppendValues(mdfInput.weights, signature);
+
+  ResultPointer result = lookup(std::move(signature), [this, &odfInput, &mdfInput, samples]() -> ResultPointer {
+    std::shared_ptr<const FloatVector> odfData = odf(odfInput);
+    MDFInput copy = mdfInput;
+    std::shared_ptr<MDFPlotData> plot = std::make_shared<MDFPlotData>();
+    plot->error = StatsGeneratorUtilities::GenerateMDFPlotData(odfInput.crystalStructure, *odfData, copy.angles, copy.axes, copy.weights, plot->x, plot->y, samples);
+    return plot;
+  });
+  return std::static_pointer_cast<const MDFPlotData>(result);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TextureComputeService::ResultPointer TextureComputeService::lookup(Signature signature, const std::function<ResultPointer()>& compute)
+{
+  uint64_t hash = HashSignature(signature);
+  std::promise<ResultPointer> promise;
+  std::shared_future<ResultPointer> future;
+  uint64_t id = 0;
+  bool owner = false;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto iter = std::find_if(m_Entries.begin(), m_Entries.end(), [hash, &signature](const Entry& entry) { return entry.hash == hash && entry.signature == signature; });
+    if(iter != m_Entries.end())
+    {
+      // Move the entry to the front so the least recently used entry is always at the back
+      m_Entries.splice(m_Entries.begin(), m_Entries, iter);
+      future = iter->result;
+    }
+    else
+    {
+      owner = true;
+      id = ++m_NextId;
+      future = promise.get_future().share();
+      m_Entries.push_front({id, hash, std::move(signature), future});
+      while(m_Entries.size() > m_Capacity)
+      {
+        m_Entries.pop_back();
+      }
+    }
+  }
+
+  // The computation runs outside of the lock so other results can be looked up while it runs
+  if(owner)
+  {
+    try
+    {
+      promise.set_value(compute());
+    } catch(...)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Entries.remove_if([id](const Entry& entry) { return entry.id == id; });
+      }
+      promise.set_exception(std::current_exception());
+    }
+  }
+  return future.get();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TextureComputeService::clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t TextureComputeService::size() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t TextureComputeService::capacity() const
+{
+  return m_Capacity;
+}
@@ -0,0 +1,171 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "SyntheticBuilding/SyntheticBuildingDLLExport.h"
+
+/**
+ * @brief The TextureComputeService class computes ODF and MDF data for the StatsGenerator and keeps the most
+ * recently used results. Results are keyed on the exact texture components (crystal structure, Euler angles,
+ * weights, sigmas and misorientation entries), so editing the texture in the GUI and generating the same phase
+ * again from a filter reuse one computation. When several threads ask for the same result at once only the first
+ * one computes it and the others wait for that result. All methods are thread safe.
+ */
+class SyntheticBuilding_EXPORT TextureComputeService
+{
+public:
+  using FloatVector = std::vector<float>;
+
+  /**
+   * @brief The ODFInput struct holds the texture components of an ODF. The Euler angles are in radians.
+   */
+  struct ODFInput
+  {
+    unsigned int crystalStructure = 0;
+    FloatVector e1s;
+    FloatVector e2s;
+    FloatVector e3s;
+    FloatVector weights;
+    FloatVector sigmas;
+  };
+
+  /**
+   * @brief The MDFInput struct holds the misorientation entries of an MDF. The angles are in radians and the
+   * axes (3 values per entry) have unit length.
+   */
+  struct MDFInput
+  {
+    FloatVector angles;
+    FloatVector axes;
+    FloatVector weights;
+  };
+
+  /**
+   * @brief The MDFPlotData struct holds the plotted MDF. error is negative if the MDF could not be generated.
+   */
+  struct MDFPlotData
+  {
+    int error = 0;
+    FloatVector x;
+    FloatVector y;
+  };
+
+  explicit TextureComputeService(size_t capacity = 16);
+  virtual ~TextureComputeService();
+
+  /**
+   * @brief Instance Returns the service that is shared by the StatsGenerator filters and widgets
+   * @return
+   */
+  static TextureComputeService* Instance();
+
+  /**
+   * @brief odf Returns the ODF of the texture components, computing it if it is not cached
+   * @param input
+   * @return
+   */
+  std::shared_ptr<const FloatVector> odf(const ODFInput& input);
+
+  /**
+   * @brief mdfPlot Returns the plotted MDF for the misorientation entries on top of the ODF, computing it
+   * (and the ODF) if it is not cached
+   * @param odfInput
+   * @param mdfInput
+   * @param samples Number of random misorientations used for the plot
+   * @return
+   */
+  std::shared_ptr<const MDFPlotData> mdfPlot(const ODFInput& odfInput, const MDFInput& mdfInput, int samples);
+
+  /**
+   * @brief clear Drops every cached result. Computations that are running still finish for their callers.
+   */
+  void clear();
+
+  /**
+   * @brief size Returns the number of cached results
+   * @return
+   */
+  size_t size() const;
+
+  /**
+   * @brief capacity Returns the maximum number of cached results
+   * @return
+   */
+  size_t capacity() const;
+
+private:
+  using Signature = std::vector<uint32_t>;
+  using ResultPointer = std::shared_ptr<const void>;
+
+  struct Entry
+  {
+    uint64_t id = 0;
+    uint64_t hash = 0;
+    Signature signature;
+    std::shared_future<ResultPointer> result;
+  };
+
+  /**
+   * @brief lookup Returns the cached result with the signature, or runs compute and caches its result
+   * @param signature
+   * @param compute
+   * @return
+   */
+  ResultPointer lookup(Signature signature, const std::function<ResultPointer()>& compute);
+
+  static void AppendODFInput(const ODFInput& input, Signature& signature);
+  static void AppendValues(const FloatVector& values, Signature& signature);
+
+  size_t m_Capacity = 16;
+  uint64_t m_NextId = 0;
+  mutable std::mutex m_Mutex;
+  std::list<Entry> m_Entries;
+
+public:
+  TextureComputeService(const TextureComputeService&) = delete;            // Copy Constructor Not Implemented
+  TextureComputeService(TextureComputeService&&) = delete;                 // Move Constructor Not Implemented
+  TextureComputeService& operator=(const TextureComputeService&) = delete; // Copy Assignment Not Implemented
+  TextureComputeService& operator=(TextureComputeService&&) = delete;      // Move Assignment Not Implemented
+};
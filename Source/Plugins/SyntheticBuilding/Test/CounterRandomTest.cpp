@@ -0,0 +1,106 @@
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/CounterRandom.h"
+
+class CounterRandomTest
+{
+public:
+  CounterRandomTest() = default;
+  ~CounterRandomTest() = default;
+
+  // -----------------------------------------------------------------------------
+  int TestKnownAnswers()
+  {
+    // Known answer vectors of the Philox4x32-10 reference implementation
+    CounterRandom zero(0);
+    CounterRandom::Block block = zero.generate(0, 0);
+    DREAM3D_REQUIRE_EQUAL(block[0], 0x6627e8d5U)
+    DREAM3D_REQUIRE_EQUAL(block[1], 0xe169c58dU)
+    DREAM3D_REQUIRE_EQUAL(block[2], 0xbc57ac4cU)
+    DREAM3D_REQUIRE_EQUAL(block[3], 0x9b00dbd8U)
+
+    CounterRandom ones(0xffffffffffffffffULL);
+    block = ones.generate(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    DREAM3D_REQUIRE_EQUAL(block[0], 0x408f276dU)
+    DREAM3D_REQUIRE_EQUAL(block[1], 0x41c83b0eU)
+    DREAM3D_REQUIRE_EQUAL(block[2], 0xa20bc7c6U)
+    DREAM3D_REQUIRE_EQUAL(block[3], 0x6d5451fdU)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestOrderIndependence()
+  {
+    const size_t count = 10000;
+    CounterRandom random(12345);
+    std::vector<double> forward(count);
+    for(size_t i = 0; i < count; i++)
+    {
+      forward[i] = random.uniform(i, 7);
+    }
+    CounterRandom other(12345);
+    for(size_t i = count; i > 0; i--)
+    {
+      DREAM3D_REQUIRE_EQUAL(other.uniform(i - 1, 7), forward[i - 1])
+    }
+
+    // A different stream or seed gives different numbers
+    size_t sameStream = 0;
+    size_t sameSeed = 0;
+    CounterRandom seeded(12346);
+    for(size_t i = 0; i < count; i++)
+    {
+      sameStream += (random.uniform(i, 8) == forward[i]) ? 1 : 0;
+      sameSeed += (seeded.uniform(i, 7) == forward[i]) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE(sameStream == 0)
+    DREAM3D_REQUIRE(sameSeed == 0)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestUniformity()
+  {
+    const size_t count = 1000000;
+    const size_t numBins = 10;
+    std::array<size_t, 10> bins = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    CounterRandom random(2020);
+    for(size_t i = 0; i < count; i++)
+    {
+      std::array<double, 2> values = random.uniformPair(i, 0);
+      for(double value : values)
+      {
+        DREAM3D_REQUIRE(value >= 0.0 && value < 1.0)
+        bins[static_cast<size_t>(value * numBins)]++;
+      }
+    }
+    double expected = 2.0 * count / numBins;
+    for(size_t bin : bins)
+    {
+      DREAM3D_REQUIRE(bin > 0.99 * expected && bin < 1.01 * expected)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "########### CounterRandomTest ##############" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestKnownAnswers())
+    DREAM3D_REGISTER_TEST(TestOrderIndependence())
+    DREAM3D_REGISTER_TEST(TestUniformity())
+  }
+
+public:
+  CounterRandomTest(const CounterRandomTest&) = delete;            // Copy Constructor Not Implemented
+  CounterRandomTest(CounterRandomTest&&) = delete;                 // Move Constructor Not Implemented
+  CounterRandomTest& operator=(const CounterRandomTest&) = delete; // Copy Assignment Not Implemented
+  CounterRandomTest& operator=(CounterRandomTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DynamicListArray.hpp"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/Math/GeometryMath.h"
+#include "SIMPLib/Math/MatrixMath.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/FeatureLatticeFill.h"
+
+class FeatureLatticeFillTest
+{
+public:
+  FeatureLatticeFillTest() = default;
+  ~FeatureLatticeFillTest() = default;
+
+  using LatticeKey = std::array<int64_t, 3>;
+
+  // -----------------------------------------------------------------------------
+  // A cube with the given side and its lower corner at the origin. Every face is split along the diagonal from
+  // its first to its third corner, so on the faces normal to x the diagonal is the line y = z.
+  // -----------------------------------------------------------------------------
+  void createCube(float side, std::vector<float>& vertices, std::vector<MeshIndexType>& triangles)
+  {
+    vertices.clear();
+    for(size_t c = 0; c < 8; c++)
+    {
+      vertices.push_back((c & 1) != 0 ? side : 0.0f);
+      vertices.push_back((c & 2) != 0 ? side : 0.0f);
+      vertices.push_back((c & 4) != 0 ? side : 0.0f);
+    }
+    triangles.clear();
+    const size_t uw[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      size_t u = (axis + 1) % 3;
+      size_t w = (axis + 2) % 3;
+      for(size_t side01 = 0; side01 < 2; side01++)
+      {
+        MeshIndexType corners[4] = {0, 0, 0, 0};
+        for(size_t c = 0; c < 4; c++)
+        {
+          corners[c] = (side01 << axis) | (uw[c][0] << u) | (uw[c][1] << w);
+        }
+        const size_t split[2][3] = {{0, 1, 2}, {0, 2, 3}};
+        for(const auto& tri : split)
+        {
+          triangles.push_back(corners[tri[0]]);
+          triangles.push_back(corners[tri[1]]);
+          triangles.push_back(corners[tri[2]]);
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The corner tetrahedron of the cube with the given side
+  // -----------------------------------------------------------------------------
+  void createTetrahedron(float side, std::vector<float>& vertices, std::vector<MeshIndexType>& triangles)
+  {
+    vertices = {0.0f, 0.0f, 0.0f, side, 0.0f, 0.0f, 0.0f, side, 0.0f, 0.0f, 0.0f, side};
+    triangles = {0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3};
+  }
+
+  // -----------------------------------------------------------------------------
+  // Rotation by angle about the normalized axis
+  // -----------------------------------------------------------------------------
+  void createRotation(float x, float y, float z, float angle, float g[3][3])
+  {
+    float length = std::sqrt(x * x + y * y + z * z);
+    float n[3] = {x / length, y / length, z / length};
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    for(size_t r = 0; r < 3; r++)
+    {
+      for(size_t k = 0; k < 3; k++)
+      {
+        g[r][k] = (1.0f - c) * n[r] * n[k] + (r == k ? c : 0.0f);
+      }
+    }
+    g[0][1] -= s * n[2];
+    g[0][2] += s * n[1];
+    g[1][0] += s * n[2];
+    g[1][2] -= s * n[0];
+    g[2][0] -= s * n[1];
+    g[2][1] += s * n[0];
+  }
+
+  // -----------------------------------------------------------------------------
+  // Offsets of the atoms of each basis from their lattice point, in quarters of the lattice constants
+  // -----------------------------------------------------------------------------
+  std::vector<LatticeKey> basisOffsets(uint32_t basis)
+  {
+    switch(basis)
+    {
+    case 1:
+      return {{0, 0, 0}, {2, 2, 2}};
+    case 2:
+      return {{0, 0, 0}, {2, 2, 0}, {2, 0, 2}, {0, 2, 2}};
+    case 3:
+      return {{0, 0, 0}, {2, 2, 0}, {2, 0, 2}, {0, 2, 2}, {1, 1, 1}, {3, 3, 1}, {3, 1, 3}, {1, 3, 3}};
+    default:
+      return {{0, 0, 0}};
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Fills the triangles with atoms and checks them against GeometryMath::PointInPolyhedron on every position of
+  // the lattice around the triangles. Positions that are inside must have an atom and positions that are outside
+  // must not. Positions on the surface may go either way.
+  // -----------------------------------------------------------------------------
+  int compareWithPointInPolyhedron(const std::vector<float>& meshVertices, const std::vector<MeshIndexType>& meshTriangles, float g[3][3], const float latticeConstants[3], uint32_t basis,
+                                   std::set<LatticeKey>& keys)
+  {
+    size_t numVertices = meshVertices.size() / 3;
+    size_t numFaces = meshTriangles.size() / 3;
+
+    SharedVertexList::Pointer vertexList = TriangleGeom::CreateSharedVertexList(numVertices);
+    TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numFaces, vertexList, SIMPL::Geometry::TriangleGeometry);
+    float* vertices = triangleGeom->getVertexPointer(0);
+    MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+    std::copy(meshVertices.begin(), meshVertices.end(), vertices);
+    std::copy(meshTriangles.begin(), meshTriangles.end(), triangles);
+
+    // The bounding boxes and the face list that PointInPolyhedron needs, set up as InsertAtoms used to
+    float ll[3] = {0.0f, 0.0f, 0.0f};
+    float ur[3] = {0.0f, 0.0f, 0.0f};
+    VertexGeom::Pointer faceBBs = VertexGeom::CreateGeometry(2 * numFaces, "faceBBs");
+    Int32Int32DynamicListArray::Pointer faceLists = Int32Int32DynamicListArray::New();
+    QVector<int32_t> linkCount(1, static_cast<int32_t>(numFaces));
+    faceLists->allocateLists(linkCount);
+    for(size_t i = 0; i < numFaces; i++)
+    {
+      faceLists->insertCellReference(0, i, i);
+      GeometryMath::FindBoundingBoxOfFace(triangleGeom.get(), i, ll, ur);
+      faceBBs->setCoords(2 * i, ll);
+      faceBBs->setCoords(2 * i + 1, ur);
+    }
+    Int32Int32DynamicListArray::ElementList& faceIds = faceLists->getElementList(0);
+    float radius = 0.0f;
+    GeometryMath::FindBoundingBoxOfFaces(triangleGeom.get(), faceIds, ll, ur);
+    GeometryMath::FindDistanceBetweenPoints(ll, ur, radius);
+
+    std::vector<int64_t> faces(numFaces);
+    for(size_t i = 0; i < numFaces; i++)
+    {
+      faces[i] = static_cast<int64_t>(i);
+    }
+    std::vector<float> atoms;
+    FeatureLatticeFill::FillFeature(triangles, vertices, faces.data(), numFaces, g, latticeConstants, basis, atoms);
+    DREAM3D_REQUIRE(!atoms.empty())
+
+    // The lattice starts at the lower corner of the bounding box of the rotated triangles
+    float llRot[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float urRot[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for(size_t v = 0; v < numVertices; v++)
+    {
+      float rot[3] = {0.0f, 0.0f, 0.0f};
+      MatrixMath::Multiply3x3with3x1(g, vertices + 3 * v, rot);
+      for(size_t d = 0; d < 3; d++)
+      {
+        llRot[d] = std::min(llRot[d], rot[d]);
+        urRot[d] = std::max(urRot[d], rot[d]);
+      }
+    }
+
+    // Every atom must sit on a position of the basis and appear only once
+    std::vector<LatticeKey> offsets = basisOffsets(basis);
+    keys.clear();
+    for(size_t n = 0; n < atoms.size() / 3; n++)
+    {
+      float crystal[3] = {0.0f, 0.0f, 0.0f};
+      MatrixMath::Multiply3x3with3x1(g, atoms.data() + 3 * n, crystal);
+      LatticeKey key = {0, 0, 0};
+      for(size_t d = 0; d < 3; d++)
+      {
+        double quarters = 4.0 * (crystal[d] - llRot[d]) / latticeConstants[d];
+        key[d] = static_cast<int64_t>(std::llround(quarters));
+        DREAM3D_REQUIRE(std::fabs(quarters - static_cast<double>(key[d])) < 0.01)
+      }
+      LatticeKey offset = {((key[0] % 4) + 4) % 4, ((key[1] % 4) + 4) % 4, ((key[2] % 4) + 4) % 4};
+      DREAM3D_REQUIRE(std::find(offsets.begin(), offsets.end(), offset) != offsets.end())
+      DREAM3D_REQUIRE(keys.insert(key).second)
+    }
+
+    float gT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    MatrixMath::Transpose3x3(g, gT);
+    int64_t numPoints[3] = {0, 0, 0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      numPoints[d] = static_cast<int64_t>((urRot[d] - llRot[d]) / latticeConstants[d]) + 1;
+    }
+    size_t inside = 0;
+    for(int64_t k = -1; k <= numPoints[2]; k++)
+    {
+      for(int64_t j = -1; j <= numPoints[1]; j++)
+      {
+        for(int64_t i = -1; i <= numPoints[0]; i++)
+        {
+          for(const LatticeKey& offset : offsets)
+          {
+            LatticeKey key = {4 * i + offset[0], 4 * j + offset[1], 4 * k + offset[2]};
+            float crystal[3] = {0.0f, 0.0f, 0.0f};
+            for(size_t d = 0; d < 3; d++)
+            {
+              crystal[d] = llRot[d] + static_cast<float>(key[d]) * 0.25f * latticeConstants[d];
+            }
+            float point[3] = {0.0f, 0.0f, 0.0f};
+            MatrixMath::Multiply3x3with3x1(gT, crystal, point);
+            char code = GeometryMath::PointInPolyhedron(triangleGeom.get(), faceIds, faceBBs.get(), point, ll, ur, radius);
+            if(code == 'i')
+            {
+              DREAM3D_REQUIRE(keys.find(key) != keys.end())
+              inside++;
+            }
+            else if(code == 'o')
+            {
+              DREAM3D_REQUIRE(keys.find(key) == keys.end())
+            }
+          }
+        }
+      }
+    }
+    DREAM3D_REQUIRE(inside > 0)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLatticeTypes()
+  {
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> triangles;
+    const float latticeConstants[3] = {0.13f, 0.17f, 0.19f};
+    float identity[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    float rotation[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    createRotation(1.0f, 2.0f, 3.0f, 0.7f, rotation);
+
+    std::set<LatticeKey> keys;
+    for(uint32_t basis = 0; basis < 4; basis++)
+    {
+      DREAM3D_REQUIRE_EQUAL(FeatureLatticeFill::AtomsPerLatticePoint(basis), basisOffsets(basis).size())
+
+      createCube(2.0f, vertices, triangles);
+      DREAM3D_REQUIRE_EQUAL(compareWithPointInPolyhedron(vertices, triangles, identity, latticeConstants, basis, keys), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(compareWithPointInPolyhedron(vertices, triangles, rotation, latticeConstants, basis, keys), EXIT_SUCCESS)
+
+      createTetrahedron(2.0f, vertices, triangles);
+      DREAM3D_REQUIRE_EQUAL(compareWithPointInPolyhedron(vertices, triangles, identity, latticeConstants, basis, keys), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(compareWithPointInPolyhedron(vertices, triangles, rotation, latticeConstants, basis, keys), EXIT_SUCCESS)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // With equal lattice constants along y and z, the rows j == k run exactly along the shared diagonal edges of the
+  // two cube faces normal to x. Each of those rows must be entered and left once, so it holds every atom in [0, 2].
+  // -----------------------------------------------------------------------------
+  int TestRowsThroughSharedEdges()
+  {
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> triangles;
+    createCube(2.0f, vertices, triangles);
+    const float latticeConstants[3] = {0.13f, 0.25f, 0.25f};
+    float identity[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+
+    std::set<LatticeKey> keys;
+    DREAM3D_REQUIRE_EQUAL(compareWithPointInPolyhedron(vertices, triangles, identity, latticeConstants, 0, keys), EXIT_SUCCESS)
+
+    for(int64_t j = 1; j < 8; j++)
+    {
+      size_t rowAtoms = 0;
+      for(const LatticeKey& key : keys)
+      {
+        rowAtoms += (key[1] == 4 * j && key[2] == 4 * j) ? 1 : 0;
+      }
+      DREAM3D_REQUIRE_EQUAL(rowAtoms, 16)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "########### FeatureLatticeFillTest ##############" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestLatticeTypes())
+    DREAM3D_REGISTER_TEST(TestRowsThroughSharedEdges())
+  }
+
+public:
+  FeatureLatticeFillTest(const FeatureLatticeFillTest&) = delete;            // Copy Constructor Not Implemented
+  FeatureLatticeFillTest(FeatureLatticeFillTest&&) = delete;                 // Move Constructor Not Implemented
+  FeatureLatticeFillTest& operator=(const FeatureLatticeFillTest&) = delete; // Copy Assignment Not Implemented
+  FeatureLatticeFillTest& operator=(FeatureLatticeFillTest&&) = delete;      // Move Assignment Not Implemented
+};
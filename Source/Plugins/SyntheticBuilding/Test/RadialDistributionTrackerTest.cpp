@@ -0,0 +1,96 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/RadialDistributionTracker.h"
+
+class RadialDistributionTrackerTest
+{
+public:
+  RadialDistributionTrackerTest() = default;
+  ~RadialDistributionTrackerTest() = default;
+
+  const int32_t k_NumFeatures = 401;
+  const size_t k_NumBins = 20;
+  const std::array<float, 3> k_BoxDims = {{100.0f, 80.0f, 60.0f}};
+
+  // -----------------------------------------------------------------------------
+  // Moving a Feature must give the error that removing it, moving its centroid and adding it again gives
+  // -----------------------------------------------------------------------------
+  int TestEvaluateMove(bool doubleCount)
+  {
+    std::mt19937_64 generator(5489);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // Feature 0 is not a precipitate, the others alternate between two phases
+    std::vector<float> centroids(static_cast<size_t>(k_NumFeatures) * 3, 0.0f);
+    std::vector<int32_t> featurePhases(static_cast<size_t>(k_NumFeatures), 0);
+    for(int32_t feature = 1; feature < k_NumFeatures; feature++)
+    {
+      for(size_t i = 0; i < 3; i++)
+      {
+        centroids[feature * 3 + i] = unit(generator) * k_BoxDims[i];
+      }
+      featurePhases[feature] = 1 + feature % 2;
+    }
+
+    std::vector<float> targetDist(k_NumBins);
+    std::vector<float> randomDist(k_NumBins);
+    for(size_t i = 0; i < k_NumBins; i++)
+    {
+      targetDist[i] = 1.0f + 0.5f * std::sin(static_cast<float>(i));
+      randomDist[i] = 1.0f + static_cast<float>(i * i);
+    }
+
+    RadialDistributionTracker tracker;
+    tracker.initialize(targetDist, randomDist, 2.0f, 1.5f, k_NumBins, k_BoxDims, static_cast<size_t>(k_NumFeatures));
+    tracker.setFeatureData(centroids.data(), featurePhases.data());
+    for(int32_t feature = 1; feature < k_NumFeatures; feature++)
+    {
+      tracker.addFeature(feature, doubleCount);
+    }
+
+    std::uniform_int_distribution<int32_t> featureDistribution(1, k_NumFeatures - 1);
+    for(size_t move = 0; move < 200; move++)
+    {
+      int32_t feature = featureDistribution(generator);
+      float position[3] = {unit(generator) * k_BoxDims[0], unit(generator) * k_BoxDims[1], unit(generator) * k_BoxDims[2]};
+
+      float before = tracker.getError();
+      float evaluated = tracker.evaluateMove(feature, position, doubleCount);
+      DREAM3D_REQUIRE_EQUAL(tracker.getError(), before)
+
+      tracker.removeFeature(feature, doubleCount);
+      for(size_t i = 0; i < 3; i++)
+      {
+        centroids[feature * 3 + i] = position[i];
+      }
+      tracker.addFeature(feature, doubleCount);
+      DREAM3D_REQUIRE(std::fabs(tracker.getError() - evaluated) < 1.0e-6f)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "########### RadialDistributionTrackerTest ##############" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestEvaluateMove(true))
+    DREAM3D_REGISTER_TEST(TestEvaluateMove(false))
+  }
+
+public:
+  RadialDistributionTrackerTest(const RadialDistributionTrackerTest&) = delete;            // Copy Constructor Not Implemented
+  RadialDistributionTrackerTest(RadialDistributionTrackerTest&&) = delete;                 // Move Constructor Not Implemented
+  RadialDistributionTrackerTest& operator=(const RadialDistributionTrackerTest&) = delete; // Copy Assignment Not Implemented
+  RadialDistributionTrackerTest& operator=(RadialDistributionTrackerTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,136 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/StatsGeneratorUtilities.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/TextureComputeService.h"
+
+class TextureComputeServiceTest
+{
+public:
+  TextureComputeServiceTest() = default;
+  ~TextureComputeServiceTest() = default;
+
+  // -----------------------------------------------------------------------------
+  TextureComputeService::ODFInput createODFInput(float euler1)
+  {
+    TextureComputeService::ODFInput input;
+    input.crystalStructure = EbsdLib::CrystalStructure::Cubic_High;
+    input.e1s = {euler1, 0.5f};
+    input.e2s = {0.25f, 0.75f};
+    input.e3s = {0.0f, 1.0f};
+    input.weights = {500000.0f, 250000.0f};
+    input.sigmas = {1.0f, 2.0f};
+    return input;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestCachedODF()
+  {
+    TextureComputeService service(4);
+    TextureComputeService::ODFInput input = createODFInput(0.1f);
+
+    std::shared_ptr<const std::vector<float>> first = service.odf(input);
+    std::shared_ptr<const std::vector<float>> second = service.odf(input);
+    DREAM3D_REQUIRE(first.get() == second.get())
+    DREAM3D_REQUIRE_EQUAL(service.size(), 1)
+
+    // The cached ODF is the one the utilities compute directly
+    TextureComputeService::ODFInput copy = input;
+    std::vector<float> expected = StatsGeneratorUtilities::GenerateODFData(copy.crystalStructure, copy.e1s, copy.e2s, copy.e3s, copy.weights, copy.sigmas);
+    DREAM3D_REQUIRE(*first == expected)
+
+    // Any change of the texture components gives a new result
+    std::shared_ptr<const std::vector<float>> other = service.odf(createODFInput(0.2f));
+    DREAM3D_REQUIRE(other.get() != first.get())
+    input.crystalStructure = EbsdLib::CrystalStructure::Hexagonal_High;
+    std::shared_ptr<const std::vector<float>> hexagonal = service.odf(input);
+    DREAM3D_REQUIRE(hexagonal.get() != first.get())
+    DREAM3D_REQUIRE_EQUAL(service.size(), 3)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestEviction()
+  {
+    TextureComputeService service(2);
+    std::shared_ptr<const std::vector<float>> first = service.odf(createODFInput(0.1f));
+    service.odf(createODFInput(0.2f));
+    // Using the first result again makes the second one the least recently used
+    DREAM3D_REQUIRE(service.odf(createODFInput(0.1f)).get() == first.get())
+    service.odf(createODFInput(0.3f));
+    DREAM3D_REQUIRE_EQUAL(service.size(), 2)
+    DREAM3D_REQUIRE(service.odf(createODFInput(0.1f)).get() == first.get())
+
+    service.clear();
+    DREAM3D_REQUIRE_EQUAL(service.size(), 0)
+    DREAM3D_REQUIRE(service.odf(createODFInput(0.1f)).get() != first.get())
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestConcurrentRequests()
+  {
+    TextureComputeService service(4);
+    TextureComputeService::ODFInput input = createODFInput(0.1f);
+    const size_t numThreads = 8;
+    std::vector<std::shared_ptr<const std::vector<float>>> results(numThreads);
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < numThreads; i++)
+    {
+      threads.emplace_back([&service, &input, &results, i]() { results[i] = service.odf(input); });
+    }
+    for(auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    // Every thread gets the one result that was computed
+    for(const auto& result : results)
+    {
+      DREAM3D_REQUIRE(result.get() == results[0].get())
+    }
+    DREAM3D_REQUIRE_EQUAL(service.size(), 1)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMDFPlot()
+  {
+    TextureComputeService service(4);
+    TextureComputeService::ODFInput odfInput = createODFInput(0.1f);
+    TextureComputeService::MDFInput mdfInput;
+
+    std::shared_ptr<const TextureComputeService::MDFPlotData> plot = service.mdfPlot(odfInput, mdfInput, 1000);
+    DREAM3D_REQUIRE_EQUAL(plot->error, 0)
+    DREAM3D_REQUIRE_EQUAL(plot->x.size(), plot->y.size())
+    DREAM3D_REQUIRE(service.mdfPlot(odfInput, mdfInput, 1000).get() == plot.get())
+
+    // The plot cached its ODF as well
+    DREAM3D_REQUIRE_EQUAL(service.size(), 2)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "########### TextureComputeServiceTest ##############" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestCachedODF())
+    DREAM3D_REGISTER_TEST(TestEviction())
+    DREAM3D_REGISTER_TEST(TestConcurrentRequests())
+    DREAM3D_REGISTER_TEST(TestMDFPlot())
+  }
+
+public:
+  TextureComputeServiceTest(const TextureComputeServiceTest&) = delete;            // Copy Constructor Not Implemented
+  TextureComputeServiceTest(TextureComputeServiceTest&&) = delete;                 // Move Constructor Not Implemented
+  TextureComputeServiceTest& operator=(const TextureComputeServiceTest&) = delete; // Copy Assignment Not Implemented
+  TextureComputeServiceTest& operator=(TextureComputeServiceTest&&) = delete;      // Move Assignment Not Implemented
+};
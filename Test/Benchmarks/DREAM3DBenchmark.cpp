@@ -0,0 +1,632 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include "SyntheticMicrostructure.h"
+
+namespace
+{
+const QString k_CellFeatureData = SIMPL::Defaults::CellFeatureAttributeMatrixName;
+const QString k_CellEnsembleData = SIMPL::Defaults::CellEnsembleAttributeMatrixName;
+
+/**
+ * @brief One filter of the benchmark pipeline. Helper steps produce arrays that a later timed filter needs and
+ * are never timed themselves.
+ */
+struct BenchmarkStep
+{
+  QString filterName;
+  bool timed = false;
+  std::function<void(AbstractFilter*)> configure;
+  // Number of input elements the timed filter works on and their unit, used for the throughput
+  std::function<size_t(const DataContainerArray::Pointer&)> workItems;
+  QString workUnit;
+};
+
+/**
+ * @brief The synthetic volume of one size. It is generated once and copied into a fresh DataContainerArray for
+ * every run so that no run sees the output of an earlier one.
+ */
+struct SyntheticVolume
+{
+  std::array<size_t, 3> dims = {0, 0, 0};
+  size_t numFeatures = 0;
+  std::vector<int32_t> featureIds;
+  std::vector<float> featureQuats;
+};
+
+// -----------------------------------------------------------------------------
+DataArrayPath ImagePath(const QString& attributeMatrix = QString(), const QString& array = QString())
+{
+  return DataArrayPath(SIMPL::Defaults::ImageDataContainerName, attributeMatrix, array);
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath TrianglePath(const QString& attributeMatrix = QString(), const QString& array = QString())
+{
+  return DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, attributeMatrix, array);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void SetProperty(AbstractFilter* filter, const char* name, const T& value)
+{
+  QVariant var;
+  var.setValue(value);
+  if(!filter->setProperty(name, var))
+  {
+    std::cerr << "Unable to set property " << name << " of " << filter->getNameOfClass().toStdString() << std::endl;
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t NumberOfCells(const DataContainerArray::Pointer& dca)
+{
+  return dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getGeometryAs<ImageGeom>()->getNumberOfElements();
+}
+
+// -----------------------------------------------------------------------------
+size_t NumberOfTriangles(const DataContainerArray::Pointer& dca)
+{
+  DataContainer::Pointer dc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+  if(nullptr == dc.get() || nullptr == dc->getGeometryAs<TriangleGeom>().get())
+  {
+    return 0;
+  }
+  return dc->getGeometryAs<TriangleGeom>()->getNumberOfTris();
+}
+
+// -----------------------------------------------------------------------------
+size_t NumberOfFeatures(const DataContainerArray::Pointer& dca)
+{
+  AttributeMatrix::Pointer am = dca->getAttributeMatrix(ImagePath(k_CellFeatureData));
+  if(nullptr == am.get() || am->getNumberOfTuples() == 0)
+  {
+    return 0;
+  }
+  return am->getNumberOfTuples() - 1;
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Resets the peak resident set size of the process so the next reading only covers the work done after
+ * the reset. This is only possible on Linux.
+ * @return Whether the peak was reset
+ */
+bool ResetPeakResidentSetSize()
+{
+#if defined(__linux__)
+  QFile clearRefs("/proc/self/clear_refs");
+  if(!clearRefs.open(QIODevice::WriteOnly))
+  {
+    return false;
+  }
+  return clearRefs.write("5") == 1;
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Returns the peak resident set size of the process in bytes, or 0 if it can not be read.
+ */
+size_t PeakResidentSetSize()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+  {
+    return 0;
+  }
+  return static_cast<size_t>(counters.PeakWorkingSetSize);
+#elif defined(__linux__)
+  // VmHWM follows resets through clear_refs, ru_maxrss does not
+  QFile status("/proc/self/status");
+  if(status.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    QTextStream in(&status);
+    QString line = in.readLine();
+    while(!line.isNull())
+    {
+      if(line.startsWith("VmHWM:"))
+      {
+        return line.mid(6).remove("kB").trimmed().toULongLong() * 1024;
+      }
+      line = in.readLine();
+    }
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#else
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  // macOS reports bytes
+  return static_cast<size_t>(usage.ru_maxrss);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+SyntheticVolume GenerateVolume(size_t size, size_t cellsPerFeature, uint64_t seed)
+{
+  SyntheticVolume volume;
+  volume.dims = {size, size, size};
+  const size_t totalCells = size * size * size;
+  volume.numFeatures = std::max<size_t>(1, totalCells / std::max<size_t>(1, cellsPerFeature));
+  volume.featureIds = SyntheticMicrostructure::GenerateVoronoiFeatureIds(volume.dims, volume.numFeatures, seed);
+  // Feature 0 is never used by the Voronoi labels but keeps the quaternions indexed by feature id
+  volume.featureQuats = SyntheticMicrostructure::GenerateRandomQuaternions(volume.numFeatures + 1, seed + 1);
+  return volume;
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Builds the input of the pipeline: an Image geometry whose cells carry the orientation of the Voronoi
+ * feature they belong to, a single cubic phase and no feature ids. The feature ids are recovered by the
+ * segmentation, which is the first timed filter.
+ */
+DataContainerArray::Pointer CreateDataContainerArray(const SyntheticVolume& volume)
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+  dca->addOrReplaceDataContainer(dc);
+
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+  size_t dims[3] = {volume.dims[0], volume.dims[1], volume.dims[2]};
+  image->setDimensions(dims);
+  dc->setGeometry(image);
+
+  const size_t totalCells = volume.featureIds.size();
+  std::vector<size_t> tDims = {volume.dims[0], volume.dims[1], volume.dims[2]};
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+  dc->addOrReplaceAttributeMatrix(cellAttrMat);
+
+  FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalCells, std::vector<size_t>(1, 4), SIMPL::CellData::Quats, true);
+  SyntheticMicrostructure::FillCellQuaternions(volume.featureIds, volume.featureQuats, quats->getPointer(0));
+  cellAttrMat->insertOrAssign(quats);
+
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalCells, SIMPL::CellData::Phases, true);
+  phases->initializeWithValue(1);
+  cellAttrMat->insertOrAssign(phases);
+
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(std::vector<size_t>(1, 2), k_CellEnsembleData, AttributeMatrix::Type::CellEnsemble);
+  dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+  UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, SIMPL::EnsembleData::CrystalStructures, true);
+  crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+  ensembleAttrMat->insertOrAssign(crystalStructures);
+
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Creates the benchmark pipeline. It runs the timed filters in the order a reconstruction would:
+ * segmentation, clean up, feature statistics, meshing, smoothing and finally the GBCD of the smoothed mesh.
+ */
+std::vector<BenchmarkStep> CreatePipeline(int minimumFeatureSize, int smoothingIterations)
+{
+  const QString featureIds = SIMPL::CellData::FeatureIds;
+  const QString numElements = SIMPL::FeatureData::NumElements;
+  std::vector<BenchmarkStep> steps;
+
+  steps.push_back({"EBSDSegmentFeatures", true,
+                   [](AbstractFilter* filter) {
+                     SetProperty(filter, "CellFeatureAttributeMatrixName", k_CellFeatureData);
+                     SetProperty(filter, "MisorientationTolerance", 5.0f);
+                     SetProperty(filter, "UseGoodVoxels", false);
+                     SetProperty(filter, "CellPhasesArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases));
+                     SetProperty(filter, "CrystalStructuresArrayPath", ImagePath(k_CellEnsembleData, SIMPL::EnsembleData::CrystalStructures));
+                     SetProperty(filter, "QuatsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats));
+                     SetProperty(filter, "FeatureIdsArrayName", featureIds);
+                   },
+                   NumberOfCells, "cells"});
+
+  steps.push_back({"FindFeaturePhases", false, [featureIds](AbstractFilter* filter) {
+                     SetProperty(filter, "FeatureIdsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, featureIds));
+                     SetProperty(filter, "CellPhasesArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases));
+                     SetProperty(filter, "FeaturePhasesArrayPath", ImagePath(k_CellFeatureData, SIMPL::FeatureData::Phases));
+                   }});
+
+  // FindShapes creates a Volumes array of its own
+  steps.push_back({"FindSizes", false, [featureIds, numElements](AbstractFilter* filter) {
+                     SetProperty(filter, "FeatureAttributeMatrixName", ImagePath(k_CellFeatureData));
+                     SetProperty(filter, "FeatureIdsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, featureIds));
+                     SetProperty(filter, "VolumesArrayName", QString("SizeVolumes"));
+                     SetProperty(filter, "NumElementsArrayName", numElements);
+                   }});
+
+  steps.push_back({"MinSize", true,
+                   [featureIds, numElements, minimumFeatureSize](AbstractFilter* filter) {
+                     SetProperty(filter, "MinAllowedFeatureSize", minimumFeatureSize);
+                     SetProperty(filter, "ApplyToSinglePhase", false);
+                     SetProperty(filter, "FeatureIdsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, featureIds));
+                     SetProperty(filter, "FeaturePhasesArrayPath", ImagePath(k_CellFeatureData, SIMPL::FeatureData::Phases));
+                     SetProperty(filter, "NumCellsArrayPath", ImagePath(k_CellFeatureData, numElements));
+                   },
+                   NumberOfCells, "cells"});
+
+  steps.push_back({"FindNeighbors", true,
+                   [featureIds](AbstractFilter* filter) {
+                     SetProperty(filter, "CellFeatureAttributeMatrixPath", ImagePath(k_CellFeatureData));
+                     SetProperty(filter, "FeatureIdsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, featureIds));
+                     SetProperty(filter, "StoreBoundaryCells", false);
+                     SetProperty(filter, "StoreSurfaceFeatures", false);
+                   },
+                   NumberOfCells, "cells"});
+
+  steps.push_back({"FindFeatureCentroids", false, [featureIds](AbstractFilter* filter) {
+                     SetProperty(filter, "FeatureIdsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, featureIds));
+                     SetProperty(filter, "CentroidsArrayPath", ImagePath(k_CellFeatureData, SIMPL::FeatureData::Centroids));
+                   }});
+
+  steps.push_back({"FindShapes", true,
+                   [featureIds](AbstractFilter* filter) {
+                     SetProperty(filter, "CellFeatureAttributeMatrixName", ImagePath(k_CellFeatureData));
+                     SetProperty(filter, "FeatureIdsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, featureIds));
+                     SetProperty(filter, "CentroidsArrayPath", ImagePath(k_CellFeatureData, SIMPL::FeatureData::Centroids));
+                   },
+                   NumberOfCells, "cells"});
+
+  steps.push_back({"QuickSurfaceMesh", true,
+                   [featureIds](AbstractFilter* filter) {
+                     SetProperty(filter, "SelectedDataArrayPaths", std::vector<DataArrayPath>());
+                     SetProperty(filter, "SurfaceDataContainerName", TrianglePath());
+                     SetProperty(filter, "FeatureIdsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, featureIds));
+                     SetProperty(filter, "FixProblemVoxels", false);
+                   },
+                   NumberOfCells, "cells"});
+
+  steps.push_back({"LaplacianSmoothing", true,
+                   [smoothingIterations](AbstractFilter* filter) {
+                     SetProperty(filter, "SurfaceDataContainerName", TrianglePath());
+                     SetProperty(filter, "SurfaceMeshNodeTypeArrayPath", TrianglePath(SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType));
+                     SetProperty(filter, "SurfaceMeshFaceLabelsArrayPath", TrianglePath(SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+                     SetProperty(filter, "IterationSteps", smoothingIterations);
+                     SetProperty(filter, "Lambda", 0.25f);
+                   },
+                   NumberOfTriangles, "triangles"});
+
+  steps.push_back({"TriangleNormalFilter", false, [](AbstractFilter* filter) {
+                     SetProperty(filter, "SurfaceMeshTriangleNormalsArrayPath", TrianglePath(SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceNormals));
+                   }});
+
+  steps.push_back({"TriangleAreaFilter", false, [](AbstractFilter* filter) {
+                     SetProperty(filter, "SurfaceMeshTriangleAreasArrayPath", TrianglePath(SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceAreas));
+                   }});
+
+  steps.push_back({"FindAvgOrientations", false, [featureIds](AbstractFilter* filter) {
+                     SetProperty(filter, "FeatureIdsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, featureIds));
+                     SetProperty(filter, "CellPhasesArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases));
+                     SetProperty(filter, "QuatsArrayPath", ImagePath(SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats));
+                     SetProperty(filter, "CrystalStructuresArrayPath", ImagePath(k_CellEnsembleData, SIMPL::EnsembleData::CrystalStructures));
+                     SetProperty(filter, "AvgQuatsArrayPath", ImagePath(k_CellFeatureData, SIMPL::FeatureData::AvgQuats));
+                     SetProperty(filter, "AvgEulerAnglesArrayPath", ImagePath(k_CellFeatureData, SIMPL::FeatureData::AvgEulerAngles));
+                   }});
+
+  steps.push_back({"FindGBCD", true,
+                   [](AbstractFilter* filter) {
+                     SetProperty(filter, "GBCDRes", 9.0f);
+                     SetProperty(filter, "SurfaceMeshFaceLabelsArrayPath", TrianglePath(SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+                     SetProperty(filter, "SurfaceMeshFaceNormalsArrayPath", TrianglePath(SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceNormals));
+                     SetProperty(filter, "SurfaceMeshFaceAreasArrayPath", TrianglePath(SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceAreas));
+                     SetProperty(filter, "FeatureEulerAnglesArrayPath", ImagePath(k_CellFeatureData, SIMPL::FeatureData::AvgEulerAngles));
+                     SetProperty(filter, "FeaturePhasesArrayPath", ImagePath(k_CellFeatureData, SIMPL::FeatureData::Phases));
+                     SetProperty(filter, "CrystalStructuresArrayPath", ImagePath(k_CellEnsembleData, SIMPL::EnsembleData::CrystalStructures));
+                   },
+                   NumberOfTriangles, "triangles"});
+
+  return steps;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<int> ParseIntegerList(const QString& text, bool* ok)
+{
+  std::vector<int> values;
+  *ok = true;
+  for(const QString& item : text.split(',', QString::SkipEmptyParts))
+  {
+    bool itemOk = false;
+    int value = item.trimmed().toInt(&itemOk);
+    if(!itemOk || value < 0)
+    {
+      *ok = false;
+      return values;
+    }
+    values.push_back(value);
+  }
+  *ok = !values.empty();
+  return values;
+}
+
+// -----------------------------------------------------------------------------
+int MaximumThreadCount()
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  return tbb::this_task_arena::max_concurrency();
+#else
+  return 1;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Executes the filter with at most the given number of threads.
+ */
+void ExecuteFilter(AbstractFilter* filter, int numThreads)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_arena arena(numThreads);
+  arena.execute([filter] { filter->execute(); });
+#else
+  Q_UNUSED(numThreads);
+  filter->execute();
+#endif
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("DREAM3DBenchmark");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Times the core DREAM.3D filters on synthetic microstructures and writes the results as JSON.");
+  parser.addHelpOption();
+  QCommandLineOption sizesOption("sizes", "Comma separated edge lengths of the cubic volumes in cells.", "list", "32,64,128");
+  QCommandLineOption threadsOption("threads", "Comma separated thread counts. 0 uses every available thread.", "list", "1,0");
+  QCommandLineOption repetitionsOption("repetitions", "Number of times each filter is timed for every size and thread count.", "count", "3");
+  QCommandLineOption cellsPerFeatureOption("cells-per-feature", "Average number of cells of a Voronoi feature.", "count", "1000");
+  QCommandLineOption seedOption("seed", "Seed of the synthetic microstructure.", "seed", "5489");
+  QCommandLineOption smoothingOption("smoothing-iterations", "Number of Laplacian smoothing iterations.", "count", "20");
+  QCommandLineOption filtersOption("filters", "Comma separated names of the filters to time. All core filters are timed by default.", "list");
+  QCommandLineOption outputOption({"o", "output"}, "Output JSON file. The results are written to the standard output by default.", "file");
+  parser.addOptions({sizesOption, threadsOption, repetitionsOption, cellsPerFeatureOption, seedOption, smoothingOption, filtersOption, outputOption});
+  parser.process(app);
+
+  bool sizesOk = false;
+  bool threadsOk = false;
+  std::vector<int> sizes = ParseIntegerList(parser.value(sizesOption), &sizesOk);
+  std::vector<int> threadCounts = ParseIntegerList(parser.value(threadsOption), &threadsOk);
+  const int repetitions = parser.value(repetitionsOption).toInt();
+  const int cellsPerFeature = parser.value(cellsPerFeatureOption).toInt();
+  const int smoothingIterations = parser.value(smoothingOption).toInt();
+  const uint64_t seed = parser.value(seedOption).toULongLong();
+  const bool emptyVolume = std::find(sizes.begin(), sizes.end(), 0) != sizes.end();
+  if(!sizesOk || emptyVolume || !threadsOk || repetitions < 1 || cellsPerFeature < 1 || smoothingIterations < 1)
+  {
+    std::cerr << "Invalid arguments. Sizes are comma separated positive integers, thread counts comma separated non negative integers; repetitions, cells per feature and smoothing iterations must be at least 1." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+  fm->RegisterKnownFilters(fm);
+  QMetaObjectUtilities::RegisterMetaTypes();
+
+  // Small features that MinSize removes come from the Voronoi cells that are clipped by the volume boundary
+  const int minimumFeatureSize = std::max(2, cellsPerFeature / 10);
+  std::vector<BenchmarkStep> steps = CreatePipeline(minimumFeatureSize, smoothingIterations);
+
+  // Only run the pipeline as far as the last selected filter
+  std::map<QString, bool> selected;
+  for(const BenchmarkStep& step : steps)
+  {
+    if(step.timed)
+    {
+      selected[step.filterName] = !parser.isSet(filtersOption);
+    }
+  }
+  if(parser.isSet(filtersOption))
+  {
+    for(const QString& name : parser.value(filtersOption).split(',', QString::SkipEmptyParts))
+    {
+      if(selected.find(name.trimmed()) == selected.end())
+      {
+        std::cerr << "Unknown filter '" << name.trimmed().toStdString() << "'. The timed filters are:";
+        for(const auto& entry : selected)
+        {
+          std::cerr << " " << entry.first.toStdString();
+        }
+        std::cerr << std::endl;
+        return EXIT_FAILURE;
+      }
+      selected[name.trimmed()] = true;
+    }
+  }
+  size_t lastStep = 0;
+  for(size_t i = 0; i < steps.size(); i++)
+  {
+    if(steps[i].timed && selected[steps[i].filterName])
+    {
+      lastStep = i;
+    }
+    if(nullptr == fm->getFactoryFromClassName(steps[i].filterName).get())
+    {
+      std::cerr << "The benchmark requires the " << steps[i].filterName.toStdString() << " filter, which was not found in the loaded plugins." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const int maxThreads = MaximumThreadCount();
+  const bool canResetPeak = ResetPeakResidentSetSize();
+  QJsonArray results;
+
+  for(int size : sizes)
+  {
+    std::cerr << "Generating a " << size << "^3 volume with " << cellsPerFeature << " cells per feature" << std::endl;
+    SyntheticVolume volume = GenerateVolume(static_cast<size_t>(size), static_cast<size_t>(cellsPerFeature), seed);
+
+    for(int requestedThreads : threadCounts)
+    {
+      const int numThreads = (requestedThreads == 0) ? maxThreads : std::min(requestedThreads, maxThreads);
+      for(int repetition = 0; repetition < repetitions; repetition++)
+      {
+        DataContainerArray::Pointer dca = CreateDataContainerArray(volume);
+        for(size_t i = 0; i <= lastStep; i++)
+        {
+          const BenchmarkStep& step = steps[i];
+          AbstractFilter::Pointer filter = fm->getFactoryFromClassName(step.filterName)->create();
+          filter->setDataContainerArray(dca);
+          step.configure(filter.get());
+
+          const bool record = step.timed && selected[step.filterName];
+          if(record)
+          {
+            ResetPeakResidentSetSize();
+          }
+          auto start = std::chrono::steady_clock::now();
+          ExecuteFilter(filter.get(), step.timed ? numThreads : maxThreads);
+          auto end = std::chrono::steady_clock::now();
+          if(filter->getErrorCode() < 0)
+          {
+            std::cerr << step.filterName.toStdString() << " failed with error code " << filter->getErrorCode() << " on the " << size << "^3 volume" << std::endl;
+            return EXIT_FAILURE;
+          }
+          if(!record)
+          {
+            continue;
+          }
+
+          const double seconds = std::chrono::duration<double>(end - start).count();
+          const size_t workItems = step.workItems(dca);
+          QJsonObject result;
+          result["filter"] = step.filterName;
+          result["size"] = size;
+          result["cells"] = static_cast<double>(NumberOfCells(dca));
+          result["features"] = static_cast<double>(NumberOfFeatures(dca));
+          result["triangles"] = static_cast<double>(NumberOfTriangles(dca));
+          result["threads"] = numThreads;
+          result["repetition"] = repetition;
+          result["seconds"] = seconds;
+          result["work_items"] = static_cast<double>(workItems);
+          result["work_unit"] = step.workUnit;
+          result["throughput"] = seconds > 0.0 ? static_cast<double>(workItems) / seconds : 0.0;
+          result["peak_rss_bytes"] = static_cast<double>(PeakResidentSetSize());
+          results.append(result);
+
+          std::cerr << "  " << step.filterName.toStdString() << " size=" << size << " threads=" << numThreads << " run=" << repetition << ": " << seconds << " s" << std::endl;
+        }
+      }
+    }
+  }
+
+  QJsonObject root;
+  root["benchmark"] = QString("DREAM3DBenchmark");
+  root["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+  root["hardware_threads"] = static_cast<int>(std::thread::hardware_concurrency());
+  root["max_threads"] = maxThreads;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  root["parallel_algorithms"] = true;
+#else
+  root["parallel_algorithms"] = false;
+#endif
+  root["seed"] = QString::number(seed);
+  root["cells_per_feature"] = cellsPerFeature;
+  root["minimum_feature_size"] = minimumFeatureSize;
+  root["smoothing_iterations"] = smoothingIterations;
+  root["repetitions"] = repetitions;
+  // "filter" when the peak can be reset before every filter, "process" when it is the peak of the whole run
+  root["peak_rss_scope"] = canResetPeak ? QString("filter") : QString("process");
+  root["results"] = results;
+
+  QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+  if(parser.isSet(outputOption))
+  {
+    QFile outFile(parser.value(outputOption));
+    if(!outFile.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+      std::cerr << "Unable to open the output file " << parser.value(outputOption).toStdString() << std::endl;
+      return EXIT_FAILURE;
+    }
+    outFile.write(json);
+  }
+  else
+  {
+    std::cout << json.constData();
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,268 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SyntheticMicrostructure.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace
+{
+/**
+ * @brief Voronoi seeds sorted into a regular grid of buckets.
+ */
+struct SeedGrid
+{
+  std::array<size_t, 3> bucketDims = {1, 1, 1};
+  float bucketSize = 1.0f;
+  std::vector<size_t> bucketStart;
+  std::vector<std::array<float, 3>> seeds;
+  std::vector<int32_t> seedIds;
+};
+
+/**
+ * @brief The VoronoiLabelImpl class labels one range of X rows of the volume with the nearest seed.
+ */
+class VoronoiLabelImpl
+{
+public:
+  VoronoiLabelImpl(const SeedGrid& grid, const std::array<size_t, 3>& dims, int32_t* featureIds)
+  : m_Grid(grid)
+  , m_Dims(dims)
+  , m_FeatureIds(featureIds)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    const std::array<size_t, 3>& bDims = m_Grid.bucketDims;
+    const size_t maxRing = std::max({bDims[0], bDims[1], bDims[2]});
+
+    for(size_t row = start; row < end; row++)
+    {
+      const size_t y = row % m_Dims[1];
+      const size_t z = row / m_Dims[1];
+      for(size_t x = 0; x < m_Dims[0]; x++)
+      {
+        const std::array<float, 3> p = {static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f, static_cast<float>(z) + 0.5f};
+        std::array<int64_t, 3> home = {};
+        for(size_t d = 0; d < 3; d++)
+        {
+          home[d] = std::min(static_cast<int64_t>(p[d] / m_Grid.bucketSize), static_cast<int64_t>(bDims[d]) - 1);
+        }
+
+        float bestDist = std::numeric_limits<float>::max();
+        int32_t bestId = 0;
+        // Every seed outside the shells searched so far is at least ring * bucketSize away,
+        // so the search can stop as soon as the best seed is closer than that.
+        for(size_t ring = 0; ring <= maxRing; ring++)
+        {
+          searchShell(home, static_cast<int64_t>(ring), p, bestDist, bestId);
+          const float bound = static_cast<float>(ring) * m_Grid.bucketSize;
+          if(bestId != 0 && bestDist <= bound * bound)
+          {
+            break;
+          }
+        }
+        m_FeatureIds[row * m_Dims[0] + x] = bestId;
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
+private:
+  const SeedGrid& m_Grid;
+  std::array<size_t, 3> m_Dims;
+  int32_t* m_FeatureIds = nullptr;
+
+  void searchShell(const std::array<int64_t, 3>& home, int64_t ring, const std::array<float, 3>& p, float& bestDist, int32_t& bestId) const
+  {
+    const std::array<size_t, 3>& bDims = m_Grid.bucketDims;
+    for(int64_t k = home[2] - ring; k <= home[2] + ring; k++)
+    {
+      if(k < 0 || k >= static_cast<int64_t>(bDims[2]))
+      {
+        continue;
+      }
+      for(int64_t j = home[1] - ring; j <= home[1] + ring; j++)
+      {
+        if(j < 0 || j >= static_cast<int64_t>(bDims[1]))
+        {
+          continue;
+        }
+        const bool onShellYZ = std::abs(k - home[2]) == ring || std::abs(j - home[1]) == ring;
+        // Inside the shell only the two X end buckets belong to it
+        const int64_t step = (onShellYZ || ring == 0) ? 1 : 2 * ring;
+        for(int64_t i = home[0] - ring; i <= home[0] + ring; i += step)
+        {
+          if(i < 0 || i >= static_cast<int64_t>(bDims[0]))
+          {
+            continue;
+          }
+          const size_t bucket = (static_cast<size_t>(k) * bDims[1] + static_cast<size_t>(j)) * bDims[0] + static_cast<size_t>(i);
+          for(size_t s = m_Grid.bucketStart[bucket]; s < m_Grid.bucketStart[bucket + 1]; s++)
+          {
+            const std::array<float, 3>& q = m_Grid.seeds[s];
+            const float dx = q[0] - p[0];
+            const float dy = q[1] - p[1];
+            const float dz = q[2] - p[2];
+            const float dist = dx * dx + dy * dy + dz * dz;
+            if(dist < bestDist || (dist == bestDist && m_Grid.seedIds[s] < bestId))
+            {
+              bestDist = dist;
+              bestId = m_Grid.seedIds[s];
+            }
+          }
+        }
+      }
+    }
+  }
+};
+} // namespace
+
+namespace SyntheticMicrostructure
+{
+// -----------------------------------------------------------------------------
+std::vector<int32_t> GenerateVoronoiFeatureIds(const std::array<size_t, 3>& dims, size_t numFeatures, uint64_t seed)
+{
+  const size_t totalCells = dims[0] * dims[1] * dims[2];
+  std::vector<int32_t> featureIds(totalCells, 0);
+  if(totalCells == 0 || numFeatures == 0)
+  {
+    return featureIds;
+  }
+
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+  SeedGrid grid;
+  // Buckets of about one seed each
+  grid.bucketSize = std::max(1.0f, std::cbrt(static_cast<float>(totalCells) / static_cast<float>(numFeatures)));
+  for(size_t d = 0; d < 3; d++)
+  {
+    grid.bucketDims[d] = std::max<size_t>(1, static_cast<size_t>(std::ceil(static_cast<float>(dims[d]) / grid.bucketSize)));
+  }
+  const size_t numBuckets = grid.bucketDims[0] * grid.bucketDims[1] * grid.bucketDims[2];
+
+  std::vector<std::array<float, 3>> seeds(numFeatures);
+  std::vector<size_t> seedBucket(numFeatures);
+  grid.bucketStart.assign(numBuckets + 1, 0);
+  for(size_t f = 0; f < numFeatures; f++)
+  {
+    std::array<size_t, 3> b = {};
+    for(size_t d = 0; d < 3; d++)
+    {
+      seeds[f][d] = unit(generator) * static_cast<float>(dims[d]);
+      b[d] = std::min(static_cast<size_t>(seeds[f][d] / grid.bucketSize), grid.bucketDims[d] - 1);
+    }
+    seedBucket[f] = (b[2] * grid.bucketDims[1] + b[1]) * grid.bucketDims[0] + b[0];
+    grid.bucketStart[seedBucket[f] + 1]++;
+  }
+  for(size_t b = 0; b < numBuckets; b++)
+  {
+    grid.bucketStart[b + 1] += grid.bucketStart[b];
+  }
+  grid.seeds.resize(numFeatures);
+  grid.seedIds.resize(numFeatures);
+  std::vector<size_t> cursor(grid.bucketStart.begin(), grid.bucketStart.end() - 1);
+  for(size_t f = 0; f < numFeatures; f++)
+  {
+    const size_t slot = cursor[seedBucket[f]]++;
+    grid.seeds[slot] = seeds[f];
+    grid.seedIds[slot] = static_cast<int32_t>(f + 1);
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, dims[1] * dims[2]);
+  dataAlg.execute(VoronoiLabelImpl(grid, dims, featureIds.data()));
+  return featureIds;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<float> GenerateRandomQuaternions(size_t count, uint64_t seed)
+{
+  // Shoemake's method gives quaternions that are uniform over SO(3)
+  constexpr double k_2Pi = 6.283185307179586;
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+  std::vector<float> quats(count * 4);
+  for(size_t i = 0; i < count; i++)
+  {
+    const double u1 = unit(generator);
+    const double u2 = unit(generator);
+    const double u3 = unit(generator);
+    const double r1 = std::sqrt(1.0 - u1);
+    const double r2 = std::sqrt(u1);
+    double x = r1 * std::sin(k_2Pi * u2);
+    double y = r1 * std::cos(k_2Pi * u2);
+    double z = r2 * std::sin(k_2Pi * u3);
+    double w = r2 * std::cos(k_2Pi * u3);
+    // q and -q are the same rotation, keep the scalar part positive
+    if(w < 0.0)
+    {
+      x = -x;
+      y = -y;
+      z = -z;
+      w = -w;
+    }
+    quats[i * 4 + 0] = static_cast<float>(x);
+    quats[i * 4 + 1] = static_cast<float>(y);
+    quats[i * 4 + 2] = static_cast<float>(z);
+    quats[i * 4 + 3] = static_cast<float>(w);
+  }
+  return quats;
+}
+
+// -----------------------------------------------------------------------------
+void FillCellQuaternions(const std::vector<int32_t>& featureIds, const std::vector<float>& featureQuats, float* cellQuats)
+{
+  const size_t numCells = featureIds.size();
+  for(size_t i = 0; i < numCells; i++)
+  {
+    const float* q = featureQuats.data() + static_cast<size_t>(featureIds[i]) * 4;
+    std::copy(q, q + 4, cellQuats + i * 4);
+  }
+}
+} // namespace SyntheticMicrostructure
@@ -0,0 +1,76 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The SyntheticMicrostructure namespace holds the generators for the synthetic inputs of the
+ * benchmark executable. Every generator is deterministic for a given seed so that runs on different
+ * machines or builds time exactly the same data.
+ */
+namespace SyntheticMicrostructure
+{
+/**
+ * @brief Labels every cell of a volume of the given dimensions with the id of its nearest Voronoi seed.
+ * The seeds are placed uniformly at random inside the volume and are looked up through a grid of buckets
+ * that holds about one seed each, so the cost is linear in the number of cells.
+ * @param dims Volume dimensions in cells (X, Y, Z)
+ * @param numFeatures Number of Voronoi seeds. The feature ids run from 1 to numFeatures
+ * @param seed Seed of the random number generator
+ * @return Feature id of each cell in X fastest order
+ */
+std::vector<int32_t> GenerateVoronoiFeatureIds(const std::array<size_t, 3>& dims, size_t numFeatures, uint64_t seed);
+
+/**
+ * @brief Draws orientations that are uniformly distributed over SO(3).
+ * @param count Number of orientations
+ * @param seed Seed of the random number generator
+ * @return Unit quaternions in the <x, y, z, w> layout used by the Quats arrays
+ */
+std::vector<float> GenerateRandomQuaternions(size_t count, uint64_t seed);
+
+/**
+ * @brief Expands per feature quaternions into a per cell quaternion array.
+ * @param featureIds Feature id of each cell
+ * @param featureQuats Quaternion of each feature (4 values per feature, indexed by feature id)
+ * @param cellQuats Receives 4 values per cell
+ */
+void FillCellQuaternions(const std::vector<int32_t>& featureIds, const std::vector<float>& featureQuats, float* cellQuats);
+} // namespace SyntheticMicrostructure